@@ -27,70 +27,135 @@
 #include "main/optimizer.hh"
 #include "utils/training.hh"
 #include "utils/storage.hh"
+#include "utils/dataset.hh"
+#include "utils/pipeline.hh"
+#include "utils/imageFP.hh"
 
 #include "cifar/cifar10_reader.hpp"
 #include "cifar10.hh"
 
+#define BATCH_SIZE 100
+
+#define IMAGE_SIZE 32
+#define IMAGE_CHANNELS 3
+#define CROP_MIN 26
+
+#define PIPELINE_THREADS 4
+#define PIPELINE_CAPACITY 4
+
+#define DATA_DIR "./data/cifar10/cifar-10-batches-bin"
+
+// convert CIFAR10 data to mapped dataset layout
+static void convert_data(const std::string& path)
+{
+  auto data = cifar::read_dataset<std::vector, std::vector, DTYPE, uint8_t>
+  (DATA_DIR);
+
+  Dataset::write(DATA_DIR "/train.sgds",
+    data.training_images, data.training_labels);
+  Dataset::write(DATA_DIR "/test.sgds",
+    data.test_images, data.test_labels);
+}
+
 ///////////////////////////////////
 // training instance implementation
 ///////////////////////////////////
 class CIFAR10Client : public Training
 {
 public:
-  CIFAR10Client(int worker) : Training(worker)
+  CIFAR10Client(int worker, bool training = true) : Training(worker)
   {
-    std::cout << "CIFAR10 training " << worker << std::endl;
-
-    // load data
-    _data = cifar::read_dataset<std::vector, std::vector, DTYPE, uint8_t>
-    ("./data/cifar10/cifar-10-batches-bin");
+    std::cout << "CIFAR10 " << (training ? "training " : "inference ")
+              << worker << std::endl;
 
     // create graph
     Graph& g = graph();
-    _model = new CIFAR10Model(g);    
-
-    // optimizer
-    _optimizer = new Adam(g.variables(), 0.001);
+    _model = new CIFAR10Model(g, BATCH_SIZE);
 
     // loss
-    _y_hat = g.new_constant(OUTPUT, 1);
-    auto& ce = -*_y_hat * *g.new_log_softmax(_model->output_logits());
+    _y_hat = g.new_constant(BATCH_SIZE, OUTPUT);
+    auto& y_logits = _model->output_logits();
+    auto& ce = -*_y_hat * *g.new_log_softmax(y_logits, ROWWISE);
     _loss = g.new_sum(ce);
 
     // counters
     _steps = 0;
     _positive = 0;
 
-    // data index
-    _training.resize(_data.training_images.size());
-    for (int i=_data.training_images.size()-1; i>=0; i--) _training[i] = i;
+    // inference takes neither data nor optimizer state
+    _optimizer = nullptr;
+    _pipeline = nullptr;
+    if (!training) return;
+
+    // map data converted once per process
+    _train = Dataset::shared(DATA_DIR "/train.sgds", convert_data);
+    _test = Dataset::shared(DATA_DIR "/test.sgds", convert_data);
+
+    // optimizer
+    _optimizer = new Adam(g.variables(), 0.001);
+
+    // training batches prepared in background
+    auto train = _train;
+    _pipeline = new Pipeline(train->size(), BATCH_SIZE, INPUT, OUTPUT,
+      [train](int index, Batch& batch, int row, RNG& rng)
+      {
+        set_input(batch.input, batch.target, row,
+          train->input(index), train->label(index));
+        augment(batch.input, row, rng);
+      }, PIPELINE_THREADS, PIPELINE_CAPACITY, g.random().uniform_int(INT_MAX));
   }
 
   ~CIFAR10Client()
   {
+    delete _pipeline;
     delete _optimizer;
   }
 
-  void set_input(Tensor& in, Tensor& out, std::vector<DTYPE>& image, int label)
+  // set input sample in batch row
+  static void set_input(Tensor& in, Tensor& out, int row,
+  const ConstRowVectorMap& image, int label)
   {
-    in.block(0,0, INPUT,1) = Eigen::Map<Tensor>(image.data(), INPUT, 1);
+    in.row(row) = image;
+
+    in.row(row) /= (in.row(row).norm() + EPSILON);
+
+    for (int i=0; i<OUTPUT; i++) out(row, i) = (label == i);
+  }
+
+  // random crop scaled back to image size and horizontal flip of batch row
+  static void augment(Tensor& in, int row, RNG& rng)
+  {
+    int size = rng.uniform_int(CROP_MIN, IMAGE_SIZE);
+    int top = rng.uniform_int(IMAGE_SIZE - size);
+    int left = rng.uniform_int(IMAGE_SIZE - size);
+    bool flip = rng.uniform_int(1);
+
+    // planar channels of the row
+    for (int c=0; c<IMAGE_CHANNELS; c++)
+    {
+      ImageFP plane(in.row(row).data() + c * IMAGE_SIZE * IMAGE_SIZE,
+        IMAGE_SIZE, IMAGE_SIZE);
 
-    in.block(0,0, INPUT,1) /= (in.block(0,0, INPUT,1).norm() + EPSILON);
+      ImageFP im = plane.crop(top, left, size, size);
+      if (size != IMAGE_SIZE)
+        im = im.scale(IMAGE_SIZE, IMAGE_SIZE, ImageFP::INTERPOLATE_BILINEAR);
+      if (flip) im = im.flip();
 
-    for (int i=0; i<OUTPUT; i++) out(i, 0) = (label == i);
+      std::memcpy(plane.data(), im.data(), plane.size() * sizeof(DTYPE));
+    }
   }
 
-  // get output
-  int get_output(const Tensor& out)
+  // get output of batch row
+  int get_output(const Tensor& out, int row)
   {
     int max_i = -1;
     DTYPE max_v = 0;
 
     for (int i=0; i<OUTPUT; i++)
     {
-      if (out(i, 0) > max_v)
+      if (out(row, i) > max_v)
       {
-        max_v = out(i, 0);
+        max_v = out(row, i);
         max_i = i;
       }
     }
@@ -100,6 +165,8 @@ public:
 
   virtual void batch_train()
   {
+    if (!_pipeline) throw std::runtime_error("Model created for inference");
+
     // restore references
     auto& g = graph();
     auto& x = _model->input();
@@ -108,26 +175,22 @@ public:
     auto& loss = *_loss;
     auto& opt = *_optimizer;
 
-    int batch_size = 100;
-    int positive = 0;
+    int batch_size = BATCH_SIZE;
     _steps++;
 
-    // data index
-    graph().random().shuffle(_training.begin(), _training.end(), batch_size);
+    // batch input prepared while previous batch trained
+    _pipeline->take(_data);
+    x.value().swap(_data.input);
+    y_hat.value().swap(_data.target);
 
     // batch train
+    g.recache();
+    g.backward(loss, loss());
+
     for (int i=0; i<batch_size; i++)
     {
-      int ir = _training[i];
-      auto& image = _data.training_images[ir];
-      auto label = _data.training_labels[ir];
-
-      g.recache();
-      set_input(x.value(), y_hat.value(), image, label);
-      g.backward(loss, loss());
-
-      auto predl = get_output(y());
-      if (predl == label) _positive++;
+      auto label = _train->label(_data.index[i]);
+      if (get_output(y(), i) == label) _positive++;
     }
 
     // update weights
@@ -153,21 +216,52 @@ public:
     }
   }
 
+  virtual void batch_predict(const Tensor& input, Tensor& output)
+  {
+    if (input.cols() != INPUT)
+      throw std::runtime_error("Invalid prediction input size");
+
+    auto& g = graph();
+    auto& x = _model->input();
+
+    // input rows normalized as in training
+    x.value() = input;
+    for (int r=0; r<input.rows(); r++)
+      x.value().row(r) /= (x.value().row(r).norm() + EPSILON);
+
+    g.recache();
+    output = _model->output()();
+  }
+
   float validate(Graph& g, Constant& x, Function& y, Constant& y_hat)
   {
     int positive = 0;
-    int size = _data.test_images.size();
+    int size = _test->size();
+    int batch_size = x.value().rows();
 
-    for (int i=0; i<size; i++)
+    // weights changed since last pass
+    g.recache();
+
+    for (int i=0; i<size; i+=batch_size)
     {
-      auto& image = _data.test_images[i];
-      auto label = _data.test_labels[i];
+      int rows = std::min(batch_size, size - i);
+
+      // last batch may be smaller
+      for (int r=0; r<rows; r++)
+      {
+        auto image = _test->input(i + r);
+        auto label = _test->label(i + r);
+        set_input(x.value(), y_hat.value(), r, image, label);
+      }
 
-      g.recache();
-      set_input(x.value(), y_hat.value(), image, label);
+      // recompute input dependent nodes only
+      g.invalidate_from(x);
+      auto& out = y();
 
-      auto predl = get_output(y());
-      if (predl == label) positive++;
+      for (int r=0; r<rows; r++)
+      {
+        if (get_output(out, r) == _test->label(i + r)) positive++;
+      }
     }
 
     return (float)positive/size;
@@ -180,10 +274,12 @@ private:
   Optimizer *_optimizer;
   int _steps;
   int _positive;
-  std::vector<int> _training;
+  Pipeline *_pipeline;
+  Batch _data;
 
   // cifar data
-  cifar::CIFAR10_dataset<std::vector, std::vector<DTYPE>, uint8_t> _data;
+  std::shared_ptr<const Dataset> _train;
+  std::shared_ptr<const Dataset> _test;
 };
 
 ///////////////////////////////////
@@ -195,6 +291,11 @@ DLL_EXPORT Training* create(int idx)
   return new CIFAR10Client(idx);
 }
 
+DLL_EXPORT Training* create_inference(int idx)
+{
+  return new CIFAR10Client(idx, false);
+}
+
 DLL_EXPORT void destroy(Training* ptr)
 {
   delete (CIFAR10Client*)ptr;
@@ -19,15 +19,16 @@ using namespace seegnify;
 class CIFAR10Model
 {
 public:
-  CIFAR10Model(Graph& g)
+  // input rows are samples of a batch
+  CIFAR10Model(Graph& g, int batch = 1)
   {
     // input
-    _x = g.new_constant(INPUT, 1);
-    _x->value() = Tensor::Zero(INPUT, 1);
+    _x = g.new_constant(batch, INPUT);
+    _x->value() = Tensor::Zero(batch, INPUT);
 
     // network
     _y_logits = g.new_linear(*_x, INPUT, OUTPUT);
-    _y = g.new_softmax(*_y_logits);
+    _y = g.new_softmax(*_y_logits, ROWWISE);
   }
 
   Constant& input() { return *_x; }
@@ -10,7 +10,7 @@
 #include "main/optimizer.hh"
 #include "utils/training.hh"
 #include "utils/storage.hh"
-#include "utils/rlenv.hh"
+#include "utils/vecrlenv.hh"
 
 #include "cifar/cifar10_reader.hpp"
 #include "cifarRL.hh"
@@ -24,102 +24,88 @@
 // progress log
 #define VALSTEPS 100000
 
+typedef std::vector<std::vector<uint8_t>> Images;
+typedef std::vector<uint8_t> Labels;
+
 ////////////////////////////////
-// RL training environment
+// RL training environments
 ////////////////////////////////
-class CIFARRLEnv : public RLEnv
+class CIFARRLEnv : public VecRLEnv
 {
 public:
-  enum ACTION
-  {
-    ACTION_UP,
-    ACTION_DOWN,
-    ACTION_LEFT,
-    ACTION_RIGHT,
-    ACTION_FORWARD,
-    ACTION_BACKWARD,
-    ACTION_ZOOM_IN,
-    ACTION_ZOOM_OUT,
-  };
-
-  CIFARRLEnv()
+  CIFARRLEnv(int size, const Images& images, const Labels& labels,
+  bool shuffle) :
+  VecRLEnv(size, VIEW_ROWS, VIEW_COLS),
+  _images(images), _labels(labels), _shuffle(shuffle)
   {
-    finished = false;
-    last_action = NUM_OF_ACTIONS;
-    set_view_size(VIEW_ROWS, VIEW_COLS);
-  }
+    _order.resize(images.size());
+    for (int i=images.size()-1; i>=0; i--) _order[i] = i;
+    _draws = 0;
 
-  void set_label(int l)
-  {
-    label = l;
+    _label.resize(size);
+    _sample.resize(size);
   }
 
-  bool is_correct()
+  // number of samples drawn before current sample of environment i
+  uint64_t sample(int i) const { return _sample[i]; }
+
+  // label of current sample of environment i
+  int label(int i) const { return _label[i]; }
+
+protected:
+  // draw next sample, shuffled once per pass over the data if requested
+  virtual void reset(int i)
   {
-    return last_action - NUM_OF_ACTIONS == label;
+    int position = _draws % _order.size();
+    if (position == 0 && _shuffle)
+      _random.shuffle(_order.begin(), _order.end());
+
+    int index = _order[position];
+    _sample[i] = _draws++;
+    _label[i] = _labels[index];
+
+    auto rgb = cifar_to_rgb(_images[index]);
+    set_full_rgb(i, rgb.data(), 1, DATA_ROWS, DATA_COLS);
   }
 
-  uint16_t get_actions_count()
+  // actions from NUM_OF_MOVES up select the label
+  virtual DTYPE reward(int i, int action)
   {
-    return NUM_OF_ACTIONS;
+    return action - NUM_OF_MOVES == _label[i];
   }
 
-  bool is_episode_finished()
+  virtual bool finished(int i, int action)
   {
-    return finished || action_step > NUM_OF_ACTIONS || total_reward < MIN_REWARD;
+    return action >= NUM_OF_MOVES || steps(i) > NUM_OF_ACTIONS;
   }
 
-  float make_action(uint16_t action)
+  static std::vector<uint8_t> cifar_to_rgb(const std::vector<uint8_t>& image)
   {
-    last_action = action;
+    // convert ciphar to RGB format
+    auto pix = image.data();
+    std::vector<uint8_t> rgb(image.size(), 0);
 
-    switch(action)
+    for (int r=0; r<DATA_ROWS; r++)
+    for (int c=0; c<DATA_COLS; c++)
+    for (int channel=0; channel<3; channel++) // RGB
     {
-      case ACTION_UP:         action_up(); break;
-      case ACTION_DOWN:       action_down(); break;
-      case ACTION_LEFT:       action_left(); break;
-      case ACTION_RIGHT:      action_right(); break;
-      case ACTION_FORWARD:    action_forward(); break;
-      case ACTION_BACKWARD:   action_backward(); break;
-      case ACTION_ZOOM_IN:    action_zoom_in(); break;
-      case ACTION_ZOOM_OUT:   action_zoom_out(); break;
-    };
-
-    if (last_action >= NUM_OF_ACTIONS) finished = true;
-
-    auto r = get_reward();
-    total_reward += r;
-    return r;
-  }
-  
-protected:
-  virtual void reset()
-  {
-    slice = rand() % slices;
-
-    auto center_x = full_cols / 2;
-    auto center_y = full_rows / 2;
-    auto max_dist = full_cols / 4;
-
-    x = center_x + rand() % (2 * max_dist) - max_dist;
-    y = center_y + rand() % (2 * max_dist) - max_dist;
-
-    total_reward = 0;
-    label = NUM_OF_ACTIONS;
-    last_action = NUM_OF_ACTIONS;
-  }
+      auto rgb_index = r * DATA_COLS * 3 + c * 3 + channel;
+      auto pix_index = channel * DATA_COLS * DATA_ROWS + r * DATA_COLS + c;
+      rgb[rgb_index] = pix[pix_index];
+    }
 
-  // [0,1] reward for loss: -log(p) a r -log(p-1) a (1-r)
-  virtual float get_reward()
-  {
-    return is_correct();
+    return rgb;
   }
 
 private:
-  bool finished;
-  float total_reward;
-  uint16_t last_action;
-  uint16_t label;
+  const Images& _images;
+  const Labels& _labels;
+  bool _shuffle;
+  std::vector<int> _order;
+  uint64_t _draws;
+  std::vector<int> _label;
+  std::vector<uint64_t> _sample;
+  RNG _random;
 };
 
 ////////////////////////////////
@@ -139,36 +125,36 @@ public:
     // get graph
     Graph& g = graph();
 
-    // ceate RL env
-    _env = new CIFARRLEnv();
+    // ceate RL environments stepped in batch
+    _env = new CIFARRLEnv(BATCH,
+      _data.training_images, _data.training_labels, true);
+    _test = new CIFARRLEnv(BATCH,
+      _data.test_images, _data.test_labels, false);
 
-    // ceate RL model
-    _mod = new CIFARRLModel(g);
+    // ceate RL model of batch of environments
+    _mod = new CIFARRLModel(g, BATCH);
 
     // optimizer
     _opt = new Adam(g.variables(), LRATE);
 
-    // state
-    _episode = 0;
-    _frames = 0;
-    
     std::cout << " training_images=" << _data.training_images.size()
               << " training_labels=" << _data.training_labels.size()
               << " test_images=" << _data.test_images.size()
               << " test_labels=" << _data.test_labels.size()
               << " env rows=" << VIEW_ROWS
               << " env rows=" << VIEW_COLS
+              << " environments=" << BATCH
               << " input size=" << INPUT
               << " hidden size=" << HIDDEN
               << " output size=" << OUTPUT
               << std::endl;
 
-    // loss over time
-    for (int t=0; t<STEPS; t++)
-    {      
-      // time step action and reward
-      auto& a = *g.new_constant(OUTPUT, 1);
-      auto& r = *g.new_constant(1, 1);
+    // loss over window of time steps
+    for (int t=0; t<WINDOW; t++)
+    {
+      // time step action and reward of each environment
+      auto& a = *g.new_constant(BATCH, OUTPUT);
+      auto& r = *g.new_constant(BATCH, 1);
       _action.push_back(&a);
       _reward.push_back(&r);
 
@@ -176,15 +162,15 @@ public:
       auto& p = _mod->policy(t);
 
       // selected output
-      //auto& s = *g.new_log(*g.new_sum(p * a)) * r;
-      auto& s = *g.new_sum(*g.new_log((1 - EPSILON) * p + EPSILON) * a) * r;
+      auto& s = *g.new_sum(
+        *g.new_log((1 - EPSILON) * p + EPSILON) * a, ROWWISE) * r;
 
       // not-selected output
-      //auto& u = *g.new_log(*g.new_sum((1 - p) * a)) * (1 - r);
-      auto& u = *g.new_sum(*g.new_log((1 - EPSILON) * (1 - p) + EPSILON) * a) * (1 - r);
+      auto& u = *g.new_sum(
+        *g.new_log((1 - EPSILON) * (1 - p) + EPSILON) * a, ROWWISE) * (1 - r);
 
       // time step loss
-      auto& l = - s - u;
+      auto& l = *g.new_sum(- s - u);
 
       // cumulative loss
       if (t == 0)
@@ -200,168 +186,171 @@ public:
       }
     }
 
-    // data index
-    _batch.resize(_data.training_images.size());
-    for (int i=_data.training_images.size()-1; i>=0; i--) _batch[i] = i;
+    // episodes and hidden state continue across batches
+    _env->new_episode();
+    _state = _mod->unroll().state();
+    _keep = Tensor::Ones(BATCH, 1);
+
+    // state
+    _batch = 0;
+    _episode = 0;
+    _validate = VALSTEPS;
+    _total_loss = 0;
   }
 
   ~CIFARRLClient()
   {
     delete _opt;
     delete _env;
+    delete _test;
     delete _mod;
   }
 
-  std::vector<uint8_t> cifar_to_rgb(const std::vector<uint8_t>& image)
+  // set target
+  void set_target(Tensor& action, const std::vector<int>& a,
+  Tensor& reward, const std::vector<DTYPE>& r)
   {
-    // convert ciphar to RGB format
-    auto pix = image.data();
-    std::vector<uint8_t> rgb(image.size(), 0);
-
-    for (int r=0; r<DATA_ROWS; r++)
-    for (int c=0; c<DATA_COLS; c++) 
-    for (int channel=0; channel<3; channel++) // RGB
+    action.setZero();
+    for (int i=0; i<BATCH; i++)
     {
-      auto rgb_index = r * DATA_COLS * 3 + c * 3 + channel;
-      auto pix_index = channel * DATA_COLS * DATA_ROWS + r * DATA_COLS + c;
-      rgb[rgb_index] = pix[pix_index];
+      action(i, a[i]) = 1;
+      reward(i, 0) = r[i];
     }
-
-    return rgb;
   }
 
-  // set input
-  void set_input(Tensor& in, const Image& image)
+  // get action of each environment
+  std::vector<int> get_actions(const Tensor& out, float epsilon = 0.0)
   {
-    auto imageI = image.data();
-    std::vector<DTYPE> imageF(INPUT, 0);
-    for (int i=0; i<INPUT; i++) imageF[i] = imageI[i];
+    std::vector<int> actions(out.rows());
 
-    in.block(0,0, INPUT,1) = TensorMap(imageF.data(), INPUT, 1);
+    for (int i=0; i<out.rows(); i++)
+    {
+      auto row = out.data() + i * out.cols();
 
-    in.block(0,0, INPUT,1) /= 255;
-  }
+      // get stochastic output from the network
+      if (0.0 < epsilon)
+      {
+        actions[i] = graph().random().discrete_choice(row, row + out.cols());
+        continue;
+      }
 
-  // set target
-  void set_target(Tensor& action, int a, Tensor& reward, float r)
-  {
-    action.setZero();
-    action(a,0) = 1;
-    reward(0,0) = r;
+      // get deterministic output form the network
+      actions[i] = std::max_element(row, row + out.cols()) - row;
+    }
+
+    return actions;
   }
 
-  // get output
-  int get_action(const Tensor& out, float epsilon = 0.0)
+  // discounted rewards of each environment until the end of its episode
+  void discount(std::vector<std::vector<DTYPE>>& rewards,
+  const std::vector<std::vector<bool>>& done)
   {
-    // get stochastic output form the network
-    if (0.0 < epsilon)
+    std::vector<DTYPE> r(BATCH, 0);
+    for (int t=rewards.size()-1; t>=0; t--)
     {
-      return graph().random().discrete_choice(out.data(), out.data() + out.size());
+      for (int i=0; i<BATCH; i++)
+      {
+        r[i] = (done[t][i]) ? rewards[t][i] : rewards[t][i] + GAMMA * r[i];
+        rewards[t][i] = r[i];
+      }
     }
-
-    // get deterministic output form the network
-    int max_row = -1;
-    int max_col = -1;
-    out.maxCoeff(&max_row, &max_col);
-    return max_row;
   }
 
-  float episode(const std::vector<uint8_t>& image, int label, bool train)
+  virtual void batch_train()
   {
-    // clear graph cache
-    graph().recache();
-
-    // data sample
-    auto sample = cifar_to_rgb(image);
-    auto explore = (train) ? EXPLORE : 0;
-
-    // new episode
-    _env->new_episode();
-    _env->set_full_rgb(sample.data(), 1, DATA_ROWS, DATA_COLS);
-    _env->set_label(label);
-
-    // loop in time
-    _frames = 0;
-    std::vector<int> actions;
-    std::vector<DTYPE> rewards;
+    // continue hidden state of the previous batch
+    auto& unroll = _mod->unroll();
+    unroll.state(_state);
+
+    // step all environments over windows of time steps
+    std::vector<Tensor> inputs;
+    std::vector<Tensor> keeps;
+    std::vector<std::vector<int>> actions;
+    std::vector<std::vector<DTYPE>> rewards;
+    std::vector<std::vector<bool>> done;
+    std::vector<std::vector<Tensor>> states;
+    float success = 0;
+    int finished = 0;
     for (int t=0; t<STEPS; t++)
     {
-      _frames++;
-      auto& input = _mod->input(t);
-      auto& policy = _mod->policy(t);
-
-      // get action from policy
-      auto view = _env->get_view_rgb();
-      set_input(input.value(), view);
-      actions.push_back(get_action(policy(), explore));
-
-      // apply action
-      rewards.push_back(_env->make_action(actions.back()));
-      if (_env->is_episode_finished()) break;
+      // carry hidden state into next window
+      int slot = unroll.slot(t);
+      if (t > 0 && slot == 0) unroll.advance();
+      if (slot == 0) states.push_back(unroll.state());
+
+      auto& input = _mod->input(slot);
+      auto& keep = _mod->keep(slot);
+      auto& policy = _mod->policy(slot);
+
+      // get actions from policy of all environments
+      _env->observe(input.value());
+      keep.value() = _keep;
+      inputs.push_back(input.value());
+      keeps.push_back(keep.value());
+      actions.push_back(get_actions(policy(), EXPLORE));
+
+      // apply actions, finished episodes restart
+      rewards.emplace_back();
+      done.emplace_back();
+      _env->step(actions.back(), rewards.back(), done.back());
+
+      // reset hidden state of restarted episodes
+      for (int i=0; i<BATCH; i++)
+      {
+        _keep(i, 0) = !done.back()[i];
+        if (done.back()[i]) success += rewards.back()[i];
+      }
+      finished += std::count(done.back().begin(), done.back().end(), true);
     }
 
-    if (train)
-    {
-      auto total = std::accumulate(rewards.begin(), rewards.end(), 0);
-      //if (total == 0) abort();
+    // hidden state entering the next batch
+    unroll.advance();
+    _state = unroll.state();
+
+    // discount rewards
+    discount(rewards, done);
 
-      // discount rewards
-      rewards = discount_reward(rewards, GAMMA);
+    // truncated back-propagation through each window from the last one,
+    // each window replays its steps from the recorded state
+    _total_loss = 0;
+    for (int w=states.size()-1; w>=0; w--)
+    {
+      int first = w * WINDOW;
+      unroll.state(states[w]);
 
-      // apply action and reward in each time step
-      for (int t=0; t<_frames; t++)
+      // apply input, action and reward in each time step
+      for (int t=0; t<WINDOW; t++)
       {
         // restore references
+        auto& input = _mod->input(t);
+        auto& keep = _mod->keep(t);
         auto& action = *_action[t];
         auto& reward = *_reward[t];
 
-        set_target(action.value(),    actions[t],
-                   reward.value(),    rewards[t]);
+        input.value() = inputs[first + t];
+        keep.value() = keeps[first + t];
+        set_target(action.value(),    actions[first + t],
+                   reward.value(),    rewards[first + t]);
       }
 
       // get current loss
-      auto& loss = *_loss[_frames-1];
-      loss();
+      auto& loss = *_loss[WINDOW-1];
+      _total_loss += loss()(0);
 
       // compute gradients
       graph().backward(loss, Tensor::Constant(1,1,1));
-
-      // update state
-      _episode++;
     }
 
-    return _env->is_correct();
-  }
-
-  virtual void batch_train()
-  {
-    // train on batch of episodes
-    graph().random().shuffle(_batch.begin(), _batch.end());
-    float success = 0;
-    for (int i=0; i<BATCH; i++)
-    {
-      int index = _batch[i];
-      auto& image = _data.training_images[index];
-      auto label = _data.training_labels[index];
-      success += episode(image, label, true);
-    }
+    // update state
+    _episode += finished;
 
     // log status
     if (worker() == 0)
     {
-      int index = _batch[BATCH-1];
-      int label = _data.training_labels[index];
-      auto& image = _data.training_images[index];
-      auto& action = _action[_frames-1]->forward();
-      auto loss = _loss[_frames-1]->forward()(0);
-      int guess = get_action(action) - _env->get_actions_count();
-
-      std::cout << "batch " << _episode / BATCH
-                << ", accuracy " << success / BATCH
-                << ", frames " << _frames
-                << ", label " << label
-                << ", guess " << guess
-                << ", loss " << loss
+      std::cout << "batch " << ++_batch
+                << ", accuracy " << success / std::max(finished, 1)
+                << ", episodes " << finished
+                << ", loss " << _total_loss
                 << std::endl << std::flush;
     }
 
@@ -370,47 +359,83 @@ public:
     graph().zero_grad();
 
     // validate on test data
-    if (worker() == 0 && _episode % VALSTEPS == 0)
+    if (worker() == 0 && _episode >= _validate)
     {
-      int success = 0;
+      _validate += VALSTEPS;
+      validate();
+    }
+  }
 
-      // run batch of episodes
-      int size = _data.test_images.size();
-      for (int i=0; i<size; i++)
-      {
-        auto& image = _data.test_images[i];
-        auto label = _data.test_labels[i];
-        success += episode(image, label, false);
+  // run each test sample once in batch of environments from initial state
+  void validate()
+  {
+    auto& unroll = _mod->unroll();
+    unroll.reset();
+
+    int size = _data.test_images.size();
+    int tested = 0;
+    int success = 0;
 
-        if ((i+1) % 100 == 0)
+    Tensor keep = Tensor::Ones(BATCH, 1);
+    std::vector<uint64_t> sample(BATCH);
+    std::vector<DTYPE> rewards;
+    std::vector<bool> done;
+
+    _test->new_episode();
+    for (int t=0; tested < size; t++)
+    {
+      int slot = unroll.slot(t);
+      if (t > 0 && slot == 0) unroll.advance();
+
+      auto& input = _mod->input(slot);
+      _test->observe(input.value());
+      _mod->keep(slot).value() = keep;
+
+      for (int i=0; i<BATCH; i++) sample[i] = _test->sample(i);
+      _test->step(get_actions(_mod->policy(slot)()), rewards, done);
+
+      // count first episode of each sample
+      for (int i=0; i<BATCH; i++)
+      {
+        keep(i, 0) = !done[i];
+        if (done[i] && sample[i] < (uint64_t)size)
         {
-          std::cout << "validation accuracy "
-                    << (i+1) << " / " << size << " : "
-                    << (float)success / (float)(i+1)
-                    << std::endl << std::flush;
+          success += rewards[i];
+          if (++tested % 1000 == 0)
+          {
+            std::cout << "validation accuracy "
+                      << tested << " / " << size << " : "
+                      << (float)success / (float)tested
+                      << std::endl << std::flush;
+          }
         }
       }
-
-      std::cout << "final validation accuracy "
-                << (float)success / (float)size
-                << std::endl << std::flush;
     }
+
+    std::cout << "final validation accuracy "
+              << (float)success / (float)size
+              << std::endl << std::flush;
   }
 
 private:
   std::vector<Constant*> _action;
   std::vector<Constant*> _reward;
   std::vector<Function*> _loss;
-  CIFARRLEnv *_env;
+  CIFARRLEnv* _env;
+  CIFARRLEnv* _test;
   CIFARRLModel* _mod;
   Optimizer* _opt;
-  uint32_t _episode;
-  uint32_t _frames; 
-  std::vector<int> _batch;
+  std::vector<Tensor> _state;
+  Tensor _keep;
+  uint64_t _episode;
+  uint64_t _validate;
+  uint32_t _batch;
+  float _total_loss;
 
   // cifar data
   cifar::CIFAR10_dataset<std::vector, std::vector<uint8_t>, uint8_t> _data;
 };
+
 ///////////////////////////////////
 extern "C" { // export C signatures
 ///////////////////////////////////
@@ -428,4 +453,3 @@ DLL_EXPORT void destroy(Training* ptr)
 ///////////////////////////////////
 } // export C signatures
 ///////////////////////////////////
-
@@ -24,6 +24,7 @@
 // RL mpdel params
 #define DEPTH       2
 #define STEPS       10
+#define WINDOW      5
 #define HIDDEN      50
 #define INPUT       (3 * VIEW_ROWS * VIEW_COLS)
 #define OUTPUT      (LABELS + NUM_OF_ACTIONS)
@@ -37,66 +38,85 @@ using namespace seegnify;
 class CIFARRLModel
 {
 public:
-  CIFARRLModel(Graph& g)
+  CIFARRLModel(Graph& g, int batch)
   {
     // model dimensions
     const int SIZE = INPUT + HIDDEN + OUTPUT;
 
-    // network hidden input
-    Function *hidden[DEPTH];
-    Function *cell[DEPTH];
-    for (int i=0; i<DEPTH; i++)
-    {
-      hidden[i] = g.new_constant(SIZE, 1);
-      hidden[i]->value() = Tensor::Zero(SIZE, 1);
-      cell[i] = hidden[i];
-    }
+    // network hidden input and cell of each layer, one row per environment
+    std::vector<Tensor> state(2 * DEPTH, Tensor::Zero(batch, SIZE));
+
+    Linear *l0 = nullptr, *y = nullptr;
+    LSTM *lstm[DEPTH];
 
-    // recurrent network in time
-    for (int t=0; t<STEPS; t++)
+    // recurrent network in time over window of steps sharing weights
+    auto step = [&](int t, const std::vector<Function*>& state)
     {
       // time step input
-      _input.push_back(g.new_constant(INPUT, 1));
+      _input.push_back(g.new_constant(batch, INPUT));
       auto x = _input.back();
 
-      auto l0 = g.new_linear(*x, INPUT, SIZE, "INPUT");
+      // state kept in rows of continued episodes
+      _keep.push_back(g.new_constant(batch, 1));
+      auto& keep = *_keep.back();
+
+      l0 = (t == 0) ? g.new_linear(*x, INPUT, SIZE, "INPUT") :
+        g.new_linear(*x, *l0);
       auto h0 = g.new_tanh(*l0);
 
-      for (int i=0; i<0; i++)
-      {
-        char name[32];
-        sprintf(name, "INPUT-%d", i+1);
-        l0 = g.new_linear(*h0, SIZE, SIZE, name);
-        h0 = g.new_tanh(*l0);
-      }
-      
+      std::vector<Function*> next;
       Function *h_x = h0;
       for (int i=0; i<DEPTH; i++)
       {
-        char name[32];
-        sprintf(name, "GU-%d", i+1);
-        auto h = g.new_lstm(*h_x, *hidden[i], *cell[i], SIZE, SIZE);
-        g.name(h, name);
-        hidden[i] = h;
-        cell[i] = &h->cell();
-        h_x = h;
+        auto& hidden = *state[2 * i] * *g.new_broadcast(keep, *state[2 * i]);
+        auto& cell = *state[2 * i + 1] *
+          *g.new_broadcast(keep, *state[2 * i + 1]);
+        if (t == 0)
+        {
+          char name[32];
+          sprintf(name, "GU-%d", i+1);
+          lstm[i] = g.new_lstm(*h_x, hidden, cell, SIZE, SIZE);
+          g.name(lstm[i], name);
+        }
+        else
+        {
+          lstm[i] = g.new_lstm(*h_x, hidden, cell, *lstm[i]);
+        }
+        next.push_back(lstm[i]);
+        next.push_back(&lstm[i]->cell());
+        h_x = lstm[i];
       }
 
-      auto y = g.new_linear(*h_x, SIZE, OUTPUT, "ACTION");
+      y = (t == 0) ? g.new_linear(*h_x, SIZE, OUTPUT, "ACTION") :
+        g.new_linear(*h_x, *y);
 
-      // action policy
-      _policy.push_back(g.new_softmax(*y));
-    }
+      // action policy of each environment
+      _policy.push_back(g.new_softmax(*y, ROWWISE));
+
+      return next;
+    };
+
+    _unroll = new Unroll(g, WINDOW, state, step);
   }
 
+  ~CIFARRLModel() { delete _unroll; }
+
+  // input, state mask and policy of window slot t
   Constant& input(int t) { return *_input[t]; }
 
+  Constant& keep(int t) { return *_keep[t]; }
+
   Function& policy(int t) { return *_policy[t]; }
 
+  // window of time steps
+  Unroll& unroll() { return *_unroll; }
+
 private:
   // graph references
   std::vector<Constant*> _input;
+  std::vector<Constant*> _keep;
   std::vector<Function*> _policy;
+  Unroll* _unroll;
 };
 
 #endif /* _SEEGNIFY_CIFARRLMODEL_H_ */
@@ -19,6 +19,7 @@
 
 // RL model params
 #define STEPS   10
+#define WINDOW  5
 #define HIDDEN  500
 #define INPUT   (3 * VIEW_ROWS * VIEW_COLS)
 #define OUTPUT  (LABELS + NUM_OF_ACTIONS)
@@ -32,50 +33,68 @@ using namespace seegnify;
 class MNISTRLModel
 {
 public:
-  MNISTRLModel(Graph& g)
+  MNISTRLModel(Graph& g, int batch)
   {
     // graph dimensions
     const int SIZE = INPUT + HIDDEN + OUTPUT;
 
-    // network hidden input
-    Function *h1 = g.new_constant(SIZE, 1);
-    Function *h2 = g.new_constant(SIZE, 1);
-    Function *h3 = g.new_constant(SIZE, 1);
-    h1->value() = Tensor::Zero(SIZE, 1);
-    h2->value() = Tensor::Zero(SIZE, 1);
-    h3->value() = Tensor::Zero(SIZE, 1);
+    // network hidden input, one row per environment
+    std::vector<Tensor> hidden(2, Tensor::Zero(batch, SIZE));
 
-    // network hidden state
-    Function *c1(h1), *c2(h2), *c3(h3);
+    Linear *l1 = nullptr, *l2 = nullptr;
+    GRU *g1 = nullptr, *g2 = nullptr;
 
-    // recurrent network over time
-    for (int t=0; t<STEPS; t++)
+    // recurrent network over window of time steps sharing weights
+    auto step = [&](int t, const std::vector<Function*>& h)
     {
       // input
-      _input.push_back(g.new_constant(INPUT, 1));
+      _input.push_back(g.new_constant(batch, INPUT));
       auto x = _input.back();
 
-      h1 = g.new_tanh(*g.new_linear(*x, INPUT, SIZE));
+      // hidden state kept in rows of continued episodes
+      _keep.push_back(g.new_constant(batch, 1));
+      auto& keep = *_keep.back();
+      auto& h0 = *h[0] * *g.new_broadcast(keep, *h[0]);
+      auto& h1 = *h[1] * *g.new_broadcast(keep, *h[1]);
 
-      h2 = g.new_gru(*h1, *h2, SIZE, SIZE);
+      l1 = (t == 0) ? g.new_linear(*x, INPUT, SIZE) : g.new_linear(*x, *l1);
+      auto a1 = g.new_tanh(*l1);
 
-      h3  = g.new_gru(*h2, *h3, SIZE, SIZE);
+      g1 = (t == 0) ? g.new_gru(*a1, h0, SIZE, SIZE) :
+        g.new_gru(*a1, h0, *g1);
 
-      auto y = g.new_linear(*h3, SIZE, OUTPUT);
+      g2 = (t == 0) ? g.new_gru(*g1, h1, SIZE, SIZE) :
+        g.new_gru(*g1, h1, *g2);
 
-      // action policy
-      _policy.push_back(g.new_softmax(*y));
-    }
+      l2 = (t == 0) ? g.new_linear(*g2, SIZE, OUTPUT) : g.new_linear(*g2, *l2);
+
+      // action policy of each environment
+      _policy.push_back(g.new_softmax(*l2, ROWWISE));
+
+      return std::vector<Function*>{ g1, g2 };
+    };
+
+    _unroll = new Unroll(g, WINDOW, hidden, step);
   }
 
+  ~MNISTRLModel() { delete _unroll; }
+
+  // input, hidden state mask and policy of window slot t
   Constant& input(int t) { return *_input[t]; }
 
+  Constant& keep(int t) { return *_keep[t]; }
+
   Function& policy(int t) { return *_policy[t]; }
 
+  // window of time steps
+  Unroll& unroll() { return *_unroll; }
+
 private:
   // graph references
   std::vector<Constant*> _input;
+  std::vector<Constant*> _keep;
   std::vector<Function*> _policy;
+  Unroll* _unroll;
 };
 
 #endif /* _SEEGNIFY_MNISTRLMODEL_H_ */
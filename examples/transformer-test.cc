@@ -15,6 +15,7 @@
 #include "external/thread-pool-11/ThreadPool.h"
 
 #include "examples/transformer.hh"
+#include "utils/numpy.hh"
 #include "utils/unittest.hh"
 
 bool isApprox(const Tensor& A, const Tensor& B, DTYPE eps)
@@ -121,6 +122,104 @@ void test_cnpy()
   TEST_END()
 }
 
+void test_numpy_mapped()
+{
+  TEST_BEGIN("Numpy Mapped")
+
+  int NUM_LAYERS = 1;
+  int NUM_HEADS = 2;
+  int EMB_SIZE = 8;
+  int SEQ_SIZE = 6;
+  int FF_SIZE = 5;
+  DTYPE DROPOUT = 0.0;
+
+  int SRC_TOKENS = 10;
+  int TGT_TOKENS = 10;
+  int BOS_TOKEN = 8;
+  int PAD_TOKEN = 0;
+
+  // differently seeded models
+  Graph g1, g2;
+  g1.random().seed(1);
+  g2.random().seed(2);
+
+  Transformer T1(g1, SRC_TOKENS, TGT_TOKENS, PAD_TOKEN,
+    NUM_LAYERS, NUM_HEADS, EMB_SIZE, FF_SIZE, SEQ_SIZE, DROPOUT);
+  Transformer T2(g2, SRC_TOKENS, TGT_TOKENS, PAD_TOKEN,
+    NUM_LAYERS, NUM_HEADS, EMB_SIZE, FF_SIZE, SEQ_SIZE, DROPOUT);
+
+  save_numpy("transformer-mapped.npz", g1);
+
+  // archive readable by cnpy
+  auto vars = g1.named_variables();
+  cnpy::npz_t npz = cnpy::npz_load("transformer-mapped.npz");
+  ASSERT(npz.size() == vars.size())
+  for (const auto& it: vars)
+  {
+    auto& arr = npz[it.first];
+    auto& value = it.second->value();
+    ASSERT(arr.num_vals == value.size())
+    ASSERT(ConstTensorMap(arr.data<DTYPE>(), value.rows(), value.cols()) ==
+      value)
+  }
+
+  // aligned views into the mapped archive
+  NumpyFile file("transformer-mapped.npz");
+  ASSERT(file.size() == vars.size())
+  for (int i=0; i<file.size(); i++)
+  {
+    auto& value = vars[file.name(i)]->value();
+    auto view = file.tensor(i);
+    ASSERT((uintptr_t)view.data() % 64 == 0)
+    ASSERT(view == value)
+    ASSERT(file.shape(i).size() == (value.rows() == 1 ? 1 : 2))
+  }
+
+  // variables bound to the archive give the same output
+  ASSERT(load_numpy("transformer-mapped.npz", g2) == vars.size())
+
+  std::vector<int> src = {4, 2, 7, 1, PAD_TOKEN, PAD_TOKEN};
+  std::vector<int> tgt = {BOS_TOKEN, 5, 1, 6, 3, PAD_TOKEN};
+  auto& y1 = T1.forward(src, tgt);
+  auto& y2 = T2.forward(src, tgt);
+  ASSERT(y1 == y2)
+
+  // archive and array written by cnpy
+  Tensor two = Tensor::Random(5, 10);
+  cnpy::npz_save("transformer-cnpy.npz", "varTwo", two.data(), {5,10}, "w");
+  cnpy::npz_save("transformer-cnpy.npz", "varOne", two.data(), {5}, "a");
+  cnpy::npy_save("transformer-cnpy.npy", two.data(), {5,10});
+
+  NumpyFile npz_file("transformer-cnpy.npz");
+  ASSERT(npz_file.size() == 2)
+  Tensor copy;
+  npz_file.copy(npz_file.find("varTwo"), copy);
+  ASSERT(copy == two)
+  npz_file.copy(npz_file.find("varOne"), copy);
+  ASSERT(copy.rows() == 1 && copy.cols() == 5)
+  ASSERT(copy == two.block(0, 0, 1, 5))
+  ASSERT(npz_file.find("varThree") == -1)
+
+  NumpyFile npy_file("transformer-cnpy.npy");
+  ASSERT(npy_file.size() == 1)
+  ASSERT(npy_file.name(0) == "transformer-cnpy")
+  npy_file.copy(0, copy);
+  ASSERT(copy == two)
+
+  // arrays of other shape are rejected
+  std::vector<std::string> names = {vars.begin()->first};
+  std::vector<const Tensor*> tensors = {&two};
+  NumpyFile::write("transformer-shape.npz", names, tensors);
+  try
+  {
+    load_numpy("transformer-shape.npz", g2);
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  TEST_END()
+}
+
 void test_thread_pool() {
     int num_threads = 2;
     ThreadPool pool(num_threads);
@@ -2025,9 +2124,154 @@ void test_transformer_backward()
     TEST_END()
 }
 
+void test_transformer_decode()
+{
+    TEST_BEGIN("Transformer Cached Decode")
+
+    int NUM_LAYERS = 2;
+    int NUM_HEADS = 2;
+    int EMB_SIZE = 8;
+    int SEQ_SIZE = 6;
+    int FF_SIZE = 5;
+    DTYPE DROPOUT = 0.0;
+
+    int SRC_TOKENS = 10;
+    int TGT_TOKENS = 10;
+    int BOS_TOKEN = 8;
+    int PAD_TOKEN = 0;
+
+    Graph g;
+
+    Transformer T(g, SRC_TOKENS, TGT_TOKENS, PAD_TOKEN,
+      NUM_LAYERS, NUM_HEADS, EMB_SIZE, FF_SIZE, SEQ_SIZE, DROPOUT);
+
+    std::vector<int> src_x = {4, 2, 7, 3, PAD_TOKEN, PAD_TOKEN};
+    std::vector<int> tgt_x = {BOS_TOKEN, 5, 1, 6, 2, 3};
+
+    // cache is reused by the second sequence
+    Transformer::Cache cache;
+    T.encode({1, 1, 1, 1, 1, 1}, cache);
+    T.decode(BOS_TOKEN, cache);
+    T.encode(src_x, cache);
+
+    // each decoded row matches full decoder pass over target prefix
+    for (int i=0; i<SEQ_SIZE; i++)
+    {
+      std::vector<int> prefix(SEQ_SIZE, PAD_TOKEN);
+      std::copy(tgt_x.begin(), tgt_x.begin() + i + 1, prefix.begin());
+
+      g.recache();
+      T.recache();
+      Tensor y_full = T.forward(src_x, prefix).row(i);
+      Tensor y_step = T.decode(tgt_x[i], cache);
+
+      ASSERT(y_step.isApprox(y_full, 0.0001))
+    }
+
+    TEST_END()
+}
+
+void test_transformer_packed()
+{
+    TEST_BEGIN("Transformer Packed Forward")
+
+    int NUM_LAYERS = 2;
+    int NUM_HEADS = 2;
+    int EMB_SIZE = 8;
+    int SEQ_SIZE = 6;
+    int FF_SIZE = 5;
+    DTYPE DROPOUT = 0.0;
+
+    int SRC_TOKENS = 10;
+    int TGT_TOKENS = 10;
+    int BOS_TOKEN = 8;
+    int PAD_TOKEN = 0;
+
+    Graph g;
+
+    Transformer T(g, SRC_TOKENS, TGT_TOKENS, PAD_TOKEN,
+      NUM_LAYERS, NUM_HEADS, EMB_SIZE, FF_SIZE, SEQ_SIZE, DROPOUT);
+
+    std::vector<std::vector<int>> src_x = {{4, 2, 7}, {1, 5, 6, 3, 2, 9}};
+    std::vector<std::vector<int>> tgt_x = {{BOS_TOKEN, 5, 1, 6}, {BOS_TOKEN}};
+
+    Tensor y_packed = T.forward(src_x, tgt_x);
+    ASSERT(y_packed.rows() == 5)
+
+    // rows of each sequence match its padded forward pass
+    int row = 0;
+    for (int i=0; i<src_x.size(); i++)
+    {
+      auto src = src_x[i];
+      auto tgt = tgt_x[i];
+      int tgt_size = tgt.size();
+      src.resize(SEQ_SIZE, PAD_TOKEN);
+      tgt.resize(SEQ_SIZE, PAD_TOKEN);
+
+      g.recache();
+      T.recache();
+      auto& y = T.forward(src, tgt);
+
+      ASSERT(y.topRows(tgt_size).isApprox(y_packed.middleRows(row, tgt_size),
+        0.0001))
+      row += tgt_size;
+    }
+
+    TEST_END()
+}
+
+void test_transformer_checkpoint()
+{
+    TEST_BEGIN("Transformer Checkpoint")
+
+    int NUM_LAYERS = 2;
+    int NUM_HEADS = 2;
+    int EMB_SIZE = 8;
+    int SEQ_SIZE = 6;
+    int FF_SIZE = 5;
+    DTYPE DROPOUT = 0.1;
+
+    int SRC_TOKENS = 10;
+    int TGT_TOKENS = 10;
+    int BOS_TOKEN = 8;
+    int PAD_TOKEN = 0;
+
+    // equally seeded graphs, the second one checkpointed per layer
+    Graph g1, g2;
+    g1.random().seed(7);
+    g2.random().seed(7);
+
+    Transformer T1(g1, SRC_TOKENS, TGT_TOKENS, PAD_TOKEN,
+      NUM_LAYERS, NUM_HEADS, EMB_SIZE, FF_SIZE, SEQ_SIZE, DROPOUT);
+    Transformer T2(g2, SRC_TOKENS, TGT_TOKENS, PAD_TOKEN,
+      NUM_LAYERS, NUM_HEADS, EMB_SIZE, FF_SIZE, SEQ_SIZE, DROPOUT, true);
+
+    std::vector<int> src = {4, 2, 7, 1, PAD_TOKEN, PAD_TOKEN};
+    std::vector<int> tgt = {BOS_TOKEN, 5, 1, 6, 3, PAD_TOKEN};
+
+    auto& y1 = T1.forward(src, tgt);
+    auto& y2 = T2.forward(src, tgt);
+    ASSERT(y1.isApprox(y2, 0.0001))
+
+    // gradients of recomputed layers match stored activations
+    g1.backward(T1, Tensor::Ones(y1.rows(), y1.cols()));
+    g2.backward(T2, Tensor::Ones(y2.rows(), y2.cols()));
+
+    auto& v1 = g1.variables();
+    auto& v2 = g2.variables();
+    ASSERT(v1.size() == v2.size())
+    for (int i=0; i<v1.size(); i++)
+    {
+        ASSERT(v1[i]->gradient().isApprox(v2[i]->gradient(), 0.001))
+    }
+
+    TEST_END()
+}
+
 int main(int argc, char* argv[]) {
 
     test_cnpy();
+    test_numpy_mapped();
     test_thread_pool();
 
     test_sequence_mask();
@@ -2045,6 +2289,9 @@ int main(int argc, char* argv[]) {
     test_decoder_layer_backward();
     test_transformer_forward();
     test_transformer_backward();
+    test_transformer_decode();
+    test_transformer_packed();
+    test_transformer_checkpoint();
 
     return 0;
 }
@@ -7,7 +7,7 @@
 #include "main/optimizer.hh"
 #include "utils/training.hh"
 #include "utils/storage.hh"
-#include "external/cnpy/cnpy.h"
+#include "utils/numpy.hh"
 
 #include "transformer.hh"
 
@@ -80,17 +80,19 @@ public:
       [&](Function& row) { return g.new_log_softmax(row); });
     g.name(y, "softmax_y");
 
-    // expected output
-    _y_hat = new SequenceMask(g, PAD_TOKEN, SEQ_SIZE);
-    g.keep(_y_hat);
-    
+    // expected output token of each row
+    _y_hat = g.new_constant();
+
     // loss
-    _loss = g.new_sum(- *_y_hat * *y); // cross entropy
+    _loss = g.new_sum(- *g.new_gather(*y, *_y_hat)); // cross entropy
 
     // optimizer
     _optimizer = new Adam(g.variables(), 0.0001);
     //_optimizer = new SGD(g.variables(), 0.1, 0.1);
 
+    // transfer weights and updates in bf16
+    precision(BF16);
+
     // counters
     _batch = 0;
   }
@@ -166,57 +168,34 @@ public:
     return text;
   }
 
-  // generate output mask for training loss
-  Tensor output_mask(const std::vector<int>& tgt)
+  // unpadded source sequence
+  std::vector<int> packed_source(const std::string& text)
   {
-    Tensor mask = Tensor::Zero(SEQ_SIZE, TGT_TOKENS);
-
-    auto it = std::find(tgt.begin(), tgt.end(), PAD_TOKEN);
-    size_t tgt_size = ((it != tgt.end()) ? it - tgt.begin() : tgt.size()) - 1;
-
-    // one-hot token
-    for (int i=0; i<tgt_size; i++)
-    {
-      mask(i, tgt[i + 1]) = 1; // i + 1 for BOS
-    }
-
-    // one-hot EOS
-    mask(tgt_size, EOS_TOKEN) = 1;
-    return mask;
+    auto size = std::min<int>(text.size(), SEQ_SIZE);
+    return std::vector<int>(text.begin(), text.begin() + size);
   }
 
-  void save_numpy(const std::string& filepath)
+  // unpadded target sequence with BOS
+  std::vector<int> packed_target(const std::string& text)
   {
-    int count = 0;
-    auto vars = graph().named_variables();
-
-    for (const auto& it: vars)
-    {
-      auto name = it.first;
-      auto var = it.second;
-      auto data = var->value().data();
-      size_t rows = var->value().rows();
-      size_t cols = var->value().cols();
-
-      std::string mode = (count) ? "a" : "w"; // a to append, w to create
-      if (rows == 1)
-      {
-        cnpy::npz_save(filepath, name, data, {cols}, mode);
-      }
-      else
-      {
-        cnpy::npz_save(filepath, name, data, {rows, cols}, mode);
-      }
+    auto size = std::min<int>(text.size(), SEQ_SIZE - 1); // 1 for BOS
+    std::vector<int> tokens(1, BOS_TOKEN);
+    tokens.insert(tokens.end(), text.begin(), text.begin() + size);
+    return tokens;
+  }
 
-      count+=1;
-    }
+  // append expected tokens of target rows, next token or EOS
+  void output_tokens(const std::vector<int>& tgt, std::vector<int>& out)
+  {
+    out.insert(out.end(), tgt.begin() + 1, tgt.end()); // 1 for BOS
+    out.push_back(EOS_TOKEN);
   }
 
   virtual void batch_train()
   {
     if (worker() == 0 && _batch == 0)
     {
-      save_numpy("transformer-cpp.npz");
+      save_numpy("transformer-cpp.npz", graph());
     }
 
     // restore references
@@ -229,35 +208,38 @@ public:
     // select training batch
     g.random().shuffle(_train_batch.begin(), _train_batch.end());
 
-    // batch train
+    // pack batch sequences without padding
+    std::vector<std::vector<int>> src_x, tgt_x;
+    std::vector<int> y_hat;
     for (int i=0; i<batch_size; i++)
     {
-      g.recache();
-
-      // training sample
       auto& x = _train_data[_train_batch[i]];
-      auto src_x = source_tokens(x.first);
-      auto tgt_x = target_tokens(x.second);
+      src_x.push_back(packed_source(x.first));
+      tgt_x.push_back(packed_target(x.second));
+      output_tokens(tgt_x.back(), y_hat);
+    }
 
-      // loss mask
-      _y_hat->value() = output_mask(tgt_x);
+    g.recache();
 
-      // set model inputs
-      auto& y = _model->forward(src_x, tgt_x);
+    // expected tokens
+    _y_hat->value() = Tensor(y_hat.size(), 1);
+    for (int i=0; i<y_hat.size(); i++) _y_hat->value()(i) = y_hat[i];
 
-      // traning loss
-      auto& loss = _loss->forward();
-      if (worker() == 0)
-      {
-        std::cout << "time:" << time_to_string(time_now())
-                  << " loss:" << loss
-                  << std::endl;
-      }
+    // set model inputs
+    auto& y = _model->forward(src_x, tgt_x);
 
-      // backward pass from loss
-      g.backward(*_loss, loss.array().min(Tensor::Ones(1,1).array()));
+    // traning loss
+    auto& loss = _loss->forward();
+    if (worker() == 0)
+    {
+      std::cout << "time:" << time_to_string(time_now())
+                << " loss:" << loss
+                << std::endl;
     }
 
+    // backward pass from loss
+    g.backward(*_loss, loss.array().min(Tensor::Ones(1,1).array()));
+
     /*
     if (worker() == 0)
     {
@@ -329,7 +311,7 @@ private:
   std::vector<int> _train_batch;
   Transformer *_model;
   Optimizer *_optimizer;
-  SequenceMask* _y_hat;
+  Constant* _y_hat;
   Function* _loss;
   int _batch;
 };
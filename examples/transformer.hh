@@ -26,15 +26,23 @@ public:
 
   void source(const std::vector<int>& src_seq)
   {
-    _value = Tensor::Zero(_seq_size, _seq_size);
+    _value = padding(src_seq).replicate(_seq_size, 1);
+  }
+
+  // mask row [1 x seq_size] of source padding
+  Tensor padding(const std::vector<int>& src_seq) const
+  {
+    Tensor row = Tensor::Zero(1, _seq_size);
 
     size_t padding = _seq_size - sequence_size(src_seq);
 
     if (padding)
     {
       DTYPE inf = std::numeric_limits<DTYPE>::infinity();
-      _value.rightCols(padding) = Tensor::Constant(_seq_size, padding, -inf);
+      row.rightCols(padding) = Tensor::Constant(1, padding, -inf);
     }
+
+    return row;
   }
 
   void target(const std::vector<int>& tgt_seq)
@@ -54,7 +62,7 @@ public:
 protected:
 
   // determine actual sequence size
-  int sequence_size(const std::vector<int>& sequence)
+  int sequence_size(const std::vector<int>& sequence) const
   {
     auto it = std::find(sequence.begin(), sequence.end(), _pad_token);
 
@@ -69,6 +77,14 @@ private:
   const int _seq_size;
 };
 
+// inference of linear function without graph
+inline Tensor linear(Linear& f, const Tensor& x)
+{
+  Tensor y = x * f.W().forward().transpose();
+  y.rowwise() += f.b().forward().row(0);
+  return y;
+}
+
 
 ///////////////////////////////////
 // Scaled Dot-Product Attention
@@ -115,12 +131,12 @@ public:
     // complete qkv attention []
     _attention = _graph.new_product(*_attention, _v);
 
-    _attention->derivative(_graph.new_iderivative(*this));
+    identity(*_attention);
   }
 
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     _value = _attention->forward();
 
@@ -136,128 +152,6 @@ protected:
 };
 
 
-///////////////////////////////////
-// Multi-Head Attention
-///////////////////////////////////
-class MultiHeadAttention : public Function
-{
-public:
-  MultiHeadAttention(
-    Graph& g, Function& q, Function& k, Function& v, Function& mask,
-    int trg_size, int seq_size, int emb_size, int num_heads,
-    bool bias = true, DTYPE dropout = 0.0) :
-    Function(g)
-  {
-    const int L = trg_size; // q.rows()
-    const int S = seq_size; // k.rows()
-    const int E = emb_size; // v.cols()
-    const int H = num_heads;
-    const int D = emb_size / num_heads;
-
-    auto q_heads = split_heads(linear(q, E, E, bias, "Wq", "bq"), H, S, D);
-    auto k_heads = split_heads(linear(k, E, E, bias, "Wk", "bk"), H, S, D);
-    auto v_heads = split_heads(linear(v, E, E, bias, "Wv", "bv"), H, S, D);
-
-    std::vector<Function*> heads(num_heads, nullptr);
-
-    for (int i=0; i<num_heads; i++)
-    {
-      heads[i] = new ScaledDotProductAttention(
-        _graph, *q_heads[i], *k_heads[i], *v_heads[i], mask, L, S, H, dropout
-      );
-      _graph.keep(heads[i]);
-    }
-
-    _attention = &linear(join_heads(heads, S, D), E, E, bias, "Wo", "bo");
-
-    _attention->derivative(_graph.new_iderivative(*this));
-  }
-
-  virtual const Tensor& forward()
-  {
-    if (_value.size() > 0) return _value;
-
-    // TODO: run attention heads in parallel using thread pool
-
-    _value = _attention->forward();
-
-    return _value;
-  }
-  
-private:
-  Function& linear(Function& x, int in, int out, bool bias,
-  const std::string& w_name, const std::string& b_name)
-  {
-    auto W = _graph.new_variable(out, in, ("MHA." + w_name).c_str());
-    auto y = _graph.new_product(x, *_graph.new_transpose(*W));
-
-    if (bias)
-    {
-      auto b = _graph.new_variable(1, out, ("MHA." + b_name).c_str());
-      return *y + *_graph.new_broadcast(*b, *y);
-    }
-    else
-    {
-      return *y;
-    }
-  }
-
-  std::vector<Function*> split_heads(
-    Function& x, int num_heads, int seq_size, int head_size
-  )
-  {
-    std::vector<Function*> heads(num_heads, nullptr);
-
-    // sequence length, head size
-    int S = seq_size;
-    int D = head_size;
-
-    // split horizontally
-    for (int i=0; i<num_heads; i++)
-    {
-      heads[i] = _graph.new_split(x, 0,i*D, S,D);
-    }
-
-    return heads;
-  }
-
-  Function& join_heads(
-    const std::vector<Function*>& heads, int seq_size, int head_size
-  )
-  {
-    // sequence length, head size
-    int S = seq_size;
-    int D = head_size;
-
-    int num_heads = heads.size();
-
-    Function* joined = nullptr;
-
-    // join horizontally
-    for (int i=0; i<num_heads; i++)
-    {
-      // transpose for row-major join
-      auto head = _graph.new_transpose(*heads[i]);
-
-      if (joined)
-      {
-        joined = _graph.new_join(*joined, *head, (i+1)*D,S);
-      }
-      else
-      {
-        joined = head;
-      }
-    }
-
-    // inverse the transpose
-    return *_graph.new_transpose(*joined);
-  }
-
-private:
-  Function *_attention;
-};
-
-
 ///////////////////////////////////
 // PositionWiseFeedForward
 ///////////////////////////////////
@@ -268,20 +162,27 @@ public:
     Graph& g, Function& x, int emb_size, int ff_size, DTYPE dropout = 0.0) :
     Function(g)
   {
-    _y = g.new_linear(x, emb_size, ff_size, true);
-    _y = g.new_relu(*_y);
+    _l1 = g.new_linear(x, emb_size, ff_size, true);
+    _y = g.new_relu(*_l1);
     if (dropout > 0)
     {
       _y = g.new_dropout(*_y, dropout);
     }
-    _y = g.new_linear(*_y, ff_size, emb_size, true);
+    _l2 = g.new_linear(*_y, ff_size, emb_size, true);
+    _y = _l2;
+
+    identity(*_y);
+  }
 
-    _y->derivative(g.new_iderivative(*this));
+  // inference without dropout
+  Tensor infer(const Tensor& x)
+  {
+    return linear(*_l2, linear(*_l1, x).cwiseMax(0));
   }
 
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     // update value
     _value = _y->forward();
@@ -290,6 +191,8 @@ public:
   }
 
 private:
+  Linear* _l1;
+  Linear* _l2;
   Function* _y;
 };
 
@@ -318,25 +221,48 @@ public:
     _pe(Eigen::all, Eigen::seq(0, emb_size-1, 2)) = prod.array().sin();
     _pe(Eigen::all, Eigen::seq(1, emb_size-1, 2)) = prod.array().cos();
 
-    _x.derivative(g.new_iderivative(*this));
+    identity(_x);
   }
 
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     auto& x = _x.forward();
     int seq_size = x.rows();
 
+    if (_offsets.size())
+    {
+      // positions restart at each packed sequence
+      _value = x;
+      for (int i=1; i<_offsets.size(); i++)
+      {
+        int rows = _offsets[i] - _offsets[i-1];
+        _value.middleRows(_offsets[i-1], rows) += _pe.topRows(rows);
+      }
+      return _value;
+    }
+
     // update value
     _value = x + _pe(Eigen::seqN(0, seq_size), Eigen::all);
 
     return _value;
   }
 
+  // cumulative rows [0, n1, n1 + n2, ...] of packed sequences,
+  // empty for one sequence
+  void pack(const std::vector<int>& offsets) { _offsets = offsets; }
+
+  // encoding of x rows at positions starting from offset
+  Tensor infer(const Tensor& x, int offset)
+  {
+    return x + _pe.middleRows(offset, x.rows());
+  }
+
 private:
   Tensor _pe;
   Function& _x;
+  std::vector<int> _offsets;
 };
 
 ///////////////////////////////////
@@ -346,13 +272,16 @@ class RowwiseNorm : public Function
 {
 public:
   RowwiseNorm(Graph& g, Function& x, int rows, int cols, DTYPE eps = EPSILON) :
-  Function(g)
+  Function(g), _eps(eps)
   {
     // apply row-wise Norm with shared weights
     _y = _graph.new_rowwise(x, rows, cols, 
-      [&](Function& row)
+      [&](Function& row) -> Function*
       {
-        return _graph.new_norm(row, 1, cols, eps);
+        auto norm = _graph.new_norm(row, 1, cols, eps);
+        _a = &norm->A();
+        _b = &norm->B();
+        return norm;
       },
       [&](Function& row, Function& shared)
       {
@@ -360,12 +289,12 @@ public:
       }
     );
 
-    _y->derivative(g.new_iderivative(*this));
+    identity(*_y);
   }
 
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     // update value
     _value = _y->forward();
@@ -373,7 +302,21 @@ public:
     return _value;
   }
 
+  // inference of each row of x
+  Tensor infer(const Tensor& x)
+  {
+    Tensor x_mean = x.colwise() - x.rowwise().mean();
+    ColVector std = (x_mean.array().square().rowwise().mean() + _eps).sqrt();
+    Tensor y = x_mean.array().colwise() / std.array();
+    y.array().rowwise() *= _a->forward().row(0).array();
+    y.rowwise() += _b->forward().row(0);
+    return y;
+  }
+
 private:
+  const DTYPE _eps;
+  Variable* _a;
+  Variable* _b;
   Function* _y;
 };
 
@@ -388,36 +331,58 @@ public:
     int seq_size, int emb_size, int num_heads, int ff_size, DTYPE dropout) :
     Function(g)
   {
-    auto attn = new MultiHeadAttention(g, x, x, x, mask,
+    _attn = new MultiHeadAttention(g, x, x, x, mask,
       seq_size, seq_size, emb_size, num_heads, true, dropout);
-    g.keep(attn);
+    g.keep(_attn);
 
-    _y = new RowwiseNorm(
-      g, x + *g.new_dropout(*attn, dropout), seq_size, emb_size);
-    g.keep(_y);
+    _norm1 = new RowwiseNorm(
+      g, x + *g.new_dropout(*_attn, dropout), seq_size, emb_size);
+    g.keep(_norm1);
 
-    auto ff = new PositionWiseFeedForward(g, *_y, emb_size, ff_size, dropout);
-    g.keep(ff);
+    _ff = new PositionWiseFeedForward(g, *_norm1, emb_size, ff_size, dropout);
+    g.keep(_ff);
 
-    _y = new RowwiseNorm(
-      g, *_y + *g.new_dropout(*ff, dropout), seq_size, emb_size);
-    g.keep(_y);
+    _norm2 = new RowwiseNorm(
+      g, *_norm1 + *g.new_dropout(*_ff, dropout), seq_size, emb_size);
+    g.keep(_norm2);
 
-    _y->derivative(g.new_iderivative(*this));
+    identity(*_norm2);
   }
 
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     // update value
-    _value = _y->forward();
+    _value = _norm2->forward();
 
     return _value;
   }
 
+  // attend within packed sequences, empty offsets for masked attention
+  void pack(const std::vector<int>& offsets)
+  {
+    if (offsets.empty()) _attn->unpack(); else _attn->pack(offsets, offsets);
+  }
+
+  // attend over tiles of rows, 0 for full attention matrix
+  void tile(int rows) { _attn->tile(rows); }
+
+  // inference without dropout, mask [rows x rows] of x
+  Tensor infer(const Tensor& x, const Tensor& mask)
+  {
+    MultiHeadAttention::Cache kv;
+    _attn->append(x, x, kv);
+
+    Tensor y = _norm1->infer(x + _attn->attend(x, kv, mask));
+    return _norm2->infer(y + _ff->infer(y));
+  }
+
 private:
-  Function* _y;
+  MultiHeadAttention* _attn;
+  PositionWiseFeedForward* _ff;
+  RowwiseNorm* _norm1;
+  RowwiseNorm* _norm2;
 };
 
 ///////////////////////////////////
@@ -431,44 +396,98 @@ public:
     int seq_size, int emb_size, int num_heads, int ff_size, DTYPE dropout) :
     Function(g)
   {
-    auto self_attn = new MultiHeadAttention(g, x, x, x, tgt_mask,
+    _self_attn = new MultiHeadAttention(g, x, x, x, tgt_mask,
       seq_size, seq_size, emb_size, num_heads, true, dropout);
-    g.keep(self_attn);
+    g.keep(_self_attn);
 
-    _y = new RowwiseNorm(
-      g, x + *g.new_dropout(*self_attn, dropout), seq_size, emb_size);
-    g.keep(_y);
+    _norm1 = new RowwiseNorm(
+      g, x + *g.new_dropout(*_self_attn, dropout), seq_size, emb_size);
+    g.keep(_norm1);
 
-    auto cross_attn = new MultiHeadAttention(g, *_y, e, e, src_mask,
+    _cross_attn = new MultiHeadAttention(g, *_norm1, e, e, src_mask,
       seq_size, seq_size, emb_size, num_heads, true, dropout);
-    g.keep(cross_attn);
+    g.keep(_cross_attn);
 
-    _y = new RowwiseNorm(
-      g, *_y + *g.new_dropout(*cross_attn, dropout), seq_size, emb_size);
-    g.keep(_y);
+    _norm2 = new RowwiseNorm(
+      g, *_norm1 + *g.new_dropout(*_cross_attn, dropout), seq_size, emb_size);
+    g.keep(_norm2);
 
-    auto ff = new PositionWiseFeedForward(g, *_y, emb_size, ff_size, dropout);
-    g.keep(ff);
+    _ff = new PositionWiseFeedForward(g, *_norm2, emb_size, ff_size, dropout);
+    g.keep(_ff);
 
-    _y = new RowwiseNorm(
-      g, *_y + *g.new_dropout(*ff, dropout), seq_size, emb_size);
-    g.keep(_y);
+    _norm3 = new RowwiseNorm(
+      g, *_norm2 + *g.new_dropout(*_ff, dropout), seq_size, emb_size);
+    g.keep(_norm3);
 
-    _y->derivative(g.new_iderivative(*this));
+    identity(*_norm3);
   }
 
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     // update value
-    _value = _y->forward();
+    _value = _norm3->forward();
 
     return _value;
   }
 
+  // attend within packed sequences, empty offsets for masked attention
+  void pack(const std::vector<int>& src_offsets,
+  const std::vector<int>& tgt_offsets)
+  {
+    if (tgt_offsets.empty())
+    {
+      _self_attn->unpack();
+      _cross_attn->unpack();
+    }
+    else
+    {
+      _self_attn->pack(tgt_offsets, tgt_offsets, true);
+      _cross_attn->pack(tgt_offsets, src_offsets);
+    }
+  }
+
+  // attend over tiles of rows, 0 for full attention matrix
+  void tile(int rows)
+  {
+    _self_attn->tile(rows);
+    _cross_attn->tile(rows);
+  }
+
+  // keys and values of decoded tokens and encoder output
+  struct Cache
+  {
+    MultiHeadAttention::Cache self;
+    MultiHeadAttention::Cache cross;
+  };
+
+  // reset cache for encoder output e
+  void encode(const Tensor& e, Cache& cache)
+  {
+    cache.self.clear();
+    cache.cross.clear();
+    _cross_attn->append(e, e, cache.cross);
+  }
+
+  // inference of next token row x attending to cached tokens and itself,
+  // src_mask [1 x seq_size] masks encoder output padding
+  Tensor infer(const Tensor& x, const Tensor& src_mask, Cache& cache)
+  {
+    _self_attn->append(x, x, cache.self);
+
+    Tensor y = _norm1->infer(x + _self_attn->attend(x, cache.self));
+    y = _norm2->infer(y + _cross_attn->attend(y, cache.cross, src_mask));
+    return _norm3->infer(y + _ff->infer(y));
+  }
+
 private:
-  Function* _y;
+  MultiHeadAttention* _self_attn;
+  MultiHeadAttention* _cross_attn;
+  PositionWiseFeedForward* _ff;
+  RowwiseNorm* _norm1;
+  RowwiseNorm* _norm2;
+  RowwiseNorm* _norm3;
 };
 
 
@@ -481,34 +500,37 @@ public:
   Transformer(
   Graph& g, int src_tokens, int tgt_tokens, int pad_token,
   int num_layers, int num_heads, int emb_size, int ff_size, int seq_size,
-  DTYPE dropout) : Function(g)
+  DTYPE dropout, bool checkpoint = false) : Function(g), _seq_size(seq_size)
   {
     _src = g.new_constant(1, seq_size);
     _tgt = g.new_constant(1, seq_size);
 
-    auto src_emb = g.new_embedding(*_src, src_tokens, emb_size);
-    auto tgt_emb = g.new_embedding(*_tgt, tgt_tokens, emb_size);
+    _src_emb = g.new_embedding(*_src, src_tokens, emb_size);
+    _tgt_emb = g.new_embedding(*_tgt, tgt_tokens, emb_size);
 
-    auto src_pos = new PositionalEncoding(g, *src_emb, seq_size, emb_size);
-    auto tgt_pos = new PositionalEncoding(g, *tgt_emb, seq_size, emb_size);
-    g.keep(src_pos);
-    g.keep(tgt_pos);
+    _src_pos = new PositionalEncoding(g, *_src_emb, seq_size, emb_size);
+    _tgt_pos = new PositionalEncoding(g, *_tgt_emb, seq_size, emb_size);
+    g.keep(_src_pos);
+    g.keep(_tgt_pos);
 
     _src_mask = new SequenceMask(g, pad_token, seq_size);
     _tgt_mask = new SequenceMask(g, pad_token, seq_size);
     g.keep(_src_mask);
     g.keep(_tgt_mask);
 
-    _encoder = g.new_dropout(*src_pos, dropout);
-    _decoder = g.new_dropout(*tgt_pos, dropout);
+    _encoder = g.new_dropout(*_src_pos, dropout);
+    _decoder = g.new_dropout(*_tgt_pos, dropout);
 
     // encoder layers
     g.scope_push("encoder");
     for (int i=0; i<num_layers; i++)
     {
-      _encoder = new EncoderLayer(g, *_encoder, *_src_mask,
+      auto layer = new EncoderLayer(g, *_encoder, *_src_mask,
         seq_size, emb_size, num_heads, ff_size, dropout);
-      g.keep(_encoder);
+      g.keep(layer);
+      _encoders.push_back(layer);
+      _encoder = layer;
+      if (checkpoint) _encoder = g.new_checkpoint(*layer);
     }
     g.scope_pop();
 
@@ -516,21 +538,25 @@ public:
     g.scope_push("decoder");
     for (int i=0; i<num_layers; i++)
     {
-      _decoder = new DecoderLayer(g, *_decoder, *_encoder, *_src_mask,
+      auto layer = new DecoderLayer(g, *_decoder, *_encoder, *_src_mask,
         *_tgt_mask, seq_size, emb_size, num_heads, ff_size, dropout);
-      g.keep(_decoder);
+      g.keep(layer);
+      _decoders.push_back(layer);
+      _decoder = layer;
+      if (checkpoint) _decoder = g.new_checkpoint(*layer);
     }
     g.scope_pop();
 
-    _decoder = g.new_linear(*_decoder, emb_size, tgt_tokens);
+    _output = g.new_linear(*_decoder, emb_size, tgt_tokens);
+    _decoder = _output;
 
-    _decoder->derivative(g.new_iderivative(*this));
+    identity(*_decoder);
   }
 
   // requires src and tgt sequences
   virtual const Tensor& forward()
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
 
     // run transformer
     _value = _decoder->forward();
@@ -543,7 +569,9 @@ public:
     const std::vector<int>& src, const std::vector<int>& tgt
   )
   {
-    if (_value.size() > 0) return _value;
+    if (cached()) return _value;
+
+    pack({}, {});
 
     // update source input tensor
     _src->value() = Tensor::Zero(1, src.size());
@@ -560,38 +588,111 @@ public:
     return forward();
   }
 
-  // forward with automatic setting of src and tgt sequences
+  // forward of unpadded sequences packed into consecutive rows, output
+  // row of each tgt token follows the order of tgt sequences
+  const Tensor& forward(
+    const std::vector<std::vector<int>>& src,
+    const std::vector<std::vector<int>>& tgt
+  )
+  {
+    if (cached()) return _value;
+
+    if (src.size() != tgt.size())
+      throw std::runtime_error("Incompatible number of packed sequences");
+
+    // concatenate tokens
+    std::vector<int> src_offsets(1, 0), tgt_offsets(1, 0);
+    _src->value() = pack_tokens(src, src_offsets);
+    _tgt->value() = pack_tokens(tgt, tgt_offsets);
+
+    pack(src_offsets, tgt_offsets);
+
+    return forward();
+  }
+
+  // stream attention of all layers over tiles of rows to keep memory
+  // linear in sequence size, 0 for full attention matrices
+  void tile(int rows)
+  {
+    for (auto layer: _encoders) layer->tile(rows);
+    for (auto layer: _decoders) layer->tile(rows);
+  }
+
+  // decoding state of one sequence, copy to branch beams
+  struct Cache
+  {
+    std::vector<DecoderLayer::Cache> layers;
+    Tensor src_mask;
+    int size;
+  };
+
+  // encode source once and reset decoding state
+  void encode(const std::vector<int>& src, Cache& cache)
+  {
+    int seq_size = src.size();
+    auto& E = _src_emb->E().forward();
+
+    Tensor x(seq_size, E.cols());
+    for (int i=0; i<seq_size; i++) x.row(i) = E.row(src[i]);
+    x = _src_pos->infer(x, 0);
+
+    cache.src_mask = _src_mask->padding(src);
+    Tensor mask = cache.src_mask.replicate(seq_size, 1);
+
+    for (auto layer: _encoders) x = layer->infer(x, mask);
+
+    cache.layers.resize(_decoders.size());
+    for (int i=0; i<_decoders.size(); i++)
+    {
+      _decoders[i]->encode(x, cache.layers[i]);
+    }
+    cache.size = 0;
+  }
+
+  // logits [1 x tgt_tokens] of the token following the given one,
+  // each step attends to cached keys and values of previous tokens
+  Tensor decode(int token, Cache& cache)
+  {
+    if (cache.size >= _seq_size)
+      throw std::runtime_error("Decoded sequence exceeds sequence size");
+
+    Tensor x = _tgt_emb->E().forward().row(token);
+    x = _tgt_pos->infer(x, cache.size);
+
+    for (int i=0; i<_decoders.size(); i++)
+    {
+      x = _decoders[i]->infer(x, cache.src_mask, cache.layers[i]);
+    }
+    cache.size++;
+
+    return linear(*_output, x);
+  }
+
+  // greedy decoding of src, pad_token matches transformer.py generate
   std::vector<int> generate(
     const std::vector<int>& src, int bos_token, int eos_token, int pad_token
   )
   {
-    // create output sequence
-    int seq_size = src.size();
-    std::vector<int> tgt(seq_size, pad_token);
-    int token = bos_token; // initial target token
+    Cache cache;
+    return generate(src, bos_token, eos_token, cache);
+  }
+
+  // greedy decoding of src reusing cache buffers
+  std::vector<int> generate(
+    const std::vector<int>& src, int bos_token, int eos_token, Cache& cache
+  )
+  {
+    encode(src, cache);
 
     // collect output tokens
     std::vector<int> out;
-    Tensor encoder_cache;
+    int token = bos_token; // initial target token
 
     // generate output tokens
-    for (int i=0; i<seq_size && token != eos_token; i++)
+    for (int i=0; i<src.size() && token != eos_token; i++)
     {
-      graph().recache();
-
-      if (encoder_cache.size())
-      {
-        _encoder->value() = encoder_cache;
-      }
-
-      tgt[i] = token; // add previoud token to target
-      token = decode(forward(src, tgt), i); // predict
+      token = argmax(decode(token, cache)); // predict
       out.push_back(token); // add new token to output
-
-      if (!encoder_cache.size())
-      {
-        encoder_cache = _encoder->forward();
-      }
     }
 
     // return generated sequence
@@ -603,18 +704,57 @@ public:
   Function& target() { return *_tgt; }
 
 protected:
-  int decode(const Tensor& output, int row)
+  // tokens [1 x total size] of sequences and their cumulative sizes
+  Tensor pack_tokens(const std::vector<std::vector<int>>& seqs,
+  std::vector<int>& offsets)
+  {
+    for (auto& seq: seqs)
+    {
+      if (seq.empty() || seq.size() > _seq_size)
+        throw std::runtime_error("Invalid packed sequence size");
+      offsets.push_back(offsets.back() + seq.size());
+    }
+
+    Tensor tokens(1, offsets.back());
+    for (int i=0; i<seqs.size(); i++)
+    for (int j=0; j<seqs[i].size(); j++)
+    {
+      tokens(offsets[i] + j) = seqs[i][j];
+    }
+
+    return tokens;
+  }
+
+  // set packed sequence offsets of all layers, empty offsets unpack
+  void pack(const std::vector<int>& src_offsets,
+  const std::vector<int>& tgt_offsets)
+  {
+    _src_pos->pack(src_offsets);
+    _tgt_pos->pack(tgt_offsets);
+    for (auto layer: _encoders) layer->pack(src_offsets);
+    for (auto layer: _decoders) layer->pack(src_offsets, tgt_offsets);
+  }
+
+  int argmax(const Tensor& output)
   {
     Eigen::Index max_col;
-    output.row(row).maxCoeff(&max_col);
+    output.row(0).maxCoeff(&max_col);
     return max_col;
   }
 
 private:
+  const int _seq_size;
   Constant* _src;
   Constant* _tgt;
+  Embedding* _src_emb;
+  Embedding* _tgt_emb;
+  PositionalEncoding* _src_pos;
+  PositionalEncoding* _tgt_pos;
   SequenceMask* _src_mask;
   SequenceMask* _tgt_mask;
+  std::vector<EncoderLayer*> _encoders;
+  std::vector<DecoderLayer*> _decoders;
+  Linear* _output;
   Function* _encoder;
   Function* _decoder;
 };
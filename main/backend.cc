@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef SEEGNIFY_BLAS
+#ifdef SEEGNIFY_MKL
+#include <mkl_cblas.h>
+#else
+#include <cblas.h>
+#endif
+#endif
+
+#include "backend.hh"
+
+namespace seegnify {
+
+// Elementwise kernels are cloned for AVX-512, AVX2 and the baseline target
+// and resolved once at load time, unless the build already targets AVX-512.
+// NEON is the baseline of aarch64 builds.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__AVX512F__)
+#if defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define KERNEL_CLONES
+#endif
+#endif
+#endif
+
+#ifdef KERNEL_CLONES
+#define KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define KERNEL
+#endif
+
+// independent partial sums of the reduction kernel
+#define SUM_LANES 16
+
+///////////////////////////////////////////
+// multi-versioned kernels
+///////////////////////////////////////////
+
+KERNEL static void axpy_kernel(DTYPE a, const DTYPE* x, DTYPE* y, size_t n)
+{
+  for (size_t i=0; i<n; i++) y[i] += a * x[i];
+}
+
+KERNEL static DTYPE sum_kernel(const DTYPE* x, size_t n)
+{
+  DTYPE s[SUM_LANES] = {0};
+
+  size_t i = 0;
+  for (; i + SUM_LANES <= n; i += SUM_LANES)
+  {
+    for (int l=0; l<SUM_LANES; l++) s[l] += x[i + l];
+  }
+
+  DTYPE sum = 0;
+  for (; i<n; i++) sum += x[i];
+  for (int l=0; l<SUM_LANES; l++) sum += s[l];
+
+  return sum;
+}
+
+const char* kernel_isa()
+{
+#ifdef KERNEL_CLONES
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return "avx512f";
+  if (__builtin_cpu_supports("avx2")) return "avx2";
+  return "default";
+#elif defined(__AVX512F__)
+  return "avx512f";
+#elif defined(__ARM_NEON)
+  return "neon";
+#else
+  return "default";
+#endif
+}
+
+///////////////////////////////////////////
+// Eigen backend
+///////////////////////////////////////////
+
+// C = alpha * a * b + beta * C of Eigen expressions
+template <class L, class R>
+static void product(const L& a, const R& b, Tensor& C, DTYPE alpha,
+DTYPE beta)
+{
+  if (beta == 0)
+  {
+    C.noalias() = alpha * (a * b);
+  }
+  else
+  {
+    C *= beta;
+    C.noalias() += alpha * (a * b);
+  }
+}
+
+void Backend::shape(const Tensor& A, bool ta, const Tensor& B, bool tb,
+int& m, int& n, int& k)
+{
+  m = (ta) ? A.cols() : A.rows();
+  k = (ta) ? A.rows() : A.cols();
+  n = (tb) ? B.rows() : B.cols();
+
+  if (k != ((tb) ? B.cols() : B.rows()))
+    throw std::runtime_error("Incompatible product shapes");
+}
+
+void Backend::gemm(const Tensor& A, bool ta, const Tensor& B, bool tb,
+Tensor& C, DTYPE alpha, DTYPE beta) const
+{
+  int m, n, k;
+  shape(A, ta, B, tb, m, n, k);
+
+  if (beta != 0 && (C.rows() != m || C.cols() != n))
+    throw std::runtime_error("Incompatible product output shape");
+
+  if (ta && tb)
+    product(A.transpose(), B.transpose(), C, alpha, beta);
+  else if (ta)
+    product(A.transpose(), B, C, alpha, beta);
+  else if (tb)
+    product(A, B.transpose(), C, alpha, beta);
+  else
+    product(A, B, C, alpha, beta);
+}
+
+void Backend::gemm_batch(const std::vector<const Tensor*>& A, bool ta,
+const std::vector<const Tensor*>& B, bool tb,
+const std::vector<Tensor*>& C) const
+{
+  if (A.size() != B.size() || A.size() != C.size())
+    throw std::runtime_error("Incompatible product batch sizes");
+
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for (int i=0; i<(int)A.size(); i++) gemm(*A[i], ta, *B[i], tb, *C[i]);
+}
+
+void Backend::spmm(const Tensor& A, const SparseTensor& B, bool tb,
+Tensor& C) const
+{
+  if (A.cols() != ((tb) ? B.cols() : B.rows()))
+    throw std::runtime_error("Incompatible product shapes");
+
+  if (tb)
+    C = A * B.transpose();
+  else
+    C = A * B;
+}
+
+void Backend::axpy(DTYPE a, const Tensor& x, Tensor& y) const
+{
+  if (x.rows() != y.rows() || x.cols() != y.cols())
+    throw std::runtime_error("Incompatible axpy shapes");
+
+  axpy_kernel(a, x.data(), y.data(), x.size());
+}
+
+DTYPE Backend::sum(const Tensor& x) const
+{
+  return sum_kernel(x.data(), x.size());
+}
+
+///////////////////////////////////////////
+// BLAS backend
+///////////////////////////////////////////
+
+#ifdef SEEGNIFY_BLAS
+
+static_assert(sizeof(DTYPE) == sizeof(float), "BLAS backend requires float");
+
+class BlasBackend : public Backend
+{
+public:
+  virtual const char* name() const { return "blas"; }
+
+  virtual void gemm(const Tensor& A, bool ta, const Tensor& B, bool tb,
+  Tensor& C, DTYPE alpha, DTYPE beta) const
+  {
+    int m, n, k;
+    shape(A, ta, B, tb, m, n, k);
+
+    if (beta == 0)
+      C.resize(m, n);
+    else if (C.rows() != m || C.cols() != n)
+      throw std::runtime_error("Incompatible product output shape");
+
+    if (m == 0 || n == 0) return;
+
+    cblas_sgemm(CblasRowMajor,
+      (ta) ? CblasTrans : CblasNoTrans, (tb) ? CblasTrans : CblasNoTrans,
+      m, n, k, alpha,
+      A.data(), std::max<int>(1, A.cols()),
+      B.data(), std::max<int>(1, B.cols()),
+      beta, C.data(), n);
+  }
+};
+
+#endif /* SEEGNIFY_BLAS */
+
+///////////////////////////////////////////
+// backend selection
+///////////////////////////////////////////
+
+#ifdef SEEGNIFY_CUDA
+// CUDA backend of the first device, throws without device
+Backend& cuda_backend();
+#endif
+
+std::vector<std::string> backends()
+{
+  std::vector<std::string> names = { "eigen" };
+#ifdef SEEGNIFY_BLAS
+  names.push_back("blas");
+#endif
+#ifdef SEEGNIFY_CUDA
+  names.push_back("cuda");
+#endif
+  return names;
+}
+
+static Backend* find_backend(const std::string& name)
+{
+  static Backend eigen;
+#ifdef SEEGNIFY_BLAS
+  static BlasBackend blas;
+  if (name == "blas") return &blas;
+#endif
+#ifdef SEEGNIFY_CUDA
+  if (name == "cuda") return &cuda_backend();
+#endif
+  if (name == "eigen") return &eigen;
+
+  throw std::runtime_error("Unknown backend " + name);
+}
+
+// backend selected in the environment or host backend, BLAS when built,
+// device backends pay transfers of every product and run only on request
+static Backend* default_backend()
+{
+  auto name = std::getenv("SEEGNIFY_BACKEND");
+  if (name) return find_backend(name);
+
+#ifdef SEEGNIFY_BLAS
+  return find_backend("blas");
+#else
+  return find_backend("eigen");
+#endif
+}
+
+static std::atomic<Backend*>& active_backend()
+{
+  static std::atomic<Backend*> active(default_backend());
+  return active;
+}
+
+Backend& backend()
+{
+  return *active_backend();
+}
+
+void backend(const std::string& name)
+{
+  active_backend() = find_backend(name);
+}
+
+} /* namespace */
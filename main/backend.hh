@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_BACKEND_H_
+#define _SEEGNIFY_BACKEND_H_
+
+#include <string>
+#include <vector>
+
+#include "types.hh"
+
+namespace seegnify {
+
+// Compute backend of the heavy tensor primitives. The default Eigen backend
+// is always available, the BLAS backend (OpenBLAS, MKL or BLIS through their
+// CBLAS interface) is built with SEEGNIFY_BLAS and the CUDA backend (cuBLAS)
+// with SEEGNIFY_CUDA. Backends override products and share the elementwise
+// maps and reductions, which are compiled for several instruction sets and
+// dispatched to the best one of the host.
+class Backend
+{
+public:
+  virtual ~Backend() {}
+
+  // backend name
+  virtual const char* name() const { return "eigen"; }
+
+  // C = alpha * op(A) * op(B) + beta * C, op(X) = X.T when transposed
+  virtual void gemm(const Tensor& A, bool ta, const Tensor& B, bool tb,
+    Tensor& C, DTYPE alpha = 1, DTYPE beta = 0) const;
+
+  // C[i] = op(A[i]) * op(B[i]) of a batch of products
+  virtual void gemm_batch(const std::vector<const Tensor*>& A, bool ta,
+    const std::vector<const Tensor*>& B, bool tb,
+    const std::vector<Tensor*>& C) const;
+
+  // C = A * op(B) of dense A and sparse B
+  virtual void spmm(const Tensor& A, const SparseTensor& B, bool tb,
+    Tensor& C) const;
+
+  // y = a * x + y
+  void axpy(DTYPE a, const Tensor& x, Tensor& y) const;
+
+  // sum of elements
+  DTYPE sum(const Tensor& x) const;
+
+protected:
+  // validate shapes of op(A) * op(B), return rows m, cols n and inner size k
+  static void shape(const Tensor& A, bool ta, const Tensor& B, bool tb,
+    int& m, int& n, int& k);
+};
+
+// names of backends built in
+std::vector<std::string> backends();
+
+// active backend, initially the one named by SEEGNIFY_BACKEND or the BLAS
+// backend when built in, Eigen otherwise
+Backend& backend();
+
+// activate backend by name
+void backend(const std::string& name);
+
+// instruction set of the elementwise kernels on this host
+const char* kernel_isa();
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_BACKEND_H_ */
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include <cuda_runtime.h>
+#include <cublas_v2.h>
+
+#include "backend.hh"
+
+namespace seegnify {
+
+static void check(cudaError_t status, const char* call)
+{
+  if (status != cudaSuccess)
+    throw std::runtime_error(std::string(call) + ": " +
+      cudaGetErrorString(status));
+}
+
+static void check(cublasStatus_t status, const char* call)
+{
+  if (status != CUBLAS_STATUS_SUCCESS)
+    throw std::runtime_error(std::string(call) + ": cuBLAS error " +
+      std::to_string((int)status));
+}
+
+// Device memory growing to the largest size requested
+class DeviceBuffer
+{
+public:
+  DeviceBuffer() : _data(nullptr), _size(0) {}
+
+  ~DeviceBuffer() { if (_data) cudaFree(_data); }
+
+  DeviceBuffer(const DeviceBuffer&) = delete;
+
+  DTYPE* reserve(size_t size)
+  {
+    if (size > _size)
+    {
+      if (_data) check(cudaFree(_data), "cudaFree");
+      _data = nullptr;
+      _size = 0;
+      check(cudaMalloc((void**)&_data, size * sizeof(DTYPE)), "cudaMalloc");
+      _size = size;
+    }
+    return _data;
+  }
+
+  DTYPE* data() const { return _data; }
+
+private:
+  DTYPE* _data;
+  size_t _size;
+};
+
+// Pinned host memory growing to the largest size requested, copies from
+// pinned memory run asynchronously to the host
+class PinnedBuffer
+{
+public:
+  PinnedBuffer() : _data(nullptr), _size(0) {}
+
+  ~PinnedBuffer() { if (_data) cudaFreeHost(_data); }
+
+  PinnedBuffer(const PinnedBuffer&) = delete;
+
+  DTYPE* reserve(size_t size)
+  {
+    if (size > _size)
+    {
+      if (_data) check(cudaFreeHost(_data), "cudaFreeHost");
+      _data = nullptr;
+      _size = 0;
+      check(cudaMallocHost((void**)&_data, size * sizeof(DTYPE)),
+        "cudaMallocHost");
+      _size = size;
+    }
+    return _data;
+  }
+
+  DTYPE* data() const { return _data; }
+
+private:
+  DTYPE* _data;
+  size_t _size;
+};
+
+// Products run on the device on host tensors. Operands are copied to device
+// buffers reused across calls through pinned staging buffers, a product
+// batch copies the operands of the next product on the copy stream while
+// the current one runs on the compute stream, and the host unstages the
+// previous product meanwhile. Calls are serialized on one cuBLAS handle.
+class CudaBackend : public Backend
+{
+public:
+  CudaBackend()
+  {
+    int devices = 0;
+    check(cudaGetDeviceCount(&devices), "cudaGetDeviceCount");
+    if (devices == 0) throw std::runtime_error("No CUDA device");
+
+    check(cudaStreamCreate(&_compute), "cudaStreamCreate");
+    check(cudaStreamCreate(&_copy), "cudaStreamCreate");
+    check(cublasCreate(&_blas), "cublasCreate");
+    check(cublasSetStream(_blas, _compute), "cublasSetStream");
+
+    for (int i=0; i<SLOTS; i++)
+    {
+      check(cudaEventCreateWithFlags(&_copied[i], cudaEventDisableTiming),
+        "cudaEventCreate");
+      check(cudaEventCreateWithFlags(&_computed[i], cudaEventDisableTiming),
+        "cudaEventCreate");
+    }
+  }
+
+  ~CudaBackend()
+  {
+    for (int i=0; i<SLOTS; i++)
+    {
+      cudaEventDestroy(_copied[i]);
+      cudaEventDestroy(_computed[i]);
+    }
+    cublasDestroy(_blas);
+    cudaStreamDestroy(_copy);
+    cudaStreamDestroy(_compute);
+  }
+
+  virtual const char* name() const { return "cuda"; }
+
+  virtual void gemm(const Tensor& A, bool ta, const Tensor& B, bool tb,
+  Tensor& C, DTYPE alpha, DTYPE beta) const
+  {
+    int m, n, k;
+    shape(A, ta, B, tb, m, n, k);
+
+    if (beta == 0)
+      C.resize(m, n);
+    else if (C.rows() != m || C.cols() != n)
+      throw std::runtime_error("Incompatible product output shape");
+
+    if (m == 0 || n == 0) return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    upload(A, B, (beta == 0) ? nullptr : &C, 0, _compute);
+    product(ta, tb, m, n, k, alpha, beta, 0);
+    download(C, 0);
+
+    check(cudaStreamSynchronize(_compute), "cudaStreamSynchronize");
+    unstage(C, 0);
+  }
+
+  virtual void gemm_batch(const std::vector<const Tensor*>& A, bool ta,
+  const std::vector<const Tensor*>& B, bool tb,
+  const std::vector<Tensor*>& C) const
+  {
+    if (A.size() != B.size() || A.size() != C.size())
+      throw std::runtime_error("Incompatible product batch sizes");
+
+    std::vector<int> m(A.size()), n(A.size()), k(A.size());
+    for (int i=0; i<(int)A.size(); i++)
+    {
+      shape(*A[i], ta, *B[i], tb, m[i], n[i], k[i]);
+      C[i]->resize(m[i], n[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // product i computes while operands of product i + 1 are copied
+    if (A.size()) upload(*A[0], *B[0], nullptr, 0, _copy);
+    for (int i=0; i<(int)A.size(); i++)
+    {
+      int slot = i % SLOTS;
+      check(cudaEventRecord(_copied[slot], _copy), "cudaEventRecord");
+
+      if (i + 1 < (int)A.size())
+      {
+        // slot of the next product is free after its previous product,
+        // its staged operands once they were copied
+        int next = (i + 1) % SLOTS;
+        if (i + 1 >= SLOTS)
+        {
+          check(cudaStreamWaitEvent(_copy, _computed[next], 0),
+            "cudaStreamWaitEvent");
+          check(cudaEventSynchronize(_copied[next]), "cudaEventSynchronize");
+        }
+        upload(*A[i + 1], *B[i + 1], nullptr, next, _copy);
+      }
+
+      check(cudaStreamWaitEvent(_compute, _copied[slot], 0),
+        "cudaStreamWaitEvent");
+      if (m[i] && n[i]) product(ta, tb, m[i], n[i], k[i], 1, 0, slot);
+      if (m[i] && n[i]) download(*C[i], slot);
+      check(cudaEventRecord(_computed[slot], _compute), "cudaEventRecord");
+
+      // unstage previous product while this one runs
+      if (i > 0)
+      {
+        int prev = (i - 1) % SLOTS;
+        check(cudaEventSynchronize(_computed[prev]), "cudaEventSynchronize");
+        unstage(*C[i - 1], prev);
+      }
+    }
+
+    check(cudaStreamSynchronize(_compute), "cudaStreamSynchronize");
+    if (A.size()) unstage(*C.back(), (A.size() - 1) % SLOTS);
+  }
+
+private:
+  static const int SLOTS = 2;
+
+  // copy operands through staging buffers into device buffers of a slot
+  void upload(const Tensor& A, const Tensor& B, const Tensor* C, int slot,
+  cudaStream_t stream) const
+  {
+    copy(_A[slot].reserve(A.size()), _hA[slot], A, stream);
+    copy(_B[slot].reserve(B.size()), _hB[slot], B, stream);
+
+    if (C) copy(_C[slot].reserve(C->size()), _hC[slot], *C, stream);
+  }
+
+  static void copy(DTYPE* dst, PinnedBuffer& staging, const Tensor& src,
+  cudaStream_t stream)
+  {
+    if (src.size() == 0) return;
+    auto pinned = staging.reserve(src.size());
+    std::copy(src.data(), src.data() + src.size(), pinned);
+    check(cudaMemcpyAsync(dst, pinned, src.size() * sizeof(DTYPE),
+      cudaMemcpyHostToDevice, stream), "cudaMemcpyAsync");
+  }
+
+  // row-major C = op(A) * op(B) is column-major C.T = op(B).T * op(A).T
+  void product(bool ta, bool tb, int m, int n, int k, DTYPE alpha,
+  DTYPE beta, int slot) const
+  {
+    int lda = (ta) ? m : k;
+    int ldb = (tb) ? k : n;
+    auto dC = _C[slot].reserve(m * n);
+
+    check(cublasSgemm(_blas,
+      (tb) ? CUBLAS_OP_T : CUBLAS_OP_N, (ta) ? CUBLAS_OP_T : CUBLAS_OP_N,
+      n, m, k, &alpha,
+      _B[slot].data(), std::max(1, ldb),
+      _A[slot].data(), std::max(1, lda),
+      &beta, dC, n), "cublasSgemm");
+  }
+
+  // copy product of a slot to its staging buffer
+  void download(const Tensor& C, int slot) const
+  {
+    check(cudaMemcpyAsync(_hC[slot].reserve(C.size()), _C[slot].data(),
+      C.size() * sizeof(DTYPE), cudaMemcpyDeviceToHost, _compute),
+      "cudaMemcpyAsync");
+  }
+
+  // copy downloaded product of a slot to C
+  void unstage(Tensor& C, int slot) const
+  {
+    if (C.size() == 0) return;
+    std::copy(_hC[slot].data(), _hC[slot].data() + C.size(), C.data());
+  }
+
+  cudaStream_t _compute;
+  cudaStream_t _copy;
+  cublasHandle_t _blas;
+  cudaEvent_t _copied[SLOTS];
+  cudaEvent_t _computed[SLOTS];
+  mutable DeviceBuffer _A[SLOTS];
+  mutable DeviceBuffer _B[SLOTS];
+  mutable DeviceBuffer _C[SLOTS];
+  mutable PinnedBuffer _hA[SLOTS];
+  mutable PinnedBuffer _hB[SLOTS];
+  mutable PinnedBuffer _hC[SLOTS];
+  mutable std::mutex _lock;
+};
+
+Backend& cuda_backend()
+{
+  static CudaBackend cuda;
+  return cuda;
+}
+
+} /* namespace */
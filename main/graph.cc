@@ -6,11 +6,24 @@
 
 #include <iostream>
 #include <iterator>
+#include <algorithm>
+#include <unordered_set>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <iomanip>
+#include <cstdlib>
+#include <cxxabi.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Array.erf
 #include <unsupported/Eigen/SpecialFunctions>
 
 #include "graph.hh"
+#include "backend.hh"
+#include "external/thread-pool-11/ThreadPool.h"
 
 namespace seegnify {
 
@@ -122,12 +135,25 @@ Function& operator/(Function& x, Function& y)
 // Tensor routines
 ///////////////////////////////////////////
 
+// shape of tensor as rows x cols
+static std::string shape(const Tensor& t)
+{
+  return std::to_string(t.rows()) + "x" + std::to_string(t.cols());
+}
+
+// throw unless elementwise operands have the same shape
+static void check_shapes(const Tensor& x, const Tensor& y)
+{
+  if (x.rows() != y.rows() || x.cols() != y.cols())
+    throw std::runtime_error("Incompatible shapes " +
+      shape(x) + " and " + shape(y));
+}
+
 static Tensor ATB(const Tensor& A, const Tensor& B)
 {
-  if (B.cols() == 1)
-    return (ConstRowVectorMap(B.data(), B.size()) * A).transpose();
-  else
-    return A.transpose() * B;
+  Tensor C;
+  backend().gemm(A, true, B, false, C);
+  return C;
 }
 
 // compute sparse product A.T*B at non-zero elements of a reference tensor R
@@ -137,27 +163,31 @@ static SparseTensor ATB(
   const SparseTensor& R
 )
 {
-  auto AT = A.transpose();
-  auto BT = B.transpose();
-  SparseTensor abt(R.rows(), R.cols());
+  SparseTensor atb(R.rows(), R.cols());
   for (int k=0; k < R.outerSize(); ++k)
   {
       for (SparseTensor::InnerIterator it(R,k); it; ++it)
       {
           auto row = it.row();
           auto col = it.col();
-          abt.coeffRef(row, col) = AT(row) * BT(col);
+          atb.coeffRef(row, col) = A.col(row).dot(B.col(col));
       }
   }
-  return abt;
+  return atb;
 }
 
 static Tensor ABT(const Tensor& A, const Tensor& B)
 {
-  if (B.cols() == 1)
-    return A * ConstRowVectorMap(B.data(), B.size());
-  else
-    return A * B.transpose();
+  Tensor C;
+  backend().gemm(A, false, B, true, C);
+  return C;
+}
+
+static Tensor ABT(const Tensor& A, const SparseTensor& B)
+{
+  Tensor C;
+  backend().spmm(A, B, true, C);
+  return C;
 }
 
 // compute sparse product A*B.T at non-zero elements of a reference tensor R
@@ -174,7 +204,7 @@ static SparseTensor ABT(
       {
           auto row = it.row();
           auto col = it.col();
-          abt.coeffRef(row, col) = A(row) * B(col);
+          abt.coeffRef(row, col) = A.row(row).dot(B.row(col));
       }
   }
   return abt;
@@ -187,6 +217,110 @@ static Tensor clip(const Tensor& t, DTYPE min_val, DTYPE max_val)
   return t.array().min(up.array()).max(lo.array());
 }
 
+// max along axis broadcast to the shape of t
+static Tensor axis_max(const Tensor& t, Axis axis)
+{
+  if (axis == ROWWISE) return t.rowwise().maxCoeff().replicate(1, t.cols());
+  if (axis == COLWISE) return t.colwise().maxCoeff().replicate(t.rows(), 1);
+  return Tensor::Constant(t.rows(), t.cols(), t.maxCoeff());
+}
+
+// sum along axis broadcast to the shape of t
+static Tensor axis_sum(const Tensor& t, Axis axis)
+{
+  if (axis == ROWWISE) return t.rowwise().sum().replicate(1, t.cols());
+  if (axis == COLWISE) return t.colwise().sum().replicate(t.rows(), 1);
+  return Tensor::Constant(t.rows(), t.cols(), t.sum());
+}
+
+///////////////////////////////////////////
+// Activation kernels
+///////////////////////////////////////////
+
+// Kernels evaluate an activation and its derivative in one pass over
+// blocks that stay in cache, so the backward pass does not recompute the
+// transcendentals. Eigen maps the array expressions to the SIMD instruction
+// set selected at build time (SSE, AVX2, AVX-512 or NEON).
+
+#define KERNEL_BLOCK 1024
+
+typedef Eigen::Array<DTYPE, Eigen::Dynamic, 1> KernelBlock;
+typedef Eigen::Map<KernelBlock> KernelBlockMap;
+typedef Eigen::Map<const KernelBlock> ConstKernelBlockMap;
+
+// erf(x) given exp(-x^2)
+template <class X, class E>
+static KernelBlock erf_exp(const X& x, const E& exp_x2)
+{
+#ifdef FAST_ACTIVATION
+  // Abramowitz and Stegun 7.1.26, |error| < 1.5e-7
+  KernelBlock t = 1 / (1 + 0.3275911 * x.abs());
+  KernelBlock p = t * (0.254829592 + t * (-0.284496736 + t * (1.421413741 +
+    t * (-1.453152027 + t * 1.061405429))));
+  return (1 - p * exp_x2) * x.sign();
+#else
+  (void)exp_x2; // exact erf needs no exp(-x^2)
+  return x.erf();
+#endif
+}
+
+// apply kernel f(x, y, dydx) to blocks of x
+template <class F>
+static void kernel_blocks(const Tensor& x, Tensor& y, Tensor& dydx, F f)
+{
+  y.resize(x.rows(), x.cols());
+  dydx.resize(x.rows(), x.cols());
+
+  for (int i=0; i<x.size(); i+=KERNEL_BLOCK)
+  {
+    int size = std::min<int>(KERNEL_BLOCK, x.size() - i);
+    ConstKernelBlockMap x_i(x.data() + i, size);
+    KernelBlockMap y_i(y.data() + i, size);
+    KernelBlockMap dydx_i(dydx.data() + i, size);
+    f(x_i, y_i, dydx_i);
+  }
+}
+
+// y = erf(x), dydx = 2 / sqrt(pi) * exp(-x^2)
+static void erf_kernel(const Tensor& x, Tensor& y, Tensor& dydx)
+{
+  kernel_blocks(x, y, dydx, [](ConstKernelBlockMap& x, KernelBlockMap& y,
+  KernelBlockMap& dydx)
+  {
+    KernelBlock e = (-x * x).exp();
+    y = erf_exp(x, e);
+    dydx = M_2_SQRTPI * e;
+  });
+}
+
+// y = 0.5 * x * (1 + erf(x / sqrt(2))),
+// dydx = 0.5 * (1 + erf(x / sqrt(2))) + x * exp(-x^2 / 2) / sqrt(2 * pi)
+static void gelu_kernel(const Tensor& x, Tensor& y, Tensor& dydx)
+{
+  kernel_blocks(x, y, dydx, [](ConstKernelBlockMap& x, KernelBlockMap& y,
+  KernelBlockMap& dydx)
+  {
+    KernelBlock z = x * M_SQRT1_2;
+    KernelBlock e = (-z * z).exp();
+    KernelBlock cdf = 0.5 * (1 + erf_exp(z, e));
+    y = x * cdf;
+    dydx = cdf + x * e * (0.5 * M_2_SQRTPI * M_SQRT1_2);
+  });
+}
+
+// y = log(1 + exp(x)), dydx = sigmoid(x)
+static void softplus_kernel(const Tensor& x, Tensor& y, Tensor& dydx)
+{
+  kernel_blocks(x, y, dydx, [](ConstKernelBlockMap& x, KernelBlockMap& y,
+  KernelBlockMap& dydx)
+  {
+    // log(1+exp(x)) = log(1+exp(-abs(x))) + max(x,0) for numerical stability
+    KernelBlock e = (-x.abs()).exp();
+    y = e.log1p() + x.max(0);
+    dydx = (x >= 0).select(KernelBlock::Ones(x.size()), e) / (1 + e);
+  });
+}
+
 ///////////////////////////////////////////
 // Function impl
 ///////////////////////////////////////////
@@ -194,20 +328,82 @@ static Tensor clip(const Tensor& t, DTYPE min_val, DTYPE max_val)
 Function::Function(Graph& graph) : _graph(graph)
 {
   _backprop = true;
+  _stale = false;
+  _released = false;
+  _version = 0;
+  _owner = nullptr;
+  _row_sparse = false;
+  _view = NO_VIEW;
+  _view_row = 0;
+  _view_col = 0;
+}
+
+Function::Function(Graph& graph, Function& base) : _graph(graph)
+{
+  _backprop = true;
+  _stale = false;
+  _released = false;
+  _version = 0;
+  _owner = &base;
+  _row_sparse = false;
+  _view = NO_VIEW;
+  _view_row = 0;
+  _view_col = 0;
+}
+
+// set derivative callback
+void Function::derivative(Function* d)
+{
+  _derivative.push_back(d);
+
+  // the owner of the derivative reads this function in forward pass
+  auto owner = d->_owner;
+  if (owner) owner->input(*this);
+}
+
+// record forward input
+void Function::input(Function& x)
+{
+  if (std::find(_inputs.begin(), _inputs.end(), &x) == _inputs.end())
+  {
+    _inputs.push_back(&x);
+  }
+}
+
+// pass gradient of this function to inner function x
+void Function::identity(Function& x)
+{
+  if (_graph.no_grad())
+    input(x);
+  else
+    x.derivative(_graph.new_iderivative(*this));
+}
+
+void Function::view(Function& x, View view, int row, int col)
+{
+  if (_graph.no_grad())
+    input(x);
+  else
+    x.derivative(new VDerivative(_graph, *this, view, row, col));
 }
 
 // backward traversal
 const Tensor& Function::backward()
 {
   // if no value is set, there is no gradient
-  if (!_value.size()) throw NoValueException();
+  if (!_value.size())
+  {
+    if (!_released) throw NoValueException();
+    _graph.evaluate(*this);
+  }
 
   // update and cache gradient
   if (!_gradient.size())
   {
-    _gradient = Tensor::Zero(_value.rows(), _value.cols());
-
-    if (_backprop) _graph.aggregate(_gradient, _derivative);
+    if (_backprop)
+      _graph.aggregate(_gradient, _value.rows(), _value.cols(), _derivative);
+    else
+      _gradient = Tensor::Zero(_value.rows(), _value.cols());
   }
 
   return _gradient;
@@ -218,6 +414,8 @@ void Function::recache()
 {
   _value.resize(0,0);
   _gradient.resize(0,0);
+  _stale = false;
+  _released = false;
 }
 
 ///////////////////////////////////////////
@@ -225,13 +423,13 @@ void Function::recache()
 ///////////////////////////////////////////
 
 IDerivative::IDerivative(Graph& graph, Function& base) :
-Function(graph), _base(base) {}
+Function(graph, base), _base(base) {}
 
 // dFdx = base.dFdx
 const Tensor& IDerivative::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   auto& g = _base.backward();
 
@@ -242,6 +440,26 @@ const Tensor& IDerivative::forward()
   return _value;
 }
 
+VDerivative::VDerivative(Graph& graph, Function& base, View view,
+int row, int col) : Function(graph, base), _base(base)
+{
+  _view = view;
+  _view_row = row;
+  _view_col = col;
+  graph.keep(this);
+}
+
+// dFdx = base.dFdx read in place
+const Tensor& VDerivative::forward()
+{
+  // value kept while base gradient is released
+  if (cached()) return _value;
+
+  // stale empty value marks derivative evaluated
+  _stale = true;
+  return _base.backward();
+}
+
 ///////////////////////////////////////////
 // Function Rowwise
 ///////////////////////////////////////////
@@ -249,23 +467,21 @@ const Tensor& IDerivative::forward()
 Rowwise::Rowwise(Graph& graph, Function& x, int rows, int cols,
 std::function<Function*(Function& block)> ctor) : Function(graph)
 {
-  _y = nullptr;
+  auto begin = graph.nodes().size();
+
+  // first row tells if the block has a native row-wise op
+  auto& block = *graph.new_split(x, 0,0, 1,cols);
+  _y = ctor(block);
+  if (rows > 1 && native(x, block, begin)) return;
 
   // split x by row and join rows
-  for (int r=0; r<rows; r++)
+  for (int r=1; r<rows; r++)
   {
     auto row = ctor(*graph.new_split(x, r,0, 1,cols));
-    if (_y)
-    {
-      _y = graph.new_join(*_y, *row, r+1,cols); // row major
-    }
-    else
-    {
-      _y = row;
-    }
+    _y = graph.new_join(*_y, *row, r+1,cols); // row major
   }
 
-  _y->derivative(graph.new_iderivative(*this));
+  identity(*_y);
 }
 
 Rowwise::Rowwise(Graph& graph, Function& x, int rows, int cols,
@@ -273,33 +489,71 @@ std::function<Function*(Function& block)> shared_ctor,
 std::function<Function*(Function& block, Function& shared)> ctor) :
 Function(graph)
 {
+  auto begin = graph.nodes().size();
+
   // row-wise function with shared weights
-  Function* shared = nullptr;
+  auto& block = *graph.new_split(x, 0,0, 1,cols);
+  auto shared = shared_ctor(block);
+  _y = shared;
+  if (rows > 1 && native(x, block, begin)) return;
 
   // split x by row and join rows
-  for (int r=0; r<rows; r++)
+  for (int r=1; r<rows; r++)
   {
-    if (shared)
-    {
-      auto row = ctor(*graph.new_split(x, r,0, 1,cols), *shared);
-      _y = graph.new_join(*_y, *row, r+1,cols); // row major
-    }
-    else
-    {
-      shared = shared_ctor(*graph.new_split(x, r,0, 1,cols));
-      _y = shared;
-    }
+    auto row = ctor(*graph.new_split(x, r,0, 1,cols), *shared);
+    _y = graph.new_join(*_y, *row, r+1,cols); // row major
   }
 
-  _y->derivative(graph.new_iderivative(*this));
+  identity(*_y);
 }
 
+// map the first row block kept at nodes[begin:] to a native row-wise op
+bool Rowwise::native(Function& x, Function& block, size_t begin)
+{
+  auto end = _graph.nodes().size();
+
+  // element-wise ops must read the row block only
+  auto& inputs = _y->inputs();
+  bool unary = (inputs.size() == 1 && inputs[0] == &block);
+
+  Function* y = nullptr;
+
+  auto softmax = dynamic_cast<Softmax*>(_y);
+  auto log_softmax = dynamic_cast<LogSoftmax*>(_y);
+  auto sum = dynamic_cast<Sum*>(_y);
+  auto mean = dynamic_cast<Mean*>(_y);
+  auto maximum = dynamic_cast<Maximum*>(_y);
+  auto norm = dynamic_cast<Norm*>(_y);
+
+  if (unary && softmax && softmax->axis() == ALL)
+    y = _graph.new_softmax(x, ROWWISE);
+  else if (unary && log_softmax && log_softmax->axis() == ALL)
+    y = _graph.new_log_softmax(x, ROWWISE);
+  else if (unary && sum && sum->axis() == ALL)
+    y = _graph.new_sum(x, ROWWISE);
+  else if (unary && mean && mean->axis() == ALL)
+    y = _graph.new_mean(x, ROWWISE);
+  else if (unary && maximum && maximum->axis() == ALL)
+    y = _graph.new_maximum(x, ROWWISE);
+  else if (norm && &norm->X() == &block && norm->A().value().rows() == 1 &&
+           norm->A().value().cols() > 1)
+    y = _graph.new_norm(x, *norm); // row gain normalizes each row
+  else
+    return false;
+
+  // drop the first row block, keep its variables
+  _graph.discard(begin, end);
+
+  _y = y;
+  identity(*_y);
+  return true;
+}
 
 // F = f(x rowwise)
 const Tensor& Rowwise::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // update value
   _value = _y->forward();
@@ -322,7 +576,7 @@ std::function<Function*(Function& block)> ctor) : Function(graph)
     )
   );
 
-  _y->derivative(graph.new_iderivative(*this));
+  identity(*_y);
 }
 
 Colwise::Colwise(Graph& graph, Function& x, int rows, int cols,
@@ -337,14 +591,14 @@ Function(graph)
     )
   );
 
-  _y->derivative(graph.new_iderivative(*this));
+  identity(*_y);
 }
 
 // F = f(x colwise)
 const Tensor& Colwise::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // update value
   _value = _y->forward();
@@ -373,8 +627,9 @@ Function(graph)
 {
   // Xavier initialization
   float stddev = (cols == 1) ? (1.0 / rows) : (1.0 / cols);
-  auto random = [&]() { return graph.random().normal_dec(0, stddev); };
-  _value = Tensor::NullaryExpr(rows, cols, random);
+  _value.resize(rows, cols);
+  Philox(graph.random().key(), graph.random().stream()).normal(
+    _value.data(), _value.size(), 0, stddev);
 }
 
 // accumulate gradient
@@ -383,15 +638,55 @@ const Tensor& Variable::backward()
   // if no value is set, there is no gradient
   if (!_value.size()) throw NoValueException();
 
-  // initialize gradient to zero
-  if (!_gradient.size())
-  {
+  // accumulate gradient of repeated backward passes
+  if (_backprop)
+    _graph.aggregate(_gradient, _value.rows(), _value.cols(), _derivative,
+      _gradient.size() > 0);
+  else if (!_gradient.size())
     _gradient = Tensor::Zero(_value.rows(), _value.cols());
+
+  return _gradient;
+}
+
+bool Variable::row_sparse() const
+{
+  if (_derivative.empty()) return false;
+
+  for (auto e: _derivative) if (!e->_row_sparse) return false;
+
+  return true;
+}
+
+void Variable::touch(const std::vector<int>& rows)
+{
+  if (_touched_mask.size() != _value.rows())
+  {
+    _touched_mask.assign(_value.rows(), false);
   }
 
-  if (_backprop) _graph.aggregate(_gradient, _derivative);
+  for (auto r: rows)
+  {
+    if (!_touched_mask[r])
+    {
+      _touched_mask[r] = true;
+      _touched.push_back(r);
+    }
+  }
+}
 
-  return _gradient;
+void Variable::zero_grad()
+{
+  if (row_sparse() && _gradient.rows() == _value.rows())
+  {
+    for (auto r: _touched) _gradient.row(r).setZero();
+  }
+  else
+  {
+    _gradient.setZero();
+  }
+
+  for (auto r: _touched) if (r < _touched_mask.size()) _touched_mask[r] = false;
+  _touched.clear();
 }
 
 ///////////////////////////////////////////
@@ -401,18 +696,21 @@ const Tensor& Variable::backward()
 Broadcast::Broadcast(Graph& graph, Function& x, Function& target) :
 Function(graph), _x(x), _t(target)
 {
+  // target shape is read without derivative
+  _inputs.push_back(&_t);
+
   // Broadcast Backward function
   class Derivative_x : public Function
   {
   public:
     Derivative_x(Graph& graph, Broadcast& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
@@ -420,20 +718,17 @@ Function(graph), _x(x), _t(target)
       // broadcast row-wise
       if (x.rows() == 1 && x.cols() > 1)
       {
-        Tensor dFdx = g.colwise().sum();
-        _value = dFdx;
+        _value = g.colwise().sum();
       }
       // broadcast col-wise
       else if (x.rows() > 1 && x.cols() == 1)
       {
-        Tensor dFdx = g.rowwise().sum();
-        _value = dFdx;
+        _value = g.rowwise().sum();
       }
       // broadcast any size
       else
       {
-        Tensor dFdx = Tensor::Constant(x.rows(), x.cols(), g.sum());
-        _value = dFdx;
+        _value.setConstant(x.rows(), x.cols(), g.sum());
       }
 
       // return gradient value
@@ -444,35 +739,40 @@ Function(graph), _x(x), _t(target)
     Broadcast& _base;
   };
 
-  _x.derivative(new Derivative_x(_graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = x (x broadcast to target)
 const Tensor& Broadcast::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get source and target
   auto& x = _x.forward();
   auto& t = _t.forward();
 
-  // broadcast row-wise
+  if ((x.rows() == 1 && x.cols() > 1 && x.cols() != t.cols()) ||
+      (x.rows() > 1 && x.cols() == 1 && x.rows() != t.rows()))
+    throw std::runtime_error("Incompatible broadcast of " +
+      shape(x) + " to " + shape(t));
+
+  // broadcast row-wise, values are written once
   if (x.rows() == 1 && x.cols() > 1)
   {
-    _value = Tensor::Zero(t.rows(), t.cols());
-    _value.rowwise() += ConstRowVectorMap(x.data(), x.size());
+    _value.resize(t.rows(), t.cols());
+    _value.rowwise() = ConstRowVectorMap(x.data(), x.size());
   }
   // broadcast col-wise
   else if (x.rows() > 1 && x.cols() == 1)
   {
-    _value = Tensor::Zero(t.rows(), t.cols());
-    _value.colwise() += ConstColVectorMap(x.data(), x.size());
+    _value.resize(t.rows(), t.cols());
+    _value.colwise() = ConstColVectorMap(x.data(), x.size());
   }
   // broadcast any size
   else
   {
-    _value = Tensor::Constant(t.rows(), t.cols(), x.sum());
+    _value.setConstant(t.rows(), t.cols(), x.sum());
   }
 
   return _value;
@@ -485,50 +785,25 @@ const Tensor& Broadcast::forward()
 Reshape::Reshape(Graph& graph, Function& x, int rows, int cols) :
 Function(graph), _x(x), _rows(rows), _cols(cols)
 {
-  // Reshape Backward function
-  class Derivative_x : public Function
-  {
-  public:
-    Derivative_x(Graph& graph, Reshape& base) :
-    Function(graph), _base(base) { graph.keep(this); }
-
-    // dFdx = 1
-    virtual const Tensor& forward()
-    {
-      // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& x = _base._x.forward();
-
-      // pass the reshaped gradient through (default is ColMajor)
-      auto dFdx = g.reshaped<Eigen::RowMajor>(x.rows(), x.cols());
-
-      // update gradient value
-      _value = dFdx;
-
-      // return gradient value
-      return _value;
-    }
-
-  private:
-    Reshape& _base;
-  };
-
-  _x.derivative(new Derivative_x(graph, *this));
+  // gradient elements are in the order of x
+  view(_x, HEAD_VIEW);
 }
 
 // F = x
 const Tensor& Reshape::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
 
-  // update value (reshaped() default is ColMajor)
-  _value = x.reshaped<Eigen::RowMajor>(_rows, _cols);
+  if (x.size() != (size_t)_rows * _cols)
+    throw std::runtime_error("Incompatible reshape of " + shape(x) + " to " +
+      std::to_string(_rows) + "x" + std::to_string(_cols));
+
+  // copy elements in row-major order
+  _value = ConstTensorMap(x.data(), _rows, _cols);
 
   return _value;
 }
@@ -540,49 +815,22 @@ const Tensor& Reshape::forward()
 Split::Split(Graph& graph, Function& x, int r, int c, int rows, int cols) :
 Function(graph), _x(x), _r(r), _c(c), _rows(rows), _cols(cols)
 {
-  // Split Backward function
-  class Derivative_x : public Function
-  {
-  public:
-    Derivative_x(Graph& graph, Split& base) :
-    Function(graph), _base(base) { graph.keep(this); }
-
-    // dFdx = 1
-    virtual const Tensor& forward()
-    {
-      // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& x = _base._x.forward();
-
-      // pass the gradient through the block
-      Tensor dFdx = Tensor::Zero(x.rows(), x.cols());
-      dFdx.block(_base._r, _base._c, _base._rows, _base._cols) = g;
-
-      // update gradient value
-      _value = dFdx;
-
-      // return gradient value
-      return _value;
-    }    
-
-  private:
-    Split& _base;
-  };
-
-  _x.derivative(new Derivative_x(graph, *this));
+  // gradient is added to the block of x only
+  view(_x, BLOCK_VIEW, r, c);
 }
 
 // F = block(x)
 const Tensor& Split::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
 
+  if (_r < 0 || _c < 0 || _r + _rows > x.rows() || _c + _cols > x.cols())
+    throw std::runtime_error("Split block out of bounds of " + shape(x));
+
   // update value
   _value = x.block(_r, _c, _rows, _cols);
 
@@ -597,86 +845,30 @@ const Tensor& Split::forward()
 Join::Join(Graph& graph, Function& x, Function& y, int rows, int cols) :
 Function(graph), _x(x), _y(y), _rows(rows), _cols(cols)
 {
-  // Join Derivative with respect to X
-  class Derivative_x : public Function
-  {
-  public:
-    Derivative_x(Graph& graph, Join& base) :
-    Function(graph), _base(base) { graph.keep(this); }
-
-    // dFdx = 1
-    virtual const Tensor& forward()
-    {
-      // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& x = _base._x.forward();
-
-      // split g into gx and gy (g data is already flat)
-      ConstTensorMap gx(g.data(), x.rows(), x.cols());
-
-      // update gradient value
-      _value = gx;
-      return _value;
-    }    
-
-  private:
-    Join& _base;
-  };
-
-  // Join Derivative with respect to Y
-  class Derivative_y : public Function
-  {
-  public:
-    Derivative_y(Graph& graph, Join& base) :
-    Function(graph), _base(base) { graph.keep(this); }
-
-    // dFdy = 1
-    virtual const Tensor& forward()
-    {
-      // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& x = _base._x.forward();
-      auto& y = _base._y.forward();
-
-      // split g into gx and gy (g data is already flat)
-      ConstTensorMap gy(g.data() + x.size(), y.rows(), y.cols());
-
-      // update gradient value
-      _value = gy;
-      return _value;
-    }    
-
-  private:
-    Join& _base;
-  };
-
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  // gradient elements of x come first, of y last
+  view(_x, HEAD_VIEW);
+  view(_y, TAIL_VIEW);
 }
 
 // F = join(x)
 const Tensor& Join::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
   auto& y = _y.forward();
 
-  // join x and y into a flat vector
-  ConstRowVectorMap vx(x.data(), x.size());
-  ConstRowVectorMap vy(y.data(), y.size());
-  RowVector xy(x.size() + y.size());
-  xy.leftCols(x.size()) = vx;
-  xy.rightCols(y.size()) = vy;
+  if (x.size() + y.size() != (size_t)_rows * _cols)
+    throw std::runtime_error("Incompatible join of " + shape(x) + " and " +
+      shape(y) + " to " + std::to_string(_rows) + "x" + std::to_string(_cols));
 
-  // reshape flat vector into output shape
-  _value = TensorMap(xy.data(), _rows, _cols);
+  // copy x and y elements into output shape in row-major order
+  _value.resize(_rows, _cols);
+  RowVectorMap xy(_value.data(), _value.size());
+  xy.head(x.size()) = ConstRowVectorMap(x.data(), x.size());
+  xy.tail(y.size()) = ConstRowVectorMap(y.data(), y.size());
 
   // return value
   return _value;
@@ -694,13 +886,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_x(Graph& graph, Min& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1 if x < y, 0 otherwise
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
@@ -726,13 +918,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_y(Graph& graph, Min& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdy = 1 if x > y, 0 otherwise
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
@@ -753,19 +945,20 @@ Function(graph), _x(x), _y(y)
     Min& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_y>(_y, *this);
 }
 
 // F = min(x,y)
 const Tensor& Min::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
   auto& y = _y.forward();
+  check_shapes(x, y);
 
   // update value
   _value = x.array().min(y.array());
@@ -786,13 +979,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_x(Graph& graph, Max& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1 if x > y, 0 otherwise
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& d = _base.backward();
       auto& x = _base._x.forward();
@@ -817,13 +1010,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_y(Graph& graph, Max& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdy = 1 if x < y, 0 otherwise
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& d = _base.backward();
       auto& x = _base._x.forward();
@@ -843,19 +1036,20 @@ Function(graph), _x(x), _y(y)
     Max& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_y>(_y, *this);
 }
 
 // F = max(x,y)
 const Tensor& Max::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
   auto& y = _y.forward();
+  check_shapes(x, y);
 
   // update value
   _value = x.array().max(y.array());
@@ -898,6 +1092,8 @@ Function(graph)
 
 void Linear::init(Function& x)
 {
+  _x = &x;
+
   // col major
   // F = W * x + b
   // _y = _graph.new_product(*_W, x);
@@ -911,13 +1107,23 @@ void Linear::init(Function& x)
     _y = _graph.new_add(*_y, *_graph.new_broadcast(*_b, *_y));
   }
 
-  _y->derivative(_graph.new_iderivative(*this));
+  identity(*_y);
 }
 
 const Tensor& Linear::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
+
+  // int8 weights with int32 accumulation
+  if (_quantized)
+  {
+    QTensor x;
+    quantize_input(_x->forward(), x);
+    qgemm(x, _qW, _value);
+    if (_bias.size()) _value.rowwise() += _bias.row(0);
+    return _value;
+  }
 
   // create cached value
   _value.noalias() = _y->forward();
@@ -926,6 +1132,19 @@ const Tensor& Linear::forward()
   return _value;
 }
 
+void Linear::calibrate()
+{
+  _range = std::max(_range, _x->forward().cwiseAbs().maxCoeff());
+}
+
+void Linear::quantize()
+{
+  // per output channel scales
+  seegnify::quantize(_W->forward(), _qW);
+  _bias = (_b) ? _b->forward() : Tensor();
+  _quantized = true;
+}
+
 ///////////////////////////////////////////
 // Function Product
 ///////////////////////////////////////////
@@ -938,21 +1157,21 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_x(Graph& graph, Product& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = y.T
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& y = _base._y.forward();
 
       auto& dFdx = y;
 
-      // update gradient value
-      _value = ABT(g, dFdx);
+      // update gradient value in place
+      backend().gemm(g, false, dFdx, true, _value);
       return _value;
     }    
 
@@ -965,21 +1184,21 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_y(Graph& graph, Product& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdy = x.T
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
 
       auto& dFdy = x;
 
-      // update gradient value
-      _value = ATB(dFdy, g);
+      // update gradient value in place
+      backend().gemm(dFdy, true, g, false, _value);
       return _value;
     }    
 
@@ -987,27 +1206,52 @@ Function(graph), _x(x), _y(y)
     Product& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_y>(_y, *this);
 }
 
 // F = x * y
 const Tensor& Product::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
   auto& y = _y.forward();
 
+  if (x.cols() != y.rows())
+    throw std::runtime_error("Incompatible product shapes " +
+      shape(x) + " and " + shape(y));
+
+  // int8 inputs with int32 accumulation
+  if (_quantized)
+  {
+    QTensor qx, qy;
+    Tensor yT = y.transpose();
+    quantize_input(x, qx);
+    seegnify::quantize(yT, qy);
+    qgemm(qx, qy, _value);
+    return _value;
+  }
+
   // create cached value
-  _value.noalias() = x * y;
+  backend().gemm(x, false, y, false, _value);
 
   // return value
   return _value;
 }
 
+void Product::calibrate()
+{
+  _range = std::max(_range, _x.forward().cwiseAbs().maxCoeff());
+}
+
+void Product::quantize()
+{
+  _quantized = true;
+}
+
 ///////////////////////////////////////////
 // Function Add
 ///////////////////////////////////////////
@@ -1020,14 +1264,14 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_any(Graph& graph, Add& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1
     // dFdy = 1
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
 
@@ -1040,19 +1284,20 @@ Function(graph), _x(x), _y(y)
     Add& _base;
   };
 
-  _x.derivative(new Derivative_any(graph, *this));
-  _y.derivative(new Derivative_any(graph, *this));
+  derivative<Derivative_any>(_x, *this);
+  derivative<Derivative_any>(_y, *this);
 }
 
 // F = x + y
 const Tensor& Add::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get inputs
   auto& x = _x.forward();
   auto& y = _y.forward();
+  check_shapes(x, y);
 
   // update value
   _value.noalias() = x + y;
@@ -1073,13 +1318,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_x(Graph& graph, Sub& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
 
@@ -1097,13 +1342,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_y(Graph& graph, Sub& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdy = -1
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
 
@@ -1116,19 +1361,20 @@ Function(graph), _x(x), _y(y)
     Sub& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_y>(_y, *this);
 }
 
 // F = x - y
 const Tensor& Sub::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get inputs
   auto& x = _x.forward();
   auto& y = _y.forward();
+  check_shapes(x, y);
 
   // update value
   _value.noalias() = x - y;
@@ -1149,13 +1395,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_x(Graph& graph, Mul& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = y
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& y = _base._y.forward();
@@ -1177,13 +1423,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_y(Graph& graph, Mul& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdy = x
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
@@ -1200,19 +1446,20 @@ Function(graph), _x(x), _y(y)
     Mul& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_y>(_y, *this);
 }
 
 // F = x * y
 const Tensor& Mul::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get inputs
   auto& x = _x.forward();
   auto& y = _y.forward();
+  check_shapes(x, y);
 
   // update value
   _value = x.array() * y.array();
@@ -1233,13 +1480,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_x(Graph& graph, Power& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = y * pow(F, y-1)
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& F = _base.forward();
       auto& g = _base.backward();
@@ -1262,13 +1509,13 @@ Function(graph), _x(x), _y(y)
   {
   public:
     Derivative_y(Graph& graph, Power& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdy = F * log(x)
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& F = _base.forward();
       auto& g = _base.backward();
@@ -1286,19 +1533,20 @@ Function(graph), _x(x), _y(y)
     Power& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-  _y.derivative(new Derivative_y(graph, *this));
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_y>(_y, *this);
 }
 
 // F = pow(x, y)
 const Tensor& Power::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get inputs
   auto& x = _x.forward();
   auto& y = _y.forward();
+  check_shapes(x, y);
 
   // update value
   _value = x.array().pow(y.array());
@@ -1318,13 +1566,13 @@ Tanh::Tanh(Graph& graph, Function& x) : Function(graph), _x(x)
   {
   public:
     Derivative_x(Graph& graph, Tanh& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1 - (tanh(x))^2
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& F = _base.forward();
@@ -1341,14 +1589,14 @@ Tanh::Tanh(Graph& graph, Function& x) : Function(graph), _x(x)
     Tanh& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = (exp(x) - exp(-x) / (exp(x) + exp(-x))
 const Tensor& Tanh::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
@@ -1372,13 +1620,13 @@ Function(graph), _x(x)
   {
   public:
     Derivative_x(Graph& graph, Sigmoid& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = F(1 - F)
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& F = _base.forward();
@@ -1395,14 +1643,14 @@ Function(graph), _x(x)
     Sigmoid& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = 1 / (1 + exp(-x))
 const Tensor& Sigmoid::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
@@ -1429,14 +1677,14 @@ Function(graph)
   _relu = graph.new_max(x, *graph.new_broadcast(zero, x));
 
   // let output handle the gradient directly
-  _relu->derivative(_graph.new_iderivative(*this));
+  identity(*_relu);
 }
 
 // F = max(x, 0)
 const Tensor& ReLU::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // update value
   _value = _relu->forward();
@@ -1450,28 +1698,39 @@ const Tensor& ReLU::forward()
 ///////////////////////////////////////////
 
 Dropout::Dropout(Graph& graph, Function& x, DTYPE rate) :
-Function(graph), _x(x), _rate(rate), _enabled(true)
+Function(graph), _x(x), _rate(rate), _enabled(true), _masked(false)
 {
+  _stream = graph.random().stream();
+  _step = 0;
+
   // Derivative with respect to x
   class Derivative_x : public Function
   {
   public:
     Derivative_x(Graph& graph, Dropout& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-    // dFdy = x * mask
+    // dFdy = g * mask
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
-      auto& m = _base._mask;
+      _base.forward();
+
+      if (!_base._masked)
+      {
+        _value = g;
+        return _value;
+      }
 
-      auto dFdx = g.array() * m.array();
+      // regenerate mask of the forward step
+      _value.resize(g.rows(), g.cols());
+      Philox(_graph.random().key(), _base._stream, _base._step).uniform(
+        _value.data(), _value.size());
+      _value = (_value.array() < _base._rate).select(DTYPE(0), g.array());
 
-      // update gradient value
-      _value = dFdx;
       return _value;
     }
 
@@ -1479,34 +1738,32 @@ Function(graph), _x(x), _rate(rate), _enabled(true)
     Dropout& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = x * mask
 const Tensor& Dropout::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get values
   auto& x = _x.forward();
 
-  // compute dropout mask
-  if (_enabled)
-  {
-    auto random = [&]() { return _graph.random().uniform_dec(0, 1); };
-    auto mask = Tensor::NullaryExpr(x.rows(), x.cols(), random);
-    auto zero = Tensor::Zero(x.rows(), x.cols());
-    auto ones = Tensor::Ones(x.rows(), x.cols());
-    _mask = (mask.array() < _rate).select(zero, ones);
-  }
-  else
+  _masked = _enabled;
+  if (!_masked)
   {
-    _mask = Tensor::Ones(x.rows(), x.cols());
+    _value = x;
+    return _value;
   }
 
-  // update value
-  _value = x.array() * _mask.array();
+  // fused mask of uniform values of the next step, the same step
+  // when a released value is recomputed
+  if (!_released) _step++;
+  _value.resize(x.rows(), x.cols());
+  Philox(_graph.random().key(), _stream, _step).uniform(
+    _value.data(), _value.size());
+  _value = (_value.array() < _rate).select(DTYPE(0), x.array());
 
   // return value
   return _value;
@@ -1518,42 +1775,30 @@ const Tensor& Dropout::forward()
 
 // Derivative approches 0 when error is evently distributed.
 // Use LogSoftmax for training and Softmax for inference.
-Softmax::Softmax(Graph& graph, Function& x) :
-Function(graph), _x(x)
+Softmax::Softmax(Graph& graph, Function& x, Axis axis) :
+Function(graph), _x(x), _axis(axis)
 {
   // Derivative with respect to x
   class Derivative_x : public Function
   {
   public:
     Derivative_x(Graph& graph, Softmax& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx(j,i) = F(i)(K(i,j) - F(j))
     // K(i,j) = 1 for i==j, 0 for i!=j (Kronecker delta)
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& y = _base.forward();
 
-      // reshape input to flat row vector
-      auto F = y.reshaped(1, y.size());
-
-      // use Identity matrix to construct diagonal matrix
-      auto I = Tensor::Identity(F.size(), F.size());
-
-      // col major
-      //auto dFdx = I * F.asDiagonal() - F * F.transpose();
-      //auto gdFdx = (g.asDiagonal() * dFdx).colwise().sum().transpose();
-
-      // row major
-      auto dFdx = I * F.asDiagonal() - F.transpose() * F;
-      auto gdFdx = (g.asDiagonal() * dFdx).colwise().sum();
-
-      // reshape to input shape
-      _value = gdFdx.reshaped(y.rows(), y.cols());
+      // Jacobian-vector product along the axis, no Jacobian needed
+      // dFdx * g = F * (g - sum(g * F))
+      Tensor gy = g.array() * y.array();
+      _value = gy.array() - y.array() * axis_sum(gy, _base._axis).array();
 
       return _value;
     }    
@@ -1562,23 +1807,23 @@ Function(graph), _x(x)
     Softmax& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = exp(x) / sum(exp(x))
 const Tensor& Softmax::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input vector
   auto& x = _x.forward();
 
   // for numerical stability subtract max(_x) before exponential
-  auto exp_x = (x.array() - x.maxCoeff()).exp();
+  Tensor exp_x = (x - axis_max(x, _axis)).array().exp();
 
   // create cached value
-  _value = exp_x / exp_x.sum();
+  _value = exp_x.array() / axis_sum(exp_x, _axis).array();
 
   // return value
   return _value;
@@ -1596,21 +1841,19 @@ Function(graph), _x(x)
   {
   public:
     Derivative_x(Graph& graph, Softplus& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = sigmoid(x) = 1 / (1 + exp(-x))
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
-      // get input
-      auto& x = _base._x.forward();
+      auto& g = _base.backward();
+      _base.forward();
 
-      // update gradient
-      //_value = 1 / (1 + (-x).array().exp());
-      // for numerical stability compute sigmoid with tanh
-      _value = 0.5 * (x.array() * 0.5).tanh() + 0.5;
+      // update gradient with sigmoid from forward pass
+      _value = g.array() * _base._dFdx.array();
 
       // return value
       return _value;
@@ -1620,14 +1863,14 @@ Function(graph), _x(x)
     Softplus& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = log(1 + exp(x))
 const Tensor& Softplus::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input vector
   auto& x = _x.forward();
@@ -1636,10 +1879,8 @@ const Tensor& Softplus::forward()
   // log(1+exp(x)) = log(1+exp(x)) - log(exp(x)) + x = log(1+exp(-x)) + x
   // so for numerical stability use: log(1+exp(-abs(x))) + max(x,0)
   
-  // create cached value
-  auto zero = Tensor::Zero(x.rows(), x.cols());
-  auto max_x_0 = x.array().max(zero.array());
-  _value = (1 + (-x.array().abs()).exp()).log() + max_x_0;
+  // create cached value and derivative
+  softplus_kernel(x, _value, _dFdx);
 
   // return value
   return _value;
@@ -1649,42 +1890,30 @@ const Tensor& Softplus::forward()
 // Function Log-Softmax
 ///////////////////////////////////////////
 
-LogSoftmax::LogSoftmax(Graph& graph, Function& x) :
-Function(graph), _x(x)
+LogSoftmax::LogSoftmax(Graph& graph, Function& x, Axis axis) :
+Function(graph), _x(x), _axis(axis)
 {
   // Derivative with respect to x
   class Derivative_x : public Function
   {
   public:
     Derivative_x(Graph& graph, LogSoftmax& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx(j,i) = K(i,j) - F(j)
     // K(i,j) = 1 for i==j, 0 for i!=j (Kronecker delta)
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
-      auto s = _base.softmax();
-
-      // reshape input to flat row vector
-      auto S = s.reshaped(1, s.size());
+      // softmax from cached log-softmax
+      Tensor s = _base.forward().array().exp();
 
-      // use Identity matrix to construct diagonal matrix
-      auto I = Tensor::Identity(S.size(), S.size());
-
-      // col-major
-      // auto dFdx = I - Tensor::Ones(S.size(), 1) * S.transpose();
-      // auto gdFdx = (g.asDiagonal() * dFdx).colwise().sum().transpose();
-
-      // row-major
-      auto dFdx = I - Tensor::Ones(S.size(), 1) * S;
-      auto gdFdx = (g.asDiagonal() * dFdx).colwise().sum();
-
-      // reshape to input shape
-      _value = gdFdx.reshaped(s.rows(), s.cols());
+      // Jacobian-vector product along the axis, no Jacobian needed
+      // dFdx * g = g - S * sum(g)
+      _value = g.array() - s.array() * axis_sum(g, _base._axis).array();
 
       return _value;
     }    
@@ -1693,7 +1922,7 @@ Function(graph), _x(x)
     LogSoftmax& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = exp(x) / sum(exp(x))
@@ -1703,25 +1932,26 @@ const Tensor LogSoftmax::softmax()
   auto& x = _x.forward();
 
   // for numerical stability subtract max(_x) before exponential
-  auto exp_x = (x.array() - x.maxCoeff()).exp();
+  Tensor exp_x = (x - axis_max(x, _axis)).array().exp();
 
   // calculate softmax
-  return exp_x / exp_x.sum();
+  return exp_x.array() / axis_sum(exp_x, _axis).array();
 }
 
 // F = log(exp(x) / sum(exp(x))) = x - log(sum(exp(x)))
 const Tensor& LogSoftmax::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   auto& x = _x.forward();
 
   // for numerical stability subtract max(_x) before exponential
-  auto x_C = x.array() - x.maxCoeff();
+  Tensor x_C = x - axis_max(x, _axis);
+  Tensor exp_x = x_C.array().exp();
 
   // create cached value
-  _value = x_C - std::log(x_C.exp().sum());
+  _value = x_C.array() - axis_sum(exp_x, _axis).array().log();
 
   // return value
   return _value;
@@ -1739,13 +1969,13 @@ Function(graph), _x(x)
   {
   public:
     Derivative_x(Graph& graph, Log& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1 / x
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
@@ -1762,14 +1992,14 @@ Function(graph), _x(x)
     Log& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = log(x)
 const Tensor& Log::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
@@ -1793,13 +2023,13 @@ Function(graph), _x(x)
   {
   public:
     Derivative_x(Graph& graph, Abs& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = abs(x) / x
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
@@ -1819,14 +2049,14 @@ Function(graph), _x(x)
     Abs& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = abs(x)
 const Tensor& Abs::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
@@ -1845,40 +2075,15 @@ const Tensor& Abs::forward()
 Transpose::Transpose(Graph& graph, Function& x) :
 Function(graph), _x(x)
 {
-  // Derivative with respect to x
-  class Derivative_x : public Function
-  {
-  public:
-    Derivative_x(Graph& graph, Transpose& base) :
-    Function(graph), _base(base) { graph.keep(this); }
-
-    // dFdx = base.dFdx.T
-    virtual const Tensor& forward()
-    {
-      // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-
-      // update gradient value
-      _value = g.transpose();
-
-      // return gradient value
-      return _value;
-    }    
-
-  private:
-    Transpose& _base;
-  };
-
-  _x.derivative(new Derivative_x(graph, *this));
+  // dFdx = base.dFdx.T
+  view(_x, TRANSPOSED_VIEW);
 }
 
 // F = x.T
 const Tensor& Transpose::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
@@ -1894,29 +2099,32 @@ const Tensor& Transpose::forward()
 // Function Sum
 ///////////////////////////////////////////
 
-Sum::Sum(Graph& graph, Function& x) :
-Function(graph), _x(x)
+Sum::Sum(Graph& graph, Function& x, Axis axis) :
+Function(graph), _x(x), _axis(axis)
 {
   // Derivative with respect to x
   class Derivative_x : public Function
   {
   public:
     Derivative_x(Graph& graph, Sum& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
 
-      auto dFdx = g(0,0);
-
       // update gradient value
-      _value = Tensor::Constant(x.rows(), x.cols(), dFdx);
+      if (_base._axis == ROWWISE)
+        _value = g.replicate(1, x.cols());
+      else if (_base._axis == COLWISE)
+        _value = g.replicate(x.rows(), 1);
+      else
+        _value = Tensor::Constant(x.rows(), x.cols(), g(0,0));
 
      return _value;
     }    
@@ -1925,21 +2133,25 @@ Function(graph), _x(x)
     Sum& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = sum(x)
 const Tensor& Sum::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
 
   // update value
-  _value.resize(1,1);
-  _value(0,0) = x.sum();
+  if (_axis == ROWWISE)
+    _value = x.rowwise().sum();
+  else if (_axis == COLWISE)
+    _value = x.colwise().sum();
+  else
+    _value = Tensor::Constant(1, 1, backend().sum(x));
 
   // return value
   return _value;
@@ -1949,29 +2161,32 @@ const Tensor& Sum::forward()
 // Function Mean
 ///////////////////////////////////////////
 
-Mean::Mean(Graph& graph, Function& x) :
-Function(graph), _x(x)
+Mean::Mean(Graph& graph, Function& x, Axis axis) :
+Function(graph), _x(x), _axis(axis)
 {
   // Derivative with respect to x
   class Derivative_x : public Function
   {
   public:
     Derivative_x(Graph& graph, Mean& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Function(graph, base), _base(base) { graph.keep(this); }
 
     // dFdx = 1 / N
     virtual const Tensor& forward()
     {
       // return cached gradient
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
 
-      auto dFdx = g(0,0) / x.size();
-
       // update gradient value
-      _value = Tensor::Constant(x.rows(), x.cols(), dFdx);
+      if (_base._axis == ROWWISE)
+        _value = g.replicate(1, x.cols()) / x.cols();
+      else if (_base._axis == COLWISE)
+        _value = g.replicate(x.rows(), 1) / x.rows();
+      else
+        _value = Tensor::Constant(x.rows(), x.cols(), g(0,0) / x.size());
 
       return _value;
     }    
@@ -1980,21 +2195,105 @@ Function(graph), _x(x)
     Mean& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_x>(_x, *this);
 }
 
 // F = sum(x) / N
 const Tensor& Mean::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
+
+  // get input
+  auto& x = _x.forward();
+
+  // update value
+  if (_axis == ROWWISE)
+    _value = x.rowwise().mean();
+  else if (_axis == COLWISE)
+    _value = x.colwise().mean();
+  else
+    _value = Tensor::Constant(1, 1, x.sum() / x.size());
+
+  // return value
+  return _value;
+}
+
+///////////////////////////////////////////
+// Function Maximum
+///////////////////////////////////////////
+
+Maximum::Maximum(Graph& graph, Function& x, Axis axis) :
+Function(graph), _x(x), _axis(axis)
+{
+  // Derivative with respect to x
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, Maximum& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdx = 1 at the (first) max element, 0 elsewhere
+    virtual const Tensor& forward()
+    {
+      // return cached gradient
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      auto& x = _base._x.forward();
+
+      // update gradient value
+      _value = Tensor::Zero(x.rows(), x.cols());
+
+      Eigen::Index r, c;
+      if (_base._axis == ROWWISE)
+      {
+        for (r=0; r<x.rows(); r++)
+        {
+          x.row(r).maxCoeff(&c);
+          _value(r,c) = g(r,0);
+        }
+      }
+      else if (_base._axis == COLWISE)
+      {
+        for (c=0; c<x.cols(); c++)
+        {
+          x.col(c).maxCoeff(&r);
+          _value(r,c) = g(0,c);
+        }
+      }
+      else
+      {
+        x.maxCoeff(&r, &c);
+        _value(r,c) = g(0,0);
+      }
+
+      return _value;
+    }
+
+  private:
+    Maximum& _base;
+  };
+
+  derivative<Derivative_x>(_x, *this);
+}
+
+// F = max(x)
+const Tensor& Maximum::forward()
+{
+  // return cached value
+  if (cached()) return _value;
 
   // get input
   auto& x = _x.forward();
 
   // update value
-  _value.resize(1,1);
-  _value(0,0) = x.sum() / x.size();
+  if (_axis == ROWWISE)
+    _value = x.rowwise().maxCoeff();
+  else if (_axis == COLWISE)
+    _value = x.colwise().maxCoeff();
+  else
+    _value = Tensor::Constant(1, 1, x.maxCoeff());
 
   // return value
   return _value;
@@ -2004,6 +2303,12 @@ const Tensor& Mean::forward()
 // Function GRU
 ///////////////////////////////////////////
 
+// add bias row to each row of a batch
+static Function& add_bias(Function& y, Function& b)
+{
+  return y + *y.graph().new_broadcast(b, y);
+}
+
 GRU::GRU(Graph& graph, Function& x, Function& h, int in, int out) :
 Function(graph), _x(x), _h(h)
 {
@@ -2047,7 +2352,7 @@ Function(graph), _x(x), _h(h)
 const Tensor& GRU::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // create value h(t)
   _value = _GRU->forward();
@@ -2060,21 +2365,21 @@ void GRU::init()
 {
   // z
   auto& z = *_graph.new_sigmoid(
-    product(_x,*_Wz) + product(_h,*_Uz) + *_bz);
+    add_bias(product(_x,*_Wz) + product(_h,*_Uz), *_bz));
 
   // r
   auto& r = *_graph.new_sigmoid(
-    product(_x,*_Wr) + product(_h,*_Ur) + *_br);
+    add_bias(product(_x,*_Wr) + product(_h,*_Ur), *_br));
 
   // c
   auto& c = *_graph.new_tanh(
-    product(_x,*_Wh) + product(r * _h,*_Uh) + *_bh);
+    add_bias(product(_x,*_Wh) + product(r * _h,*_Uh), *_bh));
 
   // h(t)
   _GRU = &(z * _h + (1-z) * c);
 
   // let output handle the gradient directly
-  _GRU->derivative(_graph.new_iderivative(*this));
+  identity(*_GRU);
 }
 
 ///////////////////////////////////////////
@@ -2132,7 +2437,7 @@ Function(graph), _x(x), _h(h), _c(c)
 const Tensor& LSTM::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
   // create value h(t)
   _value = _LSTM->forward();
@@ -2151,19 +2456,19 @@ void LSTM::init()
 {
   // f
   auto& f = *_graph.new_sigmoid(
-    product(_x,*_Wf) + product(_h,*_Hf) + *_bf);
+    add_bias(product(_x,*_Wf) + product(_h,*_Hf), *_bf));
 
   // i
   auto& i = *_graph.new_sigmoid(
-    product(_x,*_Wi) + product(_h,*_Hi) + *_bi);
+    add_bias(product(_x,*_Wi) + product(_h,*_Hi), *_bi));
 
   // o
   auto& o = *_graph.new_sigmoid(
-    product(_x,*_Wo) + product(_h,*_Ho) + *_bo);
+    add_bias(product(_x,*_Wo) + product(_h,*_Ho), *_bo));
 
   // g
   auto& g = *_graph.new_tanh(
-    product(_x,*_Wg) + product(_h,*_Hg) + *_bg);
+    add_bias(product(_x,*_Wg) + product(_h,*_Hg), *_bg));
 
   // c
   auto& c = f * _c + i * g;
@@ -2176,1172 +2481,4625 @@ void LSTM::init()
   _LSTM = &h;
 
   // let output handle the gradient directly
-  _LSTM->derivative(_graph.new_iderivative(*this));
+  identity(*_LSTM);
 }
 
 ///////////////////////////////////////////
-// Sampler
+// Function GRU Sequence
 ///////////////////////////////////////////
 
-Sampler::Sampler(Graph& graph, Function& m, Function& s) : 
-Function(graph), _m(m), _s(s), _enabled(true)
-{
-  // random sampling with parametrization trick for back-propagation
-  // Auto-Encoding Variational Bayes by Diederik P. Kingma, Max Welling
-  // https://arxiv.org/pdf/1312.6114.pdf
-
-  _e = _graph.new_constant();
-
-  _Z = &(_m + *_e * _s);
-
-  _Z->derivative(_graph.new_iderivative(*this));
-}
+// Gradients of gate pre-activations of all steps, value holds dG
+class GRUSequence::Derivative_steps : public Function
+{
+public:
+  Derivative_steps(Graph& graph, GRUSequence& base) :
+  Function(graph, base), _base(base) { graph.keep(this); }
+
+  // gradients of stacked variables and initial state
+  const Tensor& W() { forward(); return _dW; }
+  const Tensor& U() { forward(); return _dU; }
+  const Tensor& b() { forward(); return _db; }
+  const Tensor& h() { forward(); return _dh; }
+
+  // dh(t) = g(t) + dh(t-1) of step t+1
+  // dz(t) = dh(t) . (h(t-1) - c(t)) . z(t) . (1 - z(t))
+  // dc(t) = dh(t) . (1 - z(t)) . (1 - c(t)^2)
+  // dr(t) = (dc(t) * Uh.T) . h(t-1) . r(t) . (1 - r(t))
+  // dh(t-1) = dh(t) . z(t) + (dc(t) * Uh.T) . r(t) + dz(t) * Uz.T
+  //         + dr(t) * Ur.T
+  virtual const Tensor& forward()
+  {
+    // return cached value
+    if (cached()) return _value;
+
+    auto& g = _base.backward();
+    _base.forward();
+
+    auto& x = _base._x.forward();
+    auto& h = _base._h.forward();
+    auto& H = _base._value;
+    auto& G = _base._G;
+    auto& Uh = _base._Uh->forward();
+    int B = h.rows();
+    int N = h.cols();
+    int T = x.rows() / B;
+
+    Tensor U(N, 2 * N);
+    U << _base._Uz->forward(), _base._Ur->forward();
+
+    // h(t-1) of all steps
+    Tensor Hp(T * B, N);
+    Hp.topRows(B) = h;
+    Hp.bottomRows((T - 1) * B) = H.topRows((T - 1) * B);
+
+    _value.resize(T * B, 3 * N);
+    _dh.setZero(B, N);
+
+    Tensor drh;
+    for (int t=T-1; t>=0; t--)
+    {
+      auto G_t = G.middleRows(t * B, B).array();
+      auto z = G_t.leftCols(N);
+      auto r = G_t.middleCols(N, N);
+      auto c = G_t.rightCols(N);
+      auto hp = Hp.middleRows(t * B, B).array();
+      auto dG_t = _value.middleRows(t * B, B);
+
+      _dh += g.middleRows(t * B, B);
+      auto dh = _dh.array();
+
+      dG_t.leftCols(N) = dh * (hp - c) * z * (1 - z);
+      dG_t.rightCols(N) = dh * (1 - z) * (1 - c * c);
+      drh.noalias() = dG_t.rightCols(N) * Uh.transpose();
+      dG_t.middleCols(N, N) = drh.array() * hp * r * (1 - r);
+
+      _dh = (dh * z + drh.array() * r).matrix();
+      _dh.noalias() += dG_t.leftCols(2 * N) * U.transpose();
+    }
 
-const Tensor& Sampler::forward()
-{
-  // return cached value
-  if (_value.size()) return _value;
+    _dW = ATB(x, _value);
+    _db = _value.colwise().sum();
 
-  int rows = _m().rows();
-  int cols = _m().cols();
+    _dU.resize(N, 3 * N);
+    _dU.leftCols(2 * N).noalias() =
+      Hp.transpose() * _value.leftCols(2 * N);
+    _dU.rightCols(N).noalias() =
+      (G.middleCols(N, N).cwiseProduct(Hp)).transpose() * _value.rightCols(N);
 
-  // sample random constant
-  if (_enabled)
-  {
-    auto random = [&]() { return _graph.random().normal_dec(0, 1); };
-    _e->value() = Tensor::NullaryExpr(rows, cols, random);
+    return _value;
   }
-  else
-  {
-    _e->value() = Tensor::Zero(rows, cols);
-  }
-
-  // update value
-  _value = _Z->forward();
-
-  // return value
-  return _value;
-}
 
-///////////////////////////////////////////
-// Norm
-///////////////////////////////////////////
+private:
+  GRUSequence& _base;
+  Tensor _dW;
+  Tensor _dU;
+  Tensor _db;
+  Tensor _dh;
+};
 
-Norm::Norm(Graph& graph, Function& x, int rows, int cols, DTYPE eps) :
-Function(graph), _x(x), _epsilon(eps)
+GRUSequence::GRUSequence(Graph& graph, Function& x, Function& h,
+int in, int out) :
+Function(graph), _x(x), _h(h)
 {
-  if (rows * cols > 1)
-  {
-    _a = graph.new_variable(rows, cols, "Norm.A");
-    _b = graph.new_variable(rows, cols, "Norm.B");
-  }
-  else
-  {
-    _a = graph.new_variable(1, 1, "Norm.a");
-    _b = graph.new_variable(1, 1, "Norm.b");
-  }
+  // construct new variables (row-major) in order of GRU
+  _Wz = graph.new_variable(in, out, "Wz");
+  _Uz = graph.new_variable(out, out, "Uz");
+  _bz = graph.new_variable(1, out, "bz");
 
-  _a->value() = Tensor::Ones(_a->value().rows(), _a->value().cols());
-  _b->value() = Tensor::Zero(_b->value().rows(), _b->value().cols());
+  _Wr = graph.new_variable(in, out, "Wr");
+  _Ur = graph.new_variable(out, out, "Ur");
+  _br = graph.new_variable(1, out, "br");
+
+  _Wh = graph.new_variable(in, out, "Wh");
+  _Uh = graph.new_variable(out, out, "Uh");
+  _bh = graph.new_variable(1, out, "bh");
 
   init();
 }
 
-Norm::Norm(Graph& graph, Function& x, const Norm& other) :
-Function(graph), _x(x), _epsilon(other._epsilon)
+GRUSequence::GRUSequence(Graph& graph, Function& x, Function& h,
+const GRU& other) :
+Function(graph), _x(x), _h(h)
 {
-  _a = other._a;
-  _b = other._b;
+  // share variables with the GRU cell
+  _Wz = other._Wz; _Uz = other._Uz; _bz = other._bz;
+  _Wr = other._Wr; _Ur = other._Ur; _br = other._br;
+  _Wh = other._Wh; _Uh = other._Uh; _bh = other._bh;
 
   init();
 }
 
-void Norm::init()
+GRUSequence::GRUSequence(Graph& graph, Function& x, Function& h,
+const GRUSequence& other) :
+Function(graph), _x(x), _h(h)
 {
-  _H = _graph.new_constant(1,1); // dimension placeholder
-
-  auto& mean = *_graph.new_sum(_x) / *_H;
-  auto& x_mean = _x - *_graph.new_broadcast(mean, _x);
-
-  auto& var = *_graph.new_sum(x_mean * x_mean) / *_H;
-  auto& std = power(var + _epsilon, 0.5);
-
-  _N = &(x_mean / *_graph.new_broadcast(std, x_mean));
-
-  if (_a->value().size() > 1 && _b->value().size() > 1)
-  {
-    _N = &(*_N * *_a + *_b);
-  }
-  else
-  {
-    auto a = _graph.new_broadcast(*_a, *_N);
-    auto b = _graph.new_broadcast(*_b, *_N);
-
-    _N = &(*_N * *a + *b);
-  }
+  // share variables with the "other"
+  _Wz = other._Wz; _Uz = other._Uz; _bz = other._bz;
+  _Wr = other._Wr; _Ur = other._Ur; _br = other._br;
+  _Wh = other._Wh; _Uh = other._Uh; _bh = other._bh;
 
-  _N->derivative(_graph.new_iderivative(*this));
+  init();
 }
 
-// F = a * (x - m) / s - b
-const Tensor& Norm::forward()
+void GRUSequence::init()
 {
-  // return cached value
-  if (_value.size()) return _value;
-
-  auto& x = _x.forward();
-
-  // update dimension placeholder
-  _H->value() = Tensor::Constant(1,1, x.rows() * x.cols());
+  _dG = nullptr;
 
-  // compute norm
-  _value = _N->forward();
-
-  return _value;
-}
+  // Derivative with respect to x
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, GRUSequence& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-///////////////////////////////////////////
-// Gaussian
-///////////////////////////////////////////
+    // dFdx = dG * [Wz Wr Wh].T
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
 
-Gaussian::Gaussian(Graph& graph, Function& x, Function& m, Function& s) : 
-Function(graph)
-{
-  // compute height of distribution's peak
-  _a = &(1 / (s * sqrt(2 * M_PI)));
+      auto& dG = _base._dG->forward();
+      int N = _base._Uz->forward().rows();
 
-  // compute argument for exp(z)
-  _z = &(-0.5 * power((x - m) / s, 2));
+      _value.noalias() = dG.leftCols(N) * _base._Wz->forward().transpose();
+      _value.noalias() += dG.middleCols(N, N) * _base._Wr->forward().transpose();
+      _value.noalias() += dG.rightCols(N) * _base._Wh->forward().transpose();
+      return _value;
+    }
 
-  // for performance and numerical stability we do NOT add exp(z) to the graph,
-  // instead, we calculate exp(z) in forward() method and use
-  // F = a * exp(z), with dFdz = a * exp(z), dFda = exp(z)
+  private:
+    GRUSequence& _base;
+  };
 
-  // Derivative with respect to a
-  class Derivative_a : public Function
+  // Derivative with respect to initial h
+  class Derivative_h : public Function
   {
   public:
-    Derivative_a(Graph& graph, Gaussian& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_h(Graph& graph, GRUSequence& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-    // dFda = exp(z)
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& z = _base._z->forward();
-      auto dFda = z.array().exp();
-
-      // update gradient value
-      _value = g.array() * dFda;
+      if (cached()) return _value;
 
-      // return gradient value
+      _value = _base._dG->h();
       return _value;
     }
 
   private:
-    Gaussian& _base;
+    GRUSequence& _base;
   };
 
-  // Derivative with respect to z
-  class Derivative_z : public Function
+  // Derivative with respect to gate p of W, U or b
+  class Derivative_gate : public Function
   {
   public:
-    Derivative_z(Graph& graph, Function& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_gate(Graph& graph, GRUSequence& base,
+    const Tensor& (Derivative_steps::*grad)(), int p) :
+    Function(graph, base), _base(base), _grad(grad), _p(p)
+    { graph.keep(this); }
 
-    // dFdz = a * exp(z) = F
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& dFdz = _base.forward();
+      if (cached()) return _value;
 
-      // update gradient value
-      _value = g.array() * dFdz.array();
+      auto& d = (_base._dG->*_grad)();
+      int N = d.cols() / 3;
 
-      // return gradient value
+      _value = d.middleCols(_p * N, N);
       return _value;
     }
 
   private:
-    Function& _base;
+    GRUSequence& _base;
+    const Tensor& (Derivative_steps::*_grad)();
+    int _p;
   };
 
-  _a->derivative(new Derivative_a(_graph, *this));
-  _z->derivative(new Derivative_z(_graph, *this));
+  Variable* W[] = { _Wz, _Wr, _Wh };
+  Variable* U[] = { _Uz, _Ur, _Uh };
+  Variable* b[] = { _bz, _br, _bh };
+
+  if (_graph.no_grad())
+  {
+    input(_x);
+    input(_h);
+    for (int i=0; i<3; i++)
+    {
+      input(*W[i]);
+      input(*U[i]);
+      input(*b[i]);
+    }
+    return;
+  }
+
+  _dG = new Derivative_steps(_graph, *this);
+
+  _x.derivative(new Derivative_x(_graph, *this));
+  _h.derivative(new Derivative_h(_graph, *this));
+  for (int i=0; i<3; i++)
+  {
+    W[i]->derivative(
+      new Derivative_gate(_graph, *this, &Derivative_steps::W, i));
+    U[i]->derivative(
+      new Derivative_gate(_graph, *this, &Derivative_steps::U, i));
+    b[i]->derivative(
+      new Derivative_gate(_graph, *this, &Derivative_steps::b, i));
+  }
 }
 
-// A = 1 / (s * sqrt(2 * PI))
-// Z = -(x - m)^2 / (2*s^2)
-// F = A * exp(Z)
-const Tensor& Gaussian::forward()
+// G = x * [Wz Wr Wh] + [bz br bh]
+// z(t), r(t) = Sigmoid(G(t) + h(t-1) * [Uz Ur])
+// c(t) = Tanh(G(t) + (r(t) . h(t-1)) * Uh)
+// h(t) = z(t) . h(t-1) + (1 - z(t)) . c(t)
+const Tensor& GRUSequence::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
-  auto& a = _a->forward();
-  auto& z = _z->forward();
+  auto& x = _x.forward();
+  auto& h = _h.forward();
+  auto& Uh = _Uh->forward();
+  int B = h.rows();
+  int N = h.cols();
 
-  // F = a * exp(Z)
-  _value = a.array() * z.array().exp();
+  if (x.rows() % B)
+    throw std::runtime_error("Sequence rows not divisible by batch size");
+
+  int T = x.rows() / B;
+
+  // input projections of all steps with stacked gates
+  Tensor W(x.cols(), 3 * N);
+  W << _Wz->forward(), _Wr->forward(), _Wh->forward();
+  RowVector b(3 * N);
+  b << _bz->forward(), _br->forward(), _bh->forward();
+
+  _G.noalias() = x * W;
+  _G.rowwise() += b;
+
+  Tensor U(N, 2 * N);
+  U << _Uz->forward(), _Ur->forward();
+
+  _value.resize(x.rows(), N);
+
+  Tensor hp = h;
+  for (int t=0; t<T; t++)
+  {
+    auto G_t = _G.middleRows(t * B, B);
+    auto zr = G_t.leftCols(2 * N);
+    auto c = G_t.rightCols(N);
+
+    zr.noalias() += hp * U;
+    zr = (1 + (-zr.array()).exp()).inverse();
+
+    auto z = G_t.leftCols(N).array();
+    auto r = G_t.middleCols(N, N).array();
+    c.noalias() += (r * hp.array()).matrix() * Uh;
+    c = c.array().tanh();
+
+    auto h_t = _value.middleRows(t * B, B);
+    h_t = z * hp.array() + (1 - z) * c.array();
+    hp = h_t;
+  }
 
   // return value
   return _value;
 }
 
 ///////////////////////////////////////////
-// Log-Gaussian
+// Function LSTM Sequence
 ///////////////////////////////////////////
 
-LogGaussian::LogGaussian(Graph& graph, Function& x, Function& m, Function& s) :
-Function(graph)
+// Gradients of gate pre-activations of all steps, value holds dG
+class LSTMSequence::Derivative_steps : public Function
+{
+public:
+  Derivative_steps(Graph& graph, LSTMSequence& base) :
+  Function(graph, base), _base(base) { graph.keep(this); }
+
+  // gradients of stacked variables and initial states
+  const Tensor& W() { forward(); return _dW; }
+  const Tensor& H() { forward(); return _dH; }
+  const Tensor& b() { forward(); return _db; }
+  const Tensor& h() { forward(); return _dh; }
+  const Tensor& c() { forward(); return _dc; }
+
+  // dh(t) = g(t) + dh(t-1) of step t+1
+  // dc(t) = dc(t-1) of step t+1 + dh(t) . o(t) . (1 - Tanh(c(t))^2)
+  // di(t) = dc(t) . g(t) . i(t) . (1 - i(t))
+  // df(t) = dc(t) . c(t-1) . f(t) . (1 - f(t))
+  // dg(t) = dc(t) . i(t) . (1 - g(t)^2)
+  // do(t) = dh(t) . Tanh(c(t)) . o(t) . (1 - o(t))
+  // dh(t-1) = dG(t) * [Hi Hf Hg Ho].T, dc(t-1) = dc(t) . f(t)
+  virtual const Tensor& forward()
+  {
+    // return cached value
+    if (cached()) return _value;
+
+    auto& g = _base.backward();
+    _base.forward();
+
+    auto& x = _base._x.forward();
+    auto& h = _base._h.forward();
+    auto& c = _base._c.forward();
+    auto& Hs = _base._value;
+    auto& Cs = _base._C;
+    auto& G = _base._G;
+    int B = h.rows();
+    int N = h.cols();
+    int T = x.rows() / B;
+
+    Tensor Hw(N, 4 * N);
+    Hw << _base._Hi->forward(), _base._Hf->forward(),
+          _base._Hg->forward(), _base._Ho->forward();
+
+    // h(t-1) and c(t-1) of all steps
+    Tensor Hp(T * B, N), Cp(T * B, N);
+    Hp.topRows(B) = h;
+    Hp.bottomRows((T - 1) * B) = Hs.topRows((T - 1) * B);
+    Cp.topRows(B) = c;
+    Cp.bottomRows((T - 1) * B) = Cs.topRows((T - 1) * B);
+
+    _value.resize(T * B, 4 * N);
+    _dh.setZero(B, N);
+    _dc.setZero(B, N);
+
+    for (int t=T-1; t>=0; t--)
+    {
+      auto G_t = G.middleRows(t * B, B).array();
+      auto i = G_t.leftCols(N);
+      auto f = G_t.middleCols(N, N);
+      auto gg = G_t.middleCols(2 * N, N);
+      auto o = G_t.rightCols(N);
+      auto cp = Cp.middleRows(t * B, B).array();
+      Tensor tc = Cs.middleRows(t * B, B).array().tanh();
+      auto dG_t = _value.middleRows(t * B, B);
+
+      _dh += g.middleRows(t * B, B);
+      auto dh = _dh.array();
+      _dc.array() += dh * o * (1 - tc.array() * tc.array());
+      auto dc = _dc.array();
+
+      dG_t.leftCols(N) = dc * gg * i * (1 - i);
+      dG_t.middleCols(N, N) = dc * cp * f * (1 - f);
+      dG_t.middleCols(2 * N, N) = dc * i * (1 - gg * gg);
+      dG_t.rightCols(N) = dh * tc.array() * o * (1 - o);
+
+      _dh.noalias() = dG_t * Hw.transpose();
+      _dc.array() *= f;
+    }
+
+    _dW = ATB(x, _value);
+    _dH = ATB(Hp, _value);
+    _db = _value.colwise().sum();
+
+    return _value;
+  }
+
+private:
+  LSTMSequence& _base;
+  Tensor _dW;
+  Tensor _dH;
+  Tensor _db;
+  Tensor _dh;
+  Tensor _dc;
+};
+
+LSTMSequence::LSTMSequence(Graph& graph, Function& x, Function& h,
+Function& c, int in, int out) :
+Function(graph), _x(x), _h(h), _c(c)
 {
-  // compute height of distribution's peak
-  _a = &(1 / (s * sqrt(2 * M_PI)));
+  // construct new variables (row-major) in order of LSTM
+  _Wi = graph.new_variable(in, out, "Wi");
+  _Hi = graph.new_variable(out, out, "Hi");
+  _bi = graph.new_variable(1, out, "bi");
 
-  // compute argument for exp(z)
-  _z = &(-0.5 * power((x - m) / s, 2));
+  _Wf = graph.new_variable(in, out, "Wf");
+  _Hf = graph.new_variable(out, out, "Hf");
+  _bf = graph.new_variable(1, out, "bf");
 
-  // for performance and numerical stability we do NOT add exp(z) to the graph,
-  // instead, we calculate exp(z) in forward() method and use
-  // F = log(a * exp(z)) = log(a) + z, with dFdz = 1, dFda = 1/a
+  _Wo = graph.new_variable(in, out, "Wo");
+  _Ho = graph.new_variable(out, out, "Ho");
+  _bo = graph.new_variable(1, out, "bo");
 
-  // Derivative with respect to a
-  class Derivative_a : public Function
+  _Wg = graph.new_variable(in, out, "Wg");
+  _Hg = graph.new_variable(out, out, "Hg");
+  _bg = graph.new_variable(1, out, "bg");
+
+  init();
+}
+
+LSTMSequence::LSTMSequence(Graph& graph, Function& x, Function& h,
+Function& c, const LSTM& other) :
+Function(graph), _x(x), _h(h), _c(c)
+{
+  // share variables with the LSTM cell
+  _Wi = other._Wi; _Hi = other._Hi; _bi = other._bi;
+  _Wf = other._Wf; _Hf = other._Hf; _bf = other._bf;
+  _Wo = other._Wo; _Ho = other._Ho; _bo = other._bo;
+  _Wg = other._Wg; _Hg = other._Hg; _bg = other._bg;
+
+  init();
+}
+
+LSTMSequence::LSTMSequence(Graph& graph, Function& x, Function& h,
+Function& c, const LSTMSequence& other) :
+Function(graph), _x(x), _h(h), _c(c)
+{
+  // share variables with the "other"
+  _Wi = other._Wi; _Hi = other._Hi; _bi = other._bi;
+  _Wf = other._Wf; _Hf = other._Hf; _bf = other._bf;
+  _Wo = other._Wo; _Ho = other._Ho; _bo = other._bo;
+  _Wg = other._Wg; _Hg = other._Hg; _bg = other._bg;
+
+  init();
+}
+
+void LSTMSequence::init()
+{
+  _dG = nullptr;
+
+  // Derivative with respect to x
+  class Derivative_x : public Function
   {
   public:
-    Derivative_a(Graph& graph, LogGaussian& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_x(Graph& graph, LSTMSequence& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-    // dFda = exp(z)
+    // dFdx = dG * [Wi Wf Wg Wo].T
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& a = _base._a->forward();
-      auto dFda = 1 / a.array();
+      if (cached()) return _value;
 
-      // update gradient value
-      _value = g.array() * dFda;
+      auto& dG = _base._dG->forward();
+      Variable* W[] = { _base._Wi, _base._Wf, _base._Wg, _base._Wo };
+      int N = dG.cols() / 4;
 
-      // return gradient value
+      _value.noalias() = dG.leftCols(N) * W[0]->forward().transpose();
+      for (int p=1; p<4; p++)
+        _value.noalias() += dG.middleCols(p * N, N) * W[p]->forward().transpose();
       return _value;
     }
 
   private:
-    LogGaussian& _base;
+    LSTMSequence& _base;
   };
 
-  // Derivative with respect to z
-  class Derivative_z : public Function
+  // Derivative with respect to initial h or c
+  class Derivative_state : public Function
   {
   public:
-    Derivative_z(Graph& graph, Function& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_state(Graph& graph, LSTMSequence& base,
+    const Tensor& (Derivative_steps::*grad)()) :
+    Function(graph, base), _base(base), _grad(grad) { graph.keep(this); }
 
-    // dFdz = a * exp(z) = F
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
-      auto& g = _base.backward();
-      // auto dFdz = Tensor::Ones(g.rows(), g.cols());
+      _value = (_base._dG->*_grad)();
+      return _value;
+    }
 
-      // update gradient value
-      _value = g.array() /** dFdz.array()*/;
+  private:
+    LSTMSequence& _base;
+    const Tensor& (Derivative_steps::*_grad)();
+  };
 
-      // return gradient value
+  // Derivative with respect to gate p of W, H or b
+  class Derivative_gate : public Function
+  {
+  public:
+    Derivative_gate(Graph& graph, LSTMSequence& base,
+    const Tensor& (Derivative_steps::*grad)(), int p) :
+    Function(graph, base), _base(base), _grad(grad), _p(p)
+    { graph.keep(this); }
+
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& d = (_base._dG->*_grad)();
+      int N = d.cols() / 4;
+
+      _value = d.middleCols(_p * N, N);
       return _value;
     }
 
   private:
-    Function& _base;
+    LSTMSequence& _base;
+    const Tensor& (Derivative_steps::*_grad)();
+    int _p;
   };
 
-  _a->derivative(new Derivative_a(_graph, *this));
-  _z->derivative(new Derivative_z(_graph, *this));
+  // gates stacked as i, f, g, o
+  Variable* W[] = { _Wi, _Wf, _Wg, _Wo };
+  Variable* H[] = { _Hi, _Hf, _Hg, _Ho };
+  Variable* b[] = { _bi, _bf, _bg, _bo };
+
+  if (_graph.no_grad())
+  {
+    input(_x);
+    input(_h);
+    input(_c);
+    for (int i=0; i<4; i++)
+    {
+      input(*W[i]);
+      input(*H[i]);
+      input(*b[i]);
+    }
+    return;
+  }
+
+  _dG = new Derivative_steps(_graph, *this);
+
+  _x.derivative(new Derivative_x(_graph, *this));
+  _h.derivative(new Derivative_state(_graph, *this, &Derivative_steps::h));
+  _c.derivative(new Derivative_state(_graph, *this, &Derivative_steps::c));
+  for (int i=0; i<4; i++)
+  {
+    W[i]->derivative(
+      new Derivative_gate(_graph, *this, &Derivative_steps::W, i));
+    H[i]->derivative(
+      new Derivative_gate(_graph, *this, &Derivative_steps::H, i));
+    b[i]->derivative(
+      new Derivative_gate(_graph, *this, &Derivative_steps::b, i));
+  }
 }
 
-// A = 1 / (s * sqrt(2 * PI))
-// Z = -(x - m)^2 / (2*s^2)
-// F = log(A * exp(Z)) = log(A) + Z
-const Tensor& LogGaussian::forward()
+// G = x * [Wi Wf Wg Wo] + [bi bf bg bo]
+// i(t), f(t), o(t) = Sigmoid(G(t) + h(t-1) * [Hi Hf Ho])
+// g(t) = Tanh(G(t) + h(t-1) * Hg)
+// c(t) = f(t) . c(t-1) + i(t) . g(t)
+// h(t) = o(t) . Tanh(c(t))
+const Tensor& LSTMSequence::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
-  auto& a = _a->forward();
-  auto& z = _z->forward();
+  auto& x = _x.forward();
+  auto& h = _h.forward();
+  auto& c = _c.forward();
+  int B = h.rows();
+  int N = h.cols();
 
-  _value = a.array().log() + z.array();
+  if (x.rows() % B)
+    throw std::runtime_error("Sequence rows not divisible by batch size");
+
+  int T = x.rows() / B;
+
+  // input projections of all steps with stacked gates
+  Tensor W(x.cols(), 4 * N);
+  W << _Wi->forward(), _Wf->forward(), _Wg->forward(), _Wo->forward();
+  RowVector b(4 * N);
+  b << _bi->forward(), _bf->forward(), _bg->forward(), _bo->forward();
+
+  _G.noalias() = x * W;
+  _G.rowwise() += b;
+
+  Tensor H(N, 4 * N);
+  H << _Hi->forward(), _Hf->forward(), _Hg->forward(), _Ho->forward();
+
+  _value.resize(x.rows(), N);
+  _C.resize(x.rows(), N);
+
+  Tensor hp = h, cp = c;
+  for (int t=0; t<T; t++)
+  {
+    auto G_t = _G.middleRows(t * B, B);
+    G_t.noalias() += hp * H;
+
+    auto i = G_t.leftCols(N).array();
+    auto f = G_t.middleCols(N, N).array();
+    auto g = G_t.middleCols(2 * N, N).array();
+    auto o = G_t.rightCols(N).array();
+    i = (1 + (-i).exp()).inverse();
+    f = (1 + (-f).exp()).inverse();
+    g = g.tanh();
+    o = (1 + (-o).exp()).inverse();
+
+    auto c_t = _C.middleRows(t * B, B);
+    auto h_t = _value.middleRows(t * B, B);
+    c_t = f * cp.array() + i * g;
+    h_t = o * c_t.array().tanh();
+    hp = h_t;
+    cp = c_t;
+  }
 
   // return value
   return _value;
 }
 
 ///////////////////////////////////////////
-// Function Embedding
+// Sampler
 ///////////////////////////////////////////
 
-Embedding::Embedding(Graph& graph, Function& i, int in, int out) :
-Function(graph), _i(i)
-{
-  // construct new variables with row-wise embedding vectors
-  _E = graph.new_variable(in, out, "Embedding.E");
-
-  init();
-}
-
-Embedding::Embedding(Graph& graph, Function& i, const Embedding& other) :
-Function(graph), _i(i)
+Sampler::Sampler(Graph& graph, Function& m, Function& s) : 
+Function(graph), _m(m), _s(s), _enabled(true)
 {
-  // share variables with the "other"
-  _E = other._E;
-
-  init();
-}
+  // random sampling with parametrization trick for back-propagation
+  // Auto-Encoding Variational Bayes by Diederik P. Kingma, Max Welling
+  // https://arxiv.org/pdf/1312.6114.pdf
 
-void Embedding::init()
-{
-  // Derivative with respect to E
-  class Derivative_E : public Function
+  // Random noise function
+  class Noise : public Function
   {
   public:
-    Derivative_E(Graph& graph, Embedding& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Noise(Graph& graph, Sampler& base) : Function(graph), _base(base)
+    {
+      _inputs.push_back(&base._m);
+      _stream = graph.random().stream();
+      _step = 0;
+      graph.keep(this);
+    }
 
-    // dFdE = x(i)
+    // e = N(0,1) of shape m
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
-
-      auto& g = _base.backward();
-      auto& E = _base._E->forward();
+      if (cached()) return _value;
 
-      // update gradient value
-      _value = Tensor::Zero(E.rows(), E.cols());
-      auto& index = _base._i();
+      int rows = _base._m().rows();
+      int cols = _base._m().cols();
 
-      for (int i=0; i<index.size(); i++)
+      // sample random value of the next step, or of the same step when
+      // a released value is recomputed
+      if (_base._enabled)
       {
-        _value.row((int)index(i)) = g.row(i);
+        _value.resize(rows, cols);
+        if (!_released) _step++;
+        Philox(_graph.random().key(), _stream, _step).normal(
+          _value.data(), _value.size(), 0, 1);
+      }
+      else
+      {
+        _value = Tensor::Zero(rows, cols);
       }
 
       return _value;
     }
 
   private:
-    Embedding& _base;
+    Sampler& _base;
+    uint32_t _stream;
+    uint32_t _step;
   };
 
-  _E->derivative(new Derivative_E(_graph, *this));
+  _e = new Noise(_graph, *this);
+
+  _Z = &(_m + *_e * _s);
+
+  identity(*_Z);
 }
 
-// F = E * x(i)
-const Tensor& Embedding::forward()
+const Tensor& Sampler::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
-
-  // get variables
-  auto& E = _E->forward();
-
-  // create initial value
-  auto& index = _i();
-  _value = Tensor::Zero(index.size(), E.cols());
+  if (cached()) return _value;
 
-  for (int i=0; i<index.size(); i++)
-  {
-    _value.row(i) = E.row((int)index(i));
-  }
+  // update value
+  _value = _Z->forward();
 
   // return value
   return _value;
 }
 
 ///////////////////////////////////////////
-// Function Conv2D
+// Norm
 ///////////////////////////////////////////
 
-Conv2D::Conv2D(
-  Graph& graph,
-  Function& x,
-  int i_rows,
-  int i_cols,
-  int i_channels,
-  int o_channels,
-  int k_rows,
-  int k_cols,
-  int stride,
-  int padding,
-  int dilation) :
-Function(graph),
-_x(x),
-_i_rows(i_rows),
-_i_cols(i_cols),
-_i_channels(i_channels),
-_o_channels(o_channels),
-_k_rows(k_rows),
-_k_cols(k_cols),
-_stride(stride),
-_padding(padding),
-_dilation(dilation)
+Norm::Norm(Graph& graph, Function& x, int rows, int cols, DTYPE eps) :
+Function(graph), _x(x), _epsilon(eps)
 {
-  // Kernels for input and output channels
-  //
-  // x - flat 2D col-major matrix
-  // I - number of input channels
-  // O - number of output channels
-  // X_i - channel i of input X
-  // Y_o - channel o of output Y
-  // K_i_o - kernel [i,o] of input X_i and output Y_o
-  // K_r - number of kernel rows
-  // K_c - number of kernel cols
-  //
-  // D = [K_r, K_c], kernel dimentions
-  // N = O * I, numbef of kernels
-  // E = K_r * K_c, number of single kernel parameters
-  // A = N * E, number of all kernel parameters
-  //
-  // Kernels are stored in kernel matrix as sub-matrices or blocks.
-  //
-  // Kernel Matrix K = [O * K_r, I * K_c]
-  //
-  // [K_1_1,...,K_I_1] // kernels for output channel 0
-  // .................
-  // [K_1_O,...,K_I_O] // kernels for outout channel O-1
-  //
-  // Examples
-  //
-  // Pseudo code to access kernel for input "i" and output "o":
-  //
-  // K[o * K_r, i * K_c, K_r, K_c]
-  //
-  // Eigen code to access kernel for input "i" and output "o" as matrix:
-  //
-  // auto kernel_i_o = K.block(o * K_r, i * K_c, K_r, K_c);
-  //
-  // Eigen code to access kernel for input "i" and output "o" as vector:
-  //
-  // auto kernel_vector_i_o = ConstTensorMap(kernel_i_o.data(), E, 1);
-  //
+  if (rows * cols > 1)
+  {
+    _a = graph.new_variable(rows, cols, "Norm.A");
+    _b = graph.new_variable(rows, cols, "Norm.B");
+  }
+  else
+  {
+    _a = graph.new_variable(1, 1, "Norm.a");
+    _b = graph.new_variable(1, 1, "Norm.b");
+  }
 
-  // construct new variables
-  _K = graph.new_variable(_o_channels * _k_rows, _i_channels * _k_cols);
+  _a->value() = Tensor::Ones(_a->value().rows(), _a->value().cols());
+  _b->value() = Tensor::Zero(_b->value().rows(), _b->value().cols());
 
   init();
 }
 
-Conv2D::Conv2D(Graph& graph, Function& x, const Conv2D& other) :
-Function(graph), _x(x)
+Norm::Norm(Graph& graph, Function& x, const Norm& other) :
+Function(graph), _x(x), _epsilon(other._epsilon)
 {
-  // share dimentions and variables with the "other"
-  _i_rows = other._i_rows;
-  _i_cols = other._i_cols,
-  _i_channels = other._i_channels,
-  _o_channels = other._o_channels,
-  _k_rows = other._k_rows;
-  _k_cols = other._k_cols;
-  _stride = other._stride,
-  _padding = other._padding,
-  _dilation = other._dilation,
-  _K = other._K;
+  _a = other._a;
+  _b = other._b;
 
   init();
 }
 
-const Tensor& Conv2D::forward()
+// mean and variance of n values in one pass, lanes of Welford updates
+// vectorize and merge by the pairwise formula of Chan et al.
+static void welford(const DTYPE* x, int n, DTYPE& mean, DTYPE& var)
 {
-  // return cached value
-  if (_value.size()) return _value;
+  const int L = 8;
+  DTYPE m[L] = {0}, s[L] = {0};
 
-  auto& x = _x();
-  auto& K = K_matrix();
+  // lanes hold k values each
+  int i = 0, k = 0;
+  for (; i + L <= n; i += L)
+  {
+    DTYPE r = DTYPE(1) / ++k;
+    for (int l=0; l<L; l++)
+    {
+      DTYPE d = x[i + l] - m[l];
+      m[l] += d * r;
+      s[l] += d * (x[i + l] - m[l]);
+    }
+  }
 
-  //_value = K * x; // col major
-  _value = ABT(x,K); // row major
+  // merge lanes
+  DTYPE M = 0, S = 0;
+  int N = 0;
+  for (int l=0; l<L && k>0; l++)
+  {
+    DTYPE d = m[l] - M;
+    int NK = N + k;
+    M += d * k / NK;
+    S += s[l] + d * d * N * k / NK;
+    N = NK;
+  }
 
-  // return value
-  return _value;
+  // remaining values
+  for (; i<n; i++)
+  {
+    DTYPE d = x[i] - M;
+    M += d / ++N;
+    S += d * (x[i] - M);
+  }
+
+  mean = M;
+  var = (N > 0) ? S / N : 0;
 }
 
-void Conv2D::init()
+bool Norm::rowwise() const
+{
+  auto& a = _a->value();
+  return a.rows() == 1 && a.cols() > 1;
+}
+
+void Norm::init()
 {
   // Derivative with respect to x
   class Derivative_x : public Function
   {
   public:
-    Derivative_x(Graph& graph, Conv2D& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_x(Graph& graph, Norm& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-    // dFdx = K_matrix
+    // dFdx = r * (dH - mean(dH) - H * mean(dH * H)), dH = g * a
+    // H = (x - m) * r, r = 1 / sqrt(var + eps)
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
-      auto& K = _base.K_matrix();
+      auto& x = _base._x.forward();
+      auto& a = _base._a->forward();
+      _base.forward();
 
-      auto& dFdx = K;
+      auto& mean = _base._mean;
+      auto& rstd = _base._rstd;
 
-      // update gradient value
-      //_value = ABT(g, dFdx); // col major
-      _value = g * dFdx; // row major
+      // gradient of normalized value
+      _value.resize(x.rows(), x.cols());
+      if (_base.rowwise())
+        _value = g.array().rowwise() * a.row(0).array();
+      else if (a.size() > 1)
+        _value = g.array() * a.array();
+      else
+        _value = g * a(0);
+
+      // rows of normalized elements
+      int rows = mean.size();
+      int cols = x.size() / rows;
+      ConstTensorMap X(x.data(), rows, cols);
+      TensorMap dH(_value.data(), rows, cols);
+
+      Tensor H = (X.array().colwise() - mean.array()).colwise() * rstd.array();
+      ColVector dH_mean = dH.rowwise().mean();
+      ColVector dHH_mean = (dH.array() * H.array()).rowwise().mean();
+
+      dH = ((dH.array().colwise() - dH_mean.array()) -
+        H.array().colwise() * dHH_mean.array()).colwise() * rstd.array();
 
       return _value;
-    }    
+    }
 
   private:
-    Conv2D& _base;
+    Norm& _base;
   };
 
-  // Derivative with respect to K
-  class Derivative_K : public Function
+  // Derivative with respect to a
+  class Derivative_a : public Function
   {
   public:
-    Derivative_K(Graph& graph, Conv2D& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_a(Graph& graph, Norm& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-    // dFdK = x
+    // dFda = g * H, reduced to the shape of a
     virtual const Tensor& forward()
     {
       // return cached value
-      if (_value.size()) return _value;
+      if (cached()) return _value;
 
       auto& g = _base.backward();
       auto& x = _base._x.forward();
-      auto& K = _base.K_matrix();
+      auto& a = _base._a->forward();
+      _base.forward();
 
-      auto& dFdK = x;
-      //auto dFdK_matrix = ABT(g, dFdK, K); // col major
-      auto dFdK_matrix = ATB(g, dFdK, K); // row major
+      auto& mean = _base._mean;
+      auto& rstd = _base._rstd;
 
-      // update gradient value
-      _value = _base.K_gradient(dFdK_matrix);
+      int rows = mean.size();
+      int cols = x.size() / rows;
+      ConstTensorMap X(x.data(), rows, cols);
+      ConstTensorMap G(g.data(), rows, cols);
+
+      Tensor gH = ((X.array().colwise() - mean.array()).colwise() *
+        rstd.array()) * G.array();
+
+      if (_base.rowwise())
+        _value = gH.colwise().sum();
+      else if (a.size() > 1)
+        _value = ConstTensorMap(gH.data(), a.rows(), a.cols());
+      else
+        _value = Tensor::Constant(1, 1, gH.sum());
 
       return _value;
     }
 
   private:
-    Conv2D& _base;
+    Norm& _base;
   };
 
-  _x.derivative(new Derivative_x(_graph, *this));
-  _K->derivative(new Derivative_K(_graph, *this));
-}
+  // Derivative with respect to b
+  class Derivative_b : public Function
+  {
+  public:
+    Derivative_b(Graph& graph, Norm& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-SparseTensor& Conv2D::K_matrix()
-{
-  if (_K_tracker.size() && _K_tracker == _K->value()) return _K_matrix;
+    // dFdb = g, reduced to the shape of b
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
 
-  _K_tracker = _K->value();
+      auto& g = _base.backward();
+      auto& b = _base._b->forward();
 
-  // convert matrix K to unrolled matrix K_matrix
-  convert(_K->value(), _K_matrix, true);
+      if (_base.rowwise())
+        _value = g.colwise().sum();
+      else if (b.size() > 1)
+        _value = g;
+      else
+        _value = Tensor::Constant(1, 1, g.sum());
 
-  return _K_matrix;
+      return _value;
+    }
+
+  private:
+    Norm& _base;
+  };
+
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_a>(*_a, *this);
+  derivative<Derivative_b>(*_b, *this);
 }
 
-Tensor Conv2D::K_gradient(SparseTensor& dK_matrix)
+// F = a * (x - m) / sqrt(var + eps) + b
+const Tensor& Norm::forward()
 {
-  // K gradient
-  Tensor dK = Tensor::Zero(
-    _o_channels * _k_rows,
-    _i_channels * _k_cols
-  );
+  // return cached value
+  if (cached()) return _value;
 
-  // convert unrolled gradient dK_matrix to gradient dK
-  convert(dK, dK_matrix, false);
+  auto& x = _x.forward();
+  auto& a = _a->forward();
+  auto& b = _b->forward();
 
-  return dK;
+  // row gain normalizes each row (sample of a batch) separately
+  int rows = rowwise() ? x.rows() : 1;
+  int cols = x.size() / rows;
+  ConstTensorMap X(x.data(), rows, cols);
+
+  // mean and variance of each row in one pass
+  _mean.resize(rows);
+  _rstd.resize(rows);
+  for (int r=0; r<rows; r++)
+  {
+    DTYPE var;
+    welford(X.row(r).data(), cols, _mean(r), var);
+    _rstd(r) = 1 / std::sqrt(var + _epsilon);
+  }
+
+  // normalize and apply gain and bias in the second pass
+  _value.resize(x.rows(), x.cols());
+  TensorMap N(_value.data(), rows, cols);
+  N = (X.array().colwise() - _mean.array()).colwise() * _rstd.array();
+
+  if (rowwise())
+  {
+    _value.array().rowwise() *= a.row(0).array();
+    _value.array().rowwise() += b.row(0).array();
+  }
+  else if (a.size() > 1)
+  {
+    _value = _value.array() * a.array() + b.array();
+  }
+  else
+  {
+    _value = _value.array() * a(0) + b(0);
+  }
+
+  return _value;
 }
 
-void Conv2D::convert(Tensor& K, SparseTensor& K_matrix, bool forward)
-{
-  // build kernel matrix by sliding kernel over input
-  //
-  // Input for single channel
-  //
-  // 1 2 3
-  // 4 5 6
-  //
-  // Multiple channels are in plannar format (channel, row, col)
-  //
-  // R,R,R, G,G,G, B,B,B
-  // 
-  // Inputs with channels in packed format (row, col, channel)
-  //
-  // R,G,B, R,G,B, R,G,B
-  //
-  // should be converted to plannar format
-  //
-  // Padded input
-  //
-  // 0 0 0 0 0
-  // 0 1 2 3 0
-  // 0 4 5 6 0
-  // 0 0 0 0 0
-  //
-  // Kernel
-  //
-  // 10 20
-  // 30 40
-  //
-  // Kernel with dilation
-  //
-  // 10 0 20
-  //  0 0  0
-  // 30 0 40
-  //
-  // Convolution over all input positions
-  //
-  //   10 20 30 40
-  // 1  0  0  0  1
-  // 2  0  0  1  2
-  // 3  0  0  2  3
-  // 4  0  0  3  0
-  // 5  0  1  0  4
-  // 6  1  2  4  5
-  // 7  2  3  5  6
-  // 8  3  0  6  0
-  // 9  0  4  0  0
-  // 0  4  5  0  0
-  // 1  5  6  0  0
-  // 2  6  0  0  0
-  //
-  // Resulting kernel matrix for one channel
-  //
-  //     1  2  3  4  5  6
-  // 1  40
-  // 2  30 40
-  // 3     30 40
-  // 4        30
-  // 5  20       40
-  // 6  10 20    30 40
-  // 7     10 20    30 40
-  // 8        10       30
-  // 9           20
-  // 0           10 20
-  // 1              10 20
-  // 2                 10
-  //
-  //
-  // Resulting kernel matrix for mulitple channels
-  //
-  //     input channel 1      input channel I
-  //
-  //     1  2  3  4  5  6 ... 1  2  3  4  5  6    o 
-  // 1  40                ... 40                  u
-  // 2  30 40             ... 30 40               t
-  // 3     30 40          ...    30 40
-  // 4        30          ...       30            c
-  // 5  20       40       ... 20       40         h
-  // 6  10 20    30 40    ... 10 20    30 40      a
-  // 7     10 20    30 40 ...    10 20    30 40   n
-  // 8        10       30 ...       10       30   n
-  // 9           20       ...          20         e
-  // 0           10 20    ...          10 20      l
-  // 1              10 20 ...             10 20
-  // 2                 10 ...                10   1
-  //    .......................................   
-  //    .......................................
-  //    .......................................
-  //     1  2  3  4  5  6 ... 1  2  3  4  5  6    o 
-  // 1  40                ... 40                  u
-  // 2  30 40             ... 30 40               t
-  // 3     30 40          ...    30 40
-  // 4        30          ...       30            c
-  // 5  20       40       ... 20       40         h
-  // 6  10 20    30 40    ... 10 20    30 40      a
-  // 7     10 20    30 40 ...    10 20    30 40   n
-  // 8        10       30 ...       10       30   n
-  // 9           20       ...          20         e
-  // 0           10 20    ...          10 20      l
-  // 1              10 20 ...             10 20
-  // 2                 10 ...                10   O
+///////////////////////////////////////////
+// GradientCheckpoint
+///////////////////////////////////////////
 
-  // row / column dilation
-  int r_d = _dilation;
-  int c_d = _dilation;
+GradientCheckpoint::GradientCheckpoint(Graph& graph, Function& x) :
+Function(graph), _x(x), _release(true)
+{
+  // functions of earlier segments
+  std::unordered_set<Function*> other;
+  for (auto e: graph.nodes())
+  {
+    auto c = dynamic_cast<GradientCheckpoint*>(e);
+    if (c) other.insert(c->_segment.begin(), c->_segment.end());
+  }
 
-  // row / column padding
-  int r_p = _padding;
-  int c_p = _padding;
+  // functions computing x within the segment boundary
+  std::vector<Function*> stack = { &x };
+  while (stack.size())
+  {
+    auto e = stack.back();
+    stack.pop_back();
 
-  // row / column stride
-  int r_s = _stride;
-  int c_s = _stride;
+    if (_inside.count(e) || other.count(e)) continue;
+    if (dynamic_cast<Constant*>(e) || dynamic_cast<Variable*>(e) ||
+        dynamic_cast<GradientCheckpoint*>(e)) continue;
 
-  // input with padding
-  int i_padded_rows = _i_rows + 2 * r_p;
-  int i_padded_cols = _i_cols + 2 * c_p;
+    _inside.insert(e);
+    for (auto i: e->_inputs) stack.push_back(i);
+  }
 
-  // kernel with dilation
-  int k_span_rows = r_d * (_k_rows - 1) + 1;
-  int k_span_cols = c_d * (_k_cols - 1) + 1;
+  for (auto e: graph.nodes()) if (_inside.count(e)) _segment.push_back(e);
 
-  // output
-  int o_rows = (_i_rows - k_span_rows + 2 * r_p) / r_s + 1;
-  int o_cols = (_i_cols - k_span_cols + 2 * c_p) / c_s + 1;
+  identity(x);
+}
 
-  // kernel matrix for input and output channels
-  K_matrix.conservativeResize(
-    _o_channels * o_rows * o_cols,
-    _i_channels *_i_rows * _i_cols
-  );
+// F = x
+const Tensor& GradientCheckpoint::forward()
+{
+  // return cached value
+  if (cached()) return _value;
 
-  // input mask with padding
-  TensorXi i_mask = TensorXi::Zero(i_padded_rows, i_padded_cols);
-  i_mask.block(r_p, c_p, _i_rows, _i_cols) = TensorXi::Ones(_i_rows, _i_cols);
+  _value = _x.forward();
 
-  // kernel mask with dilation
-  TensorXi k_mask = TensorXi::Ones(k_span_rows, k_span_cols);
-  if (_dilation > 1)
+  if (_release)
   {
-    for (int r=0; r<_k_rows - 1; r++)
-    {
-      k_mask.block(r * r_d + 1, 0, r_d - 1, k_span_cols).array() = 0;
-    }
-    for (int c=0; c<_k_cols - 1; c++)
-    {
-      k_mask.block(0, c * c_d + 1, k_span_rows, c_d - 1).array() = 0;
-    }
+    free();
+    for (auto e: _segment) e->_released = true;
   }
 
-  // update kernel matrix for all input and output channels
-  for (int i=0; i < _i_channels; i++)
-  for (int o=0; o < _o_channels; o++)
-  {
-    auto kernel = K.block(
-      o * _k_rows,
-      i * _k_cols,
-      _k_rows,
-      _k_cols
-    );
+  return _value;
+}
 
-    auto k_matrix = K_matrix.block(
-      o * o_rows * o_cols,
-      i *_i_rows * _i_cols,
-      o_rows * o_cols,
-      _i_rows * _i_cols
-    );
+// Gradient of the checkpoint comes from functions after it, whose segments
+// are back-propagated first. The recomputed segment passes it down to the
+// derivatives of the segment inputs, which keep their values until the
+// variable gradients are aggregated.
+void GradientCheckpoint::backprop()
+{
+  backward();
 
-    // row major
-    for (int r=0, m_r=0; r <= i_padded_rows - k_span_rows; r++)
-    for (int c=0; c <= i_padded_cols - k_span_cols; c++, m_r++)
-    // col major
-    //for (int c=0, m_r=0; c <= i_padded_cols - k_span_cols; c++)
-    //for (int r=0; r <= i_padded_rows - k_span_rows; r++, m_r++)
+  // recompute segment values
+  _graph.evaluate(_x);
+
+  // segment gradients, latest function first
+  for (auto it = _segment.rbegin(); it != _segment.rend(); ++it)
+  {
+    if ((*it)->_value.size()) (*it)->backward();
+  }
+
+  // derivatives of segment inputs
+  for (auto e: _segment)
+  for (auto i: e->_inputs)
+  {
+    if (_inside.count(i) || !i->_backprop || dynamic_cast<Constant*>(i))
+      continue;
+
+    for (auto d: i->_derivative)
     {
-      TensorXi conv = i_mask.block(r, c, k_span_rows, k_span_cols);
-      conv.array() *= k_mask.array();
+      if (d->_owner != e) continue;
 
-      for (int k_r=0; k_r < _k_rows; k_r++)
-      for (int k_c=0; k_c < _k_cols; k_c++)
+      // views read gradients freed below, keep their values
+      auto& value = _graph.evaluate(*d, true);
+      if (&value != &d->_value)
       {
-        // convert kernel index to convolution index
-        int conv_r = k_r * r_d;
-        int conv_c = k_c * c_d;
-
-        if (conv(conv_r, conv_c))
-        {
-          // convert input coordinates to kernel matrix column (row major)
-          int m_c = (r - r_p + conv_r) * _i_cols + (c - c_p + conv_c);
-          // convert input coordinates to kernel matrix column (col major)
-          // int m_c = (r - r_p + conv_r) + (c - c_p + conv_c) * _i_rows;
-          if (forward)
-          {
-            k_matrix.coeffRef(m_r, m_c) = kernel(k_r, k_c);
-          }
-          else
-          {
-            kernel(k_r, k_c) += k_matrix.coeff(m_r, m_c);
-          }
-        }
+        d->_value = value;
+        d->_stale = false;
       }
     }
   }
+
+  free();
+  _gradient.resize(0,0);
+}
+
+void GradientCheckpoint::free()
+{
+  for (auto e: _segment)
+  {
+    e->_value.resize(0,0);
+    e->_gradient.resize(0,0);
+    for (auto d: e->_derivative) d->_value.resize(0,0);
+  }
 }
 
 ///////////////////////////////////////////
-// Function Error
+// Gaussian
 ///////////////////////////////////////////
 
-Erf::Erf(Graph& graph, Function& x) :
-Function(graph), _x(x)
+Gaussian::Gaussian(Graph& graph, Function& x, Function& m, Function& s) : 
+Function(graph)
 {
-  // Derivative with respect to x
-  class Derivative_x : public Function
+  // compute height of distribution's peak
+  _a = &(1 / (s * sqrt(2 * M_PI)));
+
+  // compute argument for exp(z)
+  _z = &(-0.5 * power((x - m) / s, 2));
+
+  // for performance and numerical stability we do NOT add exp(z) to the graph,
+  // instead, we calculate exp(z) in forward() method and use
+  // F = a * exp(z), with dFdz = a * exp(z), dFda = exp(z)
+
+  // Derivative with respect to a
+  class Derivative_a : public Function
   {
   public:
-    Derivative_x(Graph& graph, Erf& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_a(Graph& graph, Gaussian& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
 
-    // dFdx = (2 / sqrt(pi)) * exp(-x^2)
+    // dFda = exp(z)
     virtual const Tensor& forward()
     {
-      // return cached gradient
-      if (_value.size()) return _value;
+      // return cached value
+      if (cached()) return _value;
 
       auto& g = _base.backward();
-      auto& x = _base._x.forward();
+      auto& z = _base._z->forward();
+      auto dFda = z.array().exp();
+
+      // update gradient value
+      _value = g.array() * dFda;
+
+      // return gradient value
+      return _value;
+    }
+
+  private:
+    Gaussian& _base;
+  };
 
-      // M_2_SQRTPI = 2/sqrt(pi)
-      auto dFdx = M_2_SQRTPI * (-x.array() * x.array()).exp();
+  // Derivative with respect to z
+  class Derivative_z : public Function
+  {
+  public:
+    Derivative_z(Graph& graph, Function& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdz = a * exp(z) = F
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      auto& dFdz = _base.forward();
 
       // update gradient value
-      _value = dFdx.array() * g.array();
+      _value = g.array() * dFdz.array();
 
-     return _value;
+      // return gradient value
+      return _value;
     }
 
   private:
-    Erf& _base;
+    Function& _base;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
+  derivative<Derivative_a>(*_a, *this);
+  derivative<Derivative_z>(*_z, *this);
 }
 
-// F = erf(x)
-const Tensor& Erf::forward()
+// A = 1 / (s * sqrt(2 * PI))
+// Z = -(x - m)^2 / (2*s^2)
+// F = A * exp(Z)
+const Tensor& Gaussian::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
-  // get input
-  auto& x = _x.forward();
+  auto& a = _a->forward();
+  auto& z = _z->forward();
 
-  // update value
-  _value = x.array().erf();
+  // F = a * exp(Z)
+  _value = a.array() * z.array().exp();
 
   // return value
   return _value;
 }
 
 ///////////////////////////////////////////
-// Function GeLU
+// Log-Gaussian
 ///////////////////////////////////////////
 
-#ifdef APPROXIMATE_GELU
-
-GeLU::GeLU(Graph& graph, Function& x) :
+LogGaussian::LogGaussian(Graph& graph, Function& x, Function& m, Function& s) :
 Function(graph)
 {
-  // M_2_PI = 2 / pi
-  //_gelu = &(0.5 * x * (1.0 + *graph.new_tanh(
-  //  M_2_PI * (x + 0.044715 * *graph.new_power(x, 3))
-  //)));
+  // compute height of distribution's peak
+  _a = &(1 / (s * sqrt(2 * M_PI)));
 
-  _gelu = &(x * *graph.new_sigmoid(1.702 * x));
+  // compute argument for exp(z)
+  _z = &(-0.5 * power((x - m) / s, 2));
+
+  // for performance and numerical stability we do NOT add exp(z) to the graph,
+  // instead, we calculate exp(z) in forward() method and use
+  // F = log(a * exp(z)) = log(a) + z, with dFdz = 1, dFda = 1/a
+
+  // Derivative with respect to a
+  class Derivative_a : public Function
+  {
+  public:
+    Derivative_a(Graph& graph, LogGaussian& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFda = exp(z)
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      auto& a = _base._a->forward();
+      auto dFda = 1 / a.array();
+
+      // update gradient value
+      _value = g.array() * dFda;
+
+      // return gradient value
+      return _value;
+    }
+
+  private:
+    LogGaussian& _base;
+  };
+
+  // Derivative with respect to z
+  class Derivative_z : public Function
+  {
+  public:
+    Derivative_z(Graph& graph, Function& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdz = a * exp(z) = F
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      // auto dFdz = Tensor::Ones(g.rows(), g.cols());
+
+      // update gradient value
+      _value = g.array() /** dFdz.array()*/;
+
+      // return gradient value
+      return _value;
+    }
+
+  private:
+    Function& _base;
+  };
 
-  _gelu->derivative(graph.new_iderivative(*this));
+  derivative<Derivative_a>(*_a, *this);
+  derivative<Derivative_z>(*_z, *this);
 }
 
-// F = 0.5 (1 + tanh(√2/π(x + 0.044715 x^3)))
-const Tensor& GeLU::forward()
+// A = 1 / (s * sqrt(2 * PI))
+// Z = -(x - m)^2 / (2*s^2)
+// F = log(A * exp(Z)) = log(A) + Z
+const Tensor& LogGaussian::forward()
 {
   // return cached value
-  if (_value.size()) return _value;
+  if (cached()) return _value;
 
-  _value = _gelu->forward();
+  auto& a = _a->forward();
+  auto& z = _z->forward();
+
+  _value = a.array().log() + z.array();
 
   // return value
   return _value;
 }
 
-#else
+///////////////////////////////////////////
+// Function Embedding
+///////////////////////////////////////////
 
-GeLU::GeLU(Graph& graph, Function& x) :
-Function(graph), _x(x)
+Embedding::Embedding(Graph& graph, Function& i, int in, int out) :
+Function(graph), _i(i)
 {
-  // Derivative with respect to x
-  class Derivative_x : public Function
+  // construct new variables with row-wise embedding vectors
+  _E = graph.new_variable(in, out, "Embedding.E");
+
+  init();
+}
+
+Embedding::Embedding(Graph& graph, Function& i, const Embedding& other) :
+Function(graph), _i(i)
+{
+  // share variables with the "other"
+  _E = other._E;
+
+  init();
+}
+
+void Embedding::init()
+{
+  // index is read without derivative
+  _inputs.push_back(&_i);
+
+  // Derivative with respect to E
+  class Derivative_E : public Function
   {
   public:
-    Derivative_x(Graph& graph, GeLU& base) :
-    Function(graph), _base(base) { graph.keep(this); }
+    Derivative_E(Graph& graph, Embedding& base) :
+    Function(graph, base), _base(base)
+    {
+      // gradient of indexed rows only
+      _row_sparse = true;
+      graph.keep(this);
+    }
+
+    // dFdE = x(i)
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      auto& index = _base._i();
+
+      // unique rows in order of first occurrence
+      std::unordered_map<int, int> slot;
+      _rows.clear();
+      for (int i=0; i<index.size(); i++)
+      {
+        int r = (int)index(i);
+        if (slot.emplace(r, _rows.size()).second) _rows.push_back(r);
+      }
+
+      // update gradient value of indexed rows, repeated rows add up
+      _value = Tensor::Zero(_rows.size(), g.cols());
+      for (int i=0; i<index.size(); i++)
+      {
+        _value.row(slot[(int)index(i)]) += g.row(i);
+      }
+
+      _base._E->touch(_rows);
+
+      return _value;
+    }
+
+  private:
+    Embedding& _base;
+  };
+
+  derivative<Derivative_E>(*_E, *this);
+}
+
+// F = E * x(i)
+const Tensor& Embedding::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  auto& index = _i();
+
+  // dequantize int8 embedding vectors
+  if (_quantized)
+  {
+    _value.resize(index.size(), _qW.cols());
+    for (int i=0; i<index.size(); i++)
+    {
+      int r = (int)index(i);
+      _value.row(i) = _qW.values.row(r).cast<DTYPE>() * _qW.scales(r);
+    }
+    return _value;
+  }
+
+  // get variables
+  auto& E = _E->forward();
+
+  // create initial value
+  _value = Tensor::Zero(index.size(), E.cols());
+
+  for (int i=0; i<index.size(); i++)
+  {
+    _value.row(i) = E.row((int)index(i));
+  }
+
+  // return value
+  return _value;
+}
+
+void Embedding::quantize()
+{
+  // per embedding vector scales
+  seegnify::quantize(_E->forward(), _qW);
+  _quantized = true;
+}
+
+///////////////////////////////////////////
+// Function Gather
+///////////////////////////////////////////
+
+Gather::Gather(Graph& graph, Function& x, Function& i) :
+Function(graph), _x(x), _i(i)
+{
+  // Derivative with respect to x
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, Gather& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdx(r, i(r)) = 1
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      auto& x = _base._x.forward();
+      auto& index = _base._i.forward();
+
+      _value = Tensor::Zero(x.rows(), x.cols());
+      for (int r=0; r<index.size(); r++)
+      {
+        int c = (int)index(r);
+        if (c >= 0) _value(r, c) = g(r);
+      }
+
+      return _value;
+    }
+
+  private:
+    Gather& _base;
+  };
+
+  derivative<Derivative_x>(_x, *this);
+
+  // index is read without derivative
+  input(_i);
+}
+
+// F = x(r, i(r))
+const Tensor& Gather::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  auto& x = _x.forward();
+  auto& index = _i.forward();
+
+  _value = Tensor::Zero(index.size(), 1);
+  for (int r=0; r<index.size(); r++)
+  {
+    int c = (int)index(r);
+    if (c >= 0) _value(r) = x(r, c);
+  }
+
+  return _value;
+}
+
+///////////////////////////////////////////
+// Function Conv2D
+///////////////////////////////////////////
+
+Conv2D::Conv2D(
+  Graph& graph,
+  Function& x,
+  int i_rows,
+  int i_cols,
+  int i_channels,
+  int o_channels,
+  int k_rows,
+  int k_cols,
+  int stride,
+  int padding,
+  int dilation) :
+Function(graph),
+_x(x),
+_i_rows(i_rows),
+_i_cols(i_cols),
+_i_channels(i_channels),
+_o_channels(o_channels),
+_k_rows(k_rows),
+_k_cols(k_cols),
+_stride(stride),
+_padding(padding),
+_dilation(dilation),
+_sparse(false)
+{
+  // Kernels for input and output channels
+  //
+  // x - flat 2D col-major matrix
+  // I - number of input channels
+  // O - number of output channels
+  // X_i - channel i of input X
+  // Y_o - channel o of output Y
+  // K_i_o - kernel [i,o] of input X_i and output Y_o
+  // K_r - number of kernel rows
+  // K_c - number of kernel cols
+  //
+  // D = [K_r, K_c], kernel dimentions
+  // N = O * I, numbef of kernels
+  // E = K_r * K_c, number of single kernel parameters
+  // A = N * E, number of all kernel parameters
+  //
+  // Kernels are stored in kernel matrix as sub-matrices or blocks.
+  //
+  // Kernel Matrix K = [O * K_r, I * K_c]
+  //
+  // [K_1_1,...,K_I_1] // kernels for output channel 0
+  // .................
+  // [K_1_O,...,K_I_O] // kernels for outout channel O-1
+  //
+  // Examples
+  //
+  // Pseudo code to access kernel for input "i" and output "o":
+  //
+  // K[o * K_r, i * K_c, K_r, K_c]
+  //
+  // Eigen code to access kernel for input "i" and output "o" as matrix:
+  //
+  // auto kernel_i_o = K.block(o * K_r, i * K_c, K_r, K_c);
+  //
+  // Eigen code to access kernel for input "i" and output "o" as vector:
+  //
+  // auto kernel_vector_i_o = ConstTensorMap(kernel_i_o.data(), E, 1);
+  //
+
+  // construct new variables
+  _K = graph.new_variable(_o_channels * _k_rows, _i_channels * _k_cols);
+
+  init();
+}
+
+Conv2D::Conv2D(Graph& graph, Function& x, const Conv2D& other) :
+Function(graph), _x(x)
+{
+  // share dimentions and variables with the "other"
+  _i_rows = other._i_rows;
+  _i_cols = other._i_cols,
+  _i_channels = other._i_channels,
+  _o_channels = other._o_channels,
+  _k_rows = other._k_rows;
+  _k_cols = other._k_cols;
+  _stride = other._stride,
+  _padding = other._padding,
+  _dilation = other._dilation,
+  _sparse = other._sparse;
+  _K = other._K;
+
+  init();
+}
+
+const Tensor& Conv2D::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  auto& x = _x();
+
+  // im2col and int8 GEMM for each sample (row) of a batch
+  if (_quantized)
+  {
+    int o_size = o_rows() * o_cols();
+    _value.resize(x.rows(), _o_channels * o_size);
+
+    Tensor col, out;
+    QTensor qcol;
+    for (int b=0; b<x.rows(); b++)
+    {
+      im2col(x.row(b).data(), col);
+      Tensor colT = col.transpose();
+      quantize_input(colT, qcol);
+      qgemm(_qW, qcol, out);
+      TensorMap(_value.row(b).data(), _o_channels, o_size) = out;
+    }
+
+    return _value;
+  }
+
+  if (_sparse)
+  {
+    auto& K = K_matrix();
+
+    //_value = K * x; // col major
+    _value = ABT(x,K); // row major
+
+    return _value;
+  }
+
+  // im2col and GEMM for each sample (row) of a batch
+  auto K = K_dense();
+  int o_size = o_rows() * o_cols();
+  _value.resize(x.rows(), _o_channels * o_size);
+
+  Tensor col;
+  for (int b=0; b<x.rows(); b++)
+  {
+    im2col(x.row(b).data(), col);
+    TensorMap(_value.row(b).data(), _o_channels, o_size).noalias() = K * col;
+  }
+
+  // return value
+  return _value;
+}
+
+void Conv2D::calibrate()
+{
+  _range = std::max(_range, _x().cwiseAbs().maxCoeff());
+}
+
+void Conv2D::quantize()
+{
+  // per output channel scales
+  seegnify::quantize(K_dense(), _qW);
+  _quantized = true;
+}
+
+void Conv2D::init()
+{
+  // Derivative with respect to x
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, Conv2D& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdx = K_matrix
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+
+      if (_base._sparse)
+      {
+        auto& K = _base.K_matrix();
+
+        auto& dFdx = K;
+
+        // update gradient value
+        //_value = ABT(g, dFdx); // col major
+        backend().spmm(g, dFdx, false, _value); // row major
+
+        return _value;
+      }
+
+      auto& x = _base._x.forward();
+      auto K = _base.K_dense();
+      int o_size = _base.o_rows() * _base.o_cols();
+
+      // update gradient value as col2im of K.T * g for each sample
+      _value = Tensor::Zero(x.rows(), x.cols());
+
+      Tensor col;
+      for (int b=0; b<g.rows(); b++)
+      {
+        col.noalias() = K.transpose() *
+          ConstTensorMap(g.row(b).data(), _base._o_channels, o_size);
+        _base.col2im(col, _value.row(b).data());
+      }
+
+      return _value;
+    }    
+
+  private:
+    Conv2D& _base;
+  };
+
+  // Derivative with respect to K
+  class Derivative_K : public Function
+  {
+  public:
+    Derivative_K(Graph& graph, Conv2D& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdK = x
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      auto& x = _base._x.forward();
+
+      if (_base._sparse)
+      {
+        auto& K = _base.K_matrix();
+
+        auto& dFdK = x;
+        //auto dFdK_matrix = ABT(g, dFdK, K); // col major
+        auto dFdK_matrix = ATB(g, dFdK, K); // row major
+
+        // update gradient value
+        _value = _base.K_gradient(dFdK_matrix);
+
+        return _value;
+      }
+
+      int o_size = _base.o_rows() * _base.o_cols();
+      int k_size = _base._i_channels * _base._k_rows * _base._k_cols;
+
+      // dK = sum of g * im2col(x).T over samples
+      Tensor dK = Tensor::Zero(_base._o_channels, k_size);
+
+      Tensor col;
+      for (int b=0; b<x.rows(); b++)
+      {
+        _base.im2col(x.row(b).data(), col);
+        dK.noalias() += ConstTensorMap(
+          g.row(b).data(), _base._o_channels, o_size) * col.transpose();
+      }
+
+      // update gradient value
+      _value = _base.K_gradient(dK);
+
+      return _value;
+    }
+
+  private:
+    Conv2D& _base;
+  };
+
+  derivative<Derivative_x>(_x, *this);
+  derivative<Derivative_K>(*_K, *this);
+}
+
+SparseTensor& Conv2D::K_matrix()
+{
+  if (_K_matrix.size() && _K_version == _K->version()) return _K_matrix;
+
+  // convert matrix K to unrolled matrix K_matrix
+  convert(_K->value(), _K_matrix, true);
+
+  _K_version = _K->version();
+
+  return _K_matrix;
+}
+
+Tensor Conv2D::K_gradient(SparseTensor& dK_matrix)
+{
+  // K gradient
+  Tensor dK = Tensor::Zero(
+    _o_channels * _k_rows,
+    _i_channels * _k_cols
+  );
+
+  // convert unrolled gradient dK_matrix to gradient dK
+  convert(dK, dK_matrix, false);
+
+  return dK;
+}
+
+int Conv2D::o_rows() const
+{
+  int k_span_rows = _dilation * (_k_rows - 1) + 1;
+  return (_i_rows - k_span_rows + 2 * _padding) / _stride + 1;
+}
+
+int Conv2D::o_cols() const
+{
+  int k_span_cols = _dilation * (_k_cols - 1) + 1;
+  return (_i_cols - k_span_cols + 2 * _padding) / _stride + 1;
+}
+
+Tensor Conv2D::K_dense() const
+{
+  // kernel matrix K [O * K_r, I * K_c] as GEMM weights [O, I * K_r * K_c]
+  auto& K = _K->forward();
+  Tensor W(_o_channels, _i_channels * _k_rows * _k_cols);
+
+  for (int o=0; o<_o_channels; o++)
+  for (int i=0; i<_i_channels; i++)
+  for (int k_r=0; k_r<_k_rows; k_r++)
+  {
+    W.block(o, (i * _k_rows + k_r) * _k_cols, 1, _k_cols) =
+      K.block(o * _k_rows + k_r, i * _k_cols, 1, _k_cols);
+  }
+
+  return W;
+}
+
+Tensor Conv2D::K_gradient(const Tensor& dK_dense) const
+{
+  // GEMM weights gradient [O, I * K_r * K_c] as K gradient [O * K_r, I * K_c]
+  Tensor dK(_o_channels * _k_rows, _i_channels * _k_cols);
+
+  for (int o=0; o<_o_channels; o++)
+  for (int i=0; i<_i_channels; i++)
+  for (int k_r=0; k_r<_k_rows; k_r++)
+  {
+    dK.block(o * _k_rows + k_r, i * _k_cols, 1, _k_cols) =
+      dK_dense.block(o, (i * _k_rows + k_r) * _k_cols, 1, _k_cols);
+  }
+
+  return dK;
+}
+
+void Conv2D::im2col(const DTYPE* x, Tensor& col) const
+{
+  // unroll planar input [I, rows, cols] into columns of kernel windows
+  //
+  // col row    - kernel element (i, k_r, k_c)
+  // col column - output position (o_r, o_c)
+  //
+  int out_rows = o_rows();
+  int out_cols = o_cols();
+  col.resize(_i_channels * _k_rows * _k_cols, out_rows * out_cols);
+
+  for (int i=0; i<_i_channels; i++)
+  for (int k_r=0; k_r<_k_rows; k_r++)
+  for (int k_c=0; k_c<_k_cols; k_c++)
+  {
+    auto dst = col.row((i * _k_rows + k_r) * _k_cols + k_c).data();
+    auto src = x + i * _i_rows * _i_cols;
+
+    for (int o_r=0; o_r<out_rows; o_r++)
+    {
+      int r = o_r * _stride - _padding + k_r * _dilation;
+      for (int o_c=0; o_c<out_cols; o_c++)
+      {
+        int c = o_c * _stride - _padding + k_c * _dilation;
+        bool inside = (r >= 0 && r < _i_rows && c >= 0 && c < _i_cols);
+        *dst++ = (inside) ? src[r * _i_cols + c] : 0;
+      }
+    }
+  }
+}
+
+void Conv2D::col2im(const Tensor& col, DTYPE* x) const
+{
+  // fold columns of kernel windows back into planar input (accumulate)
+  int out_rows = o_rows();
+  int out_cols = o_cols();
+
+  for (int i=0; i<_i_channels; i++)
+  for (int k_r=0; k_r<_k_rows; k_r++)
+  for (int k_c=0; k_c<_k_cols; k_c++)
+  {
+    auto src = col.row((i * _k_rows + k_r) * _k_cols + k_c).data();
+    auto dst = x + i * _i_rows * _i_cols;
+
+    for (int o_r=0; o_r<out_rows; o_r++)
+    {
+      int r = o_r * _stride - _padding + k_r * _dilation;
+      for (int o_c=0; o_c<out_cols; o_c++, src++)
+      {
+        int c = o_c * _stride - _padding + k_c * _dilation;
+        if (r >= 0 && r < _i_rows && c >= 0 && c < _i_cols)
+        {
+          dst[r * _i_cols + c] += *src;
+        }
+      }
+    }
+  }
+}
+
+void Conv2D::convert(Tensor& K, SparseTensor& K_matrix, bool forward)
+{
+  // build kernel matrix by sliding kernel over input
+  //
+  // Input for single channel
+  //
+  // 1 2 3
+  // 4 5 6
+  //
+  // Multiple channels are in plannar format (channel, row, col)
+  //
+  // R,R,R, G,G,G, B,B,B
+  // 
+  // Inputs with channels in packed format (row, col, channel)
+  //
+  // R,G,B, R,G,B, R,G,B
+  //
+  // should be converted to plannar format
+  //
+  // Padded input
+  //
+  // 0 0 0 0 0
+  // 0 1 2 3 0
+  // 0 4 5 6 0
+  // 0 0 0 0 0
+  //
+  // Kernel
+  //
+  // 10 20
+  // 30 40
+  //
+  // Kernel with dilation
+  //
+  // 10 0 20
+  //  0 0  0
+  // 30 0 40
+  //
+  // Convolution over all input positions
+  //
+  //   10 20 30 40
+  // 1  0  0  0  1
+  // 2  0  0  1  2
+  // 3  0  0  2  3
+  // 4  0  0  3  0
+  // 5  0  1  0  4
+  // 6  1  2  4  5
+  // 7  2  3  5  6
+  // 8  3  0  6  0
+  // 9  0  4  0  0
+  // 0  4  5  0  0
+  // 1  5  6  0  0
+  // 2  6  0  0  0
+  //
+  // Resulting kernel matrix for one channel
+  //
+  //     1  2  3  4  5  6
+  // 1  40
+  // 2  30 40
+  // 3     30 40
+  // 4        30
+  // 5  20       40
+  // 6  10 20    30 40
+  // 7     10 20    30 40
+  // 8        10       30
+  // 9           20
+  // 0           10 20
+  // 1              10 20
+  // 2                 10
+  //
+  //
+  // Resulting kernel matrix for mulitple channels
+  //
+  //     input channel 1      input channel I
+  //
+  //     1  2  3  4  5  6 ... 1  2  3  4  5  6    o 
+  // 1  40                ... 40                  u
+  // 2  30 40             ... 30 40               t
+  // 3     30 40          ...    30 40
+  // 4        30          ...       30            c
+  // 5  20       40       ... 20       40         h
+  // 6  10 20    30 40    ... 10 20    30 40      a
+  // 7     10 20    30 40 ...    10 20    30 40   n
+  // 8        10       30 ...       10       30   n
+  // 9           20       ...          20         e
+  // 0           10 20    ...          10 20      l
+  // 1              10 20 ...             10 20
+  // 2                 10 ...                10   1
+  //    .......................................   
+  //    .......................................
+  //    .......................................
+  //     1  2  3  4  5  6 ... 1  2  3  4  5  6    o 
+  // 1  40                ... 40                  u
+  // 2  30 40             ... 30 40               t
+  // 3     30 40          ...    30 40
+  // 4        30          ...       30            c
+  // 5  20       40       ... 20       40         h
+  // 6  10 20    30 40    ... 10 20    30 40      a
+  // 7     10 20    30 40 ...    10 20    30 40   n
+  // 8        10       30 ...       10       30   n
+  // 9           20       ...          20         e
+  // 0           10 20    ...          10 20      l
+  // 1              10 20 ...             10 20
+  // 2                 10 ...                10   O
+
+  // row / column dilation
+  int r_d = _dilation;
+  int c_d = _dilation;
+
+  // row / column padding
+  int r_p = _padding;
+  int c_p = _padding;
+
+  // row / column stride
+  int r_s = _stride;
+  int c_s = _stride;
+
+  // input with padding
+  int i_padded_rows = _i_rows + 2 * r_p;
+  int i_padded_cols = _i_cols + 2 * c_p;
+
+  // kernel with dilation
+  int k_span_rows = r_d * (_k_rows - 1) + 1;
+  int k_span_cols = c_d * (_k_cols - 1) + 1;
+
+  // output
+  int o_rows = (_i_rows - k_span_rows + 2 * r_p) / r_s + 1;
+  int o_cols = (_i_cols - k_span_cols + 2 * c_p) / c_s + 1;
+
+  // kernel matrix for input and output channels
+  K_matrix.conservativeResize(
+    _o_channels * o_rows * o_cols,
+    _i_channels *_i_rows * _i_cols
+  );
+
+  // input mask with padding
+  TensorXi i_mask = TensorXi::Zero(i_padded_rows, i_padded_cols);
+  i_mask.block(r_p, c_p, _i_rows, _i_cols) = TensorXi::Ones(_i_rows, _i_cols);
+
+  // kernel mask with dilation
+  TensorXi k_mask = TensorXi::Ones(k_span_rows, k_span_cols);
+  if (_dilation > 1)
+  {
+    for (int r=0; r<_k_rows - 1; r++)
+    {
+      k_mask.block(r * r_d + 1, 0, r_d - 1, k_span_cols).array() = 0;
+    }
+    for (int c=0; c<_k_cols - 1; c++)
+    {
+      k_mask.block(0, c * c_d + 1, k_span_rows, c_d - 1).array() = 0;
+    }
+  }
+
+  // update kernel matrix for all input and output channels
+  for (int i=0; i < _i_channels; i++)
+  for (int o=0; o < _o_channels; o++)
+  {
+    auto kernel = K.block(
+      o * _k_rows,
+      i * _k_cols,
+      _k_rows,
+      _k_cols
+    );
+
+    auto k_matrix = K_matrix.block(
+      o * o_rows * o_cols,
+      i *_i_rows * _i_cols,
+      o_rows * o_cols,
+      _i_rows * _i_cols
+    );
+
+    // row major
+    for (int r=0, m_r=0; r <= i_padded_rows - k_span_rows; r += r_s)
+    for (int c=0; c <= i_padded_cols - k_span_cols; c += c_s, m_r++)
+    // col major
+    //for (int c=0, m_r=0; c <= i_padded_cols - k_span_cols; c++)
+    //for (int r=0; r <= i_padded_rows - k_span_rows; r++, m_r++)
+    {
+      TensorXi conv = i_mask.block(r, c, k_span_rows, k_span_cols);
+      conv.array() *= k_mask.array();
+
+      for (int k_r=0; k_r < _k_rows; k_r++)
+      for (int k_c=0; k_c < _k_cols; k_c++)
+      {
+        // convert kernel index to convolution index
+        int conv_r = k_r * r_d;
+        int conv_c = k_c * c_d;
+
+        if (conv(conv_r, conv_c))
+        {
+          // convert input coordinates to kernel matrix column (row major)
+          int m_c = (r - r_p + conv_r) * _i_cols + (c - c_p + conv_c);
+          // convert input coordinates to kernel matrix column (col major)
+          // int m_c = (r - r_p + conv_r) + (c - c_p + conv_c) * _i_rows;
+          if (forward)
+          {
+            k_matrix.coeffRef(m_r, m_c) = kernel(k_r, k_c);
+          }
+          else
+          {
+            kernel(k_r, k_c) += k_matrix.coeff(m_r, m_c);
+          }
+        }
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////
+// Function Error
+///////////////////////////////////////////
+
+Erf::Erf(Graph& graph, Function& x) :
+Function(graph), _x(x)
+{
+  // Derivative with respect to x
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, Erf& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdx = (2 / sqrt(pi)) * exp(-x^2)
+    virtual const Tensor& forward()
+    {
+      // return cached gradient
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      _base.forward();
+
+      // update gradient value with derivative from forward pass
+      _value = g.array() * _base._dFdx.array();
+
+     return _value;
+    }
+
+  private:
+    Erf& _base;
+  };
+
+  derivative<Derivative_x>(_x, *this);
+}
+
+// F = erf(x)
+const Tensor& Erf::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  // get input
+  auto& x = _x.forward();
+
+  // update value and derivative
+  erf_kernel(x, _value, _dFdx);
+
+  // return value
+  return _value;
+}
+
+///////////////////////////////////////////
+// Function GeLU
+///////////////////////////////////////////
+
+#ifdef APPROXIMATE_GELU
+
+GeLU::GeLU(Graph& graph, Function& x) :
+Function(graph)
+{
+  // M_2_PI = 2 / pi
+  //_gelu = &(0.5 * x * (1.0 + *graph.new_tanh(
+  //  M_2_PI * (x + 0.044715 * *graph.new_power(x, 3))
+  //)));
+
+  _gelu = &(x * *graph.new_sigmoid(1.702 * x));
+
+  identity(*_gelu);
+}
+
+// F = 0.5 (1 + tanh(√2/π(x + 0.044715 x^3)))
+const Tensor& GeLU::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  _value = _gelu->forward();
+
+  // return value
+  return _value;
+}
+
+#else
+
+GeLU::GeLU(Graph& graph, Function& x) :
+Function(graph), _x(x)
+{
+  // Derivative with respect to x
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, GeLU& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // F = 0.5 * x * (1 + erf(x / sqrt(2)))
+    // z(x) = x / sqrt(2)
+    // F = 0.5 * x * (1 + erf(z))
+    // dFdx = 0.5 * (1 + erf(z)) + 0.5 * x * derfdz / sqrt(2)
+    // derfdz = erf(-z^2) * 2 / sqrt(pi)
+    // dFdx = 0.5 * (1 + erf(z)) + 0.5 * x * erf(-z^2) * 2 / sqrt(pi) / sqrt(2)
+    virtual const Tensor& forward()
+    {
+      // return cached gradient
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      _base.forward();
+
+      // update gradient value with derivative from forward pass
+      _value = g.array() * _base._dFdx.array();
+
+      return _value;
+    }
+
+  private:
+    GeLU& _base;
+  };
+
+  derivative<Derivative_x>(_x, *this);
+}
+
+// F = 0.5 * x * (1 + erf(x / sqrt(2)))
+const Tensor& GeLU::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  // get input
+  auto& x = _x.forward();
+
+  // update value and derivative
+  gelu_kernel(x, _value, _dFdx);
+
+  // return value
+  return _value;
+}
+
+#endif
+
+///////////////////////////////////////////
+// Function Multi-Head Attention
+///////////////////////////////////////////
+
+// row-wise softmax in place
+static void softmax_rows(Tensor& x)
+{
+  ColVector max = x.rowwise().maxCoeff();
+  x = (x.array().colwise() - max.array()).exp();
+  ColVector sum = x.rowwise().sum();
+  x.array().colwise() /= sum.array();
+}
+
+// Gradients of projections Q, K and V, value holds dQ
+class MultiHeadAttention::Derivative_heads : public Function
+{
+public:
+  Derivative_heads(Graph& graph, MultiHeadAttention& base) :
+  Function(graph, base), _base(base) { graph.keep(this); }
+
+  // gradient of projection i of Q, K and V
+  const Tensor& projection(int i)
+  {
+    forward();
+    return (i == 0) ? _value : (i == 1) ? _dK : _dV;
+  }
+
+  // dO = g * Wo
+  // dV(h) = A(h).T * dO(h)
+  // dA(h) = dO(h) * V(h).T
+  // dS(h) = P(h) * (dA(h) - sum(dA(h) * P(h))), A(h) = P(h) with dropout
+  // dQ(h) = dS(h) * K(h) / sqrt(D)
+  // dK(h) = dS(h).T * Q(h) / sqrt(D)
+  virtual const Tensor& forward()
+  {
+    // return cached value
+    if (cached()) return _value;
+
+    auto& g = _base.backward();
+    _base.forward();
+
+    auto& Q = _base._Q;
+    auto& K = _base._K;
+    auto& V = _base._V;
+    int E = Q.cols();
+    int D = E / _base._heads;
+    DTYPE scale = 1 / std::sqrt(DTYPE(D));
+
+    Tensor dO = g * _base._Wo->forward();
+
+    _value.setZero(Q.rows(), E);
+    _dK.setZero(K.rows(), E);
+    _dV.setZero(V.rows(), E);
+
+    if (_base._tile > 0)
+    {
+      tiled(dO);
+      return _value;
+    }
+
+    Tensor dA;
+    auto& blocks = _base._blocks;
+    for (int b=0; b<blocks.size(); b++)
+    for (int h=0; h<_base._heads; h++)
+    {
+      auto& B = blocks[b];
+      auto& P = _base._P[b * _base._heads + h];
+      auto dO_h = dO.block(B.q, h * D, B.q_rows, D);
+      auto V_h = V.block(B.k, h * D, B.k_rows, D);
+      auto dV_h = _dV.block(B.k, h * D, B.k_rows, D);
+
+      // gradient through dropout mask
+      if (_base._M.size())
+      {
+        auto& M = _base._M[b * _base._heads + h];
+        dV_h.noalias() = P.cwiseProduct(M).transpose() * dO_h;
+        dA.noalias() = dO_h * V_h.transpose();
+        dA.array() *= M.array();
+      }
+      else
+      {
+        dV_h.noalias() = P.transpose() * dO_h;
+        dA.noalias() = dO_h * V_h.transpose();
+      }
+
+      // row-wise softmax Jacobian-vector product
+      ColVector s = (dA.array() * P.array()).rowwise().sum();
+      dA = P.array() * (dA.array().colwise() - s.array());
+
+      _value.block(B.q, h * D, B.q_rows, D).noalias() =
+        scale * dA * K.block(B.k, h * D, B.k_rows, D);
+      _dK.block(B.k, h * D, B.k_rows, D).noalias() =
+        scale * dA.transpose() * Q.block(B.q, h * D, B.q_rows, D);
+    }
+
+    return _value;
+  }
+
+private:
+  // recompute attention of each tile from the row log-sum-exp L
+  // P(h) = exp(S(h) - L(h))
+  // dS(h) = P(h) * (dA(h) - sum(dO(h) * O(h)))
+  void tiled(const Tensor& dO)
+  {
+    auto& Q = _base._Q;
+    auto& K = _base._K;
+    auto& V = _base._V;
+    auto& mask = _base._mask.forward();
+    int D = Q.cols() / _base._heads;
+    DTYPE scale = 1 / std::sqrt(DTYPE(D));
+    bool dropout = _base._enabled && _base._rate > 0;
+
+    Tensor S, M, dA;
+    for (int h=0; h<_base._heads; h++)
+    {
+      ColVector s = (dO.middleCols(h * D, D).array() *
+        _base._O.middleCols(h * D, D).array()).rowwise().sum();
+
+      for (auto& B: _base._blocks)
+      for (auto& T: _base.tiles(B))
+      {
+        _base.scores(mask, B, T, h, S);
+        S = (S.array().colwise() -
+          _base._L.col(h).segment(T.q, T.q_rows).array()).exp();
+
+        auto dO_t = dO.block(T.q, h * D, T.q_rows, D);
+        auto V_t = V.block(T.k, h * D, T.k_rows, D);
+        auto dV_t = _dV.block(T.k, h * D, T.k_rows, D);
+
+        dA.noalias() = dO_t * V_t.transpose();
+        if (dropout)
+        {
+          _base.dropout(T, h, M);
+          dV_t.noalias() += S.cwiseProduct(M).transpose() * dO_t;
+          dA.array() *= M.array();
+        }
+        else
+        {
+          dV_t.noalias() += S.transpose() * dO_t;
+        }
+
+        dA = S.array() * (dA.array().colwise() -
+          s.segment(T.q, T.q_rows).array());
+
+        _value.block(T.q, h * D, T.q_rows, D).noalias() +=
+          scale * dA * K.block(T.k, h * D, T.k_rows, D);
+        _dK.block(T.k, h * D, T.k_rows, D).noalias() +=
+          scale * dA.transpose() * Q.block(T.q, h * D, T.q_rows, D);
+      }
+    }
+  }
+
+  MultiHeadAttention& _base;
+  Tensor _dK;
+  Tensor _dV;
+};
+
+// q dim = [trg_size x emb_size]
+// k, v dim = [seq_size x emb_size]
+// Wq, Wk, Wv, Wo dim = [emb_size x emb_size]
+MultiHeadAttention::MultiHeadAttention(
+  Graph& graph, Function& q, Function& k, Function& v, Function& mask,
+  int trg_size, int seq_size, int emb_size, int num_heads,
+  bool bias, DTYPE dropout
+) :
+Function(graph), _q(q), _k(k), _v(v), _mask(mask),
+_trg_size(trg_size), _seq_size(seq_size), _heads(num_heads), _rate(dropout)
+{
+  if (trg_size < 1 || seq_size < 1)
+    throw std::runtime_error("Invalid attention sequence size");
+  if (num_heads < 1 || emb_size % num_heads)
+    throw std::runtime_error("Embedding size not divisible by heads");
+
+  int E = emb_size;
+
+  // construct new variables
+  _Wq = graph.new_variable(E, E, "MHA.Wq");
+  _bq = (bias) ? graph.new_variable(1, E, "MHA.bq") : nullptr;
+  _Wk = graph.new_variable(E, E, "MHA.Wk");
+  _bk = (bias) ? graph.new_variable(1, E, "MHA.bk") : nullptr;
+  _Wv = graph.new_variable(E, E, "MHA.Wv");
+  _bv = (bias) ? graph.new_variable(1, E, "MHA.bv") : nullptr;
+  _Wo = graph.new_variable(E, E, "MHA.Wo");
+  _bo = (bias) ? graph.new_variable(1, E, "MHA.bo") : nullptr;
+
+  init();
+}
+
+MultiHeadAttention::MultiHeadAttention(
+  Graph& graph, Function& q, Function& k, Function& v, Function& mask,
+  const MultiHeadAttention& other
+) :
+Function(graph), _q(q), _k(k), _v(v), _mask(mask),
+_trg_size(0), _seq_size(0), _heads(other._heads), _rate(other._rate)
+{
+  // share variables with the "other"
+  _Wq = other._Wq; _bq = other._bq;
+  _Wk = other._Wk; _bk = other._bk;
+  _Wv = other._Wv; _bv = other._bv;
+  _Wo = other._Wo; _bo = other._bo;
+
+  init();
+}
+
+void MultiHeadAttention::init()
+{
+  _enabled = true;
+  _causal = false;
+  _tile = 0;
+  _stream = _graph.random().stream();
+  _step = 0;
+  _dQKV = nullptr;
+
+  // Derivative with respect to q, k or v
+  class Derivative_x : public Function
+  {
+  public:
+    Derivative_x(Graph& graph, MultiHeadAttention& base, Function& x) :
+    Function(graph, base), _base(base), _x(x) { graph.keep(this); }
+
+    // dFdx = sum of dP * Wp over projections P of x
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      Function* x[] = { &_base._q, &_base._k, &_base._v };
+      Variable* W[] = { _base._Wq, _base._Wk, _base._Wv };
+
+      std::vector<int> p;
+      for (int i=0; i<3; i++) if (x[i] == &_x) p.push_back(i);
+
+      if (p.size() == 1)
+      {
+        _value.noalias() = _base._dQKV->projection(p[0]) * W[p[0]]->forward();
+        return _value;
+      }
+
+      // one GEMM over joined projections
+      int E = _base._Wo->forward().rows();
+      Tensor dP(_x.forward().rows(), p.size() * E);
+      Tensor Wp(p.size() * E, E);
+      for (int i=0; i<p.size(); i++)
+      {
+        dP.middleCols(i * E, E) = _base._dQKV->projection(p[i]);
+        Wp.middleRows(i * E, E) = W[p[i]]->forward();
+      }
+
+      _value.noalias() = dP * Wp;
+      return _value;
+    }
+
+  private:
+    MultiHeadAttention& _base;
+    Function& _x;
+  };
+
+  // Derivative with respect to Wq, Wk or Wv
+  class Derivative_W : public Function
+  {
+  public:
+    Derivative_W(Graph& graph, MultiHeadAttention& base, Function& x, int p) :
+    Function(graph, base), _base(base), _x(x), _p(p) { graph.keep(this); }
+
+    // dFdW = dP.T * x
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      _value = ATB(_base._dQKV->projection(_p), _x.forward());
+      return _value;
+    }
+
+  private:
+    MultiHeadAttention& _base;
+    Function& _x;
+    int _p;
+  };
+
+  // Derivative with respect to bq, bk or bv
+  class Derivative_b : public Function
+  {
+  public:
+    Derivative_b(Graph& graph, MultiHeadAttention& base, int p) :
+    Function(graph, base), _base(base), _p(p) { graph.keep(this); }
+
+    // dFdb = sum(dP)
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      _value = _base._dQKV->projection(_p).colwise().sum();
+      return _value;
+    }
+
+  private:
+    MultiHeadAttention& _base;
+    int _p;
+  };
+
+  // Derivative with respect to Wo
+  class Derivative_Wo : public Function
+  {
+  public:
+    Derivative_Wo(Graph& graph, MultiHeadAttention& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdWo = g.T * O
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      auto& g = _base.backward();
+      _base.forward();
+
+      _value = ATB(g, _base._O);
+      return _value;
+    }
+
+  private:
+    MultiHeadAttention& _base;
+  };
+
+  // Derivative with respect to bo
+  class Derivative_bo : public Function
+  {
+  public:
+    Derivative_bo(Graph& graph, MultiHeadAttention& base) :
+    Function(graph, base), _base(base) { graph.keep(this); }
+
+    // dFdbo = sum(g)
+    virtual const Tensor& forward()
+    {
+      // return cached value
+      if (cached()) return _value;
+
+      _value = _base.backward().colwise().sum();
+      return _value;
+    }
+
+  private:
+    MultiHeadAttention& _base;
+  };
+
+  Function* x[] = { &_q, &_k, &_v };
+  Variable* W[] = { _Wq, _Wk, _Wv };
+  Variable* b[] = { _bq, _bk, _bv };
+
+  // mask is added to scores without gradient
+  input(_mask);
+
+  if (_graph.no_grad())
+  {
+    for (int i=0; i<3; i++)
+    {
+      input(*x[i]);
+      input(*W[i]);
+      if (b[i]) input(*b[i]);
+    }
+    input(*_Wo);
+    if (_bo) input(*_bo);
+    return;
+  }
+
+  _dQKV = new Derivative_heads(_graph, *this);
+
+  for (int i=0; i<3; i++)
+  {
+    // input shared by projections has one derivative
+    if (std::find(x, x + i, x[i]) == x + i)
+      x[i]->derivative(new Derivative_x(_graph, *this, *x[i]));
+
+    W[i]->derivative(new Derivative_W(_graph, *this, *x[i], i));
+    if (b[i]) b[i]->derivative(new Derivative_b(_graph, *this, i));
+  }
+
+  _Wo->derivative(new Derivative_Wo(_graph, *this));
+  if (_bo) _bo->derivative(new Derivative_bo(_graph, *this));
+}
+
+// F = concat(A(h) * V(h)) * Wo.T + bo
+const Tensor& MultiHeadAttention::forward()
+{
+  // return cached value
+  if (cached()) return _value;
+
+  // get input
+  auto& q = _q.forward();
+  auto& k = _k.forward();
+  auto& v = _v.forward();
+  auto& mask = _mask.forward();
+
+  int E = _Wo->forward().rows();
+  int D = E / _heads;
+  DTYPE scale = 1 / std::sqrt(DTYPE(D));
+
+  // rows of constructed sizes unless packed, shared attention may differ
+  bool sized = _q_offsets.empty();
+  if ((sized && _trg_size && q.rows() != _trg_size) ||
+      (sized && _seq_size && k.rows() != _seq_size) ||
+      k.rows() != v.rows() ||
+      q.cols() != E || k.cols() != E || v.cols() != E)
+    throw std::runtime_error("Incompatible attention of q " + shape(q) +
+      ", k " + shape(k) + " and v " + shape(v));
+
+  // self-attention projects Q, K and V with one GEMM
+  if (&_q == &_k && &_k == &_v)
+  {
+    Tensor W(3 * E, E);
+    W << _Wq->forward(), _Wk->forward(), _Wv->forward();
+
+    Tensor QKV = ABT(q, W);
+    if (_bq)
+    {
+      RowVector b(3 * E);
+      b << _bq->forward(), _bk->forward(), _bv->forward();
+      QKV.rowwise() += b;
+    }
+
+    _Q = QKV.leftCols(E);
+    _K = QKV.middleCols(E, E);
+    _V = QKV.rightCols(E);
+  }
+  else
+  {
+    _Q = ABT(q, _Wq->forward());
+    _K = ABT(k, _Wk->forward());
+    _V = ABT(v, _Wv->forward());
+    if (_bq) _Q.rowwise() += _bq->forward().row(0);
+    if (_bk) _K.rowwise() += _bk->forward().row(0);
+    if (_bv) _V.rowwise() += _bv->forward().row(0);
+  }
+
+  bool dropout = _enabled && _rate > 0;
+  DTYPE inf = std::numeric_limits<DTYPE>::infinity();
+
+  _blocks = blocks(_Q.rows(), _K.rows());
+  if (dropout && !_released) _step++;
+
+  if (_tile > 0)
+  {
+    attend_tiled(mask);
+
+    // output projection
+    _value = ABT(_O, _Wo->forward());
+    if (_bo) _value.rowwise() += _bo->forward().row(0);
+    return _value;
+  }
+
+  _L.resize(0, 0);
+  _P.resize(_blocks.size() * _heads);
+  _M.resize(dropout ? _P.size() : 0);
+  _O.setZero(_Q.rows(), E);
+
+  // heads are strided column blocks of Q, K, V and O, packed sequences
+  // are row blocks attending to each other only
+  for (int b=0; b<_blocks.size(); b++)
+  for (int h=0; h<_heads; h++)
+  {
+    auto& B = _blocks[b];
+    auto& P = _P[b * _heads + h];
+    auto O_h = _O.block(B.q, h * D, B.q_rows, D);
+    auto V_h = _V.block(B.k, h * D, B.k_rows, D);
+
+    P.noalias() = _Q.block(B.q, h * D, B.q_rows, D) *
+      _K.block(B.k, h * D, B.k_rows, D).transpose();
+
+    // scale, mask and row-wise softmax in place
+    if (_q_offsets.empty())
+      P = P.array() * scale + mask.array();
+    else
+      P *= scale;
+    if (_causal) P.triangularView<Eigen::StrictlyUpper>().setConstant(-inf);
+    softmax_rows(P);
+
+    if (dropout)
+    {
+      auto& M = _M[b * _heads + h];
+      this->dropout(B, h, M);
+      O_h.noalias() = P.cwiseProduct(M) * V_h;
+    }
+    else
+    {
+      O_h.noalias() = P * V_h;
+    }
+  }
+
+  // output projection
+  _value = ABT(_O, _Wo->forward());
+  if (_bo) _value.rowwise() += _bo->forward().row(0);
+
+  // return value
+  return _value;
+}
+
+void MultiHeadAttention::pack(const std::vector<int>& q_offsets,
+const std::vector<int>& k_offsets, bool causal)
+{
+  if (q_offsets.size() != k_offsets.size() || q_offsets.size() < 2)
+    throw std::runtime_error("Incompatible packed sequence offsets");
+
+  _q_offsets = q_offsets;
+  _k_offsets = k_offsets;
+  _causal = causal;
+}
+
+void MultiHeadAttention::unpack()
+{
+  _q_offsets.clear();
+  _k_offsets.clear();
+  _causal = false;
+}
+
+std::vector<MultiHeadAttention::Block> MultiHeadAttention::blocks(
+int q_rows, int k_rows) const
+{
+  if (_q_offsets.empty()) return { Block{ 0, q_rows, 0, k_rows } };
+
+  if (_q_offsets.back() != q_rows || _k_offsets.back() != k_rows)
+    throw std::runtime_error("Packed sequence offsets do not match rows");
+
+  std::vector<Block> blocks;
+  for (int i=1; i<_q_offsets.size(); i++)
+  {
+    Block b;
+    b.q = _q_offsets[i-1];
+    b.q_rows = _q_offsets[i] - b.q;
+    b.k = _k_offsets[i-1];
+    b.k_rows = _k_offsets[i] - b.k;
+    blocks.push_back(b);
+  }
+
+  return blocks;
+}
+
+std::vector<MultiHeadAttention::Block> MultiHeadAttention::tiles(
+const Block& block) const
+{
+  std::vector<Block> tiles;
+  for (int i=0; i<block.q_rows; i+=_tile)
+  for (int j=0; j<block.k_rows; j+=_tile)
+  {
+    Block t;
+    t.q = block.q + i;
+    t.q_rows = std::min(_tile, block.q_rows - i);
+    t.k = block.k + j;
+    t.k_rows = std::min(_tile, block.k_rows - j);
+
+    // keys past the last query of the tile are hidden
+    if (_causal && j > i + t.q_rows - 1) break;
+    tiles.push_back(t);
+  }
+
+  return tiles;
+}
+
+void MultiHeadAttention::scores(const Tensor& mask, const Block& block,
+const Block& tile, int h, Tensor& S) const
+{
+  int D = _Q.cols() / _heads;
+  DTYPE scale = 1 / std::sqrt(DTYPE(D));
+  DTYPE inf = std::numeric_limits<DTYPE>::infinity();
+
+  S.noalias() = _Q.block(tile.q, h * D, tile.q_rows, D) *
+    _K.block(tile.k, h * D, tile.k_rows, D).transpose();
+
+  if (_q_offsets.empty())
+    S = S.array() * scale + mask.block(tile.q, tile.k,
+      tile.q_rows, tile.k_rows).array();
+  else
+    S *= scale;
+
+  // hide key c from query r past the diagonal of the block
+  if (_causal)
+  {
+    int d = (tile.k - block.k) - (tile.q - block.q);
+    for (int r=0; r<S.rows(); r++)
+    for (int c=std::max(0, r - d + 1); c<S.cols(); c++) S(r, c) = -inf;
+  }
+}
+
+// rows of tile are ranges of mask [heads * q rows x k rows] of the step,
+// tiled and full attention draw the same mask
+void MultiHeadAttention::dropout(const Block& tile, int h, Tensor& M) const
+{
+  Philox philox(_graph.random().key(), _stream, _step);
+
+  M.resize(tile.q_rows, tile.k_rows);
+  for (int r=0; r<tile.q_rows; r++)
+  {
+    uint64_t row = uint64_t(h) * _Q.rows() + tile.q + r;
+    philox.uniform(M.row(r).data(), tile.k_rows, row * _K.rows() + tile.k);
+  }
+
+  M = (M.array() < _rate).select(DTYPE(0), Tensor::Ones(M.rows(), M.cols()));
+}
+
+// O(h) = sum(exp(S(h) - m) * V(h)) / l over key tiles, where the running
+// row maximum m and sum l are rescaled by each new tile
+void MultiHeadAttention::attend_tiled(const Tensor& mask)
+{
+  int E = _Q.cols();
+  int D = E / _heads;
+  bool dropout = _enabled && _rate > 0;
+  DTYPE inf = std::numeric_limits<DTYPE>::infinity();
+
+  // release attention of untiled forward
+  _P.clear();
+  _M.clear();
+
+  _O.setZero(_Q.rows(), E);
+  _L.resize(_Q.rows(), _heads);
+
+  Tensor S, M;
+  ColVector m(_Q.rows()), l(_Q.rows());
+  for (int h=0; h<_heads; h++)
+  {
+    m.setConstant(-inf);
+    l.setZero();
+
+    for (auto& B: _blocks)
+    for (auto& T: tiles(B))
+    {
+      scores(mask, B, T, h, S);
+      auto O_t = _O.block(T.q, h * D, T.q_rows, D);
+
+      // rescale running sum and output to the new row maximum
+      for (int r=0; r<S.rows(); r++)
+      {
+        DTYPE& m_r = m(T.q + r);
+        DTYPE& l_r = l(T.q + r);
+        DTYPE max = std::max(m_r, S.row(r).maxCoeff());
+        DTYPE shift = (max == -inf) ? 0 : max;
+        DTYPE alpha = std::exp(m_r - shift);
+        S.row(r) = (S.row(r).array() - shift).exp();
+        l_r = alpha * l_r + S.row(r).sum();
+        O_t.row(r) *= alpha;
+        m_r = max;
+      }
+
+      if (dropout)
+      {
+        this->dropout(T, h, M);
+        S.array() *= M.array();
+      }
+
+      O_t.noalias() += S * _V.block(T.k, h * D, T.k_rows, D);
+    }
+
+    // normalize output, fully masked rows get zero attention
+    for (int r=0; r<_Q.rows(); r++)
+    {
+      if (l(r) > 0)
+      {
+        _O.block(r, h * D, 1, D) /= l(r);
+        _L(r, h) = m(r) + std::log(l(r));
+      }
+      else
+      {
+        _L(r, h) = inf;
+      }
+    }
+  }
+}
+
+void MultiHeadAttention::append(const Tensor& k, const Tensor& v,
+Cache& cache)
+{
+  int E = _Wo->forward().rows();
+  int rows = k.rows();
+
+  // grow capacity geometrically to keep appends amortized
+  if (cache.size + rows > cache.K.rows())
+  {
+    int capacity = std::max<int>(2 * cache.K.rows(), cache.size + rows);
+    cache.K.conservativeResize(capacity, E);
+    cache.V.conservativeResize(capacity, E);
+  }
+
+  auto K = cache.K.middleRows(cache.size, rows);
+  auto V = cache.V.middleRows(cache.size, rows);
+  K.noalias() = k * _Wk->forward().transpose();
+  V.noalias() = v * _Wv->forward().transpose();
+  if (_bk) K.rowwise() += _bk->forward().row(0);
+  if (_bv) V.rowwise() += _bv->forward().row(0);
+
+  cache.size += rows;
+}
+
+Tensor MultiHeadAttention::attend(const Tensor& q, const Cache& cache,
+const Tensor& mask)
+{
+  int E = _Wo->forward().rows();
+  int D = E / _heads;
+  DTYPE scale = 1 / std::sqrt(DTYPE(D));
+
+  Tensor Q = ABT(q, _Wq->forward());
+  if (_bq) Q.rowwise() += _bq->forward().row(0);
+
+  auto K = cache.K.topRows(cache.size);
+  auto V = cache.V.topRows(cache.size);
+
+  Tensor P, O(q.rows(), E);
+  for (int h=0; h<_heads; h++)
+  {
+    P.noalias() = Q.middleCols(h * D, D) * K.middleCols(h * D, D).transpose();
+    P *= scale;
+    if (mask.size()) P += mask;
+    softmax_rows(P);
+    O.middleCols(h * D, D).noalias() = P * V.middleCols(h * D, D);
+  }
+
+  Tensor F = ABT(O, _Wo->forward());
+  if (_bo) F.rowwise() += _bo->forward().row(0);
+
+  return F;
+}
+
+///////////////////////////////////////////
+// Graph
+///////////////////////////////////////////
+
+void Graph::clear()
+{
+  for (auto e: _plans) delete e;
+  _plans.clear();
+  for (auto e: _nodes) delete e;
+  _nodes.clear();
+  _vars.clear();
+  _names.clear();
+  _node_scopes.clear();
+}
+
+// set function name
+Function* Graph::name(Function* f, const char* name)
+{
+  if (f == nullptr || name == nullptr)
+    return nullptr;
+
+  auto it = std::find(_nodes.begin(), _nodes.end(), f);
+  if (it != _nodes.end())
+  {
+    _names[it - _nodes.begin()] = name;
+    return *it;
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+// get function by name
+Function* Graph::function(const char* name) const
+{
+  if (name == nullptr)
+    return nullptr;
+
+  auto it = std::find(_names.begin(), _names.end(), name);
+  if (it != _names.end())
+  {
+    return _nodes[it - _names.begin()];
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+// get graph variables with unique names
+std::map<std::string, Variable*> Graph::named_variables() const
+{
+  // get variable positions in node list
+  std::vector<uint32_t> inode;
+  for (int i=0; i<_nodes.size() && inode.size() != _vars.size(); i++)
+  {
+    if (_nodes[i] == _vars[inode.size()])
+    {
+      inode.push_back(i);
+    }
+  }
+
+  // keep track of name counts
+  std::map<std::string, int> counts;
+  std::map<std::string, Variable*> dict;
+
+  for (int i=0; i<_vars.size(); i++)
+  {
+    // get variable name
+    auto name = _names[inode[i]];
+
+    // index duplicate names
+    auto itc = counts.find(name);
+    if (itc == counts.end())
+    {
+      counts[name] = 0;
+    }
+    else
+    {
+      counts[name] = itc->second + 1;
+      name = name + "." + std::to_string(counts[name]);
+    }
+
+    // add name:variable to dictionary
+    dict[name] = _vars[i];
+  }
+
+  return dict;
+}
+
+// track function
+void Graph::keep(Function* f, const char* name)
+{
+  _nodes.push_back(f);
+  _names.push_back((name) ? name : "");
+  _node_scopes.push_back(_scope_ids.empty() ? 0 : _scope_ids.back());
+}
+
+// track variable
+void Graph::keep(Variable* v, const char* name)
+{
+  _nodes.push_back(v);
+  _vars.push_back(v);
+  _names.push_back((name) ? scope_name() + name : scope_name() + "Variable");
+  _node_scopes.push_back(_scope_ids.empty() ? 0 : _scope_ids.back());
+}
+
+// remove nodes kept in range [begin, end) except variables
+void Graph::discard(size_t begin, size_t end)
+{
+  std::unordered_set<Function*> removed;
+  for (size_t i=begin; i<end; i++)
+  {
+    auto v = _nodes[i];
+    if (std::find(_vars.begin(), _vars.end(), v) == _vars.end())
+    {
+      removed.insert(v);
+    }
+  }
+
+  // unlink derivatives of removed nodes
+  for (auto f: _nodes)
+  {
+    if (removed.count(f)) continue;
+
+    auto& d = f->_derivative;
+    d.erase(std::remove_if(d.begin(), d.end(),
+      [&](Function* e) { return removed.count(e) > 0; }), d.end());
+  }
+
+  // delete nodes and keep names aligned
+  size_t j = begin;
+  for (size_t i=begin; i<_nodes.size(); i++)
+  {
+    if (i < end && removed.count(_nodes[i]))
+    {
+      delete _nodes[i];
+      continue;
+    }
+
+    _nodes[j] = _nodes[i];
+    _names[j] = _names[i];
+    _node_scopes[j] = _node_scopes[i];
+    j++;
+  }
+
+  _nodes.resize(j);
+  _names.resize(j);
+  _node_scopes.resize(j);
+}
+
+// reset cache
+void Graph::recache() 
+{
+  for (auto e: _nodes) e->recache();
+}
+
+// reset cache of functions computed from f
+void Graph::invalidate_from(Function& f)
+{
+  std::unordered_set<Function*> stale = { &f };
+
+  // nodes are kept after their inputs
+  for (auto e: _nodes)
+  {
+    // derivatives depend on the whole backward pass
+    if (e->_owner)
+    {
+      e->recache();
+      continue;
+    }
+
+    bool downstream = false;
+    for (auto i: e->_inputs)
+    {
+      if (stale.count(i)) { downstream = true; break; }
+    }
+
+    if (downstream)
+    {
+      stale.insert(e);
+      e->recache();
+    }
+    else if (!dynamic_cast<Variable*>(e))
+    {
+      // variable gradients accumulate until zero_grad
+      e->_gradient.resize(0,0);
+    }
+  }
+}
+
+// reset gradients
+void Graph::zero_grad()
+{
+  for (auto e: _vars) e->zero_grad();
+}
+
+// compute gradients
+void Graph::backward(Function& f, const Tensor& g)
+{
+  if (_no_grad)
+    throw std::runtime_error("Graph in no-grad mode has no derivatives");
+
+  f.forward();
+  f.gradient() = g;
+
+  // functions computing f
+  std::unordered_set<Function*> reach = { &f };
+  std::vector<Function*> stack = { &f };
+  while (stack.size())
+  {
+    auto e = stack.back();
+    stack.pop_back();
+    for (auto i: e->_inputs) if (reach.insert(i).second) stack.push_back(i);
+  }
+
+  // recompute checkpointed segments, latest first
+  for (auto it = _nodes.rbegin(); it != _nodes.rend(); ++it)
+  {
+    auto c = dynamic_cast<GradientCheckpoint*>(*it);
+    if (c && c->_value.size() && reach.count(c)) c->backprop();
+  }
+
+  for (auto e: _vars) e->backward();
+}
+
+// compile execution plan
+Plan* Graph::compile(Function& f)
+{
+  auto plan = new Plan(*this, f);
+  _plans.push_back(plan);
+  return plan;
+}
+
+///////////////////////////////////////////
+// Quantizer impl
+///////////////////////////////////////////
+
+Quantizer::Quantizer(Graph& graph) : _graph(graph)
+{
+  for (auto f: graph.nodes())
+  {
+    auto node = dynamic_cast<Quantized*>(f);
+    if (node) _nodes.push_back(node);
+  }
+}
+
+void Quantizer::calibrate()
+{
+  for (auto e: _nodes) if (!e->quantized()) e->calibrate();
+}
+
+void Quantizer::quantize()
+{
+  for (auto e: _nodes) e->quantize();
+  _graph.recache();
+}
+
+void Quantizer::dequantize()
+{
+  for (auto e: _nodes) e->dequantize();
+  _graph.recache();
+}
+
+void Quantizer::write(std::ostream& out) const
+{
+  int32_t size = _nodes.size();
+  out.write((const char*)&size, sizeof(size));
+  for (auto e: _nodes) e->write(out);
+}
+
+void Quantizer::read(std::istream& in)
+{
+  int32_t size = 0;
+  in.read((char*)&size, sizeof(size));
+  if (size != _nodes.size())
+    throw std::runtime_error("Incompatible number of quantized nodes");
+
+  for (auto e: _nodes) e->read(in);
+  _graph.recache();
+}
+
+///////////////////////////////////////////
+// Profiler impl
+///////////////////////////////////////////
+
+// evaluations kept for trace, records are aggregated past the limit
+#define PROFILER_EVENTS (1 << 20)
+
+// evaluations in progress on this thread
+struct ProfileFrame
+{
+  uint64_t start;
+  uint64_t nested;
+};
+
+static thread_local std::vector<ProfileFrame> profile_stack;
+
+Profiler::Profiler(Graph& graph) :
+_graph(graph), _start(std::chrono::steady_clock::now())
+{
+  _graph._profiler = this;
+}
+
+Profiler::~Profiler()
+{
+  if (_graph._profiler == this) _graph._profiler = nullptr;
+}
+
+const Tensor& Profiler::evaluate(Function& f, bool derivative)
+{
+  auto now = [&]() -> uint64_t {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - _start).count();
+  };
+
+  auto data = f._value.data();
+  auto start = now();
+  profile_stack.push_back(ProfileFrame{start, 0});
+
+  const Tensor* value;
+  try
+  {
+    value = &f.forward();
+  }
+  catch (...)
+  {
+    profile_stack.pop_back();
+    throw;
+  }
+
+  // nested time is charged to the inner evaluations
+  uint64_t micros = now() - start;
+  uint64_t nested = profile_stack.back().nested;
+  profile_stack.pop_back();
+  if (profile_stack.size()) profile_stack.back().nested += micros;
+
+  // value buffer replaced by this evaluation
+  uint64_t allocated = 0;
+  if (f._value.size() && f._value.data() != data)
+    allocated = f._value.size() * sizeof(DTYPE);
+
+  std::lock_guard<std::mutex> lock(_lock);
+  auto& stats = _stats[derivative][&f];
+  stats.count++;
+  stats.micros += micros - std::min(micros, nested);
+  stats.total_micros += micros;
+  stats.allocated += allocated;
+
+  if (_events.size() < PROFILER_EVENTS)
+  {
+    auto thread = _threads.emplace(std::this_thread::get_id(),
+      (int)_threads.size()).first->second;
+    _events.push_back(Event{&f, derivative, thread, start, micros});
+  }
+
+  return *value;
+}
+
+std::string Profiler::type(const Function* f)
+{
+  int status = 0;
+  auto name = typeid(*f).name();
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  std::string type = (status == 0) ? demangled : name;
+  std::free(demangled);
+
+  auto pos = type.rfind("::");
+  return (pos == std::string::npos) ? type : type.substr(pos + 2);
+}
+
+std::string Profiler::scope(const Function* f,
+const std::unordered_map<const Function*, int>& index) const
+{
+  // derivatives and fused nodes take scope of the node they belong to
+  while (f)
+  {
+    auto it = index.find(f);
+    if (it != index.end())
+    {
+      auto& name = _graph.scope_name(it->second);
+      return name.empty() ? name : name.substr(0, name.size() - 1);
+    }
+    f = f->_owner;
+  }
+  return "";
+}
+
+std::vector<Profiler::Record> Profiler::records() const
+{
+  std::unordered_map<const Function*, int> index;
+  auto& nodes = _graph.nodes();
+  for (int i=0; i<nodes.size(); i++) index[nodes[i]] = i;
+
+  std::vector<Record> records;
+  std::lock_guard<std::mutex> lock(_lock);
+  for (int d=0; d<2; d++)
+  {
+    for (auto& e: _stats[d])
+    {
+      auto& s = e.second;
+      records.push_back(Record{e.first, scope(e.first, index), type(e.first),
+        d == 1, s.count, s.micros * 1e-6, s.total_micros * 1e-6,
+        s.allocated});
+    }
+  }
+
+  std::sort(records.begin(), records.end(),
+    [](const Record& a, const Record& b) { return a.seconds > b.seconds; });
+
+  return records;
+}
+
+void Profiler::write_table(std::ostream& out) const
+{
+  struct Row
+  {
+    std::string scope;
+    uint64_t count = 0;
+    double forward = 0;
+    double derivative = 0;
+    uint64_t allocated = 0;
+  };
+
+  // sum records of each scope
+  std::vector<Row> rows;
+  std::unordered_map<std::string, int> index;
+  double total = 0;
+  for (auto& e: records())
+  {
+    auto it = index.emplace(e.scope, rows.size()).first;
+    if (it->second == rows.size())
+    {
+      rows.push_back(Row());
+      rows.back().scope = e.scope;
+    }
+
+    auto& row = rows[it->second];
+    row.count += e.count;
+    (e.derivative ? row.derivative : row.forward) += e.seconds;
+    row.allocated += e.allocated;
+    total += e.seconds;
+  }
+
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+    return a.forward + a.derivative > b.forward + b.derivative;
+  });
+
+  auto flags = out.flags();
+  auto precision = out.precision();
+  out << std::left << std::setw(40) << "scope" << std::right
+      << std::setw(10) << "calls"
+      << std::setw(14) << "forward ms"
+      << std::setw(15) << "derivative ms"
+      << std::setw(8) << "self %"
+      << std::setw(14) << "allocated MB" << std::endl;
+
+  out << std::fixed;
+  for (auto& e: rows)
+  {
+    double self = e.forward + e.derivative;
+    out << std::left << std::setw(40) << (e.scope.empty() ? "-" : e.scope)
+        << std::right
+        << std::setw(10) << e.count
+        << std::setw(14) << std::setprecision(3) << e.forward * 1e3
+        << std::setw(15) << std::setprecision(3) << e.derivative * 1e3
+        << std::setw(8) << std::setprecision(1)
+        << (total > 0 ? 100 * self / total : 0)
+        << std::setw(14) << std::setprecision(3) << e.allocated / 1048576.0
+        << std::endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// JSON string with quotes and backslashes escaped
+static std::string json_string(const std::string& s)
+{
+  std::string json = "\"";
+  for (auto c: s)
+  {
+    if (c == '"' || c == '\\') json += '\\';
+    json += c;
+  }
+  return json + "\"";
+}
+
+void Profiler::write_trace(std::ostream& out) const
+{
+  std::unordered_map<const Function*, const Record*> names[2];
+  auto records = this->records();
+  for (auto& e: records) names[e.derivative][e.node] = &e;
+
+  std::lock_guard<std::mutex> lock(_lock);
+  out << "{\"traceEvents\":[";
+  for (size_t i=0; i<_events.size(); i++)
+  {
+    auto& e = _events[i];
+    auto& r = *names[e.derivative][e.node];
+    out << (i ? ",\n" : "\n")
+        << "{\"name\":" << json_string(r.type)
+        << ",\"cat\":\"" << (e.derivative ? "derivative" : "forward")
+        << "\",\"ph\":\"X\",\"ts\":" << e.start
+        << ",\"dur\":" << e.micros
+        << ",\"pid\":0,\"tid\":" << e.thread
+        << ",\"args\":{\"scope\":" << json_string(r.scope) << "}}";
+  }
+  out << "\n]}" << std::endl;
+}
+
+void Profiler::clear()
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  _stats[0].clear();
+  _stats[1].clear();
+  _events.clear();
+  _start = std::chrono::steady_clock::now();
+}
+
+///////////////////////////////////////////
+// numerical derivative
+///////////////////////////////////////////
+
+DTYPE Graph::dFdX(Function& f, Variable& x, int fr, int fc, int xr, int xc)
+{
+  auto& v = x.value();
+  DTYPE x0 = v(xr,xc);
+
+  // F(x + h)
+  recache();
+  v(xr,xc) = x0 + FINITE_DELTA;
+  DTYPE f2 = f.forward()(fr,fc);
+
+  // F(x - h)
+  recache();
+  v(xr,xc) = x0 - FINITE_DELTA;
+  DTYPE f1 = f.forward()(fr,fc);
+
+  // restore x
+  v(xr,xc) = x0;
+
+  // (F(x + h) - F(x - h)) / 2h
+  return (f2 - f1) / (2 * FINITE_DELTA);
+}
+
+Tensor Graph::dFdX(Function& f, Variable& x)
+{
+  // get provided gradient and its size
+  Tensor df = f.gradient();
+  auto size = df.size();
+
+  int f_rows = f.forward().rows();
+  int f_cols = f.forward().cols();
+  int x_rows = x.forward().rows();
+  int x_cols = x.forward().cols();
+
+  // set default gradient value to 1, if not provided
+  if (!size)
+  {
+    df = Tensor::Ones(f_rows, f_cols);
+  }
+
+  Tensor dfdx = Tensor::Zero(x_rows, x_cols);
+  
+  for (int fr=0; fr<f_rows; fr++)
+  for (int fc=0; fc<f_cols; fc++)
+  for (int xr=0; xr<x_rows; xr++)
+  for (int xc=0; xc<x_cols; xc++)
+  dfdx(xr, xc) = dfdx(xr, xc) + dFdX(f, x, fr, fc, xr, xc) * df(fr, fc);
+
+  // reset gradient to the provided value
+  if (size)
+  {
+    f.gradient() = df;
+  }
+
+  return dfdx;
+}
+
+///////////////////////////////////////////
+// node name scope
+///////////////////////////////////////////
+
+// enter scope, nodes remember index of its full name
+void Graph::scope_push(const char* name)
+{
+  _scope.push_back(name);
+
+  auto full = scope_name();
+  auto it = std::find(_scope_names.begin(), _scope_names.end(), full);
+  _scope_ids.push_back(it - _scope_names.begin());
+  if (it == _scope_names.end()) _scope_names.push_back(full);
+}
+
+std::string Graph::scope_name() const
+{
+  int size = _scope.size();
+  for (const auto& e: _scope) size += e.size();
+
+  std::string name;
+  name.reserve(size);
+
+  for (const auto& e: _scope)
+  {
+    name += e;
+    name += ':';
+  }
+
+  return name;
+}
+
+///////////////////////////////////////////
+// Compiled execution plan
+///////////////////////////////////////////
+
+// Node construction order is a topological order of the graph, since every
+// function takes its inputs by reference at construction time. One lazy
+// forward and backward pass traces the nodes reachable from f, after which
+// the plan runs the reachable nodes in a flat loop without recursion or
+// NoValueException. The plan assumes that a node forward() reads only its
+// inputs. Compile again after changing the graph or the input shapes.
+Plan::Plan(Graph& graph, Function& f) :
+_graph(graph), _output(f), _threads(1)
+{
+  auto& nodes = graph.nodes();
+
+  // leaf nodes have nothing to compute
+  auto leaf = [](Function* e) {
+    return dynamic_cast<Constant*>(e) || dynamic_cast<Variable*>(e);
+  };
+
+  // plans schedule all values, checkpoints keep their segments
+  for (auto e: nodes)
+  {
+    auto c = dynamic_cast<GradientCheckpoint*>(e);
+    if (c) c->release(false);
+  }
+
+  // trace lazy forward pass, which resolves the node shapes
+  graph.recache();
+  f.recache();
+  try
+  {
+    f.forward();
+  }
+  catch (std::exception& e)
+  {
+    throw trace_error(e);
+  }
+
+  for (auto e: nodes)
+  {
+    if (e != &f && e->_value.size() && !leaf(e)) _forward.push_back(e);
+  }
+  _forward.push_back(&f);
+
+  // trace lazy backward pass from variables
+  f._gradient = Tensor::Zero(f._value.rows(), f._value.cols());
+  for (auto v: graph.variables())
+  {
+    for (auto d: v->_derivative)
+    {
+      try { d->forward(); } catch (NoValueException& e) { continue; }
+    }
+  }
+
+  // collect derivatives evaluated in the trace
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+  {
+    auto e = *it;
+    bool variable = dynamic_cast<Variable*>(e) != nullptr;
+    if (e == &f || (!variable && (leaf(e) || !e->_gradient.size()))) continue;
+
+    auto& v = e->_value;
+    Step step = { e, variable, (int)v.rows(), (int)v.cols(), {}, {}, {} };
+    for (auto d: e->_derivative)
+    {
+      if (d->_value.size() || d->_stale) step.derivative.push_back(d);
+    }
+    if (variable && step.derivative.empty()) continue;
+
+    _backward.push_back(step);
+  }
+
+  plan_memory();
+  plan_schedule();
+
+  // clear the trace, traced values are kept as buffers of the first pass
+  std::unordered_set<Function*> traced(_forward.begin(), _forward.end());
+  for (auto e: nodes)
+  {
+    Tensor value;
+    if (traced.count(e)) value.swap(e->_value);
+    e->recache();
+    if (value.size())
+    {
+      e->_value.swap(value);
+      e->_stale = true;
+    }
+  }
+
+  // variable gradients accumulate in place from the first pass
+  for (auto& e: _backward)
+  {
+    auto& g = e.node->_gradient;
+    if (e.accumulate && !g.size()) g.setZero(e.rows, e.cols);
+  }
+}
+
+std::runtime_error Plan::trace_error(const std::exception& e)
+{
+  auto& nodes = _graph.nodes();
+
+  // functions computing the output
+  std::unordered_set<Function*> reach = { &_output };
+  for (auto it = nodes.rbegin(); it != nodes.rend(); ++it)
+  {
+    if (!reach.count(*it)) continue;
+    for (auto x: (*it)->_inputs) reach.insert(x);
+  }
+
+  // evaluate them in graph order, inputs first, up to the failing one
+  _graph.recache();
+  for (int i=0; i<nodes.size(); i++)
+  {
+    auto n = nodes[i];
+    if (!reach.count(n)) continue;
+
+    try
+    {
+      n->forward();
+    }
+    catch (std::exception& error)
+    {
+      std::string inputs;
+      for (auto x: n->_inputs)
+        inputs += (inputs.empty() ? "" : ", ") + shape(x->_value);
+
+      auto& name = _graph.names()[i];
+      _graph.recache();
+      return std::runtime_error("Failed to trace " + Profiler::type(n) +
+        " node " + std::to_string(i) + (name.empty() ? "" : " " + name) +
+        " of inputs " + inputs + ": " + error.what());
+    }
+  }
+
+  _graph.recache();
+  return std::runtime_error(e.what());
+}
+
+Plan::~Plan()
+{
+  for (auto e: _fused) delete e;
+}
+
+// Derivative values live for a single step and node gradients live from
+// their own step until the last step that reads them. Buffers of equal size
+// with disjoint lifetimes share one arena tensor, which is swapped in and out
+// of the node in O(1) and never freed between passes.
+void Plan::plan_memory()
+{
+  std::unordered_map<Function*, int> index;
+  for (int i=0; i<_backward.size(); i++)
+  {
+    index[_backward[i].node] = i;
+    _backward[i].acquire.clear();
+    _backward[i].release.clear();
+  }
+  _arena.clear();
+
+  // gradient of a node is read by the derivatives it owns
+  std::vector<int> last(_backward.size());
+  for (int i=0; i<_backward.size(); i++) last[i] = i;
+
+  for (int i=0; i<_backward.size(); i++)
+  {
+    for (auto d: _backward[i].derivative)
+    {
+      // derivatives without owner may read any gradient
+      if (!d->_owner)
+      {
+        for (auto& l: last) l = _backward.size() - 1;
+        break;
+      }
+
+      auto it = index.find(d->_owner);
+      if (it != index.end()) last[it->second] = std::max(last[it->second], i);
+    }
+  }
+
+  std::unordered_map<int, std::vector<int>> free;
+
+  for (int i=0; i<_backward.size(); i++)
+  {
+    auto& e = _backward[i];
+
+    // derivative values have the shape of the step node, views have none
+    std::vector<Buffer> buffers;
+    for (auto d: e.derivative)
+    {
+      if (d->_view != Function::NO_VIEW) continue;
+      buffers.push_back({ d, true, -1, e.rows, e.cols });
+    }
+
+    // variable gradients accumulate across passes and keep their memory
+    if (!e.accumulate)
+    {
+      buffers.push_back({ e.node, false, -1, e.rows, e.cols });
+    }
+
+    // take free slots of matching size (parallel steps never share)
+    for (auto b: buffers)
+    {
+      auto& slots = free[b.rows * b.cols];
+      if (slots.size() && _threads <= 1)
+      {
+        b.slot = slots.back();
+        slots.pop_back();
+      }
+      else
+      {
+        b.slot = _arena.size();
+        _arena.push_back(Tensor::Zero(b.rows, b.cols));
+      }
+
+      e.acquire.push_back(b);
+
+      // derivative values die at the end of the step
+      int end = (b.value) ? i : last[i];
+      _backward[end].release.push_back(b);
+    }
+
+    // return slots after the step
+    for (auto& b: e.release)
+    {
+      free[b.rows * b.cols].push_back(b.slot);
+    }
+  }
+}
+
+// bytes preallocated for backward buffers
+size_t Plan::memory() const
+{
+  size_t size = 0;
+  for (auto& t: _arena) size += t.size() * sizeof(DTYPE);
+  return size;
+}
+
+// run nodes on n threads as soon as their inputs are ready
+void Plan::threads(int n)
+{
+  _threads = std::max(n, 1);
+  _pool.reset((_threads > 1) ? new ThreadPool(_threads) : nullptr);
+
+  // concurrent steps need their own buffers
+  plan_memory();
+}
+
+// A forward node waits for the nodes it reads and a backward step waits for
+// the steps of the functions owning its derivatives, whose gradients the
+// derivatives read.
+void Plan::plan_schedule()
+{
+  std::unordered_map<Function*, int> index;
+  for (int i=0; i<_forward.size(); i++) index[_forward[i]] = i;
+
+  // fused kernels compute the value of the pattern root
+  for (auto& k: _kernels) index[k.first] = index[k.second];
+
+  _forward_wait.assign(_forward.size(), 0);
+  _forward_next.assign(_forward.size(), {});
+  for (int i=0; i<_forward.size(); i++)
+  {
+    for (auto x: _forward[i]->_inputs)
+    {
+      auto it = index.find(x);
+      if (it == index.end() || it->second == i) continue;
+
+      _forward_next[it->second].push_back(i);
+      _forward_wait[i]++;
+    }
+  }
+
+  index.clear();
+  for (int i=0; i<_backward.size(); i++) index[_backward[i].node] = i;
+
+  _backward_wait.assign(_backward.size(), 0);
+  _backward_next.assign(_backward.size(), {});
+  for (int i=0; i<_backward.size(); i++)
+  {
+    for (auto d: _backward[i].derivative)
+    {
+      // derivatives without owner may read any gradient, keep step order
+      int owner = i - 1;
+      if (d->_owner)
+      {
+        auto it = index.find(d->_owner);
+        owner = (it != index.end()) ? it->second : -1;
+      }
+      if (owner < 0 || owner == i) continue;
+
+      _backward_next[owner].push_back(i);
+      _backward_wait[i]++;
+    }
+  }
+}
+
+// run tasks of a dependency graph on the thread pool
+void Plan::run(const std::vector<int>& wait,
+const std::vector<std::vector<int>>& next, std::function<void(int)> task)
+{
+  int size = wait.size();
+  if (!size) return;
+
+  std::unique_ptr<std::atomic<int>[]> count(new std::atomic<int>[size]);
+  for (int i=0; i<size; i++) count[i] = wait[i];
+
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+  int left = size;
+
+  // share cores of the caller with Eigen threads of the pool threads,
+  // set per thread so that plans of other threads are not affected
+  int eigen_threads = std::max(1, Eigen::nbThreads() / _threads);
+
+  std::function<void(int)> submit = [&](int i)
+  {
+    _pool->enqueue([&, i]()
+    {
+#ifdef _OPENMP
+      omp_set_num_threads(eigen_threads);
+#endif
+      try
+      {
+        task(i);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) error = std::current_exception();
+      }
+
+      for (auto j: next[i])
+      {
+        if (--count[j] == 0) submit(j);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--left == 0) done.notify_all();
+    });
+  };
+
+  for (int i=0; i<size; i++)
+  {
+    if (wait[i] == 0) submit(i);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&]() { return left == 0; });
+
+  if (error) std::rethrow_exception(error);
+}
+
+// forward pass in topological order
+const Tensor& Plan::forward()
+{
+  // invalidate values without freeing them
+  for (auto e: _forward) e->_stale = true;
+
+  auto task = [&](int i)
+  {
+    _graph.evaluate(*_forward[i]);
+    _forward[i]->_stale = false;
+  };
+
+  if (_pool)
+  {
+    run(_forward_wait, _forward_next, task);
+  }
+  else
+  {
+    for (int i=0; i<_forward.size(); i++) task(i);
+  }
+
+  return _output._value;
+}
+
+// swap step buffers in from the arena
+void Plan::acquire(Step& e)
+{
+  for (auto& b: e.acquire)
+  {
+    auto& t = tensor(b);
+    t.swap(_arena[b.slot]);
+    t.resize(b.rows, b.cols);
+    if (b.value) b.node->_stale = true;
+  }
+}
+
+// swap step buffers out to the arena
+void Plan::release(Step& e)
+{
+  for (auto& b: e.release)
+  {
+    auto& t = tensor(b);
+    t.swap(_arena[b.slot]);
+    t.resize(0,0);
+    if (b.value) b.node->_stale = false;
+  }
+}
+
+// aggregate step node gradient
+void Plan::aggregate(Step& e)
+{
+  auto& n = *e.node;
+  auto rows = n._value.rows();
+  auto cols = n._value.cols();
+
+  // gradient buffer comes from the arena, sums are written in place
+  if (n._backprop)
+    _graph.aggregate(n._gradient, rows, cols, e.derivative,
+      e.accumulate && n._gradient.size());
+  else if (!e.accumulate || !n._gradient.size())
+    n._gradient.setZero(rows, cols);
+}
+
+// backward pass in reverse topological order
+void Plan::backward(const Tensor& g)
+{
+  _output._gradient = g;
+
+  if (_pool)
+  {
+    // buffers are not shared, so all of them live for the whole pass
+    for (auto& e: _backward) acquire(e);
+    run(_backward_wait, _backward_next, [&](int i) {
+      aggregate(_backward[i]);
+    });
+    for (auto& e: _backward) release(e);
+    return;
+  }
+
+  for (auto& e: _backward)
+  {
+    acquire(e);
+    aggregate(e);
+    release(e);
+  }
+}
+
+///////////////////////////////////////////
+// Recurrent unrolling
+///////////////////////////////////////////
+
+Unroll::Unroll(Graph& graph, int window, const std::vector<Tensor>& state,
+const Step& step) : _graph(graph), _window(window), _init(state)
+{
+  if (window < 1) throw std::runtime_error("Invalid unroll window");
+
+  // state entering the window
+  std::vector<Function*> h;
+  for (auto& value: state)
+  {
+    auto c = graph.new_constant(value.rows(), value.cols());
+    c->value() = value;
+    _entry.push_back(c);
+    h.push_back(c);
+  }
+
+  // state of each slot feeds the next slot
+  for (int i=0; i<window; i++)
+  {
+    h = step(i, h);
+    if (h.size() != _entry.size())
+      throw std::runtime_error("Unroll step changes state size");
+  }
+
+  _exit = h;
+}
+
+std::vector<Tensor> Unroll::state() const
+{
+  std::vector<Tensor> values;
+  for (auto c: _entry) values.push_back(c->value());
+  return values;
+}
+
+void Unroll::state(const std::vector<Tensor>& values)
+{
+  if (values.size() != _entry.size())
+    throw std::runtime_error("Incompatible unroll state size");
+
+  for (int i=0; i<_entry.size(); i++) _entry[i]->value() = values[i];
+  _graph.recache();
+}
+
+void Unroll::advance()
+{
+  std::vector<Tensor> values;
+  for (auto f: _exit) values.push_back(f->forward());
+  state(values);
+}
+
+///////////////////////////////////////////
+// Operator fusion
+///////////////////////////////////////////
+
+// match constant scalar c broadcast to the target t
+static bool broadcast_scalar(Function* b, Function* t, Function*& c)
+{
+  if (!dynamic_cast<Broadcast*>(b)) return false;
+
+  auto& in = b->inputs();
+  if (in.size() != 2 || in[0] != t) return false;
+
+  c = in[1];
+  return dynamic_cast<Constant*>(c) && c->value().size() == 1;
+}
+
+// match a unary elementwise node or composite ending at node n
+bool Plan::stage(Function* n, Stage& s)
+{
+  auto& in = n->inputs();
+  s.constant = nullptr;
+  s.sign = 1;
+  s.nodes.clear();
+
+  if ((dynamic_cast<Tanh*>(n) || dynamic_cast<Sigmoid*>(n)) && in.size() == 1)
+  {
+    s.type = (dynamic_cast<Tanh*>(n)) ? TANH : SIGMOID;
+    s.input = in[0];
+    s.nodes = { n };
+    return true;
+  }
+
+  // max(x, broadcast(0, x))
+  if (dynamic_cast<ReLU*>(n) && in.size() == 1)
+  {
+    auto m = in[0];
+    auto& m_in = m->inputs();
+    if (!dynamic_cast<Max*>(m) || m_in.size() != 2) return false;
+
+    Function* zero;
+    if (!broadcast_scalar(m_in[1], m_in[0], zero)) return false;
+    if (zero->value()(0) != 0) return false;
+
+    s.type = RELU;
+    s.input = m_in[0];
+    s.nodes = { m_in[1], m, n };
+    return true;
+  }
+
+  // x * broadcast(c, x), x + broadcast(c, x) and x - broadcast(c, x)
+  bool mul = dynamic_cast<Mul*>(n) != nullptr;
+  bool add = dynamic_cast<Add*>(n) != nullptr;
+  bool sub = dynamic_cast<Sub*>(n) != nullptr;
+  if ((mul || add || sub) && in.size() == 2)
+  {
+    for (int i=0; i<2; i++)
+    {
+      if (sub && i == 0) continue;
+      if (!broadcast_scalar(in[i], in[1-i], s.constant)) continue;
+
+      s.type = (mul) ? SCALE : SHIFT;
+      s.sign = (sub) ? -1 : 1;
+      s.input = in[1-i];
+      s.nodes = { in[i], n };
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// F = act(x * W.T + b)
+bool Plan::fuse_gemm(Function* root, Fusion& f)
+{
+  // optional activation
+  Stage act;
+  Function* y = root;
+  bool active = stage(root, act) && act.type <= RELU;
+  if (active) y = act.input;
+
+  std::vector<Function*> nodes;
+
+  // linear layer is a pass-through composite
+  if (dynamic_cast<Linear*>(y))
+  {
+    if (y->inputs().size() != 1) return false;
+    nodes.push_back(y);
+    y = y->inputs()[0];
+  }
+
+  // optional bias broadcast to product
+  Function* p = y;
+  Function* b = nullptr;
+  if (dynamic_cast<Add*>(y))
+  {
+    auto& in = y->inputs();
+    if (in.size() != 2 || !dynamic_cast<Broadcast*>(in[1])) return false;
+
+    p = in[0];
+    auto& b_in = in[1]->inputs();
+    if (b_in.size() != 2 || b_in[0] != p) return false;
+    if (b_in[1]->value().rows() != 1) return false;
+
+    b = b_in[1];
+    nodes.push_back(in[1]);
+    nodes.push_back(y);
+  }
+
+  // product with transposed weights
+  auto& p_in = p->inputs();
+  if (!dynamic_cast<Product*>(p) || p_in.size() != 2) return false;
+  auto t = p_in[1];
+  auto& t_in = t->inputs();
+  if (!dynamic_cast<Transpose*>(t) || t_in.size() != 1) return false;
+  if (b && b->value().cols() != p->value().cols()) return false;
+
+  auto x = p_in[0];
+  auto W = t_in[0];
+  nodes.push_back(t);
+  nodes.push_back(p);
+  if (active) nodes.insert(nodes.end(), act.nodes.begin(), act.nodes.end());
+
+  // activation derivative from its output
+  static auto activate = [](Tensor& y, StageType type)
+  {
+    if (type == TANH) y = y.array().tanh();
+    else if (type == SIGMOID) y = 0.5 * ((0.5 * y).array().tanh() + 1.0);
+    else y = y.cwiseMax(0);
+  };
+
+  class Gemm : public Function
+  {
+  public:
+    Gemm(Graph& graph, Function* root, Function* x, Function* W, Function* b,
+    bool active, StageType type) : Function(graph),
+    _root(root), _x(x), _W(W), _b(b), _active(active), _type(type) {}
+
+    virtual const Tensor& forward()
+    {
+      auto& x = _x->forward();
+      auto& W = _W->forward();
+      auto& y = _root->_value;
+
+      y.noalias() = x * W.transpose();
+      if (_b)
+      {
+        auto& b = _b->forward();
+        y.rowwise() += ConstRowVectorMap(b.data(), b.size());
+      }
+      if (_active) activate(y, _type);
+
+      _root->_stale = false;
+      return y;
+    }
+
+    // gradient at the product output
+    Tensor delta()
+    {
+      auto& g = _root->backward();
+      if (!_active) return g;
+
+      auto y = _root->_value.array();
+      if (_type == TANH) return g.array() * (1 - y * y);
+      if (_type == SIGMOID) return g.array() * y * (1 - y);
+      return (y > 0).select(g, 0);
+    }
+
+    Function *_root, *_x, *_W, *_b;
+    bool _active;
+    StageType _type;
+  };
+
+  class Derivative : public Function
+  {
+  public:
+    Derivative(Graph& graph, Gemm& base, int wrt) :
+    Function(graph, *base._root), _base(base), _wrt(wrt) {}
+
+    // dx = G * W, dW = G.T * x, db = sum(G)
+    virtual const Tensor& forward()
+    {
+      if (cached()) return _value;
+
+      Tensor G = _base.delta();
+      if (_wrt == 0) _value.noalias() = G * _base._W->forward();
+      else if (_wrt == 1) _value.noalias() = G.transpose() * _base._x->forward();
+      else _value = G.colwise().sum();
+
+      return _value;
+    }
+
+  private:
+    Gemm& _base;
+    int _wrt;
+  };
+
+  auto kernel = new Gemm(_graph, root, x, W, b, active, act.type);
+  f.kernel = kernel;
+  f.nodes = nodes;
+  f.derivative.push_back({ x, new Derivative(_graph, *kernel, 0) });
+  f.derivative.push_back({ W, new Derivative(_graph, *kernel, 1) });
+  if (b) f.derivative.push_back({ b, new Derivative(_graph, *kernel, 2) });
+
+  return true;
+}
+
+// F = softmax(x * c + mask)
+bool Plan::fuse_softmax(Function* root, Fusion& f)
+{
+  auto softmax = dynamic_cast<Softmax*>(root);
+  if (!softmax || root->inputs().size() != 1) return false;
+
+  std::vector<Function*> nodes;
+
+  // optional additive mask
+  Function* s = root->inputs()[0];
+  Function* mask = nullptr;
+  Stage scale;
+  if (dynamic_cast<Add*>(s) && !stage(s, scale))
+  {
+    auto& in = s->inputs();
+    if (in.size() != 2) return false;
+
+    nodes.push_back(s);
+    mask = in[1];
+    s = in[0];
+  }
+
+  // scale by constant
+  if (!stage(s, scale) || scale.type != SCALE) return false;
+  nodes.insert(nodes.end(), scale.nodes.begin(), scale.nodes.end());
+  nodes.push_back(root);
+
+  class Kernel : public Function
+  {
+  public:
+    Kernel(Graph& graph, Function* root, Function* x, Function* c,
+    Function* mask, Axis axis) : Function(graph),
+    _root(root), _x(x), _c(c), _mask(mask), _axis(axis) {}
 
-    // F = 0.5 * x * (1 + erf(x / sqrt(2)))
-    // z(x) = x / sqrt(2)
-    // F = 0.5 * x * (1 + erf(z))
-    // dFdx = 0.5 * (1 + erf(z)) + 0.5 * x * derfdz / sqrt(2)
-    // derfdz = erf(-z^2) * 2 / sqrt(pi)
-    // dFdx = 0.5 * (1 + erf(z)) + 0.5 * x * erf(-z^2) * 2 / sqrt(pi) / sqrt(2)
     virtual const Tensor& forward()
     {
-      // return cached gradient
-      if (_value.size()) return _value;
+      auto& x = _x->forward();
+      auto c = _c->forward()(0);
+      auto& y = _root->_value;
 
-      auto& g = _base.backward();
-      auto& x = _base._x.forward();
+      if (_mask) y = x.array() * c + _mask->forward().array();
+      else y = x.array() * c;
 
-      auto z = x.array() * M_SQRT1_2;
-      auto derfdz = M_2_SQRTPI * (-z.array() * z.array()).exp();
-      Tensor dFdx = 0.5 * (1 + z.erf()) + 0.5 * x.array() * derfdz * M_SQRT1_2;
+      y = (y - axis_max(y, _axis)).array().exp();
+      y.array() /= axis_sum(y, _axis).array();
 
-      // update gradient value
-      _value = g.array() * dFdx.array();
+      _root->_stale = false;
+      return y;
+    }
 
-      return _value;
+    // gradient at the softmax input
+    Tensor delta()
+    {
+      auto& g = _root->backward();
+      auto& y = _root->_value;
+
+      Tensor gy = g.array() * y.array();
+      return gy.array() - y.array() * axis_sum(gy, _axis).array();
     }
 
-  private:
-    GeLU& _base;
+    Function *_root, *_x, *_c, *_mask;
+    Axis _axis;
   };
 
-  _x.derivative(new Derivative_x(graph, *this));
-}
-
-// F = 0.5 * x * (1 + erf(x / sqrt(2)))
-const Tensor& GeLU::forward()
-{
-  // return cached value
-  if (_value.size()) return _value;
+  class Derivative : public Function
+  {
+  public:
+    Derivative(Graph& graph, Kernel& base, bool mask) :
+    Function(graph, *base._root), _base(base), _mask(mask) {}
 
-  // get input
-  auto& x = _x.forward();
+    // dx = c * G, dmask = G
+    virtual const Tensor& forward()
+    {
+      if (cached()) return _value;
 
-  // update value
-  _value = 0.5 * x.array() * (1 + (x.array() * M_SQRT1_2).erf());
+      if (_mask) _value = _base.delta();
+      else _value = _base.delta() * _base._c->forward()(0);
 
-  // return value
-  return _value;
-}
+      return _value;
+    }
 
-#endif
+  private:
+    Kernel& _base;
+    bool _mask;
+  };
 
-///////////////////////////////////////////
-// Graph
-///////////////////////////////////////////
+  auto x = scale.input;
+  auto kernel = new Kernel(_graph, root, x, scale.constant, mask,
+    softmax->axis());
+  f.kernel = kernel;
+  f.nodes = nodes;
+  f.derivative.push_back({ x, new Derivative(_graph, *kernel, false) });
+  if (mask) f.derivative.push_back({ mask, new Derivative(_graph, *kernel, true) });
 
-void Graph::clear()
-{
-  for (auto e: _nodes) delete e;
-  _nodes.clear();
-  _vars.clear();
-  _names.clear();
+  return true;
 }
 
-// set function name
-Function* Graph::name(Function* f, const char* name)
+// F = stage_n(...stage_1(x))
+bool Plan::fuse_chain(Function* root, const Edges& consumers, Fusion& f)
 {
-  if (f == nullptr || name == nullptr)
-    return nullptr;
+  std::vector<Stage> stages;
+  std::vector<Function*> nodes;
 
-  auto it = std::find(_nodes.begin(), _nodes.end(), f);
-  if (it != _nodes.end())
-  {
-    _names[it - _nodes.begin()] = name;
-    return *it;
-  }
-  else
+  // extend chain down while the input is consumed only by the chain
+  Stage s;
+  Function* top = root;
+  while (stage(top, s))
   {
-    return nullptr;
-  }
-}
-
-// get function by name
-Function* Graph::function(const char* name) const
-{
-  if (name == nullptr)
-    return nullptr;
+    stages.insert(stages.begin(), s);
+    nodes.insert(nodes.begin(), s.nodes.begin(), s.nodes.end());
 
-  auto it = std::find(_names.begin(), _names.end(), name);
-  if (it != _names.end())
-  {
-    return _nodes[it - _names.begin()];
-  }
-  else
-  {
-    return nullptr;
-  }
-}
+    auto it = consumers.find(s.input);
+    if (it == consumers.end() || s.input == &_output) break;
 
-// get graph variables with unique names
-std::map<std::string, Variable*> Graph::named_variables() const
-{
-  // get variable positions in node list
-  std::vector<uint32_t> inode;
-  for (int i=0; i<_nodes.size() && inode.size() != _vars.size(); i++)
-  {
-    if (_nodes[i] == _vars[inode.size()])
+    bool inner = true;
+    for (auto c: it->second)
     {
-      inode.push_back(i);
+      inner = inner && std::find(s.nodes.begin(), s.nodes.end(), c) != s.nodes.end();
     }
-  }
+    if (!inner) break;
 
-  // keep track of name counts
-  std::map<std::string, int> counts;
-  std::map<std::string, Variable*> dict;
+    top = s.input;
+  }
+  if (stages.size() < 2) return false;
 
-  for (int i=0; i<_vars.size(); i++)
+  class Chain : public Function
   {
-    // get variable name
-    auto name = _names[inode[i]];
+  public:
+    Chain(Graph& graph, Function* root, const std::vector<Stage>& stages) :
+    Function(graph), _root(root), _stages(stages) {}
 
-    // index duplicate names
-    auto itc = counts.find(name);
-    if (itc == counts.end())
-    {
-      counts[name] = 0;
-    }
-    else
+    // compute value and dy/dx in cache sized blocks through all stages
+    virtual const Tensor& forward()
     {
-      counts[name] = itc->second + 1;
-      name = name + "." + std::to_string(counts[name]);
-    }
-
-    // add name:variable to dictionary
-    dict[name] = _vars[i];
-  }
+      auto& x = _stages.front().input->forward();
+      auto& y = _root->_value;
+      y.resize(x.rows(), x.cols());
+      _dydx.resize(x.rows(), x.cols());
 
-  return dict;
-}
+      const int BLOCK = 1024;
+      for (int i=0; i<x.size(); i+=BLOCK)
+      {
+        int size = std::min<int>(BLOCK, x.size() - i);
+        auto v = Eigen::Map<Eigen::Array<DTYPE,1,Eigen::Dynamic>>(y.data() + i, size);
+        auto d = Eigen::Map<Eigen::Array<DTYPE,1,Eigen::Dynamic>>(_dydx.data() + i, size);
 
-// track function
-void Graph::keep(Function* f, const char* name)
-{
-  _nodes.push_back(f);
-  _names.push_back((name) ? name : "");
-}
+        v = Eigen::Map<const Eigen::Array<DTYPE,1,Eigen::Dynamic>>(x.data() + i, size);
+        d.setOnes();
 
-// track variable
-void Graph::keep(Variable* v, const char* name)
-{
-  _nodes.push_back(v);
-  _vars.push_back(v);
-  _names.push_back((name) ? scope_name() + name : scope_name() + "Variable");
-}
+        for (auto& s: _stages)
+        {
+          switch (s.type)
+          {
+          case TANH:
+            v = v.tanh();
+            d *= 1 - v * v;
+            break;
+          case SIGMOID:
+            v = 0.5 * ((0.5 * v).tanh() + 1.0);
+            d *= v * (1 - v);
+            break;
+          case RELU:
+            d = (v > 0).select(d, 0);
+            v = v.max(0);
+            break;
+          case SCALE:
+            v *= s.constant->forward()(0);
+            d *= s.constant->forward()(0);
+            break;
+          case SHIFT:
+            v += s.sign * s.constant->forward()(0);
+            break;
+          }
+        }
+      }
 
-// reset cache
-void Graph::recache() 
-{
-  for (auto e: _nodes) e->recache();
-}
+      _root->_stale = false;
+      return y;
+    }
 
-// reset gradients
-void Graph::zero_grad()
-{
-  for (auto e: _vars) e->gradient().setZero();
-}
+    Function* _root;
+    std::vector<Stage> _stages;
+    Tensor _dydx;
+  };
 
-// compute gradients
-void Graph::backward(Function& f, const Tensor& g)
-{
-  f.forward();
-  f.gradient() = g;
-  for (auto e: _vars) e->backward();
-}
+  class Derivative : public Function
+  {
+  public:
+    Derivative(Graph& graph, Chain& base) :
+    Function(graph, *base._root), _base(base) {}
 
-///////////////////////////////////////////
-// numerical derivative
-///////////////////////////////////////////
+    // dx = g * dy/dx
+    virtual const Tensor& forward()
+    {
+      if (cached()) return _value;
 
-DTYPE Graph::dFdX(Function& f, Variable& x, int fr, int fc, int xr, int xc)
-{
-  auto& v = x.value();
-  DTYPE x0 = v(xr,xc);
+      auto& g = _base._root->backward();
+      _value = g.array() * _base._dydx.array();
 
-  // F(x + h)
-  recache();
-  v(xr,xc) = x0 + FINITE_DELTA;
-  DTYPE f2 = f.forward()(fr,fc);
+      return _value;
+    }
 
-  // F(x - h)
-  recache();
-  v(xr,xc) = x0 - FINITE_DELTA;
-  DTYPE f1 = f.forward()(fr,fc);
+  private:
+    Chain& _base;
+  };
 
-  // restore x
-  v(xr,xc) = x0;
+  auto kernel = new Chain(_graph, root, stages);
+  f.kernel = kernel;
+  f.nodes = nodes;
+  f.derivative.push_back({ stages.front().input, new Derivative(_graph, *kernel) });
 
-  // (F(x + h) - F(x - h)) / 2h
-  return (f2 - f1) / (2 * FINITE_DELTA);
+  return true;
 }
 
-Tensor Graph::dFdX(Function& f, Variable& x)
+// Patterns are matched on the traced plan and replaced by fused kernels that
+// write the pattern output directly. Nodes inside a pattern are no longer
+// evaluated by the plan and their derivatives are replaced by the fused
+// derivatives of the pattern inputs. Inner nodes must not be read outside
+// of the pattern. The lazy graph API is not affected.
+int Plan::fuse()
 {
-  // get provided gradient and its size
-  Tensor df = f.gradient();
-  auto size = df.size();
-
-  int f_rows = f.forward().rows();
-  int f_cols = f.forward().cols();
-  int x_rows = x.forward().rows();
-  int x_cols = x.forward().cols();
+  // evaluate the plan for shape checks
+  forward();
 
-  // set default gradient value to 1, if not provided
-  if (!size)
+  // consumers of every node in the plan
+  Edges consumers;
+  for (auto e: _forward)
   {
-    df = Tensor::Ones(f_rows, f_cols);
+    for (auto x: e->inputs()) consumers[x].push_back(e);
   }
 
-  Tensor dfdx = Tensor::Zero(x_rows, x_cols);
-  
-  for (int fr=0; fr<f_rows; fr++)
-  for (int fc=0; fc<f_cols; fc++)
-  for (int xr=0; xr<x_rows; xr++)
-  for (int xc=0; xc<x_cols; xc++)
-  dfdx(xr, xc) = dfdx(xr, xc) + dFdX(f, x, fr, fc, xr, xc) * df(fr, fc);
+  std::unordered_map<Function*, Function*> fused;
+  std::unordered_map<Function*, Function*> kernels;
+  std::unordered_map<Function*, std::vector<Function*>> derivatives;
+  int count = 0;
 
-  // reset gradient to the provided value
-  if (size)
+  // match patterns from the output down
+  for (auto it = _forward.rbegin(); it != _forward.rend(); ++it)
   {
-    f.gradient() = df;
-  }
+    auto root = *it;
+    if (fused.count(root)) continue;
 
-  return dfdx;
-}
+    Fusion f = { nullptr, {}, {} };
+    bool match = fuse_gemm(root, f) || fuse_softmax(root, f) ||
+      fuse_chain(root, consumers, f);
+    if (!match) continue;
 
-///////////////////////////////////////////
-// node name scope
-///////////////////////////////////////////
+    // inner nodes must be private to the pattern
+    bool valid = true;
+    for (auto n: f.nodes)
+    {
+      valid = valid && !fused.count(n) && n->_backprop;
+      if (n == root) continue;
 
-std::string Graph::scope_name() const
-{
-  int size = _scope.size();
-  for (const auto& e: _scope) size += e.size();
+      valid = valid && n != &_output;
+      for (auto c: consumers[n])
+      {
+        valid = valid && std::find(f.nodes.begin(), f.nodes.end(), c) != f.nodes.end();
+      }
+    }
+    if (std::find(f.nodes.begin(), f.nodes.end(), root) == f.nodes.end())
+    {
+      valid = false;
+    }
 
-  std::string name;
-  name.reserve(size);
+    if (!valid)
+    {
+      delete f.kernel;
+      for (auto& d: f.derivative) delete d.second;
+      continue;
+    }
 
-  for (const auto& e: _scope)
+    // kernel reads the inputs of the pattern
+    for (auto n: f.nodes)
+    {
+      for (auto x: n->inputs())
+      {
+        auto& in = f.kernel->_inputs;
+        if (std::find(f.nodes.begin(), f.nodes.end(), x) == f.nodes.end() &&
+            std::find(in.begin(), in.end(), x) == in.end()) in.push_back(x);
+      }
+    }
+
+    for (auto n: f.nodes) fused[n] = root;
+    kernels[root] = f.kernel;
+    _fused.push_back(f.kernel);
+    for (auto& d: f.derivative)
+    {
+      derivatives[d.first].push_back(d.second);
+      _fused.push_back(d.second);
+    }
+    count++;
+  }
+
+  // replace pattern nodes with kernels
+  std::vector<Function*> forward;
+  for (auto e: _forward)
   {
-    name += e;
-    name += ':';
+    auto it = kernels.find(e);
+    if (it != kernels.end()) forward.push_back(it->second);
+    else if (!fused.count(e)) forward.push_back(e);
+    else e->recache();
   }
+  _forward = forward;
 
-  return name;
+  // replace derivatives owned by pattern nodes
+  std::vector<Step> backward;
+  for (auto& e: _backward)
+  {
+    auto it = fused.find(e.node);
+    if (it != fused.end() && it->second != e.node) continue;
+
+    std::vector<Function*> derivative;
+    for (auto d: e.derivative)
+    {
+      if (!fused.count(d->_owner)) derivative.push_back(d);
+    }
+    auto& extra = derivatives[e.node];
+    derivative.insert(derivative.end(), extra.begin(), extra.end());
+
+    e.derivative = derivative;
+    backward.push_back(e);
+  }
+  _backward = backward;
+  _kernels.insert(kernels.begin(), kernels.end());
+
+  plan_memory();
+  plan_schedule();
+
+  return count;
 }
 
 ///////////////////////////////////////////
 // Default gradient aggregator
 ///////////////////////////////////////////
 
-void Graph::aggregate(Tensor& g, const std::vector<Function*>& derivative) const
+void Graph::aggregate(Tensor& g, int rows, int cols,
+const std::vector<Function*>& derivative, bool accumulate) const
 {
+  // g holds gradient to add to
+  bool set = accumulate;
+  size_t g_size = (size_t)rows * cols;
+
   // aggregate gradient
   for (auto e: derivative)
   {
     try
     {
-      g += e->forward();
+      auto& d = evaluate(*e, true);
+
+      // scatter row-sparse value
+      if (e->_row_sparse)
+      {
+        if (!set) g.setZero(rows, cols);
+        for (int i=0; i<e->_rows.size(); i++) g.row(e->_rows[i]) += d.row(i);
+      }
+      // scatter block of value
+      else if (e->_view == Function::BLOCK_VIEW)
+      {
+        if (!set) g.setZero(rows, cols);
+        g.block(e->_view_row, e->_view_col, d.rows(), d.cols()) += d;
+      }
+      // read transposed value
+      else if (e->_view == Function::TRANSPOSED_VIEW)
+      {
+        if (set) g += d.transpose(); else g = d.transpose();
+      }
+      // read value elements in row-major order
+      else if (e->_view != Function::NO_VIEW)
+      {
+        auto offset = (e->_view == Function::TAIL_VIEW) ? d.size() - g_size : 0;
+        ConstTensorMap v(d.data() + offset, rows, cols);
+        if (set) g += v; else g = v;
+      }
+      // take over value owned by the derivative, the only reader of which
+      // is this gradient, or copy into existing buffer
+      else if (!set)
+      {
+        if (!g.size() && &d == &e->_value)
+        {
+          // stale empty value marks derivative evaluated
+          g.swap(e->_value);
+          e->_stale = true;
+        }
+        else
+          g = d;
+      }
+      else
+      {
+        backend().axpy(1, d, g);
+      }
+
+      set = true;
     }
     catch(NoValueException& e)
     {
       continue;
     }
   }
+
+  if (!set) g.setZero(rows, cols);
 }
 
 } /* namespace */
@@ -10,9 +10,18 @@
 #include <memory>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <thread>
 
 #include "types.hh"
 #include "random.hh"
+#include "quantize.hh"
+
+// worker threads of the plan scheduler
+class ThreadPool;
 
 namespace seegnify {
 
@@ -20,6 +29,16 @@ namespace seegnify {
 class Aggregator;
 class Function;
 class Graph;
+class Plan;
+class Profiler;
+
+// Axis of normalization or reduction
+enum Axis
+{
+  ALL,      // whole tensor
+  ROWWISE,  // each row (sample of a batch) separately
+  COLWISE   // each column separately
+};
 
 // Function operators
 Function& operator+(Function& x, Function& y);
@@ -43,6 +62,9 @@ public:
   // default ctor
   Function(Graph& graph);
 
+  // derivative ctor
+  Function(Graph& graph, Function& base);
+
   // virtual destructor
   virtual ~Function() { _derivative.clear(); };
 
@@ -59,13 +81,25 @@ public:
   virtual void recache();
 
   // set derivative callback
-  void derivative(Function* d) { _derivative.push_back(d); }
+  void derivative(Function* d);
+
+  // forward inputs
+  const std::vector<Function*>& inputs() const { return _inputs; }
 
   // enable / disable back-prop
   void backprop(bool enable) { _backprop = enable; }
 
-  // variable value
-  Tensor& value() { return _value; }
+  // variable value for writes (mutable access advances the version)
+  Tensor& value() { _version++; return _value; }
+
+  // variable value for reads, keeps the version
+  const Tensor& value() const { return _value; }
+
+  // advance the version after writing through an earlier reference
+  void touch() { _version++; }
+
+  // value version of variables and constants
+  size_t version() const { return _version; }
 
   // gradient value
   Tensor& gradient() { return _gradient; }
@@ -77,15 +111,73 @@ public:
   Graph& graph() { return _graph; }
 
 protected:
+  friend class Plan;
+  friend class Graph;
+  friend class Variable;
+  friend class Profiler;
+  friend class GradientCheckpoint;
+
+  // value is cached
+  bool cached() const { return _value.size() && !_stale; }
+
+  // record forward input
+  void input(Function& x);
+
+  // set derivative D of input x, only record the input in no-grad graph
+  template <class D, class F>
+  void derivative(Function& x, F& base);
+
+  // pass gradient of this function to inner function x
+  void identity(Function& x);
+
+  // layout of a derivative value in the gradient it adds to
+  enum View
+  {
+    NO_VIEW,          // value has the shape of the gradient
+    BLOCK_VIEW,       // value is the gradient block at view row and col
+    HEAD_VIEW,        // gradient is the first elements of value in order
+    TAIL_VIEW,        // gradient is the last elements of value in order
+    TRANSPOSED_VIEW   // value is the transposed gradient
+  };
+
+  // pass gradient of this function to x in place, read through view
+  void view(Function& x, View view, int row = 0, int col = 0);
+
   // backprop flag
   bool _backprop;
 
+  // stale value flag
+  bool _stale;
+
+  // value released by a checkpoint, recomputed on demand
+  bool _released;
+
+  // value version
+  std::atomic<size_t> _version;
+
   // derivative callbacks
   std::vector<Function*> _derivative;
 
+  // function owning this derivative
+  Function* _owner;
+
+  // forward inputs
+  std::vector<Function*> _inputs;
+
   // function value cache
   Tensor _value;
 
+  // row indices of row-sparse value, empty for dense value
+  std::vector<int> _rows;
+
+  // value holds only rows listed in _rows
+  bool _row_sparse;
+
+  // layout of derivative value and offset of block view
+  View _view;
+  int _view_row;
+  int _view_col;
+
   // function gradient cache
   Tensor _gradient;
 
@@ -105,6 +197,18 @@ protected:
   Function& _base;
 };
 
+// In-place (view) derivative
+class VDerivative : public Function
+{
+public:
+  VDerivative(Graph& graph, Function& base, View view, int row, int col);
+
+  virtual const Tensor& forward();
+
+protected:
+  Function& _base;
+};
+
 // Rowwise function
 class Rowwise : public Function
 {
@@ -119,6 +223,9 @@ public:
   virtual const Tensor& forward();
 
 protected:
+  // replace row blocks with a native row-wise op
+  bool native(Function& x, Function& block, size_t begin);
+
   Function* _y;
 };
 
@@ -161,6 +268,22 @@ public:
   virtual const Tensor& backward();
 
   virtual void recache() { /* no-op */ }
+
+  // gradient comes from row-sparse derivatives only
+  bool row_sparse() const;
+
+  // rows with gradient since last zero_grad of row-sparse variable
+  const std::vector<int>& rows() const { return _touched; }
+
+  // record rows with gradient
+  void touch(const std::vector<int>& rows);
+
+  // reset gradient, of touched rows only when row-sparse
+  void zero_grad();
+
+private:
+  std::vector<int> _touched;
+  std::vector<bool> _touched_mask;
 };
 
 // Broadcast function
@@ -248,7 +371,7 @@ protected:
 };
 
 // Linear function
-class Linear : public Function
+class Linear : public Function, public Quantized
 {
 public:
   Linear(
@@ -263,23 +386,33 @@ public:
 
   virtual const Tensor& forward();
 
+  virtual void calibrate();
+
+  virtual void quantize();
+
 private:
   void init(Function& x);
 
 protected:
+  Function* _x;
   Variable* _W;
   Variable* _b;
   Function* _y;
 };
 
 // Product (linear unbiased) function
-class Product : public Function
+class Product : public Function, public Quantized
 {
 public:
   Product(Graph& graph, Function& x, Function& y);
 
   virtual const Tensor& forward();
 
+  virtual void calibrate();
+
+  // int8 product with y quantized per column on each pass
+  virtual void quantize();
+
 protected:
   Function& _x;
   Function& _y;
@@ -385,21 +518,29 @@ public:
 
 protected:
   DTYPE _rate;
-  Tensor _mask;
   Function& _x;
   bool _enabled;
+
+  // mask of forward step regenerated in backward, not stored
+  bool _masked;
+  uint32_t _stream;
+  uint32_t _step;
 };
 
 // Softmax function
 class Softmax : public Function
 {
 public:
-  Softmax(Graph& graph, Function& x);
+  Softmax(Graph& graph, Function& x, Axis axis = ALL);
 
   virtual const Tensor& forward();
 
+  // normalization axis
+  Axis axis() const { return _axis; }
+
 protected:
   Function& _x;
+  Axis _axis;
 };
 
 // Softplus function
@@ -412,19 +553,24 @@ public:
 
 protected:
   Function& _x;
+  Tensor _dFdx;
 };
 
 // Log-Softmax function
 class LogSoftmax : public Function
 {
 public:
-  LogSoftmax(Graph& graph, Function& x);
+  LogSoftmax(Graph& graph, Function& x, Axis axis = ALL);
 
   const Tensor softmax();
   virtual const Tensor& forward();
 
+  // normalization axis
+  Axis axis() const { return _axis; }
+
 protected:
   Function& _x;
+  Axis _axis;
 };
 
 // Logarithm function
@@ -467,24 +613,48 @@ protected:
 class Sum : public Function
 {
 public:
-  Sum(Graph& graph, Function& x);
+  Sum(Graph& graph, Function& x, Axis axis = ALL);
 
   virtual const Tensor& forward();
 
+  // reduction axis
+  Axis axis() const { return _axis; }
+
 protected:
   Function& _x;
+  Axis _axis;
 };
 
 // Mean reduction function
 class Mean : public Function
 {
 public:
-  Mean(Graph& graph, Function& x);
+  Mean(Graph& graph, Function& x, Axis axis = ALL);
+
+  virtual const Tensor& forward();
+
+  // reduction axis
+  Axis axis() const { return _axis; }
+
+protected:
+  Function& _x;
+  Axis _axis;
+};
+
+// Maximum reduction function
+class Maximum : public Function
+{
+public:
+  Maximum(Graph& graph, Function& x, Axis axis = ALL);
 
   virtual const Tensor& forward();
 
+  // reduction axis
+  Axis axis() const { return _axis; }
+
 protected:
   Function& _x;
+  Axis _axis;
 };
 
 // Standard GRU function
@@ -513,6 +683,8 @@ public:
   virtual const Tensor& forward();
 
 private:
+  friend class GRUSequence;
+
   void init();
 
 protected:
@@ -560,6 +732,8 @@ public:
   virtual const Tensor& forward();
 
 private:
+  friend class LSTMSequence;
+
   void init();
 
 protected:
@@ -572,10 +746,111 @@ protected:
   Function *_LSTM;
 };
 
+// GRU over a sequence of time-major rows x [T*B x in] starting from state
+// h [B x out], value h(t) of all steps [T*B x out]. Input projections of
+// all steps with stacked gates take one GEMM, the recurrence runs fused
+// gate kernels and backward propagates through time without step nodes.
+// Variables are compatible with GRU cell.
+class GRUSequence : public Function
+{
+public:
+  GRUSequence(Graph& graph, Function& x, Function& h, int in, int out);
+  GRUSequence(Graph& graph, Function& x, Function& h, const GRU& other);
+  GRUSequence(Graph& graph, Function& x, Function& h,
+  const GRUSequence& other);
+
+  Variable& Wz() { return *_Wz; }
+  Variable& Uz() { return *_Uz; }
+  Variable& bz() { return *_bz; }
+
+  Variable& Wr() { return *_Wr; }
+  Variable& Ur() { return *_Ur; }
+  Variable& br() { return *_br; }
+
+  Variable& Wh() { return *_Wh; }
+  Variable& Uh() { return *_Uh; }
+  Variable& bh() { return *_bh; }
+
+  virtual const Tensor& forward();
+
+private:
+  void init();
+
+  // gradients of gates of all steps
+  class Derivative_steps;
+
+protected:
+  Function  &_x;
+  Function  &_h;
+  Variable  *_Wz, *_Uz, *_bz;
+  Variable  *_Wr, *_Ur, *_br;
+  Variable  *_Wh, *_Uh, *_bh;
+  Derivative_steps* _dG;
+
+  // gates z, r and c of all steps [T*B x 3*out]
+  Tensor _G;
+};
+
+// LSTM over a sequence of time-major rows x [T*B x in] starting from states
+// h and c [B x out], value h(t) of all steps [T*B x out]. Input projections
+// of all steps with stacked gates take one GEMM, the recurrence runs fused
+// gate kernels and backward propagates through time without step nodes.
+// Variables are compatible with LSTM cell.
+class LSTMSequence : public Function
+{
+public:
+  LSTMSequence(Graph& graph, Function& x, Function& h, Function& c,
+  int in, int out);
+  LSTMSequence(Graph& graph, Function& x, Function& h, Function& c,
+  const LSTM& other);
+  LSTMSequence(Graph& graph, Function& x, Function& h, Function& c,
+  const LSTMSequence& other);
+
+  Variable& Wf() { return *_Wf; }
+  Variable& Hf() { return *_Hf; }
+  Variable& bf() { return *_bf; }
+
+  Variable& Wi() { return *_Wi; }
+  Variable& Hi() { return *_Hi; }
+  Variable& bi() { return *_bi; }
+
+  Variable& Wo() { return *_Wo; }
+  Variable& Ho() { return *_Ho; }
+  Variable& bo() { return *_bo; }
+
+  Variable& Wg() { return *_Wg; }
+  Variable& Hg() { return *_Hg; }
+  Variable& bg() { return *_bg; }
+
+  // c(t) of all steps [T*B x out] without gradient
+  const Tensor& cell() { forward(); return _C; }
+
+  virtual const Tensor& forward();
+
+private:
+  void init();
+
+  // gradients of gates of all steps
+  class Derivative_steps;
+
+protected:
+  Function &_x, &_h, &_c;
+  Variable *_Wf, *_Hf, *_bf;
+  Variable *_Wi, *_Hi, *_bi;
+  Variable *_Wo, *_Ho, *_bo;
+  Variable *_Wg, *_Hg, *_bg;
+  Derivative_steps* _dG;
+
+  // gates i, f, g and o and cells of all steps
+  Tensor _G;
+  Tensor _C;
+};
+
 // Norm
 class Norm : public Function
 {
 public:
+  // gain of [1 x cols] normalizes each row of a batch separately
   Norm(Graph& graph, Function& x,
   int rows = -1, int cols = -1, DTYPE eps = EPSILON);
 
@@ -587,16 +862,24 @@ public:
   Variable& A() { return *_a; }
   Variable& B() { return *_b; }
 
+  // input access
+  Function& X() { return _x; }
+
 private:
   void init();
 
+  // row gain normalizes rows, other gains normalize all elements
+  bool rowwise() const;
+
 protected:
   const DTYPE _epsilon;
   Function &_x;
   Variable *_a;
   Variable *_b;
-  Function *_N;
-  Constant *_H;
+
+  // mean and reciprocal standard deviation of each normalized row
+  ColVector _mean;
+  ColVector _rstd;
 };
 
 // Sampler function
@@ -611,7 +894,7 @@ public:
 
 protected:
   Function &_m, &_s;
-  Constant *_e;
+  Function *_e;
   Function *_Z;
   bool _enabled;
 };
@@ -643,7 +926,7 @@ protected:
 };
 
 // Embedding function
-class Embedding : public Function
+class Embedding : public Function, public Quantized
 {
 public:
   Embedding(Graph& graph, Function& i, int in, int out);
@@ -654,6 +937,10 @@ public:
 
   virtual const Tensor& forward();
 
+  virtual void calibrate() {}
+
+  virtual void quantize();
+
 private:
   void init();
 
@@ -662,8 +949,23 @@ protected:
   Variable* _E;
 };
 
+// Gather function
+// F(r) = x(r, i(r)) for column index i(r) of each row, rows with negative
+// index are zero and pass no gradient
+class Gather : public Function
+{
+public:
+  Gather(Graph& graph, Function& x, Function& i);
+
+  virtual const Tensor& forward();
+
+protected:
+  Function& _x;
+  Function& _i;
+};
+
 // Conv2D function
-class Conv2D : public Function
+class Conv2D : public Function, public Quantized
 {
 public:
   Conv2D(
@@ -684,16 +986,34 @@ public:
   // kernel(s) variable
   Variable& K() const { return *_K; };
 
+  // use unrolled sparse kernel matrix instead of im2col and GEMM
+  void sparse(bool enable) { _sparse = enable; }
+
   virtual const Tensor& forward();
 
+  virtual void calibrate();
+
+  virtual void quantize();
+
 private:
   void init();
 
+  // sparse backend
   SparseTensor& K_matrix();
   Tensor K_gradient(SparseTensor& dK_matrix);
 
   void convert(Tensor& K, SparseTensor& K_matrix, bool forward);
 
+  // im2col backend
+  Tensor K_dense() const;
+  Tensor K_gradient(const Tensor& dK_dense) const;
+
+  void im2col(const DTYPE* x, Tensor& col) const;
+  void col2im(const Tensor& col, DTYPE* x) const;
+
+  int o_rows() const;
+  int o_cols() const;
+
 protected:
   int _i_rows;
   int _i_cols;
@@ -704,9 +1024,10 @@ protected:
   int _stride;
   int _padding;
   int _dilation;
+  bool _sparse;
   Function& _x;
   Variable* _K;
-  Tensor _K_tracker;
+  size_t _K_version;
   SparseTensor _K_matrix;
 };
 
@@ -720,6 +1041,7 @@ public:
 
 protected:
   Function& _x;
+  Tensor _dFdx;
 };
 
 // GeLU function
@@ -735,9 +1057,164 @@ protected:
   Function* _gelu;
 #else
   Function& _x;
+  Tensor _dFdx;
 #endif
 };
 
+// Multi-Head Attention function
+// F = concat(A(1) * V(1), ..., A(H) * V(H)) * Wo.T + bo
+// A(h) = dropout(softmax(Q(h) * K(h).T / sqrt(D) + mask))
+// Q = q * Wq.T + bq, K = k * Wk.T + bk, V = v * Wv.T + bv
+// Heads are column blocks of Q, K and V of width D = emb_size / num_heads,
+// projected by one GEMM when q, k and v are the same function.
+class MultiHeadAttention : public Function
+{
+public:
+  // q [trg_size x emb_size], k and v [seq_size x emb_size],
+  // mask [trg_size x seq_size] added to attention scores
+  MultiHeadAttention(
+    Graph& graph, Function& q, Function& k, Function& v, Function& mask,
+    int trg_size, int seq_size, int emb_size, int num_heads,
+    bool bias = true, DTYPE dropout = 0.0
+  );
+  MultiHeadAttention(
+    Graph& graph, Function& q, Function& k, Function& v, Function& mask,
+    const MultiHeadAttention& other
+  );
+
+  // variable access
+  Variable& Wq() { return *_Wq; }
+  Variable& Wk() { return *_Wk; }
+  Variable& Wv() { return *_Wv; }
+  Variable& Wo() { return *_Wo; }
+  Variable& bq() { return *_bq; }
+  Variable& bk() { return *_bk; }
+  Variable& bv() { return *_bv; }
+  Variable& bo() { return *_bo; }
+
+  virtual const Tensor& forward();
+
+  void enable(bool enable) { _enabled = enable; }
+
+  // attend within sequences packed into consecutive rows instead of the
+  // mask, offsets [0, n1, n1 + n2, ...] hold cumulative rows of q and k,
+  // causal hides keys following each query of a sequence
+  void pack(const std::vector<int>& q_offsets,
+  const std::vector<int>& k_offsets, bool causal = false);
+
+  // attend over all rows with the mask
+  void unpack();
+
+  // stream over tiles of q and k rows with online softmax, keep no
+  // attention matrix and recompute tiles in backward, 0 disables tiling
+  void tile(int rows) { _tile = rows; }
+
+  // key and value projections of attended rows kept between decoding steps
+  struct Cache
+  {
+    Cache() : size(0) {}
+
+    // drop cached rows, keep capacity
+    void clear() { size = 0; }
+
+    Tensor K;
+    Tensor V;
+    int size;
+  };
+
+  // project k and v rows and append them to the cache
+  void append(const Tensor& k, const Tensor& v, Cache& cache);
+
+  // attention of q rows over cached rows without dropout or gradient,
+  // optional mask [q rows x cached rows] is added to scores
+  Tensor attend(const Tensor& q, const Cache& cache,
+  const Tensor& mask = Tensor());
+
+private:
+  void init();
+
+  // attention gradients of Q, K and V
+  class Derivative_heads;
+
+  // rows of q and k attending to each other
+  struct Block
+  {
+    int q, q_rows;
+    int k, k_rows;
+  };
+
+  std::vector<Block> blocks(int q_rows, int k_rows) const;
+
+  // tiles of q and k rows within a block, causal mask skips tiles of
+  // keys following all queries of the tile
+  std::vector<Block> tiles(const Block& block) const;
+
+  // scaled and masked scores of tile rows within a block and head h
+  void scores(const Tensor& mask, const Block& block, const Block& tile,
+  int h, Tensor& S) const;
+
+  // dropout mask of tile and head h regenerated from the forward step
+  void dropout(const Block& tile, int h, Tensor& M) const;
+
+  // attention of O and L over tiles with online softmax
+  void attend_tiled(const Tensor& mask);
+
+protected:
+  Function &_q, &_k, &_v, &_mask;
+  Variable *_Wq, *_Wk, *_Wv, *_Wo;
+  Variable *_bq, *_bk, *_bv, *_bo;
+  int _trg_size, _seq_size; // rows of q and of k and v, 0 when unchecked
+  int _heads;
+  DTYPE _rate;
+  bool _enabled;
+  Derivative_heads* _dQKV;
+  std::vector<int> _q_offsets;
+  std::vector<int> _k_offsets;
+  bool _causal;
+  std::vector<Block> _blocks;
+  int _tile;
+  uint32_t _stream;
+  uint32_t _step;
+
+  // projections, joined heads, attention and dropout mask of each block
+  // and head, tiled attention keeps log-sum-exp of each row and head only
+  Tensor _Q, _K, _V, _O;
+  std::vector<Tensor> _P;
+  std::vector<Tensor> _M;
+  Tensor _L;
+};
+
+// Gradient checkpoint of the segment of functions computing x. Values of
+// the segment are released after forward and recomputed segment by segment
+// in Graph::backward, which keeps the activations of checkpoints and of one
+// segment instead of all of them. The segment ends at constants, variables
+// and earlier checkpoints.
+class GradientCheckpoint : public Function
+{
+public:
+  GradientCheckpoint(Graph& graph, Function& x);
+
+  virtual const Tensor& forward();
+
+  // release segment values after forward
+  void release(bool enable) { _release = enable; }
+
+  // recompute the segment, cache derivatives of its inputs and release it
+  void backprop();
+
+  // functions of the segment in graph order
+  const std::vector<Function*>& segment() const { return _segment; }
+
+protected:
+  // free segment values, gradients and derivatives of segment functions
+  void free();
+
+  Function& _x;
+  bool _release;
+  std::vector<Function*> _segment;
+  std::unordered_set<Function*> _inside;
+};
+
 // No Value computed in the graph exception
 class NoValueException : public std::runtime_error
 {
@@ -745,11 +1222,277 @@ public:
   NoValueException() : std::runtime_error("NoValueException") {}
 };
 
+// Compiled execution plan. Node shapes are resolved from the shapes of
+// constants and variables at compile time, which reports incompatible
+// shapes. Values, gradients and scratch buffers are allocated then as well,
+// so that the first pass runs like the following ones.
+class Plan
+{
+public:
+  Plan(Graph& graph, Function& f);
+
+  ~Plan();
+
+  // forward pass in topological order
+  const Tensor& forward();
+
+  // backward pass in reverse topological order
+  void backward(const Tensor& g);
+
+  // fuse known node patterns, return number of fused patterns
+  int fuse();
+
+  // output function
+  Function& output() { return _output; }
+
+  // forward nodes in execution order
+  const std::vector<Function*>& nodes() const { return _forward; }
+
+  // bytes preallocated for backward buffers
+  size_t memory() const;
+
+  // run nodes on n threads as soon as their inputs are ready
+  void threads(int n);
+
+protected:
+  // error of the first node in graph order failing to trace
+  std::runtime_error trace_error(const std::exception& e);
+
+  // value or gradient placed in a shared buffer
+  struct Buffer
+  {
+    Function* node;
+    bool value;
+    int slot;
+    int rows;
+    int cols;
+  };
+
+  // backward step of a single node
+  struct Step
+  {
+    Function* node;
+    bool accumulate;
+    int rows;
+    int cols;
+    std::vector<Function*> derivative;
+    std::vector<Buffer> acquire;
+    std::vector<Buffer> release;
+  };
+
+  // elementwise stage of a fused chain
+  enum StageType { TANH, SIGMOID, RELU, SCALE, SHIFT };
+
+  struct Stage
+  {
+    StageType type;
+    Function* input;
+    Function* constant;
+    DTYPE sign;
+    std::vector<Function*> nodes;
+  };
+
+  // pattern replaced by fused nodes
+  struct Fusion
+  {
+    Function* kernel;
+    std::vector<Function*> nodes;
+    std::vector<std::pair<Function*, Function*>> derivative;
+  };
+
+  typedef std::unordered_map<Function*, std::vector<Function*>> Edges;
+
+  // pattern matching
+  bool stage(Function* n, Stage& s);
+  bool fuse_gemm(Function* root, Fusion& f);
+  bool fuse_softmax(Function* root, Fusion& f);
+  bool fuse_chain(Function* root, const Edges& consumers, Fusion& f);
+
+  // assign shared buffers by liveness
+  void plan_memory();
+
+  // dependencies of forward nodes and backward steps
+  void plan_schedule();
+
+  // backward step buffers and gradient
+  void acquire(Step& e);
+  void release(Step& e);
+  void aggregate(Step& e);
+
+  // run tasks of a dependency graph on the thread pool
+  void run(const std::vector<int>& wait,
+    const std::vector<std::vector<int>>& next, std::function<void(int)> task);
+
+  // buffer tensor
+  static Tensor& tensor(const Buffer& b)
+  {
+    return (b.value) ? b.node->_value : b.node->_gradient;
+  }
+
+  Graph& _graph;
+  Function& _output;
+  std::vector<Function*> _forward;
+  std::vector<Step> _backward;
+  std::vector<Tensor> _arena;
+  std::vector<Function*> _fused;
+  std::unordered_map<Function*, Function*> _kernels;
+  std::vector<int> _forward_wait;
+  std::vector<int> _backward_wait;
+  std::vector<std::vector<int>> _forward_next;
+  std::vector<std::vector<int>> _backward_next;
+  std::unique_ptr<ThreadPool> _pool;
+  int _threads;
+};
+
+// Recurrent unrolling over a ring of window step subgraphs. Step t of a
+// sequence runs on slot t % window. Constants hold the state entering the
+// window, so when the next window starts the state leaving its last slot
+// is copied into them and back-propagation stops at the window boundary
+// (truncated BPTT). Memory and cost of a pass are bounded by the window.
+class Unroll
+{
+public:
+  // build slot from state functions entering it, return state leaving it
+  typedef std::function<std::vector<Function*>(int slot,
+    const std::vector<Function*>& state)> Step;
+
+  // initial state entering the first window
+  Unroll(Graph& graph, int window, const std::vector<Tensor>& state,
+  const Step& step);
+
+  // number of slots
+  int window() const { return _window; }
+
+  // slot of step t
+  int slot(int t) const { return t % _window; }
+
+  // state entering the window
+  std::vector<Tensor> state() const;
+
+  // set state entering the window and recache the graph
+  void state(const std::vector<Tensor>& values);
+
+  // carry state leaving the last slot into the next window
+  void advance();
+
+  // restart from the initial state
+  void reset() { state(_init); }
+
+protected:
+  Graph& _graph;
+  int _window;
+  std::vector<Tensor> _init;
+  std::vector<Constant*> _entry;
+  std::vector<Function*> _exit;
+};
+
+// Post-training int8 quantization of Linear, Conv2D, Embedding and Product
+class Quantizer
+{
+public:
+  Quantizer(Graph& graph);
+
+  // track input ranges after forward pass on calibration data
+  void calibrate();
+
+  // switch nodes to int8 weights
+  void quantize();
+
+  // switch nodes back to full precision weights
+  void dequantize();
+
+  // save int8 weights of nodes in graph order
+  void write(std::ostream& out) const;
+
+  // load int8 weights of nodes in graph order and switch to int8 mode
+  void read(std::istream& in);
+
+  // quantizable nodes in graph order
+  const std::vector<Quantized*>& nodes() const { return _nodes; }
+
+private:
+  Graph& _graph;
+  std::vector<Quantized*> _nodes;
+};
+
+// Opt-in profile of graph node evaluation. Compiled plans evaluate forward
+// nodes one at a time, each of which is timed. Derivatives are timed as they
+// are aggregated into gradients in eager and compiled backward passes. Time
+// of evaluations nested in another one is excluded from its self time.
+class Profiler
+{
+public:
+  // attach to graph, detach on destruction
+  Profiler(Graph& graph);
+
+  ~Profiler();
+
+  // evaluations of one node
+  struct Record
+  {
+    const Function* node;
+    std::string scope;
+    std::string type;
+    bool derivative;
+    uint64_t count;
+    double seconds;       // excluding nested evaluations
+    double total_seconds; // including nested evaluations
+    uint64_t allocated;   // bytes of value buffers allocated
+  };
+
+  // evaluate node and record its time and allocated value
+  const Tensor& evaluate(Function& f, bool derivative);
+
+  // records of evaluated nodes by self time
+  std::vector<Record> records() const;
+
+  // write table of time and memory per scope
+  void write_table(std::ostream& out) const;
+
+  // write evaluations in chrome://tracing format
+  void write_trace(std::ostream& out) const;
+
+  // drop records and events
+  void clear();
+
+  // type name of node
+  static std::string type(const Function* f);
+
+private:
+  struct Stats
+  {
+    uint64_t count = 0;
+    uint64_t micros = 0;
+    uint64_t total_micros = 0;
+    uint64_t allocated = 0;
+  };
+
+  struct Event
+  {
+    const Function* node;
+    bool derivative;
+    int thread;
+    uint64_t start;
+    uint64_t micros;
+  };
+
+  // scope of node or of node it belongs to
+  std::string scope(const Function* f,
+    const std::unordered_map<const Function*, int>& index) const;
+
+  Graph& _graph;
+  std::chrono::steady_clock::time_point _start;
+  std::unordered_map<const Function*, Stats> _stats[2];
+  std::vector<Event> _events;
+  std::unordered_map<std::thread::id, int> _threads;
+  mutable std::mutex _lock;
+};
+
 // Function Graph
 class Graph
 {
 public:
-  Graph()
+  Graph() : _no_grad(false), _profiler(nullptr), _scope_names(1)
   {
   }
 
@@ -763,6 +1506,12 @@ public:
   // random number generator
   RNG& random() { return _rng; }
 
+  // build nodes without derivatives for inference
+  void no_grad(bool enable) { _no_grad = enable; }
+
+  // no-grad mode of nodes built from now on
+  bool no_grad() const { return _no_grad; }
+
   // set function name
   Function* name(Function* f, const char* name);
 
@@ -790,15 +1539,22 @@ public:
   // reset cache
   void recache();
 
+  // reset cache of functions computed from f
+  void invalidate_from(Function& f);
+
   // reset gradients
   void zero_grad();
 
   // compute gradients
   void backward(Function& f, const Tensor& g);
 
-  // aggreagor implementation
-  virtual void aggregate(
-  Tensor& g, const std::vector<Function*>& derivative) const;
+  // compile execution plan for function
+  Plan* compile(Function& f);
+
+  // aggreagor implementation, derivatives of shape rows x cols are added
+  // to g when accumulating, otherwise g is set to their sum
+  virtual void aggregate(Tensor& g, int rows, int cols,
+  const std::vector<Function*>& derivative, bool accumulate = false) const;
 
   ///////////////////////////////////////////
   // numerical derivative
@@ -812,12 +1568,31 @@ public:
   // node name scope
   ///////////////////////////////////////////
 
-  void scope_push(const char* name) { _scope.push_back(name); }
+  void scope_push(const char* name);
 
-  void scope_pop() { _scope.pop_back(); }
+  void scope_pop() { _scope.pop_back(); _scope_ids.pop_back(); }
 
   std::string scope_name() const;
 
+  // scope of node i when it was created
+  const std::string& scope_name(int i) const
+  {
+    return _scope_names[_node_scopes[i]];
+  }
+
+  ///////////////////////////////////////////
+  // profiling
+  ///////////////////////////////////////////
+
+  // attached profiler, null when not profiled
+  Profiler* profiler() const { return _profiler; }
+
+  // evaluate node, timed when profiled
+  const Tensor& evaluate(Function& f, bool derivative = false) const
+  {
+    return _profiler ? _profiler->evaluate(f, derivative) : f.forward();
+  }
+
   ///////////////////////////////////////////
   // node constructors
   ///////////////////////////////////////////
@@ -1005,9 +1780,9 @@ public:
     return node;
   }
 
-  Softmax* new_softmax(Function& x)
+  Softmax* new_softmax(Function& x, Axis axis = ALL)
   {
-    auto node = new Softmax(*this, x);
+    auto node = new Softmax(*this, x, axis);
     keep(node);
     return node;
   }
@@ -1019,9 +1794,9 @@ public:
     return node;
   }
 
-  LogSoftmax* new_log_softmax(Function& x)
+  LogSoftmax* new_log_softmax(Function& x, Axis axis = ALL)
   {
-    auto node = new LogSoftmax(*this, x);
+    auto node = new LogSoftmax(*this, x, axis);
     keep(node);
     return node;
   }
@@ -1047,16 +1822,23 @@ public:
     return node;
   }
 
-  Sum* new_sum(Function& x)
+  Sum* new_sum(Function& x, Axis axis = ALL)
   {
-    auto node = new Sum(*this, x);
+    auto node = new Sum(*this, x, axis);
     keep(node);
     return node;
   }
 
-  Mean* new_mean(Function& x)
+  Mean* new_mean(Function& x, Axis axis = ALL)
   {
-    auto node = new Mean(*this, x);
+    auto node = new Mean(*this, x, axis);
+    keep(node);
+    return node;
+  }
+
+  Maximum* new_maximum(Function& x, Axis axis = ALL)
+  {
+    auto node = new Maximum(*this, x, axis);
     keep(node);
     return node;
   }
@@ -1089,6 +1871,52 @@ public:
     return node;
   }
 
+  GRUSequence* new_gru_sequence(Function& x, Function& h, int in, int out)
+  {
+    auto node = new GRUSequence(*this, x, h, in, out);
+    keep(node);
+    return node;
+  }
+
+  GRUSequence* new_gru_sequence(Function& x, Function& h, const GRU& other)
+  {
+    auto node = new GRUSequence(*this, x, h, other);
+    keep(node);
+    return node;
+  }
+
+  GRUSequence* new_gru_sequence(Function& x, Function& h,
+  const GRUSequence& other)
+  {
+    auto node = new GRUSequence(*this, x, h, other);
+    keep(node);
+    return node;
+  }
+
+  LSTMSequence* new_lstm_sequence(Function& x, Function& h, Function& c,
+  int in, int out)
+  {
+    auto node = new LSTMSequence(*this, x, h, c, in, out);
+    keep(node);
+    return node;
+  }
+
+  LSTMSequence* new_lstm_sequence(Function& x, Function& h, Function& c,
+  const LSTM& other)
+  {
+    auto node = new LSTMSequence(*this, x, h, c, other);
+    keep(node);
+    return node;
+  }
+
+  LSTMSequence* new_lstm_sequence(Function& x, Function& h, Function& c,
+  const LSTMSequence& other)
+  {
+    auto node = new LSTMSequence(*this, x, h, c, other);
+    keep(node);
+    return node;
+  }
+
   Sampler* new_sampler(Function& m, Function& s)
   {
     auto node = new Sampler(*this, m, s);
@@ -1096,6 +1924,13 @@ public:
     return node;
   }
 
+  GradientCheckpoint* new_checkpoint(Function& x)
+  {
+    auto node = new GradientCheckpoint(*this, x);
+    keep(node);
+    return node;
+  }
+
   Norm* new_norm(Function& x, int rows = -1, int cols = -1, DTYPE eps = EPSILON)
   {
     auto node = new Norm(*this, x, rows, cols, eps);
@@ -1138,6 +1973,13 @@ public:
     return node;
   }
 
+  Gather* new_gather(Function& x, Function& i)
+  {
+    auto node = new Gather(*this, x, i);
+    keep(node);
+    return node;
+  }
+
   Conv2D* new_conv2d(
     Function& x, int i_rows, int i_cols,
     int i_channels = 1, int o_channels = 1, int k_rows = 3, int k_cols = 3,
@@ -1172,14 +2014,60 @@ public:
     return node;
   }
 
+  MultiHeadAttention* new_multihead_attention(
+    Function& q, Function& k, Function& v, Function& mask,
+    int trg_size, int seq_size, int emb_size, int num_heads,
+    bool bias = true, DTYPE dropout = 0.0
+  )
+  {
+    auto node = new MultiHeadAttention(*this, q, k, v, mask,
+      trg_size, seq_size, emb_size, num_heads, bias, dropout);
+    keep(node);
+    return node;
+  }
+
+  MultiHeadAttention* new_multihead_attention(
+    Function& q, Function& k, Function& v, Function& mask,
+    const MultiHeadAttention& other
+  )
+  {
+    auto node = new MultiHeadAttention(*this, q, k, v, mask, other);
+    keep(node);
+    return node;
+  }
+
 protected:
+  friend class Rowwise;
+  friend class Profiler;
+
+  // remove nodes kept in range [begin, end) except variables
+  void discard(size_t begin, size_t end);
+
   RNG _rng;
+  bool _no_grad;
+  std::vector<Plan*> _plans;
   std::vector<Function*> _nodes;
   std::vector<Variable*> _vars;
   std::vector<std::string> _names;
   std::vector<std::string> _scope;
+  Profiler* _profiler;
+
+  // scope of each node as index of distinct scope names
+  std::vector<std::string> _scope_names;
+  std::vector<int> _scope_ids;
+  std::vector<int> _node_scopes;
 };
 
+// set derivative D of input x, only record the input in no-grad graph
+template <class D, class F>
+void Function::derivative(Function& x, F& base)
+{
+  if (_graph.no_grad())
+    input(x);
+  else
+    x.derivative(new D(_graph, base));
+}
+
 } /* namespace */
 
 #endif /*_SEEGNIFY_GRAPH_H_*/
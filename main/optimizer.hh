@@ -8,6 +8,7 @@
 #define _SEEGNIFY_OPTIMIZER_H_
 
 #include "graph.hh"
+#include "external/thread-pool-11/ThreadPool.h"
 
 namespace seegnify {
 
@@ -104,8 +105,30 @@ private:
 class Optimizer
 {
 public:
+  Optimizer() : _lazy(false) {}
   virtual ~Optimizer() {} 
   virtual void update() = 0;
+
+  // update only rows with gradient of row-sparse variables (e.g. Embedding),
+  // statistics of other rows are not decayed
+  void lazy(bool enable) { _lazy = enable; }
+
+protected:
+  // call f for variable blocks to update
+  template <class F>
+  void update_blocks(Variable& v, F f)
+  {
+    if (_lazy && v.row_sparse())
+    {
+      for (auto r: v.rows()) f(r, 1);
+    }
+    else
+    {
+      f(0, v.value().rows());
+    }
+  }
+
+  bool _lazy;
 };
 
 // SGD + momentum optimizer
@@ -174,18 +197,25 @@ public:
     int size = _vars.size();
     for (int i=0; i<size; i++)
     {
-      auto& w = _vars[i]->value();
-      auto& g = _vars[i]->gradient();
+      auto& v = *_vars[i];
+      auto& w = v.value();
+      auto& g = v.gradient();
       auto& egg = _egg[i];
 
       if (!egg.size()) egg = g.array() * g.array();
 
-      // update g^2 EMA
-      auto gg = (g.array() * g.array()).matrix();
-      egg += (1.0 - _gamma) * (gg - egg);
+      update_blocks(v, [&](int r, int n)
+      {
+        auto g_r = g.middleRows(r, n);
+        auto egg_r = egg.middleRows(r, n);
 
-      // update weights
-      w -= _lr * (g.array() / (egg.array() + EPSILON)).matrix();
+        // update g^2 EMA
+        auto gg = (g_r.array() * g_r.array()).matrix();
+        egg_r += (1.0 - _gamma) * (gg - egg_r);
+
+        // update weights
+        w.middleRows(r, n) -= _lr * (g_r.array() / (egg_r.array() + EPSILON)).matrix();
+      });
     }
   }
 
@@ -226,26 +256,35 @@ public:
     int size = _vars.size();
     for (int i=0; i<size; i++)
     {
-      auto& w = _vars[i]->value();
-      auto& g = _vars[i]->gradient();
+      auto& v = *_vars[i];
+      auto& w = v.value();
+      auto& g = v.gradient();
       auto& s1 = _s1[i];
       auto& s2 = _s2[i];
 
       if (!s1.size()) s1 = g;
       if (!s2.size()) s2 = g.array() * g.array();
 
-      // update EMA
-      auto gg = (g.array() * g.array()).matrix();
-      s1 += (1.0 - _beta1) * (g - s1);
-      s2 += (1.0 - _beta2) * (gg - s2);
-
-      // comupte bias correction
-      auto sc1 = s1 / (1.0 - powf(_beta1, _t));
-      auto sc2 = s2 / (1.0 - powf(_beta2, _t));
-      auto lr = _lr * sqrt(1.0 - powf(_beta2, _t)) / (1.0 - powf(_beta1, _t));
-
-      // update weights
-      w -= lr * (sc1.array() / ((sc2.array() + EPSILON)).sqrt()).matrix();
+      update_blocks(v, [&](int r, int n)
+      {
+        auto g_r = g.middleRows(r, n);
+        auto s1_r = s1.middleRows(r, n);
+        auto s2_r = s2.middleRows(r, n);
+
+        // update EMA
+        auto gg = (g_r.array() * g_r.array()).matrix();
+        s1_r += (1.0 - _beta1) * (g_r - s1_r);
+        s2_r += (1.0 - _beta2) * (gg - s2_r);
+
+        // comupte bias correction
+        auto sc1 = s1_r / (1.0 - powf(_beta1, _t));
+        auto sc2 = s2_r / (1.0 - powf(_beta2, _t));
+        auto lr = _lr * sqrt(1.0 - powf(_beta2, _t)) / (1.0 - powf(_beta1, _t));
+
+        // update weights
+        w.middleRows(r, n) -=
+          lr * (sc1.array() / ((sc2.array() + EPSILON)).sqrt()).matrix();
+      });
     }
   }
 
@@ -349,26 +388,35 @@ public:
     int size = _vars.size();
     for (int i=0; i<size; i++)
     {
-      auto& w = _vars[i]->value();
-      auto& g = _vars[i]->gradient();
+      auto& v = *_vars[i];
+      auto& w = v.value();
+      auto& g = v.gradient();
       auto& s1 = _s1[i];
       auto& s2 = _s2[i];
 
       if (!s1.size()) s1 = g;
       if (!s2.size()) s2 = g.array() * g.array();
 
-      // updage averages
-      auto gg = g.array() * g.array();
-      s1 += (1.0 - _beta1) * (g - s1);
-      s2 += (1.0 - _beta2) * (gg * (gg - s2.array()).sign()).matrix();
-
-      // comupte bias correction
-      auto sc1 = s1 / (1.0 - powf(_beta1, _t));
-      auto sc2 = s2 / (1.0 - powf(_beta2, _t));
-      auto lr = _lr * sqrt(1.0 - powf(_beta2, _t)) / (1.0 - powf(_beta1, _t));
-
-      // update weights
-      w -= lr * (sc1.array() / ((sc2.array() + EPSILON)).sqrt()).matrix();
+      update_blocks(v, [&](int r, int n)
+      {
+        auto g_r = g.middleRows(r, n);
+        auto s1_r = s1.middleRows(r, n);
+        auto s2_r = s2.middleRows(r, n);
+
+        // updage averages
+        auto gg = g_r.array() * g_r.array();
+        s1_r += (1.0 - _beta1) * (g_r - s1_r);
+        s2_r += (1.0 - _beta2) * (gg * (gg - s2_r.array()).sign()).matrix();
+
+        // comupte bias correction
+        auto sc1 = s1_r / (1.0 - powf(_beta1, _t));
+        auto sc2 = s2_r / (1.0 - powf(_beta2, _t));
+        auto lr = _lr * sqrt(1.0 - powf(_beta2, _t)) / (1.0 - powf(_beta1, _t));
+
+        // update weights
+        w.middleRows(r, n) -=
+          lr * (sc1.array() / ((sc2.array() + EPSILON)).sqrt()).matrix();
+      });
     }
   }
 
@@ -382,6 +430,175 @@ private:
   std::vector<Variable*> _vars;
 };
 
+// Optimizer state of all variables in one contiguous buffer, traversed
+// in cache sized chunks so that a fused step visits each element once
+class FlatState
+{
+public:
+  // elements per chunk, all chunk streams stay in L1 cache
+  enum { CHUNK = 2048 };
+
+  // chunk of variable elements
+  struct Chunk
+  {
+    int var;
+    int offset;
+    int size;
+    int state;
+  };
+
+  FlatState(const std::vector<Variable*>& vars, int buffers) :
+  _vars(vars), _buffers(buffers), _size(0) {}
+
+  // variables
+  const std::vector<Variable*>& variables() const { return _vars; }
+
+  // chunks of all variables, built on first call
+  const std::vector<Chunk>& chunks()
+  {
+    if (_chunks.size()) return _chunks;
+
+    for (int i=0; i<_vars.size(); i++)
+    {
+      const Function& v = *_vars[i];
+      int size = v.value().size();
+      for (int j=0; j<size; j+=CHUNK)
+      {
+        int n = std::min<int>(CHUNK, size - j);
+        _chunks.push_back(Chunk{i, j, n, _size});
+        _size += n;
+      }
+    }
+
+    _state = RowVector::Zero(_buffers * _size);
+    return _chunks;
+  }
+
+  // state buffer b of chunk c
+  RowVectorMap state(const Chunk& c, int b)
+  {
+    return RowVectorMap(_state.data() + (size_t)b * _size + c.state, c.size);
+  }
+
+  // resolve value and gradient data of variables and advance value
+  // versions once per step, called before chunks are shared by threads
+  void prepare()
+  {
+    _values.resize(_vars.size());
+    _gradients.resize(_vars.size());
+    for (int i=0; i<_vars.size(); i++)
+    {
+      _values[i] = _vars[i]->value().data();
+      _gradients[i] = _vars[i]->gradient().data();
+    }
+  }
+
+  // variable value of chunk c
+  RowVectorMap value(const Chunk& c)
+  {
+    return RowVectorMap(_values[c.var] + c.offset, c.size);
+  }
+
+  // variable gradient of chunk c
+  RowVectorMap gradient(const Chunk& c)
+  {
+    return RowVectorMap(_gradients[c.var] + c.offset, c.size);
+  }
+
+private:
+  std::vector<Variable*> _vars;
+  std::vector<DTYPE*> _values;
+  std::vector<DTYPE*> _gradients;
+  std::vector<Chunk> _chunks;
+  RowVector _state;
+  int _buffers;
+  int _size;
+};
+
+// Adam optimizer with one fused pass over all variables. Moments live in
+// flat state and each chunk is updated while it remains in cache, chunks
+// are split among threads. Results match Adam.
+class FusedAdam : public Optimizer
+{
+public:
+  FusedAdam(const std::vector<Variable*>& vars, DTYPE lr,
+  DTYPE beta1 = 0.9, DTYPE beta2 = 0.999) : _state(vars, 2)
+  {
+    _t = 0;
+    _lr = lr;
+    _beta1 = beta1;
+    _beta2 = beta2;
+    _threads = 1;
+  }
+
+  // split chunks among n threads
+  void threads(int n)
+  {
+    _threads = std::max(n, 1);
+    _pool.reset((_threads > 1) ? new ThreadPool(_threads) : nullptr);
+  }
+
+  void update()
+  {
+    // increment step (common for all variables)
+    _t++;
+
+    // comupte bias correction
+    DTYPE c1 = 1.0 / (1.0 - powf(_beta1, _t));
+    DTYPE c2 = 1.0 / (1.0 - powf(_beta2, _t));
+    DTYPE lr = _lr * sqrt(1.0 - powf(_beta2, _t)) / (1.0 - powf(_beta1, _t));
+
+    auto& chunks = _state.chunks();
+    int size = chunks.size();
+    _state.prepare();
+
+    auto step = [&](int begin, int end)
+    {
+      for (int i=begin; i<end; i++)
+      {
+        auto& c = chunks[i];
+        auto w = _state.value(c);
+        auto g = _state.gradient(c);
+        auto s1 = _state.state(c, 0);
+        auto s2 = _state.state(c, 1);
+
+        if (_t == 1) { s1 = g; s2 = g.array() * g.array(); }
+
+        // update EMA
+        s1 += (1.0 - _beta1) * (g - s1);
+        s2 += (1.0 - _beta2) * ((g.array() * g.array()).matrix() - s2);
+
+        // update weights
+        w -= lr * ((s1.array() * c1) /
+          ((s2.array() * c2 + EPSILON)).sqrt()).matrix();
+      }
+    };
+
+    if (_threads <= 1 || size < 2)
+    {
+      step(0, size);
+      return;
+    }
+
+    std::vector<std::future<void>> done;
+    int block = (size + _threads - 1) / _threads;
+    for (int i=0; i<size; i+=block)
+    {
+      done.push_back(_pool->enqueue(step, i, std::min(size, i + block)));
+    }
+    for (auto& f: done) f.get();
+  }
+
+private:
+  DTYPE _t;
+  DTYPE _lr;
+  DTYPE _beta1;
+  DTYPE _beta2;
+  FlatState _state;
+  int _threads;
+  std::unique_ptr<ThreadPool> _pool;
+};
+
 } /* namespace */
 
 #endif /*_SEEGNIFY_OPTIMIZER_H_*/
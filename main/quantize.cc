@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "quantize.hh"
+
+namespace seegnify {
+
+// columns of b processed while a row of a remains in cache
+#define QGEMM_BLOCK 64
+
+///////////////////////////////////////////
+// int8 tensors
+///////////////////////////////////////////
+
+void quantize(const Tensor& t, QTensor& q, DTYPE range)
+{
+  q.values.resize(t.rows(), t.cols());
+  q.scales.resize(t.rows());
+
+  for (int r=0; r<t.rows(); r++)
+  {
+    DTYPE max = (range > 0) ? range : t.row(r).cwiseAbs().maxCoeff();
+    DTYPE scale = (max > 0) ? max / 127 : 1;
+
+    q.scales(r) = scale;
+    q.values.row(r) = (t.row(r) / scale).array().round()
+      .max(-127).min(127).cast<int8_t>();
+  }
+}
+
+Tensor dequantize(const QTensor& q)
+{
+  return q.scales.asDiagonal() * q.values.cast<DTYPE>();
+}
+
+// int8 dot products of 2 rows of a with 4 rows of b accumulated in int32,
+// returns number of leading elements processed
+#if defined(__AVX2__)
+
+#define QVEC 16
+typedef __m256i qvec;
+
+static inline qvec qzero() { return _mm256_setzero_si256(); }
+
+static inline qvec qload(const int8_t* p)
+{
+  return _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)p));
+}
+
+static inline qvec qmadd(qvec acc, qvec a, qvec b)
+{
+  return _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+}
+
+static inline int32_t qsum(qvec v)
+{
+  __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v),
+    _mm256_extracti128_si256(v, 1));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+  return _mm_cvtsi128_si32(s);
+}
+
+#elif defined(__SSE2__)
+
+#define QVEC 8
+typedef __m128i qvec;
+
+static inline qvec qzero() { return _mm_setzero_si128(); }
+
+static inline qvec qload(const int8_t* p)
+{
+  __m128i v = _mm_loadl_epi64((const __m128i*)p);
+  return _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+}
+
+static inline qvec qmadd(qvec acc, qvec a, qvec b)
+{
+  return _mm_add_epi32(acc, _mm_madd_epi16(a, b));
+}
+
+static inline int32_t qsum(qvec s)
+{
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+  return _mm_cvtsi128_si32(s);
+}
+
+#endif
+
+static int qdot(const int8_t* a[2], const int8_t* b[4], int size,
+int32_t c[2][4])
+{
+#ifdef QVEC
+  qvec acc[2][4];
+  for (int i=0; i<2; i++)
+    for (int j=0; j<4; j++) acc[i][j] = qzero();
+
+  int k = 0;
+  for (; k+QVEC<=size; k+=QVEC)
+  {
+    qvec a0 = qload(a[0] + k);
+    qvec a1 = qload(a[1] + k);
+    for (int j=0; j<4; j++)
+    {
+      qvec bj = qload(b[j] + k);
+      acc[0][j] = qmadd(acc[0][j], a0, bj);
+      acc[1][j] = qmadd(acc[1][j], a1, bj);
+    }
+  }
+
+  for (int i=0; i<2; i++)
+    for (int j=0; j<4; j++) c[i][j] = qsum(acc[i][j]);
+
+  return k;
+#else
+  for (int i=0; i<2; i++)
+    for (int j=0; j<4; j++) c[i][j] = 0;
+
+  return 0;
+#endif
+}
+
+void qgemm(const QTensor& a, const QTensor& b, Tensor& c)
+{
+  int M = a.rows();
+  int N = b.rows();
+  int K = a.cols();
+
+  if (b.cols() != K)
+    throw std::runtime_error("Incompatible int8 matrix dimensions");
+
+  c.resize(M, N);
+
+  for (int n0=0; n0<N; n0+=QGEMM_BLOCK)
+  {
+    int n1 = std::min(N, n0 + QGEMM_BLOCK);
+
+    for (int m=0; m<M; m+=2)
+    {
+      // rows past the end repeat the last row
+      const int8_t* a_m[2];
+      for (int i=0; i<2; i++)
+      {
+        a_m[i] = a.values.data() + (size_t)std::min(m + i, M - 1) * K;
+      }
+
+      for (int n=n0; n<n1; n+=4)
+      {
+        const int8_t* b_n[4];
+        for (int j=0; j<4; j++)
+        {
+          b_n[j] = b.values.data() + (size_t)std::min(n + j, n1 - 1) * K;
+        }
+
+        // vectorized head and scalar tail
+        int32_t acc[2][4];
+        int k0 = qdot(a_m, b_n, K, acc);
+        for (int i=0; i<2; i++)
+        for (int j=0; j<4; j++)
+        {
+          for (int k=k0; k<K; k++) acc[i][j] += (int16_t)a_m[i][k] * b_n[j][k];
+        }
+
+        for (int i=0; i<2 && m+i<M; i++)
+        for (int j=0; j<4 && n+j<n1; j++)
+        {
+          c(m + i, n + j) = a.scales(m + i) * b.scales(n + j) * acc[i][j];
+        }
+      }
+    }
+  }
+}
+
+void read_qtensor(QTensor& q, std::istream& in)
+{
+  int32_t rows, cols;
+  in.read((char*)&rows, sizeof(rows));
+  in.read((char*)&cols, sizeof(cols));
+  if (!in || rows < 0 || cols < 0)
+    throw std::runtime_error("Failed to read int8 tensor");
+
+  q.values.resize(rows, cols);
+  q.scales.resize(rows);
+  in.read((char*)q.scales.data(), rows * sizeof(DTYPE));
+  in.read((char*)q.values.data(), q.values.size());
+  if (!in) throw std::runtime_error("Failed to read int8 tensor");
+}
+
+void write_qtensor(const QTensor& q, std::ostream& out)
+{
+  int32_t rows = q.rows();
+  int32_t cols = q.cols();
+  out.write((const char*)&rows, sizeof(rows));
+  out.write((const char*)&cols, sizeof(cols));
+  out.write((const char*)q.scales.data(), rows * sizeof(DTYPE));
+  out.write((const char*)q.values.data(), q.values.size());
+}
+
+///////////////////////////////////////////
+// Quantized node
+///////////////////////////////////////////
+
+void Quantized::write(std::ostream& out) const
+{
+  int32_t bias = _bias.size();
+  out.write((const char*)&_range, sizeof(_range));
+  out.write((const char*)&bias, sizeof(bias));
+  out.write((const char*)_bias.data(), bias * sizeof(DTYPE));
+  write_qtensor(_qW, out);
+}
+
+void Quantized::read(std::istream& in)
+{
+  int32_t bias = 0;
+  in.read((char*)&_range, sizeof(_range));
+  in.read((char*)&bias, sizeof(bias));
+  if (!in || bias < 0) throw std::runtime_error("Failed to read int8 bias");
+  _bias.resize(1, bias);
+  in.read((char*)_bias.data(), bias * sizeof(DTYPE));
+  read_qtensor(_qW, in);
+  _quantized = true;
+}
+
+} /* namespace */
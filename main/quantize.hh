@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_QUANTIZE_H_
+#define _SEEGNIFY_QUANTIZE_H_
+
+#include <iostream>
+
+#include "types.hh"
+
+namespace seegnify {
+
+typedef Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> TensorI8;
+
+// Int8 tensor with symmetric per-row scales, t(r,c) = values(r,c) * scales(r)
+struct QTensor
+{
+  TensorI8 values;
+  ColVector scales;
+
+  int rows() const { return values.rows(); }
+  int cols() const { return values.cols(); }
+};
+
+// quantize rows of t with their own scales (range = 0) or one scale of range
+void quantize(const Tensor& t, QTensor& q, DTYPE range = 0);
+
+// dequantize q
+Tensor dequantize(const QTensor& q);
+
+// c = a * b.T with int32 accumulation
+void qgemm(const QTensor& a, const QTensor& b, Tensor& c);
+
+// read QTensor from stream
+void read_qtensor(QTensor& q, std::istream& in);
+
+// write QTensor to stream
+void write_qtensor(const QTensor& q, std::ostream& out);
+
+// Node with int8 inference variant
+class Quantized
+{
+public:
+  Quantized() : _range(0), _quantized(false) {}
+
+  virtual ~Quantized() {}
+
+  // track input range during forward pass on calibration data
+  virtual void calibrate() = 0;
+
+  // switch to int8 weights computed from current weights
+  virtual void quantize() = 0;
+
+  // switch back to full precision weights
+  void dequantize() { _quantized = false; }
+
+  // int8 mode state
+  bool quantized() const { return _quantized; }
+
+  // save int8 weights, full precision bias and calibrated range
+  void write(std::ostream& out) const;
+
+  // load int8 weights, full precision bias and calibrated range,
+  // switch to int8 mode
+  void read(std::istream& in);
+
+protected:
+  // quantize input with calibrated range or dynamically per row
+  void quantize_input(const Tensor& x, QTensor& q) const
+  {
+    seegnify::quantize(x, q, _range);
+  }
+
+  QTensor _qW;
+  Tensor _bias;
+  DTYPE _range;
+  bool _quantized;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_QUANTIZE_H_ */
@@ -8,23 +8,158 @@
 #define _SEEGNIFY_RANDOM_H_
 
 #include <random>
+#include <mutex>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <unordered_map>
 
 namespace seegnify {
 
+// Counter-based Philox4x32-10 generator (Salmon et al., Parallel Random
+// Numbers: As Easy as 1, 2, 3). Block i of a stream is a function of the
+// key and the counter (i, step, stream) only, so values fill the same way
+// on any thread and in any order, and are regenerated instead of stored.
+// Rounds of consecutive blocks run in lanes the compiler vectorizes.
+class Philox
+{
+public:
+  Philox(uint64_t key, uint32_t stream, uint32_t step = 0)
+  {
+    _key[0] = uint32_t(key);
+    _key[1] = uint32_t(key >> 32);
+    _step = step;
+    _stream = stream;
+  }
+
+  // four random words of block i
+  void block(uint64_t i, uint32_t out[4]) const
+  {
+    uint32_t w[4][LANES];
+    rounds(i, w);
+    for (int j=0; j<4; j++) out[j] = w[j][0];
+  }
+
+  // uniform values in [0, 1) of elements [offset, offset + n)
+  void uniform(float* out, size_t n, uint64_t offset = 0) const
+  {
+    fill(out, n, offset, [](const uint32_t* w, float* v)
+    {
+      for (int j=0; j<4; j++) v[j] = (w[j] >> 8) * (1.0f / 16777216);
+    });
+  }
+
+  // normal values of elements [offset, offset + n) by Box-Muller
+  void normal(float* out, size_t n, float mean, float stddev,
+  uint64_t offset = 0) const
+  {
+    fill(out, n, offset, [=](const uint32_t* w, float* v)
+    {
+      for (int j=0; j<4; j+=2)
+      {
+        float u1 = ((w[j] >> 8) + 1) * (1.0f / 16777216);
+        float u2 = (w[j+1] >> 8) * (1.0f / 16777216);
+        float r = stddev * std::sqrt(-2 * std::log(u1));
+        v[j] = mean + r * std::cos(6.2831853f * u2);
+        v[j+1] = mean + r * std::sin(6.2831853f * u2);
+      }
+    });
+  }
+
+private:
+  static const int LANES = 8;
+
+  // ten rounds of blocks [first, first + LANES)
+  void rounds(uint64_t first, uint32_t w[4][LANES]) const
+  {
+    uint32_t k0 = _key[0], k1 = _key[1];
+    for (int l=0; l<LANES; l++)
+    {
+      w[0][l] = uint32_t(first + l);
+      w[1][l] = uint32_t((first + l) >> 32);
+      w[2][l] = _step;
+      w[3][l] = _stream;
+    }
+
+    for (int r=0; r<10; r++)
+    {
+      for (int l=0; l<LANES; l++)
+      {
+        uint64_t p0 = uint64_t(0xD2511F53) * w[0][l];
+        uint64_t p1 = uint64_t(0xCD9E8D57) * w[2][l];
+        uint32_t x1 = w[1][l], x3 = w[3][l];
+        w[0][l] = uint32_t(p1 >> 32) ^ x1 ^ k0;
+        w[1][l] = uint32_t(p1);
+        w[2][l] = uint32_t(p0 >> 32) ^ x3 ^ k1;
+        w[3][l] = uint32_t(p0);
+      }
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+  }
+
+  // values v of the four words w of each block covering the elements
+  template <class F>
+  void fill(float* out, size_t n, uint64_t offset, F f) const
+  {
+    uint64_t first = offset / 4;
+    uint64_t last = (offset + n + 3) / 4;
+    uint32_t w[4][LANES];
+    uint32_t x[4];
+    float v[4];
+
+    for (uint64_t b=first; b<last; b+=LANES)
+    {
+      rounds(b, w);
+      for (int l=0; l<LANES && b + l < last; l++)
+      {
+        for (int j=0; j<4; j++) x[j] = w[j][l];
+        f(x, v);
+
+        // copy values of elements within range
+        uint64_t e = (b + l) * 4;
+        for (int j=0; j<4; j++, e++)
+        {
+          if (e >= offset && e < offset + n) out[e - offset] = v[j];
+        }
+      }
+    }
+  }
+
+  uint32_t _key[2];
+  uint32_t _step;
+  uint32_t _stream;
+};
+
 class RNG
 {
 public:
-  RNG()
+  RNG() : _streams(0)
   {
     seed();
   }
 
   void seed()
   {
-    _generator.seed(_device());
+    seed((uint64_t(_device()) << 32) | _device());
+  }
+
+  // seed of generator and key of counter-based streams
+  void seed(uint64_t value)
+  {
+    _generator.seed(value);
+    _key = value;
   }
 
+  // key of counter-based streams
+  uint64_t key() const { return _key; }
+
+  // stream id of a new node, drawn in node construction order
+  uint32_t stream() { return _streams++; }
+
+  // lock for draws from concurrent threads
+  std::mutex& mutex() { return _mutex; }
+
   int uniform_int(int top)
   {
     std::uniform_int_distribution<int> d(0, top);
@@ -84,6 +219,9 @@ public:
 private:
   std::random_device _device;
   std::mt19937 _generator;
+  std::mutex _mutex;
+  std::atomic<uint32_t> _streams;
+  uint64_t _key;
 };
 
 } /* namespace */
@@ -42,6 +42,12 @@ typedef Eigen::Matrix<DTYPE, Eigen::Dynamic, 1, Eigen::ColMajor> ColVector;
 typedef Eigen::Map<ColVector> ColVectorMap;
 typedef Eigen::Map<const ColVector> ConstColVectorMap;
 
+// storage precision
+enum Precision { FP32 = 0, FP16 = 1, BF16 = 2 };
+
+typedef Eigen::Matrix<Eigen::half, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> TensorFP16;
+typedef Eigen::Matrix<Eigen::bfloat16, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> TensorBF16;
+
 // Export symbols
 #ifndef DLL_EXPORT
 #define DLL_EXPORT __attribute__ ((visibility ("default")))
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "audiostream.hh"
+
+namespace seegnify {
+
+// WAV sample formats
+#define WAVE_PCM 0x0001
+#define WAVE_FLOAT 0x0003
+#define WAVE_EXTENSIBLE 0xFFFE
+
+///////////////////////////////////////////
+// byte order helpers
+///////////////////////////////////////////
+
+static inline uint32_t le16(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t le32(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint32_t be16(const uint8_t* p)
+{
+  return (p[0] << 8) | p[1];
+}
+
+static inline uint32_t be32(const uint8_t* p)
+{
+  return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static inline DTYPE int24(uint32_t v)
+{
+  return (int32_t)((v ^ 0x800000) - 0x800000) / (DTYPE)8388608.;
+}
+
+static inline DTYPE int32(uint32_t v)
+{
+  return (DTYPE)(int32_t)v /
+    static_cast<float>(std::numeric_limits<std::int32_t>::max());
+}
+
+static inline DTYPE float32(uint32_t v)
+{
+  float f;
+  std::memcpy(&f, &v, sizeof(f));
+  return f;
+}
+
+// 80 bit extended precision number of AIFF sample rate
+static inline double extended(const uint8_t* p)
+{
+  int exponent = ((p[0] & 0x7F) << 8 | p[1]) - 16383;
+  uint64_t mantissa = 0;
+  for (int i=2; i<10; i++) mantissa = (mantissa << 8) | p[i];
+  double value = std::ldexp((double)mantissa, exponent - 63);
+  return (p[0] & 0x80) ? -value : value;
+}
+
+static inline bool chunk(const uint8_t* p, const char* id)
+{
+  return std::memcmp(p, id, 4) == 0;
+}
+
+///////////////////////////////////////////
+// AudioStream impl
+///////////////////////////////////////////
+
+AudioStream::AudioStream(const std::string& path) : _file(path)
+{
+  _samples = nullptr;
+  _channels = 0;
+  _sample_rate = 0;
+  _bit_depth = 0;
+  _block = 0;
+  _frames = 0;
+
+  auto data = (const uint8_t*)_file.data();
+  if (_file.size() >= 12 && chunk(data, "RIFF") && chunk(data + 8, "WAVE"))
+    parse_wave(path);
+  else
+  if (_file.size() >= 12 && chunk(data, "FORM") &&
+     (chunk(data + 8, "AIFF") || chunk(data + 8, "AIFC")))
+    parse_aiff(path);
+  else
+    throw std::runtime_error("Unsupported audio file '" + path + "'");
+
+  if (!_samples || _channels <= 0 || _sample_rate <= 0)
+    throw std::runtime_error("Invalid audio file '" + path + "'");
+}
+
+void AudioStream::parse_wave(const std::string& path)
+{
+  auto data = (const uint8_t*)_file.data();
+  size_t size = _file.size();
+
+  int format = 0;
+  size_t bytes = 0;
+
+  for (size_t p=12; p + 8 <= size;)
+  {
+    size_t length = std::min<size_t>(le32(data + p + 4), size - p - 8);
+    auto body = data + p + 8;
+
+    if (chunk(data + p, "fmt ") && length >= 16)
+    {
+      format = le16(body);
+      _channels = le16(body + 2);
+      _sample_rate = le32(body + 4);
+      _block = le16(body + 12);
+      _bit_depth = le16(body + 14);
+
+      // sub format is first two bytes of the format GUID
+      if (format == WAVE_EXTENSIBLE && length >= 40) format = le16(body + 24);
+    }
+    else if (chunk(data + p, "data"))
+    {
+      _samples = body;
+      bytes = length;
+    }
+
+    p += 8 + length + (length & 1);
+  }
+
+  if (format == WAVE_PCM && _bit_depth == 8) _encoding = UINT8;
+  else if (format == WAVE_PCM && _bit_depth == 16) _encoding = INT16_LE;
+  else if (format == WAVE_PCM && _bit_depth == 24) _encoding = INT24_LE;
+  else if (format == WAVE_PCM && _bit_depth == 32) _encoding = INT32_LE;
+  else if (format == WAVE_FLOAT && _bit_depth == 32) _encoding = FLOAT32_LE;
+  else throw std::runtime_error("Unsupported audio format of '" + path + "'");
+
+  _block = std::max(_block, _channels * _bit_depth / 8);
+  if (_block > 0) _frames = bytes / _block;
+}
+
+void AudioStream::parse_aiff(const std::string& path)
+{
+  auto data = (const uint8_t*)_file.data();
+  size_t size = _file.size();
+
+  bool aifc = chunk(data + 8, "AIFC");
+  const uint8_t* compression = nullptr;
+  size_t bytes = 0;
+  long frames = 0;
+
+  for (size_t p=12; p + 8 <= size;)
+  {
+    size_t length = std::min<size_t>(be32(data + p + 4), size - p - 8);
+    auto body = data + p + 8;
+
+    if (chunk(data + p, "COMM") && length >= 18)
+    {
+      _channels = be16(body);
+      frames = be32(body + 2);
+      _bit_depth = be16(body + 6);
+      _sample_rate = std::round(extended(body + 8));
+      if (aifc && length >= 22) compression = body + 18;
+    }
+    else if (chunk(data + p, "SSND") && length >= 8)
+    {
+      size_t offset = be32(body);
+      _samples = body + 8 + offset;
+      bytes = (length >= 8 + offset) ? length - 8 - offset : 0;
+    }
+
+    p += 8 + length + (length & 1);
+  }
+
+  bool little = compression && chunk(compression, "sowt");
+  bool real = compression &&
+    (chunk(compression, "fl32") || chunk(compression, "FL32"));
+
+  if (compression && !little && !real &&
+      !chunk(compression, "NONE") && !chunk(compression, "twos"))
+    throw std::runtime_error("Unsupported audio format of '" + path + "'");
+
+  if (real && _bit_depth == 32) _encoding = FLOAT32_BE;
+  else if (real) throw std::runtime_error("Invalid audio file '" + path + "'");
+  else if (_bit_depth == 8) _encoding = INT8;
+  else if (_bit_depth == 16) _encoding = little ? INT16_LE : INT16_BE;
+  else if (_bit_depth == 24) _encoding = little ? INT24_LE : INT24_BE;
+  else if (_bit_depth == 32) _encoding = little ? INT32_LE : INT32_BE;
+  else throw std::runtime_error("Unsupported audio format of '" + path + "'");
+
+  _block = _channels * _bit_depth / 8;
+  if (_block > 0) _frames = std::min<long>(frames, bytes / _block);
+}
+
+// decode samples by f into out
+template <class F>
+static void decode_samples(const uint8_t* in, long count, int block,
+DTYPE* out, bool add, F f)
+{
+  if (add)
+    for (long i=0; i<count; i++, in+=block) out[i] += f(in);
+  else
+    for (long i=0; i<count; i++, in+=block) out[i] = f(in);
+}
+
+void AudioStream::decode(const uint8_t* in, long count, DTYPE* out,
+bool add) const
+{
+  auto b = _block;
+
+  switch (_encoding)
+  {
+    case UINT8: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return (DTYPE)(p[0] - 128) / (DTYPE)128.; });
+      break;
+    case INT8: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return (DTYPE)(int8_t)p[0] / (DTYPE)128.; });
+      break;
+    case INT16_LE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return (DTYPE)(int16_t)le16(p) / (DTYPE)32768.; });
+      break;
+    case INT16_BE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return (DTYPE)(int16_t)be16(p) / (DTYPE)32768.; });
+      break;
+    case INT24_LE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return int24(p[0] | p[1] << 8 | p[2] << 16); });
+      break;
+    case INT24_BE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return int24(p[2] | p[1] << 8 | p[0] << 16); });
+      break;
+    case INT32_LE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return int32(le32(p)); });
+      break;
+    case INT32_BE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return int32(be32(p)); });
+      break;
+    case FLOAT32_LE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return float32(le32(p)); });
+      break;
+    case FLOAT32_BE: decode_samples(in, count, b, out, add,
+      [](const uint8_t* p) { return float32(be32(p)); });
+      break;
+  }
+}
+
+long AudioStream::read(long frame, long count, DTYPE* out, int channel) const
+{
+  if (channel >= _channels)
+    throw std::runtime_error("Invalid audio channel");
+
+  if (frame < 0 || frame >= _frames || count <= 0) return 0;
+  count = std::min(count, _frames - frame);
+
+  auto in = _samples + (size_t)frame * _block;
+  int bytes = _bit_depth / 8;
+
+  if (channel >= 0)
+  {
+    decode(in + channel * bytes, count, out, false);
+    return count;
+  }
+
+  // mean of channels
+  decode(in, count, out, false);
+  for (int c=1; c<_channels; c++) decode(in + c * bytes, count, out, true);
+  if (_channels > 1)
+  {
+    DTYPE scale = DTYPE(1) / _channels;
+    for (long i=0; i<count; i++) out[i] *= scale;
+  }
+
+  return count;
+}
+
+} /* namespace */
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_AUDIO_STREAM_H_
+#define _SEEGNIFY_AUDIO_STREAM_H_
+
+#include <string>
+#include <cstdint>
+
+#include "main/types.hh"
+#include "dataset.hh"
+
+namespace seegnify {
+
+// PCM audio of a WAV or AIFF file mapped read-only from disk. Samples are
+// decoded on demand from the mapped data, so reading frames of a long file
+// loads only the pages they span. Sample values follow AudioFile, integer
+// samples are scaled to [-1, 1] and float samples are read as they are.
+class AudioStream
+{
+public:
+  AudioStream(const std::string& path);
+
+  // number of channels
+  int channels() const { return _channels; }
+
+  // samples per second
+  int sample_rate() const { return _sample_rate; }
+
+  // bits per sample
+  int bit_depth() const { return _bit_depth; }
+
+  // samples per channel
+  long frames() const { return _frames; }
+
+  // decode count samples from frame of channel, or mean of all channels if
+  // channel is negative, return number of samples decoded before file end
+  long read(long frame, long count, DTYPE* out, int channel = -1) const;
+
+private:
+  // sample encodings
+  enum Encoding
+  {
+    UINT8,      // unsigned 8 bit
+    INT8,       // signed 8 bit
+    INT16_LE,   // little endian 16 bit
+    INT16_BE,   // big endian 16 bit
+    INT24_LE,   // little endian 24 bit
+    INT24_BE,   // big endian 24 bit
+    INT32_LE,   // little endian 32 bit
+    INT32_BE,   // big endian 32 bit
+    FLOAT32_LE, // little endian IEEE float
+    FLOAT32_BE, // big endian IEEE float
+  };
+
+  // parse chunks of WAV file
+  void parse_wave(const std::string& path);
+
+  // parse chunks of AIFF file
+  void parse_aiff(const std::string& path);
+
+  // decode count samples one block apart, add them to out if add is set
+  void decode(const uint8_t* in, long count, DTYPE* out, bool add) const;
+
+  MappedFile _file;
+  const uint8_t* _samples;
+  Encoding _encoding;
+  int _channels;
+  int _sample_rate;
+  int _bit_depth;
+  int _block;
+  long _frames;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_AUDIO_STREAM_H_ */
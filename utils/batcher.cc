@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "batcher.hh"
+
+namespace seegnify {
+
+Batcher::Batcher(int max_rows, int max_delay_us) :
+_max_rows(max_rows), _max_delay(max_delay_us)
+{
+  if (max_rows <= 0 || max_delay_us < 0)
+    throw std::runtime_error("Invalid batcher configuration");
+
+  _queued_rows = 0;
+  _stop = false;
+
+  _requests = 0;
+  _batches = 0;
+  _rows = 0;
+}
+
+void Batcher::predict(const Tensor& input, Tensor& output)
+{
+  Request request;
+  request.input = &input;
+  request.output = &output;
+  request.arrival = Clock::now();
+  request.done = false;
+
+  std::unique_lock<std::mutex> lock(_lock);
+  if (_stop) throw std::runtime_error("Batcher stopped");
+
+  _queue.push_back(&request);
+  _queued_rows += input.rows();
+
+  // full batch wakes waiting replicas, first request an idle one
+  if (_queued_rows >= _max_rows) _arrived.notify_all();
+  else _arrived.notify_one();
+
+  _completed.wait(lock, [&]() { return request.done; });
+  if (request.error) std::rethrow_exception(request.error);
+}
+
+void Batcher::take(std::vector<Request*>& batch)
+{
+  batch.clear();
+
+  int rows = 0;
+  int cols = _queue.front()->input->cols();
+
+  // requests in arrival order of the same input size
+  while (_queue.size())
+  {
+    auto next = _queue.front();
+    int size = next->input->rows();
+    if (batch.size() && (rows + size > _max_rows ||
+        next->input->cols() != cols)) break;
+
+    batch.push_back(next);
+    _queue.pop_front();
+    _queued_rows -= size;
+    rows += size;
+  }
+}
+
+void Batcher::run(const Predict& predict)
+{
+  std::vector<Request*> batch;
+  Tensor input, output;
+
+  std::unique_lock<std::mutex> lock(_lock);
+
+  while (true)
+  {
+    _arrived.wait(lock, [&]() { return _stop || _queue.size(); });
+    if (_queue.empty()) return;
+
+    // wait for more rows while the oldest request may wait
+    auto deadline = _queue.front()->arrival + _max_delay;
+    _arrived.wait_until(lock, deadline, [&]()
+    {
+      return _stop || _queue.empty() || _queued_rows >= _max_rows;
+    });
+
+    // taken by another replica in the meantime
+    if (_queue.empty()) continue;
+
+    take(batch);
+
+    // more requests queued for other replicas
+    if (_queue.size()) _arrived.notify_one();
+
+    lock.unlock();
+
+    // join requests, predict and split outputs
+    std::exception_ptr error;
+    try
+    {
+      int rows = 0;
+      for (auto r: batch) rows += r->input->rows();
+
+      input.resize(rows, batch[0]->input->cols());
+      rows = 0;
+      for (auto r: batch)
+      {
+        input.middleRows(rows, r->input->rows()) = *r->input;
+        rows += r->input->rows();
+      }
+
+      predict(input, output);
+      if (output.rows() != rows)
+        throw std::runtime_error("Invalid number of prediction rows");
+
+      rows = 0;
+      for (auto r: batch)
+      {
+        *r->output = output.middleRows(rows, r->input->rows());
+        rows += r->input->rows();
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+
+    auto now = Clock::now();
+    for (auto r: batch)
+    {
+      std::chrono::duration<double> latency = now - r->arrival;
+      if (_latency.size() < BATCHER_WINDOW)
+        _latency.push_back(latency.count());
+      else
+        _latency[_requests % BATCHER_WINDOW] = latency.count();
+
+      r->error = error;
+      r->done = true;
+      _requests++;
+      _rows += r->input->rows();
+    }
+    _batches++;
+
+    _completed.notify_all();
+  }
+}
+
+void Batcher::stop()
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  _stop = true;
+  _arrived.notify_all();
+}
+
+uint64_t Batcher::requests() const
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  return _requests;
+}
+
+uint64_t Batcher::batches() const
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  return _batches;
+}
+
+uint64_t Batcher::rows() const
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  return _rows;
+}
+
+double Batcher::latency(double quantile) const
+{
+  std::vector<double> latency;
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    latency = _latency;
+  }
+
+  if (latency.empty()) return 0;
+
+  size_t k = std::min<size_t>(quantile * latency.size(), latency.size() - 1);
+  std::nth_element(latency.begin(), latency.begin() + k, latency.end());
+  return latency[k];
+}
+
+} /* namespace */
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_BATCHER_H_
+#define _SEEGNIFY_BATCHER_H_
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "main/types.hh"
+
+namespace seegnify {
+
+// number of latest request latencies kept for percentiles
+#define BATCHER_WINDOW 4096
+
+// Dynamic batching of prediction requests. Requests of input rows queue
+// up and model replicas take them in arrival order, joined into one batch
+// of up to max rows. A replica waits for more requests only while the
+// oldest one has waited less than max delay, so a request is delayed by
+// at most that much before its batch starts. Requests are never split, a
+// request larger than max rows is a batch of its own.
+class Batcher
+{
+public:
+  // predict output rows of batch of input rows
+  typedef std::function<void(const Tensor& input, Tensor& output)> Predict;
+
+  Batcher(int max_rows, int max_delay_us);
+
+  // predict rows of input in the batch of some replica, wait for output
+  void predict(const Tensor& input, Tensor& output);
+
+  // serve batches by predict until stopped, called by each replica thread
+  void run(const Predict& predict);
+
+  // stop replicas once queued requests are done
+  void stop();
+
+  // requests completed
+  uint64_t requests() const;
+
+  // batches completed
+  uint64_t batches() const;
+
+  // rows of completed batches
+  uint64_t rows() const;
+
+  // request latency at quantile in [0, 1] in seconds, of latest requests
+  double latency(double quantile) const;
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Request
+  {
+    const Tensor* input;
+    Tensor* output;
+    Clock::time_point arrival;
+    std::exception_ptr error;
+    bool done;
+  };
+
+  // take requests of next batch, caller holds lock
+  void take(std::vector<Request*>& batch);
+
+  const int _max_rows;
+  const std::chrono::microseconds _max_delay;
+
+  mutable std::mutex _lock;
+  std::condition_variable _arrived;
+  std::condition_variable _completed;
+  std::deque<Request*> _queue;
+  int _queued_rows;
+  bool _stop;
+
+  // statistics
+  uint64_t _requests;
+  uint64_t _batches;
+  uint64_t _rows;
+  std::vector<double> _latency;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_BATCHER_H_ */
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <functional>
+#include <cstring>
+
+#include "main/graph.hh"
+#include "main/backend.hh"
+#include "main/optimizer.hh"
+#include "examples/transformer.hh"
+#include "storage.hh"
+
+namespace seegnify {
+
+// One benchmark case, counts are per iteration. Setup allocates the case
+// and returns its iteration, so only one case is held in memory at a time.
+struct Benchmark
+{
+  std::string name;
+  std::string shape;
+  double flops;
+  double bytes;
+  double samples;
+  std::function<std::function<void()>()> setup;
+};
+
+// measured benchmark case
+struct Result
+{
+  const Benchmark* bench;
+  int iterations;
+  double seconds; // per iteration
+};
+
+// graph with input x and a loss over its output
+struct Model
+{
+  Graph graph;
+  Function* loss = nullptr;
+
+  // forward and backward pass of the loss
+  void step()
+  {
+    graph.recache();
+    graph.backward(*loss, Tensor::Ones(1, 1));
+    graph.zero_grad();
+  }
+};
+
+// random variable of graph
+Variable& input(Graph& g, int rows, int cols)
+{
+  auto& x = *g.new_variable(rows, cols);
+  x.value() = Tensor::Random(rows, cols);
+  return x;
+}
+
+// loss summing output weighted by random constant
+Function& weighted_sum(Graph& g, Function& y)
+{
+  auto& w = *g.new_constant(y().rows(), y().cols());
+  w.value() = Tensor::Random(y().rows(), y().cols());
+  return *g.new_sum(w * y);
+}
+
+// benchmark of graph built by ctor
+void add_graph(std::vector<Benchmark>& list, const std::string& name,
+const std::string& shape, double flops, double bytes, double samples,
+std::function<Function&(Graph&)> ctor)
+{
+  list.push_back(Benchmark{name, shape, flops, bytes, samples,
+    [ctor]() -> std::function<void()>
+    {
+      std::shared_ptr<Model> model(new Model());
+      model->loss = &ctor(model->graph);
+      return [model]() { model->step(); };
+    }});
+}
+
+// benchmark of optimizer update over variables of given sizes
+template <class O>
+void add_optimizer(std::vector<Benchmark>& list, const std::string& name,
+int tensors, int rows, int cols, int states)
+{
+  // read weight, gradient and states, write weight and states
+  double size = (double)tensors * rows * cols;
+  double bytes = size * sizeof(DTYPE) * (3 + 2 * states);
+
+  std::ostringstream shape;
+  shape << tensors << "x" << rows << "x" << cols;
+  list.push_back(Benchmark{name, shape.str(), 0, bytes, 0,
+    [=]() -> std::function<void()>
+    {
+      std::shared_ptr<Graph> g(new Graph());
+      std::vector<Variable*> vars;
+      for (int i=0; i<tensors; i++)
+      {
+        auto& v = input(*g, rows, cols);
+        v.gradient() = Tensor::Random(rows, cols);
+        vars.push_back(&v);
+      }
+      std::shared_ptr<O> optimizer(new O(vars, 1e-6));
+      return [g, optimizer]() { optimizer->update(); };
+    }});
+}
+
+// benchmark of matrix product on a named compute backend
+void add_gemm(std::vector<Benchmark>& list, const std::string& name,
+int M, int K, int N)
+{
+  std::ostringstream shape;
+  shape << M << "x" << K << "x" << N;
+  double flops = 2.0 * M * K * N;
+  double bytes = (double)(M * K + K * N + M * N) * sizeof(DTYPE);
+
+  list.push_back(Benchmark{"gemm." + name, shape.str(), flops, bytes, 0,
+    [=]() -> std::function<void()>
+    {
+      std::shared_ptr<Tensor> a(new Tensor(Tensor::Random(M, K)));
+      std::shared_ptr<Tensor> b(new Tensor(Tensor::Random(K, N)));
+      std::shared_ptr<Tensor> c(new Tensor());
+      return [a, b, c, name]()
+      {
+        // other benchmarks keep the active backend
+        std::string active = backend().name();
+        backend(name);
+        backend().gemm(*a, false, *b, false, *c);
+        backend(active);
+      };
+    }});
+}
+
+// benchmark of tensor serialization in given precision
+void add_serialization(std::vector<Benchmark>& list, const std::string& name,
+int rows, int cols, Precision precision)
+{
+  std::ostringstream shape;
+  shape << rows << "x" << cols;
+  double bytes = (double)rows * cols * sizeof(DTYPE);
+
+  list.push_back(Benchmark{"write_tensor." + name, shape.str(), 0, bytes, 0,
+    [=]() -> std::function<void()>
+    {
+      std::shared_ptr<Tensor> t(new Tensor(Tensor::Random(rows, cols)));
+      std::shared_ptr<std::stringstream> io(new std::stringstream());
+      return [t, io, precision]()
+      {
+        io->seekp(0);
+        write_tensor(*t, *io, precision);
+      };
+    }});
+
+  list.push_back(Benchmark{"read_tensor." + name, shape.str(), 0, bytes, 0,
+    [=]() -> std::function<void()>
+    {
+      std::shared_ptr<Tensor> t(new Tensor(Tensor::Random(rows, cols)));
+      std::shared_ptr<std::stringstream> io(new std::stringstream());
+      write_tensor(*t, *io, precision);
+      return [t, io, precision]()
+      {
+        io->seekg(0);
+        *t = read_tensor(*io, precision);
+      };
+    }});
+}
+
+// benchmark cases at shapes of typical models
+std::vector<Benchmark> benchmarks()
+{
+  std::vector<Benchmark> list;
+  const double F = sizeof(DTYPE);
+
+  // matrix products of each compute backend
+  for (auto& name: backends()) add_gemm(list, name, 512, 512, 512);
+
+  // dense layers, backward takes twice the forward products
+  {
+    int B = 64, I = 1024, O = 1024;
+    add_graph(list, "Linear", "64x1024x1024", 6.0 * B * I * O,
+      F * (B * I + I * O + B * O) * 3, B, [=](Graph& g) -> Function& {
+        auto& y = *g.new_linear(input(g, B, I), I, O);
+        y.W().value().setRandom();
+        return weighted_sum(g, y);
+      });
+  }
+  {
+    int M = 512, K = 512, N = 512;
+    add_graph(list, "Product", "512x512x512", 6.0 * M * K * N,
+      F * (M * K + K * N + M * N) * 3, M, [=](Graph& g) -> Function& {
+        return weighted_sum(g, *g.new_product(input(g, M, K),
+          input(g, K, N)));
+      });
+  }
+  {
+    int B = 16, R = 32, C = 32, I = 16, O = 32, K = 3;
+    int P = (R - K + 1) * (C - K + 1);
+    add_graph(list, "Conv2D", "16x16x32x32>32k3", 6.0 * B * P * I * O * K * K,
+      F * (B * I * R * C + B * O * P) * 3, B, [=](Graph& g) -> Function& {
+        auto& y = *g.new_conv2d(input(g, B, I * R * C), R, C, I, O, K, K);
+        y.K().value().setRandom();
+        return weighted_sum(g, y);
+      });
+  }
+
+  // memory bound layers, read input, write output, read both and
+  // gradient, write input gradient
+  {
+    int B = 64, N = 4096;
+    add_graph(list, "Softmax", "64x4096", 0, F * B * N * 5, B,
+      [=](Graph& g) -> Function& {
+        return weighted_sum(g, *g.new_softmax(input(g, B, N), ROWWISE));
+      });
+    add_graph(list, "LogSoftmax", "64x4096", 0, F * B * N * 5, B,
+      [=](Graph& g) -> Function& {
+        return weighted_sum(g, *g.new_log_softmax(input(g, B, N), ROWWISE));
+      });
+    add_graph(list, "Norm", "64x4096", 0, F * B * N * 5, B,
+      [=](Graph& g) -> Function& {
+        return weighted_sum(g, *g.new_norm(input(g, B, N), 1, N));
+      });
+  }
+  {
+    int B = 512, V = 32000, E = 512;
+    add_graph(list, "Embedding", "512x32000x512", 0, F * B * E * 4, B,
+      [=](Graph& g) -> Function& {
+        auto& i = *g.new_constant(1, B);
+        for (int k=0; k<B; k++) i.value()(k) = (k * 7919) % V;
+        auto& y = *g.new_embedding(i, V, E);
+        y.E().value().setRandom();
+        return weighted_sum(g, y);
+      });
+  }
+
+  // recurrent cells, gates of input and state products
+  {
+    int B = 32, I = 256, H = 256;
+    double gate = 2.0 * B * (I * H + H * H);
+    add_graph(list, "GRU", "32x256x256", 3 * 3 * gate,
+      F * 3 * (I * H + H * H) * 3, B, [=](Graph& g) -> Function& {
+        auto& y = *g.new_gru(input(g, B, I), input(g, B, H), I, H);
+        for (auto v: g.variables()) v->value().setRandom();
+        return weighted_sum(g, y);
+      });
+    add_graph(list, "LSTM", "32x256x256", 3 * 4 * gate,
+      F * 4 * (I * H + H * H) * 3, B, [=](Graph& g) -> Function& {
+        auto& y = *g.new_lstm(input(g, B, I), input(g, B, H),
+          input(g, B, H), I, H);
+        for (auto v: g.variables()) v->value().setRandom();
+        return weighted_sum(g, y);
+      });
+  }
+
+  // recurrent sequences of 16 steps
+  {
+    int T = 16, B = 32, I = 256, H = 256;
+    double gate = 2.0 * T * B * (I * H + H * H);
+    add_graph(list, "GRUSequence", "16x32x256x256", 3 * 3 * gate,
+      F * 3 * (I * H + H * H) * 3, T * B, [=](Graph& g) -> Function& {
+        auto& y = *g.new_gru_sequence(input(g, T * B, I), input(g, B, H),
+          I, H);
+        for (auto v: g.variables()) v->value().setRandom();
+        return weighted_sum(g, y);
+      });
+    add_graph(list, "LSTMSequence", "16x32x256x256", 3 * 4 * gate,
+      F * 4 * (I * H + H * H) * 3, T * B, [=](Graph& g) -> Function& {
+        auto& y = *g.new_lstm_sequence(input(g, T * B, I), input(g, B, H),
+          input(g, B, H), I, H);
+        for (auto v: g.variables()) v->value().setRandom();
+        return weighted_sum(g, y);
+      });
+  }
+
+  // attention of one sequence, projections and scores of all heads
+  {
+    int S = 128, E = 512, H = 8;
+    double flops = 8.0 * S * E * E + 4.0 * S * S * E;
+    add_graph(list, "MultiHeadAttention", "128x512h8", 3 * flops,
+      F * (4 * E * E + 4 * S * E + H * S * S) * 3, S,
+      [=](Graph& g) -> Function& {
+        auto& x = input(g, S, E);
+        auto& mask = *g.new_constant(S, S);
+        mask.value().setZero();
+        auto mha = new MultiHeadAttention(g, x, x, x, mask, S, S, E, H);
+        g.keep(mha);
+        for (auto v: g.variables()) v->value() *= 0.05;
+        return weighted_sum(g, *mha);
+      });
+  }
+
+  // optimizers over 16M weights
+  add_optimizer<SGD>(list, "SGD.update", 16, 1024, 1024, 1);
+  add_optimizer<RMSprop>(list, "RMSprop.update", 16, 1024, 1024, 1);
+  add_optimizer<Adam>(list, "Adam.update", 16, 1024, 1024, 2);
+  add_optimizer<AdamNC>(list, "AdamNC.update", 16, 1024, 1024, 2);
+  add_optimizer<Yogi>(list, "Yogi.update", 16, 1024, 1024, 2);
+  add_optimizer<FusedAdam>(list, "FusedAdam.update", 16, 1024, 1024, 2);
+
+  // serialization of 16 MB tensor
+  add_serialization(list, "FP32", 2048, 2048, FP32);
+  add_serialization(list, "FP16", 2048, 2048, FP16);
+  add_serialization(list, "BF16", 2048, 2048, BF16);
+
+  return list;
+}
+
+// run benchmark for at least given seconds after one warm-up iteration
+Result measure(const Benchmark& bench, double seconds)
+{
+  auto run = bench.setup();
+  run();
+
+  int iterations = 0;
+  double elapsed = 0;
+  auto start = std::chrono::steady_clock::now();
+  while (elapsed < seconds || iterations < 3)
+  {
+    run();
+    iterations++;
+    elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  }
+
+  return Result{&bench, iterations, elapsed / iterations};
+}
+
+// rate of count per second, 0 when not measured
+double rate(double count, double seconds)
+{
+  return (count > 0 && seconds > 0) ? count / seconds : 0;
+}
+
+void write_table(const std::vector<Result>& results, std::ostream& out)
+{
+  out << std::left << std::setw(24) << "benchmark"
+      << std::setw(20) << "shape" << std::right
+      << std::setw(12) << "usec/iter"
+      << std::setw(10) << "GFLOP/s"
+      << std::setw(10) << "GB/s"
+      << std::setw(14) << "samples/s" << std::endl;
+
+  out << std::fixed;
+  for (auto& e: results)
+  {
+    auto& b = *e.bench;
+    out << std::left << std::setw(24) << b.name
+        << std::setw(20) << b.shape << std::right << std::setprecision(1)
+        << std::setw(12) << e.seconds * 1e6
+        << std::setw(10) << rate(b.flops, e.seconds) * 1e-9
+        << std::setw(10) << rate(b.bytes, e.seconds) * 1e-9
+        << std::setw(14) << rate(b.samples, e.seconds) << std::endl;
+  }
+}
+
+void write_json(const std::vector<Result>& results, std::ostream& out)
+{
+  out << "{\"simd\":\"" << Eigen::SimdInstructionSetsInUse() << "\","
+      << "\"kernels\":\"" << kernel_isa() << "\","
+      << "\"backend\":\"" << backend().name() << "\","
+      << "\"threads\":" << Eigen::nbThreads() << ",\"benchmarks\":[";
+
+  out << std::setprecision(6);
+  for (int i=0; i<results.size(); i++)
+  {
+    auto& e = results[i];
+    auto& b = *e.bench;
+    out << (i ? ",\n" : "\n")
+        << "{\"name\":\"" << b.name << "\","
+        << "\"shape\":\"" << b.shape << "\","
+        << "\"iterations\":" << e.iterations << ","
+        << "\"seconds\":" << e.seconds << ","
+        << "\"gflops\":" << rate(b.flops, e.seconds) * 1e-9 << ","
+        << "\"gbps\":" << rate(b.bytes, e.seconds) * 1e-9 << ","
+        << "\"samples_per_second\":" << rate(b.samples, e.seconds) << "}";
+  }
+  out << "\n]}" << std::endl;
+}
+
+// syntax message
+void syntax(char* argv[])
+{
+  std::cerr << "Usage: " << argv[0] << " "
+            << "[--json] [--seconds SECONDS] [FILTER]" << std::endl;
+}
+
+} /* namespace */
+
+using namespace seegnify;
+
+/**
+ * benchmark entry point
+ */
+int main(int argc, char* argv[])
+{
+  bool json = false;
+  double seconds = 0.5;
+  std::string filter;
+
+  for (int i=1; i<argc; i++)
+  {
+    if (std::strcmp(argv[i], "--json") == 0) json = true;
+    else
+    if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+      seconds = std::stod(argv[++i]);
+    else
+    if (argv[i][0] != '-' && filter.empty()) filter = argv[i];
+    else
+    {
+      syntax(argv);
+      return 1;
+    }
+  }
+
+  try
+  {
+    // run benchmarks with names containing filter
+    auto list = benchmarks();
+    std::vector<Result> results;
+    for (auto& e: list)
+    {
+      if (e.name.find(filter) == std::string::npos) continue;
+      results.push_back(measure(e, seconds));
+      if (!json) std::cerr << "." << std::flush;
+    }
+    if (!json) std::cerr << std::endl;
+
+    if (json)
+      write_json(results, std::cout);
+    else
+      write_table(results, std::cout);
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 4;
+  }
+
+  return 0;
+}
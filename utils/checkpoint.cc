@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+
+#include <zlib.h>
+
+#include "checkpoint.hh"
+
+namespace seegnify {
+
+#define CHECKPOINT_MAGIC 0x4B434753 // SGCK
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_HEADER 64
+#define CHECKPOINT_ALIGN 64
+
+struct CheckpointHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+  uint32_t dtype;
+  uint32_t checksum;
+  uint32_t index;
+};
+
+// index entry of tensor, followed by name
+struct CheckpointEntry
+{
+  uint64_t offset;
+  int32_t rows;
+  int32_t cols;
+  uint32_t crc;
+  uint32_t name;
+};
+
+static size_t align(size_t offset)
+{
+  return (offset + CHECKPOINT_ALIGN - 1) / CHECKPOINT_ALIGN * CHECKPOINT_ALIGN;
+}
+
+static uint32_t checksum(const char* data, size_t size)
+{
+  uLong crc = crc32(0L, Z_NULL, 0);
+
+  // crc32 takes up to 4GB at a time
+  while (size)
+  {
+    uInt n = (uInt)std::min<size_t>(size, 1 << 30);
+    crc = crc32(crc, (const Bytef*)data, n);
+    data += n;
+    size -= n;
+  }
+
+  return crc;
+}
+
+///////////////////////////////////////////
+// Checkpoint impl
+///////////////////////////////////////////
+
+Checkpoint::Checkpoint(const std::string& path, bool verify) : _file(path)
+{
+  if (_file.size() < CHECKPOINT_HEADER)
+    throw std::runtime_error("Invalid checkpoint file '" + path + "'");
+
+  CheckpointHeader header;
+  std::memcpy(&header, _file.data(), sizeof(header));
+
+  if (header.magic != CHECKPOINT_MAGIC ||
+      header.version != CHECKPOINT_VERSION ||
+      header.dtype != sizeof(DTYPE) ||
+      CHECKPOINT_HEADER + (size_t)header.index > _file.size())
+    throw std::runtime_error("Invalid checkpoint file '" + path + "'");
+
+  _checksum = header.checksum;
+
+  // parse index
+  size_t pos = CHECKPOINT_HEADER;
+  size_t end = CHECKPOINT_HEADER + header.index;
+  for (int i=0; i<header.size; i++)
+  {
+    CheckpointEntry entry;
+    if (pos + sizeof(entry) > end)
+      throw std::runtime_error("Truncated checkpoint file '" + path + "'");
+
+    std::memcpy(&entry, _file.data() + pos, sizeof(entry));
+    pos += sizeof(entry);
+
+    size_t bytes = (size_t)entry.rows * entry.cols * sizeof(DTYPE);
+    if (pos + entry.name > end || entry.rows < 0 || entry.cols < 0 ||
+        entry.offset % CHECKPOINT_ALIGN || entry.offset + bytes > _file.size())
+      throw std::runtime_error("Truncated checkpoint file '" + path + "'");
+
+    Entry e;
+    e.name.assign(_file.data() + pos, entry.name);
+    e.rows = entry.rows;
+    e.cols = entry.cols;
+    e.offset = entry.offset;
+    e.crc = entry.crc;
+    pos += entry.name;
+
+    _index[e.name] = _entries.size();
+    _entries.push_back(e);
+  }
+
+  if (verify && !this->verify())
+    throw std::runtime_error("Corrupted checkpoint file '" + path + "'");
+}
+
+bool Checkpoint::verify() const
+{
+  if (!_checksum) return true;
+
+  for (auto& e: _entries)
+  {
+    size_t bytes = (size_t)e.rows * e.cols * sizeof(DTYPE);
+    if (checksum(_file.data() + e.offset, bytes) != e.crc) return false;
+  }
+
+  return true;
+}
+
+bool Checkpoint::is_checkpoint(const std::string& path)
+{
+  std::ifstream file(path, std::ios::in | std::ifstream::binary);
+  uint32_t magic = 0;
+  file.read((char*)&magic, sizeof(magic));
+  return file && magic == CHECKPOINT_MAGIC;
+}
+
+void Checkpoint::write(const std::string& path,
+const std::vector<std::string>& names,
+const std::vector<const Tensor*>& tensors, bool checksum)
+{
+  if (names.size() != tensors.size())
+    throw std::runtime_error("Incompatible number of names and tensors");
+
+  int size = tensors.size();
+
+  // index precedes aligned payloads
+  size_t index = 0;
+  for (auto& e: names) index += sizeof(CheckpointEntry) + e.size();
+
+  std::vector<CheckpointEntry> entries(size);
+  size_t offset = align(CHECKPOINT_HEADER + index);
+  for (int i=0; i<size; i++)
+  {
+    auto& t = *tensors[i];
+    auto& e = entries[i];
+    e.offset = offset;
+    e.rows = t.rows();
+    e.cols = t.cols();
+    e.crc = checksum ? seegnify::checksum((const char*)t.data(),
+      t.size() * sizeof(DTYPE)) : 0;
+    e.name = names[i].size();
+    offset = align(offset + t.size() * sizeof(DTYPE));
+  }
+
+  CheckpointHeader header;
+  header.magic = CHECKPOINT_MAGIC;
+  header.version = CHECKPOINT_VERSION;
+  header.size = size;
+  header.dtype = sizeof(DTYPE);
+  header.checksum = checksum;
+  header.index = index;
+
+  // write to temporary file and rename when complete
+  auto temp_file = path + ".new";
+  std::ofstream file(temp_file, std::ios::out | std::ofstream::binary);
+  if (!file)
+  {
+    std::ostringstream error;
+    error << "Failed to write file '" << temp_file << "'. Error code ";
+    error << errno << " .";
+    throw std::runtime_error(error.str());
+  }
+
+  char padding[CHECKPOINT_ALIGN] = {0};
+  std::memcpy(padding, &header, sizeof(header));
+  file.write(padding, CHECKPOINT_HEADER);
+  std::memset(padding, 0, sizeof(header));
+
+  for (int i=0; i<size; i++)
+  {
+    file.write((const char*)&entries[i], sizeof(CheckpointEntry));
+    file.write(names[i].data(), names[i].size());
+  }
+
+  size_t pos = CHECKPOINT_HEADER + index;
+  for (int i=0; i<size; i++)
+  {
+    auto& t = *tensors[i];
+    file.write(padding, entries[i].offset - pos);
+    file.write((const char*)t.data(), t.size() * sizeof(DTYPE));
+    pos = entries[i].offset + t.size() * sizeof(DTYPE);
+  }
+
+  file.close();
+  if (!file || std::rename(temp_file.c_str(), path.c_str()))
+  {
+    throw std::runtime_error("Failed to save checkpoint '" + path + "'");
+  }
+}
+
+} /* namespace */
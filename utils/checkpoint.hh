@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_CHECKPOINT_H_
+#define _SEEGNIFY_CHECKPOINT_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "main/types.hh"
+#include "utils/dataset.hh"
+
+namespace seegnify {
+
+// Named tensors mapped read-only from disk.
+// Layout: 64 byte header, index of named tensors, DTYPE payloads aligned
+// to 64 bytes, optional CRC32 of each payload
+class Checkpoint
+{
+public:
+  // map checkpoint file, verify payload checksums if requested
+  Checkpoint(const std::string& path, bool verify = false);
+
+  // number of tensors
+  int size() const { return _entries.size(); }
+
+  // tensor name
+  const std::string& name(int i) const { return _entries[i].name; }
+
+  // tensor view into the mapped file
+  ConstTensorMap tensor(int i) const
+  {
+    auto& e = _entries[i];
+    return ConstTensorMap((const DTYPE*)(_file.data() + e.offset),
+      e.rows, e.cols);
+  }
+
+  // tensor index by name, -1 when not found
+  int find(const std::string& name) const
+  {
+    auto it = _index.find(name);
+    return (it == _index.end()) ? -1 : it->second;
+  }
+
+  // compare payloads with stored checksums
+  bool verify() const;
+
+  // check for checkpoint format
+  static bool is_checkpoint(const std::string& path);
+
+  // save named tensors, payload checksums are optional
+  static void write(const std::string& path,
+  const std::vector<std::string>& names,
+  const std::vector<const Tensor*>& tensors, bool checksum = true);
+
+private:
+  struct Entry
+  {
+    std::string name;
+    int rows;
+    int cols;
+    size_t offset;
+    uint32_t crc;
+  };
+
+  MappedFile _file;
+  std::vector<Entry> _entries;
+  std::unordered_map<std::string, int> _index;
+  bool _checksum;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_CHECKPOINT_H_ */
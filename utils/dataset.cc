@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+#include <mutex>
+#include <map>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "dataset.hh"
+#include "storage.hh"
+#include "topology.hh"
+
+namespace seegnify {
+
+#define DATASET_MAGIC 0x53444753 // SGDS
+#define DATASET_VERSION 1
+#define DATASET_HEADER 64
+
+struct DatasetHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+  uint32_t features;
+  uint32_t dtype;
+};
+
+///////////////////////////////////////////
+// MappedFile impl
+///////////////////////////////////////////
+
+MappedFile::MappedFile(const std::string& path) : _data(nullptr), _size(0)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::ostringstream error;
+    error << "Failed to open file '" << path << "'. Error code ";
+    error << errno << " .";
+    throw std::runtime_error(error.str());
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0) _size = st.st_size;
+
+  void* data = (_size > 0) ?
+    mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  close(fd);
+
+  if (data == MAP_FAILED)
+  {
+    std::ostringstream error;
+    error << "Failed to map file '" << path << "'. Error code ";
+    error << errno << " .";
+    throw std::runtime_error(error.str());
+  }
+
+  _data = (const char*)data;
+}
+
+MappedFile::~MappedFile()
+{
+  munmap((void*)_data, _size);
+}
+
+///////////////////////////////////////////
+// Dataset impl
+///////////////////////////////////////////
+
+Dataset::Dataset(const std::string& path) : _file(path)
+{
+  if (_file.size() < DATASET_HEADER)
+    throw std::runtime_error("Invalid dataset file '" + path + "'");
+
+  DatasetHeader header;
+  std::memcpy(&header, _file.data(), sizeof(header));
+
+  if (header.magic != DATASET_MAGIC || header.version != DATASET_VERSION ||
+      header.dtype != sizeof(DTYPE))
+    throw std::runtime_error("Invalid dataset file '" + path + "'");
+
+  _size = header.size;
+  _features = header.features;
+
+  size_t inputs = (size_t)_size * _features * sizeof(DTYPE);
+  size_t labels = (size_t)_size * sizeof(int32_t);
+  if (_file.size() < DATASET_HEADER + inputs + labels)
+    throw std::runtime_error("Truncated dataset file '" + path + "'");
+
+  _inputs = (const DTYPE*)(_file.data() + DATASET_HEADER);
+  _labels = (const int32_t*)(_file.data() + DATASET_HEADER + inputs);
+}
+
+void Dataset::write(const std::string& path,
+const std::vector<std::vector<DTYPE>>& inputs,
+const std::vector<uint8_t>& labels)
+{
+  if (inputs.size() != labels.size())
+    throw std::runtime_error("Incompatible number of inputs and labels");
+
+  DatasetHeader header;
+  header.magic = DATASET_MAGIC;
+  header.version = DATASET_VERSION;
+  header.size = inputs.size();
+  header.features = inputs.size() ? inputs[0].size() : 0;
+  header.dtype = sizeof(DTYPE);
+
+  // write to temporary file and rename when complete
+  auto temp_file = path + ".new";
+  std::ofstream file(temp_file, std::ios::out | std::ofstream::binary);
+  if (!file)
+  {
+    std::ostringstream error;
+    error << "Failed to write file '" << temp_file << "'. Error code ";
+    error << errno << " .";
+    throw std::runtime_error(error.str());
+  }
+
+  char padding[DATASET_HEADER] = {0};
+  std::memcpy(padding, &header, sizeof(header));
+  file.write(padding, DATASET_HEADER);
+
+  for (auto& e: inputs)
+  {
+    if (e.size() != header.features)
+      throw std::runtime_error("Incompatible number of input features");
+    file.write((const char*)e.data(), e.size() * sizeof(DTYPE));
+  }
+
+  for (auto e: labels)
+  {
+    int32_t label = e;
+    file.write((const char*)&label, sizeof(label));
+  }
+
+  file.close();
+  if (!file || std::rename(temp_file.c_str(), path.c_str()))
+  {
+    throw std::runtime_error("Failed to save dataset '" + path + "'");
+  }
+}
+
+std::shared_ptr<const Dataset> Dataset::shared(const std::string& path,
+const std::function<void(const std::string&)>& convert)
+{
+  static std::mutex lock;
+  static std::map<std::string, std::weak_ptr<const Dataset>> datasets;
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  // reuse dataset mapped by other thread
+  auto dataset = datasets[path].lock();
+  if (dataset) return dataset;
+
+  // convert source data once
+  if (file_size(path) < 0) convert(path);
+
+  dataset = std::shared_ptr<const Dataset>(new Dataset(path));
+  datasets[path] = dataset;
+
+  // samples read by replicas of all nodes
+  Topology::interleave(dataset->_file.data(), dataset->_file.size());
+
+  return dataset;
+}
+
+} /* namespace */
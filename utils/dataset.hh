@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_DATASET_H_
+#define _SEEGNIFY_DATASET_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "main/types.hh"
+
+namespace seegnify {
+
+// Read-only memory mapped file
+class MappedFile
+{
+public:
+  MappedFile(const std::string& path);
+
+  ~MappedFile();
+
+  const char* data() const { return _data; }
+
+  size_t size() const { return _size; }
+
+private:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* _data;
+  size_t _size;
+};
+
+// Labeled samples in a binary layout mapped read-only from disk.
+// Layout: 64 byte header, DTYPE inputs [size x features], int32 labels [size]
+class Dataset
+{
+public:
+  Dataset(const std::string& path);
+
+  // number of samples
+  int size() const { return _size; }
+
+  // number of input features per sample
+  int features() const { return _features; }
+
+  // sample input
+  ConstRowVectorMap input(int i) const
+  {
+    return ConstRowVectorMap(_inputs + (size_t)i * _features, _features);
+  }
+
+  // sample label
+  int label(int i) const { return _labels[i]; }
+
+  // convert samples to binary layout
+  static void write(const std::string& path,
+  const std::vector<std::vector<DTYPE>>& inputs,
+  const std::vector<uint8_t>& labels);
+
+  // get dataset mapped once per process, convert with callback if missing
+  static std::shared_ptr<const Dataset> shared(const std::string& path,
+  const std::function<void(const std::string&)>& convert);
+
+private:
+  MappedFile _file;
+  const DTYPE* _inputs;
+  const int32_t* _labels;
+  int _size;
+  int _features;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_DATASET_H_ */
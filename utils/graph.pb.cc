@@ -23,7 +23,14 @@ namespace _pbi = _pb::internal;
 namespace seegnify {
 namespace graph {
 PROTOBUF_CONSTEXPR GetWeights::GetWeights(
-    ::_pbi::ConstantInitialized) {}
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.since_version_)*/{}
+  , /*decltype(_impl_._since_version_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.worker_)*/uint64_t{0u}
+  , /*decltype(_impl_.clock_)*/uint64_t{0u}
+  , /*decltype(_impl_.precision_)*/0u} {}
 struct GetWeightsDefaultTypeInternal {
   PROTOBUF_CONSTEXPR GetWeightsDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -37,7 +44,10 @@ PROTOBUF_CONSTEXPR GetWeightsResponse::GetWeightsResponse(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_._has_bits_)*/{}
   , /*decltype(_impl_._cached_size_)*/{}
-  , /*decltype(_impl_.weights_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}} {}
+  , /*decltype(_impl_.version_)*/{}
+  , /*decltype(_impl_._version_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.updates_)*/uint64_t{0u}
+  , /*decltype(_impl_.delta_)*/false} {}
 struct GetWeightsResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR GetWeightsResponseDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -48,10 +58,7 @@ struct GetWeightsResponseDefaultTypeInternal {
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GetWeightsResponseDefaultTypeInternal _GetWeightsResponse_default_instance_;
 PROTOBUF_CONSTEXPR SetWeights::SetWeights(
-    ::_pbi::ConstantInitialized): _impl_{
-    /*decltype(_impl_._has_bits_)*/{}
-  , /*decltype(_impl_._cached_size_)*/{}
-  , /*decltype(_impl_.weights_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}} {}
+    ::_pbi::ConstantInitialized) {}
 struct SetWeightsDefaultTypeInternal {
   PROTOBUF_CONSTEXPR SetWeightsDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -65,7 +72,12 @@ PROTOBUF_CONSTEXPR UpdWeights::UpdWeights(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_._has_bits_)*/{}
   , /*decltype(_impl_._cached_size_)*/{}
-  , /*decltype(_impl_.update_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}} {}
+  , /*decltype(_impl_.worker_)*/uint64_t{0u}
+  , /*decltype(_impl_.clock_)*/uint64_t{0u}
+  , /*decltype(_impl_.updates_)*/uint64_t{0u}
+  , /*decltype(_impl_.compute_seconds_)*/0
+  , /*decltype(_impl_.comm_seconds_)*/0
+  , /*decltype(_impl_.compression_)*/0u} {}
 struct UpdWeightsDefaultTypeInternal {
   PROTOBUF_CONSTEXPR UpdWeightsDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -75,8 +87,112 @@ struct UpdWeightsDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 UpdWeightsDefaultTypeInternal _UpdWeights_default_instance_;
-PROTOBUF_CONSTEXPR SuccessResponse::SuccessResponse(
+PROTOBUF_CONSTEXPR GetStats::GetStats(
+    ::_pbi::ConstantInitialized) {}
+struct GetStatsDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GetStatsDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GetStatsDefaultTypeInternal() {}
+  union {
+    GetStats _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GetStatsDefaultTypeInternal _GetStats_default_instance_;
+PROTOBUF_CONSTEXPR RequestStats::RequestStats(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.latency_)*/{}
+  , /*decltype(_impl_._latency_cached_byte_size_)*/{0}
+  , /*decltype(_impl_.name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.count_)*/uint64_t{0u}
+  , /*decltype(_impl_.bytes_in_)*/uint64_t{0u}
+  , /*decltype(_impl_.bytes_out_)*/uint64_t{0u}} {}
+struct RequestStatsDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR RequestStatsDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~RequestStatsDefaultTypeInternal() {}
+  union {
+    RequestStats _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RequestStatsDefaultTypeInternal _RequestStats_default_instance_;
+PROTOBUF_CONSTEXPR WorkerStats::WorkerStats(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.worker_)*/uint64_t{0u}
+  , /*decltype(_impl_.clock_)*/uint64_t{0u}
+  , /*decltype(_impl_.staleness_)*/uint64_t{0u}
+  , /*decltype(_impl_.idle_seconds_)*/0
+  , /*decltype(_impl_.compute_seconds_)*/0
+  , /*decltype(_impl_.comm_seconds_)*/0} {}
+struct WorkerStatsDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR WorkerStatsDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~WorkerStatsDefaultTypeInternal() {}
+  union {
+    WorkerStats _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 WorkerStatsDefaultTypeInternal _WorkerStats_default_instance_;
+PROTOBUF_CONSTEXPR GetStatsResponse::GetStatsResponse(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.request_)*/{}
+  , /*decltype(_impl_.worker_)*/{}
+  , /*decltype(_impl_.uptime_seconds_)*/0
+  , /*decltype(_impl_.updates_)*/uint64_t{0u}
+  , /*decltype(_impl_.updates_per_second_)*/0
+  , /*decltype(_impl_.rejected_)*/uint64_t{0u}
+  , /*decltype(_impl_.bytes_in_)*/uint64_t{0u}
+  , /*decltype(_impl_.bytes_out_)*/uint64_t{0u}
+  , /*decltype(_impl_.lock_wait_seconds_)*/0
+  , /*decltype(_impl_.checkpoints_)*/uint64_t{0u}
+  , /*decltype(_impl_.checkpoint_seconds_)*/0
+  , /*decltype(_impl_.predictions_)*/uint64_t{0u}
+  , /*decltype(_impl_.batches_)*/uint64_t{0u}
+  , /*decltype(_impl_.batch_rows_)*/0
+  , /*decltype(_impl_.latency_p50_seconds_)*/0
+  , /*decltype(_impl_.latency_p99_seconds_)*/0
+  , /*decltype(_impl_.workers_)*/0u} {}
+struct GetStatsResponseDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR GetStatsResponseDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~GetStatsResponseDefaultTypeInternal() {}
+  union {
+    GetStatsResponse _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 GetStatsResponseDefaultTypeInternal _GetStatsResponse_default_instance_;
+PROTOBUF_CONSTEXPR Predict::Predict(
+    ::_pbi::ConstantInitialized) {}
+struct PredictDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PredictDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PredictDefaultTypeInternal() {}
+  union {
+    Predict _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PredictDefaultTypeInternal _Predict_default_instance_;
+PROTOBUF_CONSTEXPR PredictResponse::PredictResponse(
     ::_pbi::ConstantInitialized) {}
+struct PredictResponseDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR PredictResponseDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~PredictResponseDefaultTypeInternal() {}
+  union {
+    PredictResponse _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 PredictResponseDefaultTypeInternal _PredictResponse_default_instance_;
+PROTOBUF_CONSTEXPR SuccessResponse::SuccessResponse(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.scale_)*/0} {}
 struct SuccessResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR SuccessResponseDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -103,8 +219,12 @@ struct ErrorResponseDefaultTypeInternal {
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ErrorResponseDefaultTypeInternal _ErrorResponse_default_instance_;
 PROTOBUF_CONSTEXPR Request::Request(
     ::_pbi::ConstantInitialized): _impl_{
-    /*decltype(_impl_.request_)*/{}
+    /*decltype(_impl_._has_bits_)*/{}
   , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/uint64_t{0u}
+  , /*decltype(_impl_.payload_)*/false
+  , /*decltype(_impl_.deflate_)*/false
+  , /*decltype(_impl_.request_)*/{}
   , /*decltype(_impl_._oneof_case_)*/{}} {}
 struct RequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR RequestDefaultTypeInternal()
@@ -117,8 +237,12 @@ struct RequestDefaultTypeInternal {
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 RequestDefaultTypeInternal _Request_default_instance_;
 PROTOBUF_CONSTEXPR Response::Response(
     ::_pbi::ConstantInitialized): _impl_{
-    /*decltype(_impl_.response_)*/{}
+    /*decltype(_impl_._has_bits_)*/{}
   , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.id_)*/uint64_t{0u}
+  , /*decltype(_impl_.payload_)*/false
+  , /*decltype(_impl_.deflate_)*/false
+  , /*decltype(_impl_.response_)*/{}
   , /*decltype(_impl_._oneof_case_)*/{}} {}
 struct ResponseDefaultTypeInternal {
   PROTOBUF_CONSTEXPR ResponseDefaultTypeInternal()
@@ -131,47 +255,161 @@ struct ResponseDefaultTypeInternal {
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ResponseDefaultTypeInternal _Response_default_instance_;
 }  // namespace graph
 }  // namespace seegnify
-static ::_pb::Metadata file_level_metadata_graph_2eproto[8];
+static ::_pb::Metadata file_level_metadata_graph_2eproto[14];
 static constexpr ::_pb::EnumDescriptor const** file_level_enum_descriptors_graph_2eproto = nullptr;
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_graph_2eproto = nullptr;
 
 const uint32_t TableStruct_graph_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeights, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeights, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeights, _impl_.since_version_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeights, _impl_.worker_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeights, _impl_.clock_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeights, _impl_.precision_),
+  ~0u,
+  0,
+  1,
+  2,
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeightsResponse, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeightsResponse, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
-  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeightsResponse, _impl_.weights_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeightsResponse, _impl_.version_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeightsResponse, _impl_.delta_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetWeightsResponse, _impl_.updates_),
+  ~0u,
+  1,
   0,
-  PROTOBUF_FIELD_OFFSET(::seegnify::graph::SetWeights, _impl_._has_bits_),
+  ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::SetWeights, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
-  PROTOBUF_FIELD_OFFSET(::seegnify::graph::SetWeights, _impl_.weights_),
-  0,
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
-  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.update_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.compression_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.worker_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.clock_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.updates_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.compute_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::UpdWeights, _impl_.comm_seconds_),
+  5,
+  0,
+  1,
+  2,
+  3,
+  4,
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStats, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _impl_.name_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _impl_.count_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _impl_.bytes_in_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _impl_.bytes_out_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::RequestStats, _impl_.latency_),
+  0,
+  1,
+  2,
+  3,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_.worker_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_.clock_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_.staleness_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_.idle_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_.compute_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::WorkerStats, _impl_.comm_seconds_),
+  0,
+  1,
+  2,
+  3,
+  4,
+  5,
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.uptime_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.updates_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.updates_per_second_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.rejected_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.bytes_in_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.bytes_out_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.request_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.lock_wait_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.checkpoints_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.checkpoint_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.workers_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.worker_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.predictions_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.batches_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.batch_rows_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.latency_p50_seconds_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::GetStatsResponse, _impl_.latency_p99_seconds_),
   0,
+  1,
+  2,
+  3,
+  4,
+  5,
+  ~0u,
+  6,
+  7,
+  8,
+  14,
+  ~0u,
+  9,
+  10,
+  11,
+  12,
+  13,
   ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Predict, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::PredictResponse, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::SuccessResponse, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::SuccessResponse, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::SuccessResponse, _impl_.scale_),
+  0,
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::ErrorResponse, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::ErrorResponse, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -182,36 +420,68 @@ const uint32_t TableStruct_graph_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(pr
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::ErrorResponse, _impl_.message_),
   1,
   0,
-  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _internal_metadata_),
   ~0u,  // no _extensions_
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _impl_._oneof_case_[0]),
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _impl_.payload_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _impl_.deflate_),
+  ::_pbi::kInvalidFieldOffsetTag,
+  ::_pbi::kInvalidFieldOffsetTag,
   ::_pbi::kInvalidFieldOffsetTag,
   ::_pbi::kInvalidFieldOffsetTag,
   ::_pbi::kInvalidFieldOffsetTag,
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::Request, _impl_.request_),
-  ~0u,  // no _has_bits_
+  0,
+  1,
+  2,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _internal_metadata_),
   ~0u,  // no _extensions_
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _impl_._oneof_case_[0]),
   ~0u,  // no _weak_field_map_
   ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _impl_.id_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _impl_.payload_),
+  PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _impl_.deflate_),
+  ::_pbi::kInvalidFieldOffsetTag,
+  ::_pbi::kInvalidFieldOffsetTag,
   ::_pbi::kInvalidFieldOffsetTag,
   ::_pbi::kInvalidFieldOffsetTag,
   ::_pbi::kInvalidFieldOffsetTag,
   PROTOBUF_FIELD_OFFSET(::seegnify::graph::Response, _impl_.response_),
+  0,
+  1,
+  2,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
+  ~0u,
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  { 0, -1, -1, sizeof(::seegnify::graph::GetWeights)},
-  { 6, 13, -1, sizeof(::seegnify::graph::GetWeightsResponse)},
-  { 14, 21, -1, sizeof(::seegnify::graph::SetWeights)},
-  { 22, 29, -1, sizeof(::seegnify::graph::UpdWeights)},
-  { 30, -1, -1, sizeof(::seegnify::graph::SuccessResponse)},
-  { 36, 44, -1, sizeof(::seegnify::graph::ErrorResponse)},
-  { 46, -1, -1, sizeof(::seegnify::graph::Request)},
-  { 56, -1, -1, sizeof(::seegnify::graph::Response)},
+  { 0, 10, -1, sizeof(::seegnify::graph::GetWeights)},
+  { 14, 23, -1, sizeof(::seegnify::graph::GetWeightsResponse)},
+  { 26, -1, -1, sizeof(::seegnify::graph::SetWeights)},
+  { 32, 44, -1, sizeof(::seegnify::graph::UpdWeights)},
+  { 50, -1, -1, sizeof(::seegnify::graph::GetStats)},
+  { 56, 67, -1, sizeof(::seegnify::graph::RequestStats)},
+  { 72, 84, -1, sizeof(::seegnify::graph::WorkerStats)},
+  { 90, 113, -1, sizeof(::seegnify::graph::GetStatsResponse)},
+  { 130, -1, -1, sizeof(::seegnify::graph::Predict)},
+  { 136, -1, -1, sizeof(::seegnify::graph::PredictResponse)},
+  { 142, 149, -1, sizeof(::seegnify::graph::SuccessResponse)},
+  { 150, 158, -1, sizeof(::seegnify::graph::ErrorResponse)},
+  { 160, 175, -1, sizeof(::seegnify::graph::Request)},
+  { 183, 198, -1, sizeof(::seegnify::graph::Response)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -219,6 +489,12 @@ static const ::_pb::Message* const file_default_instances[] = {
   &::seegnify::graph::_GetWeightsResponse_default_instance_._instance,
   &::seegnify::graph::_SetWeights_default_instance_._instance,
   &::seegnify::graph::_UpdWeights_default_instance_._instance,
+  &::seegnify::graph::_GetStats_default_instance_._instance,
+  &::seegnify::graph::_RequestStats_default_instance_._instance,
+  &::seegnify::graph::_WorkerStats_default_instance_._instance,
+  &::seegnify::graph::_GetStatsResponse_default_instance_._instance,
+  &::seegnify::graph::_Predict_default_instance_._instance,
+  &::seegnify::graph::_PredictResponse_default_instance_._instance,
   &::seegnify::graph::_SuccessResponse_default_instance_._instance,
   &::seegnify::graph::_ErrorResponse_default_instance_._instance,
   &::seegnify::graph::_Request_default_instance_._instance,
@@ -226,27 +502,58 @@ static const ::_pb::Message* const file_default_instances[] = {
 };
 
 const char descriptor_table_protodef_graph_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\013graph.proto\022\016seegnify.graph\"\014\n\nGetWeig"
-  "hts\"%\n\022GetWeightsResponse\022\017\n\007weights\030\001 \002"
-  "(\014\"\035\n\nSetWeights\022\017\n\007weights\030\001 \002(\014\"\034\n\nUpd"
-  "Weights\022\016\n\006update\030\001 \002(\014\"\021\n\017SuccessRespon"
-  "se\"0\n\rErrorResponse\022\016\n\006status\030\001 \002(\r\022\017\n\007m"
-  "essage\030\002 \002(\t\"\255\001\n\007Request\0221\n\013get_weights\030"
-  "\n \001(\0132\032.seegnify.graph.GetWeightsH\000\0221\n\013s"
-  "et_weights\030\013 \001(\0132\032.seegnify.graph.SetWei"
-  "ghtsH\000\0221\n\013upd_weights\030\014 \001(\0132\032.seegnify.g"
-  "raph.UpdWeightsH\000B\t\n\007request\"\265\001\n\010Respons"
-  "e\0229\n\013get_weights\030\013 \001(\0132\".seegnify.graph."
-  "GetWeightsResponseH\000\0222\n\007success\030\014 \001(\0132\037."
-  "seegnify.graph.SuccessResponseH\000\022.\n\005erro"
-  "r\030\r \001(\0132\035.seegnify.graph.ErrorResponseH\000"
-  "B\n\n\010response"
+  "\n\013graph.proto\022\016seegnify.graph\"Y\n\nGetWeig"
+  "hts\022\031\n\rsince_version\030\001 \003(\004B\002\020\001\022\016\n\006worker"
+  "\030\002 \001(\004\022\r\n\005clock\030\003 \001(\004\022\021\n\tprecision\030\004 \001(\r"
+  "\"O\n\022GetWeightsResponse\022\023\n\007version\030\002 \003(\004B"
+  "\002\020\001\022\r\n\005delta\030\003 \001(\010\022\017\n\007updates\030\004 \001(\004J\004\010\001\020"
+  "\002\"\022\n\nSetWeightsJ\004\010\001\020\002\"\206\001\n\nUpdWeights\022\023\n\013"
+  "compression\030\002 \001(\r\022\016\n\006worker\030\003 \001(\004\022\r\n\005clo"
+  "ck\030\004 \001(\004\022\017\n\007updates\030\005 \001(\004\022\027\n\017compute_sec"
+  "onds\030\006 \001(\001\022\024\n\014comm_seconds\030\007 \001(\001J\004\010\001\020\002\"\n"
+  "\n\010GetStats\"e\n\014RequestStats\022\014\n\004name\030\001 \002(\t"
+  "\022\r\n\005count\030\002 \001(\004\022\020\n\010bytes_in\030\003 \001(\004\022\021\n\tbyt"
+  "es_out\030\004 \001(\004\022\023\n\007latency\030\005 \003(\004B\002\020\001\"\204\001\n\013Wo"
+  "rkerStats\022\016\n\006worker\030\001 \002(\004\022\r\n\005clock\030\002 \001(\004"
+  "\022\021\n\tstaleness\030\003 \001(\004\022\024\n\014idle_seconds\030\004 \001("
+  "\001\022\027\n\017compute_seconds\030\005 \001(\001\022\024\n\014comm_secon"
+  "ds\030\006 \001(\001\"\273\003\n\020GetStatsResponse\022\026\n\016uptime_"
+  "seconds\030\001 \001(\001\022\017\n\007updates\030\002 \001(\004\022\032\n\022update"
+  "s_per_second\030\003 \001(\001\022\020\n\010rejected\030\004 \001(\004\022\020\n\010"
+  "bytes_in\030\005 \001(\004\022\021\n\tbytes_out\030\006 \001(\004\022-\n\007req"
+  "uest\030\007 \003(\0132\034.seegnify.graph.RequestStats"
+  "\022\031\n\021lock_wait_seconds\030\010 \001(\001\022\023\n\013checkpoin"
+  "ts\030\t \001(\004\022\032\n\022checkpoint_seconds\030\n \001(\001\022\017\n\007"
+  "workers\030\013 \001(\r\022+\n\006worker\030\014 \003(\0132\033.seegnify"
+  ".graph.WorkerStats\022\023\n\013predictions\030\r \001(\004\022"
+  "\017\n\007batches\030\016 \001(\004\022\022\n\nbatch_rows\030\017 \001(\001\022\033\n\023"
+  "latency_p50_seconds\030\020 \001(\001\022\033\n\023latency_p99"
+  "_seconds\030\021 \001(\001\"\t\n\007Predict\"\021\n\017PredictResp"
+  "onse\" \n\017SuccessResponse\022\r\n\005scale\030\001 \001(\002\"0"
+  "\n\rErrorResponse\022\016\n\006status\030\001 \002(\r\022\017\n\007messa"
+  "ge\030\002 \002(\t\"\266\002\n\007Request\022\n\n\002id\030\001 \001(\004\022\017\n\007payl"
+  "oad\030\002 \001(\010\022\017\n\007deflate\030\003 \001(\010\0221\n\013get_weight"
+  "s\030\n \001(\0132\032.seegnify.graph.GetWeightsH\000\0221\n"
+  "\013set_weights\030\013 \001(\0132\032.seegnify.graph.SetW"
+  "eightsH\000\0221\n\013upd_weights\030\014 \001(\0132\032.seegnify"
+  ".graph.UpdWeightsH\000\022-\n\tget_stats\030\r \001(\0132\030"
+  ".seegnify.graph.GetStatsH\000\022*\n\007predict\030\016 "
+  "\001(\0132\027.seegnify.graph.PredictH\000B\t\n\007reques"
+  "t\"\316\002\n\010Response\022\n\n\002id\030\001 \001(\004\022\017\n\007payload\030\002 "
+  "\001(\010\022\017\n\007deflate\030\003 \001(\010\0229\n\013get_weights\030\013 \001("
+  "\0132\".seegnify.graph.GetWeightsResponseH\000\022"
+  "2\n\007success\030\014 \001(\0132\037.seegnify.graph.Succes"
+  "sResponseH\000\022.\n\005error\030\r \001(\0132\035.seegnify.gr"
+  "aph.ErrorResponseH\000\0225\n\tget_stats\030\016 \001(\0132 "
+  ".seegnify.graph.GetStatsResponseH\000\0222\n\007pr"
+  "edict\030\017 \001(\0132\037.seegnify.graph.PredictResp"
+  "onseH\000B\n\n\010response"
   ;
 static ::_pbi::once_flag descriptor_table_graph_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_graph_2eproto = {
-    false, false, 572, descriptor_table_protodef_graph_2eproto,
+    false, false, 1818, descriptor_table_protodef_graph_2eproto,
     "graph.proto",
-    &descriptor_table_graph_2eproto_once, nullptr, 0, 8,
+    &descriptor_table_graph_2eproto_once, nullptr, 0, 14,
     schemas, file_default_instances, TableStruct_graph_2eproto::offsets,
     file_level_metadata_graph_2eproto, file_level_enum_descriptors_graph_2eproto,
     file_level_service_descriptors_graph_2eproto,
@@ -264,98 +571,60 @@ namespace graph {
 
 class GetWeights::_Internal {
  public:
-};
-
-GetWeights::GetWeights(::PROTOBUF_NAMESPACE_ID::Arena* arena,
-                         bool is_message_owned)
-  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
-  // @@protoc_insertion_point(arena_constructor:seegnify.graph.GetWeights)
-}
-GetWeights::GetWeights(const GetWeights& from)
-  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
-  GetWeights* const _this = this; (void)_this;
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  // @@protoc_insertion_point(copy_constructor:seegnify.graph.GetWeights)
-}
-
-
-
-
-
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetWeights::_class_data_ = {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
-};
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetWeights::GetClassData() const { return &_class_data_; }
-
-
-
-
-
-
-
-::PROTOBUF_NAMESPACE_ID::Metadata GetWeights::GetMetadata() const {
-  return ::_pbi::AssignDescriptors(
-      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[0]);
-}
-
-// ===================================================================
-
-class GetWeightsResponse::_Internal {
- public:
-  using HasBits = decltype(std::declval<GetWeightsResponse>()._impl_._has_bits_);
-  static void set_has_weights(HasBits* has_bits) {
+  using HasBits = decltype(std::declval<GetWeights>()._impl_._has_bits_);
+  static void set_has_worker(HasBits* has_bits) {
     (*has_bits)[0] |= 1u;
   }
-  static bool MissingRequiredFields(const HasBits& has_bits) {
-    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  static void set_has_clock(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_precision(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
   }
 };
 
-GetWeightsResponse::GetWeightsResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+GetWeights::GetWeights(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
   SharedCtor(arena, is_message_owned);
-  // @@protoc_insertion_point(arena_constructor:seegnify.graph.GetWeightsResponse)
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.GetWeights)
 }
-GetWeightsResponse::GetWeightsResponse(const GetWeightsResponse& from)
+GetWeights::GetWeights(const GetWeights& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
-  GetWeightsResponse* const _this = this; (void)_this;
+  GetWeights* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_._has_bits_){from._impl_._has_bits_}
     , /*decltype(_impl_._cached_size_)*/{}
-    , decltype(_impl_.weights_){}};
+    , decltype(_impl_.since_version_){from._impl_.since_version_}
+    , /*decltype(_impl_._since_version_cached_byte_size_)*/{0}
+    , decltype(_impl_.worker_){}
+    , decltype(_impl_.clock_){}
+    , decltype(_impl_.precision_){}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  _impl_.weights_.InitDefault();
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (from._internal_has_weights()) {
-    _this->_impl_.weights_.Set(from._internal_weights(), 
-      _this->GetArenaForAllocation());
-  }
-  // @@protoc_insertion_point(copy_constructor:seegnify.graph.GetWeightsResponse)
+  ::memcpy(&_impl_.worker_, &from._impl_.worker_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.precision_) -
+    reinterpret_cast<char*>(&_impl_.worker_)) + sizeof(_impl_.precision_));
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.GetWeights)
 }
 
-inline void GetWeightsResponse::SharedCtor(
+inline void GetWeights::SharedCtor(
     ::_pb::Arena* arena, bool is_message_owned) {
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_._has_bits_){}
     , /*decltype(_impl_._cached_size_)*/{}
-    , decltype(_impl_.weights_){}
+    , decltype(_impl_.since_version_){arena}
+    , /*decltype(_impl_._since_version_cached_byte_size_)*/{0}
+    , decltype(_impl_.worker_){uint64_t{0u}}
+    , decltype(_impl_.clock_){uint64_t{0u}}
+    , decltype(_impl_.precision_){0u}
   };
-  _impl_.weights_.InitDefault();
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
-GetWeightsResponse::~GetWeightsResponse() {
-  // @@protoc_insertion_point(destructor:seegnify.graph.GetWeightsResponse)
+GetWeights::~GetWeights() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.GetWeights)
   if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
   (void)arena;
     return;
@@ -363,41 +632,73 @@ GetWeightsResponse::~GetWeightsResponse() {
   SharedDtor();
 }
 
-inline void GetWeightsResponse::SharedDtor() {
+inline void GetWeights::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  _impl_.weights_.Destroy();
+  _impl_.since_version_.~RepeatedField();
 }
 
-void GetWeightsResponse::SetCachedSize(int size) const {
+void GetWeights::SetCachedSize(int size) const {
   _impl_._cached_size_.Set(size);
 }
 
-void GetWeightsResponse::Clear() {
-// @@protoc_insertion_point(message_clear_start:seegnify.graph.GetWeightsResponse)
+void GetWeights::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.GetWeights)
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  _impl_.since_version_.Clear();
   cached_has_bits = _impl_._has_bits_[0];
-  if (cached_has_bits & 0x00000001u) {
-    _impl_.weights_.ClearNonDefaultToEmpty();
+  if (cached_has_bits & 0x00000007u) {
+    ::memset(&_impl_.worker_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.precision_) -
+        reinterpret_cast<char*>(&_impl_.worker_)) + sizeof(_impl_.precision_));
   }
   _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-const char* GetWeightsResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+const char* GetWeights::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
   _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
-      // required bytes weights = 1;
+      // repeated uint64 since_version = 1 [packed = true];
       case 1:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
-          auto str = _internal_mutable_weights();
-          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt64Parser(_internal_mutable_since_version(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 8) {
+          _internal_add_since_version(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 worker = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_worker(&has_bits);
+          _impl_.worker_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 clock = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_clock(&has_bits);
+          _impl_.clock_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint32 precision = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_precision(&has_bits);
+          _impl_.precision_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
           CHK_(ptr);
         } else
           goto handle_unusual;
@@ -426,151 +727,1700 @@ failure:
 #undef CHK_
 }
 
-uint8_t* GetWeightsResponse::_InternalSerialize(
+uint8_t* GetWeights::_InternalSerialize(
     uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.GetWeightsResponse)
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.GetWeights)
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
+  // repeated uint64 since_version = 1 [packed = true];
+  {
+    int byte_size = _impl_._since_version_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt64Packed(
+          1, _internal_since_version(), byte_size, target);
+    }
+  }
+
   cached_has_bits = _impl_._has_bits_[0];
-  // required bytes weights = 1;
+  // optional uint64 worker = 2;
   if (cached_has_bits & 0x00000001u) {
-    target = stream->WriteBytesMaybeAliased(
-        1, this->_internal_weights(), target);
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(2, this->_internal_worker(), target);
+  }
+
+  // optional uint64 clock = 3;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_clock(), target);
+  }
+
+  // optional uint32 precision = 4;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(4, this->_internal_precision(), target);
   }
 
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.GetWeightsResponse)
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.GetWeights)
   return target;
 }
 
-size_t GetWeightsResponse::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.GetWeightsResponse)
+size_t GetWeights::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.GetWeights)
   size_t total_size = 0;
 
-  // required bytes weights = 1;
-  if (_internal_has_weights()) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
-        this->_internal_weights());
-  }
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  // repeated uint64 since_version = 1 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt64Size(this->_impl_.since_version_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._since_version_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    // optional uint64 worker = 2;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_worker());
+    }
+
+    // optional uint64 clock = 3;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_clock());
+    }
+
+    // optional uint32 precision = 4;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_precision());
+    }
+
+  }
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetWeightsResponse::_class_data_ = {
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetWeights::_class_data_ = {
     ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
-    GetWeightsResponse::MergeImpl
+    GetWeights::MergeImpl
 };
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetWeightsResponse::GetClassData() const { return &_class_data_; }
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetWeights::GetClassData() const { return &_class_data_; }
 
 
-void GetWeightsResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
-  auto* const _this = static_cast<GetWeightsResponse*>(&to_msg);
-  auto& from = static_cast<const GetWeightsResponse&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.GetWeightsResponse)
+void GetWeights::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GetWeights*>(&to_msg);
+  auto& from = static_cast<const GetWeights&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.GetWeights)
   GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  if (from._internal_has_weights()) {
-    _this->_internal_set_weights(from._internal_weights());
+  _this->_impl_.since_version_.MergeFrom(from._impl_.since_version_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.worker_ = from._impl_.worker_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.clock_ = from._impl_.clock_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.precision_ = from._impl_.precision_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void GetWeightsResponse::CopyFrom(const GetWeightsResponse& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.GetWeightsResponse)
+void GetWeights::CopyFrom(const GetWeights& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.GetWeights)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool GetWeightsResponse::IsInitialized() const {
-  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+bool GetWeights::IsInitialized() const {
   return true;
 }
 
-void GetWeightsResponse::InternalSwap(GetWeightsResponse* other) {
+void GetWeights::InternalSwap(GetWeights* other) {
   using std::swap;
-  auto* lhs_arena = GetArenaForAllocation();
-  auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &_impl_.weights_, lhs_arena,
-      &other->_impl_.weights_, rhs_arena
-  );
+  _impl_.since_version_.InternalSwap(&other->_impl_.since_version_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(GetWeights, _impl_.precision_)
+      + sizeof(GetWeights::_impl_.precision_)
+      - PROTOBUF_FIELD_OFFSET(GetWeights, _impl_.worker_)>(
+          reinterpret_cast<char*>(&_impl_.worker_),
+          reinterpret_cast<char*>(&other->_impl_.worker_));
 }
 
-::PROTOBUF_NAMESPACE_ID::Metadata GetWeightsResponse::GetMetadata() const {
+::PROTOBUF_NAMESPACE_ID::Metadata GetWeights::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[1]);
+      file_level_metadata_graph_2eproto[0]);
 }
 
 // ===================================================================
 
-class SetWeights::_Internal {
+class GetWeightsResponse::_Internal {
  public:
-  using HasBits = decltype(std::declval<SetWeights>()._impl_._has_bits_);
-  static void set_has_weights(HasBits* has_bits) {
-    (*has_bits)[0] |= 1u;
+  using HasBits = decltype(std::declval<GetWeightsResponse>()._impl_._has_bits_);
+  static void set_has_delta(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
   }
-  static bool MissingRequiredFields(const HasBits& has_bits) {
-    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  static void set_has_updates(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
   }
 };
 
-SetWeights::SetWeights(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+GetWeightsResponse::GetWeightsResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
   SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.GetWeightsResponse)
+}
+GetWeightsResponse::GetWeightsResponse(const GetWeightsResponse& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  GetWeightsResponse* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.version_){from._impl_.version_}
+    , /*decltype(_impl_._version_cached_byte_size_)*/{0}
+    , decltype(_impl_.updates_){}
+    , decltype(_impl_.delta_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.updates_, &from._impl_.updates_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.delta_) -
+    reinterpret_cast<char*>(&_impl_.updates_)) + sizeof(_impl_.delta_));
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.GetWeightsResponse)
+}
+
+inline void GetWeightsResponse::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.version_){arena}
+    , /*decltype(_impl_._version_cached_byte_size_)*/{0}
+    , decltype(_impl_.updates_){uint64_t{0u}}
+    , decltype(_impl_.delta_){false}
+  };
+}
+
+GetWeightsResponse::~GetWeightsResponse() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.GetWeightsResponse)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void GetWeightsResponse::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.version_.~RepeatedField();
+}
+
+void GetWeightsResponse::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void GetWeightsResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.GetWeightsResponse)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.version_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    ::memset(&_impl_.updates_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.delta_) -
+        reinterpret_cast<char*>(&_impl_.updates_)) + sizeof(_impl_.delta_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* GetWeightsResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated uint64 version = 2 [packed = true];
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt64Parser(_internal_mutable_version(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 16) {
+          _internal_add_version(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool delta = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_delta(&has_bits);
+          _impl_.delta_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 updates = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_updates(&has_bits);
+          _impl_.updates_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* GetWeightsResponse::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.GetWeightsResponse)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated uint64 version = 2 [packed = true];
+  {
+    int byte_size = _impl_._version_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt64Packed(
+          2, _internal_version(), byte_size, target);
+    }
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional bool delta = 3;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_delta(), target);
+  }
+
+  // optional uint64 updates = 4;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_updates(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.GetWeightsResponse)
+  return target;
+}
+
+size_t GetWeightsResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.GetWeightsResponse)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated uint64 version = 2 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt64Size(this->_impl_.version_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._version_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    // optional uint64 updates = 4;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_updates());
+    }
+
+    // optional bool delta = 3;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 1;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetWeightsResponse::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    GetWeightsResponse::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetWeightsResponse::GetClassData() const { return &_class_data_; }
+
+
+void GetWeightsResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GetWeightsResponse*>(&to_msg);
+  auto& from = static_cast<const GetWeightsResponse&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.GetWeightsResponse)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.version_.MergeFrom(from._impl_.version_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000003u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.updates_ = from._impl_.updates_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.delta_ = from._impl_.delta_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void GetWeightsResponse::CopyFrom(const GetWeightsResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.GetWeightsResponse)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool GetWeightsResponse::IsInitialized() const {
+  return true;
+}
+
+void GetWeightsResponse::InternalSwap(GetWeightsResponse* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.version_.InternalSwap(&other->_impl_.version_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(GetWeightsResponse, _impl_.delta_)
+      + sizeof(GetWeightsResponse::_impl_.delta_)
+      - PROTOBUF_FIELD_OFFSET(GetWeightsResponse, _impl_.updates_)>(
+          reinterpret_cast<char*>(&_impl_.updates_),
+          reinterpret_cast<char*>(&other->_impl_.updates_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata GetWeightsResponse::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[1]);
+}
+
+// ===================================================================
+
+class SetWeights::_Internal {
+ public:
+};
+
+SetWeights::SetWeights(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
   // @@protoc_insertion_point(arena_constructor:seegnify.graph.SetWeights)
 }
-SetWeights::SetWeights(const SetWeights& from)
+SetWeights::SetWeights(const SetWeights& from)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
+  SetWeights* const _this = this; (void)_this;
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.SetWeights)
+}
+
+
+
+
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SetWeights::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SetWeights::GetClassData() const { return &_class_data_; }
+
+
+
+
+
+
+
+::PROTOBUF_NAMESPACE_ID::Metadata SetWeights::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[2]);
+}
+
+// ===================================================================
+
+class UpdWeights::_Internal {
+ public:
+  using HasBits = decltype(std::declval<UpdWeights>()._impl_._has_bits_);
+  static void set_has_compression(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_worker(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_clock(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_updates(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_compute_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_comm_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+};
+
+UpdWeights::UpdWeights(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.UpdWeights)
+}
+UpdWeights::UpdWeights(const UpdWeights& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  UpdWeights* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.worker_){}
+    , decltype(_impl_.clock_){}
+    , decltype(_impl_.updates_){}
+    , decltype(_impl_.compute_seconds_){}
+    , decltype(_impl_.comm_seconds_){}
+    , decltype(_impl_.compression_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.worker_, &from._impl_.worker_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.compression_) -
+    reinterpret_cast<char*>(&_impl_.worker_)) + sizeof(_impl_.compression_));
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.UpdWeights)
+}
+
+inline void UpdWeights::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.worker_){uint64_t{0u}}
+    , decltype(_impl_.clock_){uint64_t{0u}}
+    , decltype(_impl_.updates_){uint64_t{0u}}
+    , decltype(_impl_.compute_seconds_){0}
+    , decltype(_impl_.comm_seconds_){0}
+    , decltype(_impl_.compression_){0u}
+  };
+}
+
+UpdWeights::~UpdWeights() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.UpdWeights)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void UpdWeights::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void UpdWeights::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void UpdWeights::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.UpdWeights)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    ::memset(&_impl_.worker_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.compression_) -
+        reinterpret_cast<char*>(&_impl_.worker_)) + sizeof(_impl_.compression_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* UpdWeights::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // optional uint32 compression = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_compression(&has_bits);
+          _impl_.compression_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 worker = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_worker(&has_bits);
+          _impl_.worker_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 clock = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_clock(&has_bits);
+          _impl_.clock_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 updates = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_updates(&has_bits);
+          _impl_.updates_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double compute_seconds = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 49)) {
+          _Internal::set_has_compute_seconds(&has_bits);
+          _impl_.compute_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double comm_seconds = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 57)) {
+          _Internal::set_has_comm_seconds(&has_bits);
+          _impl_.comm_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* UpdWeights::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.UpdWeights)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional uint32 compression = 2;
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(2, this->_internal_compression(), target);
+  }
+
+  // optional uint64 worker = 3;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_worker(), target);
+  }
+
+  // optional uint64 clock = 4;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_clock(), target);
+  }
+
+  // optional uint64 updates = 5;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(5, this->_internal_updates(), target);
+  }
+
+  // optional double compute_seconds = 6;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(6, this->_internal_compute_seconds(), target);
+  }
+
+  // optional double comm_seconds = 7;
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(7, this->_internal_comm_seconds(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.UpdWeights)
+  return target;
+}
+
+size_t UpdWeights::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.UpdWeights)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    // optional uint64 worker = 3;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_worker());
+    }
+
+    // optional uint64 clock = 4;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_clock());
+    }
+
+    // optional uint64 updates = 5;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_updates());
+    }
+
+    // optional double compute_seconds = 6;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double comm_seconds = 7;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += 1 + 8;
+    }
+
+    // optional uint32 compression = 2;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_compression());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData UpdWeights::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    UpdWeights::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*UpdWeights::GetClassData() const { return &_class_data_; }
+
+
+void UpdWeights::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<UpdWeights*>(&to_msg);
+  auto& from = static_cast<const UpdWeights&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.UpdWeights)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.worker_ = from._impl_.worker_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.clock_ = from._impl_.clock_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.updates_ = from._impl_.updates_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.compute_seconds_ = from._impl_.compute_seconds_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.comm_seconds_ = from._impl_.comm_seconds_;
+    }
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.compression_ = from._impl_.compression_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void UpdWeights::CopyFrom(const UpdWeights& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.UpdWeights)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool UpdWeights::IsInitialized() const {
+  return true;
+}
+
+void UpdWeights::InternalSwap(UpdWeights* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(UpdWeights, _impl_.compression_)
+      + sizeof(UpdWeights::_impl_.compression_)
+      - PROTOBUF_FIELD_OFFSET(UpdWeights, _impl_.worker_)>(
+          reinterpret_cast<char*>(&_impl_.worker_),
+          reinterpret_cast<char*>(&other->_impl_.worker_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata UpdWeights::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[3]);
+}
+
+// ===================================================================
+
+class GetStats::_Internal {
+ public:
+};
+
+GetStats::GetStats(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.GetStats)
+}
+GetStats::GetStats(const GetStats& from)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
+  GetStats* const _this = this; (void)_this;
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.GetStats)
+}
+
+
+
+
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetStats::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetStats::GetClassData() const { return &_class_data_; }
+
+
+
+
+
+
+
+::PROTOBUF_NAMESPACE_ID::Metadata GetStats::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[4]);
+}
+
+// ===================================================================
+
+class RequestStats::_Internal {
+ public:
+  using HasBits = decltype(std::declval<RequestStats>()._impl_._has_bits_);
+  static void set_has_name(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_count(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_bytes_in(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_bytes_out(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+RequestStats::RequestStats(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.RequestStats)
+}
+RequestStats::RequestStats(const RequestStats& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  RequestStats* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.latency_){from._impl_.latency_}
+    , /*decltype(_impl_._latency_cached_byte_size_)*/{0}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.count_){}
+    , decltype(_impl_.bytes_in_){}
+    , decltype(_impl_.bytes_out_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_name()) {
+    _this->_impl_.name_.Set(from._internal_name(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.count_, &from._impl_.count_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.bytes_out_) -
+    reinterpret_cast<char*>(&_impl_.count_)) + sizeof(_impl_.bytes_out_));
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.RequestStats)
+}
+
+inline void RequestStats::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.latency_){arena}
+    , /*decltype(_impl_._latency_cached_byte_size_)*/{0}
+    , decltype(_impl_.name_){}
+    , decltype(_impl_.count_){uint64_t{0u}}
+    , decltype(_impl_.bytes_in_){uint64_t{0u}}
+    , decltype(_impl_.bytes_out_){uint64_t{0u}}
+  };
+  _impl_.name_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.name_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+RequestStats::~RequestStats() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.RequestStats)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void RequestStats::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.latency_.~RepeatedField();
+  _impl_.name_.Destroy();
+}
+
+void RequestStats::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void RequestStats::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.RequestStats)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.latency_.Clear();
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    _impl_.name_.ClearNonDefaultToEmpty();
+  }
+  if (cached_has_bits & 0x0000000eu) {
+    ::memset(&_impl_.count_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.bytes_out_) -
+        reinterpret_cast<char*>(&_impl_.count_)) + sizeof(_impl_.bytes_out_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* RequestStats::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required string name = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_name();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "seegnify.graph.RequestStats.name");
+          #endif  // !NDEBUG
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 count = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_count(&has_bits);
+          _impl_.count_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 bytes_in = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_bytes_in(&has_bits);
+          _impl_.bytes_in_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 bytes_out = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_bytes_out(&has_bits);
+          _impl_.bytes_out_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated uint64 latency = 5 [packed = true];
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedUInt64Parser(_internal_mutable_latency(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 40) {
+          _internal_add_latency(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr));
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* RequestStats::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.RequestStats)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required string name = 1;
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_name().data(), static_cast<int>(this->_internal_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "seegnify.graph.RequestStats.name");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_name(), target);
+  }
+
+  // optional uint64 count = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(2, this->_internal_count(), target);
+  }
+
+  // optional uint64 bytes_in = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_bytes_in(), target);
+  }
+
+  // optional uint64 bytes_out = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_bytes_out(), target);
+  }
+
+  // repeated uint64 latency = 5 [packed = true];
+  {
+    int byte_size = _impl_._latency_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteUInt64Packed(
+          5, _internal_latency(), byte_size, target);
+    }
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.RequestStats)
+  return target;
+}
+
+size_t RequestStats::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.RequestStats)
+  size_t total_size = 0;
+
+  // required string name = 1;
+  if (_internal_has_name()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_name());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated uint64 latency = 5 [packed = true];
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      UInt64Size(this->_impl_.latency_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._latency_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000eu) {
+    // optional uint64 count = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_count());
+    }
+
+    // optional uint64 bytes_in = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_bytes_in());
+    }
+
+    // optional uint64 bytes_out = 4;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_bytes_out());
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData RequestStats::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    RequestStats::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*RequestStats::GetClassData() const { return &_class_data_; }
+
+
+void RequestStats::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<RequestStats*>(&to_msg);
+  auto& from = static_cast<const RequestStats&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.RequestStats)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.latency_.MergeFrom(from._impl_.latency_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_name(from._internal_name());
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.count_ = from._impl_.count_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.bytes_in_ = from._impl_.bytes_in_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.bytes_out_ = from._impl_.bytes_out_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void RequestStats::CopyFrom(const RequestStats& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.RequestStats)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool RequestStats::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
+}
+
+void RequestStats::InternalSwap(RequestStats* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.latency_.InternalSwap(&other->_impl_.latency_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.name_, lhs_arena,
+      &other->_impl_.name_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(RequestStats, _impl_.bytes_out_)
+      + sizeof(RequestStats::_impl_.bytes_out_)
+      - PROTOBUF_FIELD_OFFSET(RequestStats, _impl_.count_)>(
+          reinterpret_cast<char*>(&_impl_.count_),
+          reinterpret_cast<char*>(&other->_impl_.count_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata RequestStats::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[5]);
+}
+
+// ===================================================================
+
+class WorkerStats::_Internal {
+ public:
+  using HasBits = decltype(std::declval<WorkerStats>()._impl_._has_bits_);
+  static void set_has_worker(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_clock(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_staleness(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_idle_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_compute_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_comm_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+WorkerStats::WorkerStats(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.WorkerStats)
+}
+WorkerStats::WorkerStats(const WorkerStats& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  WorkerStats* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.worker_){}
+    , decltype(_impl_.clock_){}
+    , decltype(_impl_.staleness_){}
+    , decltype(_impl_.idle_seconds_){}
+    , decltype(_impl_.compute_seconds_){}
+    , decltype(_impl_.comm_seconds_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.worker_, &from._impl_.worker_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.comm_seconds_) -
+    reinterpret_cast<char*>(&_impl_.worker_)) + sizeof(_impl_.comm_seconds_));
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.WorkerStats)
+}
+
+inline void WorkerStats::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.worker_){uint64_t{0u}}
+    , decltype(_impl_.clock_){uint64_t{0u}}
+    , decltype(_impl_.staleness_){uint64_t{0u}}
+    , decltype(_impl_.idle_seconds_){0}
+    , decltype(_impl_.compute_seconds_){0}
+    , decltype(_impl_.comm_seconds_){0}
+  };
+}
+
+WorkerStats::~WorkerStats() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.WorkerStats)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void WorkerStats::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+}
+
+void WorkerStats::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void WorkerStats::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.WorkerStats)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    ::memset(&_impl_.worker_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.comm_seconds_) -
+        reinterpret_cast<char*>(&_impl_.worker_)) + sizeof(_impl_.comm_seconds_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* WorkerStats::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required uint64 worker = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_worker(&has_bits);
+          _impl_.worker_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 clock = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_clock(&has_bits);
+          _impl_.clock_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 staleness = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_staleness(&has_bits);
+          _impl_.staleness_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double idle_seconds = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _Internal::set_has_idle_seconds(&has_bits);
+          _impl_.idle_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double compute_seconds = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 41)) {
+          _Internal::set_has_compute_seconds(&has_bits);
+          _impl_.compute_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double comm_seconds = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 49)) {
+          _Internal::set_has_comm_seconds(&has_bits);
+          _impl_.comm_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* WorkerStats::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.WorkerStats)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required uint64 worker = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_worker(), target);
+  }
+
+  // optional uint64 clock = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(2, this->_internal_clock(), target);
+  }
+
+  // optional uint64 staleness = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(3, this->_internal_staleness(), target);
+  }
+
+  // optional double idle_seconds = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_idle_seconds(), target);
+  }
+
+  // optional double compute_seconds = 5;
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(5, this->_internal_compute_seconds(), target);
+  }
+
+  // optional double comm_seconds = 6;
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(6, this->_internal_comm_seconds(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.WorkerStats)
+  return target;
+}
+
+size_t WorkerStats::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.WorkerStats)
+  size_t total_size = 0;
+
+  // required uint64 worker = 1;
+  if (_internal_has_worker()) {
+    total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_worker());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003eu) {
+    // optional uint64 clock = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_clock());
+    }
+
+    // optional uint64 staleness = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_staleness());
+    }
+
+    // optional double idle_seconds = 4;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double compute_seconds = 5;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double comm_seconds = 6;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += 1 + 8;
+    }
+
+  }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData WorkerStats::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    WorkerStats::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*WorkerStats::GetClassData() const { return &_class_data_; }
+
+
+void WorkerStats::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<WorkerStats*>(&to_msg);
+  auto& from = static_cast<const WorkerStats&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.WorkerStats)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000003fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.worker_ = from._impl_.worker_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.clock_ = from._impl_.clock_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.staleness_ = from._impl_.staleness_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.idle_seconds_ = from._impl_.idle_seconds_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.compute_seconds_ = from._impl_.compute_seconds_;
+    }
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.comm_seconds_ = from._impl_.comm_seconds_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void WorkerStats::CopyFrom(const WorkerStats& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.WorkerStats)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool WorkerStats::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
+}
+
+void WorkerStats::InternalSwap(WorkerStats* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(WorkerStats, _impl_.comm_seconds_)
+      + sizeof(WorkerStats::_impl_.comm_seconds_)
+      - PROTOBUF_FIELD_OFFSET(WorkerStats, _impl_.worker_)>(
+          reinterpret_cast<char*>(&_impl_.worker_),
+          reinterpret_cast<char*>(&other->_impl_.worker_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata WorkerStats::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[6]);
+}
+
+// ===================================================================
+
+class GetStatsResponse::_Internal {
+ public:
+  using HasBits = decltype(std::declval<GetStatsResponse>()._impl_._has_bits_);
+  static void set_has_uptime_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_updates(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_updates_per_second(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_rejected(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_bytes_in(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_bytes_out(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_lock_wait_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static void set_has_checkpoints(HasBits* has_bits) {
+    (*has_bits)[0] |= 128u;
+  }
+  static void set_has_checkpoint_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 256u;
+  }
+  static void set_has_workers(HasBits* has_bits) {
+    (*has_bits)[0] |= 16384u;
+  }
+  static void set_has_predictions(HasBits* has_bits) {
+    (*has_bits)[0] |= 512u;
+  }
+  static void set_has_batches(HasBits* has_bits) {
+    (*has_bits)[0] |= 1024u;
+  }
+  static void set_has_batch_rows(HasBits* has_bits) {
+    (*has_bits)[0] |= 2048u;
+  }
+  static void set_has_latency_p50_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 4096u;
+  }
+  static void set_has_latency_p99_seconds(HasBits* has_bits) {
+    (*has_bits)[0] |= 8192u;
+  }
+};
+
+GetStatsResponse::GetStatsResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.GetStatsResponse)
+}
+GetStatsResponse::GetStatsResponse(const GetStatsResponse& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
-  SetWeights* const _this = this; (void)_this;
+  GetStatsResponse* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_._has_bits_){from._impl_._has_bits_}
     , /*decltype(_impl_._cached_size_)*/{}
-    , decltype(_impl_.weights_){}};
+    , decltype(_impl_.request_){from._impl_.request_}
+    , decltype(_impl_.worker_){from._impl_.worker_}
+    , decltype(_impl_.uptime_seconds_){}
+    , decltype(_impl_.updates_){}
+    , decltype(_impl_.updates_per_second_){}
+    , decltype(_impl_.rejected_){}
+    , decltype(_impl_.bytes_in_){}
+    , decltype(_impl_.bytes_out_){}
+    , decltype(_impl_.lock_wait_seconds_){}
+    , decltype(_impl_.checkpoints_){}
+    , decltype(_impl_.checkpoint_seconds_){}
+    , decltype(_impl_.predictions_){}
+    , decltype(_impl_.batches_){}
+    , decltype(_impl_.batch_rows_){}
+    , decltype(_impl_.latency_p50_seconds_){}
+    , decltype(_impl_.latency_p99_seconds_){}
+    , decltype(_impl_.workers_){}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  _impl_.weights_.InitDefault();
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (from._internal_has_weights()) {
-    _this->_impl_.weights_.Set(from._internal_weights(), 
-      _this->GetArenaForAllocation());
-  }
-  // @@protoc_insertion_point(copy_constructor:seegnify.graph.SetWeights)
+  ::memcpy(&_impl_.uptime_seconds_, &from._impl_.uptime_seconds_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.workers_) -
+    reinterpret_cast<char*>(&_impl_.uptime_seconds_)) + sizeof(_impl_.workers_));
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.GetStatsResponse)
 }
 
-inline void SetWeights::SharedCtor(
+inline void GetStatsResponse::SharedCtor(
     ::_pb::Arena* arena, bool is_message_owned) {
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_._has_bits_){}
     , /*decltype(_impl_._cached_size_)*/{}
-    , decltype(_impl_.weights_){}
+    , decltype(_impl_.request_){arena}
+    , decltype(_impl_.worker_){arena}
+    , decltype(_impl_.uptime_seconds_){0}
+    , decltype(_impl_.updates_){uint64_t{0u}}
+    , decltype(_impl_.updates_per_second_){0}
+    , decltype(_impl_.rejected_){uint64_t{0u}}
+    , decltype(_impl_.bytes_in_){uint64_t{0u}}
+    , decltype(_impl_.bytes_out_){uint64_t{0u}}
+    , decltype(_impl_.lock_wait_seconds_){0}
+    , decltype(_impl_.checkpoints_){uint64_t{0u}}
+    , decltype(_impl_.checkpoint_seconds_){0}
+    , decltype(_impl_.predictions_){uint64_t{0u}}
+    , decltype(_impl_.batches_){uint64_t{0u}}
+    , decltype(_impl_.batch_rows_){0}
+    , decltype(_impl_.latency_p50_seconds_){0}
+    , decltype(_impl_.latency_p99_seconds_){0}
+    , decltype(_impl_.workers_){0u}
   };
-  _impl_.weights_.InitDefault();
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
-SetWeights::~SetWeights() {
-  // @@protoc_insertion_point(destructor:seegnify.graph.SetWeights)
+GetStatsResponse::~GetStatsResponse() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.GetStatsResponse)
   if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
   (void)arena;
     return;
@@ -578,45 +2428,207 @@ SetWeights::~SetWeights() {
   SharedDtor();
 }
 
-inline void SetWeights::SharedDtor() {
+inline void GetStatsResponse::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  _impl_.weights_.Destroy();
+  _impl_.request_.~RepeatedPtrField();
+  _impl_.worker_.~RepeatedPtrField();
 }
 
-void SetWeights::SetCachedSize(int size) const {
+void GetStatsResponse::SetCachedSize(int size) const {
   _impl_._cached_size_.Set(size);
 }
 
-void SetWeights::Clear() {
-// @@protoc_insertion_point(message_clear_start:seegnify.graph.SetWeights)
+void GetStatsResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.GetStatsResponse)
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  _impl_.request_.Clear();
+  _impl_.worker_.Clear();
   cached_has_bits = _impl_._has_bits_[0];
-  if (cached_has_bits & 0x00000001u) {
-    _impl_.weights_.ClearNonDefaultToEmpty();
+  if (cached_has_bits & 0x000000ffu) {
+    ::memset(&_impl_.uptime_seconds_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.checkpoints_) -
+        reinterpret_cast<char*>(&_impl_.uptime_seconds_)) + sizeof(_impl_.checkpoints_));
+  }
+  if (cached_has_bits & 0x00007f00u) {
+    ::memset(&_impl_.checkpoint_seconds_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.workers_) -
+        reinterpret_cast<char*>(&_impl_.checkpoint_seconds_)) + sizeof(_impl_.workers_));
   }
   _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-const char* SetWeights::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+const char* GetStatsResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
   _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
-      // required bytes weights = 1;
+      // optional double uptime_seconds = 1;
       case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
-          auto str = _internal_mutable_weights();
-          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 9)) {
+          _Internal::set_has_uptime_seconds(&has_bits);
+          _impl_.uptime_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 updates = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_updates(&has_bits);
+          _impl_.updates_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double updates_per_second = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 25)) {
+          _Internal::set_has_updates_per_second(&has_bits);
+          _impl_.updates_per_second_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 rejected = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_rejected(&has_bits);
+          _impl_.rejected_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 bytes_in = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_bytes_in(&has_bits);
+          _impl_.bytes_in_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 bytes_out = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _Internal::set_has_bytes_out(&has_bits);
+          _impl_.bytes_out_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .seegnify.graph.RequestStats request = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_request(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<58>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double lock_wait_seconds = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 65)) {
+          _Internal::set_has_lock_wait_seconds(&has_bits);
+          _impl_.lock_wait_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 checkpoints = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 72)) {
+          _Internal::set_has_checkpoints(&has_bits);
+          _impl_.checkpoints_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double checkpoint_seconds = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 81)) {
+          _Internal::set_has_checkpoint_seconds(&has_bits);
+          _impl_.checkpoint_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint32 workers = 11;
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 88)) {
+          _Internal::set_has_workers(&has_bits);
+          _impl_.workers_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .seegnify.graph.WorkerStats worker = 12;
+      case 12:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 98)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_worker(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<98>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 predictions = 13;
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 104)) {
+          _Internal::set_has_predictions(&has_bits);
+          _impl_.predictions_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional uint64 batches = 14;
+      case 14:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 112)) {
+          _Internal::set_has_batches(&has_bits);
+          _impl_.batches_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
           CHK_(ptr);
         } else
           goto handle_unusual;
         continue;
+      // optional double batch_rows = 15;
+      case 15:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 121)) {
+          _Internal::set_has_batch_rows(&has_bits);
+          _impl_.batch_rows_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double latency_p50_seconds = 16;
+      case 16:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 129)) {
+          _Internal::set_has_latency_p50_seconds(&has_bits);
+          _impl_.latency_p50_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional double latency_p99_seconds = 17;
+      case 17:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 137)) {
+          _Internal::set_has_latency_p99_seconds(&has_bits);
+          _impl_.latency_p99_seconds_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -641,151 +2653,461 @@ failure:
 #undef CHK_
 }
 
-uint8_t* SetWeights::_InternalSerialize(
-    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.SetWeights)
-  uint32_t cached_has_bits = 0;
-  (void) cached_has_bits;
+uint8_t* GetStatsResponse::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.GetStatsResponse)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional double uptime_seconds = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(1, this->_internal_uptime_seconds(), target);
+  }
+
+  // optional uint64 updates = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(2, this->_internal_updates(), target);
+  }
+
+  // optional double updates_per_second = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_updates_per_second(), target);
+  }
+
+  // optional uint64 rejected = 4;
+  if (cached_has_bits & 0x00000008u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(4, this->_internal_rejected(), target);
+  }
+
+  // optional uint64 bytes_in = 5;
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(5, this->_internal_bytes_in(), target);
+  }
+
+  // optional uint64 bytes_out = 6;
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(6, this->_internal_bytes_out(), target);
+  }
+
+  // repeated .seegnify.graph.RequestStats request = 7;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_request_size()); i < n; i++) {
+    const auto& repfield = this->_internal_request(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(7, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // optional double lock_wait_seconds = 8;
+  if (cached_has_bits & 0x00000040u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(8, this->_internal_lock_wait_seconds(), target);
+  }
+
+  // optional uint64 checkpoints = 9;
+  if (cached_has_bits & 0x00000080u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(9, this->_internal_checkpoints(), target);
+  }
+
+  // optional double checkpoint_seconds = 10;
+  if (cached_has_bits & 0x00000100u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(10, this->_internal_checkpoint_seconds(), target);
+  }
+
+  // optional uint32 workers = 11;
+  if (cached_has_bits & 0x00004000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt32ToArray(11, this->_internal_workers(), target);
+  }
+
+  // repeated .seegnify.graph.WorkerStats worker = 12;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_worker_size()); i < n; i++) {
+    const auto& repfield = this->_internal_worker(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(12, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // optional uint64 predictions = 13;
+  if (cached_has_bits & 0x00000200u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(13, this->_internal_predictions(), target);
+  }
+
+  // optional uint64 batches = 14;
+  if (cached_has_bits & 0x00000400u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(14, this->_internal_batches(), target);
+  }
 
-  cached_has_bits = _impl_._has_bits_[0];
-  // required bytes weights = 1;
-  if (cached_has_bits & 0x00000001u) {
-    target = stream->WriteBytesMaybeAliased(
-        1, this->_internal_weights(), target);
+  // optional double batch_rows = 15;
+  if (cached_has_bits & 0x00000800u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(15, this->_internal_batch_rows(), target);
+  }
+
+  // optional double latency_p50_seconds = 16;
+  if (cached_has_bits & 0x00001000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(16, this->_internal_latency_p50_seconds(), target);
+  }
+
+  // optional double latency_p99_seconds = 17;
+  if (cached_has_bits & 0x00002000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(17, this->_internal_latency_p99_seconds(), target);
   }
 
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.SetWeights)
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.GetStatsResponse)
   return target;
 }
 
-size_t SetWeights::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.SetWeights)
+size_t GetStatsResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.GetStatsResponse)
   size_t total_size = 0;
 
-  // required bytes weights = 1;
-  if (_internal_has_weights()) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
-        this->_internal_weights());
-  }
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  // repeated .seegnify.graph.RequestStats request = 7;
+  total_size += 1UL * this->_internal_request_size();
+  for (const auto& msg : this->_impl_.request_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // repeated .seegnify.graph.WorkerStats worker = 12;
+  total_size += 1UL * this->_internal_worker_size();
+  for (const auto& msg : this->_impl_.worker_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    // optional double uptime_seconds = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += 1 + 8;
+    }
+
+    // optional uint64 updates = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_updates());
+    }
+
+    // optional double updates_per_second = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 + 8;
+    }
+
+    // optional uint64 rejected = 4;
+    if (cached_has_bits & 0x00000008u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_rejected());
+    }
+
+    // optional uint64 bytes_in = 5;
+    if (cached_has_bits & 0x00000010u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_bytes_in());
+    }
+
+    // optional uint64 bytes_out = 6;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_bytes_out());
+    }
+
+    // optional double lock_wait_seconds = 8;
+    if (cached_has_bits & 0x00000040u) {
+      total_size += 1 + 8;
+    }
+
+    // optional uint64 checkpoints = 9;
+    if (cached_has_bits & 0x00000080u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_checkpoints());
+    }
+
+  }
+  if (cached_has_bits & 0x00007f00u) {
+    // optional double checkpoint_seconds = 10;
+    if (cached_has_bits & 0x00000100u) {
+      total_size += 1 + 8;
+    }
+
+    // optional uint64 predictions = 13;
+    if (cached_has_bits & 0x00000200u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_predictions());
+    }
+
+    // optional uint64 batches = 14;
+    if (cached_has_bits & 0x00000400u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_batches());
+    }
+
+    // optional double batch_rows = 15;
+    if (cached_has_bits & 0x00000800u) {
+      total_size += 1 + 8;
+    }
+
+    // optional double latency_p50_seconds = 16;
+    if (cached_has_bits & 0x00001000u) {
+      total_size += 2 + 8;
+    }
+
+    // optional double latency_p99_seconds = 17;
+    if (cached_has_bits & 0x00002000u) {
+      total_size += 2 + 8;
+    }
+
+    // optional uint32 workers = 11;
+    if (cached_has_bits & 0x00004000u) {
+      total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_workers());
+    }
+
+  }
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SetWeights::_class_data_ = {
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData GetStatsResponse::_class_data_ = {
     ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
-    SetWeights::MergeImpl
+    GetStatsResponse::MergeImpl
 };
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SetWeights::GetClassData() const { return &_class_data_; }
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetStatsResponse::GetClassData() const { return &_class_data_; }
 
 
-void SetWeights::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
-  auto* const _this = static_cast<SetWeights*>(&to_msg);
-  auto& from = static_cast<const SetWeights&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.SetWeights)
+void GetStatsResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<GetStatsResponse*>(&to_msg);
+  auto& from = static_cast<const GetStatsResponse&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.GetStatsResponse)
   GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  if (from._internal_has_weights()) {
-    _this->_internal_set_weights(from._internal_weights());
+  _this->_impl_.request_.MergeFrom(from._impl_.request_);
+  _this->_impl_.worker_.MergeFrom(from._impl_.worker_);
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.uptime_seconds_ = from._impl_.uptime_seconds_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.updates_ = from._impl_.updates_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.updates_per_second_ = from._impl_.updates_per_second_;
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _this->_impl_.rejected_ = from._impl_.rejected_;
+    }
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.bytes_in_ = from._impl_.bytes_in_;
+    }
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.bytes_out_ = from._impl_.bytes_out_;
+    }
+    if (cached_has_bits & 0x00000040u) {
+      _this->_impl_.lock_wait_seconds_ = from._impl_.lock_wait_seconds_;
+    }
+    if (cached_has_bits & 0x00000080u) {
+      _this->_impl_.checkpoints_ = from._impl_.checkpoints_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
+  if (cached_has_bits & 0x00007f00u) {
+    if (cached_has_bits & 0x00000100u) {
+      _this->_impl_.checkpoint_seconds_ = from._impl_.checkpoint_seconds_;
+    }
+    if (cached_has_bits & 0x00000200u) {
+      _this->_impl_.predictions_ = from._impl_.predictions_;
+    }
+    if (cached_has_bits & 0x00000400u) {
+      _this->_impl_.batches_ = from._impl_.batches_;
+    }
+    if (cached_has_bits & 0x00000800u) {
+      _this->_impl_.batch_rows_ = from._impl_.batch_rows_;
+    }
+    if (cached_has_bits & 0x00001000u) {
+      _this->_impl_.latency_p50_seconds_ = from._impl_.latency_p50_seconds_;
+    }
+    if (cached_has_bits & 0x00002000u) {
+      _this->_impl_.latency_p99_seconds_ = from._impl_.latency_p99_seconds_;
+    }
+    if (cached_has_bits & 0x00004000u) {
+      _this->_impl_.workers_ = from._impl_.workers_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void SetWeights::CopyFrom(const SetWeights& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.SetWeights)
+void GetStatsResponse::CopyFrom(const GetStatsResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.GetStatsResponse)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool SetWeights::IsInitialized() const {
-  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+bool GetStatsResponse::IsInitialized() const {
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.request_))
+    return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.worker_))
+    return false;
   return true;
 }
 
-void SetWeights::InternalSwap(SetWeights* other) {
+void GetStatsResponse::InternalSwap(GetStatsResponse* other) {
   using std::swap;
-  auto* lhs_arena = GetArenaForAllocation();
-  auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &_impl_.weights_, lhs_arena,
-      &other->_impl_.weights_, rhs_arena
-  );
+  _impl_.request_.InternalSwap(&other->_impl_.request_);
+  _impl_.worker_.InternalSwap(&other->_impl_.worker_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(GetStatsResponse, _impl_.workers_)
+      + sizeof(GetStatsResponse::_impl_.workers_)
+      - PROTOBUF_FIELD_OFFSET(GetStatsResponse, _impl_.uptime_seconds_)>(
+          reinterpret_cast<char*>(&_impl_.uptime_seconds_),
+          reinterpret_cast<char*>(&other->_impl_.uptime_seconds_));
 }
 
-::PROTOBUF_NAMESPACE_ID::Metadata SetWeights::GetMetadata() const {
+::PROTOBUF_NAMESPACE_ID::Metadata GetStatsResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[2]);
+      file_level_metadata_graph_2eproto[7]);
 }
 
 // ===================================================================
 
-class UpdWeights::_Internal {
+class Predict::_Internal {
  public:
-  using HasBits = decltype(std::declval<UpdWeights>()._impl_._has_bits_);
-  static void set_has_update(HasBits* has_bits) {
+};
+
+Predict::Predict(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.Predict)
+}
+Predict::Predict(const Predict& from)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
+  Predict* const _this = this; (void)_this;
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.Predict)
+}
+
+
+
+
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Predict::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Predict::GetClassData() const { return &_class_data_; }
+
+
+
+
+
+
+
+::PROTOBUF_NAMESPACE_ID::Metadata Predict::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[8]);
+}
+
+// ===================================================================
+
+class PredictResponse::_Internal {
+ public:
+};
+
+PredictResponse::PredictResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.PredictResponse)
+}
+PredictResponse::PredictResponse(const PredictResponse& from)
+  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
+  PredictResponse* const _this = this; (void)_this;
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.PredictResponse)
+}
+
+
+
+
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData PredictResponse::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*PredictResponse::GetClassData() const { return &_class_data_; }
+
+
+
+
+
+
+
+::PROTOBUF_NAMESPACE_ID::Metadata PredictResponse::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
+      file_level_metadata_graph_2eproto[9]);
+}
+
+// ===================================================================
+
+class SuccessResponse::_Internal {
+ public:
+  using HasBits = decltype(std::declval<SuccessResponse>()._impl_._has_bits_);
+  static void set_has_scale(HasBits* has_bits) {
     (*has_bits)[0] |= 1u;
   }
-  static bool MissingRequiredFields(const HasBits& has_bits) {
-    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
-  }
 };
 
-UpdWeights::UpdWeights(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+SuccessResponse::SuccessResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
   SharedCtor(arena, is_message_owned);
-  // @@protoc_insertion_point(arena_constructor:seegnify.graph.UpdWeights)
+  // @@protoc_insertion_point(arena_constructor:seegnify.graph.SuccessResponse)
 }
-UpdWeights::UpdWeights(const UpdWeights& from)
+SuccessResponse::SuccessResponse(const SuccessResponse& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
-  UpdWeights* const _this = this; (void)_this;
+  SuccessResponse* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_._has_bits_){from._impl_._has_bits_}
     , /*decltype(_impl_._cached_size_)*/{}
-    , decltype(_impl_.update_){}};
+    , decltype(_impl_.scale_){}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  _impl_.update_.InitDefault();
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.update_.Set("", GetArenaForAllocation());
-  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (from._internal_has_update()) {
-    _this->_impl_.update_.Set(from._internal_update(), 
-      _this->GetArenaForAllocation());
-  }
-  // @@protoc_insertion_point(copy_constructor:seegnify.graph.UpdWeights)
+  _this->_impl_.scale_ = from._impl_.scale_;
+  // @@protoc_insertion_point(copy_constructor:seegnify.graph.SuccessResponse)
 }
 
-inline void UpdWeights::SharedCtor(
+inline void SuccessResponse::SharedCtor(
     ::_pb::Arena* arena, bool is_message_owned) {
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_._has_bits_){}
     , /*decltype(_impl_._cached_size_)*/{}
-    , decltype(_impl_.update_){}
+    , decltype(_impl_.scale_){0}
   };
-  _impl_.update_.InitDefault();
-  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.update_.Set("", GetArenaForAllocation());
-  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
-UpdWeights::~UpdWeights() {
-  // @@protoc_insertion_point(destructor:seegnify.graph.UpdWeights)
+SuccessResponse::~SuccessResponse() {
+  // @@protoc_insertion_point(destructor:seegnify.graph.SuccessResponse)
   if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
   (void)arena;
     return;
@@ -793,42 +3115,38 @@ UpdWeights::~UpdWeights() {
   SharedDtor();
 }
 
-inline void UpdWeights::SharedDtor() {
+inline void SuccessResponse::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  _impl_.update_.Destroy();
 }
 
-void UpdWeights::SetCachedSize(int size) const {
+void SuccessResponse::SetCachedSize(int size) const {
   _impl_._cached_size_.Set(size);
 }
 
-void UpdWeights::Clear() {
-// @@protoc_insertion_point(message_clear_start:seegnify.graph.UpdWeights)
+void SuccessResponse::Clear() {
+// @@protoc_insertion_point(message_clear_start:seegnify.graph.SuccessResponse)
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  cached_has_bits = _impl_._has_bits_[0];
-  if (cached_has_bits & 0x00000001u) {
-    _impl_.update_.ClearNonDefaultToEmpty();
-  }
+  _impl_.scale_ = 0;
   _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-const char* UpdWeights::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+const char* SuccessResponse::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
   _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
-      // required bytes update = 1;
+      // optional float scale = 1;
       case 1:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
-          auto str = _internal_mutable_update();
-          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
-          CHK_(ptr);
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 13)) {
+          _Internal::set_has_scale(&has_bits);
+          _impl_.scale_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
         } else
           goto handle_unusual;
         continue;
@@ -856,133 +3174,87 @@ failure:
 #undef CHK_
 }
 
-uint8_t* UpdWeights::_InternalSerialize(
+uint8_t* SuccessResponse::_InternalSerialize(
     uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.UpdWeights)
+  // @@protoc_insertion_point(serialize_to_array_start:seegnify.graph.SuccessResponse)
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
   cached_has_bits = _impl_._has_bits_[0];
-  // required bytes update = 1;
+  // optional float scale = 1;
   if (cached_has_bits & 0x00000001u) {
-    target = stream->WriteBytesMaybeAliased(
-        1, this->_internal_update(), target);
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(1, this->_internal_scale(), target);
   }
 
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.UpdWeights)
+  // @@protoc_insertion_point(serialize_to_array_end:seegnify.graph.SuccessResponse)
   return target;
 }
 
-size_t UpdWeights::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.UpdWeights)
+size_t SuccessResponse::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:seegnify.graph.SuccessResponse)
   size_t total_size = 0;
 
-  // required bytes update = 1;
-  if (_internal_has_update()) {
-    total_size += 1 +
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::BytesSize(
-        this->_internal_update());
-  }
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  // optional float scale = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size += 1 + 4;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData UpdWeights::_class_data_ = {
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SuccessResponse::_class_data_ = {
     ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
-    UpdWeights::MergeImpl
+    SuccessResponse::MergeImpl
 };
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*UpdWeights::GetClassData() const { return &_class_data_; }
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SuccessResponse::GetClassData() const { return &_class_data_; }
 
 
-void UpdWeights::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
-  auto* const _this = static_cast<UpdWeights*>(&to_msg);
-  auto& from = static_cast<const UpdWeights&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.UpdWeights)
+void SuccessResponse::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<SuccessResponse*>(&to_msg);
+  auto& from = static_cast<const SuccessResponse&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:seegnify.graph.SuccessResponse)
   GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  if (from._internal_has_update()) {
-    _this->_internal_set_update(from._internal_update());
+  if (from._internal_has_scale()) {
+    _this->_internal_set_scale(from._internal_scale());
   }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void UpdWeights::CopyFrom(const UpdWeights& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.UpdWeights)
+void SuccessResponse::CopyFrom(const SuccessResponse& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:seegnify.graph.SuccessResponse)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool UpdWeights::IsInitialized() const {
-  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+bool SuccessResponse::IsInitialized() const {
   return true;
 }
 
-void UpdWeights::InternalSwap(UpdWeights* other) {
+void SuccessResponse::InternalSwap(SuccessResponse* other) {
   using std::swap;
-  auto* lhs_arena = GetArenaForAllocation();
-  auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
-  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
-      &_impl_.update_, lhs_arena,
-      &other->_impl_.update_, rhs_arena
-  );
-}
-
-::PROTOBUF_NAMESPACE_ID::Metadata UpdWeights::GetMetadata() const {
-  return ::_pbi::AssignDescriptors(
-      &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[3]);
-}
-
-// ===================================================================
-
-class SuccessResponse::_Internal {
- public:
-};
-
-SuccessResponse::SuccessResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
-                         bool is_message_owned)
-  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase(arena, is_message_owned) {
-  // @@protoc_insertion_point(arena_constructor:seegnify.graph.SuccessResponse)
+  swap(_impl_.scale_, other->_impl_.scale_);
 }
-SuccessResponse::SuccessResponse(const SuccessResponse& from)
-  : ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase() {
-  SuccessResponse* const _this = this; (void)_this;
-  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  // @@protoc_insertion_point(copy_constructor:seegnify.graph.SuccessResponse)
-}
-
-
-
-
-
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SuccessResponse::_class_data_ = {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl,
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl,
-};
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SuccessResponse::GetClassData() const { return &_class_data_; }
-
-
-
-
-
-
 
 ::PROTOBUF_NAMESPACE_ID::Metadata SuccessResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[4]);
+      file_level_metadata_graph_2eproto[10]);
 }
 
 // ===================================================================
@@ -1258,16 +3530,28 @@ void ErrorResponse::InternalSwap(ErrorResponse* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata ErrorResponse::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[5]);
+      file_level_metadata_graph_2eproto[11]);
 }
 
 // ===================================================================
 
 class Request::_Internal {
  public:
+  using HasBits = decltype(std::declval<Request>()._impl_._has_bits_);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_payload(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_deflate(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
   static const ::seegnify::graph::GetWeights& get_weights(const Request* msg);
   static const ::seegnify::graph::SetWeights& set_weights(const Request* msg);
   static const ::seegnify::graph::UpdWeights& upd_weights(const Request* msg);
+  static const ::seegnify::graph::GetStats& get_stats(const Request* msg);
+  static const ::seegnify::graph::Predict& predict(const Request* msg);
 };
 
 const ::seegnify::graph::GetWeights&
@@ -1282,6 +3566,14 @@ const ::seegnify::graph::UpdWeights&
 Request::_Internal::upd_weights(const Request* msg) {
   return *msg->_impl_.request_.upd_weights_;
 }
+const ::seegnify::graph::GetStats&
+Request::_Internal::get_stats(const Request* msg) {
+  return *msg->_impl_.request_.get_stats_;
+}
+const ::seegnify::graph::Predict&
+Request::_Internal::predict(const Request* msg) {
+  return *msg->_impl_.request_.predict_;
+}
 void Request::set_allocated_get_weights(::seegnify::graph::GetWeights* get_weights) {
   ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   clear_request();
@@ -1327,6 +3619,36 @@ void Request::set_allocated_upd_weights(::seegnify::graph::UpdWeights* upd_weigh
   }
   // @@protoc_insertion_point(field_set_allocated:seegnify.graph.Request.upd_weights)
 }
+void Request::set_allocated_get_stats(::seegnify::graph::GetStats* get_stats) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  clear_request();
+  if (get_stats) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(get_stats);
+    if (message_arena != submessage_arena) {
+      get_stats = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, get_stats, submessage_arena);
+    }
+    set_has_get_stats();
+    _impl_.request_.get_stats_ = get_stats;
+  }
+  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.Request.get_stats)
+}
+void Request::set_allocated_predict(::seegnify::graph::Predict* predict) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  clear_request();
+  if (predict) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(predict);
+    if (message_arena != submessage_arena) {
+      predict = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, predict, submessage_arena);
+    }
+    set_has_predict();
+    _impl_.request_.predict_ = predict;
+  }
+  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.Request.predict)
+}
 Request::Request(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
@@ -1337,11 +3659,18 @@ Request::Request(const Request& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
   Request* const _this = this; (void)_this;
   new (&_impl_) Impl_{
-      decltype(_impl_.request_){}
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
     , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){}
+    , decltype(_impl_.payload_){}
+    , decltype(_impl_.deflate_){}
+    , decltype(_impl_.request_){}
     , /*decltype(_impl_._oneof_case_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.deflate_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.deflate_));
   clear_has_request();
   switch (from.request_case()) {
     case kGetWeights: {
@@ -1359,6 +3688,16 @@ Request::Request(const Request& from)
           from._internal_upd_weights());
       break;
     }
+    case kGetStats: {
+      _this->_internal_mutable_get_stats()->::seegnify::graph::GetStats::MergeFrom(
+          from._internal_get_stats());
+      break;
+    }
+    case kPredict: {
+      _this->_internal_mutable_predict()->::seegnify::graph::Predict::MergeFrom(
+          from._internal_predict());
+      break;
+    }
     case REQUEST_NOT_SET: {
       break;
     }
@@ -1371,8 +3710,12 @@ inline void Request::SharedCtor(
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
-      decltype(_impl_.request_){}
+      decltype(_impl_._has_bits_){}
     , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){uint64_t{0u}}
+    , decltype(_impl_.payload_){false}
+    , decltype(_impl_.deflate_){false}
+    , decltype(_impl_.request_){}
     , /*decltype(_impl_._oneof_case_)*/{}
   };
   clear_has_request();
@@ -1419,6 +3762,18 @@ void Request::clear_request() {
       }
       break;
     }
+    case kGetStats: {
+      if (GetArenaForAllocation() == nullptr) {
+        delete _impl_.request_.get_stats_;
+      }
+      break;
+    }
+    case kPredict: {
+      if (GetArenaForAllocation() == nullptr) {
+        delete _impl_.request_.predict_;
+      }
+      break;
+    }
     case REQUEST_NOT_SET: {
       break;
     }
@@ -1433,16 +3788,51 @@ void Request::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    ::memset(&_impl_.id_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.deflate_) -
+        reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.deflate_));
+  }
   clear_request();
+  _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
 const char* Request::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
+      // optional uint64 id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool payload = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_payload(&has_bits);
+          _impl_.payload_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool deflate = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_deflate(&has_bits);
+          _impl_.deflate_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // .seegnify.graph.GetWeights get_weights = 10;
       case 10:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 82)) {
@@ -1467,6 +3857,22 @@ const char* Request::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
         } else
           goto handle_unusual;
         continue;
+      // .seegnify.graph.GetStats get_stats = 13;
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 106)) {
+          ptr = ctx->ParseMessage(_internal_mutable_get_stats(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .seegnify.graph.Predict predict = 14;
+      case 14:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 114)) {
+          ptr = ctx->ParseMessage(_internal_mutable_predict(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1483,6 +3889,7 @@ const char* Request::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
     CHK_(ptr != nullptr);
   }  // while
 message_done:
+  _impl_._has_bits_.Or(has_bits);
   return ptr;
 failure:
   ptr = nullptr;
@@ -1496,6 +3903,25 @@ uint8_t* Request::_InternalSerialize(
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional uint64 id = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_id(), target);
+  }
+
+  // optional bool payload = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(2, this->_internal_payload(), target);
+  }
+
+  // optional bool deflate = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_deflate(), target);
+  }
+
   switch (request_case()) {
     case kGetWeights: {
       target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
@@ -1515,6 +3941,18 @@ uint8_t* Request::_InternalSerialize(
           _Internal::upd_weights(this).GetCachedSize(), target, stream);
       break;
     }
+    case kGetStats: {
+      target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(13, _Internal::get_stats(this),
+          _Internal::get_stats(this).GetCachedSize(), target, stream);
+      break;
+    }
+    case kPredict: {
+      target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(14, _Internal::predict(this),
+          _Internal::predict(this).GetCachedSize(), target, stream);
+      break;
+    }
     default: ;
   }
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
@@ -1533,6 +3971,24 @@ size_t Request::ByteSizeLong() const {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    // optional uint64 id = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_id());
+    }
+
+    // optional bool payload = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 1;
+    }
+
+    // optional bool deflate = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 + 1;
+    }
+
+  }
   switch (request_case()) {
     // .seegnify.graph.GetWeights get_weights = 10;
     case kGetWeights: {
@@ -1555,6 +4011,20 @@ size_t Request::ByteSizeLong() const {
           *_impl_.request_.upd_weights_);
       break;
     }
+    // .seegnify.graph.GetStats get_stats = 13;
+    case kGetStats: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.request_.get_stats_);
+      break;
+    }
+    // .seegnify.graph.Predict predict = 14;
+    case kPredict: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.request_.predict_);
+      break;
+    }
     case REQUEST_NOT_SET: {
       break;
     }
@@ -1577,6 +4047,19 @@ void Request::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOB
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.id_ = from._impl_.id_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.payload_ = from._impl_.payload_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.deflate_ = from._impl_.deflate_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
   switch (from.request_case()) {
     case kGetWeights: {
       _this->_internal_mutable_get_weights()->::seegnify::graph::GetWeights::MergeFrom(
@@ -1593,6 +4076,16 @@ void Request::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOB
           from._internal_upd_weights());
       break;
     }
+    case kGetStats: {
+      _this->_internal_mutable_get_stats()->::seegnify::graph::GetStats::MergeFrom(
+          from._internal_get_stats());
+      break;
+    }
+    case kPredict: {
+      _this->_internal_mutable_predict()->::seegnify::graph::Predict::MergeFrom(
+          from._internal_predict());
+      break;
+    }
     case REQUEST_NOT_SET: {
       break;
     }
@@ -1608,32 +4101,19 @@ void Request::CopyFrom(const Request& from) {
 }
 
 bool Request::IsInitialized() const {
-  switch (request_case()) {
-    case kGetWeights: {
-      break;
-    }
-    case kSetWeights: {
-      if (_internal_has_set_weights()) {
-        if (!_impl_.request_.set_weights_->IsInitialized()) return false;
-      }
-      break;
-    }
-    case kUpdWeights: {
-      if (_internal_has_upd_weights()) {
-        if (!_impl_.request_.upd_weights_->IsInitialized()) return false;
-      }
-      break;
-    }
-    case REQUEST_NOT_SET: {
-      break;
-    }
-  }
   return true;
 }
 
 void Request::InternalSwap(Request* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Request, _impl_.deflate_)
+      + sizeof(Request::_impl_.deflate_)
+      - PROTOBUF_FIELD_OFFSET(Request, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
   swap(_impl_.request_, other->_impl_.request_);
   swap(_impl_._oneof_case_[0], other->_impl_._oneof_case_[0]);
 }
@@ -1641,16 +4121,28 @@ void Request::InternalSwap(Request* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata Request::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[6]);
+      file_level_metadata_graph_2eproto[12]);
 }
 
 // ===================================================================
 
 class Response::_Internal {
  public:
+  using HasBits = decltype(std::declval<Response>()._impl_._has_bits_);
+  static void set_has_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_payload(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_deflate(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
   static const ::seegnify::graph::GetWeightsResponse& get_weights(const Response* msg);
   static const ::seegnify::graph::SuccessResponse& success(const Response* msg);
   static const ::seegnify::graph::ErrorResponse& error(const Response* msg);
+  static const ::seegnify::graph::GetStatsResponse& get_stats(const Response* msg);
+  static const ::seegnify::graph::PredictResponse& predict(const Response* msg);
 };
 
 const ::seegnify::graph::GetWeightsResponse&
@@ -1665,6 +4157,14 @@ const ::seegnify::graph::ErrorResponse&
 Response::_Internal::error(const Response* msg) {
   return *msg->_impl_.response_.error_;
 }
+const ::seegnify::graph::GetStatsResponse&
+Response::_Internal::get_stats(const Response* msg) {
+  return *msg->_impl_.response_.get_stats_;
+}
+const ::seegnify::graph::PredictResponse&
+Response::_Internal::predict(const Response* msg) {
+  return *msg->_impl_.response_.predict_;
+}
 void Response::set_allocated_get_weights(::seegnify::graph::GetWeightsResponse* get_weights) {
   ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
   clear_response();
@@ -1710,6 +4210,36 @@ void Response::set_allocated_error(::seegnify::graph::ErrorResponse* error) {
   }
   // @@protoc_insertion_point(field_set_allocated:seegnify.graph.Response.error)
 }
+void Response::set_allocated_get_stats(::seegnify::graph::GetStatsResponse* get_stats) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  clear_response();
+  if (get_stats) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(get_stats);
+    if (message_arena != submessage_arena) {
+      get_stats = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, get_stats, submessage_arena);
+    }
+    set_has_get_stats();
+    _impl_.response_.get_stats_ = get_stats;
+  }
+  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.Response.get_stats)
+}
+void Response::set_allocated_predict(::seegnify::graph::PredictResponse* predict) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  clear_response();
+  if (predict) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+      ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(predict);
+    if (message_arena != submessage_arena) {
+      predict = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, predict, submessage_arena);
+    }
+    set_has_predict();
+    _impl_.response_.predict_ = predict;
+  }
+  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.Response.predict)
+}
 Response::Response(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
@@ -1720,11 +4250,18 @@ Response::Response(const Response& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
   Response* const _this = this; (void)_this;
   new (&_impl_) Impl_{
-      decltype(_impl_.response_){}
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
     , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){}
+    , decltype(_impl_.payload_){}
+    , decltype(_impl_.deflate_){}
+    , decltype(_impl_.response_){}
     , /*decltype(_impl_._oneof_case_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  ::memcpy(&_impl_.id_, &from._impl_.id_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.deflate_) -
+    reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.deflate_));
   clear_has_response();
   switch (from.response_case()) {
     case kGetWeights: {
@@ -1742,6 +4279,16 @@ Response::Response(const Response& from)
           from._internal_error());
       break;
     }
+    case kGetStats: {
+      _this->_internal_mutable_get_stats()->::seegnify::graph::GetStatsResponse::MergeFrom(
+          from._internal_get_stats());
+      break;
+    }
+    case kPredict: {
+      _this->_internal_mutable_predict()->::seegnify::graph::PredictResponse::MergeFrom(
+          from._internal_predict());
+      break;
+    }
     case RESPONSE_NOT_SET: {
       break;
     }
@@ -1754,8 +4301,12 @@ inline void Response::SharedCtor(
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
-      decltype(_impl_.response_){}
+      decltype(_impl_._has_bits_){}
     , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.id_){uint64_t{0u}}
+    , decltype(_impl_.payload_){false}
+    , decltype(_impl_.deflate_){false}
+    , decltype(_impl_.response_){}
     , /*decltype(_impl_._oneof_case_)*/{}
   };
   clear_has_response();
@@ -1802,6 +4353,18 @@ void Response::clear_response() {
       }
       break;
     }
+    case kGetStats: {
+      if (GetArenaForAllocation() == nullptr) {
+        delete _impl_.response_.get_stats_;
+      }
+      break;
+    }
+    case kPredict: {
+      if (GetArenaForAllocation() == nullptr) {
+        delete _impl_.response_.predict_;
+      }
+      break;
+    }
     case RESPONSE_NOT_SET: {
       break;
     }
@@ -1816,16 +4379,51 @@ void Response::Clear() {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    ::memset(&_impl_.id_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.deflate_) -
+        reinterpret_cast<char*>(&_impl_.id_)) + sizeof(_impl_.deflate_));
+  }
   clear_response();
+  _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
 const char* Response::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
+      // optional uint64 id = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          _Internal::set_has_id(&has_bits);
+          _impl_.id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool payload = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_payload(&has_bits);
+          _impl_.payload_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // optional bool deflate = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_deflate(&has_bits);
+          _impl_.deflate_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       // .seegnify.graph.GetWeightsResponse get_weights = 11;
       case 11:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 90)) {
@@ -1850,6 +4448,22 @@ const char* Response::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
         } else
           goto handle_unusual;
         continue;
+      // .seegnify.graph.GetStatsResponse get_stats = 14;
+      case 14:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 114)) {
+          ptr = ctx->ParseMessage(_internal_mutable_get_stats(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .seegnify.graph.PredictResponse predict = 15;
+      case 15:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 122)) {
+          ptr = ctx->ParseMessage(_internal_mutable_predict(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1866,6 +4480,7 @@ const char* Response::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx)
     CHK_(ptr != nullptr);
   }  // while
 message_done:
+  _impl_._has_bits_.Or(has_bits);
   return ptr;
 failure:
   ptr = nullptr;
@@ -1879,6 +4494,25 @@ uint8_t* Response::_InternalSerialize(
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  // optional uint64 id = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(1, this->_internal_id(), target);
+  }
+
+  // optional bool payload = 2;
+  if (cached_has_bits & 0x00000002u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(2, this->_internal_payload(), target);
+  }
+
+  // optional bool deflate = 3;
+  if (cached_has_bits & 0x00000004u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(3, this->_internal_deflate(), target);
+  }
+
   switch (response_case()) {
     case kGetWeights: {
       target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
@@ -1898,6 +4532,18 @@ uint8_t* Response::_InternalSerialize(
           _Internal::error(this).GetCachedSize(), target, stream);
       break;
     }
+    case kGetStats: {
+      target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(14, _Internal::get_stats(this),
+          _Internal::get_stats(this).GetCachedSize(), target, stream);
+      break;
+    }
+    case kPredict: {
+      target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(15, _Internal::predict(this),
+          _Internal::predict(this).GetCachedSize(), target, stream);
+      break;
+    }
     default: ;
   }
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
@@ -1916,6 +4562,24 @@ size_t Response::ByteSizeLong() const {
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    // optional uint64 id = 1;
+    if (cached_has_bits & 0x00000001u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_id());
+    }
+
+    // optional bool payload = 2;
+    if (cached_has_bits & 0x00000002u) {
+      total_size += 1 + 1;
+    }
+
+    // optional bool deflate = 3;
+    if (cached_has_bits & 0x00000004u) {
+      total_size += 1 + 1;
+    }
+
+  }
   switch (response_case()) {
     // .seegnify.graph.GetWeightsResponse get_weights = 11;
     case kGetWeights: {
@@ -1938,6 +4602,20 @@ size_t Response::ByteSizeLong() const {
           *_impl_.response_.error_);
       break;
     }
+    // .seegnify.graph.GetStatsResponse get_stats = 14;
+    case kGetStats: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.response_.get_stats_);
+      break;
+    }
+    // .seegnify.graph.PredictResponse predict = 15;
+    case kPredict: {
+      total_size += 1 +
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+          *_impl_.response_.predict_);
+      break;
+    }
     case RESPONSE_NOT_SET: {
       break;
     }
@@ -1960,6 +4638,19 @@ void Response::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTO
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000007u) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_impl_.id_ = from._impl_.id_;
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _this->_impl_.payload_ = from._impl_.payload_;
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _this->_impl_.deflate_ = from._impl_.deflate_;
+    }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
+  }
   switch (from.response_case()) {
     case kGetWeights: {
       _this->_internal_mutable_get_weights()->::seegnify::graph::GetWeightsResponse::MergeFrom(
@@ -1976,6 +4667,16 @@ void Response::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTO
           from._internal_error());
       break;
     }
+    case kGetStats: {
+      _this->_internal_mutable_get_stats()->::seegnify::graph::GetStatsResponse::MergeFrom(
+          from._internal_get_stats());
+      break;
+    }
+    case kPredict: {
+      _this->_internal_mutable_predict()->::seegnify::graph::PredictResponse::MergeFrom(
+          from._internal_predict());
+      break;
+    }
     case RESPONSE_NOT_SET: {
       break;
     }
@@ -1993,9 +4694,6 @@ void Response::CopyFrom(const Response& from) {
 bool Response::IsInitialized() const {
   switch (response_case()) {
     case kGetWeights: {
-      if (_internal_has_get_weights()) {
-        if (!_impl_.response_.get_weights_->IsInitialized()) return false;
-      }
       break;
     }
     case kSuccess: {
@@ -2007,6 +4705,15 @@ bool Response::IsInitialized() const {
       }
       break;
     }
+    case kGetStats: {
+      if (_internal_has_get_stats()) {
+        if (!_impl_.response_.get_stats_->IsInitialized()) return false;
+      }
+      break;
+    }
+    case kPredict: {
+      break;
+    }
     case RESPONSE_NOT_SET: {
       break;
     }
@@ -2017,6 +4724,13 @@ bool Response::IsInitialized() const {
 void Response::InternalSwap(Response* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Response, _impl_.deflate_)
+      + sizeof(Response::_impl_.deflate_)
+      - PROTOBUF_FIELD_OFFSET(Response, _impl_.id_)>(
+          reinterpret_cast<char*>(&_impl_.id_),
+          reinterpret_cast<char*>(&other->_impl_.id_));
   swap(_impl_.response_, other->_impl_.response_);
   swap(_impl_._oneof_case_[0], other->_impl_._oneof_case_[0]);
 }
@@ -2024,7 +4738,7 @@ void Response::InternalSwap(Response* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata Response::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_graph_2eproto_getter, &descriptor_table_graph_2eproto_once,
-      file_level_metadata_graph_2eproto[7]);
+      file_level_metadata_graph_2eproto[13]);
 }
 
 // @@protoc_insertion_point(namespace_scope)
@@ -2047,6 +4761,30 @@ template<> PROTOBUF_NOINLINE ::seegnify::graph::UpdWeights*
 Arena::CreateMaybeMessage< ::seegnify::graph::UpdWeights >(Arena* arena) {
   return Arena::CreateMessageInternal< ::seegnify::graph::UpdWeights >(arena);
 }
+template<> PROTOBUF_NOINLINE ::seegnify::graph::GetStats*
+Arena::CreateMaybeMessage< ::seegnify::graph::GetStats >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::seegnify::graph::GetStats >(arena);
+}
+template<> PROTOBUF_NOINLINE ::seegnify::graph::RequestStats*
+Arena::CreateMaybeMessage< ::seegnify::graph::RequestStats >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::seegnify::graph::RequestStats >(arena);
+}
+template<> PROTOBUF_NOINLINE ::seegnify::graph::WorkerStats*
+Arena::CreateMaybeMessage< ::seegnify::graph::WorkerStats >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::seegnify::graph::WorkerStats >(arena);
+}
+template<> PROTOBUF_NOINLINE ::seegnify::graph::GetStatsResponse*
+Arena::CreateMaybeMessage< ::seegnify::graph::GetStatsResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::seegnify::graph::GetStatsResponse >(arena);
+}
+template<> PROTOBUF_NOINLINE ::seegnify::graph::Predict*
+Arena::CreateMaybeMessage< ::seegnify::graph::Predict >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::seegnify::graph::Predict >(arena);
+}
+template<> PROTOBUF_NOINLINE ::seegnify::graph::PredictResponse*
+Arena::CreateMaybeMessage< ::seegnify::graph::PredictResponse >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::seegnify::graph::PredictResponse >(arena);
+}
 template<> PROTOBUF_NOINLINE ::seegnify::graph::SuccessResponse*
 Arena::CreateMaybeMessage< ::seegnify::graph::SuccessResponse >(Arena* arena) {
   return Arena::CreateMessageInternal< ::seegnify::graph::SuccessResponse >(arena);
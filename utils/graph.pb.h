@@ -50,15 +50,30 @@ namespace graph {
 class ErrorResponse;
 struct ErrorResponseDefaultTypeInternal;
 extern ErrorResponseDefaultTypeInternal _ErrorResponse_default_instance_;
+class GetStats;
+struct GetStatsDefaultTypeInternal;
+extern GetStatsDefaultTypeInternal _GetStats_default_instance_;
+class GetStatsResponse;
+struct GetStatsResponseDefaultTypeInternal;
+extern GetStatsResponseDefaultTypeInternal _GetStatsResponse_default_instance_;
 class GetWeights;
 struct GetWeightsDefaultTypeInternal;
 extern GetWeightsDefaultTypeInternal _GetWeights_default_instance_;
 class GetWeightsResponse;
 struct GetWeightsResponseDefaultTypeInternal;
 extern GetWeightsResponseDefaultTypeInternal _GetWeightsResponse_default_instance_;
+class Predict;
+struct PredictDefaultTypeInternal;
+extern PredictDefaultTypeInternal _Predict_default_instance_;
+class PredictResponse;
+struct PredictResponseDefaultTypeInternal;
+extern PredictResponseDefaultTypeInternal _PredictResponse_default_instance_;
 class Request;
 struct RequestDefaultTypeInternal;
 extern RequestDefaultTypeInternal _Request_default_instance_;
+class RequestStats;
+struct RequestStatsDefaultTypeInternal;
+extern RequestStatsDefaultTypeInternal _RequestStats_default_instance_;
 class Response;
 struct ResponseDefaultTypeInternal;
 extern ResponseDefaultTypeInternal _Response_default_instance_;
@@ -71,17 +86,26 @@ extern SuccessResponseDefaultTypeInternal _SuccessResponse_default_instance_;
 class UpdWeights;
 struct UpdWeightsDefaultTypeInternal;
 extern UpdWeightsDefaultTypeInternal _UpdWeights_default_instance_;
+class WorkerStats;
+struct WorkerStatsDefaultTypeInternal;
+extern WorkerStatsDefaultTypeInternal _WorkerStats_default_instance_;
 }  // namespace graph
 }  // namespace seegnify
 PROTOBUF_NAMESPACE_OPEN
 template<> ::seegnify::graph::ErrorResponse* Arena::CreateMaybeMessage<::seegnify::graph::ErrorResponse>(Arena*);
+template<> ::seegnify::graph::GetStats* Arena::CreateMaybeMessage<::seegnify::graph::GetStats>(Arena*);
+template<> ::seegnify::graph::GetStatsResponse* Arena::CreateMaybeMessage<::seegnify::graph::GetStatsResponse>(Arena*);
 template<> ::seegnify::graph::GetWeights* Arena::CreateMaybeMessage<::seegnify::graph::GetWeights>(Arena*);
 template<> ::seegnify::graph::GetWeightsResponse* Arena::CreateMaybeMessage<::seegnify::graph::GetWeightsResponse>(Arena*);
+template<> ::seegnify::graph::Predict* Arena::CreateMaybeMessage<::seegnify::graph::Predict>(Arena*);
+template<> ::seegnify::graph::PredictResponse* Arena::CreateMaybeMessage<::seegnify::graph::PredictResponse>(Arena*);
 template<> ::seegnify::graph::Request* Arena::CreateMaybeMessage<::seegnify::graph::Request>(Arena*);
+template<> ::seegnify::graph::RequestStats* Arena::CreateMaybeMessage<::seegnify::graph::RequestStats>(Arena*);
 template<> ::seegnify::graph::Response* Arena::CreateMaybeMessage<::seegnify::graph::Response>(Arena*);
 template<> ::seegnify::graph::SetWeights* Arena::CreateMaybeMessage<::seegnify::graph::SetWeights>(Arena*);
 template<> ::seegnify::graph::SuccessResponse* Arena::CreateMaybeMessage<::seegnify::graph::SuccessResponse>(Arena*);
 template<> ::seegnify::graph::UpdWeights* Arena::CreateMaybeMessage<::seegnify::graph::UpdWeights>(Arena*);
+template<> ::seegnify::graph::WorkerStats* Arena::CreateMaybeMessage<::seegnify::graph::WorkerStats>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace seegnify {
 namespace graph {
@@ -89,9 +113,10 @@ namespace graph {
 // ===================================================================
 
 class GetWeights final :
-    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:seegnify.graph.GetWeights) */ {
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.GetWeights) */ {
  public:
   inline GetWeights() : GetWeights(nullptr) {}
+  ~GetWeights() override;
   explicit PROTOBUF_CONSTEXPR GetWeights(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   GetWeights(const GetWeights& from);
@@ -171,15 +196,29 @@ class GetWeights final :
   GetWeights* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<GetWeights>(arena);
   }
-  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
-  inline void CopyFrom(const GetWeights& from) {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
-  }
-  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
-  void MergeFrom(const GetWeights& from) {
-    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const GetWeights& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const GetWeights& from) {
+    GetWeights::MergeImpl(*this, from);
   }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(GetWeights* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
@@ -200,6 +239,73 @@ class GetWeights final :
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kSinceVersionFieldNumber = 1,
+    kWorkerFieldNumber = 2,
+    kClockFieldNumber = 3,
+    kPrecisionFieldNumber = 4,
+  };
+  // repeated uint64 since_version = 1 [packed = true];
+  int since_version_size() const;
+  private:
+  int _internal_since_version_size() const;
+  public:
+  void clear_since_version();
+  private:
+  uint64_t _internal_since_version(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      _internal_since_version() const;
+  void _internal_add_since_version(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      _internal_mutable_since_version();
+  public:
+  uint64_t since_version(int index) const;
+  void set_since_version(int index, uint64_t value);
+  void add_since_version(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      since_version() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      mutable_since_version();
+
+  // optional uint64 worker = 2;
+  bool has_worker() const;
+  private:
+  bool _internal_has_worker() const;
+  public:
+  void clear_worker();
+  uint64_t worker() const;
+  void set_worker(uint64_t value);
+  private:
+  uint64_t _internal_worker() const;
+  void _internal_set_worker(uint64_t value);
+  public:
+
+  // optional uint64 clock = 3;
+  bool has_clock() const;
+  private:
+  bool _internal_has_clock() const;
+  public:
+  void clear_clock();
+  uint64_t clock() const;
+  void set_clock(uint64_t value);
+  private:
+  uint64_t _internal_clock() const;
+  void _internal_set_clock(uint64_t value);
+  public:
+
+  // optional uint32 precision = 4;
+  bool has_precision() const;
+  private:
+  bool _internal_has_precision() const;
+  public:
+  void clear_precision();
+  uint32_t precision() const;
+  void set_precision(uint32_t value);
+  private:
+  uint32_t _internal_precision() const;
+  void _internal_set_precision(uint32_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:seegnify.graph.GetWeights)
  private:
   class _Internal;
@@ -208,7 +314,15 @@ class GetWeights final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > since_version_;
+    mutable std::atomic<int> _since_version_cached_byte_size_;
+    uint64_t worker_;
+    uint64_t clock_;
+    uint32_t precision_;
   };
+  union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
@@ -341,24 +455,56 @@ class GetWeightsResponse final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kWeightsFieldNumber = 1,
+    kVersionFieldNumber = 2,
+    kUpdatesFieldNumber = 4,
+    kDeltaFieldNumber = 3,
   };
-  // required bytes weights = 1;
-  bool has_weights() const;
+  // repeated uint64 version = 2 [packed = true];
+  int version_size() const;
   private:
-  bool _internal_has_weights() const;
+  int _internal_version_size() const;
   public:
-  void clear_weights();
-  const std::string& weights() const;
-  template <typename ArgT0 = const std::string&, typename... ArgT>
-  void set_weights(ArgT0&& arg0, ArgT... args);
-  std::string* mutable_weights();
-  PROTOBUF_NODISCARD std::string* release_weights();
-  void set_allocated_weights(std::string* weights);
+  void clear_version();
+  private:
+  uint64_t _internal_version(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      _internal_version() const;
+  void _internal_add_version(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      _internal_mutable_version();
+  public:
+  uint64_t version(int index) const;
+  void set_version(int index, uint64_t value);
+  void add_version(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      version() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      mutable_version();
+
+  // optional uint64 updates = 4;
+  bool has_updates() const;
+  private:
+  bool _internal_has_updates() const;
+  public:
+  void clear_updates();
+  uint64_t updates() const;
+  void set_updates(uint64_t value);
+  private:
+  uint64_t _internal_updates() const;
+  void _internal_set_updates(uint64_t value);
+  public:
+
+  // optional bool delta = 3;
+  bool has_delta() const;
+  private:
+  bool _internal_has_delta() const;
+  public:
+  void clear_delta();
+  bool delta() const;
+  void set_delta(bool value);
   private:
-  const std::string& _internal_weights() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_weights(const std::string& value);
-  std::string* _internal_mutable_weights();
+  bool _internal_delta() const;
+  void _internal_set_delta(bool value);
   public:
 
   // @@protoc_insertion_point(class_scope:seegnify.graph.GetWeightsResponse)
@@ -371,7 +517,10 @@ class GetWeightsResponse final :
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr weights_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > version_;
+    mutable std::atomic<int> _version_cached_byte_size_;
+    uint64_t updates_;
+    bool delta_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
@@ -379,10 +528,9 @@ class GetWeightsResponse final :
 // -------------------------------------------------------------------
 
 class SetWeights final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.SetWeights) */ {
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:seegnify.graph.SetWeights) */ {
  public:
   inline SetWeights() : SetWeights(nullptr) {}
-  ~SetWeights() override;
   explicit PROTOBUF_CONSTEXPR SetWeights(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   SetWeights(const SetWeights& from);
@@ -462,29 +610,15 @@ class SetWeights final :
   SetWeights* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
     return CreateMaybeMessage<SetWeights>(arena);
   }
-  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const SetWeights& from);
-  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const SetWeights& from) {
-    SetWeights::MergeImpl(*this, from);
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const SetWeights& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const SetWeights& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
   }
-  private:
-  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
   public:
-  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
-  bool IsInitialized() const final;
-
-  size_t ByteSizeLong() const final;
-  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
-  uint8_t* _InternalSerialize(
-      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
-  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
-
-  private:
-  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
-  void SharedDtor();
-  void SetCachedSize(int size) const final;
-  void InternalSwap(SetWeights* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
@@ -505,27 +639,6 @@ class SetWeights final :
 
   // accessors -------------------------------------------------------
 
-  enum : int {
-    kWeightsFieldNumber = 1,
-  };
-  // required bytes weights = 1;
-  bool has_weights() const;
-  private:
-  bool _internal_has_weights() const;
-  public:
-  void clear_weights();
-  const std::string& weights() const;
-  template <typename ArgT0 = const std::string&, typename... ArgT>
-  void set_weights(ArgT0&& arg0, ArgT... args);
-  std::string* mutable_weights();
-  PROTOBUF_NODISCARD std::string* release_weights();
-  void set_allocated_weights(std::string* weights);
-  private:
-  const std::string& _internal_weights() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_weights(const std::string& value);
-  std::string* _internal_mutable_weights();
-  public:
-
   // @@protoc_insertion_point(class_scope:seegnify.graph.SetWeights)
  private:
   class _Internal;
@@ -534,11 +647,7 @@ class SetWeights final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
-    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr weights_;
   };
-  union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
@@ -671,24 +780,89 @@ class UpdWeights final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kUpdateFieldNumber = 1,
+    kWorkerFieldNumber = 3,
+    kClockFieldNumber = 4,
+    kUpdatesFieldNumber = 5,
+    kComputeSecondsFieldNumber = 6,
+    kCommSecondsFieldNumber = 7,
+    kCompressionFieldNumber = 2,
   };
-  // required bytes update = 1;
-  bool has_update() const;
+  // optional uint64 worker = 3;
+  bool has_worker() const;
   private:
-  bool _internal_has_update() const;
+  bool _internal_has_worker() const;
   public:
-  void clear_update();
-  const std::string& update() const;
-  template <typename ArgT0 = const std::string&, typename... ArgT>
-  void set_update(ArgT0&& arg0, ArgT... args);
-  std::string* mutable_update();
-  PROTOBUF_NODISCARD std::string* release_update();
-  void set_allocated_update(std::string* update);
+  void clear_worker();
+  uint64_t worker() const;
+  void set_worker(uint64_t value);
+  private:
+  uint64_t _internal_worker() const;
+  void _internal_set_worker(uint64_t value);
+  public:
+
+  // optional uint64 clock = 4;
+  bool has_clock() const;
+  private:
+  bool _internal_has_clock() const;
+  public:
+  void clear_clock();
+  uint64_t clock() const;
+  void set_clock(uint64_t value);
+  private:
+  uint64_t _internal_clock() const;
+  void _internal_set_clock(uint64_t value);
+  public:
+
+  // optional uint64 updates = 5;
+  bool has_updates() const;
+  private:
+  bool _internal_has_updates() const;
+  public:
+  void clear_updates();
+  uint64_t updates() const;
+  void set_updates(uint64_t value);
+  private:
+  uint64_t _internal_updates() const;
+  void _internal_set_updates(uint64_t value);
+  public:
+
+  // optional double compute_seconds = 6;
+  bool has_compute_seconds() const;
+  private:
+  bool _internal_has_compute_seconds() const;
+  public:
+  void clear_compute_seconds();
+  double compute_seconds() const;
+  void set_compute_seconds(double value);
+  private:
+  double _internal_compute_seconds() const;
+  void _internal_set_compute_seconds(double value);
+  public:
+
+  // optional double comm_seconds = 7;
+  bool has_comm_seconds() const;
+  private:
+  bool _internal_has_comm_seconds() const;
+  public:
+  void clear_comm_seconds();
+  double comm_seconds() const;
+  void set_comm_seconds(double value);
+  private:
+  double _internal_comm_seconds() const;
+  void _internal_set_comm_seconds(double value);
+  public:
+
+  // optional uint32 compression = 2;
+  bool has_compression() const;
+  private:
+  bool _internal_has_compression() const;
+  public:
+  void clear_compression();
+  uint32_t compression() const;
+  void set_compression(uint32_t value);
   private:
-  const std::string& _internal_update() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_update(const std::string& value);
-  std::string* _internal_mutable_update();
+  uint32_t _internal_compression() const;
+  void _internal_set_compression(uint32_t value);
   public:
 
   // @@protoc_insertion_point(class_scope:seegnify.graph.UpdWeights)
@@ -701,30 +875,35 @@ class UpdWeights final :
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr update_;
+    uint64_t worker_;
+    uint64_t clock_;
+    uint64_t updates_;
+    double compute_seconds_;
+    double comm_seconds_;
+    uint32_t compression_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
 
-class SuccessResponse final :
-    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:seegnify.graph.SuccessResponse) */ {
+class GetStats final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:seegnify.graph.GetStats) */ {
  public:
-  inline SuccessResponse() : SuccessResponse(nullptr) {}
-  explicit PROTOBUF_CONSTEXPR SuccessResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline GetStats() : GetStats(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR GetStats(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  SuccessResponse(const SuccessResponse& from);
-  SuccessResponse(SuccessResponse&& from) noexcept
-    : SuccessResponse() {
+  GetStats(const GetStats& from);
+  GetStats(GetStats&& from) noexcept
+    : GetStats() {
     *this = ::std::move(from);
   }
 
-  inline SuccessResponse& operator=(const SuccessResponse& from) {
+  inline GetStats& operator=(const GetStats& from) {
     CopyFrom(from);
     return *this;
   }
-  inline SuccessResponse& operator=(SuccessResponse&& from) noexcept {
+  inline GetStats& operator=(GetStats&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -754,20 +933,20 @@ class SuccessResponse final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const SuccessResponse& default_instance() {
+  static const GetStats& default_instance() {
     return *internal_default_instance();
   }
-  static inline const SuccessResponse* internal_default_instance() {
-    return reinterpret_cast<const SuccessResponse*>(
-               &_SuccessResponse_default_instance_);
+  static inline const GetStats* internal_default_instance() {
+    return reinterpret_cast<const GetStats*>(
+               &_GetStats_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     4;
 
-  friend void swap(SuccessResponse& a, SuccessResponse& b) {
+  friend void swap(GetStats& a, GetStats& b) {
     a.Swap(&b);
   }
-  inline void Swap(SuccessResponse* other) {
+  inline void Swap(GetStats* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -780,7 +959,7 @@ class SuccessResponse final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(SuccessResponse* other) {
+  void UnsafeArenaSwap(GetStats* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -788,15 +967,15 @@ class SuccessResponse final :
 
   // implements Message ----------------------------------------------
 
-  SuccessResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<SuccessResponse>(arena);
+  GetStats* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GetStats>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
-  inline void CopyFrom(const SuccessResponse& from) {
+  inline void CopyFrom(const GetStats& from) {
     ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
   }
   using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
-  void MergeFrom(const SuccessResponse& from) {
+  void MergeFrom(const GetStats& from) {
     ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
   }
   public:
@@ -804,10 +983,10 @@ class SuccessResponse final :
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "seegnify.graph.SuccessResponse";
+    return "seegnify.graph.GetStats";
   }
   protected:
-  explicit SuccessResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit GetStats(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -820,7 +999,7 @@ class SuccessResponse final :
 
   // accessors -------------------------------------------------------
 
-  // @@protoc_insertion_point(class_scope:seegnify.graph.SuccessResponse)
+  // @@protoc_insertion_point(class_scope:seegnify.graph.GetStats)
  private:
   class _Internal;
 
@@ -833,24 +1012,24 @@ class SuccessResponse final :
 };
 // -------------------------------------------------------------------
 
-class ErrorResponse final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.ErrorResponse) */ {
+class RequestStats final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.RequestStats) */ {
  public:
-  inline ErrorResponse() : ErrorResponse(nullptr) {}
-  ~ErrorResponse() override;
-  explicit PROTOBUF_CONSTEXPR ErrorResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline RequestStats() : RequestStats(nullptr) {}
+  ~RequestStats() override;
+  explicit PROTOBUF_CONSTEXPR RequestStats(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  ErrorResponse(const ErrorResponse& from);
-  ErrorResponse(ErrorResponse&& from) noexcept
-    : ErrorResponse() {
+  RequestStats(const RequestStats& from);
+  RequestStats(RequestStats&& from) noexcept
+    : RequestStats() {
     *this = ::std::move(from);
   }
 
-  inline ErrorResponse& operator=(const ErrorResponse& from) {
+  inline RequestStats& operator=(const RequestStats& from) {
     CopyFrom(from);
     return *this;
   }
-  inline ErrorResponse& operator=(ErrorResponse&& from) noexcept {
+  inline RequestStats& operator=(RequestStats&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -880,20 +1059,20 @@ class ErrorResponse final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const ErrorResponse& default_instance() {
+  static const RequestStats& default_instance() {
     return *internal_default_instance();
   }
-  static inline const ErrorResponse* internal_default_instance() {
-    return reinterpret_cast<const ErrorResponse*>(
-               &_ErrorResponse_default_instance_);
+  static inline const RequestStats* internal_default_instance() {
+    return reinterpret_cast<const RequestStats*>(
+               &_RequestStats_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     5;
 
-  friend void swap(ErrorResponse& a, ErrorResponse& b) {
+  friend void swap(RequestStats& a, RequestStats& b) {
     a.Swap(&b);
   }
-  inline void Swap(ErrorResponse* other) {
+  inline void Swap(RequestStats* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -906,7 +1085,7 @@ class ErrorResponse final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(ErrorResponse* other) {
+  void UnsafeArenaSwap(RequestStats* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -914,14 +1093,14 @@ class ErrorResponse final :
 
   // implements Message ----------------------------------------------
 
-  ErrorResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<ErrorResponse>(arena);
+  RequestStats* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<RequestStats>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const ErrorResponse& from);
+  void CopyFrom(const RequestStats& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const ErrorResponse& from) {
-    ErrorResponse::MergeImpl(*this, from);
+  void MergeFrom( const RequestStats& from) {
+    RequestStats::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -939,15 +1118,15 @@ class ErrorResponse final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(ErrorResponse* other);
+  void InternalSwap(RequestStats* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "seegnify.graph.ErrorResponse";
+    return "seegnify.graph.RequestStats";
   }
   protected:
-  explicit ErrorResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit RequestStats(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -961,79 +1140,131 @@ class ErrorResponse final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kMessageFieldNumber = 2,
-    kStatusFieldNumber = 1,
+    kLatencyFieldNumber = 5,
+    kNameFieldNumber = 1,
+    kCountFieldNumber = 2,
+    kBytesInFieldNumber = 3,
+    kBytesOutFieldNumber = 4,
   };
-  // required string message = 2;
-  bool has_message() const;
+  // repeated uint64 latency = 5 [packed = true];
+  int latency_size() const;
   private:
-  bool _internal_has_message() const;
+  int _internal_latency_size() const;
   public:
-  void clear_message();
-  const std::string& message() const;
+  void clear_latency();
+  private:
+  uint64_t _internal_latency(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      _internal_latency() const;
+  void _internal_add_latency(uint64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      _internal_mutable_latency();
+  public:
+  uint64_t latency(int index) const;
+  void set_latency(int index, uint64_t value);
+  void add_latency(uint64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+      latency() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+      mutable_latency();
+
+  // required string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
-  void set_message(ArgT0&& arg0, ArgT... args);
-  std::string* mutable_message();
-  PROTOBUF_NODISCARD std::string* release_message();
-  void set_allocated_message(std::string* message);
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
   private:
-  const std::string& _internal_message() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
-  std::string* _internal_mutable_message();
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
   public:
 
-  // required uint32 status = 1;
-  bool has_status() const;
+  // optional uint64 count = 2;
+  bool has_count() const;
   private:
-  bool _internal_has_status() const;
+  bool _internal_has_count() const;
   public:
-  void clear_status();
-  uint32_t status() const;
-  void set_status(uint32_t value);
+  void clear_count();
+  uint64_t count() const;
+  void set_count(uint64_t value);
   private:
-  uint32_t _internal_status() const;
-  void _internal_set_status(uint32_t value);
+  uint64_t _internal_count() const;
+  void _internal_set_count(uint64_t value);
   public:
 
-  // @@protoc_insertion_point(class_scope:seegnify.graph.ErrorResponse)
+  // optional uint64 bytes_in = 3;
+  bool has_bytes_in() const;
+  private:
+  bool _internal_has_bytes_in() const;
+  public:
+  void clear_bytes_in();
+  uint64_t bytes_in() const;
+  void set_bytes_in(uint64_t value);
+  private:
+  uint64_t _internal_bytes_in() const;
+  void _internal_set_bytes_in(uint64_t value);
+  public:
+
+  // optional uint64 bytes_out = 4;
+  bool has_bytes_out() const;
+  private:
+  bool _internal_has_bytes_out() const;
+  public:
+  void clear_bytes_out();
+  uint64_t bytes_out() const;
+  void set_bytes_out(uint64_t value);
+  private:
+  uint64_t _internal_bytes_out() const;
+  void _internal_set_bytes_out(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.RequestStats)
  private:
   class _Internal;
 
-  // helper for ByteSizeLong()
-  size_t RequiredFieldsByteSizeFallback() const;
-
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
     ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
-    uint32_t status_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t > latency_;
+    mutable std::atomic<int> _latency_cached_byte_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    uint64_t count_;
+    uint64_t bytes_in_;
+    uint64_t bytes_out_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Request final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.Request) */ {
+class WorkerStats final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.WorkerStats) */ {
  public:
-  inline Request() : Request(nullptr) {}
-  ~Request() override;
-  explicit PROTOBUF_CONSTEXPR Request(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline WorkerStats() : WorkerStats(nullptr) {}
+  ~WorkerStats() override;
+  explicit PROTOBUF_CONSTEXPR WorkerStats(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  Request(const Request& from);
-  Request(Request&& from) noexcept
-    : Request() {
+  WorkerStats(const WorkerStats& from);
+  WorkerStats(WorkerStats&& from) noexcept
+    : WorkerStats() {
     *this = ::std::move(from);
   }
 
-  inline Request& operator=(const Request& from) {
+  inline WorkerStats& operator=(const WorkerStats& from) {
     CopyFrom(from);
     return *this;
   }
-  inline Request& operator=(Request&& from) noexcept {
+  inline WorkerStats& operator=(WorkerStats&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -1063,27 +1294,20 @@ class Request final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const Request& default_instance() {
+  static const WorkerStats& default_instance() {
     return *internal_default_instance();
   }
-  enum RequestCase {
-    kGetWeights = 10,
-    kSetWeights = 11,
-    kUpdWeights = 12,
-    REQUEST_NOT_SET = 0,
-  };
-
-  static inline const Request* internal_default_instance() {
-    return reinterpret_cast<const Request*>(
-               &_Request_default_instance_);
+  static inline const WorkerStats* internal_default_instance() {
+    return reinterpret_cast<const WorkerStats*>(
+               &_WorkerStats_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     6;
 
-  friend void swap(Request& a, Request& b) {
+  friend void swap(WorkerStats& a, WorkerStats& b) {
     a.Swap(&b);
   }
-  inline void Swap(Request* other) {
+  inline void Swap(WorkerStats* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -1096,7 +1320,7 @@ class Request final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(Request* other) {
+  void UnsafeArenaSwap(WorkerStats* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -1104,14 +1328,14 @@ class Request final :
 
   // implements Message ----------------------------------------------
 
-  Request* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<Request>(arena);
+  WorkerStats* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<WorkerStats>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const Request& from);
+  void CopyFrom(const WorkerStats& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const Request& from) {
-    Request::MergeImpl(*this, from);
+  void MergeFrom( const WorkerStats& from) {
+    WorkerStats::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -1129,15 +1353,15 @@ class Request final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(Request* other);
+  void InternalSwap(WorkerStats* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "seegnify.graph.Request";
+    return "seegnify.graph.WorkerStats";
   }
   protected:
-  explicit Request(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit WorkerStats(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -1151,114 +1375,131 @@ class Request final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kGetWeightsFieldNumber = 10,
-    kSetWeightsFieldNumber = 11,
-    kUpdWeightsFieldNumber = 12,
+    kWorkerFieldNumber = 1,
+    kClockFieldNumber = 2,
+    kStalenessFieldNumber = 3,
+    kIdleSecondsFieldNumber = 4,
+    kComputeSecondsFieldNumber = 5,
+    kCommSecondsFieldNumber = 6,
   };
-  // .seegnify.graph.GetWeights get_weights = 10;
-  bool has_get_weights() const;
+  // required uint64 worker = 1;
+  bool has_worker() const;
   private:
-  bool _internal_has_get_weights() const;
+  bool _internal_has_worker() const;
   public:
-  void clear_get_weights();
-  const ::seegnify::graph::GetWeights& get_weights() const;
-  PROTOBUF_NODISCARD ::seegnify::graph::GetWeights* release_get_weights();
-  ::seegnify::graph::GetWeights* mutable_get_weights();
-  void set_allocated_get_weights(::seegnify::graph::GetWeights* get_weights);
+  void clear_worker();
+  uint64_t worker() const;
+  void set_worker(uint64_t value);
   private:
-  const ::seegnify::graph::GetWeights& _internal_get_weights() const;
-  ::seegnify::graph::GetWeights* _internal_mutable_get_weights();
+  uint64_t _internal_worker() const;
+  void _internal_set_worker(uint64_t value);
   public:
-  void unsafe_arena_set_allocated_get_weights(
-      ::seegnify::graph::GetWeights* get_weights);
-  ::seegnify::graph::GetWeights* unsafe_arena_release_get_weights();
 
-  // .seegnify.graph.SetWeights set_weights = 11;
-  bool has_set_weights() const;
+  // optional uint64 clock = 2;
+  bool has_clock() const;
   private:
-  bool _internal_has_set_weights() const;
+  bool _internal_has_clock() const;
   public:
-  void clear_set_weights();
-  const ::seegnify::graph::SetWeights& set_weights() const;
-  PROTOBUF_NODISCARD ::seegnify::graph::SetWeights* release_set_weights();
-  ::seegnify::graph::SetWeights* mutable_set_weights();
-  void set_allocated_set_weights(::seegnify::graph::SetWeights* set_weights);
+  void clear_clock();
+  uint64_t clock() const;
+  void set_clock(uint64_t value);
   private:
-  const ::seegnify::graph::SetWeights& _internal_set_weights() const;
-  ::seegnify::graph::SetWeights* _internal_mutable_set_weights();
+  uint64_t _internal_clock() const;
+  void _internal_set_clock(uint64_t value);
   public:
-  void unsafe_arena_set_allocated_set_weights(
-      ::seegnify::graph::SetWeights* set_weights);
-  ::seegnify::graph::SetWeights* unsafe_arena_release_set_weights();
 
-  // .seegnify.graph.UpdWeights upd_weights = 12;
-  bool has_upd_weights() const;
+  // optional uint64 staleness = 3;
+  bool has_staleness() const;
   private:
-  bool _internal_has_upd_weights() const;
+  bool _internal_has_staleness() const;
   public:
-  void clear_upd_weights();
-  const ::seegnify::graph::UpdWeights& upd_weights() const;
-  PROTOBUF_NODISCARD ::seegnify::graph::UpdWeights* release_upd_weights();
-  ::seegnify::graph::UpdWeights* mutable_upd_weights();
-  void set_allocated_upd_weights(::seegnify::graph::UpdWeights* upd_weights);
+  void clear_staleness();
+  uint64_t staleness() const;
+  void set_staleness(uint64_t value);
   private:
-  const ::seegnify::graph::UpdWeights& _internal_upd_weights() const;
-  ::seegnify::graph::UpdWeights* _internal_mutable_upd_weights();
+  uint64_t _internal_staleness() const;
+  void _internal_set_staleness(uint64_t value);
   public:
-  void unsafe_arena_set_allocated_upd_weights(
-      ::seegnify::graph::UpdWeights* upd_weights);
-  ::seegnify::graph::UpdWeights* unsafe_arena_release_upd_weights();
 
-  void clear_request();
-  RequestCase request_case() const;
-  // @@protoc_insertion_point(class_scope:seegnify.graph.Request)
+  // optional double idle_seconds = 4;
+  bool has_idle_seconds() const;
+  private:
+  bool _internal_has_idle_seconds() const;
+  public:
+  void clear_idle_seconds();
+  double idle_seconds() const;
+  void set_idle_seconds(double value);
+  private:
+  double _internal_idle_seconds() const;
+  void _internal_set_idle_seconds(double value);
+  public:
+
+  // optional double compute_seconds = 5;
+  bool has_compute_seconds() const;
+  private:
+  bool _internal_has_compute_seconds() const;
+  public:
+  void clear_compute_seconds();
+  double compute_seconds() const;
+  void set_compute_seconds(double value);
+  private:
+  double _internal_compute_seconds() const;
+  void _internal_set_compute_seconds(double value);
+  public:
+
+  // optional double comm_seconds = 6;
+  bool has_comm_seconds() const;
+  private:
+  bool _internal_has_comm_seconds() const;
+  public:
+  void clear_comm_seconds();
+  double comm_seconds() const;
+  void set_comm_seconds(double value);
+  private:
+  double _internal_comm_seconds() const;
+  void _internal_set_comm_seconds(double value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.WorkerStats)
  private:
   class _Internal;
-  void set_has_get_weights();
-  void set_has_set_weights();
-  void set_has_upd_weights();
-
-  inline bool has_request() const;
-  inline void clear_has_request();
 
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    union RequestUnion {
-      constexpr RequestUnion() : _constinit_{} {}
-        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
-      ::seegnify::graph::GetWeights* get_weights_;
-      ::seegnify::graph::SetWeights* set_weights_;
-      ::seegnify::graph::UpdWeights* upd_weights_;
-    } request_;
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    uint32_t _oneof_case_[1];
-
+    uint64_t worker_;
+    uint64_t clock_;
+    uint64_t staleness_;
+    double idle_seconds_;
+    double compute_seconds_;
+    double comm_seconds_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
 // -------------------------------------------------------------------
 
-class Response final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.Response) */ {
+class GetStatsResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.GetStatsResponse) */ {
  public:
-  inline Response() : Response(nullptr) {}
-  ~Response() override;
-  explicit PROTOBUF_CONSTEXPR Response(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline GetStatsResponse() : GetStatsResponse(nullptr) {}
+  ~GetStatsResponse() override;
+  explicit PROTOBUF_CONSTEXPR GetStatsResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  Response(const Response& from);
-  Response(Response&& from) noexcept
-    : Response() {
+  GetStatsResponse(const GetStatsResponse& from);
+  GetStatsResponse(GetStatsResponse&& from) noexcept
+    : GetStatsResponse() {
     *this = ::std::move(from);
   }
 
-  inline Response& operator=(const Response& from) {
+  inline GetStatsResponse& operator=(const GetStatsResponse& from) {
     CopyFrom(from);
     return *this;
   }
-  inline Response& operator=(Response&& from) noexcept {
+  inline GetStatsResponse& operator=(GetStatsResponse&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -1288,27 +1529,20 @@ class Response final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const Response& default_instance() {
+  static const GetStatsResponse& default_instance() {
     return *internal_default_instance();
   }
-  enum ResponseCase {
-    kGetWeights = 11,
-    kSuccess = 12,
-    kError = 13,
-    RESPONSE_NOT_SET = 0,
-  };
-
-  static inline const Response* internal_default_instance() {
-    return reinterpret_cast<const Response*>(
-               &_Response_default_instance_);
+  static inline const GetStatsResponse* internal_default_instance() {
+    return reinterpret_cast<const GetStatsResponse*>(
+               &_GetStatsResponse_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     7;
 
-  friend void swap(Response& a, Response& b) {
+  friend void swap(GetStatsResponse& a, GetStatsResponse& b) {
     a.Swap(&b);
   }
-  inline void Swap(Response* other) {
+  inline void Swap(GetStatsResponse* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -1321,7 +1555,7 @@ class Response final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(Response* other) {
+  void UnsafeArenaSwap(GetStatsResponse* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -1329,14 +1563,14 @@ class Response final :
 
   // implements Message ----------------------------------------------
 
-  Response* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<Response>(arena);
+  GetStatsResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<GetStatsResponse>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const Response& from);
+  void CopyFrom(const GetStatsResponse& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const Response& from) {
-    Response::MergeImpl(*this, from);
+  void MergeFrom( const GetStatsResponse& from) {
+    GetStatsResponse::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -1354,15 +1588,15 @@ class Response final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(Response* other);
+  void InternalSwap(GetStatsResponse* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "seegnify.graph.Response";
+    return "seegnify.graph.GetStatsResponse";
   }
   protected:
-  explicit Response(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit GetStatsResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -1376,327 +1610,2859 @@ class Response final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kGetWeightsFieldNumber = 11,
-    kSuccessFieldNumber = 12,
-    kErrorFieldNumber = 13,
+    kRequestFieldNumber = 7,
+    kWorkerFieldNumber = 12,
+    kUptimeSecondsFieldNumber = 1,
+    kUpdatesFieldNumber = 2,
+    kUpdatesPerSecondFieldNumber = 3,
+    kRejectedFieldNumber = 4,
+    kBytesInFieldNumber = 5,
+    kBytesOutFieldNumber = 6,
+    kLockWaitSecondsFieldNumber = 8,
+    kCheckpointsFieldNumber = 9,
+    kCheckpointSecondsFieldNumber = 10,
+    kPredictionsFieldNumber = 13,
+    kBatchesFieldNumber = 14,
+    kBatchRowsFieldNumber = 15,
+    kLatencyP50SecondsFieldNumber = 16,
+    kLatencyP99SecondsFieldNumber = 17,
+    kWorkersFieldNumber = 11,
   };
-  // .seegnify.graph.GetWeightsResponse get_weights = 11;
-  bool has_get_weights() const;
+  // repeated .seegnify.graph.RequestStats request = 7;
+  int request_size() const;
   private:
-  bool _internal_has_get_weights() const;
+  int _internal_request_size() const;
   public:
-  void clear_get_weights();
-  const ::seegnify::graph::GetWeightsResponse& get_weights() const;
-  PROTOBUF_NODISCARD ::seegnify::graph::GetWeightsResponse* release_get_weights();
-  ::seegnify::graph::GetWeightsResponse* mutable_get_weights();
-  void set_allocated_get_weights(::seegnify::graph::GetWeightsResponse* get_weights);
+  void clear_request();
+  ::seegnify::graph::RequestStats* mutable_request(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::RequestStats >*
+      mutable_request();
   private:
-  const ::seegnify::graph::GetWeightsResponse& _internal_get_weights() const;
-  ::seegnify::graph::GetWeightsResponse* _internal_mutable_get_weights();
+  const ::seegnify::graph::RequestStats& _internal_request(int index) const;
+  ::seegnify::graph::RequestStats* _internal_add_request();
   public:
-  void unsafe_arena_set_allocated_get_weights(
-      ::seegnify::graph::GetWeightsResponse* get_weights);
-  ::seegnify::graph::GetWeightsResponse* unsafe_arena_release_get_weights();
+  const ::seegnify::graph::RequestStats& request(int index) const;
+  ::seegnify::graph::RequestStats* add_request();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::RequestStats >&
+      request() const;
 
-  // .seegnify.graph.SuccessResponse success = 12;
-  bool has_success() const;
+  // repeated .seegnify.graph.WorkerStats worker = 12;
+  int worker_size() const;
   private:
-  bool _internal_has_success() const;
+  int _internal_worker_size() const;
   public:
-  void clear_success();
-  const ::seegnify::graph::SuccessResponse& success() const;
-  PROTOBUF_NODISCARD ::seegnify::graph::SuccessResponse* release_success();
-  ::seegnify::graph::SuccessResponse* mutable_success();
-  void set_allocated_success(::seegnify::graph::SuccessResponse* success);
+  void clear_worker();
+  ::seegnify::graph::WorkerStats* mutable_worker(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::WorkerStats >*
+      mutable_worker();
   private:
-  const ::seegnify::graph::SuccessResponse& _internal_success() const;
-  ::seegnify::graph::SuccessResponse* _internal_mutable_success();
+  const ::seegnify::graph::WorkerStats& _internal_worker(int index) const;
+  ::seegnify::graph::WorkerStats* _internal_add_worker();
   public:
-  void unsafe_arena_set_allocated_success(
-      ::seegnify::graph::SuccessResponse* success);
-  ::seegnify::graph::SuccessResponse* unsafe_arena_release_success();
+  const ::seegnify::graph::WorkerStats& worker(int index) const;
+  ::seegnify::graph::WorkerStats* add_worker();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::WorkerStats >&
+      worker() const;
 
-  // .seegnify.graph.ErrorResponse error = 13;
-  bool has_error() const;
+  // optional double uptime_seconds = 1;
+  bool has_uptime_seconds() const;
   private:
-  bool _internal_has_error() const;
+  bool _internal_has_uptime_seconds() const;
   public:
-  void clear_error();
-  const ::seegnify::graph::ErrorResponse& error() const;
-  PROTOBUF_NODISCARD ::seegnify::graph::ErrorResponse* release_error();
-  ::seegnify::graph::ErrorResponse* mutable_error();
-  void set_allocated_error(::seegnify::graph::ErrorResponse* error);
+  void clear_uptime_seconds();
+  double uptime_seconds() const;
+  void set_uptime_seconds(double value);
   private:
-  const ::seegnify::graph::ErrorResponse& _internal_error() const;
-  ::seegnify::graph::ErrorResponse* _internal_mutable_error();
+  double _internal_uptime_seconds() const;
+  void _internal_set_uptime_seconds(double value);
   public:
-  void unsafe_arena_set_allocated_error(
-      ::seegnify::graph::ErrorResponse* error);
-  ::seegnify::graph::ErrorResponse* unsafe_arena_release_error();
 
-  void clear_response();
-  ResponseCase response_case() const;
-  // @@protoc_insertion_point(class_scope:seegnify.graph.Response)
+  // optional uint64 updates = 2;
+  bool has_updates() const;
+  private:
+  bool _internal_has_updates() const;
+  public:
+  void clear_updates();
+  uint64_t updates() const;
+  void set_updates(uint64_t value);
+  private:
+  uint64_t _internal_updates() const;
+  void _internal_set_updates(uint64_t value);
+  public:
+
+  // optional double updates_per_second = 3;
+  bool has_updates_per_second() const;
+  private:
+  bool _internal_has_updates_per_second() const;
+  public:
+  void clear_updates_per_second();
+  double updates_per_second() const;
+  void set_updates_per_second(double value);
+  private:
+  double _internal_updates_per_second() const;
+  void _internal_set_updates_per_second(double value);
+  public:
+
+  // optional uint64 rejected = 4;
+  bool has_rejected() const;
+  private:
+  bool _internal_has_rejected() const;
+  public:
+  void clear_rejected();
+  uint64_t rejected() const;
+  void set_rejected(uint64_t value);
+  private:
+  uint64_t _internal_rejected() const;
+  void _internal_set_rejected(uint64_t value);
+  public:
+
+  // optional uint64 bytes_in = 5;
+  bool has_bytes_in() const;
+  private:
+  bool _internal_has_bytes_in() const;
+  public:
+  void clear_bytes_in();
+  uint64_t bytes_in() const;
+  void set_bytes_in(uint64_t value);
+  private:
+  uint64_t _internal_bytes_in() const;
+  void _internal_set_bytes_in(uint64_t value);
+  public:
+
+  // optional uint64 bytes_out = 6;
+  bool has_bytes_out() const;
+  private:
+  bool _internal_has_bytes_out() const;
+  public:
+  void clear_bytes_out();
+  uint64_t bytes_out() const;
+  void set_bytes_out(uint64_t value);
+  private:
+  uint64_t _internal_bytes_out() const;
+  void _internal_set_bytes_out(uint64_t value);
+  public:
+
+  // optional double lock_wait_seconds = 8;
+  bool has_lock_wait_seconds() const;
+  private:
+  bool _internal_has_lock_wait_seconds() const;
+  public:
+  void clear_lock_wait_seconds();
+  double lock_wait_seconds() const;
+  void set_lock_wait_seconds(double value);
+  private:
+  double _internal_lock_wait_seconds() const;
+  void _internal_set_lock_wait_seconds(double value);
+  public:
+
+  // optional uint64 checkpoints = 9;
+  bool has_checkpoints() const;
+  private:
+  bool _internal_has_checkpoints() const;
+  public:
+  void clear_checkpoints();
+  uint64_t checkpoints() const;
+  void set_checkpoints(uint64_t value);
+  private:
+  uint64_t _internal_checkpoints() const;
+  void _internal_set_checkpoints(uint64_t value);
+  public:
+
+  // optional double checkpoint_seconds = 10;
+  bool has_checkpoint_seconds() const;
+  private:
+  bool _internal_has_checkpoint_seconds() const;
+  public:
+  void clear_checkpoint_seconds();
+  double checkpoint_seconds() const;
+  void set_checkpoint_seconds(double value);
+  private:
+  double _internal_checkpoint_seconds() const;
+  void _internal_set_checkpoint_seconds(double value);
+  public:
+
+  // optional uint64 predictions = 13;
+  bool has_predictions() const;
+  private:
+  bool _internal_has_predictions() const;
+  public:
+  void clear_predictions();
+  uint64_t predictions() const;
+  void set_predictions(uint64_t value);
+  private:
+  uint64_t _internal_predictions() const;
+  void _internal_set_predictions(uint64_t value);
+  public:
+
+  // optional uint64 batches = 14;
+  bool has_batches() const;
+  private:
+  bool _internal_has_batches() const;
+  public:
+  void clear_batches();
+  uint64_t batches() const;
+  void set_batches(uint64_t value);
+  private:
+  uint64_t _internal_batches() const;
+  void _internal_set_batches(uint64_t value);
+  public:
+
+  // optional double batch_rows = 15;
+  bool has_batch_rows() const;
+  private:
+  bool _internal_has_batch_rows() const;
+  public:
+  void clear_batch_rows();
+  double batch_rows() const;
+  void set_batch_rows(double value);
+  private:
+  double _internal_batch_rows() const;
+  void _internal_set_batch_rows(double value);
+  public:
+
+  // optional double latency_p50_seconds = 16;
+  bool has_latency_p50_seconds() const;
+  private:
+  bool _internal_has_latency_p50_seconds() const;
+  public:
+  void clear_latency_p50_seconds();
+  double latency_p50_seconds() const;
+  void set_latency_p50_seconds(double value);
+  private:
+  double _internal_latency_p50_seconds() const;
+  void _internal_set_latency_p50_seconds(double value);
+  public:
+
+  // optional double latency_p99_seconds = 17;
+  bool has_latency_p99_seconds() const;
+  private:
+  bool _internal_has_latency_p99_seconds() const;
+  public:
+  void clear_latency_p99_seconds();
+  double latency_p99_seconds() const;
+  void set_latency_p99_seconds(double value);
+  private:
+  double _internal_latency_p99_seconds() const;
+  void _internal_set_latency_p99_seconds(double value);
+  public:
+
+  // optional uint32 workers = 11;
+  bool has_workers() const;
+  private:
+  bool _internal_has_workers() const;
+  public:
+  void clear_workers();
+  uint32_t workers() const;
+  void set_workers(uint32_t value);
+  private:
+  uint32_t _internal_workers() const;
+  void _internal_set_workers(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.GetStatsResponse)
  private:
   class _Internal;
-  void set_has_get_weights();
-  void set_has_success();
-  void set_has_error();
-
-  inline bool has_response() const;
-  inline void clear_has_response();
 
   template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    union ResponseUnion {
-      constexpr ResponseUnion() : _constinit_{} {}
-        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
-      ::seegnify::graph::GetWeightsResponse* get_weights_;
-      ::seegnify::graph::SuccessResponse* success_;
-      ::seegnify::graph::ErrorResponse* error_;
-    } response_;
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
-    uint32_t _oneof_case_[1];
-
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::RequestStats > request_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::WorkerStats > worker_;
+    double uptime_seconds_;
+    uint64_t updates_;
+    double updates_per_second_;
+    uint64_t rejected_;
+    uint64_t bytes_in_;
+    uint64_t bytes_out_;
+    double lock_wait_seconds_;
+    uint64_t checkpoints_;
+    double checkpoint_seconds_;
+    uint64_t predictions_;
+    uint64_t batches_;
+    double batch_rows_;
+    double latency_p50_seconds_;
+    double latency_p99_seconds_;
+    uint32_t workers_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_graph_2eproto;
 };
-// ===================================================================
-
-
-// ===================================================================
-
-#ifdef __GNUC__
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif  // __GNUC__
-// GetWeights
-
 // -------------------------------------------------------------------
 
-// GetWeightsResponse
+class Predict final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:seegnify.graph.Predict) */ {
+ public:
+  inline Predict() : Predict(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR Predict(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-// required bytes weights = 1;
-inline bool GetWeightsResponse::_internal_has_weights() const {
-  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
-  return value;
-}
-inline bool GetWeightsResponse::has_weights() const {
-  return _internal_has_weights();
-}
-inline void GetWeightsResponse::clear_weights() {
-  _impl_.weights_.ClearToEmpty();
-  _impl_._has_bits_[0] &= ~0x00000001u;
-}
-inline const std::string& GetWeightsResponse::weights() const {
-  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeightsResponse.weights)
-  return _internal_weights();
-}
-template <typename ArgT0, typename... ArgT>
-inline PROTOBUF_ALWAYS_INLINE
-void GetWeightsResponse::set_weights(ArgT0&& arg0, ArgT... args) {
- _impl_._has_bits_[0] |= 0x00000001u;
- _impl_.weights_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeightsResponse.weights)
-}
-inline std::string* GetWeightsResponse::mutable_weights() {
-  std::string* _s = _internal_mutable_weights();
-  // @@protoc_insertion_point(field_mutable:seegnify.graph.GetWeightsResponse.weights)
-  return _s;
-}
-inline const std::string& GetWeightsResponse::_internal_weights() const {
-  return _impl_.weights_.Get();
-}
-inline void GetWeightsResponse::_internal_set_weights(const std::string& value) {
-  _impl_._has_bits_[0] |= 0x00000001u;
-  _impl_.weights_.Set(value, GetArenaForAllocation());
-}
-inline std::string* GetWeightsResponse::_internal_mutable_weights() {
-  _impl_._has_bits_[0] |= 0x00000001u;
-  return _impl_.weights_.Mutable(GetArenaForAllocation());
-}
-inline std::string* GetWeightsResponse::release_weights() {
-  // @@protoc_insertion_point(field_release:seegnify.graph.GetWeightsResponse.weights)
-  if (!_internal_has_weights()) {
-    return nullptr;
+  Predict(const Predict& from);
+  Predict(Predict&& from) noexcept
+    : Predict() {
+    *this = ::std::move(from);
   }
-  _impl_._has_bits_[0] &= ~0x00000001u;
-  auto* p = _impl_.weights_.Release();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.weights_.IsDefault()) {
-    _impl_.weights_.Set("", GetArenaForAllocation());
+
+  inline Predict& operator=(const Predict& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Predict& operator=(Predict&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Predict& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Predict* internal_default_instance() {
+    return reinterpret_cast<const Predict*>(
+               &_Predict_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    8;
+
+  friend void swap(Predict& a, Predict& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Predict* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Predict* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Predict* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Predict>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const Predict& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const Predict& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  }
+  public:
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "seegnify.graph.Predict";
+  }
+  protected:
+  explicit Predict(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.Predict)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+  };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// -------------------------------------------------------------------
+
+class PredictResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase /* @@protoc_insertion_point(class_definition:seegnify.graph.PredictResponse) */ {
+ public:
+  inline PredictResponse() : PredictResponse(nullptr) {}
+  explicit PROTOBUF_CONSTEXPR PredictResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  PredictResponse(const PredictResponse& from);
+  PredictResponse(PredictResponse&& from) noexcept
+    : PredictResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline PredictResponse& operator=(const PredictResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline PredictResponse& operator=(PredictResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const PredictResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const PredictResponse* internal_default_instance() {
+    return reinterpret_cast<const PredictResponse*>(
+               &_PredictResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    9;
+
+  friend void swap(PredictResponse& a, PredictResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(PredictResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(PredictResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  PredictResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<PredictResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyFrom;
+  inline void CopyFrom(const PredictResponse& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::CopyImpl(*this, from);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeFrom;
+  void MergeFrom(const PredictResponse& from) {
+    ::PROTOBUF_NAMESPACE_ID::internal::ZeroFieldsBase::MergeImpl(*this, from);
+  }
+  public:
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "seegnify.graph.PredictResponse";
+  }
+  protected:
+  explicit PredictResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.PredictResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+  };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SuccessResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.SuccessResponse) */ {
+ public:
+  inline SuccessResponse() : SuccessResponse(nullptr) {}
+  ~SuccessResponse() override;
+  explicit PROTOBUF_CONSTEXPR SuccessResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SuccessResponse(const SuccessResponse& from);
+  SuccessResponse(SuccessResponse&& from) noexcept
+    : SuccessResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline SuccessResponse& operator=(const SuccessResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SuccessResponse& operator=(SuccessResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SuccessResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SuccessResponse* internal_default_instance() {
+    return reinterpret_cast<const SuccessResponse*>(
+               &_SuccessResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    10;
+
+  friend void swap(SuccessResponse& a, SuccessResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SuccessResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SuccessResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SuccessResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SuccessResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SuccessResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SuccessResponse& from) {
+    SuccessResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SuccessResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "seegnify.graph.SuccessResponse";
+  }
+  protected:
+  explicit SuccessResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kScaleFieldNumber = 1,
+  };
+  // optional float scale = 1;
+  bool has_scale() const;
+  private:
+  bool _internal_has_scale() const;
+  public:
+  void clear_scale();
+  float scale() const;
+  void set_scale(float value);
+  private:
+  float _internal_scale() const;
+  void _internal_set_scale(float value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.SuccessResponse)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    float scale_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ErrorResponse final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.ErrorResponse) */ {
+ public:
+  inline ErrorResponse() : ErrorResponse(nullptr) {}
+  ~ErrorResponse() override;
+  explicit PROTOBUF_CONSTEXPR ErrorResponse(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ErrorResponse(const ErrorResponse& from);
+  ErrorResponse(ErrorResponse&& from) noexcept
+    : ErrorResponse() {
+    *this = ::std::move(from);
+  }
+
+  inline ErrorResponse& operator=(const ErrorResponse& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ErrorResponse& operator=(ErrorResponse&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ErrorResponse& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ErrorResponse* internal_default_instance() {
+    return reinterpret_cast<const ErrorResponse*>(
+               &_ErrorResponse_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    11;
+
+  friend void swap(ErrorResponse& a, ErrorResponse& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(ErrorResponse* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(ErrorResponse* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  ErrorResponse* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<ErrorResponse>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const ErrorResponse& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const ErrorResponse& from) {
+    ErrorResponse::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(ErrorResponse* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "seegnify.graph.ErrorResponse";
+  }
+  protected:
+  explicit ErrorResponse(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kMessageFieldNumber = 2,
+    kStatusFieldNumber = 1,
+  };
+  // required string message = 2;
+  bool has_message() const;
+  private:
+  bool _internal_has_message() const;
+  public:
+  void clear_message();
+  const std::string& message() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_message(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_message();
+  PROTOBUF_NODISCARD std::string* release_message();
+  void set_allocated_message(std::string* message);
+  private:
+  const std::string& _internal_message() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_message(const std::string& value);
+  std::string* _internal_mutable_message();
+  public:
+
+  // required uint32 status = 1;
+  bool has_status() const;
+  private:
+  bool _internal_has_status() const;
+  public:
+  void clear_status();
+  uint32_t status() const;
+  void set_status(uint32_t value);
+  private:
+  uint32_t _internal_status() const;
+  void _internal_set_status(uint32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:seegnify.graph.ErrorResponse)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr message_;
+    uint32_t status_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Request final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.Request) */ {
+ public:
+  inline Request() : Request(nullptr) {}
+  ~Request() override;
+  explicit PROTOBUF_CONSTEXPR Request(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Request(const Request& from);
+  Request(Request&& from) noexcept
+    : Request() {
+    *this = ::std::move(from);
+  }
+
+  inline Request& operator=(const Request& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Request& operator=(Request&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Request& default_instance() {
+    return *internal_default_instance();
+  }
+  enum RequestCase {
+    kGetWeights = 10,
+    kSetWeights = 11,
+    kUpdWeights = 12,
+    kGetStats = 13,
+    kPredict = 14,
+    REQUEST_NOT_SET = 0,
+  };
+
+  static inline const Request* internal_default_instance() {
+    return reinterpret_cast<const Request*>(
+               &_Request_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    12;
+
+  friend void swap(Request& a, Request& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Request* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Request* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Request* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Request>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Request& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Request& from) {
+    Request::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Request* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "seegnify.graph.Request";
+  }
+  protected:
+  explicit Request(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kIdFieldNumber = 1,
+    kPayloadFieldNumber = 2,
+    kDeflateFieldNumber = 3,
+    kGetWeightsFieldNumber = 10,
+    kSetWeightsFieldNumber = 11,
+    kUpdWeightsFieldNumber = 12,
+    kGetStatsFieldNumber = 13,
+    kPredictFieldNumber = 14,
+  };
+  // optional uint64 id = 1;
+  bool has_id() const;
+  private:
+  bool _internal_has_id() const;
+  public:
+  void clear_id();
+  uint64_t id() const;
+  void set_id(uint64_t value);
+  private:
+  uint64_t _internal_id() const;
+  void _internal_set_id(uint64_t value);
+  public:
+
+  // optional bool payload = 2;
+  bool has_payload() const;
+  private:
+  bool _internal_has_payload() const;
+  public:
+  void clear_payload();
+  bool payload() const;
+  void set_payload(bool value);
+  private:
+  bool _internal_payload() const;
+  void _internal_set_payload(bool value);
+  public:
+
+  // optional bool deflate = 3;
+  bool has_deflate() const;
+  private:
+  bool _internal_has_deflate() const;
+  public:
+  void clear_deflate();
+  bool deflate() const;
+  void set_deflate(bool value);
+  private:
+  bool _internal_deflate() const;
+  void _internal_set_deflate(bool value);
+  public:
+
+  // .seegnify.graph.GetWeights get_weights = 10;
+  bool has_get_weights() const;
+  private:
+  bool _internal_has_get_weights() const;
+  public:
+  void clear_get_weights();
+  const ::seegnify::graph::GetWeights& get_weights() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::GetWeights* release_get_weights();
+  ::seegnify::graph::GetWeights* mutable_get_weights();
+  void set_allocated_get_weights(::seegnify::graph::GetWeights* get_weights);
+  private:
+  const ::seegnify::graph::GetWeights& _internal_get_weights() const;
+  ::seegnify::graph::GetWeights* _internal_mutable_get_weights();
+  public:
+  void unsafe_arena_set_allocated_get_weights(
+      ::seegnify::graph::GetWeights* get_weights);
+  ::seegnify::graph::GetWeights* unsafe_arena_release_get_weights();
+
+  // .seegnify.graph.SetWeights set_weights = 11;
+  bool has_set_weights() const;
+  private:
+  bool _internal_has_set_weights() const;
+  public:
+  void clear_set_weights();
+  const ::seegnify::graph::SetWeights& set_weights() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::SetWeights* release_set_weights();
+  ::seegnify::graph::SetWeights* mutable_set_weights();
+  void set_allocated_set_weights(::seegnify::graph::SetWeights* set_weights);
+  private:
+  const ::seegnify::graph::SetWeights& _internal_set_weights() const;
+  ::seegnify::graph::SetWeights* _internal_mutable_set_weights();
+  public:
+  void unsafe_arena_set_allocated_set_weights(
+      ::seegnify::graph::SetWeights* set_weights);
+  ::seegnify::graph::SetWeights* unsafe_arena_release_set_weights();
+
+  // .seegnify.graph.UpdWeights upd_weights = 12;
+  bool has_upd_weights() const;
+  private:
+  bool _internal_has_upd_weights() const;
+  public:
+  void clear_upd_weights();
+  const ::seegnify::graph::UpdWeights& upd_weights() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::UpdWeights* release_upd_weights();
+  ::seegnify::graph::UpdWeights* mutable_upd_weights();
+  void set_allocated_upd_weights(::seegnify::graph::UpdWeights* upd_weights);
+  private:
+  const ::seegnify::graph::UpdWeights& _internal_upd_weights() const;
+  ::seegnify::graph::UpdWeights* _internal_mutable_upd_weights();
+  public:
+  void unsafe_arena_set_allocated_upd_weights(
+      ::seegnify::graph::UpdWeights* upd_weights);
+  ::seegnify::graph::UpdWeights* unsafe_arena_release_upd_weights();
+
+  // .seegnify.graph.GetStats get_stats = 13;
+  bool has_get_stats() const;
+  private:
+  bool _internal_has_get_stats() const;
+  public:
+  void clear_get_stats();
+  const ::seegnify::graph::GetStats& get_stats() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::GetStats* release_get_stats();
+  ::seegnify::graph::GetStats* mutable_get_stats();
+  void set_allocated_get_stats(::seegnify::graph::GetStats* get_stats);
+  private:
+  const ::seegnify::graph::GetStats& _internal_get_stats() const;
+  ::seegnify::graph::GetStats* _internal_mutable_get_stats();
+  public:
+  void unsafe_arena_set_allocated_get_stats(
+      ::seegnify::graph::GetStats* get_stats);
+  ::seegnify::graph::GetStats* unsafe_arena_release_get_stats();
+
+  // .seegnify.graph.Predict predict = 14;
+  bool has_predict() const;
+  private:
+  bool _internal_has_predict() const;
+  public:
+  void clear_predict();
+  const ::seegnify::graph::Predict& predict() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::Predict* release_predict();
+  ::seegnify::graph::Predict* mutable_predict();
+  void set_allocated_predict(::seegnify::graph::Predict* predict);
+  private:
+  const ::seegnify::graph::Predict& _internal_predict() const;
+  ::seegnify::graph::Predict* _internal_mutable_predict();
+  public:
+  void unsafe_arena_set_allocated_predict(
+      ::seegnify::graph::Predict* predict);
+  ::seegnify::graph::Predict* unsafe_arena_release_predict();
+
+  void clear_request();
+  RequestCase request_case() const;
+  // @@protoc_insertion_point(class_scope:seegnify.graph.Request)
+ private:
+  class _Internal;
+  void set_has_get_weights();
+  void set_has_set_weights();
+  void set_has_upd_weights();
+  void set_has_get_stats();
+  void set_has_predict();
+
+  inline bool has_request() const;
+  inline void clear_has_request();
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t id_;
+    bool payload_;
+    bool deflate_;
+    union RequestUnion {
+      constexpr RequestUnion() : _constinit_{} {}
+        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
+      ::seegnify::graph::GetWeights* get_weights_;
+      ::seegnify::graph::SetWeights* set_weights_;
+      ::seegnify::graph::UpdWeights* upd_weights_;
+      ::seegnify::graph::GetStats* get_stats_;
+      ::seegnify::graph::Predict* predict_;
+    } request_;
+    uint32_t _oneof_case_[1];
+
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Response final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:seegnify.graph.Response) */ {
+ public:
+  inline Response() : Response(nullptr) {}
+  ~Response() override;
+  explicit PROTOBUF_CONSTEXPR Response(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Response(const Response& from);
+  Response(Response&& from) noexcept
+    : Response() {
+    *this = ::std::move(from);
+  }
+
+  inline Response& operator=(const Response& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Response& operator=(Response&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Response& default_instance() {
+    return *internal_default_instance();
+  }
+  enum ResponseCase {
+    kGetWeights = 11,
+    kSuccess = 12,
+    kError = 13,
+    kGetStats = 14,
+    kPredict = 15,
+    RESPONSE_NOT_SET = 0,
+  };
+
+  static inline const Response* internal_default_instance() {
+    return reinterpret_cast<const Response*>(
+               &_Response_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    13;
+
+  friend void swap(Response& a, Response& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Response* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Response* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Response* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Response>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Response& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Response& from) {
+    Response::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Response* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "seegnify.graph.Response";
+  }
+  protected:
+  explicit Response(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kIdFieldNumber = 1,
+    kPayloadFieldNumber = 2,
+    kDeflateFieldNumber = 3,
+    kGetWeightsFieldNumber = 11,
+    kSuccessFieldNumber = 12,
+    kErrorFieldNumber = 13,
+    kGetStatsFieldNumber = 14,
+    kPredictFieldNumber = 15,
+  };
+  // optional uint64 id = 1;
+  bool has_id() const;
+  private:
+  bool _internal_has_id() const;
+  public:
+  void clear_id();
+  uint64_t id() const;
+  void set_id(uint64_t value);
+  private:
+  uint64_t _internal_id() const;
+  void _internal_set_id(uint64_t value);
+  public:
+
+  // optional bool payload = 2;
+  bool has_payload() const;
+  private:
+  bool _internal_has_payload() const;
+  public:
+  void clear_payload();
+  bool payload() const;
+  void set_payload(bool value);
+  private:
+  bool _internal_payload() const;
+  void _internal_set_payload(bool value);
+  public:
+
+  // optional bool deflate = 3;
+  bool has_deflate() const;
+  private:
+  bool _internal_has_deflate() const;
+  public:
+  void clear_deflate();
+  bool deflate() const;
+  void set_deflate(bool value);
+  private:
+  bool _internal_deflate() const;
+  void _internal_set_deflate(bool value);
+  public:
+
+  // .seegnify.graph.GetWeightsResponse get_weights = 11;
+  bool has_get_weights() const;
+  private:
+  bool _internal_has_get_weights() const;
+  public:
+  void clear_get_weights();
+  const ::seegnify::graph::GetWeightsResponse& get_weights() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::GetWeightsResponse* release_get_weights();
+  ::seegnify::graph::GetWeightsResponse* mutable_get_weights();
+  void set_allocated_get_weights(::seegnify::graph::GetWeightsResponse* get_weights);
+  private:
+  const ::seegnify::graph::GetWeightsResponse& _internal_get_weights() const;
+  ::seegnify::graph::GetWeightsResponse* _internal_mutable_get_weights();
+  public:
+  void unsafe_arena_set_allocated_get_weights(
+      ::seegnify::graph::GetWeightsResponse* get_weights);
+  ::seegnify::graph::GetWeightsResponse* unsafe_arena_release_get_weights();
+
+  // .seegnify.graph.SuccessResponse success = 12;
+  bool has_success() const;
+  private:
+  bool _internal_has_success() const;
+  public:
+  void clear_success();
+  const ::seegnify::graph::SuccessResponse& success() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::SuccessResponse* release_success();
+  ::seegnify::graph::SuccessResponse* mutable_success();
+  void set_allocated_success(::seegnify::graph::SuccessResponse* success);
+  private:
+  const ::seegnify::graph::SuccessResponse& _internal_success() const;
+  ::seegnify::graph::SuccessResponse* _internal_mutable_success();
+  public:
+  void unsafe_arena_set_allocated_success(
+      ::seegnify::graph::SuccessResponse* success);
+  ::seegnify::graph::SuccessResponse* unsafe_arena_release_success();
+
+  // .seegnify.graph.ErrorResponse error = 13;
+  bool has_error() const;
+  private:
+  bool _internal_has_error() const;
+  public:
+  void clear_error();
+  const ::seegnify::graph::ErrorResponse& error() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::ErrorResponse* release_error();
+  ::seegnify::graph::ErrorResponse* mutable_error();
+  void set_allocated_error(::seegnify::graph::ErrorResponse* error);
+  private:
+  const ::seegnify::graph::ErrorResponse& _internal_error() const;
+  ::seegnify::graph::ErrorResponse* _internal_mutable_error();
+  public:
+  void unsafe_arena_set_allocated_error(
+      ::seegnify::graph::ErrorResponse* error);
+  ::seegnify::graph::ErrorResponse* unsafe_arena_release_error();
+
+  // .seegnify.graph.GetStatsResponse get_stats = 14;
+  bool has_get_stats() const;
+  private:
+  bool _internal_has_get_stats() const;
+  public:
+  void clear_get_stats();
+  const ::seegnify::graph::GetStatsResponse& get_stats() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::GetStatsResponse* release_get_stats();
+  ::seegnify::graph::GetStatsResponse* mutable_get_stats();
+  void set_allocated_get_stats(::seegnify::graph::GetStatsResponse* get_stats);
+  private:
+  const ::seegnify::graph::GetStatsResponse& _internal_get_stats() const;
+  ::seegnify::graph::GetStatsResponse* _internal_mutable_get_stats();
+  public:
+  void unsafe_arena_set_allocated_get_stats(
+      ::seegnify::graph::GetStatsResponse* get_stats);
+  ::seegnify::graph::GetStatsResponse* unsafe_arena_release_get_stats();
+
+  // .seegnify.graph.PredictResponse predict = 15;
+  bool has_predict() const;
+  private:
+  bool _internal_has_predict() const;
+  public:
+  void clear_predict();
+  const ::seegnify::graph::PredictResponse& predict() const;
+  PROTOBUF_NODISCARD ::seegnify::graph::PredictResponse* release_predict();
+  ::seegnify::graph::PredictResponse* mutable_predict();
+  void set_allocated_predict(::seegnify::graph::PredictResponse* predict);
+  private:
+  const ::seegnify::graph::PredictResponse& _internal_predict() const;
+  ::seegnify::graph::PredictResponse* _internal_mutable_predict();
+  public:
+  void unsafe_arena_set_allocated_predict(
+      ::seegnify::graph::PredictResponse* predict);
+  ::seegnify::graph::PredictResponse* unsafe_arena_release_predict();
+
+  void clear_response();
+  ResponseCase response_case() const;
+  // @@protoc_insertion_point(class_scope:seegnify.graph.Response)
+ private:
+  class _Internal;
+  void set_has_get_weights();
+  void set_has_success();
+  void set_has_error();
+  void set_has_get_stats();
+  void set_has_predict();
+
+  inline bool has_response() const;
+  inline void clear_has_response();
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t id_;
+    bool payload_;
+    bool deflate_;
+    union ResponseUnion {
+      constexpr ResponseUnion() : _constinit_{} {}
+        ::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized _constinit_;
+      ::seegnify::graph::GetWeightsResponse* get_weights_;
+      ::seegnify::graph::SuccessResponse* success_;
+      ::seegnify::graph::ErrorResponse* error_;
+      ::seegnify::graph::GetStatsResponse* get_stats_;
+      ::seegnify::graph::PredictResponse* predict_;
+    } response_;
+    uint32_t _oneof_case_[1];
+
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_graph_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// GetWeights
+
+// repeated uint64 since_version = 1 [packed = true];
+inline int GetWeights::_internal_since_version_size() const {
+  return _impl_.since_version_.size();
+}
+inline int GetWeights::since_version_size() const {
+  return _internal_since_version_size();
+}
+inline void GetWeights::clear_since_version() {
+  _impl_.since_version_.Clear();
+}
+inline uint64_t GetWeights::_internal_since_version(int index) const {
+  return _impl_.since_version_.Get(index);
+}
+inline uint64_t GetWeights::since_version(int index) const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeights.since_version)
+  return _internal_since_version(index);
+}
+inline void GetWeights::set_since_version(int index, uint64_t value) {
+  _impl_.since_version_.Set(index, value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeights.since_version)
+}
+inline void GetWeights::_internal_add_since_version(uint64_t value) {
+  _impl_.since_version_.Add(value);
+}
+inline void GetWeights::add_since_version(uint64_t value) {
+  _internal_add_since_version(value);
+  // @@protoc_insertion_point(field_add:seegnify.graph.GetWeights.since_version)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+GetWeights::_internal_since_version() const {
+  return _impl_.since_version_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+GetWeights::since_version() const {
+  // @@protoc_insertion_point(field_list:seegnify.graph.GetWeights.since_version)
+  return _internal_since_version();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+GetWeights::_internal_mutable_since_version() {
+  return &_impl_.since_version_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+GetWeights::mutable_since_version() {
+  // @@protoc_insertion_point(field_mutable_list:seegnify.graph.GetWeights.since_version)
+  return _internal_mutable_since_version();
+}
+
+// optional uint64 worker = 2;
+inline bool GetWeights::_internal_has_worker() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool GetWeights::has_worker() const {
+  return _internal_has_worker();
+}
+inline void GetWeights::clear_worker() {
+  _impl_.worker_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t GetWeights::_internal_worker() const {
+  return _impl_.worker_;
+}
+inline uint64_t GetWeights::worker() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeights.worker)
+  return _internal_worker();
+}
+inline void GetWeights::_internal_set_worker(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.worker_ = value;
+}
+inline void GetWeights::set_worker(uint64_t value) {
+  _internal_set_worker(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeights.worker)
+}
+
+// optional uint64 clock = 3;
+inline bool GetWeights::_internal_has_clock() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool GetWeights::has_clock() const {
+  return _internal_has_clock();
+}
+inline void GetWeights::clear_clock() {
+  _impl_.clock_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t GetWeights::_internal_clock() const {
+  return _impl_.clock_;
+}
+inline uint64_t GetWeights::clock() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeights.clock)
+  return _internal_clock();
+}
+inline void GetWeights::_internal_set_clock(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.clock_ = value;
+}
+inline void GetWeights::set_clock(uint64_t value) {
+  _internal_set_clock(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeights.clock)
+}
+
+// optional uint32 precision = 4;
+inline bool GetWeights::_internal_has_precision() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool GetWeights::has_precision() const {
+  return _internal_has_precision();
+}
+inline void GetWeights::clear_precision() {
+  _impl_.precision_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint32_t GetWeights::_internal_precision() const {
+  return _impl_.precision_;
+}
+inline uint32_t GetWeights::precision() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeights.precision)
+  return _internal_precision();
+}
+inline void GetWeights::_internal_set_precision(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.precision_ = value;
+}
+inline void GetWeights::set_precision(uint32_t value) {
+  _internal_set_precision(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeights.precision)
+}
+
+// -------------------------------------------------------------------
+
+// GetWeightsResponse
+
+// repeated uint64 version = 2 [packed = true];
+inline int GetWeightsResponse::_internal_version_size() const {
+  return _impl_.version_.size();
+}
+inline int GetWeightsResponse::version_size() const {
+  return _internal_version_size();
+}
+inline void GetWeightsResponse::clear_version() {
+  _impl_.version_.Clear();
+}
+inline uint64_t GetWeightsResponse::_internal_version(int index) const {
+  return _impl_.version_.Get(index);
+}
+inline uint64_t GetWeightsResponse::version(int index) const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeightsResponse.version)
+  return _internal_version(index);
+}
+inline void GetWeightsResponse::set_version(int index, uint64_t value) {
+  _impl_.version_.Set(index, value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeightsResponse.version)
+}
+inline void GetWeightsResponse::_internal_add_version(uint64_t value) {
+  _impl_.version_.Add(value);
+}
+inline void GetWeightsResponse::add_version(uint64_t value) {
+  _internal_add_version(value);
+  // @@protoc_insertion_point(field_add:seegnify.graph.GetWeightsResponse.version)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+GetWeightsResponse::_internal_version() const {
+  return _impl_.version_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+GetWeightsResponse::version() const {
+  // @@protoc_insertion_point(field_list:seegnify.graph.GetWeightsResponse.version)
+  return _internal_version();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+GetWeightsResponse::_internal_mutable_version() {
+  return &_impl_.version_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+GetWeightsResponse::mutable_version() {
+  // @@protoc_insertion_point(field_mutable_list:seegnify.graph.GetWeightsResponse.version)
+  return _internal_mutable_version();
+}
+
+// optional bool delta = 3;
+inline bool GetWeightsResponse::_internal_has_delta() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool GetWeightsResponse::has_delta() const {
+  return _internal_has_delta();
+}
+inline void GetWeightsResponse::clear_delta() {
+  _impl_.delta_ = false;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline bool GetWeightsResponse::_internal_delta() const {
+  return _impl_.delta_;
+}
+inline bool GetWeightsResponse::delta() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeightsResponse.delta)
+  return _internal_delta();
+}
+inline void GetWeightsResponse::_internal_set_delta(bool value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.delta_ = value;
+}
+inline void GetWeightsResponse::set_delta(bool value) {
+  _internal_set_delta(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeightsResponse.delta)
+}
+
+// optional uint64 updates = 4;
+inline bool GetWeightsResponse::_internal_has_updates() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool GetWeightsResponse::has_updates() const {
+  return _internal_has_updates();
+}
+inline void GetWeightsResponse::clear_updates() {
+  _impl_.updates_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t GetWeightsResponse::_internal_updates() const {
+  return _impl_.updates_;
+}
+inline uint64_t GetWeightsResponse::updates() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetWeightsResponse.updates)
+  return _internal_updates();
+}
+inline void GetWeightsResponse::_internal_set_updates(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.updates_ = value;
+}
+inline void GetWeightsResponse::set_updates(uint64_t value) {
+  _internal_set_updates(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetWeightsResponse.updates)
+}
+
+// -------------------------------------------------------------------
+
+// SetWeights
+
+// -------------------------------------------------------------------
+
+// UpdWeights
+
+// optional uint32 compression = 2;
+inline bool UpdWeights::_internal_has_compression() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool UpdWeights::has_compression() const {
+  return _internal_has_compression();
+}
+inline void UpdWeights::clear_compression() {
+  _impl_.compression_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline uint32_t UpdWeights::_internal_compression() const {
+  return _impl_.compression_;
+}
+inline uint32_t UpdWeights::compression() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.compression)
+  return _internal_compression();
+}
+inline void UpdWeights::_internal_set_compression(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.compression_ = value;
+}
+inline void UpdWeights::set_compression(uint32_t value) {
+  _internal_set_compression(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.compression)
+}
+
+// optional uint64 worker = 3;
+inline bool UpdWeights::_internal_has_worker() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool UpdWeights::has_worker() const {
+  return _internal_has_worker();
+}
+inline void UpdWeights::clear_worker() {
+  _impl_.worker_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t UpdWeights::_internal_worker() const {
+  return _impl_.worker_;
+}
+inline uint64_t UpdWeights::worker() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.worker)
+  return _internal_worker();
+}
+inline void UpdWeights::_internal_set_worker(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.worker_ = value;
+}
+inline void UpdWeights::set_worker(uint64_t value) {
+  _internal_set_worker(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.worker)
+}
+
+// optional uint64 clock = 4;
+inline bool UpdWeights::_internal_has_clock() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool UpdWeights::has_clock() const {
+  return _internal_has_clock();
+}
+inline void UpdWeights::clear_clock() {
+  _impl_.clock_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t UpdWeights::_internal_clock() const {
+  return _impl_.clock_;
+}
+inline uint64_t UpdWeights::clock() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.clock)
+  return _internal_clock();
+}
+inline void UpdWeights::_internal_set_clock(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.clock_ = value;
+}
+inline void UpdWeights::set_clock(uint64_t value) {
+  _internal_set_clock(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.clock)
+}
+
+// optional uint64 updates = 5;
+inline bool UpdWeights::_internal_has_updates() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool UpdWeights::has_updates() const {
+  return _internal_has_updates();
+}
+inline void UpdWeights::clear_updates() {
+  _impl_.updates_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t UpdWeights::_internal_updates() const {
+  return _impl_.updates_;
+}
+inline uint64_t UpdWeights::updates() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.updates)
+  return _internal_updates();
+}
+inline void UpdWeights::_internal_set_updates(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.updates_ = value;
+}
+inline void UpdWeights::set_updates(uint64_t value) {
+  _internal_set_updates(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.updates)
+}
+
+// optional double compute_seconds = 6;
+inline bool UpdWeights::_internal_has_compute_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool UpdWeights::has_compute_seconds() const {
+  return _internal_has_compute_seconds();
+}
+inline void UpdWeights::clear_compute_seconds() {
+  _impl_.compute_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline double UpdWeights::_internal_compute_seconds() const {
+  return _impl_.compute_seconds_;
+}
+inline double UpdWeights::compute_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.compute_seconds)
+  return _internal_compute_seconds();
+}
+inline void UpdWeights::_internal_set_compute_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.compute_seconds_ = value;
+}
+inline void UpdWeights::set_compute_seconds(double value) {
+  _internal_set_compute_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.compute_seconds)
+}
+
+// optional double comm_seconds = 7;
+inline bool UpdWeights::_internal_has_comm_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool UpdWeights::has_comm_seconds() const {
+  return _internal_has_comm_seconds();
+}
+inline void UpdWeights::clear_comm_seconds() {
+  _impl_.comm_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline double UpdWeights::_internal_comm_seconds() const {
+  return _impl_.comm_seconds_;
+}
+inline double UpdWeights::comm_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.comm_seconds)
+  return _internal_comm_seconds();
+}
+inline void UpdWeights::_internal_set_comm_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.comm_seconds_ = value;
+}
+inline void UpdWeights::set_comm_seconds(double value) {
+  _internal_set_comm_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.comm_seconds)
+}
+
+// -------------------------------------------------------------------
+
+// GetStats
+
+// -------------------------------------------------------------------
+
+// RequestStats
+
+// required string name = 1;
+inline bool RequestStats::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool RequestStats::has_name() const {
+  return _internal_has_name();
+}
+inline void RequestStats::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& RequestStats::name() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.RequestStats.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void RequestStats::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:seegnify.graph.RequestStats.name)
+}
+inline std::string* RequestStats::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.RequestStats.name)
+  return _s;
+}
+inline const std::string& RequestStats::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void RequestStats::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* RequestStats::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* RequestStats::release_name() {
+  // @@protoc_insertion_point(field_release:seegnify.graph.RequestStats.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
   }
 #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   return p;
 }
-inline void GetWeightsResponse::set_allocated_weights(std::string* weights) {
-  if (weights != nullptr) {
-    _impl_._has_bits_[0] |= 0x00000001u;
-  } else {
-    _impl_._has_bits_[0] &= ~0x00000001u;
-  }
-  _impl_.weights_.SetAllocated(weights, GetArenaForAllocation());
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.weights_.IsDefault()) {
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.GetWeightsResponse.weights)
+inline void RequestStats::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.RequestStats.name)
+}
+
+// optional uint64 count = 2;
+inline bool RequestStats::_internal_has_count() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool RequestStats::has_count() const {
+  return _internal_has_count();
+}
+inline void RequestStats::clear_count() {
+  _impl_.count_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t RequestStats::_internal_count() const {
+  return _impl_.count_;
+}
+inline uint64_t RequestStats::count() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.RequestStats.count)
+  return _internal_count();
+}
+inline void RequestStats::_internal_set_count(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.count_ = value;
+}
+inline void RequestStats::set_count(uint64_t value) {
+  _internal_set_count(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.RequestStats.count)
+}
+
+// optional uint64 bytes_in = 3;
+inline bool RequestStats::_internal_has_bytes_in() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool RequestStats::has_bytes_in() const {
+  return _internal_has_bytes_in();
+}
+inline void RequestStats::clear_bytes_in() {
+  _impl_.bytes_in_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t RequestStats::_internal_bytes_in() const {
+  return _impl_.bytes_in_;
+}
+inline uint64_t RequestStats::bytes_in() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.RequestStats.bytes_in)
+  return _internal_bytes_in();
+}
+inline void RequestStats::_internal_set_bytes_in(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.bytes_in_ = value;
+}
+inline void RequestStats::set_bytes_in(uint64_t value) {
+  _internal_set_bytes_in(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.RequestStats.bytes_in)
+}
+
+// optional uint64 bytes_out = 4;
+inline bool RequestStats::_internal_has_bytes_out() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool RequestStats::has_bytes_out() const {
+  return _internal_has_bytes_out();
+}
+inline void RequestStats::clear_bytes_out() {
+  _impl_.bytes_out_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline uint64_t RequestStats::_internal_bytes_out() const {
+  return _impl_.bytes_out_;
+}
+inline uint64_t RequestStats::bytes_out() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.RequestStats.bytes_out)
+  return _internal_bytes_out();
+}
+inline void RequestStats::_internal_set_bytes_out(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.bytes_out_ = value;
+}
+inline void RequestStats::set_bytes_out(uint64_t value) {
+  _internal_set_bytes_out(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.RequestStats.bytes_out)
+}
+
+// repeated uint64 latency = 5 [packed = true];
+inline int RequestStats::_internal_latency_size() const {
+  return _impl_.latency_.size();
+}
+inline int RequestStats::latency_size() const {
+  return _internal_latency_size();
+}
+inline void RequestStats::clear_latency() {
+  _impl_.latency_.Clear();
+}
+inline uint64_t RequestStats::_internal_latency(int index) const {
+  return _impl_.latency_.Get(index);
+}
+inline uint64_t RequestStats::latency(int index) const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.RequestStats.latency)
+  return _internal_latency(index);
+}
+inline void RequestStats::set_latency(int index, uint64_t value) {
+  _impl_.latency_.Set(index, value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.RequestStats.latency)
+}
+inline void RequestStats::_internal_add_latency(uint64_t value) {
+  _impl_.latency_.Add(value);
+}
+inline void RequestStats::add_latency(uint64_t value) {
+  _internal_add_latency(value);
+  // @@protoc_insertion_point(field_add:seegnify.graph.RequestStats.latency)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+RequestStats::_internal_latency() const {
+  return _impl_.latency_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >&
+RequestStats::latency() const {
+  // @@protoc_insertion_point(field_list:seegnify.graph.RequestStats.latency)
+  return _internal_latency();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+RequestStats::_internal_mutable_latency() {
+  return &_impl_.latency_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< uint64_t >*
+RequestStats::mutable_latency() {
+  // @@protoc_insertion_point(field_mutable_list:seegnify.graph.RequestStats.latency)
+  return _internal_mutable_latency();
 }
 
 // -------------------------------------------------------------------
 
-// SetWeights
+// WorkerStats
 
-// required bytes weights = 1;
-inline bool SetWeights::_internal_has_weights() const {
+// required uint64 worker = 1;
+inline bool WorkerStats::_internal_has_worker() const {
   bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
-inline bool SetWeights::has_weights() const {
-  return _internal_has_weights();
+inline bool WorkerStats::has_worker() const {
+  return _internal_has_worker();
 }
-inline void SetWeights::clear_weights() {
-  _impl_.weights_.ClearToEmpty();
+inline void WorkerStats::clear_worker() {
+  _impl_.worker_ = uint64_t{0u};
   _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline const std::string& SetWeights::weights() const {
-  // @@protoc_insertion_point(field_get:seegnify.graph.SetWeights.weights)
-  return _internal_weights();
+inline uint64_t WorkerStats::_internal_worker() const {
+  return _impl_.worker_;
 }
-template <typename ArgT0, typename... ArgT>
-inline PROTOBUF_ALWAYS_INLINE
-void SetWeights::set_weights(ArgT0&& arg0, ArgT... args) {
- _impl_._has_bits_[0] |= 0x00000001u;
- _impl_.weights_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:seegnify.graph.SetWeights.weights)
+inline uint64_t WorkerStats::worker() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.WorkerStats.worker)
+  return _internal_worker();
 }
-inline std::string* SetWeights::mutable_weights() {
-  std::string* _s = _internal_mutable_weights();
-  // @@protoc_insertion_point(field_mutable:seegnify.graph.SetWeights.weights)
-  return _s;
+inline void WorkerStats::_internal_set_worker(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.worker_ = value;
 }
-inline const std::string& SetWeights::_internal_weights() const {
-  return _impl_.weights_.Get();
+inline void WorkerStats::set_worker(uint64_t value) {
+  _internal_set_worker(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.WorkerStats.worker)
 }
-inline void SetWeights::_internal_set_weights(const std::string& value) {
-  _impl_._has_bits_[0] |= 0x00000001u;
-  _impl_.weights_.Set(value, GetArenaForAllocation());
+
+// optional uint64 clock = 2;
+inline bool WorkerStats::_internal_has_clock() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
 }
-inline std::string* SetWeights::_internal_mutable_weights() {
-  _impl_._has_bits_[0] |= 0x00000001u;
-  return _impl_.weights_.Mutable(GetArenaForAllocation());
+inline bool WorkerStats::has_clock() const {
+  return _internal_has_clock();
 }
-inline std::string* SetWeights::release_weights() {
-  // @@protoc_insertion_point(field_release:seegnify.graph.SetWeights.weights)
-  if (!_internal_has_weights()) {
-    return nullptr;
-  }
+inline void WorkerStats::clear_clock() {
+  _impl_.clock_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t WorkerStats::_internal_clock() const {
+  return _impl_.clock_;
+}
+inline uint64_t WorkerStats::clock() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.WorkerStats.clock)
+  return _internal_clock();
+}
+inline void WorkerStats::_internal_set_clock(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.clock_ = value;
+}
+inline void WorkerStats::set_clock(uint64_t value) {
+  _internal_set_clock(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.WorkerStats.clock)
+}
+
+// optional uint64 staleness = 3;
+inline bool WorkerStats::_internal_has_staleness() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool WorkerStats::has_staleness() const {
+  return _internal_has_staleness();
+}
+inline void WorkerStats::clear_staleness() {
+  _impl_.staleness_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline uint64_t WorkerStats::_internal_staleness() const {
+  return _impl_.staleness_;
+}
+inline uint64_t WorkerStats::staleness() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.WorkerStats.staleness)
+  return _internal_staleness();
+}
+inline void WorkerStats::_internal_set_staleness(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.staleness_ = value;
+}
+inline void WorkerStats::set_staleness(uint64_t value) {
+  _internal_set_staleness(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.WorkerStats.staleness)
+}
+
+// optional double idle_seconds = 4;
+inline bool WorkerStats::_internal_has_idle_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool WorkerStats::has_idle_seconds() const {
+  return _internal_has_idle_seconds();
+}
+inline void WorkerStats::clear_idle_seconds() {
+  _impl_.idle_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline double WorkerStats::_internal_idle_seconds() const {
+  return _impl_.idle_seconds_;
+}
+inline double WorkerStats::idle_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.WorkerStats.idle_seconds)
+  return _internal_idle_seconds();
+}
+inline void WorkerStats::_internal_set_idle_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.idle_seconds_ = value;
+}
+inline void WorkerStats::set_idle_seconds(double value) {
+  _internal_set_idle_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.WorkerStats.idle_seconds)
+}
+
+// optional double compute_seconds = 5;
+inline bool WorkerStats::_internal_has_compute_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool WorkerStats::has_compute_seconds() const {
+  return _internal_has_compute_seconds();
+}
+inline void WorkerStats::clear_compute_seconds() {
+  _impl_.compute_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline double WorkerStats::_internal_compute_seconds() const {
+  return _impl_.compute_seconds_;
+}
+inline double WorkerStats::compute_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.WorkerStats.compute_seconds)
+  return _internal_compute_seconds();
+}
+inline void WorkerStats::_internal_set_compute_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.compute_seconds_ = value;
+}
+inline void WorkerStats::set_compute_seconds(double value) {
+  _internal_set_compute_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.WorkerStats.compute_seconds)
+}
+
+// optional double comm_seconds = 6;
+inline bool WorkerStats::_internal_has_comm_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool WorkerStats::has_comm_seconds() const {
+  return _internal_has_comm_seconds();
+}
+inline void WorkerStats::clear_comm_seconds() {
+  _impl_.comm_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline double WorkerStats::_internal_comm_seconds() const {
+  return _impl_.comm_seconds_;
+}
+inline double WorkerStats::comm_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.WorkerStats.comm_seconds)
+  return _internal_comm_seconds();
+}
+inline void WorkerStats::_internal_set_comm_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.comm_seconds_ = value;
+}
+inline void WorkerStats::set_comm_seconds(double value) {
+  _internal_set_comm_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.WorkerStats.comm_seconds)
+}
+
+// -------------------------------------------------------------------
+
+// GetStatsResponse
+
+// optional double uptime_seconds = 1;
+inline bool GetStatsResponse::_internal_has_uptime_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_uptime_seconds() const {
+  return _internal_has_uptime_seconds();
+}
+inline void GetStatsResponse::clear_uptime_seconds() {
+  _impl_.uptime_seconds_ = 0;
   _impl_._has_bits_[0] &= ~0x00000001u;
-  auto* p = _impl_.weights_.Release();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.weights_.IsDefault()) {
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  return p;
 }
-inline void SetWeights::set_allocated_weights(std::string* weights) {
-  if (weights != nullptr) {
-    _impl_._has_bits_[0] |= 0x00000001u;
-  } else {
-    _impl_._has_bits_[0] &= ~0x00000001u;
-  }
-  _impl_.weights_.SetAllocated(weights, GetArenaForAllocation());
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.weights_.IsDefault()) {
-    _impl_.weights_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.SetWeights.weights)
+inline double GetStatsResponse::_internal_uptime_seconds() const {
+  return _impl_.uptime_seconds_;
+}
+inline double GetStatsResponse::uptime_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.uptime_seconds)
+  return _internal_uptime_seconds();
+}
+inline void GetStatsResponse::_internal_set_uptime_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.uptime_seconds_ = value;
+}
+inline void GetStatsResponse::set_uptime_seconds(double value) {
+  _internal_set_uptime_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.uptime_seconds)
+}
+
+// optional uint64 updates = 2;
+inline bool GetStatsResponse::_internal_has_updates() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_updates() const {
+  return _internal_has_updates();
+}
+inline void GetStatsResponse::clear_updates() {
+  _impl_.updates_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t GetStatsResponse::_internal_updates() const {
+  return _impl_.updates_;
+}
+inline uint64_t GetStatsResponse::updates() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.updates)
+  return _internal_updates();
+}
+inline void GetStatsResponse::_internal_set_updates(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.updates_ = value;
+}
+inline void GetStatsResponse::set_updates(uint64_t value) {
+  _internal_set_updates(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.updates)
+}
+
+// optional double updates_per_second = 3;
+inline bool GetStatsResponse::_internal_has_updates_per_second() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_updates_per_second() const {
+  return _internal_has_updates_per_second();
+}
+inline void GetStatsResponse::clear_updates_per_second() {
+  _impl_.updates_per_second_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline double GetStatsResponse::_internal_updates_per_second() const {
+  return _impl_.updates_per_second_;
+}
+inline double GetStatsResponse::updates_per_second() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.updates_per_second)
+  return _internal_updates_per_second();
+}
+inline void GetStatsResponse::_internal_set_updates_per_second(double value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.updates_per_second_ = value;
+}
+inline void GetStatsResponse::set_updates_per_second(double value) {
+  _internal_set_updates_per_second(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.updates_per_second)
+}
+
+// optional uint64 rejected = 4;
+inline bool GetStatsResponse::_internal_has_rejected() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_rejected() const {
+  return _internal_has_rejected();
+}
+inline void GetStatsResponse::clear_rejected() {
+  _impl_.rejected_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline uint64_t GetStatsResponse::_internal_rejected() const {
+  return _impl_.rejected_;
+}
+inline uint64_t GetStatsResponse::rejected() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.rejected)
+  return _internal_rejected();
+}
+inline void GetStatsResponse::_internal_set_rejected(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.rejected_ = value;
+}
+inline void GetStatsResponse::set_rejected(uint64_t value) {
+  _internal_set_rejected(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.rejected)
+}
+
+// optional uint64 bytes_in = 5;
+inline bool GetStatsResponse::_internal_has_bytes_in() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_bytes_in() const {
+  return _internal_has_bytes_in();
+}
+inline void GetStatsResponse::clear_bytes_in() {
+  _impl_.bytes_in_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline uint64_t GetStatsResponse::_internal_bytes_in() const {
+  return _impl_.bytes_in_;
+}
+inline uint64_t GetStatsResponse::bytes_in() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.bytes_in)
+  return _internal_bytes_in();
+}
+inline void GetStatsResponse::_internal_set_bytes_in(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.bytes_in_ = value;
+}
+inline void GetStatsResponse::set_bytes_in(uint64_t value) {
+  _internal_set_bytes_in(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.bytes_in)
+}
+
+// optional uint64 bytes_out = 6;
+inline bool GetStatsResponse::_internal_has_bytes_out() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_bytes_out() const {
+  return _internal_has_bytes_out();
+}
+inline void GetStatsResponse::clear_bytes_out() {
+  _impl_.bytes_out_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000020u;
+}
+inline uint64_t GetStatsResponse::_internal_bytes_out() const {
+  return _impl_.bytes_out_;
+}
+inline uint64_t GetStatsResponse::bytes_out() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.bytes_out)
+  return _internal_bytes_out();
+}
+inline void GetStatsResponse::_internal_set_bytes_out(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.bytes_out_ = value;
+}
+inline void GetStatsResponse::set_bytes_out(uint64_t value) {
+  _internal_set_bytes_out(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.bytes_out)
+}
+
+// repeated .seegnify.graph.RequestStats request = 7;
+inline int GetStatsResponse::_internal_request_size() const {
+  return _impl_.request_.size();
+}
+inline int GetStatsResponse::request_size() const {
+  return _internal_request_size();
+}
+inline void GetStatsResponse::clear_request() {
+  _impl_.request_.Clear();
+}
+inline ::seegnify::graph::RequestStats* GetStatsResponse::mutable_request(int index) {
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.GetStatsResponse.request)
+  return _impl_.request_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::RequestStats >*
+GetStatsResponse::mutable_request() {
+  // @@protoc_insertion_point(field_mutable_list:seegnify.graph.GetStatsResponse.request)
+  return &_impl_.request_;
+}
+inline const ::seegnify::graph::RequestStats& GetStatsResponse::_internal_request(int index) const {
+  return _impl_.request_.Get(index);
+}
+inline const ::seegnify::graph::RequestStats& GetStatsResponse::request(int index) const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.request)
+  return _internal_request(index);
+}
+inline ::seegnify::graph::RequestStats* GetStatsResponse::_internal_add_request() {
+  return _impl_.request_.Add();
+}
+inline ::seegnify::graph::RequestStats* GetStatsResponse::add_request() {
+  ::seegnify::graph::RequestStats* _add = _internal_add_request();
+  // @@protoc_insertion_point(field_add:seegnify.graph.GetStatsResponse.request)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::RequestStats >&
+GetStatsResponse::request() const {
+  // @@protoc_insertion_point(field_list:seegnify.graph.GetStatsResponse.request)
+  return _impl_.request_;
+}
+
+// optional double lock_wait_seconds = 8;
+inline bool GetStatsResponse::_internal_has_lock_wait_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_lock_wait_seconds() const {
+  return _internal_has_lock_wait_seconds();
+}
+inline void GetStatsResponse::clear_lock_wait_seconds() {
+  _impl_.lock_wait_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000040u;
+}
+inline double GetStatsResponse::_internal_lock_wait_seconds() const {
+  return _impl_.lock_wait_seconds_;
+}
+inline double GetStatsResponse::lock_wait_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.lock_wait_seconds)
+  return _internal_lock_wait_seconds();
+}
+inline void GetStatsResponse::_internal_set_lock_wait_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.lock_wait_seconds_ = value;
+}
+inline void GetStatsResponse::set_lock_wait_seconds(double value) {
+  _internal_set_lock_wait_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.lock_wait_seconds)
+}
+
+// optional uint64 checkpoints = 9;
+inline bool GetStatsResponse::_internal_has_checkpoints() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000080u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_checkpoints() const {
+  return _internal_has_checkpoints();
+}
+inline void GetStatsResponse::clear_checkpoints() {
+  _impl_.checkpoints_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000080u;
+}
+inline uint64_t GetStatsResponse::_internal_checkpoints() const {
+  return _impl_.checkpoints_;
+}
+inline uint64_t GetStatsResponse::checkpoints() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.checkpoints)
+  return _internal_checkpoints();
+}
+inline void GetStatsResponse::_internal_set_checkpoints(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000080u;
+  _impl_.checkpoints_ = value;
+}
+inline void GetStatsResponse::set_checkpoints(uint64_t value) {
+  _internal_set_checkpoints(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.checkpoints)
+}
+
+// optional double checkpoint_seconds = 10;
+inline bool GetStatsResponse::_internal_has_checkpoint_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000100u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_checkpoint_seconds() const {
+  return _internal_has_checkpoint_seconds();
+}
+inline void GetStatsResponse::clear_checkpoint_seconds() {
+  _impl_.checkpoint_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000100u;
+}
+inline double GetStatsResponse::_internal_checkpoint_seconds() const {
+  return _impl_.checkpoint_seconds_;
+}
+inline double GetStatsResponse::checkpoint_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.checkpoint_seconds)
+  return _internal_checkpoint_seconds();
+}
+inline void GetStatsResponse::_internal_set_checkpoint_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00000100u;
+  _impl_.checkpoint_seconds_ = value;
+}
+inline void GetStatsResponse::set_checkpoint_seconds(double value) {
+  _internal_set_checkpoint_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.checkpoint_seconds)
+}
+
+// optional uint32 workers = 11;
+inline bool GetStatsResponse::_internal_has_workers() const {
+  bool value = (_impl_._has_bits_[0] & 0x00004000u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_workers() const {
+  return _internal_has_workers();
+}
+inline void GetStatsResponse::clear_workers() {
+  _impl_.workers_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00004000u;
+}
+inline uint32_t GetStatsResponse::_internal_workers() const {
+  return _impl_.workers_;
+}
+inline uint32_t GetStatsResponse::workers() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.workers)
+  return _internal_workers();
+}
+inline void GetStatsResponse::_internal_set_workers(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00004000u;
+  _impl_.workers_ = value;
+}
+inline void GetStatsResponse::set_workers(uint32_t value) {
+  _internal_set_workers(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.workers)
+}
+
+// repeated .seegnify.graph.WorkerStats worker = 12;
+inline int GetStatsResponse::_internal_worker_size() const {
+  return _impl_.worker_.size();
+}
+inline int GetStatsResponse::worker_size() const {
+  return _internal_worker_size();
+}
+inline void GetStatsResponse::clear_worker() {
+  _impl_.worker_.Clear();
+}
+inline ::seegnify::graph::WorkerStats* GetStatsResponse::mutable_worker(int index) {
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.GetStatsResponse.worker)
+  return _impl_.worker_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::WorkerStats >*
+GetStatsResponse::mutable_worker() {
+  // @@protoc_insertion_point(field_mutable_list:seegnify.graph.GetStatsResponse.worker)
+  return &_impl_.worker_;
+}
+inline const ::seegnify::graph::WorkerStats& GetStatsResponse::_internal_worker(int index) const {
+  return _impl_.worker_.Get(index);
+}
+inline const ::seegnify::graph::WorkerStats& GetStatsResponse::worker(int index) const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.worker)
+  return _internal_worker(index);
+}
+inline ::seegnify::graph::WorkerStats* GetStatsResponse::_internal_add_worker() {
+  return _impl_.worker_.Add();
+}
+inline ::seegnify::graph::WorkerStats* GetStatsResponse::add_worker() {
+  ::seegnify::graph::WorkerStats* _add = _internal_add_worker();
+  // @@protoc_insertion_point(field_add:seegnify.graph.GetStatsResponse.worker)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::seegnify::graph::WorkerStats >&
+GetStatsResponse::worker() const {
+  // @@protoc_insertion_point(field_list:seegnify.graph.GetStatsResponse.worker)
+  return _impl_.worker_;
+}
+
+// optional uint64 predictions = 13;
+inline bool GetStatsResponse::_internal_has_predictions() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000200u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_predictions() const {
+  return _internal_has_predictions();
+}
+inline void GetStatsResponse::clear_predictions() {
+  _impl_.predictions_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000200u;
+}
+inline uint64_t GetStatsResponse::_internal_predictions() const {
+  return _impl_.predictions_;
+}
+inline uint64_t GetStatsResponse::predictions() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.predictions)
+  return _internal_predictions();
+}
+inline void GetStatsResponse::_internal_set_predictions(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000200u;
+  _impl_.predictions_ = value;
+}
+inline void GetStatsResponse::set_predictions(uint64_t value) {
+  _internal_set_predictions(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.predictions)
+}
+
+// optional uint64 batches = 14;
+inline bool GetStatsResponse::_internal_has_batches() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000400u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_batches() const {
+  return _internal_has_batches();
+}
+inline void GetStatsResponse::clear_batches() {
+  _impl_.batches_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000400u;
+}
+inline uint64_t GetStatsResponse::_internal_batches() const {
+  return _impl_.batches_;
+}
+inline uint64_t GetStatsResponse::batches() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.batches)
+  return _internal_batches();
+}
+inline void GetStatsResponse::_internal_set_batches(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000400u;
+  _impl_.batches_ = value;
+}
+inline void GetStatsResponse::set_batches(uint64_t value) {
+  _internal_set_batches(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.batches)
+}
+
+// optional double batch_rows = 15;
+inline bool GetStatsResponse::_internal_has_batch_rows() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000800u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_batch_rows() const {
+  return _internal_has_batch_rows();
+}
+inline void GetStatsResponse::clear_batch_rows() {
+  _impl_.batch_rows_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000800u;
+}
+inline double GetStatsResponse::_internal_batch_rows() const {
+  return _impl_.batch_rows_;
+}
+inline double GetStatsResponse::batch_rows() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.batch_rows)
+  return _internal_batch_rows();
+}
+inline void GetStatsResponse::_internal_set_batch_rows(double value) {
+  _impl_._has_bits_[0] |= 0x00000800u;
+  _impl_.batch_rows_ = value;
+}
+inline void GetStatsResponse::set_batch_rows(double value) {
+  _internal_set_batch_rows(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.batch_rows)
+}
+
+// optional double latency_p50_seconds = 16;
+inline bool GetStatsResponse::_internal_has_latency_p50_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00001000u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_latency_p50_seconds() const {
+  return _internal_has_latency_p50_seconds();
+}
+inline void GetStatsResponse::clear_latency_p50_seconds() {
+  _impl_.latency_p50_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00001000u;
+}
+inline double GetStatsResponse::_internal_latency_p50_seconds() const {
+  return _impl_.latency_p50_seconds_;
+}
+inline double GetStatsResponse::latency_p50_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.latency_p50_seconds)
+  return _internal_latency_p50_seconds();
+}
+inline void GetStatsResponse::_internal_set_latency_p50_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00001000u;
+  _impl_.latency_p50_seconds_ = value;
+}
+inline void GetStatsResponse::set_latency_p50_seconds(double value) {
+  _internal_set_latency_p50_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.latency_p50_seconds)
+}
+
+// optional double latency_p99_seconds = 17;
+inline bool GetStatsResponse::_internal_has_latency_p99_seconds() const {
+  bool value = (_impl_._has_bits_[0] & 0x00002000u) != 0;
+  return value;
+}
+inline bool GetStatsResponse::has_latency_p99_seconds() const {
+  return _internal_has_latency_p99_seconds();
+}
+inline void GetStatsResponse::clear_latency_p99_seconds() {
+  _impl_.latency_p99_seconds_ = 0;
+  _impl_._has_bits_[0] &= ~0x00002000u;
+}
+inline double GetStatsResponse::_internal_latency_p99_seconds() const {
+  return _impl_.latency_p99_seconds_;
+}
+inline double GetStatsResponse::latency_p99_seconds() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.GetStatsResponse.latency_p99_seconds)
+  return _internal_latency_p99_seconds();
+}
+inline void GetStatsResponse::_internal_set_latency_p99_seconds(double value) {
+  _impl_._has_bits_[0] |= 0x00002000u;
+  _impl_.latency_p99_seconds_ = value;
+}
+inline void GetStatsResponse::set_latency_p99_seconds(double value) {
+  _internal_set_latency_p99_seconds(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.GetStatsResponse.latency_p99_seconds)
 }
 
 // -------------------------------------------------------------------
 
-// UpdWeights
+// Predict
 
-// required bytes update = 1;
-inline bool UpdWeights::_internal_has_update() const {
+// -------------------------------------------------------------------
+
+// PredictResponse
+
+// -------------------------------------------------------------------
+
+// SuccessResponse
+
+// optional float scale = 1;
+inline bool SuccessResponse::_internal_has_scale() const {
   bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
   return value;
 }
-inline bool UpdWeights::has_update() const {
-  return _internal_has_update();
+inline bool SuccessResponse::has_scale() const {
+  return _internal_has_scale();
 }
-inline void UpdWeights::clear_update() {
-  _impl_.update_.ClearToEmpty();
+inline void SuccessResponse::clear_scale() {
+  _impl_.scale_ = 0;
   _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline const std::string& UpdWeights::update() const {
-  // @@protoc_insertion_point(field_get:seegnify.graph.UpdWeights.update)
-  return _internal_update();
-}
-template <typename ArgT0, typename... ArgT>
-inline PROTOBUF_ALWAYS_INLINE
-void UpdWeights::set_update(ArgT0&& arg0, ArgT... args) {
- _impl_._has_bits_[0] |= 0x00000001u;
- _impl_.update_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
-  // @@protoc_insertion_point(field_set:seegnify.graph.UpdWeights.update)
-}
-inline std::string* UpdWeights::mutable_update() {
-  std::string* _s = _internal_mutable_update();
-  // @@protoc_insertion_point(field_mutable:seegnify.graph.UpdWeights.update)
-  return _s;
-}
-inline const std::string& UpdWeights::_internal_update() const {
-  return _impl_.update_.Get();
+inline float SuccessResponse::_internal_scale() const {
+  return _impl_.scale_;
 }
-inline void UpdWeights::_internal_set_update(const std::string& value) {
-  _impl_._has_bits_[0] |= 0x00000001u;
-  _impl_.update_.Set(value, GetArenaForAllocation());
+inline float SuccessResponse::scale() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.SuccessResponse.scale)
+  return _internal_scale();
 }
-inline std::string* UpdWeights::_internal_mutable_update() {
+inline void SuccessResponse::_internal_set_scale(float value) {
   _impl_._has_bits_[0] |= 0x00000001u;
-  return _impl_.update_.Mutable(GetArenaForAllocation());
-}
-inline std::string* UpdWeights::release_update() {
-  // @@protoc_insertion_point(field_release:seegnify.graph.UpdWeights.update)
-  if (!_internal_has_update()) {
-    return nullptr;
-  }
-  _impl_._has_bits_[0] &= ~0x00000001u;
-  auto* p = _impl_.update_.Release();
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.update_.IsDefault()) {
-    _impl_.update_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  return p;
+  _impl_.scale_ = value;
 }
-inline void UpdWeights::set_allocated_update(std::string* update) {
-  if (update != nullptr) {
-    _impl_._has_bits_[0] |= 0x00000001u;
-  } else {
-    _impl_._has_bits_[0] &= ~0x00000001u;
-  }
-  _impl_.update_.SetAllocated(update, GetArenaForAllocation());
-#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (_impl_.update_.IsDefault()) {
-    _impl_.update_.Set("", GetArenaForAllocation());
-  }
-#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  // @@protoc_insertion_point(field_set_allocated:seegnify.graph.UpdWeights.update)
+inline void SuccessResponse::set_scale(float value) {
+  _internal_set_scale(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.SuccessResponse.scale)
 }
 
 // -------------------------------------------------------------------
 
-// SuccessResponse
-
-// -------------------------------------------------------------------
-
 // ErrorResponse
 
 // required uint32 status = 1;
@@ -1799,6 +4565,90 @@ inline void ErrorResponse::set_allocated_message(std::string* message) {
 
 // Request
 
+// optional uint64 id = 1;
+inline bool Request::_internal_has_id() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Request::has_id() const {
+  return _internal_has_id();
+}
+inline void Request::clear_id() {
+  _impl_.id_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t Request::_internal_id() const {
+  return _impl_.id_;
+}
+inline uint64_t Request::id() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Request.id)
+  return _internal_id();
+}
+inline void Request::_internal_set_id(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.id_ = value;
+}
+inline void Request::set_id(uint64_t value) {
+  _internal_set_id(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.Request.id)
+}
+
+// optional bool payload = 2;
+inline bool Request::_internal_has_payload() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Request::has_payload() const {
+  return _internal_has_payload();
+}
+inline void Request::clear_payload() {
+  _impl_.payload_ = false;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline bool Request::_internal_payload() const {
+  return _impl_.payload_;
+}
+inline bool Request::payload() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Request.payload)
+  return _internal_payload();
+}
+inline void Request::_internal_set_payload(bool value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.payload_ = value;
+}
+inline void Request::set_payload(bool value) {
+  _internal_set_payload(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.Request.payload)
+}
+
+// optional bool deflate = 3;
+inline bool Request::_internal_has_deflate() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool Request::has_deflate() const {
+  return _internal_has_deflate();
+}
+inline void Request::clear_deflate() {
+  _impl_.deflate_ = false;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline bool Request::_internal_deflate() const {
+  return _impl_.deflate_;
+}
+inline bool Request::deflate() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Request.deflate)
+  return _internal_deflate();
+}
+inline void Request::_internal_set_deflate(bool value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.deflate_ = value;
+}
+inline void Request::set_deflate(bool value) {
+  _internal_set_deflate(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.Request.deflate)
+}
+
 // .seegnify.graph.GetWeights get_weights = 10;
 inline bool Request::_internal_has_get_weights() const {
   return request_case() == kGetWeights;
@@ -2021,6 +4871,154 @@ inline ::seegnify::graph::UpdWeights* Request::mutable_upd_weights() {
   return _msg;
 }
 
+// .seegnify.graph.GetStats get_stats = 13;
+inline bool Request::_internal_has_get_stats() const {
+  return request_case() == kGetStats;
+}
+inline bool Request::has_get_stats() const {
+  return _internal_has_get_stats();
+}
+inline void Request::set_has_get_stats() {
+  _impl_._oneof_case_[0] = kGetStats;
+}
+inline void Request::clear_get_stats() {
+  if (_internal_has_get_stats()) {
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.request_.get_stats_;
+    }
+    clear_has_request();
+  }
+}
+inline ::seegnify::graph::GetStats* Request::release_get_stats() {
+  // @@protoc_insertion_point(field_release:seegnify.graph.Request.get_stats)
+  if (_internal_has_get_stats()) {
+    clear_has_request();
+    ::seegnify::graph::GetStats* temp = _impl_.request_.get_stats_;
+    if (GetArenaForAllocation() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    _impl_.request_.get_stats_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::seegnify::graph::GetStats& Request::_internal_get_stats() const {
+  return _internal_has_get_stats()
+      ? *_impl_.request_.get_stats_
+      : reinterpret_cast< ::seegnify::graph::GetStats&>(::seegnify::graph::_GetStats_default_instance_);
+}
+inline const ::seegnify::graph::GetStats& Request::get_stats() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Request.get_stats)
+  return _internal_get_stats();
+}
+inline ::seegnify::graph::GetStats* Request::unsafe_arena_release_get_stats() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:seegnify.graph.Request.get_stats)
+  if (_internal_has_get_stats()) {
+    clear_has_request();
+    ::seegnify::graph::GetStats* temp = _impl_.request_.get_stats_;
+    _impl_.request_.get_stats_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void Request::unsafe_arena_set_allocated_get_stats(::seegnify::graph::GetStats* get_stats) {
+  clear_request();
+  if (get_stats) {
+    set_has_get_stats();
+    _impl_.request_.get_stats_ = get_stats;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:seegnify.graph.Request.get_stats)
+}
+inline ::seegnify::graph::GetStats* Request::_internal_mutable_get_stats() {
+  if (!_internal_has_get_stats()) {
+    clear_request();
+    set_has_get_stats();
+    _impl_.request_.get_stats_ = CreateMaybeMessage< ::seegnify::graph::GetStats >(GetArenaForAllocation());
+  }
+  return _impl_.request_.get_stats_;
+}
+inline ::seegnify::graph::GetStats* Request::mutable_get_stats() {
+  ::seegnify::graph::GetStats* _msg = _internal_mutable_get_stats();
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.Request.get_stats)
+  return _msg;
+}
+
+// .seegnify.graph.Predict predict = 14;
+inline bool Request::_internal_has_predict() const {
+  return request_case() == kPredict;
+}
+inline bool Request::has_predict() const {
+  return _internal_has_predict();
+}
+inline void Request::set_has_predict() {
+  _impl_._oneof_case_[0] = kPredict;
+}
+inline void Request::clear_predict() {
+  if (_internal_has_predict()) {
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.request_.predict_;
+    }
+    clear_has_request();
+  }
+}
+inline ::seegnify::graph::Predict* Request::release_predict() {
+  // @@protoc_insertion_point(field_release:seegnify.graph.Request.predict)
+  if (_internal_has_predict()) {
+    clear_has_request();
+    ::seegnify::graph::Predict* temp = _impl_.request_.predict_;
+    if (GetArenaForAllocation() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    _impl_.request_.predict_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::seegnify::graph::Predict& Request::_internal_predict() const {
+  return _internal_has_predict()
+      ? *_impl_.request_.predict_
+      : reinterpret_cast< ::seegnify::graph::Predict&>(::seegnify::graph::_Predict_default_instance_);
+}
+inline const ::seegnify::graph::Predict& Request::predict() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Request.predict)
+  return _internal_predict();
+}
+inline ::seegnify::graph::Predict* Request::unsafe_arena_release_predict() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:seegnify.graph.Request.predict)
+  if (_internal_has_predict()) {
+    clear_has_request();
+    ::seegnify::graph::Predict* temp = _impl_.request_.predict_;
+    _impl_.request_.predict_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void Request::unsafe_arena_set_allocated_predict(::seegnify::graph::Predict* predict) {
+  clear_request();
+  if (predict) {
+    set_has_predict();
+    _impl_.request_.predict_ = predict;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:seegnify.graph.Request.predict)
+}
+inline ::seegnify::graph::Predict* Request::_internal_mutable_predict() {
+  if (!_internal_has_predict()) {
+    clear_request();
+    set_has_predict();
+    _impl_.request_.predict_ = CreateMaybeMessage< ::seegnify::graph::Predict >(GetArenaForAllocation());
+  }
+  return _impl_.request_.predict_;
+}
+inline ::seegnify::graph::Predict* Request::mutable_predict() {
+  ::seegnify::graph::Predict* _msg = _internal_mutable_predict();
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.Request.predict)
+  return _msg;
+}
+
 inline bool Request::has_request() const {
   return request_case() != REQUEST_NOT_SET;
 }
@@ -2034,6 +5032,90 @@ inline Request::RequestCase Request::request_case() const {
 
 // Response
 
+// optional uint64 id = 1;
+inline bool Response::_internal_has_id() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Response::has_id() const {
+  return _internal_has_id();
+}
+inline void Response::clear_id() {
+  _impl_.id_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t Response::_internal_id() const {
+  return _impl_.id_;
+}
+inline uint64_t Response::id() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Response.id)
+  return _internal_id();
+}
+inline void Response::_internal_set_id(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.id_ = value;
+}
+inline void Response::set_id(uint64_t value) {
+  _internal_set_id(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.Response.id)
+}
+
+// optional bool payload = 2;
+inline bool Response::_internal_has_payload() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Response::has_payload() const {
+  return _internal_has_payload();
+}
+inline void Response::clear_payload() {
+  _impl_.payload_ = false;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline bool Response::_internal_payload() const {
+  return _impl_.payload_;
+}
+inline bool Response::payload() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Response.payload)
+  return _internal_payload();
+}
+inline void Response::_internal_set_payload(bool value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.payload_ = value;
+}
+inline void Response::set_payload(bool value) {
+  _internal_set_payload(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.Response.payload)
+}
+
+// optional bool deflate = 3;
+inline bool Response::_internal_has_deflate() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool Response::has_deflate() const {
+  return _internal_has_deflate();
+}
+inline void Response::clear_deflate() {
+  _impl_.deflate_ = false;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline bool Response::_internal_deflate() const {
+  return _impl_.deflate_;
+}
+inline bool Response::deflate() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Response.deflate)
+  return _internal_deflate();
+}
+inline void Response::_internal_set_deflate(bool value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.deflate_ = value;
+}
+inline void Response::set_deflate(bool value) {
+  _internal_set_deflate(value);
+  // @@protoc_insertion_point(field_set:seegnify.graph.Response.deflate)
+}
+
 // .seegnify.graph.GetWeightsResponse get_weights = 11;
 inline bool Response::_internal_has_get_weights() const {
   return response_case() == kGetWeights;
@@ -2256,6 +5338,154 @@ inline ::seegnify::graph::ErrorResponse* Response::mutable_error() {
   return _msg;
 }
 
+// .seegnify.graph.GetStatsResponse get_stats = 14;
+inline bool Response::_internal_has_get_stats() const {
+  return response_case() == kGetStats;
+}
+inline bool Response::has_get_stats() const {
+  return _internal_has_get_stats();
+}
+inline void Response::set_has_get_stats() {
+  _impl_._oneof_case_[0] = kGetStats;
+}
+inline void Response::clear_get_stats() {
+  if (_internal_has_get_stats()) {
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.response_.get_stats_;
+    }
+    clear_has_response();
+  }
+}
+inline ::seegnify::graph::GetStatsResponse* Response::release_get_stats() {
+  // @@protoc_insertion_point(field_release:seegnify.graph.Response.get_stats)
+  if (_internal_has_get_stats()) {
+    clear_has_response();
+    ::seegnify::graph::GetStatsResponse* temp = _impl_.response_.get_stats_;
+    if (GetArenaForAllocation() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    _impl_.response_.get_stats_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::seegnify::graph::GetStatsResponse& Response::_internal_get_stats() const {
+  return _internal_has_get_stats()
+      ? *_impl_.response_.get_stats_
+      : reinterpret_cast< ::seegnify::graph::GetStatsResponse&>(::seegnify::graph::_GetStatsResponse_default_instance_);
+}
+inline const ::seegnify::graph::GetStatsResponse& Response::get_stats() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Response.get_stats)
+  return _internal_get_stats();
+}
+inline ::seegnify::graph::GetStatsResponse* Response::unsafe_arena_release_get_stats() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:seegnify.graph.Response.get_stats)
+  if (_internal_has_get_stats()) {
+    clear_has_response();
+    ::seegnify::graph::GetStatsResponse* temp = _impl_.response_.get_stats_;
+    _impl_.response_.get_stats_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void Response::unsafe_arena_set_allocated_get_stats(::seegnify::graph::GetStatsResponse* get_stats) {
+  clear_response();
+  if (get_stats) {
+    set_has_get_stats();
+    _impl_.response_.get_stats_ = get_stats;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:seegnify.graph.Response.get_stats)
+}
+inline ::seegnify::graph::GetStatsResponse* Response::_internal_mutable_get_stats() {
+  if (!_internal_has_get_stats()) {
+    clear_response();
+    set_has_get_stats();
+    _impl_.response_.get_stats_ = CreateMaybeMessage< ::seegnify::graph::GetStatsResponse >(GetArenaForAllocation());
+  }
+  return _impl_.response_.get_stats_;
+}
+inline ::seegnify::graph::GetStatsResponse* Response::mutable_get_stats() {
+  ::seegnify::graph::GetStatsResponse* _msg = _internal_mutable_get_stats();
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.Response.get_stats)
+  return _msg;
+}
+
+// .seegnify.graph.PredictResponse predict = 15;
+inline bool Response::_internal_has_predict() const {
+  return response_case() == kPredict;
+}
+inline bool Response::has_predict() const {
+  return _internal_has_predict();
+}
+inline void Response::set_has_predict() {
+  _impl_._oneof_case_[0] = kPredict;
+}
+inline void Response::clear_predict() {
+  if (_internal_has_predict()) {
+    if (GetArenaForAllocation() == nullptr) {
+      delete _impl_.response_.predict_;
+    }
+    clear_has_response();
+  }
+}
+inline ::seegnify::graph::PredictResponse* Response::release_predict() {
+  // @@protoc_insertion_point(field_release:seegnify.graph.Response.predict)
+  if (_internal_has_predict()) {
+    clear_has_response();
+    ::seegnify::graph::PredictResponse* temp = _impl_.response_.predict_;
+    if (GetArenaForAllocation() != nullptr) {
+      temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+    }
+    _impl_.response_.predict_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline const ::seegnify::graph::PredictResponse& Response::_internal_predict() const {
+  return _internal_has_predict()
+      ? *_impl_.response_.predict_
+      : reinterpret_cast< ::seegnify::graph::PredictResponse&>(::seegnify::graph::_PredictResponse_default_instance_);
+}
+inline const ::seegnify::graph::PredictResponse& Response::predict() const {
+  // @@protoc_insertion_point(field_get:seegnify.graph.Response.predict)
+  return _internal_predict();
+}
+inline ::seegnify::graph::PredictResponse* Response::unsafe_arena_release_predict() {
+  // @@protoc_insertion_point(field_unsafe_arena_release:seegnify.graph.Response.predict)
+  if (_internal_has_predict()) {
+    clear_has_response();
+    ::seegnify::graph::PredictResponse* temp = _impl_.response_.predict_;
+    _impl_.response_.predict_ = nullptr;
+    return temp;
+  } else {
+    return nullptr;
+  }
+}
+inline void Response::unsafe_arena_set_allocated_predict(::seegnify::graph::PredictResponse* predict) {
+  clear_response();
+  if (predict) {
+    set_has_predict();
+    _impl_.response_.predict_ = predict;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:seegnify.graph.Response.predict)
+}
+inline ::seegnify::graph::PredictResponse* Response::_internal_mutable_predict() {
+  if (!_internal_has_predict()) {
+    clear_response();
+    set_has_predict();
+    _impl_.response_.predict_ = CreateMaybeMessage< ::seegnify::graph::PredictResponse >(GetArenaForAllocation());
+  }
+  return _impl_.response_.predict_;
+}
+inline ::seegnify::graph::PredictResponse* Response::mutable_predict() {
+  ::seegnify::graph::PredictResponse* _msg = _internal_mutable_predict();
+  // @@protoc_insertion_point(field_mutable:seegnify.graph.Response.predict)
+  return _msg;
+}
+
 inline bool Response::has_response() const {
   return response_case() != RESPONSE_NOT_SET;
 }
@@ -2282,6 +5512,18 @@ inline Response::ResponseCase Response::response_case() const {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
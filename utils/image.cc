@@ -11,6 +11,7 @@
 #include <limits>
 
 #include "image.hh"
+#include "imagekernel.hh"
 
 namespace seegnify {
 
@@ -170,35 +171,19 @@ Image::Status Image::save(const std::string& filename) const
 Image Image::crop(uint32_t row, uint32_t col, uint32_t rows, uint32_t cols) const
 {
   Image im(rows,  cols, _channels);
-
-  std::memset(im._data, 0, im.size());
-
-  for (int r=0; r<rows; r++)
-  {
-    for (int c=0; c<cols; c++)
-    {
-      auto this_r = r + row;
-      auto this_c = c + col;
-
-      if (this_r >= 0 and this_r < _rows)
-      if (this_c >= 0 and this_c < _cols)
-      {
-        // compute array offset given row order
-        auto offset = _channels * (r * cols + c);
-        auto this_offset = _channels * (this_r * _cols + this_c);
-
-        // copy pixel bytes
-        for (int b=0; b<_channels; b++)
-        {
-          im._data[offset + b] = _data[this_offset + b];
-        }
-      }
-    }
-  }
-
+  crop(row, col, im);
   return im;
 }
 
+void Image::crop(int32_t row, int32_t col, Image& out) const
+{
+  PixelWindow<uint8_t> w = {
+    _data, (int)_rows, (int)_cols, _channels,
+    row, col, out.rows(), out.cols()
+  };
+  crop_kernel(w, out._data);
+}
+
 Image Image::norm() const
 {
   Image im(_rows,  _cols, _channels);
@@ -234,85 +219,45 @@ Image Image::norm() const
 
 Image Image::scale(uint32_t rows, uint32_t cols, Interpolation interp) const
 {
+  Image im(rows,  cols, _channels);
+  scale(im, interp);
+  return im;
+}
+
+void Image::scale(Image& out, Interpolation interp) const
+{
+  scale(0, 0, _rows, _cols, out, interp);
+}
+
+void Image::scale(int32_t row, int32_t col, uint32_t rows, uint32_t cols,
+Image& out, Interpolation interp) const
+{
+  PixelWindow<uint8_t> w = {
+    _data, (int)_rows, (int)_cols, _channels,
+    row, col, (int)rows, (int)cols
+  };
+
   switch(interp)
   {
     case INTERPOLATE_NEAREST:
-      return scale_nearest(rows, cols);
+      scale_nearest_kernel(w, out._data, out.rows(), out.cols());
+      break;
     case INTERPOLATE_BILINEAR:
-      return scale_bilinear(rows, cols);
+      scale_bilinear_kernel(w, out._data, out.rows(), out.cols());
+      break;
     default:
-      return Image(rows,  cols, _channels);
+      break;
   }
 }
 
-Image Image::scale_nearest(uint32_t rows, uint32_t cols) const
+void Image::convert(DTYPE* out, DTYPE factor) const
 {
-  Image im(rows,  cols, _channels);
-
-  auto scale_r = (float)(_rows - 1)/(rows - 1);
-  auto scale_c = (float)(_cols - 1)/(cols - 1);
-
-  for (auto r=0; r<rows; r++)
-  for (auto c=0; c<cols; c++)
-  {
-    uint32_t this_c = std::round(scale_c * c);
-    uint32_t this_r = std::round(scale_r * r);
-
-    auto offset = _channels * (r * cols + c);
-    auto this_offset = _channels * (this_r * _cols + this_c);
-
-    // copy pixel bytes
-    for (int b=0; b<_channels; b++)
-    {
-      im._data[offset + b] = _data[this_offset + b];
-    }
-  }
-
-  return im;
+  for (int i=size(); i>0; i--) out[i-1] = factor * _data[i-1];
 }
 
-Image Image::scale_bilinear(uint32_t rows, uint32_t cols) const
+void Image::planar(DTYPE* out, DTYPE factor) const
 {
-  Image im(rows,  cols, _channels);
-
-  auto scale_r = (float)(_rows - 1)/(rows - 1);
-  auto scale_c = (float)(_cols - 1)/(cols - 1);
-
-  for (auto r=0; r<rows; r++)
-  for (auto c=0; c<cols; c++)
-  {
-    auto float_r = scale_r * r;
-    auto float_c = scale_c * c;
-
-    uint32_t this_r0 = float_r;
-    uint32_t this_c0 = float_c;
-
-    uint32_t this_r1 = std::min<uint32_t>(this_r0 + 1, _rows - 1); 
-    uint32_t this_c1 = std::min<uint32_t>(this_c0 + 1, _cols - 1); 
-
-    auto r0_c0 = _channels * (this_r0 * _cols + this_c0);
-    auto r1_c0 = _channels * (this_r1 * _cols + this_c0);
-    auto r0_c1 = _channels * (this_r0 * _cols + this_c1);
-    auto r1_c1 = _channels * (this_r1 * _cols + this_c1);
-
-    float sr = float_r - this_r0;
-    float sc = float_c - this_c0;
-
-    auto offset = _channels * (r * cols + c);
-
-    // interpolate pixel bytes
-    for (int b=0; b<_channels; b++)
-    {
-      // linear along rows
-      auto col_r0 = (1 - sr) * _data[r0_c0 + b] + sr * _data[r1_c0 + b];
-      auto col_r1 = (1 - sr) * _data[r0_c1 + b] + sr * _data[r1_c1 + b];
-
-      // linear along cols
-      im._data[offset + b] = (1 - sc) * col_r0 + sc * col_r1;
-    }
-  }
-
-  return im;
+  planar_kernel(_data, _rows * _cols, _channels, factor, out);
 }
 
 } /* namespace */
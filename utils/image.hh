@@ -9,6 +9,8 @@
 
 #include <string>
 
+#include "main/types.hh"
+
 namespace seegnify {
 
 class Image
@@ -120,14 +122,28 @@ public:
 
   Image crop (uint32_t row, uint32_t col, uint32_t rows, uint32_t cols) const;
 
+  // crop into output image of the window size
+  void crop (int32_t row, int32_t col, Image& out) const;
+
   Image scale (uint32_t rows, uint32_t cols, Interpolation interp = INTERPOLATE_NEAREST) const;
 
+  // scale into output image of the target size
+  void scale (Image& out, Interpolation interp = INTERPOLATE_NEAREST) const;
+
+  // scale window read in place into output image, the window may reach
+  // past the image
+  void scale (int32_t row, int32_t col, uint32_t rows, uint32_t cols,
+    Image& out, Interpolation interp = INTERPOLATE_NEAREST) const;
+
   Image norm() const;
 
-protected:
-  Image scale_nearest (uint32_t rows, uint32_t cols) const;
-  Image scale_bilinear (uint32_t rows, uint32_t cols) const;
+  // copy pixels times factor in interleaved layout [rows x cols x channels]
+  void convert(DTYPE* out, DTYPE factor = 1) const;
+
+  // copy channels times factor in planar layout [channels x rows x cols]
+  void planar(DTYPE* out, DTYPE factor = 1) const;
 
+protected:
   void write_row (uint32_t row, std::ofstream& f) const;
   void read_row (uint32_t row, std::ifstream& f);
 
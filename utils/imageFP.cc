@@ -11,6 +11,7 @@
 #include <limits>
 
 #include "imageFP.hh"
+#include "imagekernel.hh"
 
 namespace seegnify {
 
@@ -112,48 +113,37 @@ ImageFP::Status ImageFP::save(const std::string& filename) const
 ImageFP ImageFP::crop(uint32_t row, uint32_t col, uint32_t rows, uint32_t cols) const
 {
   ImageFP im(rows,  cols, _channels);
-
-  std::memset(im._data, 0, im.size() * sizeof(DTYPE));
-
-  for (int r=0; r<rows; r++)
-  {
-    for (int c=0; c<cols; c++)
-    {
-      auto this_r = r + row;
-      auto this_c = c + col;
-
-      if (this_r >= 0 and this_r < _rows)
-      if (this_c >= 0 and this_c < _cols)
-      {
-        // compute array offset given row order
-        auto offset = _channels * (r * cols + c);
-        auto this_offset = _channels * (this_r * _cols + this_c);
-
-        // copy channel values
-        for (int b=0; b<_channels; b++)
-        {
-          im._data[offset + b] = _data[this_offset + b];
-        }
-      }
-    }
-  }
-
+  crop(row, col, im);
   return im;
 }
 
+void ImageFP::crop(int32_t row, int32_t col, ImageFP& out) const
+{
+  PixelWindow<DTYPE> w = {
+    _data, (int)_rows, (int)_cols, _channels,
+    row, col, out.rows(), out.cols()
+  };
+  crop_kernel(w, out._data);
+}
+
 ImageFP ImageFP::norm(DTYPE range) const
 {
   ImageFP im(_rows,  _cols, _channels);
+  norm(im, range);
+  return im;
+}
 
-  auto this_data = data();
+void ImageFP::norm(ImageFP& out, DTYPE range) const
+{
+  ConstRowVectorMap in(_data, size());
 
   DTYPE max_value = std::numeric_limits<DTYPE>::min();
   DTYPE min_value = std::numeric_limits<DTYPE>::max();
 
-  for (int i=size(); i>0; i--)
+  if (size())
   {
-    max_value = std::max<DTYPE>(this_data[i-1], max_value);
-    min_value = std::min<DTYPE>(this_data[i-1], min_value);
+    max_value = std::max<DTYPE>(in.maxCoeff(), max_value);
+    min_value = std::min<DTYPE>(in.minCoeff(), min_value);
   }
 
   if (std::abs(max_value - min_value) < EPSILON)
@@ -164,97 +154,79 @@ ImageFP ImageFP::norm(DTYPE range) const
 
   auto scale = range / (max_value - min_value);
 
-  auto im_data = im.data();
-
-  for (int i=size(); i>0; i--)
-  {
-    im_data[i-1] = scale * (this_data[i-1] - min_value);
-  }
-
-  return im;
+  RowVectorMap(out._data, size()) = scale * (in.array() - min_value).matrix();
 }
 
-ImageFP ImageFP::scale(uint32_t rows, uint32_t cols, Interpolation interp) const
+void ImageFP::standardize(const DTYPE* mean, const DTYPE* stddev)
 {
-  switch(interp)
+  typedef Eigen::Map<RowVector, 0, Eigen::InnerStride<>> ChannelMap;
+
+  for (int b=0; b<_channels; b++)
   {
-    case INTERPOLATE_NEAREST:
-      return scale_nearest(rows, cols);
-    case INTERPOLATE_BILINEAR:
-      return scale_bilinear(rows, cols);
-    default:
-      return ImageFP(rows,  cols, _channels);
+    ChannelMap channel(_data + b, _rows * _cols,
+      Eigen::InnerStride<>(_channels));
+    channel = (channel.array() - mean[b]) / stddev[b];
   }
 }
 
-ImageFP ImageFP::scale_nearest(uint32_t rows, uint32_t cols) const
+void ImageFP::planar(DTYPE* out) const
 {
-  ImageFP im(rows,  cols, _channels);
+  planar_kernel(_data, _rows * _cols, _channels, DTYPE(1), out);
+}
 
-  auto scale_r = (float)(_rows - 1)/(rows - 1);
-  auto scale_c = (float)(_cols - 1)/(cols - 1);
+ImageFP ImageFP::flip() const
+{
+  ImageFP im(_rows,  _cols, _channels);
 
-  for (auto r=0; r<rows; r++)
-  for (auto c=0; c<cols; c++)
+  for (int r=0; r<_rows; r++)
   {
-    uint32_t this_c = std::round(scale_c * c);
-    uint32_t this_r = std::round(scale_r * r);
-
-    auto offset = _channels * (r * cols + c);
-    auto this_offset = _channels * (this_r * _cols + this_c);
-
-    // copy pixel bytes
-    for (int b=0; b<_channels; b++)
+    for (int c=0; c<_cols; c++)
     {
-      im._data[offset + b] = _data[this_offset + b];
+      // mirror columns of the same row
+      auto offset = _channels * (r * _cols + c);
+      auto this_offset = _channels * (r * _cols + _cols - 1 - c);
+
+      for (int b=0; b<_channels; b++)
+      {
+        im._data[offset + b] = _data[this_offset + b];
+      }
     }
   }
 
   return im;
 }
 
-ImageFP ImageFP::scale_bilinear(uint32_t rows, uint32_t cols) const
+ImageFP ImageFP::scale(uint32_t rows, uint32_t cols, Interpolation interp) const
 {
   ImageFP im(rows,  cols, _channels);
+  scale(im, interp);
+  return im;
+}
 
-  auto scale_r = (float)(_rows - 1)/(rows - 1);
-  auto scale_c = (float)(_cols - 1)/(cols - 1);
-
-  for (auto r=0; r<rows; r++)
-  for (auto c=0; c<cols; c++)
-  {
-    auto float_r = scale_r * r;
-    auto float_c = scale_c * c;
-
-    uint32_t this_r0 = float_r;
-    uint32_t this_c0 = float_c;
-
-    uint32_t this_r1 = std::min<uint32_t>(this_r0 + 1, _rows - 1); 
-    uint32_t this_c1 = std::min<uint32_t>(this_c0 + 1, _cols - 1); 
-
-    auto r0_c0 = _channels * (this_r0 * _cols + this_c0);
-    auto r1_c0 = _channels * (this_r1 * _cols + this_c0);
-    auto r0_c1 = _channels * (this_r0 * _cols + this_c1);
-    auto r1_c1 = _channels * (this_r1 * _cols + this_c1);
-
-    float sr = float_r - this_r0;
-    float sc = float_c - this_c0;
-
-    auto offset = _channels * (r * cols + c);
+void ImageFP::scale(ImageFP& out, Interpolation interp) const
+{
+  scale(0, 0, _rows, _cols, out, interp);
+}
 
-    // interpolate pixel bytes
-    for (int b=0; b<_channels; b++)
-    {
-      // linear along rows
-      auto col_r0 = (1 - sr) * _data[r0_c0 + b] + sr * _data[r1_c0 + b];
-      auto col_r1 = (1 - sr) * _data[r0_c1 + b] + sr * _data[r1_c1 + b];
+void ImageFP::scale(int32_t row, int32_t col, uint32_t rows, uint32_t cols,
+ImageFP& out, Interpolation interp) const
+{
+  PixelWindow<DTYPE> w = {
+    _data, (int)_rows, (int)_cols, _channels,
+    row, col, (int)rows, (int)cols
+  };
 
-      // linear along cols
-      im._data[offset + b] = (1 - sc) * col_r0 + sc * col_r1;
-    }
+  switch(interp)
+  {
+    case INTERPOLATE_NEAREST:
+      scale_nearest_kernel(w, out._data, out.rows(), out.cols());
+      break;
+    case INTERPOLATE_BILINEAR:
+      scale_bilinear_kernel(w, out._data, out.rows(), out.cols());
+      break;
+    default:
+      break;
   }
-
-  return im;
 }
 
 } /* namespace */
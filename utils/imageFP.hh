@@ -96,14 +96,33 @@ public:
 
   ImageFP crop (uint32_t row, uint32_t col, uint32_t rows, uint32_t cols) const;
 
+  // crop into output image of the window size
+  void crop (int32_t row, int32_t col, ImageFP& out) const;
+
   ImageFP scale (uint32_t rows, uint32_t cols, Interpolation interp = INTERPOLATE_NEAREST) const;
 
+  // scale into output image of the target size
+  void scale (ImageFP& out, Interpolation interp = INTERPOLATE_NEAREST) const;
+
+  // scale window read in place into output image, the window may reach
+  // past the image
+  void scale (int32_t row, int32_t col, uint32_t rows, uint32_t cols,
+    ImageFP& out, Interpolation interp = INTERPOLATE_NEAREST) const;
+
   ImageFP norm(DTYPE range = 1.0) const;
 
-protected:
-  ImageFP scale_nearest (uint32_t rows, uint32_t cols) const;
-  ImageFP scale_bilinear (uint32_t rows, uint32_t cols) const;
+  // normalize into output image of the same size
+  void norm(ImageFP& out, DTYPE range = 1.0) const;
 
+  // standardize channels in place, x = (x - mean[c]) / stddev[c]
+  void standardize(const DTYPE* mean, const DTYPE* stddev);
+
+  // copy channels to planar layout [channels x rows x cols]
+  void planar(DTYPE* out) const;
+
+  ImageFP flip() const;
+
+protected:
   void init()
   {
     _data = nullptr;
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_IMAGE_KERNEL_H_
+#define _SEEGNIFY_IMAGE_KERNEL_H_
+
+#include <cmath>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+namespace seegnify {
+
+// Window of interleaved pixels of a source image. The window may reach past
+// the source, pixels outside of the source read as zero. Rows of the source
+// are contiguous, so the window is a strided view of the source.
+template <class T>
+struct PixelWindow
+{
+  const T* data;   // source pixels
+  int rows;        // source rows
+  int cols;        // source cols
+  int channels;    // source channels
+  int row;         // window top row in source
+  int col;         // window left col in source
+  int height;      // window rows
+  int width;       // window cols
+};
+
+// step between window coordinates of consecutive output pixels
+inline float scale_step(int window, int output)
+{
+  return (output > 1) ? (float)(window - 1)/(output - 1) : 0;
+}
+
+// copy window to output of the same size
+template <class T>
+void crop_kernel(const PixelWindow<T>& w, T* out)
+{
+  auto ch = w.channels;
+  std::memset(out, 0, (size_t)w.height * w.width * ch * sizeof(T));
+
+  // columns of the window inside the source
+  int c0 = std::max(0, -w.col);
+  int c1 = std::min(w.width, w.cols - w.col);
+  if (c0 >= c1) return;
+
+  for (int r=std::max(0, -w.row); r<std::min(w.height, w.rows - w.row); r++)
+  {
+    auto src = w.data + ((size_t)(w.row + r) * w.cols + (w.col + c0)) * ch;
+    auto dst = out + ((size_t)r * w.width + c0) * ch;
+    std::memcpy(dst, src, (size_t)(c1 - c0) * ch * sizeof(T));
+  }
+}
+
+// nearest neighbour resize of window to output rows x cols
+template <class T>
+void scale_nearest_kernel(const PixelWindow<T>& w, T* out, int rows, int cols)
+{
+  auto ch = w.channels;
+  auto step_r = scale_step(w.height, rows);
+  auto step_c = scale_step(w.width, cols);
+
+  // source offset of each output col, negative outside of the source
+  thread_local std::vector<int> offset;
+  offset.resize(cols);
+  for (int c=0; c<cols; c++)
+  {
+    int sc = w.col + (int)std::round(step_c * c);
+    offset[c] = (sc >= 0 && sc < w.cols) ? sc * ch : -1;
+  }
+
+  for (int r=0; r<rows; r++)
+  {
+    int sr = w.row + (int)std::round(step_r * r);
+    auto dst = out + (size_t)r * cols * ch;
+
+    if (sr < 0 || sr >= w.rows)
+    {
+      std::memset(dst, 0, (size_t)cols * ch * sizeof(T));
+      continue;
+    }
+
+    auto src = w.data + (size_t)sr * w.cols * ch;
+    for (int c=0; c<cols; c++, dst+=ch)
+    {
+      if (offset[c] < 0)
+        for (int b=0; b<ch; b++) dst[b] = 0;
+      else
+        for (int b=0; b<ch; b++) dst[b] = src[offset[c] + b];
+    }
+  }
+}
+
+// bilinear resize of window to output rows x cols, in two passes: blend of
+// two source rows into a line buffer, then blend of two line pixels
+template <class T>
+void scale_bilinear_kernel(const PixelWindow<T>& w, T* out, int rows, int cols)
+{
+  auto ch = w.channels;
+  auto step_r = scale_step(w.height, rows);
+  auto step_c = scale_step(w.width, cols);
+
+  // left and right window col and weight of each output col
+  thread_local std::vector<int> left, right;
+  thread_local std::vector<float> weight, line;
+  left.resize(cols);
+  right.resize(cols);
+  weight.resize(cols);
+  line.resize((size_t)w.width * ch);
+
+  for (int c=0; c<cols; c++)
+  {
+    auto fc = step_c * c;
+    left[c] = fc;
+    right[c] = std::min(left[c] + 1, w.width - 1);
+    weight[c] = fc - left[c];
+  }
+
+  // window columns inside the source
+  int c0 = std::max(0, -w.col);
+  int c1 = std::max(c0, std::min(w.width, w.cols - w.col));
+
+  std::fill(line.begin(), line.end(), 0.0f);
+
+  for (int r=0; r<rows; r++)
+  {
+    auto fr = step_r * r;
+    int top = fr;
+    int bottom = std::min(top + 1, w.height - 1);
+    float sr = fr - top;
+
+    // source rows, null outside of the source
+    int st = w.row + top;
+    int sb = w.row + bottom;
+    auto pt = (st >= 0 && st < w.rows) ?
+      w.data + (size_t)st * w.cols * ch : nullptr;
+    auto pb = (sb >= 0 && sb < w.rows) ?
+      w.data + (size_t)sb * w.cols * ch : nullptr;
+
+    // blend along rows of window columns inside the source
+    auto l = line.data();
+    int i0 = c0 * ch, i1 = c1 * ch, shift = w.col * ch;
+    if (pt && pb)
+      for (int i=i0; i<i1; i++)
+        l[i] = (1 - sr) * pt[shift + i] + sr * pb[shift + i];
+    else if (pt)
+      for (int i=i0; i<i1; i++) l[i] = (1 - sr) * pt[shift + i];
+    else if (pb)
+      for (int i=i0; i<i1; i++) l[i] = sr * pb[shift + i];
+    else
+      for (int i=i0; i<i1; i++) l[i] = 0;
+
+    // blend along cols
+    auto dst = out + (size_t)r * cols * ch;
+    for (int c=0; c<cols; c++, dst+=ch)
+    {
+      auto a = l + left[c] * ch;
+      auto b = l + right[c] * ch;
+      float sc = weight[c];
+      for (int k=0; k<ch; k++) dst[k] = (1 - sc) * a[k] + sc * b[k];
+    }
+  }
+}
+
+// interleaved pixels to planar channels of size pixels, scaled by factor
+template <class T, class F>
+void planar_kernel(const T* in, int pixels, int channels, F scale, F* out)
+{
+  for (int b=0; b<channels; b++)
+  {
+    auto src = in + b;
+    auto dst = out + (size_t)b * pixels;
+    for (int p=0; p<pixels; p++) dst[p] = scale * src[(size_t)p * channels];
+  }
+}
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_IMAGE_KERNEL_H_ */
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <thread>
 #include <csignal>
+#include <sstream>
+#include <vector>
 
 #include "transport.hh"
 #include "graph.pb.h"
@@ -14,21 +16,31 @@
 namespace seegnify {
 
 // master routines
-extern void master_init(const std::string& file);
-extern void master_run(const ServerContext& ctx,
+extern void master_init(const std::string& file, int updates, int seconds,
+int staleness, const std::string& policy);
+extern void master_run(ServerContext& ctx,
 graph::Request& req, graph::Response& res);
 extern void master_err(const std::exception& err, graph::Response& res);
 extern void master_term();
 
 // worker routines
 extern void worker_run(const std::string& library,
-const std::string& host, int port);
+const std::string& host, int port, int aggregate, bool deflate);
 extern void worker_term();
 
+// ring routines
+extern void ring_run(const std::string& library, int rank,
+const std::vector<std::string>& hosts, const std::string& file);
+extern void ring_term();
+
 // term routine
 typedef void (*v_routine)();
 v_routine term_routine = nullptr;
 
+// default server threads of master, each open worker connection holds one
+// while it is open, worker processes open up to CLIENT_CONNECTIONS each
+#define MASTER_THREADS 256
+
 // server type
 typedef ProtobufServer<graph::Request, graph::Response> GraphServer;
 
@@ -45,8 +57,11 @@ static void on_signal(int signum) {
 // syntax message
 void syntax(char* argv[]) {
   std::cerr << "Usage: " << argv[0] << " "
-            << "master <FILE> <PORT> | "
-            << "worker <HOST> <PORT> <IMPL>"
+            << "master <FILE> <PORT> [SAVE_UPDATES] [SAVE_SECONDS] "
+            << "[MAX_STALENESS] [scale|reject|block] [THREADS] | "
+            << "worker <HOST> <PORT> <IMPL> [AGGREGATE_BATCHES] [deflate] | "
+            << "ring <RANK> <HOST:PORT,...> <IMPL> <FILE> | "
+            << "stats <HOST> <PORT>"
             << std::endl;
 }
 
@@ -72,26 +87,34 @@ int main(int argc, char* argv[]) {
     signal(SIGINT, on_signal);
 
     if (role == "master") {
-      if (argc != 4) {
+      if (argc < 4 || argc > 9) {
         syntax(argv);
         return 1;
       }
       
       std::string file = argv[2];
       int port = std::stoi(argv[3]);
+      int updates = (argc > 4) ? std::stoi(argv[4]) : 100;
+      int seconds = (argc > 5) ? std::stoi(argv[5]) : 60;
+      int staleness = (argc > 6) ? std::stoi(argv[6]) : 0;
+      std::string policy = (argc > 7) ? argv[7] : "scale";
+      int threads = (argc > 8) ? std::stoi(argv[8]) : MASTER_THREADS;
+      if (threads < 1 || threads > 65535)
+        throw std::runtime_error("Invalid number of master threads");
       std::cout << "Starting " << role << " on port " << port << std::endl;
 
-      // start master
-      master_init(file);
+      // start master, save weights every updates or seconds,
+      // bound staleness of updates, serve connections with threads
+      master_init(file, updates, seconds, staleness, policy);
       graph_server = std::make_shared<GraphServer>(master_run, master_err);
-      graph_server->run(port, std::thread::hardware_concurrency());
+      graph_server->run(port, threads);
       master_term();
 
       std::cout << "Stopping " << role << " on port " << port << std::endl;
     }
     else
     if (role == "worker") {
-      if (argc != 5) {
+      if (argc < 5 || argc > 7) {
         syntax(argv);
         return 1;
       }
@@ -99,16 +122,63 @@ int main(int argc, char* argv[]) {
       std::string host = argv[2];
       int port = std::stoi(argv[3]);
       std::string impl = argv[4];
+      int aggregate = (argc > 5) ? std::stoi(argv[5]) : 1;
+      bool deflate = (argc > 6) && std::string(argv[6]) == "deflate";
       std::cout << "Starting " << role << " at " 
                 << host << ":" << port << std::endl;
 
-      // start worker
+      // start worker, push combined update of aggregate thread batches,
+      // compress transfers when requested
       term_routine = worker_term;
-      worker_run(impl, host, port);
+      worker_run(impl, host, port, aggregate, deflate);
 
       std::cout << "Stopping " << role << " at " 
                 << host << ":" << port << std::endl;
     }
+    else
+    if (role == "ring") {
+      if (argc != 6) {
+        syntax(argv);
+        return 1;
+      }
+
+      int rank = std::stoi(argv[2]);
+      std::vector<std::string> hosts;
+      std::istringstream list(argv[3]);
+      for (std::string host; std::getline(list, host, ',');)
+        hosts.push_back(host);
+      std::string impl = argv[4];
+      std::string file = argv[5];
+      std::cout << "Starting " << role << " rank " << rank << std::endl;
+
+      // start ring member
+      term_routine = ring_term;
+      ring_run(impl, rank, hosts, file);
+
+      std::cout << "Stopping " << role << " rank " << rank << std::endl;
+    }
+    else
+    if (role == "stats") {
+      if (argc != 4) {
+        syntax(argv);
+        return 1;
+      }
+
+      std::string host = argv[2];
+      int port = std::stoi(argv[3]);
+
+      // print master statistics
+      ProtobufClient<graph::Request, graph::Response> client;
+      client.connect(host, port);
+
+      graph::Request req;
+      graph::Response res;
+      req.mutable_get_stats();
+      client.call(req, res);
+
+      if (res.has_error()) throw std::runtime_error(res.error().message());
+      std::cout << res.get_stats().DebugString();
+    }
     else {
       std::cerr << "Unknown role '" << role << "'" << std::endl;
       return 3;
@@ -8,6 +8,10 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
+#include <unordered_map>
 
 #include "transport.hh"
 #include "training.hh"
@@ -20,15 +24,208 @@ class Master : public Training
   public:
   Master(int id) : Training(id) {}
   void batch_train() {}
+
+  // number of weight tensors
+  int size() { return graph().variables().size(); }
+
+  // weight tensor for reads, keeps its version
+  const Tensor& weight(int i)
+  {
+    const Function& w = *graph().variables()[i];
+    return w.value();
+  }
+
+  // weight tensor for writes, advances its version
+  Tensor& mutable_weight(int i) { return graph().variables()[i]->value(); }
 };
 
 // master runtime data
 
-static bool data_loaded = false;
+static std::atomic<bool> data_loaded(false);
 static Master master_data(-1);
 static std::mutex master_lock;
 static std::string master_file;
 
+// parameter shards, one per weight tensor, fixed once weights are loaded
+
+typedef std::shared_ptr<const std::string> Segment;
+
+struct Increment
+{
+  uint64_t version;
+  Segment data; // with precision and compression
+};
+
+// precisions of served weights
+#define PRECISIONS 3
+
+struct Shard
+{
+  std::mutex lock;
+  Segment weights[PRECISIONS]; // serialized on demand, null when changed
+  int rows, cols; // of weight tensor
+  uint64_t version; // start time and number of increments applied
+  std::deque<Increment> history; // recent increments
+  size_t history_bytes = 0;
+};
+
+// increments kept per shard for delta pulls, older versions get full weights
+#define SHARD_HISTORY 256
+
+static std::vector<std::unique_ptr<Shard>> shards;
+static std::vector<std::string> shard_names;
+
+// immutable serialized weights replaced on update (read-copy-update), one
+// per precision requested by workers and stored in that precision, shard
+// segments are shared with shards until those change
+
+struct Served
+{
+  Segments weights;
+  std::vector<uint64_t> versions;
+  size_t updates; // applied before weights were read
+};
+
+static std::shared_ptr<const Served> served_weights[PRECISIONS];
+static std::mutex publish_lock;
+static std::atomic<size_t> updates_applied(0);
+static size_t updates_published[PRECISIONS] = {0};
+
+// checkpoint policy and state
+
+struct Snapshot
+{
+  std::vector<std::string> names;
+  std::vector<Tensor> tensors;
+};
+
+static int save_updates = 100;
+static int save_seconds = 60;
+static std::atomic<int> updates_pending(0);
+static std::thread saver_thread;
+static std::mutex saver_lock;
+static std::condition_variable saver_cond;
+static std::unique_ptr<Snapshot> saver_snapshot;
+static bool saver_stop = false;
+
+// staleness policy, bound of 0 accepts all updates as they are
+
+enum StalePolicy
+{
+  STALE_SCALE,  // scale updates by 1 / (1 + staleness), reject past bound
+  STALE_REJECT, // reject updates past bound
+  STALE_BLOCK   // hold weights of workers ahead of slowest past bound
+};
+
+struct WorkerState
+{
+  uint64_t clock;
+  std::chrono::steady_clock::time_point seen;
+  uint64_t staleness; // of last update
+  double compute_seconds;
+  double comm_seconds;
+};
+
+// seconds after which silent workers no longer hold back others
+#define STALE_TIMEOUT 30
+
+static int max_staleness = 0;
+static StalePolicy stale_policy = STALE_SCALE;
+static std::mutex clock_lock;
+static std::condition_variable clock_cond;
+static std::unordered_map<uint64_t, WorkerState> worker_states;
+
+// runtime statistics, times in microseconds
+
+enum RequestType { REQ_GET_WEIGHTS, REQ_SET_WEIGHTS, REQ_UPD_WEIGHTS,
+  REQ_GET_STATS, REQ_TYPES };
+
+static const char* request_names[REQ_TYPES] = {
+  "get_weights", "set_weights", "upd_weights", "get_stats" };
+
+// latency buckets of powers of 2 microseconds
+#define STATS_BUCKETS 32
+
+struct RequestStats
+{
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> bytes_in;
+  std::atomic<uint64_t> bytes_out;
+  std::atomic<uint64_t> latency[STATS_BUCKETS];
+};
+
+static std::chrono::steady_clock::time_point master_start;
+static RequestStats request_stats[REQ_TYPES];
+static std::atomic<uint64_t> updates_rejected(0);
+static std::atomic<uint64_t> lock_wait(0);
+static std::atomic<uint64_t> checkpoints_saved(0);
+static std::atomic<uint64_t> checkpoint_time(0);
+
+// microseconds since time point
+inline uint64_t micros_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+// lock shard, time spent waiting for it is accounted
+std::unique_lock<std::mutex> lock_shard(Shard& shard)
+{
+  std::unique_lock<std::mutex> lock(shard.lock, std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    lock_wait += micros_since(start);
+  }
+  return lock;
+}
+
+// Stream buffer passing bytes of source through and recording them
+class RecordingBuffer : public std::streambuf
+{
+public:
+  RecordingBuffer(std::istream& in) : _in(*in.rdbuf()) {}
+
+  // take bytes read since last call
+  std::string take()
+  {
+    std::string record;
+    record.swap(_record);
+    return record;
+  }
+
+protected:
+  int_type underflow() { return _in.sgetc(); }
+
+  int_type uflow()
+  {
+    int_type c = _in.sbumpc();
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      _record.push_back(traits_type::to_char_type(c));
+    return c;
+  }
+
+  std::streamsize xsgetn(char* s, std::streamsize n)
+  {
+    n = _in.sgetn(s, n);
+    _record.append(s, n);
+    return n;
+  }
+
+private:
+  std::streambuf& _in;
+  std::string _record;
+};
+
+// serialized ints as a segment
+Segment int_segment(std::initializer_list<int> values)
+{
+  std::ostringstream out;
+  for (auto v: values) write_int(v, out);
+  return std::make_shared<std::string>(out.str());
+}
+
 // master command handlers
 
 void log_status(const std::string& info)
@@ -39,14 +236,214 @@ void log_status(const std::string& info)
             << std::endl;
 }
 
-void save_weights(const std::string& weights, const std::string& file)
+// check precision of served weights
+Precision served_precision(uint32_t precision)
+{
+  if (precision >= PRECISIONS)
+    throw std::runtime_error("Unsupported weights precision");
+  return (Precision)precision;
+}
+
+// weight tensor of shard i serialized in precision when not yet,
+// called under shard lock
+const Segment& shard_weights(int i, Precision precision)
+{
+  auto& weights = shards[i]->weights[precision];
+  if (!weights)
+  {
+    std::ostringstream out;
+    write_tensor(master_data.weight(i), out, precision);
+    weights = std::make_shared<std::string>(out.str());
+  }
+  return weights;
+}
+
+// record increment of shard i in precision, called under shard lock,
+// history is limited to the size of full weights beyond which those are
+// cheaper
+void record_increment(int i, Precision precision, const Segment& data)
+{
+  auto& shard = *shards[i];
+  shard.version++;
+  shard.history.push_back(Increment{shard.version, data});
+  shard.history_bytes += data->size();
+
+  auto full = shard_weights(i, precision)->size();
+  while (shard.history.size() > SHARD_HISTORY || shard.history_bytes > full)
+  {
+    shard.history_bytes -= shard.history.front().data->size();
+    shard.history.pop_front();
+  }
+}
+
+// add increments of shard i since version or its full weights in
+// precision to segments, called under shard lock
+void add_shard_delta(int i, uint64_t since, Precision precision,
+Segments& out)
+{
+  auto& shard = *shards[i];
+  auto& history = shard.history;
+
+  // increments held in history follow version of their first one
+  size_t count = shard.version - since;
+  if (since <= shard.version && count <= history.size())
+  {
+    out.push_back(int_segment({(int)count}));
+    for (size_t k=history.size()-count; k<history.size(); k++)
+      out.push_back(history[k].data);
+  }
+  else
+  {
+    out.push_back(int_segment({-1, precision}));
+    out.push_back(shard_weights(i, precision));
+  }
+}
+
+// build serialized weights in precision from shards and replace served
+// weights of precision, skipped when a later build already covers all
+// applied updates
+void publish_weights(Precision precision)
+{
+  std::lock_guard<std::mutex> lock(publish_lock);
+
+  size_t applied = updates_applied;
+  auto& published = updates_published[precision];
+  if (served_weights[precision] && published >= applied) return;
+
+  std::ostringstream out;
+  std::shared_ptr<Served> served(new Served());
+  write_weights_header(shards.size(), precision, out);
+  served->weights.push_back(std::make_shared<std::string>(out.str()));
+  for (int i=0; i<shards.size(); i++)
+  {
+    auto lock = lock_shard(*shards[i]);
+    served->weights.push_back(shard_weights(i, precision));
+    served->versions.push_back(shards[i]->version);
+  }
+  served->updates = applied;
+
+  std::atomic_store(&served_weights[precision],
+    std::shared_ptr<const Served>(served));
+  published = applied;
+}
+
+// create shards of loaded weights, serialized in precision of the source
+// first, called under master lock
+void init_shards(Precision precision)
+{
+  shard_names = master_data.checkpoint_names();
+  shards.clear();
+
+  // versions of earlier master instances are older
+  auto start = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+
+  for (int i=0; i<master_data.size(); i++)
+  {
+    shards.emplace_back(new Shard());
+    shards.back()->rows = master_data.weight(i).rows();
+    shards.back()->cols = master_data.weight(i).cols();
+    shards.back()->version = start;
+    shard_weights(i, precision);
+  }
+  publish_weights(precision);
+  data_loaded = true;
+}
+
+// copy weights shard by shard
+std::unique_ptr<Snapshot> take_snapshot()
 {
-  std::stringstream data(weights);
-  auto temp_file = file + ".new";
-  write_file(temp_file, data);
-  if (std::rename(temp_file.c_str(), file.c_str()))
+  updates_pending = 0;
+
+  std::unique_ptr<Snapshot> snapshot(new Snapshot());
+  snapshot->names = shard_names;
+  for (int i=0; i<shards.size(); i++)
+  {
+    auto lock = lock_shard(*shards[i]);
+    snapshot->tensors.push_back(master_data.weight(i));
+  }
+  return snapshot;
+}
+
+// write weights to master file
+void save_snapshot(const Snapshot& snapshot)
+{
+  std::vector<const Tensor*> tensors;
+  for (auto& t: snapshot.tensors) tensors.push_back(&t);
+
+  try
   {
-    throw std::runtime_error("Failed to save weights");
+    auto start = std::chrono::steady_clock::now();
+    Checkpoint::write(master_file, snapshot.names, tensors);
+    checkpoint_time = micros_since(start);
+    checkpoints_saved++;
+  }
+  catch(std::exception& e)
+  {
+    log_status(e.what());
+  }
+}
+
+// hand snapshot over to the saver thread
+void schedule_checkpoint()
+{
+  auto snapshot = take_snapshot();
+
+  // replace snapshot not written yet
+  std::lock_guard<std::mutex> lock(saver_lock);
+  saver_snapshot = std::move(snapshot);
+  saver_cond.notify_one();
+}
+
+// write snapshots in background, take one when updates are pending
+// for save_seconds
+void saver_run()
+{
+  while (true)
+  {
+    std::unique_ptr<Snapshot> snapshot;
+    {
+      std::unique_lock<std::mutex> lock(saver_lock);
+      saver_cond.wait_for(lock, std::chrono::seconds(save_seconds),
+        []() { return saver_snapshot || saver_stop; });
+      if (saver_stop) return;
+      snapshot = std::move(saver_snapshot);
+    }
+
+    if (!snapshot && updates_pending) snapshot = take_snapshot();
+
+    if (snapshot) save_snapshot(*snapshot);
+  }
+}
+
+// record batch clock of worker process, called under clock lock
+WorkerState& update_clock(uint64_t worker, uint64_t clock)
+{
+  auto& e = worker_states[worker];
+  e.clock = std::max(e.clock, clock);
+  e.seen = std::chrono::steady_clock::now();
+  clock_cond.notify_all();
+  return e;
+}
+
+// wait until worker at clock is within bound of slowest active worker
+void wait_clock(uint64_t clock)
+{
+  std::unique_lock<std::mutex> lock(clock_lock);
+  while (true)
+  {
+    auto now = std::chrono::steady_clock::now();
+    auto timeout = std::chrono::seconds(STALE_TIMEOUT);
+    uint64_t slowest = clock;
+    for (auto& e: worker_states)
+    {
+      if (now - e.second.seen < timeout)
+        slowest = std::min(slowest, e.second.clock);
+    }
+    if (clock - slowest <= (uint64_t)max_staleness) return;
+
+    // silent workers time out while waiting
+    clock_cond.wait_for(lock, std::chrono::seconds(1));
   }
 }
 
@@ -57,16 +454,62 @@ std::string load_weights(const std::string& file)
   return data.str();
 }
 
-void on_get_weights(const graph::GetWeights& req, graph::Response& res)
+void on_get_weights(ServerContext& ctx,
+const graph::GetWeights& req, graph::Response& res)
 {
   if (!data_loaded) throw std::runtime_error("Server weights not loaded");
 
-  std::lock_guard<std::mutex> lock(master_lock);
+  // hold workers too far ahead of others
+  if (req.has_worker())
+  {
+    {
+      std::lock_guard<std::mutex> lock(clock_lock);
+      update_clock(req.worker(), req.clock());
+    }
+    if (stale_policy == STALE_BLOCK && max_staleness > 0)
+      wait_clock(req.clock());
+  }
+
   auto response = res.mutable_get_weights(); 
-  response->set_weights(master_data.get_weights());
+  auto precision = served_precision(req.precision());
+
+  // serve current snapshot of worker precision without blocking updates,
+  // built when missing or behind applied updates
+  int size = shards.size();
+  if (req.since_version_size() != size)
+  {
+    auto served = std::atomic_load(&served_weights[precision]);
+    if (!served || served->updates < updates_applied)
+    {
+      publish_weights(precision);
+      served = std::atomic_load(&served_weights[precision]);
+    }
+    ctx.reply(served->weights);
+    response->set_updates(served->updates);
+    for (auto v: served->versions) response->add_version(v);
+    return;
+  }
+
+  response->set_updates(updates_applied);
+
+  // serve increments since worker versions, nothing when current
+  Segments out;
+  bool current = true;
+  out.push_back(int_segment({size}));
+  for (int i=0; i<size; i++)
+  {
+    auto lock = lock_shard(*shards[i]);
+    current &= (shards[i]->version == req.since_version(i));
+    add_shard_delta(i, req.since_version(i), precision, out);
+    response->add_version(shards[i]->version);
+  }
+
+  response->set_delta(true);
+  if (!current) ctx.reply(out);
 }
 
-void on_set_weights(const graph::SetWeights& req, graph::Response& res)
+void on_set_weights(ServerContext& ctx,
+const graph::SetWeights& req, graph::Response& res)
 {
   // set response success
   auto response = res.mutable_success();
@@ -76,44 +519,194 @@ void on_set_weights(const graph::SetWeights& req, graph::Response& res)
   // accept when data not set
   if (data_loaded) return;
 
-  // set graph weights
-  master_data.set_weights(req.weights());
-  data_loaded = true;
+  // read graph weights, serialize them in worker precision first
+  if (!ctx.has_payload()) throw std::runtime_error("Missing weights");
+  init_shards(master_data.set_weights(ctx.payload()));
 
   // save graph weights
-  save_weights(master_data.get_weights(), master_file);
+  schedule_checkpoint();
   log_status("Weights set");
 }
 
-void on_upd_weights(const graph::UpdWeights& req, graph::Response& res)
+void on_upd_weights(ServerContext& ctx,
+const graph::UpdWeights& req, graph::Response& res)
 {
+  if (!data_loaded) throw std::runtime_error("Server weights not loaded");
+  if (!ctx.has_payload()) throw std::runtime_error("Missing weights update");
+
   // set response success
   auto response = res.mutable_success();
-    
-  std::lock_guard<std::mutex> lock(master_lock);
 
-  // apply weights update
-  master_data.upd_weights(req.update());
+  // updates applied since weights of this update were pulled
+  int64_t staleness = 0;
+  if (req.has_updates())
+    staleness = std::max<int64_t>(0,
+      (int64_t)updates_applied - (int64_t)req.updates());
 
-  // save graph weights
-  save_weights(master_data.get_weights(), master_file);
+  if (req.has_worker())
+  {
+    std::lock_guard<std::mutex> lock(clock_lock);
+    auto& state = update_clock(req.worker(), req.clock());
+    state.staleness = staleness;
+    state.compute_seconds = req.compute_seconds();
+    state.comm_seconds = req.comm_seconds();
+  }
+
+  DTYPE scale = 1;
+  if (max_staleness > 0 && stale_policy != STALE_BLOCK)
+  {
+    if (staleness > max_staleness)
+    {
+      response->set_scale(0);
+      updates_rejected++;
+      log_status("Weights update rejected");
+      return;
+    }
+    if (stale_policy == STALE_SCALE) scale = 1.0 / (1 + staleness);
+  }
+  response->set_scale(scale);
+
+  // history holds bytes of each increment as received
+  RecordingBuffer record(ctx.payload());
+  std::istream in(&record);
+  auto compression = (Compression)req.compression();
+  Precision precision;
+  int size = read_weights_header(in, precision);
+  if (size != shards.size())
+    throw std::runtime_error("Incompatible number of variables");
+
+  // apply weights update tensor by tensor, each read before its shard
+  // is locked to keep transfers out of locks, weights are only touched
+  // under shard lock
+  for (int i=0; i<size; i++)
+  {
+    auto& shard = *shards[i];
+    Tensor delta = Tensor::Zero(shard.rows, shard.cols);
+    record.take();
+    read_update(delta, precision, compression, in);
+    if (!in) throw std::runtime_error("Failed to read weights update");
+
+    // history holds applied increment, as received when not scaled
+    std::ostringstream increment;
+    write_int(precision, increment);
+    if (scale == 1)
+    {
+      write_int(compression, increment);
+      increment << record.take();
+    }
+    else
+    {
+      delta *= scale;
+      write_int(DENSE, increment);
+      write_tensor(delta, increment, precision);
+    }
+
+    // serialized weights of other precisions follow on demand
+    auto lock = lock_shard(shard);
+    master_data.mutable_weight(i) += delta; // (+)
+    for (auto& e: shard.weights) e.reset();
+    record_increment(i, precision,
+      std::make_shared<std::string>(increment.str()));
+  }
+
+  updates_applied++;
+  publish_weights(precision);
+
+  // save graph weights every save_updates
+  if (++updates_pending >= save_updates) schedule_checkpoint();
   log_status("Weights updated");
 }
 
+void on_get_stats(const graph::GetStats& req, graph::Response& res)
+{
+  auto response = res.mutable_get_stats();
+
+  double uptime = micros_since(master_start) * 1e-6;
+  response->set_uptime_seconds(uptime);
+  response->set_updates(updates_applied);
+  response->set_updates_per_second(uptime > 0 ? updates_applied / uptime : 0);
+  response->set_rejected(updates_rejected);
+
+  uint64_t bytes_in = 0, bytes_out = 0;
+  for (int i=0; i<REQ_TYPES; i++)
+  {
+    auto& stats = request_stats[i];
+    auto request = response->add_request();
+    request->set_name(request_names[i]);
+    request->set_count(stats.count);
+    request->set_bytes_in(stats.bytes_in);
+    request->set_bytes_out(stats.bytes_out);
+
+    // trailing empty buckets are omitted
+    int buckets = STATS_BUCKETS;
+    while (buckets > 0 && stats.latency[buckets - 1] == 0) buckets--;
+    for (int b=0; b<buckets; b++) request->add_latency(stats.latency[b]);
+
+    bytes_in += stats.bytes_in;
+    bytes_out += stats.bytes_out;
+  }
+  response->set_bytes_in(bytes_in);
+  response->set_bytes_out(bytes_out);
+
+  response->set_lock_wait_seconds(lock_wait * 1e-6);
+  response->set_checkpoints(checkpoints_saved);
+  response->set_checkpoint_seconds(checkpoint_time * 1e-6);
+
+  std::lock_guard<std::mutex> lock(clock_lock);
+  auto now = std::chrono::steady_clock::now();
+  int active = 0;
+  for (auto& e: worker_states)
+  {
+    double idle = std::chrono::duration<double>(now - e.second.seen).count();
+    if (idle < STALE_TIMEOUT) active++;
+
+    auto worker = response->add_worker();
+    worker->set_worker(e.first);
+    worker->set_clock(e.second.clock);
+    worker->set_staleness(e.second.staleness);
+    worker->set_idle_seconds(idle);
+    worker->set_compute_seconds(e.second.compute_seconds);
+    worker->set_comm_seconds(e.second.comm_seconds);
+  }
+  response->set_workers(active);
+}
+
 // master routines
 
-void master_init(const std::string& file)
+void master_init(const std::string& file, int updates, int seconds,
+int staleness, const std::string& policy)
 {
-  // init master file name
+  // init master file name and checkpoint policy
+  master_start = std::chrono::steady_clock::now();
   master_file = file;
+  save_updates = std::max(updates, 1);
+  save_seconds = std::max(seconds, 1);
+
+  // init staleness policy
+  max_staleness = std::max(staleness, 0);
+  if (policy == "scale") stale_policy = STALE_SCALE;
+  else
+  if (policy == "reject") stale_policy = STALE_REJECT;
+  else
+  if (policy == "block") stale_policy = STALE_BLOCK;
+  else
+    throw std::runtime_error("Unknown staleness policy '" + policy + "'");
 
   try
   {
     std::lock_guard<std::mutex> lock(master_lock);
 
-    // load stored weights
-    master_data.set_weights(load_weights(master_file));
-    data_loaded = true;
+    // load stored weights, serialized weights of earlier versions included
+    Precision precision = FP32;
+    if (Checkpoint::is_checkpoint(master_file))
+      master_data.load_checkpoint(master_file, true);
+    else
+    {
+      auto weights = load_weights(master_file);
+      master_data.set_weights(weights);
+      precision = weights_precision(weights);
+    }
+    init_shards(precision);
 
     // log status
     log_status("Weights loaded from " + file);
@@ -125,20 +718,54 @@ void master_init(const std::string& file)
     std::lock_guard<std::mutex> lock(master_lock);
     log_status("Initialized without weights");
   }
+
+  saver_thread = std::thread(saver_run);
 }
 
-void master_run(const ServerContext& ctx,
+void master_run(ServerContext& ctx,
 graph::Request& req, graph::Response& res)
 {
-  if (req.has_upd_weights()) on_upd_weights(req.upd_weights(), res);
+  auto start = std::chrono::steady_clock::now();
+
+  RequestType type;
+  if (req.has_upd_weights())
+  {
+    type = REQ_UPD_WEIGHTS;
+    on_upd_weights(ctx, req.upd_weights(), res);
+  }
   else
-  if (req.has_get_weights()) on_get_weights(req.get_weights(), res);
+  if (req.has_get_weights())
+  {
+    type = REQ_GET_WEIGHTS;
+    on_get_weights(ctx, req.get_weights(), res);
+  }
+  else
+  if (req.has_set_weights())
+  {
+    type = REQ_SET_WEIGHTS;
+    on_set_weights(ctx, req.set_weights(), res);
+  }
   else
-  if (req.has_set_weights()) on_set_weights(req.set_weights(), res);
+  if (req.has_get_stats())
+  {
+    type = REQ_GET_STATS;
+    on_get_stats(req.get_stats(), res);
+  }
   else
   {
     throw std::runtime_error("Command Not Supported");
   }
+
+  // account request in bucket of its latency
+  auto micros = micros_since(start);
+  int bucket = 0;
+  while (bucket < STATS_BUCKETS - 1 && (micros >> bucket) > 0) bucket++;
+
+  auto& stats = request_stats[type];
+  stats.count++;
+  stats.bytes_in += req.ByteSizeLong() + ctx.payload_in();
+  stats.bytes_out += res.ByteSizeLong() + ctx.payload_out();
+  stats.latency[bucket]++;
 }
 
 void master_err(const std::exception& err, graph::Response& res)
@@ -150,6 +777,17 @@ void master_err(const std::exception& err, graph::Response& res)
 
 void master_term()
 {
+  // stop saver and flush pending weights
+  {
+    std::lock_guard<std::mutex> lock(saver_lock);
+    saver_stop = true;
+    saver_cond.notify_one();
+  }
+  if (saver_thread.joinable()) saver_thread.join();
+
+  if (saver_snapshot) save_snapshot(*saver_snapshot);
+  if (data_loaded && updates_pending) save_snapshot(*take_snapshot());
+
   if (!data_loaded)
   {
     std::cout << "no state saved" << std::endl;
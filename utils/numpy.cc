@@ -0,0 +1,504 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "numpy.hh"
+
+namespace seegnify {
+
+#define NUMPY_ALIGN 64
+#define NUMPY_MAGIC "\x93NUMPY"
+
+// zip records
+#define ZIP_LOCAL 0x04034b50
+#define ZIP_CENTRAL 0x02014b50
+#define ZIP_END 0x06054b50
+#define ZIP64_END 0x06064b50
+#define ZIP64_LOCATOR 0x07064b50
+#define ZIP64_EXTRA 0x0001
+#define ZIP_ALIGN_EXTRA 0xD935
+#define ZIP_LIMIT 0xFFFFFFFFULL
+
+///////////////////////////////////////////
+// byte order helpers
+///////////////////////////////////////////
+
+static inline uint64_t le(const char* p, int bytes)
+{
+  uint64_t v = 0;
+  for (int i=bytes-1; i>=0; i--) v = (v << 8) | (uint8_t)p[i];
+  return v;
+}
+
+static inline void put(std::string& s, uint64_t v, int bytes)
+{
+  for (int i=0; i<bytes; i++, v>>=8) s.push_back(char(v & 0xFF));
+}
+
+static uint32_t checksum(uLong crc, const char* data, size_t size)
+{
+  // crc32 takes up to 4GB at a time
+  while (size)
+  {
+    uInt n = (uInt)std::min<size_t>(size, 1 << 30);
+    crc = crc32(crc, (const Bytef*)data, n);
+    data += n;
+    size -= n;
+  }
+
+  return crc;
+}
+
+// numpy type of DTYPE
+static std::string descr()
+{
+  return "<f" + std::to_string(sizeof(DTYPE));
+}
+
+// value of key in array header
+static std::string field(const std::string& header, const std::string& key)
+{
+  auto pos = header.find("'" + key + "'");
+  if (pos == std::string::npos) return "";
+  pos = header.find(':', pos);
+  if (pos == std::string::npos) return "";
+  pos = header.find_first_not_of(' ', pos + 1);
+  if (pos == std::string::npos) return "";
+
+  auto end = (header[pos] == '(') ? header.find(')', pos) + 1 :
+    (header[pos] == '\'') ? header.find('\'', pos + 1) + 1 :
+    header.find_first_of(",}", pos);
+
+  return header.substr(pos, end - pos);
+}
+
+///////////////////////////////////////////
+// NumpyFile impl
+///////////////////////////////////////////
+
+NumpyFile::NumpyFile(const std::string& path) : _path(path), _file(path)
+{
+  if (_file.size() >= 6 && std::memcmp(_file.data(), NUMPY_MAGIC, 6) == 0)
+  {
+    auto stem = path.substr(path.find_last_of('/') + 1);
+    parse_array(stem.substr(0, stem.rfind(".npy")), 0, _file.size());
+  }
+  else if (_file.size() >= 4 && le(_file.data(), 4) == ZIP_LOCAL)
+    parse_archive();
+  else
+    throw std::runtime_error("Invalid numpy file '" + _path + "'");
+}
+
+void NumpyFile::parse_array(const std::string& name, size_t offset,
+size_t bytes)
+{
+  auto p = _file.data() + offset;
+  if (bytes < 10 || std::memcmp(p, NUMPY_MAGIC, 6))
+    throw std::runtime_error("Invalid numpy array '" + name + "' in '" +
+      _path + "'");
+
+  // header length of version 1 takes 2 bytes, of later versions 4
+  int start = (p[6] == 1) ? 10 : 12;
+  size_t length = le(p + 8, start - 8);
+  if (start + length > bytes)
+    throw std::runtime_error("Truncated numpy array '" + name + "' in '" +
+      _path + "'");
+
+  std::string header(p + start, length);
+  if (field(header, "descr") != "'" + descr() + "'" ||
+      field(header, "fortran_order") != "False")
+    throw std::runtime_error("Unsupported type of numpy array '" + name +
+      "' in '" + _path + "', expected C ordered " + descr());
+
+  Entry e;
+  e.name = name;
+  e.offset = offset + start + length;
+
+  // dimensions of shape tuple
+  std::istringstream shape(field(header, "shape"));
+  shape.ignore(1);
+  size_t dim, count = 1;
+  while (shape >> dim)
+  {
+    e.shape.push_back(dim);
+    count *= dim;
+    shape.ignore(1);
+  }
+
+  e.rows = (e.shape.size() < 2) ? 1 : e.shape[0];
+  e.cols = (e.rows > 0) ? count / e.rows : 0;
+
+  if (e.offset + count * sizeof(DTYPE) > offset + bytes)
+    throw std::runtime_error("Truncated numpy array '" + name + "' in '" +
+      _path + "'");
+
+  _index[e.name] = _entries.size();
+  _entries.push_back(e);
+}
+
+void NumpyFile::parse_archive()
+{
+  auto data = _file.data();
+  size_t size = _file.size();
+  auto invalid = std::runtime_error("Invalid numpy archive '" + _path + "'");
+
+  // end of central directory, followed by comment of up to 64KB
+  if (size < 22) throw invalid;
+  size_t end = size - 22;
+  while (le(data + end, 4) != ZIP_END)
+  {
+    if (end == 0 || size - end > 22 + 0xFFFF) throw invalid;
+    end--;
+  }
+
+  uint64_t count = le(data + end + 10, 2);
+  uint64_t directory = le(data + end + 16, 4);
+
+  // zip64 end of central directory
+  if (count == 0xFFFF || directory == ZIP_LIMIT)
+  {
+    if (end < 20 || le(data + end - 20, 4) != ZIP64_LOCATOR) throw invalid;
+    size_t end64 = le(data + end - 20 + 8, 8);
+    if (end64 + 56 > size || le(data + end64, 4) != ZIP64_END) throw invalid;
+    count = le(data + end64 + 32, 8);
+    directory = le(data + end64 + 48, 8);
+  }
+
+  size_t pos = directory;
+  for (uint64_t i=0; i<count; i++)
+  {
+    if (pos + 46 > size || le(data + pos, 4) != ZIP_CENTRAL) throw invalid;
+
+    int method = le(data + pos + 10, 2);
+    uint64_t bytes = le(data + pos + 24, 4);
+    uint64_t packed = le(data + pos + 20, 4);
+    size_t name_size = le(data + pos + 28, 2);
+    size_t extra_size = le(data + pos + 30, 2);
+    size_t comment_size = le(data + pos + 32, 2);
+    uint64_t local = le(data + pos + 42, 4);
+
+    std::string name(data + pos + 46, name_size);
+
+    // zip64 values of fields at limit
+    auto extra = data + pos + 46 + name_size;
+    for (size_t e=0; e + 4 <= extra_size;)
+    {
+      size_t id = le(extra + e, 2), length = le(extra + e + 2, 2);
+      if (id == ZIP64_EXTRA)
+      {
+        auto value = extra + e + 4;
+        if (bytes == ZIP_LIMIT) { bytes = le(value, 8); value += 8; }
+        if (packed == ZIP_LIMIT) { packed = le(value, 8); value += 8; }
+        if (local == ZIP_LIMIT) { local = le(value, 8); value += 8; }
+      }
+      e += 4 + length;
+    }
+
+    pos += 46 + name_size + extra_size + comment_size;
+
+    if (method != 0 || packed != bytes)
+      throw std::runtime_error("Compressed numpy archive '" + _path +
+        "' is not supported");
+
+    if (local + 30 > size || le(data + local, 4) != ZIP_LOCAL) throw invalid;
+    size_t offset = local + 30 + le(data + local + 26, 2) +
+      le(data + local + 28, 2);
+    if (offset + bytes > size) throw invalid;
+
+    auto n = name.size();
+    if (n > 4 && name.compare(n - 4, 4, ".npy") == 0) name.resize(n - 4);
+
+    parse_array(name, offset, bytes);
+  }
+}
+
+ConstTensorMap NumpyFile::tensor(int i) const
+{
+  auto& e = _entries[i];
+  auto data = _file.data() + e.offset;
+
+  if ((uintptr_t)data % alignof(DTYPE))
+    throw std::runtime_error("Unaligned numpy array '" + e.name + "' in '" +
+      _path + "'");
+
+  return ConstTensorMap((const DTYPE*)data, e.rows, e.cols);
+}
+
+void NumpyFile::copy(int i, Tensor& out) const
+{
+  auto& e = _entries[i];
+  out.resize(e.rows, e.cols);
+  std::memcpy(out.data(), _file.data() + e.offset,
+    out.size() * sizeof(DTYPE));
+}
+
+// array header padded so that array data is aligned
+static std::string array_header(const Tensor& t)
+{
+  std::ostringstream dict;
+  dict << "{'descr': '" << descr() << "', 'fortran_order': False, 'shape': (";
+  if (t.rows() == 1) dict << t.cols() << ",), }";
+  else dict << t.rows() << ", " << t.cols() << "), }";
+
+  auto text = dict.str();
+  size_t length = text.size() + 1;
+  int start = (length + 10 < 0x10000) ? 10 : 12;
+  length = (start + length + NUMPY_ALIGN - 1) / NUMPY_ALIGN * NUMPY_ALIGN;
+  length -= start;
+
+  std::string header(NUMPY_MAGIC, 6);
+  header.push_back(start == 10 ? 1 : 2);
+  header.push_back(0);
+  put(header, length, start - 8);
+  header += text;
+  header.append(length - text.size() - 1, ' ');
+  header.push_back('\n');
+
+  return header;
+}
+
+// write all bytes at offset of file
+static bool write_at(int fd, const char* data, size_t size, size_t offset)
+{
+  while (size)
+  {
+    auto n = pwrite(fd, data, std::min<size_t>(size, 1 << 30), offset);
+    if (n <= 0) return false;
+    data += n;
+    size -= n;
+    offset += n;
+  }
+
+  return true;
+}
+
+void NumpyFile::write(const std::string& path,
+const std::vector<std::string>& names,
+const std::vector<const Tensor*>& tensors)
+{
+  if (names.size() != tensors.size())
+    throw std::runtime_error("Incompatible number of names and tensors");
+
+  int size = tensors.size();
+
+  // layout of local headers and data
+  std::vector<std::string> locals(size), headers(size);
+  std::vector<uint64_t> offsets(size), bytes(size);
+  uint64_t offset = 0;
+  for (int i=0; i<size; i++)
+  {
+    auto name = names[i] + ".npy";
+    headers[i] = array_header(*tensors[i]);
+    bytes[i] = headers[i].size() + tensors[i]->size() * sizeof(DTYPE);
+    offsets[i] = offset;
+
+    bool large = bytes[i] >= ZIP_LIMIT;
+    size_t fixed = 30 + name.size() + (large ? 20 : 0) + 6;
+    size_t pad = (NUMPY_ALIGN - (offset + fixed) % NUMPY_ALIGN) % NUMPY_ALIGN;
+
+    auto& h = locals[i];
+    put(h, ZIP_LOCAL, 4);
+    put(h, large ? 45 : 20, 2);           // version needed
+    put(h, 0, 2);                         // flags
+    put(h, 0, 2);                         // stored
+    put(h, 0, 2);                         // time
+    put(h, 0x21, 2);                      // date
+    put(h, 0, 4);                         // crc, set when known
+    put(h, large ? ZIP_LIMIT : bytes[i], 4);
+    put(h, large ? ZIP_LIMIT : bytes[i], 4);
+    put(h, name.size(), 2);
+    put(h, fixed - 30 - name.size() + pad, 2);
+    h += name;
+    if (large)
+    {
+      put(h, ZIP64_EXTRA, 2);
+      put(h, 16, 2);
+      put(h, bytes[i], 8);
+      put(h, bytes[i], 8);
+    }
+
+    // alignment of data as used by zipalign
+    put(h, ZIP_ALIGN_EXTRA, 2);
+    put(h, 2 + pad, 2);
+    put(h, NUMPY_ALIGN, 2);
+    h.append(pad, '\0');
+
+    offset += h.size() + bytes[i];
+  }
+
+  // write to temporary file and rename when complete
+  auto temp_file = path + ".new";
+  int fd = open(temp_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    std::ostringstream error;
+    error << "Failed to write file '" << temp_file << "'. Error code ";
+    error << errno << " .";
+    throw std::runtime_error(error.str());
+  }
+
+  // checksums and entries in parallel
+  std::vector<uint32_t> crcs(size);
+  std::atomic<bool> failed(false);
+
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i=0; i<size; i++)
+  {
+    auto data = (const char*)tensors[i]->data();
+    auto header = headers[i].data();
+    size_t header_size = headers[i].size();
+    size_t data_size = bytes[i] - header_size;
+
+    uLong crc = checksum(crc32(0L, Z_NULL, 0), header, header_size);
+    crcs[i] = checksum(crc, data, data_size);
+
+    auto& local = locals[i];
+    for (int b=0; b<4; b++) local[14 + b] = char((crcs[i] >> (8 * b)) & 0xFF);
+
+    auto pos = offsets[i];
+    if (!write_at(fd, local.data(), local.size(), pos) ||
+        !write_at(fd, header, header_size, pos + local.size()) ||
+        !write_at(fd, data, data_size, pos + local.size() + header_size))
+      failed = true;
+  }
+
+  // central directory
+  std::string directory;
+  for (int i=0; i<size; i++)
+  {
+    auto name = names[i] + ".npy";
+    bool large = bytes[i] >= ZIP_LIMIT;
+    bool far = offsets[i] >= ZIP_LIMIT;
+
+    std::string extra;
+    if (large || far)
+    {
+      put(extra, ZIP64_EXTRA, 2);
+      put(extra, (large ? 16 : 0) + (far ? 8 : 0), 2);
+      if (large) { put(extra, bytes[i], 8); put(extra, bytes[i], 8); }
+      if (far) put(extra, offsets[i], 8);
+    }
+
+    put(directory, ZIP_CENTRAL, 4);
+    put(directory, 45, 2);                // version made by
+    put(directory, (large || far) ? 45 : 20, 2);
+    put(directory, 0, 2);                 // flags
+    put(directory, 0, 2);                 // stored
+    put(directory, 0, 2);                 // time
+    put(directory, 0x21, 2);              // date
+    put(directory, crcs[i], 4);
+    put(directory, large ? ZIP_LIMIT : bytes[i], 4);
+    put(directory, large ? ZIP_LIMIT : bytes[i], 4);
+    put(directory, name.size(), 2);
+    put(directory, extra.size(), 2);
+    put(directory, 0, 2);                 // comment
+    put(directory, 0, 2);                 // disk
+    put(directory, 0, 2);                 // internal attributes
+    put(directory, 0, 4);                 // external attributes
+    put(directory, far ? ZIP_LIMIT : offsets[i], 4);
+    directory += name;
+    directory += extra;
+  }
+
+  // zip64 end of central directory when limits are exceeded
+  uint64_t end = offset + directory.size();
+  if (size >= 0xFFFF || offset >= ZIP_LIMIT || directory.size() >= ZIP_LIMIT)
+  {
+    put(directory, ZIP64_END, 4);
+    put(directory, 44, 8);
+    put(directory, 45, 2);
+    put(directory, 45, 2);
+    put(directory, 0, 4);
+    put(directory, 0, 4);
+    put(directory, size, 8);
+    put(directory, size, 8);
+    put(directory, end - offset, 8);
+    put(directory, offset, 8);
+
+    put(directory, ZIP64_LOCATOR, 4);
+    put(directory, 0, 4);
+    put(directory, end, 8);
+    put(directory, 1, 4);
+  }
+
+  put(directory, ZIP_END, 4);
+  put(directory, 0, 2);
+  put(directory, 0, 2);
+  put(directory, std::min<uint64_t>(size, 0xFFFF), 2);
+  put(directory, std::min<uint64_t>(size, 0xFFFF), 2);
+  put(directory, std::min<uint64_t>(end - offset, ZIP_LIMIT), 4);
+  put(directory, std::min<uint64_t>(offset, ZIP_LIMIT), 4);
+  put(directory, 0, 2);
+
+  if (!write_at(fd, directory.data(), directory.size(), offset))
+    failed = true;
+
+  if (close(fd) || failed || std::rename(temp_file.c_str(), path.c_str()))
+  {
+    throw std::runtime_error("Failed to save numpy archive '" + path + "'");
+  }
+}
+
+///////////////////////////////////////////
+// graph variables
+///////////////////////////////////////////
+
+int load_numpy(const std::string& path, Graph& graph)
+{
+  NumpyFile file(path);
+
+  auto vars = graph.named_variables();
+  std::vector<std::pair<int, Tensor*>> bound;
+  for (auto& it: vars)
+  {
+    int i = file.find(it.first);
+    if (i < 0) continue;
+
+    auto& value = it.second->value();
+    if (file.rows(i) != value.rows() || file.cols(i) != value.cols())
+      throw std::runtime_error("Incompatible shape of numpy array '" +
+        it.first + "' in '" + path + "'");
+
+    bound.emplace_back(i, &value);
+  }
+
+  // copy mapped arrays in parallel
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k=0; k<(int)bound.size(); k++)
+    file.copy(bound[k].first, *bound[k].second);
+
+  return bound.size();
+}
+
+void save_numpy(const std::string& path, const Graph& graph)
+{
+  std::vector<std::string> names;
+  std::vector<const Tensor*> tensors;
+
+  for (auto& it: graph.named_variables())
+  {
+    names.push_back(it.first);
+    tensors.push_back(&it.second->value());
+  }
+
+  NumpyFile::write(path, names, tensors);
+}
+
+} /* namespace */
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_NUMPY_H_
+#define _SEEGNIFY_NUMPY_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "main/types.hh"
+#include "main/graph.hh"
+#include "utils/dataset.hh"
+
+namespace seegnify {
+
+// Arrays of an uncompressed .npz archive or of a .npy file mapped read-only
+// from disk. Arrays must be C ordered with elements of DTYPE. Arrays of
+// 0 and 1 dimension are single row tensors, higher ones have the first
+// dimension in rows and all the others in cols.
+class NumpyFile
+{
+public:
+  NumpyFile(const std::string& path);
+
+  // number of arrays
+  int size() const { return _entries.size(); }
+
+  // array name, without .npy in archives, file stem of .npy file
+  const std::string& name(int i) const { return _entries[i].name; }
+
+  // array dimensions
+  const std::vector<size_t>& shape(int i) const { return _entries[i].shape; }
+
+  // tensor rows and cols of array
+  int rows(int i) const { return _entries[i].rows; }
+  int cols(int i) const { return _entries[i].cols; }
+
+  // array view into the mapped file, data must be aligned to DTYPE
+  ConstTensorMap tensor(int i) const;
+
+  // copy array to tensor of the same shape, data may be unaligned
+  void copy(int i, Tensor& out) const;
+
+  // array index by name, -1 when not found
+  int find(const std::string& name) const
+  {
+    auto it = _index.find(name);
+    return (it == _index.end()) ? -1 : it->second;
+  }
+
+  // save named tensors to uncompressed .npz archive with array data
+  // aligned to 64 bytes, entries are written by parallel threads
+  static void write(const std::string& path,
+  const std::vector<std::string>& names,
+  const std::vector<const Tensor*>& tensors);
+
+private:
+  struct Entry
+  {
+    std::string name;
+    std::vector<size_t> shape;
+    int rows;
+    int cols;
+    size_t offset;
+  };
+
+  // parse array header at offset of bytes, add entry of name
+  void parse_array(const std::string& name, size_t offset, size_t bytes);
+
+  // parse zip directory
+  void parse_archive();
+
+  std::string _path;
+  MappedFile _file;
+  std::vector<Entry> _entries;
+  std::unordered_map<std::string, int> _index;
+};
+
+// copy arrays to named variables of graph, return number of variables set
+int load_numpy(const std::string& path, Graph& graph);
+
+// save named variables of graph to .npz archive
+void save_numpy(const std::string& path, const Graph& graph);
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_NUMPY_H_ */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <stdexcept>
+
+#include "pipeline.hh"
+
+namespace seegnify {
+
+// spread of generator seeds of consecutive batches
+#define SEED_STRIDE 0x9E3779B97F4A7C15ULL
+
+Pipeline::Pipeline(int size, int batch, int inputs, int outputs,
+const Prepare& prepare, int threads, int capacity, uint64_t seed) :
+_size(size), _batch(batch), _inputs(inputs), _outputs(outputs),
+_capacity(capacity), _seed(seed), _prepare(prepare)
+{
+  if (size <= 0 || batch <= 0 || threads <= 0 || capacity <= 0)
+    throw std::runtime_error("Invalid pipeline configuration");
+
+  _sampler.seed(seed);
+  _epoch.resize(size);
+  for (int i=0; i<size; i++) _epoch[i] = i;
+  _position = size;
+
+  _claimed = 0;
+  _taken = 0;
+  _stop = false;
+
+  for (int i=0; i<threads; i++) _workers.emplace_back(&Pipeline::work, this);
+}
+
+Pipeline::~Pipeline()
+{
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _stop = true;
+  }
+  _space.notify_all();
+  _ready.notify_all();
+
+  for (auto& w: _workers) w.join();
+}
+
+void Pipeline::take(Batch& batch)
+{
+  std::unique_lock<std::mutex> lock(_lock);
+
+  _ready.wait(lock, [&]() { return _error || _queue.count(_taken); });
+  if (_error) std::rethrow_exception(_error);
+
+  // swap in ready batch, recycle buffers of the previous one
+  auto it = _queue.find(_taken);
+  std::swap(batch, it->second);
+  _free.push_back(std::move(it->second));
+  _queue.erase(it);
+  _taken++;
+
+  lock.unlock();
+  _space.notify_one();
+}
+
+void Pipeline::sample(std::vector<int>& index)
+{
+  index.resize(_batch);
+
+  for (int i=0; i<_batch; i++)
+  {
+    if (_position == _size)
+    {
+      _sampler.shuffle(_epoch.begin(), _epoch.end());
+      _position = 0;
+    }
+
+    index[i] = _epoch[_position++];
+  }
+}
+
+void Pipeline::work()
+{
+  RNG rng;
+
+  while (true)
+  {
+    Batch batch;
+    long number;
+
+    // claim next batch number and its samples
+    {
+      std::unique_lock<std::mutex> lock(_lock);
+
+      _space.wait(lock, [&]()
+      {
+        return _stop || _claimed - _taken < _capacity;
+      });
+      if (_stop) return;
+
+      number = _claimed++;
+      if (_free.size())
+      {
+        batch = std::move(_free.back());
+        _free.pop_back();
+      }
+      sample(batch.index);
+    }
+
+    // prepare samples outside of the lock
+    try
+    {
+      batch.input.setZero(_batch, _inputs);
+      batch.target.setZero(_batch, _outputs);
+
+      rng.seed(_seed + (number + 1) * SEED_STRIDE);
+      for (int r=0; r<_batch; r++) _prepare(batch.index[r], batch, r, rng);
+    }
+    catch (...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (!_error) _error = std::current_exception();
+        _stop = true;
+      }
+      _ready.notify_all();
+      _space.notify_all();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_lock);
+      _queue[number] = std::move(batch);
+    }
+    _ready.notify_all();
+  }
+}
+
+} /* namespace */
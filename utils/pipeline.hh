@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_PIPELINE_H_
+#define _SEEGNIFY_PIPELINE_H_
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "main/types.hh"
+#include "main/random.hh"
+
+namespace seegnify {
+
+// Batch of samples prepared by the pipeline
+struct Batch
+{
+  Tensor input;           // [batch x inputs]
+  Tensor target;          // [batch x outputs]
+  std::vector<int> index; // sample index of each row
+};
+
+// Prefetching data pipeline. Samples are drawn from shuffled epochs of the
+// dataset and prepared in batches by worker threads, while the training
+// thread takes the batches ready in a bounded queue. Batches come out in
+// sampling order and each one is prepared with a generator seeded by the
+// pipeline seed and the batch number, so the sequence does not depend on the
+// number of workers.
+class Pipeline
+{
+public:
+  // prepare sample of index in batch row, draw augmentation from rng
+  typedef std::function<void(int index, Batch& batch, int row, RNG& rng)>
+  Prepare;
+
+  Pipeline(int size, int batch, int inputs, int outputs,
+  const Prepare& prepare, int threads = 2, int capacity = 4,
+  uint64_t seed = 0);
+
+  ~Pipeline();
+
+  // wait for next batch and swap it in, rethrow worker exceptions
+  void take(Batch& batch);
+
+  // number of batches taken
+  long taken() const { return _taken; }
+
+private:
+  Pipeline(const Pipeline&) = delete;
+  Pipeline& operator=(const Pipeline&) = delete;
+
+  // worker thread loop
+  void work();
+
+  // draw sample indices of next batch, caller holds lock
+  void sample(std::vector<int>& index);
+
+  const int _size;
+  const int _batch;
+  const int _inputs;
+  const int _outputs;
+  const int _capacity;
+  const uint64_t _seed;
+  Prepare _prepare;
+
+  // shuffled epoch
+  RNG _sampler;
+  std::vector<int> _epoch;
+  int _position;
+
+  // batches ready or in preparation
+  std::mutex _lock;
+  std::condition_variable _ready;
+  std::condition_variable _space;
+  std::map<long, Batch> _queue;
+  std::vector<Batch> _free;
+  std::exception_ptr _error;
+  long _claimed;
+  long _taken;
+  bool _stop;
+
+  std::vector<std::thread> _workers;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_PIPELINE_H_ */
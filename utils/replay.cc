@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <thread>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "replay.hh"
+
+namespace seegnify {
+
+ReplayBuffer::ReplayBuffer(int capacity, int features) :
+_capacity(capacity), _features(features)
+{
+  if (capacity <= 0 || features <= 0)
+    throw std::runtime_error("Invalid replay buffer configuration");
+
+  _observation.setZero(capacity, features);
+  _action.assign(capacity, 0);
+  _reward.assign(capacity, 0);
+  _done.assign(capacity, 0);
+
+  _sequence.reset(new std::atomic<long>[capacity]);
+  _priority.reset(new std::atomic<DTYPE>[capacity]);
+  for (int i=0; i<capacity; i++)
+  {
+    _sequence[i].store(0);
+    _priority[i].store(0);
+  }
+
+  _max_priority.store(1);
+  _head.store(0);
+}
+
+int ReplayBuffer::size() const
+{
+  return (int)std::min<long>(_head.load(), _capacity);
+}
+
+long ReplayBuffer::insert(const DTYPE* observation, int action,
+DTYPE reward, bool done)
+{
+  long ticket = _head.fetch_add(1);
+
+  claim(ticket);
+  write(ticket, observation, action, reward, done);
+  publish(ticket);
+
+  return ticket;
+}
+
+long ReplayBuffer::insert(const Tensor& observation,
+const std::vector<int>& action, const std::vector<DTYPE>& reward,
+const std::vector<bool>& done)
+{
+  int rows = observation.rows();
+  if (observation.cols() != _features || (int)action.size() != rows ||
+      (int)reward.size() != rows || (int)done.size() != rows)
+    throw std::runtime_error("Invalid replay transition shape");
+
+  long first = _head.fetch_add(rows);
+
+  for (int r=0; r<rows; r++)
+  {
+    claim(first + r);
+    write(first + r, observation.row(r).data(), action[r], reward[r], done[r]);
+    publish(first + r);
+  }
+
+  return first;
+}
+
+void ReplayBuffer::claim(long ticket)
+{
+  auto& sequence = _sequence[ticket % _capacity];
+
+  // previous ticket of the slot is complete, unless it is the first one
+  long previous = (ticket >= _capacity) ? 2 * (ticket - _capacity + 1) : 0;
+
+  long expected = previous;
+  while (!sequence.compare_exchange_weak(expected, 2 * ticket + 1,
+         std::memory_order_acquire, std::memory_order_relaxed))
+  {
+    expected = previous;
+    std::this_thread::yield();
+  }
+
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void ReplayBuffer::write(long ticket, const DTYPE* observation, int action,
+DTYPE reward, bool done)
+{
+  int slot = ticket % _capacity;
+
+  std::memcpy(_observation.row(slot).data(), observation,
+    _features * sizeof(DTYPE));
+  _action[slot] = action;
+  _reward[slot] = reward;
+  _done[slot] = done;
+
+  // new transitions are replayed at least once with high probability
+  _priority[slot].store(_max_priority.load(std::memory_order_relaxed),
+    std::memory_order_relaxed);
+}
+
+void ReplayBuffer::publish(long ticket)
+{
+  _sequence[ticket % _capacity].store(2 * ticket + 2,
+    std::memory_order_release);
+}
+
+bool ReplayBuffer::read(int slot, Experience& out, int row) const
+{
+  long sequence = _sequence[slot].load(std::memory_order_acquire);
+  if (sequence == 0 || (sequence & 1)) return false;
+
+  std::memcpy(out.observation.row(row).data(), _observation.row(slot).data(),
+    _features * sizeof(DTYPE));
+  out.action[row] = _action[slot];
+  out.reward[row] = _reward[slot];
+  out.done[row] = _done[slot];
+
+  // slot rewritten during the copy
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (_sequence[slot].load(std::memory_order_relaxed) != sequence)
+    return false;
+
+  out.ticket[row] = sequence / 2 - 1;
+  return true;
+}
+
+void ReplayBuffer::resize(int batch, Experience& out) const
+{
+  if (size() == 0) throw std::runtime_error("Empty replay buffer");
+
+  out.observation.resize(batch, _features);
+  out.action.resize(batch);
+  out.reward.resize(batch);
+  out.done.resize(batch);
+  out.priority.resize(batch);
+  out.ticket.resize(batch);
+}
+
+void ReplayBuffer::sample(int batch, Experience& out, RNG& rng) const
+{
+  resize(batch, out);
+
+  for (int r=0; r<batch; r++)
+  {
+    int slot;
+    do slot = rng.uniform_int(size() - 1);
+    while (!read(slot, out, r));
+
+    out.priority[r] = _priority[slot].load(std::memory_order_relaxed);
+  }
+}
+
+void ReplayBuffer::sample_prioritized(int batch, Experience& out,
+RNG& rng) const
+{
+  resize(batch, out);
+
+  for (int r=0; r<batch; r++)
+  {
+    int slot;
+    DTYPE priority;
+    do
+    {
+      slot = rng.uniform_int(size() - 1);
+      priority = _priority[slot].load(std::memory_order_relaxed);
+    }
+    while (rng.uniform_dec(_max_priority.load()) >= priority ||
+           !read(slot, out, r));
+
+    out.priority[r] = priority;
+  }
+}
+
+void ReplayBuffer::update(long ticket, DTYPE priority)
+{
+  if (priority <= 0) throw std::runtime_error("Invalid replay priority");
+
+  if (!valid(ticket)) return;
+  _priority[ticket % _capacity].store(priority, std::memory_order_relaxed);
+  raise(priority);
+}
+
+void ReplayBuffer::raise(DTYPE priority)
+{
+  DTYPE current = _max_priority.load();
+  while (current < priority &&
+         !_max_priority.compare_exchange_weak(current, priority));
+}
+
+bool ReplayBuffer::valid(long ticket) const
+{
+  if (ticket < 0) return false;
+  return _sequence[ticket % _capacity].load(std::memory_order_acquire) ==
+    2 * ticket + 2;
+}
+
+ConstTensorMap ReplayBuffer::observations(long first, int count) const
+{
+  int slot = first % _capacity;
+  if (count <= 0 || slot + count > _capacity)
+    throw std::runtime_error("Invalid replay view range");
+
+  for (int i=0; i<count; i++)
+  if (!valid(first + i))
+    throw std::runtime_error("Replay view of transition not held");
+
+  return ConstTensorMap(_observation.row(slot).data(), count, _features);
+}
+
+} /* namespace */
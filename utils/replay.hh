@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_REPLAY_H_
+#define _SEEGNIFY_REPLAY_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "main/types.hh"
+#include "main/random.hh"
+
+namespace seegnify {
+
+// Transitions sampled from the replay buffer
+struct Experience
+{
+  Tensor observation;          // [batch x features]
+  std::vector<int> action;     // action of each row
+  std::vector<DTYPE> reward;   // reward of each row
+  std::vector<bool> done;      // end of episode at each row
+  std::vector<DTYPE> priority; // priority of each row
+  std::vector<long> ticket;    // insertion number of each row
+};
+
+// Experience replay buffer shared by actor threads. Transitions are written
+// to a preallocated ring of fixed capacity, the n-th inserted transition
+// (its ticket) goes to slot n % capacity and replaces the oldest one. Each
+// slot has a sequence number, odd while the slot is written and twice the
+// ticket plus two when complete. Producers claim tickets with one atomic
+// increment and readers copy slots optimistically, retrying when the
+// sequence changed under the copy, so neither insertion nor sampling take
+// a lock. Prioritized sampling draws slots uniformly and accepts them with
+// probability of their priority over the largest priority seen.
+class ReplayBuffer
+{
+public:
+  ReplayBuffer(int capacity, int features);
+
+  // maximum number of transitions held
+  int capacity() const { return _capacity; }
+
+  // observation features
+  int features() const { return _features; }
+
+  // number of transitions inserted
+  long inserted() const { return _head.load(); }
+
+  // number of transitions held or being written
+  int size() const;
+
+  // insert one transition, return its ticket
+  long insert(const DTYPE* observation, int action, DTYPE reward, bool done);
+
+  // insert rows [rows x features] as consecutive tickets, return the first
+  long insert(const Tensor& observation, const std::vector<int>& action,
+    const std::vector<DTYPE>& reward, const std::vector<bool>& done);
+
+  // sample batch of transitions uniformly
+  void sample(int batch, Experience& out, RNG& rng) const;
+
+  // sample batch of transitions proportionally to priority
+  void sample_prioritized(int batch, Experience& out, RNG& rng) const;
+
+  // set priority of transition ticket if the buffer still holds it
+  void update(long ticket, DTYPE priority);
+
+  // transition ticket is complete and still held
+  bool valid(long ticket) const;
+
+  // view of observations of count consecutive tickets from first without
+  // copy, valid as long as valid() holds for each ticket of the view
+  ConstTensorMap observations(long first, int count) const;
+
+private:
+  ReplayBuffer(const ReplayBuffer&) = delete;
+  ReplayBuffer& operator=(const ReplayBuffer&) = delete;
+
+  // wait for previous writer of ticket slot and mark the slot as written
+  void claim(long ticket);
+
+  // copy transition row of ticket slot
+  void write(long ticket, const DTYPE* observation, int action,
+    DTYPE reward, bool done);
+
+  // mark ticket slot as complete
+  void publish(long ticket);
+
+  // copy complete transition of slot to row of out, false if it changed
+  bool read(int slot, Experience& out, int row) const;
+
+  // prepare rows of out for batch
+  void resize(int batch, Experience& out) const;
+
+  // raise the largest priority seen
+  void raise(DTYPE priority);
+
+  const int _capacity;
+  const int _features;
+
+  // transitions
+  Tensor _observation;
+  std::vector<int> _action;
+  std::vector<DTYPE> _reward;
+  std::vector<uint8_t> _done;
+
+  // slot sequence numbers and priorities
+  std::unique_ptr<std::atomic<long>[]> _sequence;
+  std::unique_ptr<std::atomic<DTYPE>[]> _priority;
+  std::atomic<DTYPE> _max_priority;
+
+  // next ticket
+  std::atomic<long> _head;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_REPLAY_H_ */
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include <dlfcn.h>
+
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/StreamSocket.h>
+
+#include "training.hh"
+#include "ring.hh"
+
+namespace seegnify {
+
+// steps between checkpoints saved by rank 0
+#define RING_SAVE 100
+
+// ring runtime data
+
+static std::atomic<bool> ring_done(false);
+
+typedef Training* (*create_callback)(int);
+typedef void (*destroy_callback)(Training*);
+
+///////////////////////////////////////////
+// Ring impl
+///////////////////////////////////////////
+
+Ring::Ring(int rank, const std::vector<std::string>& hosts) :
+_rank(rank), _size(hosts.size())
+{
+  if (rank < 0 || rank >= _size)
+    throw std::runtime_error("Invalid ring rank");
+
+  if (_size == 1) return;
+
+  // listen before connecting so that neighbours can connect in any order
+  Poco::Net::SocketAddress self(hosts[rank]);
+  Poco::Net::ServerSocket server(
+    Poco::Net::SocketAddress("0.0.0.0", self.port()));
+
+  Poco::Net::SocketAddress next(hosts[(rank + 1) % _size]);
+  for (int i=0; ; i++)
+  {
+    try
+    {
+      _next.connect(next);
+      break;
+    }
+    catch (std::exception& e)
+    {
+      if (i >= RING_CONNECT)
+        throw std::runtime_error("Failed to connect to " + next.toString());
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+
+  _prev = server.acceptConnection();
+  _next.setNoDelay(true);
+  _prev.setNoDelay(true);
+
+  _sender = std::thread(&Ring::send_loop, this);
+}
+
+Ring::~Ring()
+{
+  if (!_sender.joinable()) return;
+
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _stop = true;
+  }
+  _changed.notify_all();
+  _sender.join();
+}
+
+void Ring::post(const void* data, size_t size)
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  _data = data;
+  _bytes = size;
+  _posted = true;
+  _changed.notify_all();
+}
+
+void Ring::flush()
+{
+  std::unique_lock<std::mutex> lock(_lock);
+  _changed.wait(lock, [&]() { return !_posted; });
+  if (_error)
+  {
+    auto error = _error;
+    _error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void Ring::cancel()
+{
+  try
+  {
+    _next.shutdown();
+  }
+  catch (std::exception&) {}
+
+  std::unique_lock<std::mutex> lock(_lock);
+  _changed.wait(lock, [&]() { return !_posted; });
+}
+
+void Ring::send_loop()
+{
+  std::unique_lock<std::mutex> lock(_lock);
+  while (true)
+  {
+    _changed.wait(lock, [&]() { return _posted || _stop; });
+    if (_stop) return;
+
+    auto data = _data;
+    auto size = _bytes;
+    lock.unlock();
+    std::exception_ptr error;
+    try
+    {
+      send_bytes(data, size);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    lock.lock();
+
+    _error = error;
+    _posted = false;
+    _changed.notify_all();
+  }
+}
+
+void Ring::send_bytes(const void* data, size_t size)
+{
+  auto ptr = (const char*)data;
+  while (size)
+  {
+    int n = _next.sendBytes(ptr, (int)std::min<size_t>(size, 1 << 30));
+    if (n <= 0) throw std::runtime_error("Connection to next rank closed");
+    ptr += n;
+    size -= n;
+  }
+}
+
+void Ring::recv_bytes(void* data, size_t size)
+{
+  auto ptr = (char*)data;
+  while (size)
+  {
+    int n = _prev.receiveBytes(ptr, (int)std::min<size_t>(size, 1 << 30));
+    if (n <= 0) throw std::runtime_error("Connection to prev rank closed");
+    ptr += n;
+    size -= n;
+  }
+}
+
+// ring routines
+
+// Train one rank of a ring. Models of plugin libraries run their whole
+// batch including the optimizer step in batch_train(), so the ring keeps
+// the ranks in sync by averaging their weights after every batch rather
+// than by reducing gradients before the step.
+void ring_run(const std::string& impl, int rank,
+const std::vector<std::string>& hosts, const std::string& file)
+{
+  void* handle = dlopen(impl.c_str(), RTLD_LAZY);
+  if (handle == nullptr)
+  {
+    std::ostringstream log;
+    log << "Failed to load libary '" << impl << "'";
+    throw std::runtime_error(log.str());
+  }
+
+  auto create = (create_callback)dlsym(handle, "create");
+  if (create == nullptr)
+    throw std::runtime_error("Failed to locate symbol 'create'");
+  auto destroy = (destroy_callback)dlsym(handle, "destroy");
+  if (destroy == nullptr)
+    throw std::runtime_error("Failed to locate symbol 'destroy'");
+
+  std::cout << "connecting rank " << rank << " of " << hosts.size()
+            << "..." << std::endl;
+  Ring ring(rank, hosts);
+
+  auto& model = *create(rank);
+
+  // load stored weights at rank 0
+  if (rank == 0 && Checkpoint::is_checkpoint(file))
+  {
+    model.load_checkpoint(file, true);
+    std::cout << "weights loaded from " << file << std::endl;
+  }
+
+  // all ranks train the same model
+  int64_t size = model.flat_size();
+  int64_t total = size;
+  ring.all_reduce(&total, 1);
+  if (total != size * ring.size())
+    throw std::runtime_error("Incompatible number of weights");
+
+  // broadcast weights of rank 0 as sum with zeros of other ranks,
+  // last value carries number of ranks stopping
+  std::vector<DTYPE> flat(size + 1, 0);
+  if (rank == 0) model.get_flat(flat.data());
+  ring.all_reduce(flat.data(), flat.size());
+  model.set_flat(flat.data());
+
+  for (int step=1; ; step++)
+  {
+    // train on local batch
+    model.batch_train();
+
+    // periodic model averaging: batch_train() of the model applies its own
+    // optimizer step, so ranks average the weight increments of their
+    // steps, not gradients, and keep own optimizer state
+    model.get_flat(flat.data(), true);
+    flat[size] = ring_done;
+    ring.all_reduce(flat.data(), flat.size());
+    RowVectorMap(flat.data(), size) /= ring.size();
+    model.set_flat(flat.data(), true);
+
+    bool last = (flat[size] > 0);
+    if (rank == 0 && (step % RING_SAVE == 0 || last))
+      model.save_checkpoint(file);
+    if (last) break;
+  }
+
+  if (rank == 0) std::cout << "last state saved in " << file << std::endl;
+
+  destroy(&model);
+  dlclose(handle);
+}
+
+void ring_term()
+{
+  ring_done = true;
+}
+
+} /* namespace */
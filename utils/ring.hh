@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_RING_H_
+#define _SEEGNIFY_RING_H_
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+#include <Poco/Net/StreamSocket.h>
+
+namespace seegnify {
+
+// values reduced per ring pass, larger buffers are reduced in buckets
+#define RING_BUCKET (1 << 20)
+
+// values received at a time and added while the next ones arrive
+#define RING_PIECE (1 << 14)
+
+// seconds to wait for the next rank to listen
+#define RING_CONNECT 60
+
+// Synchronous all-reduce over a ring of processes. Each rank sends to the
+// next rank and receives from the previous one. Buffers are split into one
+// chunk per rank, reduced in a scatter pass and gathered in a second pass,
+// so each rank transfers 2 * (N - 1) / N of the buffer regardless of N.
+// Chunks are sent by one sender thread of the ring while the calling thread
+// receives the chunk of the previous rank.
+class Ring
+{
+public:
+  // connect rank to its neighbours of hosts given as HOST:PORT
+  Ring(int rank, const std::vector<std::string>& hosts);
+
+  ~Ring();
+
+  // rank of the process
+  int rank() const { return _rank; }
+
+  // number of ranks
+  int size() const { return _size; }
+
+  // replace data at every rank with its sum over all ranks, ranks end with
+  // identical values
+  template <typename T>
+  void all_reduce(T* data, size_t size)
+  {
+    if (_size == 1) return;
+
+    try
+    {
+      std::vector<T> piece(RING_PIECE);
+      for (size_t offset=0; offset<size; offset+=RING_BUCKET)
+      {
+        size_t bucket = std::min<size_t>(RING_BUCKET, size - offset);
+        T* base = data + offset;
+        auto chunk_begin = [&](int c) { return bucket * c / _size; };
+        auto chunk_size = [&](int c) {
+          return chunk_begin(c + 1) - chunk_begin(c);
+        };
+
+        // reduce-scatter, rank ends with sum of chunk (rank + 1)
+        for (int s=0; s<_size-1; s++)
+        {
+          int send = (_rank - s + _size) % _size;
+          int recv = (_rank - s - 1 + _size) % _size;
+          post(base + chunk_begin(send), chunk_size(send) * sizeof(T));
+
+          T* out = base + chunk_begin(recv);
+          size_t left = chunk_size(recv);
+          while (left)
+          {
+            size_t n = std::min<size_t>(left, RING_PIECE);
+            recv_bytes(piece.data(), n * sizeof(T));
+            for (size_t i=0; i<n; i++) out[i] += piece[i];
+            out += n;
+            left -= n;
+          }
+          flush();
+        }
+
+        // all-gather of reduced chunks
+        for (int s=0; s<_size-1; s++)
+        {
+          int send = (_rank + 1 - s + _size) % _size;
+          int recv = (_rank - s + _size) % _size;
+          post(base + chunk_begin(send), chunk_size(send) * sizeof(T));
+          recv_bytes(base + chunk_begin(recv), chunk_size(recv) * sizeof(T));
+          flush();
+        }
+      }
+    }
+    catch (...)
+    {
+      // data must outlive the send in progress
+      cancel();
+      throw;
+    }
+  }
+
+private:
+  // hand bytes to the sender thread
+  void post(const void* data, size_t size);
+
+  // wait until posted bytes are sent, raise send error
+  void flush();
+
+  // close connection to next rank and wait for the sender to stop
+  void cancel();
+
+  // sender thread loop
+  void send_loop();
+
+  void send_bytes(const void* data, size_t size);
+  void recv_bytes(void* data, size_t size);
+
+  int _rank;
+  int _size;
+  Poco::Net::StreamSocket _next;
+  Poco::Net::StreamSocket _prev;
+
+  // bytes posted to the sender thread
+  std::thread _sender;
+  std::mutex _lock;
+  std::condition_variable _changed;
+  const void* _data = nullptr;
+  size_t _bytes = 0;
+  bool _posted = false;
+  bool _stop = false;
+  std::exception_ptr _error;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_RING_H_ */
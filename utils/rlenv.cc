@@ -142,17 +142,36 @@ Image RLEnv::get_full_rgb()
 
 Image RLEnv::get_view_rgb()
 {
-  // crop data to agent view
-  Image full = get_full_rgb();
-  auto view = full.crop(FULL_Y(0), FULL_X(0), FULL_L(view_rows), FULL_L(view_cols));
+  Image view(view_rows, view_cols, CHANNELS);
+  get_view_rgb(view);
+  return view;
+}
 
-  // zoom to fit agent view
-  view = view.scale(view_rows, view_cols);
+void RLEnv::get_view_rgb(Image& view)
+{
+  // view buffer allocated once
+  if (view.rows() != view_rows || view.cols() != view_cols)
+    view = Image(view_rows, view_cols, CHANNELS);
+
+  // crop data to agent view and zoom to fit, in place unless the view frame
+  // is drawn on the full image
+  if (show_view_frame)
+  {
+    Image full = get_full_rgb();
+    full.scale(FULL_Y(0), FULL_X(0), FULL_L(view_rows), FULL_L(view_cols),
+      view);
+  }
+  else
+  {
+    auto slice = ROUND(this->slice);
+    int slice_offset = CHANNELS * slice * full_rows * full_cols;
+    Image full(data + slice_offset, full_rows, full_cols, CHANNELS);
+    full.scale(FULL_Y(0), FULL_X(0), FULL_L(view_rows), FULL_L(view_cols),
+      view);
+  }
 
   // draw full frame
   draw_full_frame(view);
-
-  return view;
 }
 
 std::string RLEnv::get_info()
@@ -39,6 +39,7 @@ public:
 
     Image get_full_rgb();
     Image get_view_rgb();
+    void get_view_rgb(Image& view);
 
     void enable_full_frame(bool show) { show_full_frame = show; }
     void enable_view_frame(bool show) { show_view_frame = show; }
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <csignal>
+#include <vector>
+#include <future>
+
+#include <dlfcn.h>
+
+#include "transport.hh"
+#include "training.hh"
+#include "batcher.hh"
+#include "topology.hh"
+#include "storage.hh"
+#include "graph.pb.h"
+
+namespace seegnify {
+
+// training library callbacks
+typedef Training* (*create_callback)(int);
+typedef void (*destroy_callback)(Training*);
+
+// server type
+typedef ProtobufServer<graph::Request, graph::Response> GraphServer;
+
+// server pointer for singal handling
+std::shared_ptr<GraphServer> graph_server;
+
+// requests batched across replicas
+std::shared_ptr<Batcher> batcher;
+
+// server start time
+std::chrono::steady_clock::time_point serve_start;
+
+// predict request
+void on_predict(ServerContext& ctx, const graph::Predict& req,
+graph::Response& res)
+{
+  if (!ctx.has_payload()) throw std::runtime_error("Missing prediction input");
+
+  Tensor input = read_tensor(ctx.payload());
+  if (!ctx.payload()) throw std::runtime_error("Invalid prediction input");
+
+  Tensor output;
+  batcher->predict(input, output);
+
+  std::ostringstream out;
+  write_tensor(output, out);
+  res.mutable_predict();
+  ctx.reply({std::make_shared<std::string>(out.str())});
+}
+
+// stats request
+void on_get_stats(const graph::GetStats& req, graph::Response& res)
+{
+  std::chrono::duration<double> uptime =
+    std::chrono::steady_clock::now() - serve_start;
+
+  auto batches = batcher->batches();
+  auto response = res.mutable_get_stats();
+  response->set_uptime_seconds(uptime.count());
+  response->set_predictions(batcher->requests());
+  response->set_batches(batches);
+  response->set_batch_rows(batches ? (double)batcher->rows() / batches : 0);
+  response->set_latency_p50_seconds(batcher->latency(0.50));
+  response->set_latency_p99_seconds(batcher->latency(0.99));
+}
+
+void serve_run(ServerContext& ctx, graph::Request& req, graph::Response& res)
+{
+  if (req.has_predict())
+  {
+    on_predict(ctx, req.predict(), res);
+  }
+  else
+  if (req.has_get_stats())
+  {
+    on_get_stats(req.get_stats(), res);
+  }
+  else
+  {
+    throw std::runtime_error("Command Not Supported");
+  }
+}
+
+void serve_err(const std::exception& err, graph::Response& res)
+{
+  auto* errptr = res.mutable_error();
+  errptr->set_status(400);
+  errptr->set_message(err.what());
+}
+
+// signal handler
+static void on_signal(int signum) {
+  if (graph_server != nullptr) graph_server->stop();
+}
+
+// syntax message
+void syntax(char* argv[]) {
+  std::cerr << "Usage: " << argv[0] << " "
+            << "<IMPL> <CHECKPOINT> <PORT> [REPLICAS] [MAX_BATCH] "
+            << "[MAX_DELAY_US]"
+            << std::endl;
+}
+
+} /* namespace */
+
+using namespace seegnify;
+
+/**
+ * server entry point
+ */
+int main(int argc, char* argv[]) {
+
+  try {
+    if (argc < 4 || argc > 7) {
+      syntax(argv);
+      return 1;
+    }
+
+    std::string impl = argv[1];
+    std::string file = argv[2];
+    int port = std::stoi(argv[3]);
+    auto topology = Topology::environment();
+    int replicas = (argc > 4) ? std::stoi(argv[4]) : topology.replicas();
+    int max_batch = (argc > 5) ? std::stoi(argv[5]) : 32;
+    int max_delay = (argc > 6) ? std::stoi(argv[6]) : 1000;
+    replicas = std::max(1, replicas);
+
+    void* handle = dlopen(impl.c_str(), RTLD_LAZY);
+    if (handle == nullptr)
+    {
+      std::ostringstream log;
+      log << "Failed to load libary '" << impl << "'";
+      throw std::runtime_error(log.str());
+    }
+
+    // inference instances without training data and optimizer state,
+    // training instances of libraries that do not export them
+    auto create = (create_callback)dlsym(handle, "create_inference");
+    if (create == nullptr) create = (create_callback)dlsym(handle, "create");
+    if (create == nullptr)
+      throw std::runtime_error("Failed to locate symbol 'create'");
+    auto destroy = (destroy_callback)dlsym(handle, "destroy");
+    if (destroy == nullptr)
+      throw std::runtime_error("Failed to locate symbol 'destroy'");
+
+    // graph replicas with checkpoint weights, verified once, allocated
+    // by placed replica threads that serve batches of queued requests
+    batcher = std::make_shared<Batcher>(max_batch, max_delay);
+    std::vector<Training*> models(replicas, nullptr);
+    std::vector<std::future<void>> ready;
+    std::vector<std::thread> threads;
+    for (int i=0; i<replicas; i++)
+    {
+      auto loaded = std::make_shared<std::promise<void>>();
+      ready.push_back(loaded->get_future());
+      threads.emplace_back([&, i, loaded]()
+      {
+        try
+        {
+          topology.bind(i);
+          models[i] = create(i);
+          models[i]->load_checkpoint(file, i == 0);
+          loaded->set_value();
+        }
+        catch (...)
+        {
+          loaded->set_exception(std::current_exception());
+          return;
+        }
+
+        auto model = models[i];
+        batcher->run([model](const Tensor& input, Tensor& output)
+        {
+          model->batch_predict(input, output);
+        });
+      });
+    }
+
+    // stop replicas when any fails to load
+    try
+    {
+      for (auto& e: ready) e.get();
+    }
+    catch (...)
+    {
+      batcher->stop();
+      for (auto& t: threads) t.join();
+      for (auto model: models) if (model) destroy(model);
+      throw;
+    }
+
+    std::cout << "Starting server on port " << port
+              << " with " << replicas << " replicas" << std::endl;
+
+    // request threads wait in batches, enough of them to fill all replicas
+    signal(SIGINT, on_signal);
+    serve_start = std::chrono::steady_clock::now();
+    graph_server = std::make_shared<GraphServer>(serve_run, serve_err);
+    graph_server->run(port, std::max<int>(topology.cpus(),
+      replicas * max_batch));
+
+    batcher->stop();
+    for (auto& t: threads) t.join();
+    for (auto model: models) destroy(model);
+    dlclose(handle);
+
+    std::cout << "Stopping server on port " << port << std::endl;
+  }
+  catch (std::exception& e) {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 4;
+  }
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include <stdexcept>
+
+#include <unsupported/Eigen/FFT>
+
+#include "spectrogram.hh"
+
+namespace seegnify {
+
+// smallest power in log scale
+#define LOG_FLOOR 1e-10
+
+// mel scale of frequency [Hz]
+static inline DTYPE hz_to_mel(DTYPE hz)
+{
+  return 2595 * std::log10(1 + hz / 700);
+}
+
+// frequency [Hz] of mel scale
+static inline DTYPE mel_to_hz(DTYPE mel)
+{
+  return 700 * (std::pow(10, mel / 2595) - 1);
+}
+
+Spectrogram::Spectrogram(int sample_rate, int window, int hop, int mels,
+DTYPE fmin, DTYPE fmax, bool log) :
+_sample_rate(sample_rate), _window(window), _hop(hop), _mels(mels), _log(log)
+{
+  if (sample_rate <= 0 || window < 2 || hop <= 0 || mels < 0)
+    throw std::runtime_error("Invalid spectrogram configuration");
+
+  if (fmax <= 0) fmax = sample_rate / 2.0;
+  if (fmin < 0 || fmin >= fmax)
+    throw std::runtime_error("Invalid spectrogram frequency range");
+
+  // periodic Hann window
+  _hann.resize(window);
+  for (int n=0; n<window; n++)
+    _hann(n) = 0.5 - 0.5 * std::cos(2 * M_PI * n / window);
+
+  if (mels == 0) return;
+
+  // filter edges equally spaced in mel scale
+  std::vector<DTYPE> edge(mels + 2);
+  DTYPE low = hz_to_mel(fmin), high = hz_to_mel(fmax);
+  for (int m=0; m<mels+2; m++)
+    edge[m] = mel_to_hz(low + (high - low) * m / (mels + 1));
+
+  // triangular filters over bin frequencies
+  _filterbank.setZero(bins(), mels);
+  for (int k=0; k<bins(); k++)
+  {
+    DTYPE hz = (DTYPE)k * sample_rate / window;
+    for (int m=0; m<mels; m++)
+    {
+      DTYPE rise = (hz - edge[m]) / (edge[m+1] - edge[m]);
+      DTYPE fall = (edge[m+2] - hz) / (edge[m+2] - edge[m+1]);
+      _filterbank(k, m) = std::max<DTYPE>(0, std::min(rise, fall));
+    }
+  }
+}
+
+long Spectrogram::frames(long samples) const
+{
+  return (samples < _window) ? 0 : 1 + (samples - _window) / _hop;
+}
+
+void Spectrogram::compute(const DTYPE* samples, long size, long frame,
+int count, DTYPE* out) const
+{
+  if (count <= 0) return;
+
+  long start = frame * _hop;
+  long span = (long)(count - 1) * _hop + _window;
+
+  if (start >= 0 && start + span <= size)
+  {
+    transform(samples + start, count, out);
+    return;
+  }
+
+  // zero padded copy of samples at the end
+  thread_local std::vector<DTYPE> padded;
+  padded.assign(span, 0);
+  if (start < size)
+    std::copy(samples + start, samples + std::min(size, start + span),
+      padded.begin());
+
+  transform(padded.data(), count, out);
+}
+
+void Spectrogram::compute(const AudioStream& audio, long frame, int count,
+DTYPE* out, int channel) const
+{
+  if (count <= 0) return;
+
+  long span = (long)(count - 1) * _hop + _window;
+
+  // decode samples of the frames only
+  thread_local std::vector<DTYPE> samples;
+  samples.resize(span);
+  long size = audio.read(frame * _hop, span, samples.data(), channel);
+  std::fill(samples.begin() + size, samples.end(), 0);
+
+  transform(samples.data(), count, out);
+}
+
+void Spectrogram::compute(const AudioStream& audio, long frame, int count,
+Tensor& out, int channel) const
+{
+  out.resize(count, features());
+  compute(audio, frame, count, out.data(), channel);
+}
+
+void Spectrogram::transform(const DTYPE* span, int count, DTYPE* out) const
+{
+  typedef Eigen::Array<std::complex<DTYPE>, 1, Eigen::Dynamic> ComplexArray;
+
+  thread_local Eigen::FFT<DTYPE> fft;
+  thread_local RowVector frame;
+  thread_local ComplexArray freq;
+  thread_local Tensor power;
+
+  fft.SetFlag(Eigen::FFT<DTYPE>::HalfSpectrum);
+  frame.resize(_window);
+  freq.resize(_window);
+  power.resize(count, bins());
+
+  // power spectrum of windowed frames
+  for (int t=0; t<count; t++)
+  {
+    ConstRowVectorMap samples(span + (size_t)t * _hop, _window);
+    frame.array() = samples.array() * _hann.array();
+    fft.fwd(freq.data(), frame.data(), _window);
+    power.row(t).array() = freq.head(bins()).abs2();
+  }
+
+  TensorMap features(out, count, this->features());
+  if (_mels > 0)
+    features.noalias() = power * _filterbank;
+  else
+    features = power;
+
+  if (_log) features = (features.array() + LOG_FLOOR).log();
+}
+
+} /* namespace */
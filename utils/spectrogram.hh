@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_SPECTROGRAM_H_
+#define _SEEGNIFY_SPECTROGRAM_H_
+
+#include "main/types.hh"
+#include "audiostream.hh"
+
+namespace seegnify {
+
+// Short-time Fourier transform of audio. Frame t of the transform covers
+// samples [t * hop, t * hop + window) under a Hann window, and its features
+// are the power of frequency bins [0, window / 2], or the power summed by a
+// triangular mel filterbank when mels are set, optionally in log scale.
+// Frames of a batch are transformed with Eigen FFT into rows of a power
+// matrix, which is then projected onto the filterbank in one product.
+// Scratch buffers are thread local, so one instance can be shared by the
+// workers of a data pipeline.
+class Spectrogram
+{
+public:
+  Spectrogram(int sample_rate, int window, int hop, int mels = 0,
+    DTYPE fmin = 0, DTYPE fmax = 0, bool log = true);
+
+  // samples per frame
+  int window() const { return _window; }
+
+  // samples between frames
+  int hop() const { return _hop; }
+
+  // frequency bins per frame
+  int bins() const { return _window / 2 + 1; }
+
+  // features per frame
+  int features() const { return _mels > 0 ? _mels : bins(); }
+
+  // number of frames of samples
+  long frames(long samples) const;
+
+  // mel filterbank [bins x mels]
+  const Tensor& filterbank() const { return _filterbank; }
+
+  // features [count x features] of count frames from frame of samples,
+  // samples past the end read as zero
+  void compute(const DTYPE* samples, long size, long frame, int count,
+    DTYPE* out) const;
+
+  // features of frames of audio channel, or mean of channels if negative
+  void compute(const AudioStream& audio, long frame, int count,
+    DTYPE* out, int channel = -1) const;
+
+  // features of frames of audio to resized tensor
+  void compute(const AudioStream& audio, long frame, int count,
+    Tensor& out, int channel = -1) const;
+
+private:
+  // features of count frames of contiguous span of samples
+  void transform(const DTYPE* span, int count, DTYPE* out) const;
+
+  const int _sample_rate;
+  const int _window;
+  const int _hop;
+  const int _mels;
+  const bool _log;
+
+  RowVector _hann;
+  Tensor _filterbank;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_SPECTROGRAM_H_ */
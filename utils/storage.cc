@@ -20,6 +20,7 @@
 
 #include "storage.hh"
 #include "audio.hh"
+#include "audiostream.hh"
 
 namespace seegnify {
 
@@ -199,6 +200,225 @@ bool read_pb(::google::protobuf::Message& pb, std::istream& input) {
   return true;
 }
 
+///////////////////////////////////////////
+// payload frames
+///////////////////////////////////////////
+
+FrameOutputBuffer::FrameOutputBuffer(std::ostream& out, bool deflate) :
+_out(out), _deflate(deflate), _closed(false), _bytes(0)
+{
+  _buffer.resize(FRAME_BUFFER);
+  setp(_buffer.data(), _buffer.data() + _buffer.size());
+
+  if (_deflate)
+  {
+    _zbuffer.resize(FRAME_BUFFER);
+    _z = z_stream();
+    if (deflateInit(&_z, Z_BEST_SPEED) != Z_OK)
+      throw std::runtime_error("Failed to init payload compression");
+  }
+}
+
+FrameOutputBuffer::~FrameOutputBuffer()
+{
+  if (_deflate) deflateEnd(&_z);
+}
+
+void FrameOutputBuffer::close()
+{
+  if (_closed) return;
+  flush_buffer();
+  if (_deflate) deflate_frames(nullptr, 0, Z_FINISH);
+  write_uint32(0, _out);
+  _closed = true;
+}
+
+FrameOutputBuffer::int_type FrameOutputBuffer::overflow(int_type c)
+{
+  flush_buffer();
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize FrameOutputBuffer::xsputn(const char* s, std::streamsize n)
+{
+  if (n < FRAME_BUFFER) return std::streambuf::xsputn(s, n);
+
+  // keep order of buffered bytes, then frame caller memory
+  flush_buffer();
+  _bytes += n;
+  if (_deflate) deflate_frames(s, n, Z_NO_FLUSH); else write_frames(s, n);
+  return n;
+}
+
+int FrameOutputBuffer::sync()
+{
+  flush_buffer();
+  _out.flush();
+  return _out ? 0 : -1;
+}
+
+void FrameOutputBuffer::flush_buffer()
+{
+  size_t size = pptr() - pbase();
+  if (size == 0) return;
+
+  _bytes += size;
+  if (_deflate) deflate_frames(pbase(), size, Z_NO_FLUSH);
+  else write_frames(pbase(), size);
+  setp(_buffer.data(), _buffer.data() + _buffer.size());
+}
+
+void FrameOutputBuffer::write_frames(const char* data, size_t size)
+{
+  while (size)
+  {
+    size_t n = std::min<size_t>(size, FRAME_SIZE);
+    write_uint32(n, _out);
+    _out.write(data, n);
+    data += n;
+    size -= n;
+  }
+}
+
+void FrameOutputBuffer::deflate_frames(const char* data, size_t size,
+int flush)
+{
+  _z.next_in = (Bytef*)data;
+  _z.avail_in = size;
+
+  while (true)
+  {
+    _z.next_out = (Bytef*)_zbuffer.data();
+    _z.avail_out = _zbuffer.size();
+    int rc = ::deflate(&_z, flush);
+    if (rc == Z_STREAM_ERROR)
+      throw std::runtime_error("Failed to compress payload");
+
+    write_frames(_zbuffer.data(), _zbuffer.size() - _z.avail_out);
+
+    // all input consumed and output drained
+    if (_z.avail_out > 0 && _z.avail_in == 0)
+    {
+      if (flush != Z_FINISH || rc == Z_STREAM_END) break;
+    }
+  }
+}
+
+FrameInputBuffer::FrameInputBuffer(std::istream& in, bool deflate) :
+_in(in), _deflate(deflate), _end(false), _left(0), _bytes(0)
+{
+  _buffer.resize(FRAME_BUFFER);
+  setg(_buffer.data(), _buffer.data(), _buffer.data());
+
+  if (_deflate)
+  {
+    _zbuffer.resize(FRAME_BUFFER);
+    _z = z_stream();
+    if (inflateInit(&_z) != Z_OK)
+      throw std::runtime_error("Failed to init payload decompression");
+  }
+}
+
+FrameInputBuffer::~FrameInputBuffer()
+{
+  if (_deflate) inflateEnd(&_z);
+}
+
+void FrameInputBuffer::drain()
+{
+  while (!traits_type::eq_int_type(underflow(), traits_type::eof()))
+  {
+    setg(eback(), egptr(), egptr());
+  }
+}
+
+FrameInputBuffer::int_type FrameInputBuffer::underflow()
+{
+  if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+
+  _bytes += gptr() - eback();
+  size_t n = read_frames(_buffer.data(), _buffer.size());
+  setg(_buffer.data(), _buffer.data(), _buffer.data() + n);
+  if (n == 0) return traits_type::eof();
+
+  return traits_type::to_int_type(*gptr());
+}
+
+std::streamsize FrameInputBuffer::xsgetn(char* s, std::streamsize n)
+{
+  // take buffered bytes first
+  std::streamsize count = std::min<std::streamsize>(n, egptr() - gptr());
+  std::copy(gptr(), gptr() + count, s);
+  gbump(count);
+
+  // read remaining bytes without buffering
+  while (count < n)
+  {
+    size_t size = read_frames(s + count, n - count);
+    if (size == 0) break;
+    _bytes += size;
+    count += size;
+  }
+
+  return count;
+}
+
+bool FrameInputBuffer::next_frame()
+{
+  while (_left == 0 && !_end)
+  {
+    uint32_t size;
+    if (!read_uint32(size, _in))
+      throw std::runtime_error("Truncated payload");
+    if (size == 0) _end = true; else _left = size;
+  }
+  return _left > 0;
+}
+
+size_t FrameInputBuffer::read_frames(char* data, size_t size)
+{
+  if (!_deflate)
+  {
+    if (!next_frame()) return 0;
+
+    size_t n = std::min(size, _left);
+    _in.read(data, n);
+    if (!_in) throw std::runtime_error("Truncated payload");
+    _left -= n;
+    return n;
+  }
+
+  _z.next_out = (Bytef*)data;
+  _z.avail_out = size;
+
+  // inflate until output is produced or payload ends
+  while (_z.avail_out == size)
+  {
+    if (_z.avail_in == 0)
+    {
+      if (!next_frame()) break;
+
+      size_t n = std::min(_zbuffer.size(), _left);
+      _in.read(_zbuffer.data(), n);
+      if (!_in) throw std::runtime_error("Truncated payload");
+      _left -= n;
+      _z.next_in = (Bytef*)_zbuffer.data();
+      _z.avail_in = n;
+    }
+
+    int rc = inflate(&_z, Z_NO_FLUSH);
+    if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR)
+      throw std::runtime_error("Failed to decompress payload");
+  }
+
+  return size - _z.avail_out;
+}
+
 // read int from stream
 int read_int(std::istream& in)
 {
@@ -245,6 +465,71 @@ void write_tensor(const Tensor& t, std::ostream& out)
   out.write((const char*)t.data(), t.size() * sizeof(Tensor::Scalar));
 }
 
+// read Tensor stored with precision from stream
+Tensor read_tensor(std::istream& in, Precision precision)
+{
+  int rows = read_int(in);
+  return read_tensor(in, precision, rows);
+}
+
+// read Tensor stored with precision from stream, rows already read
+Tensor read_tensor(std::istream& in, Precision precision, int rows)
+{
+  int cols = read_int(in);
+
+  if (precision == FP32)
+  {
+    Tensor t(rows, cols);
+    in.read((char*)t.data(), t.size() * sizeof(Tensor::Scalar));
+    return t;
+  }
+
+  if (precision == FP16)
+  {
+    // FP16 values are scaled to the range of the tensor
+    DTYPE scale = read_dtype(in);
+    TensorFP16 t(rows, cols);
+    in.read((char*)t.data(), t.size() * sizeof(TensorFP16::Scalar));
+    return t.cast<DTYPE>() * scale;
+  }
+  else if (precision == BF16)
+  {
+    TensorBF16 t(rows, cols);
+    in.read((char*)t.data(), t.size() * sizeof(TensorBF16::Scalar));
+    return t.cast<DTYPE>();
+  }
+
+  throw std::runtime_error("Unsupported tensor precision");
+}
+
+// write Tensor stored with precision to stream
+void write_tensor(const Tensor& t, std::ostream& out, Precision precision)
+{
+  if (precision == FP32) return write_tensor(t, out);
+
+  write_int(t.rows(), out);
+  write_int(t.cols(), out);
+
+  if (precision == FP16)
+  {
+    // scale values to avoid FP16 overflow and underflow of small updates
+    DTYPE max = t.size() ? t.cwiseAbs().maxCoeff() : 0;
+    DTYPE scale = (max > 0) ? max / 32768 : 1;
+    write_dtype(scale, out);
+    TensorFP16 h = (t / scale).cast<Eigen::half>();
+    out.write((const char*)h.data(), h.size() * sizeof(TensorFP16::Scalar));
+  }
+  else if (precision == BF16)
+  {
+    TensorBF16 h = t.cast<Eigen::bfloat16>();
+    out.write((const char*)h.data(), h.size() * sizeof(TensorBF16::Scalar));
+  }
+  else
+  {
+    throw std::runtime_error("Unsupported tensor precision");
+  }
+}
+
 // suseconds_t (microseconds) to string of format 2009-06-15 20:20:00.1234567
 std::string usec_to_string(const suseconds_t& time) {
   time_t secs = time / 1000000;
@@ -367,20 +652,17 @@ const std::vector<const uint8_t*>& rgb, int width, int height, int delay) {
 void load_audio(const std::string& filename, std::vector<DTYPE>& samples,
 int& num_channels, int& sample_rate)
 {
-  AudioFile<DTYPE> file;
-  if (!file.load(filename))
-    return;
+  AudioStream file(filename);
 
-  uint32_t num_samples = file.getNumSamplesPerChannel();
-  uint32_t sample_bits = file.getBitDepth();
+  auto num_samples = file.frames();
 
-  num_channels = file.getNumChannels();
-  sample_rate = file.getSampleRate();
+  num_channels = file.channels();
+  sample_rate = file.sample_rate();
 
+  // decode channels straight from the mapped file
   samples.resize(num_channels * num_samples);
   for (auto c=0; c<num_channels; c++)
-  for (auto s=0; s<num_samples; s++)
-    samples[c * num_samples + s] = file.samples[c][s];
+    file.read(0, num_samples, samples.data() + c * num_samples, c);
 }
 
 // write audio file
@@ -9,6 +9,9 @@
 
 #include <time.h>
 #include <iostream>
+#include <vector>
+
+#include <zlib.h>
 
 #include <google/protobuf/message.h>
 
@@ -48,6 +51,79 @@ void write_pb(const ::google::protobuf::Message& pb, std::ostream& stream);
 // read delimited protobuf from stream
 bool read_pb(::google::protobuf::Message& pb, std::istream& stream);
 
+// bytes buffered before a frame is written
+#define FRAME_BUFFER (1 << 16)
+
+// largest frame written from caller memory
+#define FRAME_SIZE (1 << 20)
+
+// Stream buffer writing payload of unknown size as frames, each preceded
+// by its size and ended by an empty frame. Small writes are buffered, large
+// ones are framed straight from caller memory. Deflated payloads are
+// compressed on the way.
+class FrameOutputBuffer : public std::streambuf
+{
+public:
+  FrameOutputBuffer(std::ostream& out, bool deflate = false);
+  ~FrameOutputBuffer();
+
+  // write buffered bytes and end frame
+  void close();
+
+  // payload bytes before compression
+  uint64_t bytes() const { return _bytes; }
+
+protected:
+  int_type overflow(int_type c);
+  std::streamsize xsputn(const char* s, std::streamsize n);
+  int sync();
+
+private:
+  void flush_buffer();
+  void write_frames(const char* data, size_t size);
+  void deflate_frames(const char* data, size_t size, int flush);
+
+  std::ostream& _out;
+  bool _deflate;
+  bool _closed;
+  uint64_t _bytes;
+  std::vector<char> _buffer;
+  std::vector<char> _zbuffer;
+  z_stream _z;
+};
+
+// Stream buffer reading frames written by FrameOutputBuffer, large reads
+// go from the source straight to caller memory. Ends at empty frame.
+class FrameInputBuffer : public std::streambuf
+{
+public:
+  FrameInputBuffer(std::istream& in, bool deflate = false);
+  ~FrameInputBuffer();
+
+  // skip payload up to its end
+  void drain();
+
+  // payload bytes after decompression
+  uint64_t bytes() const { return _bytes + (gptr() - eback()); }
+
+protected:
+  int_type underflow();
+  std::streamsize xsgetn(char* s, std::streamsize n);
+
+private:
+  bool next_frame();
+  size_t read_frames(char* data, size_t size);
+
+  std::istream& _in;
+  bool _deflate;
+  bool _end;
+  size_t _left;
+  uint64_t _bytes;
+  std::vector<char> _buffer;
+  std::vector<char> _zbuffer;
+  z_stream _z;
+};
+
 // read DTYPE from stream
 DTYPE read_dtype(std::istream& in);
 
@@ -66,6 +142,15 @@ Tensor read_tensor(std::istream& in);
 // write Tensor to stream
 void write_tensor(const Tensor& t, std::ostream& out);
 
+// read Tensor stored with precision from stream
+Tensor read_tensor(std::istream& in, Precision precision);
+
+// read Tensor stored with precision from stream, rows already read
+Tensor read_tensor(std::istream& in, Precision precision, int rows);
+
+// write Tensor stored with precision to stream
+void write_tensor(const Tensor& t, std::ostream& out, Precision precision);
+
 // suseconds_t (microseconds) to string of format 2009-06-15 20:20:00.123456
 std::string usec_to_string(const suseconds_t& time);
 
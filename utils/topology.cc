@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <cerrno>
+#include <thread>
+
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "topology.hh"
+
+namespace seegnify {
+
+// node mask size of memory policies
+#define TOPOLOGY_MAX_NODES 1024
+#define TOPOLOGY_MASK_WORDS (TOPOLOGY_MAX_NODES / (8 * sizeof(unsigned long)))
+
+// sysfs directory of NUMA nodes
+#define TOPOLOGY_NODE_DIR "/sys/devices/system/node/"
+
+///////////////////////////////////////////
+// Topology routines
+///////////////////////////////////////////
+
+// parse kernel list format, e.g. 0-3,8,10-11
+static std::vector<int> parse_list(const std::string& list)
+{
+  std::vector<int> values;
+  std::istringstream in(list);
+  std::string range;
+
+  while (std::getline(in, range, ','))
+  {
+    if (range.empty() || range == "\n") continue;
+    auto dash = range.find('-');
+    int first = std::atoi(range.c_str());
+    int last = (dash == std::string::npos) ? first :
+      std::atoi(range.c_str() + dash + 1);
+    for (int i=first; i<=last; i++) values.push_back(i);
+  }
+
+  return values;
+}
+
+// read first line of file, empty when missing
+static std::string read_line(const std::string& path)
+{
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+// set memory policy of calling thread to nodes
+static long set_policy(int mode, const std::vector<int>& ids)
+{
+  unsigned long mask[TOPOLOGY_MASK_WORDS] = {0};
+  int bits = 8 * sizeof(unsigned long);
+  for (auto id: ids)
+  {
+    if (id < TOPOLOGY_MAX_NODES) mask[id / bits] |= 1UL << (id % bits);
+  }
+  return syscall(SYS_set_mempolicy, mode, mask, TOPOLOGY_MAX_NODES + 1);
+}
+
+///////////////////////////////////////////
+// Topology impl
+///////////////////////////////////////////
+
+Topology::Topology(const std::string& spec)
+{
+  // CPUs allowed to the process
+  std::vector<bool> allowed;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0)
+  {
+    for (int i=0; i<CPU_SETSIZE; i++) allowed.push_back(CPU_ISSET(i, &set));
+  }
+  else
+  {
+    allowed.resize(std::thread::hardware_concurrency(), true);
+  }
+
+  // allowed CPUs of online nodes
+  for (auto id: parse_list(read_line(TOPOLOGY_NODE_DIR "online")))
+  {
+    std::ostringstream path;
+    path << TOPOLOGY_NODE_DIR "node" << id << "/cpulist";
+
+    std::vector<int> cpus;
+    for (auto cpu: parse_list(read_line(path.str())))
+    {
+      if (cpu < (int)allowed.size() && allowed[cpu]) cpus.push_back(cpu);
+    }
+
+    if (cpus.size())
+    {
+      _cpus.push_back(cpus);
+      _ids.push_back(id);
+    }
+  }
+
+  // single node without NUMA
+  if (_cpus.empty())
+  {
+    std::vector<int> cpus;
+    for (int i=0; i<(int)allowed.size(); i++)
+    {
+      if (allowed[i]) cpus.push_back(i);
+    }
+    if (cpus.empty()) cpus.push_back(0);
+
+    _cpus.push_back(cpus);
+    _ids.push_back(0);
+  }
+
+  configure(spec);
+}
+
+Topology::Topology(const std::vector<std::vector<int>>& nodes,
+const std::string& spec) : _cpus(nodes)
+{
+  if (_cpus.empty())
+    throw std::runtime_error("Invalid topology without nodes");
+
+  for (int i=0; i<(int)_cpus.size(); i++)
+  {
+    if (_cpus[i].empty())
+      throw std::runtime_error("Invalid topology node without CPUs");
+    _ids.push_back(i);
+  }
+
+  configure(spec);
+}
+
+Topology Topology::environment()
+{
+  auto spec = std::getenv("SEEGNIFY_TOPOLOGY");
+  return Topology(spec ? spec : "");
+}
+
+void Topology::configure(const std::string& spec)
+{
+  for (int i=0; i<(int)_cpus.size(); i++)
+  {
+    for (auto cpu: _cpus[i]) _slots.emplace_back(i, cpu);
+  }
+
+  // one single threaded replica per CPU, unpinned
+  _replicas = cpus();
+  _threads = 1;
+  _affinity = NONE;
+  if (spec.empty()) return;
+
+  auto error = "Invalid topology '" + spec + "'";
+
+  auto colon = spec.find(':');
+  auto size = spec.substr(0, colon);
+  auto x = size.find('x');
+
+  try
+  {
+    size_t end;
+    _replicas = std::stoi(size, &end);
+    if (end != x && end != size.size()) throw std::runtime_error(error);
+    if (x != std::string::npos)
+    {
+      _threads = std::stoi(size.substr(x + 1), &end);
+      if (x + 1 + end != size.size()) throw std::runtime_error(error);
+    }
+  }
+  catch (std::logic_error&)
+  {
+    throw std::runtime_error(error);
+  }
+
+  if (_replicas < 1 || _threads < 1) throw std::runtime_error(error);
+
+  if (colon != std::string::npos)
+  {
+    auto affinity = spec.substr(colon + 1);
+    if (affinity == "none") _affinity = NONE;
+    else if (affinity == "node") _affinity = NODE;
+    else if (affinity == "cpu") _affinity = CPU;
+    else throw std::runtime_error(error);
+  }
+
+  // replicas pinned to own CPUs must not share them
+  if (_affinity == CPU && _replicas * _threads > cpus())
+  {
+    std::ostringstream log;
+    log << "Topology of " << _replicas << " x " << _threads
+        << " threads exceeds " << cpus() << " CPUs";
+    throw std::runtime_error(log.str());
+  }
+}
+
+int Topology::node(int replica) const
+{
+  return _slots[(size_t)replica * _threads % _slots.size()].first;
+}
+
+std::vector<int> Topology::cpus(int replica) const
+{
+  std::vector<int> cpus;
+
+  switch (_affinity)
+  {
+    case NONE:
+      for (auto& e: _slots) cpus.push_back(e.second);
+      break;
+    case NODE:
+      cpus = _cpus[node(replica)];
+      break;
+    case CPU:
+      for (int i=0; i<_threads; i++)
+      {
+        auto slot = ((size_t)replica * _threads + i) % _slots.size();
+        cpus.push_back(_slots[slot].second);
+      }
+      break;
+  }
+
+  return cpus;
+}
+
+void Topology::bind(int replica) const
+{
+  // intra-op threads of Eigen products of the calling thread, Eigen's own
+  // setting is global to all replicas
+#ifdef _OPENMP
+  omp_set_num_threads(_threads);
+#endif
+
+  if (_affinity == NONE) return;
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu: cpus(replica)) CPU_SET(cpu, &set);
+
+  if (sched_setaffinity(0, sizeof(set), &set))
+  {
+    std::ostringstream error;
+    error << "Failed to pin replica " << replica << ". Error code ";
+    error << errno << " .";
+    throw std::runtime_error(error.str());
+  }
+
+  // allocations first touched by the replica come from its node, the
+  // policy is a preference and may be denied in containers
+  if (nodes() > 1) set_policy(MPOL_PREFERRED, {_ids[node(replica)]});
+}
+
+void Topology::interleave(const void* data, size_t size)
+{
+  Topology system;
+  if (system.nodes() < 2) return;
+
+  // keep policy of calling thread
+  int mode = MPOL_DEFAULT;
+  unsigned long mask[TOPOLOGY_MASK_WORDS] = {0};
+  if (syscall(SYS_get_mempolicy, &mode, mask, TOPOLOGY_MAX_NODES + 1,
+      nullptr, 0)) return;
+
+  if (set_policy(MPOL_INTERLEAVE, system._ids)) return;
+
+  // fault pages in under interleave policy
+  auto page = sysconf(_SC_PAGESIZE);
+  auto bytes = (const volatile char*)data;
+  char sum = 0;
+  for (size_t i=0; i<size; i+=page) sum += bytes[i];
+  (void)sum;
+
+  syscall(SYS_set_mempolicy, mode, mask, TOPOLOGY_MAX_NODES + 1);
+}
+
+} /* namespace */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_TOPOLOGY_H_
+#define _SEEGNIFY_TOPOLOGY_H_
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace seegnify {
+
+// Placement of model replicas on the CPUs of NUMA nodes. Each replica runs
+// in its own thread with threads of intra-op parallelism, so replicas times
+// threads should not exceed the CPUs. Replicas take consecutive slots of
+// threads CPUs ordered by node and fill one node before the next.
+// Topology spec is REPLICAS[xTHREADS][:none|node|cpu], where the affinity
+// leaves a replica unpinned, pins it to all CPUs of its node or to the CPUs
+// of its slot. Pinned replicas prefer memory of their node, so the graph
+// buffers they allocate are local to the CPUs that use them.
+class Topology
+{
+public:
+  enum Affinity { NONE, NODE, CPU };
+
+  // CPUs of the process on system NUMA nodes, configured by spec
+  Topology(const std::string& spec = "");
+
+  // CPUs of given NUMA nodes, configured by spec
+  Topology(const std::vector<std::vector<int>>& nodes,
+  const std::string& spec);
+
+  // topology of SEEGNIFY_TOPOLOGY environment variable
+  static Topology environment();
+
+  // number of replicas
+  int replicas() const { return _replicas; }
+
+  // intra-op threads per replica
+  int threads() const { return _threads; }
+
+  // replica affinity
+  Affinity affinity() const { return _affinity; }
+
+  // number of NUMA nodes with CPUs of the process
+  int nodes() const { return _cpus.size(); }
+
+  // number of CPUs of the process
+  int cpus() const { return _slots.size(); }
+
+  // NUMA node index of replica
+  int node(int replica) const;
+
+  // CPUs pinned to replica, all CPUs when unpinned
+  std::vector<int> cpus(int replica) const;
+
+  // pin calling thread to replica CPUs, prefer memory of replica node
+  // and limit intra-op threads, spawned threads inherit the placement
+  void bind(int replica) const;
+
+  // spread pages of read-only data shared by replicas across system nodes,
+  // pages already in memory keep their node
+  static void interleave(const void* data, size_t size);
+
+private:
+  // parse spec
+  void configure(const std::string& spec);
+
+  // CPUs by node
+  std::vector<std::vector<int>> _cpus;
+
+  // system node ids
+  std::vector<int> _ids;
+
+  // node index and CPU of slots ordered by node
+  std::vector<std::pair<int,int>> _slots;
+
+  int _replicas;
+  int _threads;
+  Affinity _affinity;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_TOPOLOGY_H_ */
@@ -7,98 +7,685 @@
 #ifndef _SEEGNIFY_TRAINING_H_
 #define _SEEGNIFY_TRAINING_H_
 
+#include <memory>
+#include <algorithm>
+
 #include "main/graph.hh"
 #include "utils/storage.hh"
+#include "utils/checkpoint.hh"
 
 namespace seegnify {
 
+// Weights snapshot of training instances. Tensors are stored in FP32 or
+// in reduced precision, which halves the memory of the snapshot, and are
+// read in FP32.
+class Weights
+{
+public:
+  // snapshot of FP32 tensors
+  Weights(std::vector<Tensor> tensors = std::vector<Tensor>()) :
+  _tensors(std::move(tensors)), _precision(FP32) {}
+
+  // snapshot of tensors stored in precision
+  Weights(const std::vector<Tensor>& tensors, Precision precision) :
+  _precision(precision)
+  {
+    for (auto& t: tensors)
+    {
+      switch (precision)
+      {
+        case FP32: _tensors.push_back(t); break;
+        case FP16: _fp16.push_back(t.cast<Eigen::half>()); break;
+        case BF16: _bf16.push_back(t.cast<Eigen::bfloat16>()); break;
+      }
+    }
+  }
+
+  // number of tensors
+  size_t size() const
+  {
+    return _tensors.size() + _fp16.size() + _bf16.size();
+  }
+
+  // storage precision
+  Precision precision() const { return _precision; }
+
+  // tensor i in FP32, stored one or its copy in buffer
+  const Tensor& get(int i, Tensor& buffer) const
+  {
+    switch (_precision)
+    {
+      case FP16: buffer = _fp16[i].cast<DTYPE>(); return buffer;
+      case BF16: buffer = _bf16[i].cast<DTYPE>(); return buffer;
+      default: return _tensors[i];
+    }
+  }
+
+  // tensor i of FP32 snapshot
+  const Tensor& operator[](int i) const
+  {
+    if (_precision != FP32)
+      throw std::runtime_error("Weights stored in reduced precision");
+    return _tensors[i];
+  }
+
+private:
+  std::vector<Tensor> _tensors;
+  std::vector<TensorFP16> _fp16;
+  std::vector<TensorBF16> _bf16;
+  Precision _precision;
+};
+
+// Read-only weights snapshot shared by training instances of one process
+typedef std::shared_ptr<const Weights> SharedWeights;
+
+// write number of weights, precision other than FP32 is marked ahead of it
+inline void write_weights_header(int size, Precision precision,
+std::ostream& out)
+{
+  if (precision != FP32) write_int(-precision, out);
+  write_int(size, out);
+}
+
+// read number of weights and their precision
+inline int read_weights_header(std::istream& in, Precision& precision)
+{
+  int size = read_int(in);
+  precision = FP32;
+  if (size < 0)
+  {
+    precision = (Precision)-size;
+    size = read_int(in);
+  }
+  return size;
+}
+
+// get precision of serialized weights
+inline Precision weights_precision(const std::string& weights)
+{
+  Precision precision;
+  std::istringstream in(weights);
+  read_weights_header(in, precision);
+  return precision;
+}
+
+// write weights increment, only changed rows when less than half changed
+inline void write_update(const Tensor& curr, const Tensor& prev,
+Precision precision, std::ostream& out)
+{
+  std::vector<int> rows;
+  for (int r=0; r<curr.rows(); r++)
+  {
+    if (curr.row(r) != prev.row(r)) rows.push_back(r);
+  }
+
+  if (2 * rows.size() >= curr.rows())
+  {
+    write_tensor(curr - prev, out, precision);
+    return;
+  }
+
+  // negative count marks row-sparse increment
+  write_int(-(int)rows.size() - 1, out);
+  write_int(curr.rows(), out);
+
+  Tensor delta(rows.size(), curr.cols());
+  for (int i=0; i<rows.size(); i++)
+  {
+    write_int(rows[i], out);
+    delta.row(i) = curr.row(rows[i]) - prev.row(rows[i]);
+  }
+  write_tensor(delta, out, precision);
+}
+
+// read weights increment and add it to weights
+inline void read_update(Tensor& w, Precision precision, std::istream& in)
+{
+  int count = read_int(in);
+
+  // non-negative count is rows of dense increment
+  if (count >= 0)
+  {
+    w += read_tensor(in, precision, count);
+    return;
+  }
+
+  int size = -count - 1;
+  int rows = read_int(in);
+  if (rows != w.rows())
+    throw std::runtime_error("Incompatible weights update");
+
+  std::vector<int> index(size);
+  for (int i=0; i<size; i++) index[i] = read_int(in);
+
+  Tensor delta = read_tensor(in, precision);
+  for (int i=0; i<size; i++) w.row(index[i]) += delta.row(i);
+}
+
+// weights update compression
+enum Compression
+{
+  DENSE = 0,      // full increments
+  TOP_K = 1,      // largest fraction of increments
+  THRESHOLD = 2,  // increments of magnitude above threshold
+  QUANT8 = 3,     // 8-bit stochastic quantization
+  QUANT4 = 4      // 4-bit stochastic quantization
+};
+
+// write compressed weights increment, returns its decoded value
+inline Tensor write_compressed(const Tensor& delta, Compression compression,
+DTYPE param, RNG& rng, std::ostream& out)
+{
+  int size = delta.size();
+  write_int(delta.rows(), out);
+  write_int(delta.cols(), out);
+
+  Tensor decoded = Tensor::Zero(delta.rows(), delta.cols());
+
+  if (compression == TOP_K || compression == THRESHOLD)
+  {
+    std::vector<int> index;
+    if (compression == TOP_K)
+    {
+      // rank by magnitude in linear time, none of empty increment
+      int k = std::min(size, std::max(1, (int)(param * size)));
+      if (k > 0)
+      {
+        index.resize(size);
+        for (int i=0; i<size; i++) index[i] = i;
+        std::nth_element(index.begin(), index.begin() + k - 1, index.end(),
+          [&](int a, int b) {
+            return std::abs(delta.data()[a]) > std::abs(delta.data()[b]);
+          });
+        index.resize(k);
+        std::sort(index.begin(), index.end());
+      }
+    }
+    else
+    {
+      for (int i=0; i<size; i++)
+        if (std::abs(delta.data()[i]) >= param) index.push_back(i);
+    }
+
+    write_int(index.size(), out);
+    for (auto i: index) write_int(i, out);
+    for (auto i: index)
+    {
+      write_dtype(delta.data()[i], out);
+      decoded.data()[i] = delta.data()[i];
+    }
+  }
+  else if (compression == QUANT8 || compression == QUANT4)
+  {
+    // symmetric levels, unbiased by stochastic rounding
+    int levels = (compression == QUANT8) ? 127 : 7;
+    DTYPE max = size ? delta.cwiseAbs().maxCoeff() : 0;
+    DTYPE scale = (max > 0) ? max / levels : 1;
+    write_dtype(scale, out);
+
+    std::vector<int8_t> q(size);
+    for (int i=0; i<size; i++)
+    {
+      DTYPE x = delta.data()[i] / scale;
+      DTYPE f = std::floor(x);
+      q[i] = (int8_t)(f + (rng.uniform_dec(1) < x - f));
+      decoded.data()[i] = q[i] * scale;
+    }
+
+    if (compression == QUANT8)
+    {
+      out.write((const char*)q.data(), size);
+    }
+    else
+    {
+      // two offset nibbles per byte
+      std::vector<uint8_t> packed((size + 1) / 2, 0);
+      for (int i=0; i<size; i++)
+        packed[i / 2] |= (uint8_t)(q[i] + 8) << (4 * (i % 2));
+      out.write((const char*)packed.data(), packed.size());
+    }
+  }
+  else
+  {
+    throw std::runtime_error("Unsupported weights update compression");
+  }
+
+  return decoded;
+}
+
+// read compressed weights increment and add it to weights
+inline void read_compressed(Tensor& w, Compression compression,
+std::istream& in)
+{
+  int rows = read_int(in);
+  int cols = read_int(in);
+  if (rows != w.rows() || cols != w.cols())
+    throw std::runtime_error("Incompatible weights update");
+
+  int size = w.size();
+
+  if (compression == TOP_K || compression == THRESHOLD)
+  {
+    int k = read_int(in);
+    if (k < 0 || k > size)
+      throw std::runtime_error("Incompatible weights update");
+
+    std::vector<int> index(k);
+    for (int i=0; i<k; i++) index[i] = read_int(in);
+    for (int i=0; i<k; i++)
+    {
+      DTYPE v = read_dtype(in);
+      if (index[i] < 0 || index[i] >= size)
+        throw std::runtime_error("Incompatible weights update");
+      w.data()[index[i]] += v;
+    }
+  }
+  else if (compression == QUANT8 || compression == QUANT4)
+  {
+    DTYPE scale = read_dtype(in);
+    if (compression == QUANT8)
+    {
+      std::vector<int8_t> q(size);
+      in.read((char*)q.data(), size);
+      for (int i=0; i<size; i++) w.data()[i] += q[i] * scale;
+    }
+    else
+    {
+      std::vector<uint8_t> packed((size + 1) / 2);
+      in.read((char*)packed.data(), packed.size());
+      for (int i=0; i<size; i++)
+      {
+        int q = ((packed[i / 2] >> (4 * (i % 2))) & 0xF) - 8;
+        w.data()[i] += q * scale;
+      }
+    }
+  }
+  else
+  {
+    throw std::runtime_error("Unsupported weights update compression");
+  }
+
+  if (!in) throw std::runtime_error("Failed to read weights update");
+}
+
+// read weights increment of any compression and add it to weights
+inline void read_update(Tensor& w, Precision precision,
+Compression compression, std::istream& in)
+{
+  if (compression == DENSE)
+    read_update(w, precision, in);
+  else
+    read_compressed(w, compression, in);
+}
+
+// deserialize weights snapshot and its precision from stream, snapshot
+// is stored in given precision
+inline SharedWeights read_weights(std::istream& in, Precision& precision,
+Precision storage = FP32)
+{
+  int size = read_weights_header(in, precision);
+
+  std::vector<Tensor> tensors;
+  tensors.reserve(size);
+  for (int i=0; i<size; i++) tensors.push_back(read_tensor(in, precision));
+
+  if (!in) throw std::runtime_error("Failed to read weights");
+  if (storage != FP32) return std::make_shared<Weights>(tensors, storage);
+  return std::make_shared<Weights>(std::move(tensors));
+}
+
+// deserialize weights snapshot
+inline SharedWeights read_weights(const std::string& weights)
+{
+  Precision precision;
+  std::istringstream in(weights);
+  return read_weights(in, precision);
+}
+
+// Weights delta: number of weights, then for each weight the number of
+// increments since the requested version, each with its precision and
+// compression, or -1 followed by precision and full weight. Empty delta
+// marks current weights.
+inline SharedWeights read_weights_delta(std::istream& in,
+const SharedWeights& base)
+{
+  int size = read_int(in);
+  if (size != base->size())
+    throw std::runtime_error("Incompatible number of variables");
+
+  // base snapshot may still be in use, apply delta to its FP32 copy
+  std::vector<Tensor> tensors(size);
+  for (int i=0; i<size; i++)
+  {
+    auto& w = tensors[i];
+    w = base->get(i, w);
+    int count = read_int(in);
+    if (count < 0)
+    {
+      auto precision = (Precision)read_int(in);
+      w = read_tensor(in, precision);
+      continue;
+    }
+    for (int k=0; k<count; k++)
+    {
+      auto precision = (Precision)read_int(in);
+      auto compression = (Compression)read_int(in);
+      read_update(w, precision, compression, in); // (+)
+    }
+  }
+
+  if (!in) throw std::runtime_error("Failed to read weights delta");
+  return std::make_shared<Weights>(std::move(tensors));
+}
+
+// apply weights delta to base snapshot
+inline SharedWeights read_weights_delta(const std::string& delta,
+const SharedWeights& base)
+{
+  if (delta.empty()) return base;
+
+  std::istringstream in(delta);
+  return read_weights_delta(in, base);
+}
+
 // Distributed Training
 class Training
 {
 public:
-  Training(int worker) : _worker(worker) {}
+  Training(int worker) : _worker(worker), _precision(FP32), _storage(FP32),
+  _compression(DENSE), _compression_param(0), _staleness(1) {}
 
   virtual ~Training() {}
 
   virtual void batch_train() = 0;
 
-  // get graph weights
-  std::string get_weights()
+  // predict output rows of input rows with current weights, used by server
+  virtual void batch_predict(const Tensor& input, Tensor& output)
   {
-    // save graph weights
-    std::stringstream weights;
-    auto curr_vars = _curr.variables();
-    write_int(curr_vars.size(), weights);
-    for (auto v: curr_vars) write_tensor(v->value(), weights);
+    throw std::runtime_error("Model does not support prediction");
+  }
+
+  // get graph weights in transfer precision
+  std::string get_weights() { return get_weights(_precision); }
 
-    // return graph weights
+  // get graph weights in given precision
+  std::string get_weights(Precision precision)
+  {
+    std::ostringstream weights;
+    write_weights(weights, precision);
     return weights.str();
   }
 
+  // write graph weights in given precision to stream
+  void write_weights(std::ostream& out, Precision precision)
+  {
+    auto curr_vars = _curr.variables();
+    write_weights_header(curr_vars.size(), precision, out);
+    for (auto v: curr_vars) write_tensor(v->value(), out, precision);
+  }
+
   // set graph weights
   void set_weights(const std::string& weights)
   {
-    std::istringstream in(weights);
-    int size = read_int(in);
+    set_weights(read_weights(weights));
+  }
+
+  // read graph weights from stream into variables, returns their precision
+  Precision set_weights(std::istream& in)
+  {
+    Precision precision;
+    int size = read_weights_header(in, precision);
+
+    // create variables
+    for (int i=_curr.variables().size(); i<size; i++) _curr.new_variable();
+
+    auto curr_vars = _curr.variables();
+    for (int i=0; i<size; i++)
+      curr_vars[i]->value() = read_tensor(in, precision);
+
+    if (!in) throw std::runtime_error("Failed to read weights");
+    _prev = nullptr;
+    return precision;
+  }
+
+  // set graph weights from shared snapshot
+  void set_weights(const SharedWeights& weights)
+  {
+    int size = weights->size();
 
     // create variables
     if (_curr.variables().size() < size)
     {
       for (int i=_curr.variables().size(); i<size; i++) _curr.new_variable();
     }
-    if (_prev.variables().size() < size)
-    {
-      for (int i=_prev.variables().size(); i<size; i++) _prev.new_variable();
-    }
 
-    // load weight values
+    // load weight values and keep snapshot as reference for update
     auto curr_vars = _curr.variables();
-    auto prev_vars = _prev.variables();
     for (int i=0; i<size; i++)
     {
-      curr_vars[i]->value() = read_tensor(in);
-      prev_vars[i]->value() = curr_vars[i]->value();
+      auto& w = curr_vars[i]->value();
+      w = weights->get(i, w);
     }
+    _prev = weights;
   }
 
   // get last weights update
   std::string get_update()
   {
     auto curr_vars = _curr.variables();
-    auto prev_vars = _prev.variables();
-    if (curr_vars.size() != prev_vars.size())
+    if (!_prev || curr_vars.size() != _prev->size())
       throw std::runtime_error("Incompatible number of variables");
 
     // serialize weight updates
     std::ostringstream out;
     int size = curr_vars.size();
-    write_int(size, out);
+    write_weights_header(size, _precision, out);
+
+    Tensor buffer;
+    if (_compression == DENSE)
+    {
+      for (int i=0; i<size; i++)
+      {
+        auto& curr = curr_vars[i]->value();
+        auto& prev = _prev->get(i, buffer);
+        write_update(curr, prev, _precision, out); // save weight increments (+)
+      }
+      return out.str();
+    }
+
+    // compress increments, keep what was not sent for next update
+    _residual.resize(size);
     for (int i=0; i<size; i++)
     {
       auto& curr = curr_vars[i]->value();
-      auto& prev = prev_vars[i]->value();
-      write_tensor(curr - prev, out); // save weight increments (+)
+      auto& prev = _prev->get(i, buffer);
+      Tensor delta = curr - prev;
+      if (_residual[i].size() == delta.size()) delta += _residual[i];
+
+      auto sent = write_compressed(delta, _compression, _compression_param,
+        _curr.random(), out);
+      _residual[i] = delta - sent;
     }
     return out.str();
   }
 
   // apply weight increments (+)
-  void upd_weights(const std::string& update)
+  void upd_weights(const std::string& update, Compression compression = DENSE)
   {
     auto curr_vars = _curr.variables();
     std::istringstream in(update);
-    int size = read_int(in);
-    for (int i=0; i<size; i++) curr_vars[i]->value() += read_tensor(in); // (+)
+    Precision precision;
+    int size = read_weights_header(in, precision);
+    for (int i=0; i<size; i++)
+      read_update(curr_vars[i]->value(), precision, compression, in); // (+)
   }
 
+  // set compression of weights updates with fraction of TOP_K increments
+  // or THRESHOLD of their magnitude, residuals are added to next update
+  void compression(Compression compression, DTYPE param = 0)
+  {
+    _compression = compression;
+    _compression_param = param;
+    _residual.clear();
+  }
+
+  // get compression of weights updates
+  Compression compression() const { return _compression; }
+
+  // get fraction or threshold of compressed weights updates
+  DTYPE compression_param() const { return _compression_param; }
+
+  // number of weights
+  int weights_count() { return _curr.variables().size(); }
+
+  // add increment of weight i since weights were set to sum
+  void add_increment(int i, Tensor& sum)
+  {
+    auto curr_vars = _curr.variables();
+    if (!_prev || curr_vars.size() != _prev->size())
+      throw std::runtime_error("Incompatible number of variables");
+
+    Tensor buffer;
+    auto& curr = curr_vars[i]->value();
+    auto& prev = _prev->get(i, buffer);
+    if (sum.size()) sum += curr - prev; else sum = curr - prev;
+  }
+
+  // number of weight values of all variables
+  size_t flat_size()
+  {
+    size_t size = 0;
+    for (auto v: _curr.variables()) size += v->value().size();
+    return size;
+  }
+
+  // copy weights or, on request, their increments since weights were set,
+  // into flat buffer of flat_size() values
+  void get_flat(DTYPE* flat, bool increment = false)
+  {
+    auto curr_vars = _curr.variables();
+    if (increment && (!_prev || curr_vars.size() != _prev->size()))
+      throw std::runtime_error("Incompatible number of variables");
+
+    Tensor buffer;
+    for (int i=0; i<curr_vars.size(); i++)
+    {
+      auto& w = curr_vars[i]->value();
+      TensorMap out(flat, w.rows(), w.cols());
+      if (increment) out = w - _prev->get(i, buffer); else out = w;
+      flat += w.size();
+    }
+  }
+
+  // set weights from flat buffer or, on request, add it as increments
+  // to weights that were set last
+  void set_flat(const DTYPE* flat, bool increment = false)
+  {
+    auto curr_vars = _curr.variables();
+    if (increment && (!_prev || curr_vars.size() != _prev->size()))
+      throw std::runtime_error("Incompatible number of variables");
+
+    Tensor buffer;
+    std::vector<Tensor> weights;
+    for (int i=0; i<curr_vars.size(); i++)
+    {
+      auto& w = curr_vars[i]->value();
+      ConstTensorMap in(flat, w.rows(), w.cols());
+      if (increment) weights.push_back(_prev->get(i, buffer) + in);
+      else weights.push_back(in);
+      flat += w.size();
+    }
+    set_weights(std::make_shared<Weights>(std::move(weights)));
+  }
+
+  // save graph weights to checkpoint file of named tensors
+  void save_checkpoint(const std::string& path, bool checksum = true)
+  {
+    std::vector<const Tensor*> tensors;
+    for (auto v: _curr.variables()) tensors.push_back(&v->forward());
+
+    Checkpoint::write(path, checkpoint_names(), tensors, checksum);
+  }
+
+  // names of graph variables in variable order
+  std::vector<std::string> checkpoint_names()
+  {
+    std::unordered_map<Variable*, std::string> index;
+    for (auto& e: _curr.named_variables()) index[e.second] = e.first;
+
+    std::vector<std::string> names;
+    for (auto v: _curr.variables()) names.push_back(index[v]);
+    return names;
+  }
+
+  // copy graph weights with their checkpoint names
+  void snapshot(std::vector<std::string>& names, std::vector<Tensor>& tensors)
+  {
+    names = checkpoint_names();
+    tensors.clear();
+    for (auto v: _curr.variables()) tensors.push_back(v->forward());
+  }
+
+  // load graph weights from checkpoint file, by name into existing
+  // variables or in file order into new variables
+  void load_checkpoint(const std::string& path, bool verify = false)
+  {
+    Checkpoint checkpoint(path, verify);
+
+    if (_curr.variables().empty())
+    {
+      for (int i=0; i<checkpoint.size(); i++)
+        _curr.new_variable()->value() = checkpoint.tensor(i);
+    }
+    else
+    {
+      for (auto& e: _curr.named_variables())
+      {
+        int i = checkpoint.find(e.first);
+        if (i < 0)
+          throw std::runtime_error("Missing checkpoint tensor " + e.first);
+        e.second->value() = checkpoint.tensor(i);
+      }
+    }
+
+    _prev.reset();
+  }
+
+  // set precision of weights and updates transfer
+  void precision(Precision precision) { _precision = precision; }
+
+  // get precision of weights and updates transfer
+  Precision precision() const { return _precision; }
+
+  // set precision of weights snapshot shared by instances of one process,
+  // reduced precision snapshot holds full weights pulled in that precision
+  void storage(Precision precision) { _storage = precision; }
+
+  // get precision of weights snapshot shared by instances of one process
+  Precision storage() const { return _storage; }
+
+  // set number of own updates missing from weights of the next batch,
+  // 1 overlaps transfer with training, 0 transfers between batches
+  void staleness(int steps) { _staleness = std::max(0, std::min(steps, 1)); }
+
+  // get number of own updates missing from weights of the next batch
+  int staleness() const { return _staleness; }
+
 protected:
   Graph& graph() { return _curr; } 
   int worker() { return _worker; }
 
 private:
+
   Graph _curr;
-  Graph _prev;  
+  SharedWeights _prev;
   int _worker;
+  Precision _precision;
+  Precision _storage;
+  Compression _compression;
+  DTYPE _compression_param;
+  std::vector<Tensor> _residual;
+  int _staleness;
 };
 
 } /* namespace */
@@ -17,15 +17,70 @@
 #include <Poco/Net/StreamSocket.h>
 #include <Poco/Condition.h>
 #include <Poco/Mutex.h>
+#include <Poco/Timespan.h>
 #include <sstream>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <algorithm>
 
 #include "storage.hh"
 
 namespace seegnify {
 
+// seconds an idle server connection holds its thread before it is closed
+#define SERVER_IDLE_SECONDS 60
+
+// connections accepted by a server while all of its threads are busy
+#define SERVER_QUEUED 128
+
+// seconds between checks of connections waiting for a server thread
+#define SERVER_CHECK_SECONDS 10
+
+// seconds a pooled client connection stays idle, closed before the server
+// closes it
+#define CLIENT_IDLE_SECONDS 30
+
+// connections a client pool opens to one server at most
+#define CLIENT_CONNECTIONS 4
+
+// Bulk data of a message is not held in the message. It follows the
+// message as a payload of frames written from the data and read into its
+// destination, optionally deflated. Messages mark payloads with fields
+// "payload" and "deflate" of their envelopes.
+
+// payload written to stream
+typedef std::function<void(std::ostream&)> PayloadWriter;
+
+// shared buffers sent in order as one payload
+typedef std::vector<std::shared_ptr<const std::string>> Segments;
+
+// write payload frames produced by writer
+inline void write_payload(const PayloadWriter& writer, bool deflate,
+std::ostream& out) {
+  FrameOutputBuffer buffer(out, deflate);
+  std::ostream stream(&buffer);
+  writer(stream);
+  buffer.close();
+  if (!stream || !out) throw std::runtime_error("Failed to write payload");
+}
+
+// read payload frames into string
+inline void read_payload(std::string& payload, bool deflate,
+std::istream& in) {
+  FrameInputBuffer buffer(in, deflate);
+  char data[FRAME_BUFFER];
+  for (std::streamsize n; (n = buffer.sgetn(data, sizeof(data))) > 0;)
+    payload.append(data, n);
+}
+
 class ServerContext {
 public:
-  ServerContext(const Poco::Net::StreamSocket& socket) {
+  ServerContext(const Poco::Net::StreamSocket& socket) : _payload(nullptr) {
     const auto& address = socket.peerAddress();
     _address = address.host().toString();
     _port = address.port();
@@ -34,21 +89,67 @@ public:
   inline const std::string& peer_addr() const { return _address; }
   inline const uint16_t peer_port() const { return _port; }
 
+  // request payload, failed stream when request has none
+  inline std::istream& payload() { return _payload; }
+  inline bool has_payload() const { return _buffer != nullptr; }
+
+  // send segments as response payload
+  void reply(const Segments& segments) {
+    _segments = segments;
+    _replied = true;
+  }
+
+  // drop response payload of failed request
+  void discard() {
+    _segments.clear();
+    _replied = false;
+  }
+
+  inline bool replied() const { return _replied; }
+  inline const Segments& segments() const { return _segments; }
+
+  // payload bytes of current request and its response
+  uint64_t payload_in() const { return _buffer ? _buffer->bytes() : 0; }
+  uint64_t payload_out() const {
+    uint64_t size = 0;
+    for (auto& e: _segments) size += e->size();
+    return size;
+  }
+
+  // start request followed by payload when marked
+  void begin(std::istream& input, bool payload, bool deflate) {
+    _buffer.reset(payload ? new FrameInputBuffer(input, deflate) : nullptr);
+    _payload.rdbuf(_buffer.get());
+    _segments.clear();
+    _replied = false;
+  }
+
+  // skip payload not read by request handler
+  void end() {
+    if (_buffer) _buffer->drain();
+  }
+
 private:
   std::string _address;
   uint16_t _port;
+  std::unique_ptr<FrameInputBuffer> _buffer;
+  std::istream _payload;
+  Segments _segments;
+  bool _replied = false;
 };
 
 template <typename Request, typename Response>
 class ProtobufServer {
 public:
 
-  ProtobufServer(void(*handlerR)(const ServerContext&, Request&, Response&),
+  ProtobufServer(void(*handlerR)(ServerContext&, Request&, Response&),
     void(*handlerE)(const std::exception&, Response&)) {
     _handlerR = handlerR;
     _handlerE = handlerE;
   }
 
+  // serve connections on port, each open connection holds one of threads
+  // until it is closed or idle, further connections wait in a queue
   void run(uint16_t port, uint16_t threads) {
     // create server socket
     Poco::Net::SocketAddress address("0.0.0.0", port);
@@ -58,19 +159,25 @@ public:
     // create multi-threaded server
     Poco::ThreadPool pool(1, threads);
     Poco::Net::TCPServerParams::Ptr params = new Poco::Net::TCPServerParams();
-    params->setMaxQueued(128);
+    params->setMaxQueued(SERVER_QUEUED);
     params->setMaxThreads(threads);
-    params->setThreadIdleTime(60);
+    params->setThreadIdleTime(Poco::Timespan(SERVER_IDLE_SECONDS, 0));
     Poco::Net::TCPServer server(
-      new ConnectionFactory(_handlerR, _handlerE), pool, socket);
+      new ConnectionFactory(_handlerR, _handlerE), pool, socket, params);
 
     // start listening thread
     server.start();
 
-    // wait indefinitely
+    // wait until stopped, report connections waiting for a thread
     Poco::Mutex mtx;
     Poco::Mutex::ScopedLock lock(mtx);
-    _run_condition.wait(mtx);
+    while (!_run_condition.tryWait(mtx, SERVER_CHECK_SECONDS * 1000)) {
+      int queued = server.queuedConnections();
+      if (queued > 0) {
+        std::cerr << "All " << server.maxThreads() << " server threads busy, "
+                  << queued << " connections waiting" << std::endl;
+      }
+    }
 
     // stop listening thread
     server.stop();
@@ -86,7 +193,7 @@ protected:
   class ConnectionFactory : public Poco::Net::TCPServerConnectionFactory {
     public:
       ConnectionFactory(void(*handlerR)(
-        const ServerContext&, Request&, Response&),
+        ServerContext&, Request&, Response&),
         void(*handlerE)(const std::exception&, Response&)) {
         _handlerR = handlerR;
         _handlerE = handlerE;
@@ -98,7 +205,7 @@ protected:
       }
 
     private:
-      void(*_handlerR)(const ServerContext&, Request&, Response&);
+      void(*_handlerR)(ServerContext&, Request&, Response&);
       void(*_handlerE)(const std::exception&, Response&);
   };
 
@@ -106,7 +213,7 @@ protected:
   class ConnectionHandler : public Poco::Net::TCPServerConnection {
     public:
       ConnectionHandler(void(*handlerR)(
-        const ServerContext&, Request&, Response&),
+        ServerContext&, Request&, Response&),
         void(*handlerE)(const std::exception&, Response&),
         const Poco::Net::StreamSocket& socket) :
         Poco::Net::TCPServerConnection(socket) {
@@ -116,6 +223,10 @@ protected:
 
       void run() {
         auto& s = socket();
+
+        // idle connection ends at message boundary and frees its thread
+        s.setReceiveTimeout(Poco::Timespan(SERVER_IDLE_SECONDS, 0));
+
         Poco::Net::SocketInputStream input(s);
         Poco::Net::SocketOutputStream output(s);
         ServerContext context(s);
@@ -124,46 +235,68 @@ protected:
           Response response;
 
           while(read_pb(request, input)) {
-            _handlerR(context, request, response);
+            context.begin(input, request.payload(), request.deflate());
+
+            // failed request gets error response, connection stays open
+            try {
+              _handlerR(context, request, response);
+            }
+            catch (std::exception& e) {
+              response.Clear();
+              context.discard();
+              _handlerE(e, response);
+            }
+            context.end();
+
+            // reply payload in compression of request
+            bool deflate = request.deflate();
+            response.set_id(request.id());
+            if (context.replied()) {
+              response.set_payload(true);
+              response.set_deflate(deflate);
+            }
             write_pb(response, output);
+            if (context.replied()) {
+              write_payload([&](std::ostream& out) {
+                for (auto& e: context.segments()) out.write(e->data(), e->size());
+              }, deflate, output);
+            }
             output.flush();
             request.Clear();
             response.Clear();
           }
         }
         catch (std::exception& e) {
-          on_error(e, output);
-        }
-      }
-
-    protected:
-      void on_error(const std::exception& e, std::ostream& output) {
-        try {
-          Response response;
-          _handlerE(e, response);
-          write_pb(response, output);
-        }
-        catch (std::exception& e) {
+          // connection failed, responses can no longer be sent
           std::cout << "Exception in session thread: " << e.what() << std::endl;
         }
       }
 
     private:
-      void(*_handlerR)(const ServerContext&, Request&, Response&);
+      void(*_handlerR)(ServerContext&, Request&, Response&);
       void(*_handlerE)(const std::exception&, Response&);
   };
 
 private:
 
-  void(*_handlerR)(const ServerContext&, Request&, Response&);
+  void(*_handlerR)(ServerContext&, Request&, Response&);
   void(*_handlerE)(const std::exception&, Response&);
   Poco::Condition _run_condition;
 };
 
+// Long-lived client connection. Requests on one connection are sent one
+// at a time and the server answers them in order, so each response is
+// read before the next request is sent. Request ids only verify that
+// order. Concurrent callers use separate connections of a client pool.
 template <typename Request, typename Response>
 class ProtobufClient {
 public:
 
+  // response payload read from stream
+  typedef std::function<void(Response&, std::istream&)> PayloadReader;
+
+  ProtobufClient(bool deflate = false) : _next_id(0), _deflate(deflate) {}
+
   ~ProtobufClient() {
     disconnect();
   }
@@ -173,6 +306,8 @@ public:
   }
 
   void disconnect() {
+      _input.reset();
+      _output.reset();
       _stream.close();
   }
 
@@ -186,21 +321,154 @@ public:
       error << "Failed to connect to '" << host << ":" << service << "'";
       throw std::runtime_error(error.str());
     }
+    _stream.setNoDelay(true);
+
+    // buffered streams live as long as the connection
+    _input.reset(new Poco::Net::SocketInputStream(_stream));
+    _output.reset(new Poco::Net::SocketOutputStream(_stream));
   }
 
-  void send(const Request& request) {
-    Poco::Net::SocketStream stream(_stream);
-    write_pb(request, stream);
+  bool connected() const {
+    return _output != nullptr;
+  }
+
+  void send(const Request& request, const PayloadWriter& writer = nullptr) {
+    write_pb(request, *_output);
+    if (writer) write_payload(writer, request.deflate(), *_output);
+    _output->flush();
   }
 
   void receive(Response& response) {
-    Poco::Net::SocketStream stream(_stream);
-    read_pb(response, stream);
+    if (!read_pb(response, *_input))
+      throw std::runtime_error("Connection closed by server");
+  }
+
+  // send request and wait for its response, payloads of both are optional,
+  // response payload is read into its destination or skipped without reader
+  void call(Request& request, Response& response,
+    const PayloadWriter& writer = nullptr,
+    const PayloadReader& reader = nullptr) {
+    request.set_id(++_next_id);
+    request.set_payload(writer != nullptr);
+    request.set_deflate(writer != nullptr && _deflate);
+    send(request, writer);
+
+    receive(response);
+    if (response.id() != request.id())
+      throw std::runtime_error("Response out of order");
+
+    if (response.payload()) {
+      FrameInputBuffer buffer(*_input, response.deflate());
+      std::istream in(&buffer);
+      if (reader) reader(response, in);
+      buffer.drain();
+    }
   }
 
 private:
 
   Poco::Net::StreamSocket _stream;
+  std::unique_ptr<Poco::Net::SocketInputStream> _input;
+  std::unique_ptr<Poco::Net::SocketOutputStream> _output;
+  uint64_t _next_id;
+  bool _deflate;
+};
+
+// Per process pool of client connections to one server. Connections are
+// opened on demand up to a limit, returned to the pool after use and
+// dropped on error or after idle time. Callers wait for a connection when
+// all of them are in use, so that the server needs at most the limit of
+// connection threads for each client process.
+template <typename Request, typename Response>
+class ProtobufClientPool {
+public:
+
+  typedef ProtobufClient<Request, Response> Client;
+  typedef typename Client::PayloadReader PayloadReader;
+
+  ProtobufClientPool(const std::string& host, uint32_t port,
+    bool deflate = false, int connections = CLIENT_CONNECTIONS) :
+    _host(host), _port(port), _deflate(deflate),
+    _connections(std::max(connections, 1)), _open(0) {}
+
+  // send request on an idle connection and wait for its response
+  void call(Request& request, Response& response,
+    const PayloadWriter& writer = nullptr,
+    const PayloadReader& reader = nullptr) {
+    auto client = acquire();
+    try {
+      client->call(request, response, writer, reader);
+    }
+    catch (...) {
+      // connection in unknown state after error is closed
+      drop(std::move(client));
+      throw;
+    }
+    release(std::move(client));
+  }
+
+  // take idle connection or open a new one within the limit
+  std::unique_ptr<Client> acquire() {
+    std::unique_lock<std::mutex> lock(_lock);
+
+    // close connections idle long enough for the server to close them
+    auto expired = Clock::now() - std::chrono::seconds(CLIENT_IDLE_SECONDS);
+    while (_idle.size() && _idle.front().second < expired) {
+      _idle.pop_front();
+      _open--;
+    }
+
+    _released.wait(lock, [&]() {
+      return _idle.size() || _open < _connections;
+    });
+
+    if (_idle.size()) {
+      auto client = std::move(_idle.back().first);
+      _idle.pop_back();
+      return client;
+    }
+
+    _open++;
+    lock.unlock();
+
+    try {
+      std::unique_ptr<Client> client(new Client(_deflate));
+      client->connect(_host, _port);
+      return client;
+    }
+    catch (...) {
+      drop(nullptr);
+      throw;
+    }
+  }
+
+  // return healthy connection to the pool
+  void release(std::unique_ptr<Client> client) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _idle.emplace_back(std::move(client), Clock::now());
+    _released.notify_one();
+  }
+
+  // close failed connection
+  void drop(std::unique_ptr<Client> client) {
+    client.reset();
+    std::lock_guard<std::mutex> lock(_lock);
+    _open--;
+    _released.notify_one();
+  }
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  std::string _host;
+  uint32_t _port;
+  bool _deflate;
+  int _connections;
+  int _open;
+  std::mutex _lock;
+  std::condition_variable _released;
+  std::deque<std::pair<std::unique_ptr<Client>, Clock::time_point>> _idle;
 };
 
 } /* namespace */
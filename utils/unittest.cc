@@ -5,7 +5,10 @@
  */
 
 #include <iostream>
+#include <fstream>
 #include <thread>
+#include <sched.h>
+#include <atomic>
 #include <csignal>
 #include <chrono>
 #include <queue>
@@ -13,13 +16,25 @@
 #include <unsupported/Eigen/FFT>
 
 #include "main/graph.hh"
+#include "main/backend.hh"
 #include "main/optimizer.hh"
 #include "unittest.hh"
 #include "storage.hh"
+#include "dataset.hh"
+#include "audio.hh"
+#include "audiostream.hh"
+#include "spectrogram.hh"
+#include "pipeline.hh"
+#include "replay.hh"
+#include "batcher.hh"
+#include "topology.hh"
+#include "ring.hh"
 #include "image.hh"
 #include "imageFP.hh"
 #include "painter.hh"
 #include "rlenv.hh"
+#include "vecrlenv.hh"
+#include "training.hh"
 
 using namespace seegnify;
 
@@ -258,6 +273,159 @@ void test_audio_file()
   TEST_END()
 }
 
+void test_audio_stream()
+{
+  TEST_BEGIN("Audio Stream")
+
+  int sample_rate = 16000;
+  int steps = sample_rate / 2;
+
+  // stereo tone, 440 Hz left and 1000 Hz right
+  AudioFile<DTYPE> file;
+  file.setSampleRate(sample_rate);
+  file.setAudioBufferSize(2, steps);
+  for (int i=0; i<steps; i++)
+  {
+    DTYPE t = (DTYPE)i / sample_rate;
+    file.samples[0][i] = 0.8 * sin(2 * M_PI * 440 * t);
+    file.samples[1][i] = 0.4 * sin(2 * M_PI * 1000 * t);
+  }
+
+  // formats decoded the same as AudioFile
+  struct { int bits; AudioFileFormat format; const char* name; } formats[] = {
+    {8, AudioFileFormat::Wave, "/tmp/stream-8.wav"},
+    {16, AudioFileFormat::Wave, "/tmp/stream-16.wav"},
+    {24, AudioFileFormat::Wave, "/tmp/stream-24.wav"},
+    {32, AudioFileFormat::Wave, "/tmp/stream-32.wav"},
+    {16, AudioFileFormat::Aiff, "/tmp/stream-16.aiff"},
+    {24, AudioFileFormat::Aiff, "/tmp/stream-24.aiff"},
+  };
+
+  for (auto& f: formats)
+  {
+    file.setBitDepth(f.bits);
+    file.save(f.name, f.format);
+
+    AudioFile<DTYPE> expected;
+    expected.load(f.name);
+
+    AudioStream audio(f.name);
+    ASSERT(audio.channels() == 2)
+    ASSERT(audio.sample_rate() == sample_rate)
+    ASSERT(audio.bit_depth() == f.bits)
+    ASSERT(audio.frames() == steps)
+
+    // frames decoded from the middle of the file
+    std::vector<DTYPE> left(100), right(100), mean(100);
+    ASSERT(audio.read(1000, 100, left.data(), 0) == 100)
+    ASSERT(audio.read(1000, 100, right.data(), 1) == 100)
+    ASSERT(audio.read(1000, 100, mean.data()) == 100)
+    for (int i=0; i<100; i++)
+    {
+      ASSERT(left[i] == expected.samples[0][1000 + i])
+      ASSERT(right[i] == expected.samples[1][1000 + i])
+      ASSERT(std::abs(mean[i] - (left[i] + right[i]) / 2) < EPSILON)
+    }
+
+    // read stops at the end of file
+    ASSERT(audio.read(steps - 10, 100, left.data(), 0) == 10)
+    ASSERT(audio.read(steps, 100, left.data(), 0) == 0)
+  }
+
+  // load_audio decodes channels from the stream
+  std::vector<DTYPE> samples;
+  int num_channels, rate;
+  load_audio("/tmp/stream-16.wav", samples, num_channels, rate);
+  ASSERT(num_channels == 2 && rate == sample_rate)
+  ASSERT(samples.size() == 2 * steps)
+
+  AudioStream audio("/tmp/stream-16.wav");
+  std::vector<DTYPE> right(steps);
+  audio.read(0, steps, right.data(), 1);
+  ASSERT(std::equal(right.begin(), right.end(), samples.begin() + steps))
+
+  std::ofstream("/tmp/stream.txt") << "not an audio file";
+  try
+  {
+    AudioStream invalid("/tmp/stream.txt");
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  TEST_END()
+
+  TEST_BEGIN("Spectrogram")
+
+  int sample_rate = 12000;
+  int window = 256;
+  int hop = 128;
+
+  // tone on the center frequency of bin 20
+  int bin = 20;
+  DTYPE tone = (DTYPE)bin * sample_rate / window;
+
+  std::vector<DTYPE> samples(sample_rate);
+  for (int i=0; i<sample_rate; i++)
+    samples[i] = 0.5 * sin(2 * M_PI * tone * i / sample_rate);
+  save_audio("/tmp/spectrogram.wav", samples, 1, sample_rate);
+
+  // samples as decoded from file
+  int num_channels, rate;
+  load_audio("/tmp/spectrogram.wav", samples, num_channels, rate);
+
+  // power spectrum peaks at tone bin
+  Spectrogram stft(sample_rate, window, hop, 0, 0, 0, false);
+  ASSERT(stft.bins() == window / 2 + 1)
+  ASSERT(stft.features() == stft.bins())
+  ASSERT(stft.frames(sample_rate) == 1 + (sample_rate - window) / hop)
+  ASSERT(stft.frames(window - 1) == 0)
+
+  AudioStream audio("/tmp/spectrogram.wav");
+  Tensor power;
+  stft.compute(audio, 10, 8, power);
+  ASSERT(power.rows() == 8 && power.cols() == stft.bins())
+  for (int t=0; t<8; t++)
+  {
+    int peak;
+    power.row(t).maxCoeff(&peak);
+    ASSERT(peak == bin)
+  }
+
+  // same features from stream and from samples
+  Tensor direct(8, stft.features());
+  stft.compute(samples.data(), samples.size(), 10, 8, direct.data());
+  ASSERT(power.isApprox(direct))
+
+  // frames past the end are zero padded
+  long last = stft.frames(samples.size());
+  stft.compute(audio, last - 1, 4, power);
+  stft.compute(samples.data(), samples.size(), last - 1, 4, direct.data());
+  ASSERT(power.isApprox(direct.topRows(4)))
+  ASSERT(power.row(3).isZero())
+
+  // mel filterbank of log power, written into rows of a batch
+  int mels = 40;
+  Spectrogram mel(sample_rate, window, hop, mels);
+  ASSERT(mel.features() == mels)
+  ASSERT(mel.filterbank().rows() == mel.bins())
+  ASSERT(mel.filterbank().cols() == mels)
+  ASSERT(mel.filterbank().minCoeff() >= 0)
+  for (int m=0; m<mels; m++)
+  {
+    ASSERT(mel.filterbank().col(m).sum() > 0)
+  }
+
+  Tensor batch(2, 4 * mels);
+  mel.compute(audio, 10, 4, batch.row(1).data());
+  Tensor expected;
+  Spectrogram linear(sample_rate, window, hop, mels, 0, 0, false);
+  linear.compute(audio, 10, 4, expected);
+  expected = (expected.array() + 1e-10).log();
+  ASSERT(ConstTensorMap(batch.row(1).data(), 4, mels).isApprox(expected))
+
+  TEST_END()
+}
+
 void test_image_file()
 {
   TEST_BEGIN("Image Scale & Crop")
@@ -375,6 +543,416 @@ void test_image_file()
   TEST_END()
 }
 
+void test_dataset_file()
+{
+  TEST_BEGIN("Dataset File")
+
+  int N = 5;
+  int FEATURES = 7;
+  std::string path = "/tmp/test.sgds";
+  std::remove(path.c_str());
+
+  std::vector<std::vector<DTYPE>> inputs(N);
+  std::vector<uint8_t> labels(N);
+  for (int i=0; i<N; i++)
+  {
+    for (int j=0; j<FEATURES; j++) inputs[i].push_back(i * FEATURES + j);
+    labels[i] = 2 * i;
+  }
+
+  // convert once, map once per process
+  int converted = 0;
+  auto convert = [&](const std::string& p)
+  {
+    converted++;
+    Dataset::write(p, inputs, labels);
+  };
+
+  auto data1 = Dataset::shared(path, convert);
+  auto data2 = Dataset::shared(path, convert);
+  ASSERT(converted == 1)
+  ASSERT(data1 == data2)
+
+  ASSERT(data1->size() == N)
+  ASSERT(data1->features() == FEATURES)
+  for (int i=0; i<N; i++)
+  {
+    ASSERT(data1->input(i) == ConstRowVectorMap(inputs[i].data(), FEATURES))
+    ASSERT(data1->label(i) == labels[i])
+  }
+
+  std::remove(path.c_str());
+
+  TEST_END()
+}
+
+void test_pipeline()
+{
+  TEST_BEGIN("Data Pipeline")
+
+  int N = 10;
+  int BATCH = 3;
+  int EPOCHS = 3;
+
+  // sample index as input, augmentation draw as target
+  auto prepare = [](int index, Batch& batch, int row, RNG& rng)
+  {
+    batch.input(row, 0) = index;
+    batch.target(row, 0) = rng.uniform_dec(1.0);
+  };
+
+  Pipeline p1(N, BATCH, 1, 1, prepare, 1, 2, 7);
+  Pipeline p4(N, BATCH, 1, 1, prepare, 4, 3, 7);
+
+  // every sample once per epoch in the same order for any number of workers
+  std::vector<int> seen(N, 0);
+  Batch b1, b4;
+  for (int i=0; i<N*EPOCHS/BATCH; i++)
+  {
+    p1.take(b1);
+    p4.take(b4);
+
+    ASSERT(b1.input.rows() == BATCH)
+    ASSERT(b1.index == b4.index)
+    ASSERT(b1.target == b4.target)
+    for (int r=0; r<BATCH; r++)
+    {
+      ASSERT(b1.input(r, 0) == b1.index[r])
+      seen[b1.index[r]]++;
+    }
+  }
+  ASSERT(p1.taken() == N*EPOCHS/BATCH)
+  for (int i=0; i<N; i++)
+  {
+    ASSERT(seen[i] == EPOCHS)
+  }
+
+  // worker exceptions rethrown to the training thread
+  Pipeline bad(N, BATCH, 1, 1, [](int index, Batch& batch, int row, RNG& rng)
+  {
+    throw std::runtime_error("bad sample");
+  });
+  bool thrown = false;
+  try { bad.take(b1); } catch (std::exception& e) { thrown = true; }
+  ASSERT(thrown)
+
+  TEST_END()
+}
+
+void test_replay_buffer()
+{
+  TEST_BEGIN("Replay Buffer")
+
+  int capacity = 64;
+  int features = 5;
+  int threads = 4;
+  int count = 2000;
+
+  ReplayBuffer buffer(capacity, features);
+  ASSERT(buffer.size() == 0)
+
+  Experience batch;
+  RNG rng;
+  try
+  {
+    buffer.sample(1, batch, rng);
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  // concurrent producers and a sampler checking transitions are not torn
+  std::atomic<bool> torn(false);
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> producers;
+  for (int t=0; t<threads; t++)
+  producers.emplace_back([&, t]()
+  {
+    std::vector<DTYPE> observation(features);
+    for (int i=0; i<count; i++)
+    {
+      DTYPE value = t * count + i;
+      std::fill(observation.begin(), observation.end(), value);
+      buffer.insert(observation.data(), t, value, i == count - 1);
+    }
+  });
+
+  std::thread sampler([&]()
+  {
+    RNG rng;
+    Experience batch;
+    while (!stop)
+    {
+      if (buffer.size() == 0) continue;
+      buffer.sample(8, batch, rng);
+      for (int r=0; r<8; r++)
+      {
+        auto value = batch.reward[r];
+        if ((batch.observation.row(r).array() != value).any() ||
+            batch.action[r] != int(value) / count) torn = true;
+      }
+    }
+  });
+
+  for (auto& p: producers) p.join();
+  stop = true;
+  sampler.join();
+
+  ASSERT(!torn)
+  ASSERT(buffer.inserted() == threads * count)
+  ASSERT(buffer.size() == capacity)
+
+  // only the latest capacity tickets are held
+  ASSERT(buffer.valid(threads * count - 1))
+  ASSERT(!buffer.valid(threads * count - capacity - 1))
+  ASSERT(!buffer.valid(threads * count))
+
+  // tickets of sampled rows are held
+  buffer.sample(16, batch, rng);
+  ASSERT(batch.observation.rows() == 16)
+  for (int r=0; r<16; r++)
+  {
+    ASSERT(buffer.valid(batch.ticket[r]))
+    ASSERT(batch.priority[r] == 1)
+  }
+
+  // rows inserted as consecutive tickets and viewed without copy
+  Tensor rows = Tensor::Random(4, features);
+  std::vector<int> action = {0, 1, 2, 3};
+  std::vector<DTYPE> reward = {0, 0, 0, 1};
+  std::vector<bool> done = {false, false, false, true};
+
+  long first = buffer.insert(rows, action, reward, done);
+  while (first % capacity + 4 > capacity)
+    first = buffer.insert(rows, action, reward, done);
+
+  auto view = buffer.observations(first, 4);
+  ASSERT(view == rows)
+  ASSERT(view.data() != rows.data())
+
+  try
+  {
+    buffer.observations(first + 4, 1);
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  // prioritized sampling prefers high priority
+  for (long t=buffer.inserted()-capacity; t<buffer.inserted(); t++)
+    buffer.update(t, 0.001);
+  long high = buffer.inserted() - 1;
+  buffer.update(high, 100);
+
+  buffer.sample_prioritized(32, batch, rng);
+  int hits = 0;
+  for (int r=0; r<32; r++) hits += (batch.ticket[r] == high);
+  ASSERT(hits > 28)
+
+  TEST_END()
+}
+
+void test_batcher()
+{
+  TEST_BEGIN("Request Batcher")
+
+  int max_rows = 8;
+  int replicas = 2;
+  int callers = 16;
+  int count = 20;
+
+  Batcher batcher(max_rows, 2000);
+
+  // predict doubles rows, fails on negative input
+  std::atomic<int> largest(0);
+  std::vector<std::thread> threads;
+  for (int t=0; t<replicas; t++)
+  threads.emplace_back([&]()
+  {
+    batcher.run([&](const Tensor& input, Tensor& output)
+    {
+      if ((input.array() < 0).any())
+        throw std::runtime_error("Negative input");
+
+      int rows = input.rows();
+      while (rows > largest) largest = rows;
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      output = 2 * input;
+    });
+  });
+
+  // concurrent requests get their own rows back
+  std::atomic<bool> wrong(false);
+  std::vector<std::thread> requests;
+  for (int c=0; c<callers; c++)
+  requests.emplace_back([&, c]()
+  {
+    for (int i=0; i<count; i++)
+    {
+      int rows = 1 + (c + i) % 3;
+      Tensor input = Tensor::Constant(rows, 3, c * count + i);
+      Tensor output;
+      batcher.predict(input, output);
+      if (output != 2 * input) wrong = true;
+    }
+  });
+
+  for (auto& r: requests) r.join();
+
+  ASSERT(!wrong)
+  ASSERT(largest <= max_rows)
+  ASSERT(batcher.requests() == callers * count)
+  ASSERT(batcher.batches() < batcher.requests())
+  ASSERT(batcher.latency(0.5) > 0)
+  ASSERT(batcher.latency(0.5) <= batcher.latency(0.99))
+
+  // request larger than batch is a batch of its own
+  Tensor input = Tensor::Ones(max_rows + 2, 3), output;
+  batcher.predict(input, output);
+  ASSERT(output == 2 * input)
+  ASSERT(largest == max_rows + 2)
+
+  // prediction error is raised to its requests
+  input = -input;
+  try
+  {
+    batcher.predict(input, output);
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  batcher.stop();
+  for (auto& t: threads) t.join();
+
+  try
+  {
+    batcher.predict(input, output);
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  TEST_END()
+}
+
+void test_topology()
+{
+  TEST_BEGIN("Worker Topology")
+
+  // two nodes of 4 CPUs
+  std::vector<std::vector<int>> nodes = {{0,1,2,3}, {4,5,6,7}};
+
+  // default as one unpinned replica per CPU
+  Topology unpinned(nodes, "");
+  ASSERT(unpinned.nodes() == 2)
+  ASSERT(unpinned.cpus() == 8)
+  ASSERT(unpinned.replicas() == 8)
+  ASSERT(unpinned.threads() == 1)
+  ASSERT(unpinned.affinity() == Topology::NONE)
+  ASSERT(unpinned.cpus(5).size() == 8)
+
+  // replicas fill one node before the next
+  Topology cpu(nodes, "4x2:cpu");
+  ASSERT(cpu.replicas() == 4)
+  ASSERT(cpu.threads() == 2)
+  ASSERT(cpu.node(0) == 0 && cpu.node(1) == 0)
+  ASSERT(cpu.node(2) == 1 && cpu.node(3) == 1)
+  ASSERT(cpu.cpus(1) == std::vector<int>({2,3}))
+  ASSERT(cpu.cpus(2) == std::vector<int>({4,5}))
+
+  // replicas pinned to all CPUs of node
+  Topology node(nodes, "2x4:node");
+  ASSERT(node.node(1) == 1)
+  ASSERT(node.cpus(1) == std::vector<int>({4,5,6,7}))
+
+  // invalid specs
+  for (auto spec: {"x2", "4x", "0x1", "2y2", "2x2:core", "3x3:cpu"})
+  {
+    bool error = false;
+    try { Topology t(nodes, spec); } catch (std::exception&) { error = true; }
+    ASSERT(error)
+  }
+
+  // placement of thread on first CPU of process
+  Topology system("1x1:cpu");
+  ASSERT(system.cpus() >= 1)
+
+  int pinned = 0, threads = 0;
+  std::thread replica([&]()
+  {
+    system.bind(0);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+    pinned = CPU_COUNT(&set);
+    threads = Eigen::nbThreads();
+  });
+  replica.join();
+  ASSERT(pinned == 1)
+  ASSERT(threads == 1)
+
+  // shared data readable after interleave
+  std::vector<char> data(1 << 16, 1);
+  Topology::interleave(data.data(), data.size());
+  ASSERT(data.back() == 1)
+
+  TEST_END()
+}
+
+void test_ring_all_reduce()
+{
+  TEST_BEGIN("Ring All-Reduce")
+
+  // in-process ranks over loopback, buffer of two buckets
+  size_t size = RING_BUCKET + 7;
+  for (int n=1; n<=3; n++)
+  {
+    std::vector<std::string> hosts;
+    for (int r=0; r<n; r++)
+      hosts.push_back("127.0.0.1:" + std::to_string(20730 + 10 * n + r));
+
+    // rank r holds value r / 8 + i / 1024 at index i
+    std::vector<std::vector<float>> data(n, std::vector<float>(size));
+    std::vector<int64_t> totals(n);
+    std::vector<std::string> errors(n);
+    std::vector<std::thread> ranks;
+    for (int r=0; r<n; r++)
+    ranks.emplace_back([&, r]()
+    {
+      try
+      {
+        Ring ring(r, hosts);
+        for (size_t i=0; i<size; i++) data[r][i] = r / 8.0 + i % 1024 / 1024.0;
+        ring.all_reduce(data[r].data(), size);
+
+        // fewer values than ranks
+        totals[r] = r + 1;
+        ring.all_reduce(&totals[r], 1);
+      }
+      catch (std::exception& e)
+      {
+        errors[r] = e.what();
+      }
+    });
+    for (auto& r: ranks) r.join();
+
+    for (int r=0; r<n; r++)
+    {
+      ASSERT(errors[r].empty())
+      ASSERT(totals[r] == n * (n + 1) / 2)
+      ASSERT(data[r] == data[0])
+    }
+
+    // mean of ranks as averaged by ring training
+    bool mean = true;
+    for (size_t i=0; i<size; i++)
+    {
+      float expected = (n - 1) / 16.0 + i % 1024 / 1024.0;
+      if (std::abs(data[0][i] / n - expected) > 1e-5) mean = false;
+    }
+    ASSERT(mean)
+  }
+
+  TEST_END()
+}
+
 void test_eigen_matrix()
 {
   TEST_BEGIN("Matrix Map")  
@@ -440,6 +1018,136 @@ void test_eigen_matrix()
   TEST_END()
 }
 
+void test_tensor_precision()
+{
+  TEST_BEGIN("Tensor Precision")
+
+  Tensor A = Tensor::Random(8, 16);
+  Tensor B = 1e-6 * Tensor::Random(8, 16);
+
+  std::stringstream store;
+
+  write_tensor(A, store, BF16);
+  write_tensor(A, store, FP16);
+  write_tensor(B, store, FP16);
+  ASSERT(store.str().size() == 3 * (8 + 8 * 16 * 2) + 2 * sizeof(DTYPE))
+
+  // bf16 keeps 8 bits of mantissa, fp16 keeps 11 bits
+  ASSERT((read_tensor(store, BF16) - A).cwiseAbs().maxCoeff() < 4e-3)
+  ASSERT((read_tensor(store, FP16) - A).cwiseAbs().maxCoeff() < 5e-4)
+
+  // scaled fp16 keeps small updates
+  ASSERT((read_tensor(store, FP16) - B).cwiseAbs().maxCoeff() < 5e-10)
+
+  // weights payload carries its precision
+  class Model : public Training
+  {
+  public:
+    Model() : Training(0) { graph().new_variable(8, 16); }
+    void batch_train() {}
+  };
+
+  Model model;
+  model.precision(BF16);
+  auto weights = model.get_weights();
+  ASSERT(weights_precision(weights) == BF16)
+  ASSERT(weights_precision(model.get_weights(FP32)) == FP32)
+  ASSERT(weights.size() < model.get_weights(FP32).size() / 2 + 16)
+
+  Model copy;
+  copy.set_weights(weights);
+  ASSERT(copy.get_weights(BF16) == weights)
+
+  TEST_END()
+}
+
+
+void test_compute_backend()
+{
+  TEST_BEGIN("Compute Backend")
+
+  Tensor A = Tensor::Random(5, 7);
+  Tensor B = Tensor::Random(7, 3);
+  Tensor Bt = B.transpose();
+  Tensor At = A.transpose();
+  Tensor D = Tensor::Random(5, 3);
+
+  SparseTensor S = Tensor::Random(3, 7).sparseView(0.5);
+
+  ASSERT(std::string(kernel_isa()).size() > 0)
+
+  auto names = backends();
+  ASSERT(names.front() == "eigen")
+
+  // device backends run only on request
+  std::string active = backend().name();
+  if (!std::getenv("SEEGNIFY_BACKEND"))
+  {
+    ASSERT(active != "cuda")
+  }
+
+  for (auto& name: names)
+  {
+    // device backends are built in without a device on this host
+    try { backend(name); } catch (std::exception& e) { continue; }
+    auto& be = backend();
+    ASSERT(be.name() == name)
+
+    // products of transposed operands
+    Tensor C, C2, C3, C4;
+    be.gemm(A, false, B, false, C);
+    be.gemm(At, true, B, false, C2);
+    be.gemm(A, false, Bt, true, C3);
+    be.gemm(At, true, Bt, true, C4);
+    Tensor AB = A * B;
+    ASSERT(C.isApprox(AB, 0.0001))
+    ASSERT(C2.isApprox(AB, 0.0001))
+    ASSERT(C3.isApprox(AB, 0.0001))
+    ASSERT(C4.isApprox(AB, 0.0001))
+
+    // scaled accumulation
+    Tensor E = D;
+    be.gemm(A, false, B, false, E, 2, 3);
+    ASSERT(E.isApprox(2 * AB + 3 * D, 0.0001))
+
+    // batch of products
+    std::vector<const Tensor*> a = { &A, &A };
+    std::vector<const Tensor*> b = { &B, &B };
+    std::vector<Tensor*> c = { &C, &C2 };
+    be.gemm_batch(a, false, b, false, c);
+    ASSERT(C.isApprox(AB, 0.0001))
+    ASSERT(C2.isApprox(AB, 0.0001))
+
+    // dense and sparse products
+    Tensor Sdt = Tensor(S).transpose();
+    SparseTensor St = S.transpose();
+    be.spmm(A, S, true, C);
+    be.spmm(A, St, false, C2);
+    ASSERT(C.isApprox(A * Sdt, 0.0001))
+    ASSERT(C2.isApprox(A * Sdt, 0.0001))
+
+    // elementwise map and reduction
+    Tensor y = D;
+    be.axpy(0.5, AB, y);
+    ASSERT(y.isApprox(D + 0.5 * AB, 0.0001))
+    Tensor x = Tensor::Random(37, 11);
+    ASSERT(std::abs(be.sum(x) - x.sum()) < 0.001)
+
+    // mismatched shapes
+    bool thrown = false;
+    try { be.gemm(A, false, A, false, C); }
+    catch (std::exception& e) { thrown = true; }
+    ASSERT(thrown)
+  }
+  backend(active);
+
+  bool thrown = false;
+  try { backend("unknown"); } catch (std::exception& e) { thrown = true; }
+  ASSERT(thrown)
+  ASSERT(backend().name() == active)
+
+  TEST_END()
+}
 void test_random_numbers()
 {
   TEST_BEGIN("Random Choice")
@@ -481,6 +1189,54 @@ void test_random_numbers()
   TEST_END()
 }
 
+void test_philox()
+{
+  TEST_BEGIN("Philox Generator")
+
+  // known answer of Philox4x32-10 for zero key and counter
+  uint32_t w[4];
+  Philox(0, 0).block(0, w);
+  ASSERT(w[0] == 0x6627e8d5 && w[1] == 0xe169c58d)
+  ASSERT(w[2] == 0xbc57ac4c && w[3] == 0x9b00dbd8)
+
+  // blocks fill in any order
+  int N = 1000;
+  Philox philox(12345, 7, 3);
+  std::vector<float> a(N), b(N);
+  philox.uniform(a.data(), N);
+  philox.uniform(b.data() + 501, N - 501, 501);
+  philox.uniform(b.data(), 501);
+  ASSERT(a == b)
+
+  // streams and steps differ
+  Philox(12345, 8, 3).uniform(b.data(), N);
+  ASSERT(a != b)
+  Philox(12345, 7, 4).uniform(b.data(), N);
+  ASSERT(a != b)
+
+  // uniform and normal moments
+  Tensor u(100, 1000), n(100, 1000);
+  philox.uniform(u.data(), u.size());
+  philox.normal(n.data(), n.size(), 1, 2);
+  ASSERT(u.minCoeff() >= 0 && u.maxCoeff() < 1)
+  ASSERT(std::abs(u.mean() - 0.5) < 0.01)
+  ASSERT(std::abs(n.mean() - 1) < 0.02)
+  ASSERT(std::abs(std::sqrt((n.array() - n.mean()).square().mean()) - 2) < 0.02)
+
+  // nodes of equally seeded graphs draw the same values
+  Graph g1, g2;
+  g1.random().seed(42);
+  g2.random().seed(42);
+  auto& x1 = *g1.new_variable(10, 20);
+  auto& x2 = *g2.new_variable(10, 20);
+  auto& y1 = *g1.new_dropout(x1, 0.5);
+  auto& y2 = *g2.new_dropout(x2, 0.5);
+  ASSERT(x1() == x2())
+  ASSERT(y1() == y2())
+
+  TEST_END()
+}
+
 void test_discount_reward()
 {
   TEST_BEGIN("Discount Reward")
@@ -760,79 +1516,922 @@ void test_back_propagation()
   TEST_END()
 }
 
-void test_broadcast_forward()
+void test_compiled_plan()
 {
-  TEST_BEGIN("Broadcast Forward")
-  Graph g;
+  TEST_BEGIN("Compiled Plan")
 
   // size
-  int IN = 2;
+  int IN = 3;
+  int OUT = 4;
+  Graph g;
 
-  // x vector
-  Constant x(g, IN, 1);
-  x.value() << 1, 2;
-  ASSERT(x.forward().rows() == IN);
-  ASSERT(x.forward().cols() == 1);
+  // network
+  auto& x = *g.new_variable(1, IN);
+  auto& y = *g.new_linear(x, IN, OUT);
+  auto& loss = *g.new_sum(*g.new_tanh(y) * *g.new_sigmoid(y));
 
-  // y scalar
-  Constant s(g, 1,1);
-  s.value() << 3.3;
-  Broadcast y(g, s, x);
-  ASSERT(y.forward().rows() == IN);
-  ASSERT(y.forward().cols() == 1);
+  // unreachable branch
+  auto& z = *g.new_softmax(x);
 
-  // y_hat
-  Tensor y_hat(IN, 1);
-  y_hat << 3.3, 3.3;
-  ASSERT(y_hat == y.forward());
+  auto& W = y.W();
+  auto& b = y.b();
 
-  // z vector
-  Variable z(g, IN, 1);
-  z.value() << 3,4;
-  ASSERT(z.forward().rows() == IN);
-  ASSERT(z.forward().cols() == 1);
+  // compile plan
+  auto& plan = *g.compile(loss);
+  auto& nodes = plan.nodes();
+  ASSERT(&plan.output() == &loss)
+  ASSERT(nodes.back() == &loss)
+  ASSERT(std::find(nodes.begin(), nodes.end(), &z) == nodes.end())
+  ASSERT(std::find(nodes.begin(), nodes.end(), &W) == nodes.end())
 
-  // v matrix
-  Variable v(g, IN, IN);
-  v.value() << 1,2,
-               3,4;
-  ASSERT(v.forward().rows() == IN);
-  ASSERT(v.forward().cols() == IN);
+  for (int i=0; i<2; i++)
+  {
+    x.value() = Tensor::Random(1, IN);
 
-  // b broadcast
-  Broadcast b(g, z, v);
-  ASSERT(b.forward().rows() == IN);
-  ASSERT(b.forward().cols() == IN);
+    // lazy forward and backward
+    g.recache();
+    g.backward(loss, Tensor::Ones(1,1));
+    Tensor loss_hat = loss.forward();
+    Tensor dW_hat = W.gradient();
+    Tensor db_hat = b.gradient();
+    Tensor dx_hat = x.gradient();
+    g.zero_grad();
 
-  Function& vb = v + b;
+    // compiled forward and backward
+    auto& F = plan.forward();
+    plan.backward(Tensor::Ones(1,1));
 
-  // vs_hat
-  Tensor vb_hat(IN, IN);
-  vb_hat << 1+3, 2+3,
-            3+4, 4+4;
-  ASSERT(vb_hat == vb.forward());
+    ASSERT(F.isApprox(loss_hat))
+    ASSERT(W.gradient().isApprox(dW_hat))
+    ASSERT(b.gradient().isApprox(db_hat))
+    ASSERT(x.gradient().isApprox(dx_hat))
+    g.zero_grad();
+  }
+
+  // lazy API keeps working after compiled passes
+  g.recache();
+  ASSERT(z.forward().size() == IN)
 
   TEST_END()
 }
 
-void test_broadcast_backward()
+void test_plan_memory()
 {
-  TEST_BEGIN("Broadcast Backward")
-  Graph g;
+  TEST_BEGIN("Plan Memory")
 
   // size
-  int ROWS = 2;
-  int COLS = 3;
+  int N = 16;
+  int DEPTH = 8;
+  Graph g;
 
-  // x vector
-  auto& x = *g.new_variable(1, COLS);
-  x.value() << 1, 2, 3;
-  ASSERT(x.forward().rows() == 1);
-  ASSERT(x.forward().cols() == COLS);
+  // deep chain of equal size nodes
+  auto& x = *g.new_variable(1, N);
+  Function* y = &x;
+  for (int i=0; i<DEPTH; i++) y = g.new_tanh(*y);
+  auto& hidden = *y;
+  auto& loss = *g.new_sum(hidden);
+
+  // compile plan
+  auto& plan = *g.compile(loss);
+
+  // lazy forward and backward
+  g.recache();
+  g.backward(loss, Tensor::Ones(1,1));
+  Tensor loss_hat = loss.forward();
+  Tensor dx_hat = x.gradient();
+  g.zero_grad();
+
+  // compiled forward and backward
+  plan.forward();
+  plan.backward(Tensor::Ones(1,1));
+  auto data = hidden.value().data();
+  g.zero_grad();
+
+  // values are recomputed in place
+  auto& F = plan.forward();
+  plan.backward(Tensor::Ones(1,1));
+  ASSERT(hidden.value().data() == data)
+  ASSERT(F.isApprox(loss_hat))
+  ASSERT(x.gradient().isApprox(dx_hat))
+
+  // chain buffers are shared by disjoint lifetimes
+  ASSERT(plan.memory() > 0)
+  ASSERT(plan.memory() < DEPTH * N * sizeof(DTYPE))
+
+  // intermediate gradients are released after last use
+  ASSERT(hidden.gradient().size() == 0)
 
-  // v matrix
-  auto& v = *g.new_variable(ROWS, COLS);
-  v.value() << 4,5,6,
+  TEST_END()
+}
+
+void test_plan_shapes()
+{
+  TEST_BEGIN("Plan Shapes")
+
+  // size
+  int N = 4;
+  int IN = 3;
+  int OUT = 5;
+
+  // incompatible shapes are reported when compiled, naming the node
+  {
+    Graph g;
+    auto& x = *g.new_constant(N, IN);
+    x.value() = Tensor::Random(N, IN);
+    auto& y = *g.new_linear(x, IN + 1, OUT);
+    auto& loss = *g.new_sum(y);
+
+    try
+    {
+      g.compile(loss);
+      ASSERT(false)
+    }
+    catch (std::runtime_error& e)
+    {
+      std::string what = e.what();
+      ASSERT(what.find("Product") != std::string::npos)
+      ASSERT(what.find("4x3") != std::string::npos)
+    }
+
+    // and by lazy evaluation
+    try
+    {
+      g.recache();
+      loss.forward();
+      ASSERT(false)
+    }
+    catch (std::runtime_error& e) {}
+  }
+
+  // constant without shape
+  {
+    Graph g;
+    auto& x = *g.new_constant();
+    auto& loss = *g.new_sum(*g.new_linear(x, IN, OUT));
+
+    try
+    {
+      g.compile(loss);
+      ASSERT(false)
+    }
+    catch (std::runtime_error& e)
+    {
+      ASSERT(std::string(e.what()).find("0x0") != std::string::npos)
+    }
+  }
+
+  // first compiled pass allocates no buffers
+  Graph g;
+  auto& x = *g.new_constant(N, IN);
+  x.value() = Tensor::Random(N, IN);
+  auto& h = *g.new_tanh(*g.new_linear(x, IN, OUT));
+  auto& y = *g.new_split(h, 0, 1, N, OUT - 1);
+  auto& loss = *g.new_sum(*g.new_sigmoid(y) * y);
+
+  auto& plan = *g.compile(loss);
+  for (auto e: plan.nodes())
+  {
+    ASSERT(e->value().size() > 0)
+  }
+  for (auto v: g.variables())
+  {
+    ASSERT(v->gradient().size() == v->value().size())
+  }
+
+  Profiler profiler(g);
+  plan.forward();
+  plan.backward(Tensor::Ones(1,1));
+  for (auto& e: profiler.records())
+  {
+    ASSERT(e.allocated == 0)
+  }
+
+  // the same gradients as lazy passes
+  std::vector<Tensor> grads;
+  for (auto v: g.variables()) grads.push_back(v->gradient());
+  g.zero_grad();
+  g.recache();
+  g.backward(loss, Tensor::Ones(1,1));
+  for (int i=0; i<grads.size(); i++)
+  {
+    ASSERT(g.variables()[i]->gradient().isApprox(grads[i]))
+  }
+
+  TEST_END()
+}
+
+void test_minibatch()
+{
+  TEST_BEGIN("Minibatch")
+
+  // size
+  int N = 3;
+  int IN = 16;
+  int OUT = 4;
+  Graph g;
+
+  // batched network
+  auto& x = *g.new_constant(N, IN);
+  auto& y_hat = *g.new_constant(N, OUT);
+  auto& y = *g.new_linear(x, IN, OUT);
+  auto& c = *g.new_conv2d(x, 4, 4, 1, 1, 3, 3);
+  auto& n = *g.new_norm(y, 1, OUT);
+  auto& s = *g.new_softmax(y, ROWWISE);
+  auto& ls = *g.new_log_softmax(n, ROWWISE);
+  auto& loss = *g.new_sum(-y_hat * ls) + *g.new_sum(c);
+
+  // single sample network with shared weights
+  auto& x1 = *g.new_constant(1, IN);
+  auto& y1_hat = *g.new_constant(1, OUT);
+  auto& y1 = *g.new_linear(x1, y);
+  auto& c1 = *g.new_conv2d(x1, c);
+  auto& n1 = *g.new_norm(y1, n);
+  auto& s1 = *g.new_softmax(y1);
+  auto& ls1 = *g.new_log_softmax(n1);
+  auto& loss1 = *g.new_sum(-y1_hat * ls1) + *g.new_sum(c1);
+
+  x.value() = Tensor::Random(N, IN);
+  y_hat.value() = Tensor::Zero(N, OUT);
+  for (int i=0; i<N; i++) y_hat.value()(i, i % OUT) = 1;
+
+  // per-sample passes
+  Tensor s_hat(N, OUT), ls_hat(N, OUT), c_hat(N, c.forward().cols());
+  for (int i=0; i<N; i++)
+  {
+    g.recache();
+    x1.value() = x.value().row(i);
+    y1_hat.value() = y_hat.value().row(i);
+    s_hat.row(i) = s1.forward();
+    ls_hat.row(i) = ls1.forward();
+    c_hat.row(i) = c1.forward();
+    g.backward(loss1, Tensor::Ones(1,1));
+  }
+  Tensor dW_hat = y.W().gradient();
+  Tensor dK_hat = c.K().gradient();
+  Tensor dA_hat = n.A().gradient();
+  g.zero_grad();
+
+  // batched pass
+  g.recache();
+  g.backward(loss, Tensor::Ones(1,1));
+  ASSERT(s.forward().isApprox(s_hat))
+  ASSERT(ls.forward().isApprox(ls_hat))
+  ASSERT(c.forward().isApprox(c_hat))
+  ASSERT(y.W().gradient().isApprox(dW_hat, 0.001))
+  ASSERT(c.K().gradient().isApprox(dK_hat, 0.001))
+  ASSERT(n.A().gradient().isApprox(dA_hat, 0.001))
+
+  // row-wise softmax gradient
+  auto& z = *g.new_variable(N, OUT);
+  auto& sz = *g.new_softmax(z, ROWWISE);
+  sz.forward();
+  sz.gradient() = Tensor::Random(N, OUT);
+  Tensor dz = z.backward();
+  ASSERT(dz.isApprox(g.dFdX(sz, z), 0.01))
+
+  TEST_END()
+}
+
+void test_axis_reduction()
+{
+  TEST_BEGIN("Axis Reduction")
+
+  // size
+  int ROWS = 3;
+  int COLS = 4;
+  Graph g;
+
+  auto& x = *g.new_variable(ROWS, COLS);
+  x.value() = Tensor::Random(ROWS, COLS);
+  auto& X = x.value();
+
+  // native reductions
+  ASSERT(g.new_sum(x, ROWWISE)->forward().isApprox(X.rowwise().sum()))
+  ASSERT(g.new_sum(x, COLWISE)->forward().isApprox(X.colwise().sum()))
+  ASSERT(g.new_mean(x, ROWWISE)->forward().isApprox(X.rowwise().mean()))
+  ASSERT(g.new_mean(x, COLWISE)->forward().isApprox(X.colwise().mean()))
+  ASSERT(g.new_maximum(x, ROWWISE)->forward() == X.rowwise().maxCoeff())
+  ASSERT(g.new_maximum(x, COLWISE)->forward() == X.colwise().maxCoeff())
+  ASSERT(g.new_maximum(x)->forward()(0,0) == X.maxCoeff())
+
+  // gradients
+  std::vector<Function*> reductions = {
+    g.new_sum(x, ROWWISE), g.new_mean(x, COLWISE), g.new_maximum(x, ROWWISE)
+  };
+  for (auto r: reductions)
+  {
+    auto& w = *g.new_constant(r->forward().rows(), r->forward().cols());
+    w.value() = Tensor::Random(w.value().rows(), w.value().cols());
+    auto& f = *g.new_sum(w * *r);
+
+    g.recache();
+    g.zero_grad();
+    g.backward(f, Tensor::Ones(1,1));
+    ASSERT(x.gradient().isApprox(g.dFdX(f, x), 0.01))
+  }
+
+  // row blocks map to native ops
+  auto size = g.nodes().size();
+  auto& s = *g.new_rowwise(x, ROWS, COLS, [&](Function& row) {
+    return g.new_softmax(row);
+  });
+  auto& n = *g.new_rowwise(x, ROWS, COLS,
+    [&](Function& row) { return g.new_norm(row, 1, COLS); },
+    [&](Function& row, Function& shared) {
+      return g.new_norm(row, (Norm&)shared);
+    });
+  ASSERT(g.nodes().size() - size < 60) // independent of ROWS
+  ASSERT(g.variables().size() == 3)
+
+  Tensor s_hat(ROWS, COLS), n_hat(ROWS, COLS);
+  for (int r=0; r<ROWS; r++)
+  {
+    Tensor e = (X.row(r).array() - X.row(r).maxCoeff()).exp();
+    s_hat.row(r) = e / e.sum();
+
+    Tensor m = X.row(r).array() - X.row(r).mean();
+    n_hat.row(r) = m / sqrt(m.array().square().mean() + EPSILON);
+  }
+  ASSERT(s.forward().isApprox(s_hat))
+  ASSERT(n.forward().isApprox(n_hat))
+
+  TEST_END()
+}
+
+void test_invalidate_from()
+{
+  TEST_BEGIN("Invalidate From")
+
+  // size
+  int N = 3;
+  int IN = 4;
+  int OUT = 2;
+  Graph g;
+
+  auto& x = *g.new_constant(N, IN);
+  auto& W = *g.new_variable(OUT, IN);
+  auto& W_T = *g.new_transpose(W);
+  auto& y = *g.new_tanh(*g.new_product(x, W_T));
+  auto& loss = *g.new_sum(y);
+
+  // mutable access advances the version
+  auto version = x.version();
+  x.value() = Tensor::Random(N, IN);
+  W.value() = Tensor::Random(OUT, IN);
+  ASSERT(x.version() > version)
+
+  // reads keep the version, touch advances it
+  version = x.version();
+  const Function& cx = x;
+  ASSERT(cx.value().size() == N * IN)
+  ASSERT(x.version() == version)
+  x.touch();
+  ASSERT(x.version() == version + 1)
+
+  g.backward(loss, Tensor::Ones(1,1));
+  g.zero_grad();
+
+  // new input recomputes input dependent nodes only
+  x.value() = Tensor::Random(N, IN);
+  g.invalidate_from(x);
+  ASSERT(W_T.value().size() > 0)
+  ASSERT(y.value().size() == 0)
+
+  g.backward(loss, Tensor::Ones(1,1));
+  Tensor y_inv = y.forward();
+  Tensor dW_inv = W.gradient();
+
+  // full recache
+  g.zero_grad();
+  g.recache();
+  g.backward(loss, Tensor::Ones(1,1));
+  ASSERT(y.forward() == y_inv)
+  ASSERT(W.gradient() == dW_inv)
+
+  TEST_END()
+}
+
+void test_plan_fusion()
+{
+  TEST_BEGIN("Plan Fusion")
+
+  // size
+  int N = 3;
+  int IN = 5;
+  int OUT = 4;
+  Graph g;
+
+  // gemm + bias + activation
+  auto& x = *g.new_variable(N, IN);
+  auto& h = *g.new_tanh(*g.new_linear(x, IN, OUT));
+  auto& z = *g.new_relu(*g.new_linear(h, OUT, OUT));
+
+  // scale + mask + softmax
+  auto& V = *g.new_variable(OUT, OUT);
+  auto& mask = *g.new_constant(N, OUT);
+  mask.value() = Tensor::Random(N, OUT);
+  auto& a = *g.new_product(z, *g.new_transpose(V));
+  auto& s = *g.new_softmax(a / 2 + mask, ROWWISE);
+
+  // elementwise chain
+  auto& c = *g.new_sigmoid(*g.new_tanh(3 * s + 1));
+  auto& loss = *g.new_sum(c) + *g.new_sum(h);
+
+  // compile and fuse
+  auto& plan = *g.compile(loss);
+  int size = plan.nodes().size();
+  ASSERT(plan.fuse() == 5)
+  ASSERT(plan.nodes().size() < size)
+
+  for (int i=0; i<2; i++)
+  {
+    x.value() = Tensor::Random(N, IN);
+
+    // lazy forward and backward
+    g.recache();
+    g.backward(loss, Tensor::Ones(1,1));
+    Tensor loss_hat = loss.forward();
+    Tensor dx_hat = x.gradient();
+    Tensor dV_hat = V.gradient();
+    std::vector<Tensor> dvars;
+    for (auto v: g.variables()) dvars.push_back(v->gradient());
+    g.zero_grad();
+
+    // fused forward and backward
+    auto& F = plan.forward();
+    plan.backward(Tensor::Ones(1,1));
+
+    ASSERT(F.isApprox(loss_hat))
+    ASSERT(x.gradient().isApprox(dx_hat, 0.0001))
+    ASSERT(V.gradient().isApprox(dV_hat, 0.0001))
+    for (int k=0; k<dvars.size(); k++)
+    {
+      ASSERT(g.variables()[k]->gradient().isApprox(dvars[k], 0.0001))
+    }
+    g.zero_grad();
+  }
+
+  TEST_END()
+}
+
+void test_plan_threads()
+{
+  TEST_BEGIN("Plan Threads")
+
+  // size
+  int N = 4;
+  int IN = 8;
+  int OUT = 6;
+  int HEADS = 4;
+  Graph g;
+
+  // independent heads joined at the output
+  auto& x = *g.new_variable(N, IN);
+  Function* y = nullptr;
+  for (int h=0; h<HEADS; h++)
+  {
+    auto& q = *g.new_linear(x, IN, OUT);
+    auto& k = *g.new_linear(x, IN, OUT);
+    auto& a = *g.new_softmax(*g.new_product(q, *g.new_transpose(k)), ROWWISE);
+    auto& head = *g.new_tanh(*g.new_product(a, x));
+    y = (y) ? &(*y + head) : &head;
+  }
+  auto& loss = *g.new_sum(*y);
+
+  // sequential plan as reference
+  auto& serial = *g.compile(loss);
+  auto& parallel = *g.compile(loss);
+  parallel.threads(4);
+
+  for (int i=0; i<3; i++)
+  {
+    x.value() = Tensor::Random(N, IN);
+
+    Tensor loss_hat = serial.forward();
+    serial.backward(Tensor::Ones(1,1));
+    std::vector<Tensor> dvars;
+    for (auto v: g.variables()) dvars.push_back(v->gradient());
+    g.zero_grad();
+
+    // fused kernels are scheduled like any other node
+    if (i == 1)
+    {
+      ASSERT(parallel.fuse() > 0)
+    }
+
+    auto& F = parallel.forward();
+    parallel.backward(Tensor::Ones(1,1));
+
+    ASSERT(F.isApprox(loss_hat))
+    // key bias gradients vanish under softmax, compare absolute error
+    for (int k=0; k<dvars.size(); k++)
+    {
+      ASSERT((g.variables()[k]->gradient() - dvars[k]).norm() < 0.0001)
+    }
+    g.zero_grad();
+  }
+
+  TEST_END()
+}
+
+void test_unroll()
+{
+  TEST_BEGIN("Recurrent Unroll")
+
+  int N = 3; // state size
+  int T = 5; // steps
+  int W = 2; // window
+
+  Tensor X = Tensor::Random(T, N);
+  Tensor h0 = Tensor::Random(1, N);
+
+  // h(t) = Tanh(x(t) + h(t-1) * U) over window of slots sharing U
+  auto model = [&](Graph& g, Variable*& U, std::vector<Constant*>& x,
+  std::vector<Function*>& y, int window, const Tensor& h)
+  {
+    U = g.new_variable(N, N);
+    U->value() = Tensor::Random(N, N);
+    auto step = [&](int t, const std::vector<Function*>& state)
+    {
+      x.push_back(g.new_constant(1, N));
+      y.push_back(g.new_tanh(*x.back() + *g.new_product(*state[0], *U)));
+      return std::vector<Function*>{ y.back() };
+    };
+    return new Unroll(g, window, { h }, step);
+  };
+
+  // full unroll over all steps
+  Graph f;
+  Variable* Uf;
+  std::vector<Constant*> xf;
+  std::vector<Function*> yf;
+  Unroll* full = model(f, Uf, xf, yf, T, h0);
+  for (int t=0; t<T; t++) xf[t]->value() = X.row(t);
+
+  // ring of W slots carries state across windows
+  Graph g;
+  Variable* U;
+  std::vector<Constant*> x;
+  std::vector<Function*> y;
+  Unroll* ring = model(g, U, x, y, W, h0);
+  U->value() = Uf->value();
+  ASSERT(ring->window() == W && y.size() == W)
+
+  std::vector<std::vector<Tensor>> states;
+  for (int t=0; t<T; t++)
+  {
+    int s = ring->slot(t);
+    if (t > 0 && s == 0) ring->advance();
+    if (s == 0) states.push_back(ring->state());
+    x[s]->value() = X.row(t);
+    ASSERT(y[s]->forward().isApprox(yf[t]->forward(), 0.0001))
+  }
+  ASSERT(states.size() == 3)
+
+  // truncated gradient of the window ignores earlier steps
+  ring->state(states[1]);
+  for (int s=0; s<W; s++) x[s]->value() = X.row(W + s);
+  g.backward(*y[1], Tensor::Ones(1, N));
+
+  Graph d;
+  Variable* Ud;
+  std::vector<Constant*> xd;
+  std::vector<Function*> yd;
+  Unroll* detached = model(d, Ud, xd, yd, W, states[1][0]);
+  Ud->value() = U->value();
+  for (int s=0; s<W; s++) xd[s]->value() = X.row(W + s);
+  d.backward(*yd[1], Tensor::Ones(1, N));
+  ASSERT(U->gradient().isApprox(Ud->gradient(), 0.0001))
+
+  // restart from initial state
+  ring->reset();
+  x[0]->value() = X.row(0);
+  ASSERT(y[0]->forward().isApprox(yf[0]->forward(), 0.0001))
+
+  delete full;
+  delete ring;
+  delete detached;
+
+  TEST_END()
+}
+
+void test_checkpoint()
+{
+  TEST_BEGIN("Gradient Checkpoint")
+
+  int LAYERS = 4;
+  int SIZE = 8;
+
+  // equally seeded graphs, the second one checkpointed
+  Graph g1, g2;
+  g1.random().seed(42);
+  g2.random().seed(42);
+
+  auto& x1 = *g1.new_constant(3, SIZE);
+  auto& x2 = *g2.new_constant(3, SIZE);
+  x1.value() = Tensor::Random(3, SIZE);
+  x2.value() = x1.value();
+
+  Function* y1 = &x1;
+  Function* y2 = &x2;
+  std::vector<GradientCheckpoint*> c;
+  for (int i=0; i<LAYERS; i++)
+  {
+    y1 = g1.new_dropout(*g1.new_tanh(*g1.new_linear(*y1, SIZE, SIZE)), 0.2);
+    y2 = g2.new_dropout(*g2.new_tanh(*g2.new_linear(*y2, SIZE, SIZE)), 0.2);
+    c.push_back(g2.new_checkpoint(*y2));
+    y2 = c.back();
+  }
+
+  auto& f1 = *g1.new_sum(*y1 * *y1);
+  auto& f2 = *g2.new_sum(*y2 * *y2);
+
+  // segments of equal layers end at the previous checkpoint
+  auto& s1 = c[1]->segment();
+  ASSERT(c[0]->segment().size() == s1.size())
+  ASSERT(std::find(s1.begin(), s1.end(), c[0]) == s1.end())
+  ASSERT(s1.back() == c[1]->inputs()[0])
+
+  auto& v1 = g1.variables();
+  auto& v2 = g2.variables();
+
+  for (int pass=0; pass<2; pass++)
+  {
+    g1.recache();
+    g2.recache();
+    g1.zero_grad();
+    g2.zero_grad();
+
+    // segment values are released after forward
+    ASSERT(f1() == f2())
+    for (auto e: c[1]->segment())
+    {
+      ASSERT(e->value().size() == 0)
+    }
+
+    // recomputed segments repeat dropout masks
+    g1.backward(f1, Tensor::Ones(1, 1));
+    g2.backward(f2, Tensor::Ones(1, 1));
+    for (int i=0; i<v1.size(); i++)
+    {
+      ASSERT(v1[i]->gradient().isApprox(v2[i]->gradient()))
+    }
+
+    // and released again after backward
+    for (auto e: c[1]->segment())
+    {
+      ASSERT(e->value().size() == 0)
+    }
+  }
+
+  // backward of a variable recomputes released values on demand
+  g1.recache();
+  g2.recache();
+  f1.forward();
+  f1.gradient() = Tensor::Ones(1, 1);
+  f2.forward();
+  f2.gradient() = Tensor::Ones(1, 1);
+  ASSERT(v1[0]->backward().isApprox(v2[0]->backward()))
+
+  TEST_END()
+}
+void test_profiler()
+{
+  TEST_BEGIN("Profiler")
+
+  Graph g;
+  auto& x = *g.new_variable(2, 3);
+  g.scope_push("Encoder");
+  g.scope_push("Layer");
+  auto& y = *g.new_linear(x, 3, 4);
+  g.scope_pop();
+  auto& loss = *g.new_sum(*g.new_tanh(y));
+  g.scope_pop();
+  x.value() = Tensor::Random(2, 3);
+
+  ASSERT(g.profiler() == nullptr)
+  ASSERT(g.scope_name(0) == "")
+  ASSERT(g.scope_name(g.nodes().size() - 1) == "Encoder:")
+
+  auto& plan = *g.compile(loss);
+  {
+    Profiler profiler(g);
+    ASSERT(g.profiler() == &profiler)
+
+    for (int i=0; i<3; i++)
+    {
+      plan.forward();
+      plan.backward(Tensor::Ones(1,1));
+      g.zero_grad();
+    }
+
+    // every planned node evaluated on each pass, nested time excluded
+    auto records = profiler.records();
+    int forward = 0;
+    bool layer = false, derivative = false;
+    for (auto& e: records)
+    {
+      ASSERT(e.count == 3)
+      ASSERT(e.seconds <= e.total_seconds)
+      if (!e.derivative) forward++;
+      derivative |= e.derivative;
+      layer |= (e.scope == "Encoder:Layer" && e.type == "Linear");
+    }
+    ASSERT(forward == plan.nodes().size())
+    ASSERT(layer)
+    ASSERT(derivative)
+
+    // eager backward evaluates derivatives too
+    profiler.clear();
+    g.recache();
+    g.backward(loss, Tensor::Ones(1,1));
+    ASSERT(profiler.records().size() > 0)
+    ASSERT(profiler.records().front().derivative)
+
+    std::ostringstream table, trace;
+    profiler.write_table(table);
+    profiler.write_trace(trace);
+    ASSERT(table.str().find("Encoder:Layer") != std::string::npos)
+    ASSERT(trace.str().find("{\"traceEvents\":[") == 0)
+    ASSERT(trace.str().find("\"cat\":\"derivative\"") != std::string::npos)
+  }
+  ASSERT(g.profiler() == nullptr)
+
+  TEST_END()
+}
+
+void test_no_grad_graph()
+{
+  TEST_BEGIN("No-Grad Graph")
+
+  // size
+  int N = 4;
+  int IN = 8;
+  int OUT = 6;
+  Graph g1, g2;
+  g2.no_grad(true);
+
+  // same network with and without derivatives
+  Function* y[2];
+  Variable* x[2];
+  Graph* g[2] = {&g1, &g2};
+  for (int i=0; i<2; i++)
+  {
+    x[i] = g[i]->new_variable(N, IN);
+    auto& q = *g[i]->new_linear(*x[i], IN, OUT);
+    auto& k = *g[i]->new_linear(*x[i], IN, OUT);
+    auto& a = *g[i]->new_softmax(*g[i]->new_product(q, *g[i]->new_transpose(k)), ROWWISE);
+    y[i] = g[i]->new_sum(*g[i]->new_tanh(*g[i]->new_product(a, *x[i])));
+  }
+
+  for (int k=0; k<g1.variables().size(); k++)
+  {
+    g2.variables()[k]->value() = g1.variables()[k]->value();
+  }
+
+  ASSERT(g2.nodes().size() < g1.nodes().size())
+  for (auto f: g2.nodes())
+  {
+    ASSERT(f->inputs().size() || dynamic_cast<Variable*>(f))
+  }
+
+  // eager and compiled forward
+  auto& plan = *g2.compile(*y[1]);
+  for (int i=0; i<2; i++)
+  {
+    Tensor tx = Tensor::Random(N, IN);
+    x[0]->value() = tx;
+    x[1]->value() = tx;
+    g1.invalidate_from(*x[0]);
+    g2.invalidate_from(*x[1]);
+
+    Tensor y_hat = y[0]->forward();
+    ASSERT(y[1]->forward().isApprox(y_hat))
+    ASSERT(plan.forward().isApprox(y_hat))
+  }
+
+  // no backward pass
+  bool error = false;
+  try { g2.backward(*y[1], Tensor::Ones(1,1)); }
+  catch (std::exception&) { error = true; }
+  ASSERT(error)
+
+  TEST_END()
+}
+
+void test_gradient_aggregation()
+{
+  TEST_BEGIN("Gradient Aggregation")
+
+  // size
+  int N = 3;
+  int M = 4;
+  Graph g;
+
+  // y has one consumer, x has two
+  auto& x = *g.new_variable(N, M);
+  auto& y = *g.new_tanh(x);
+  auto& z = *g.new_mul(y, x);
+  auto& loss = *g.new_sum(z);
+
+  for (int i=0; i<2; i++)
+  {
+    Tensor tx = Tensor::Random(N, M);
+    x.value() = tx;
+    g.recache();
+    g.backward(loss, Tensor::Ones(1,1));
+
+    // dz/dx = tanh(x) + x * (1 - tanh(x)^2)
+    Tensor t = tx.array().tanh();
+    Tensor dx = t.array() + tx.array() * (1 - t.array() * t.array());
+    Tensor dy = tx;
+
+    ASSERT(y.gradient().isApprox(dy))
+    ASSERT(x.gradient().isApprox(dx))
+
+    // repeated backward accumulates
+    g.backward(loss, Tensor::Ones(1,1));
+    ASSERT(x.gradient().isApprox(2 * dx))
+    ASSERT(y.gradient().isApprox(dy))
+    g.zero_grad();
+  }
+
+  TEST_END()
+}
+
+void test_broadcast_forward()
+{
+  TEST_BEGIN("Broadcast Forward")
+  Graph g;
+
+  // size
+  int IN = 2;
+
+  // x vector
+  Constant x(g, IN, 1);
+  x.value() << 1, 2;
+  ASSERT(x.forward().rows() == IN);
+  ASSERT(x.forward().cols() == 1);
+
+  // y scalar
+  Constant s(g, 1,1);
+  s.value() << 3.3;
+  Broadcast y(g, s, x);
+  ASSERT(y.forward().rows() == IN);
+  ASSERT(y.forward().cols() == 1);
+
+  // y_hat
+  Tensor y_hat(IN, 1);
+  y_hat << 3.3, 3.3;
+  ASSERT(y_hat == y.forward());
+
+  // z vector
+  Variable z(g, IN, 1);
+  z.value() << 3,4;
+  ASSERT(z.forward().rows() == IN);
+  ASSERT(z.forward().cols() == 1);
+
+  // v matrix
+  Variable v(g, IN, IN);
+  v.value() << 1,2,
+               3,4;
+  ASSERT(v.forward().rows() == IN);
+  ASSERT(v.forward().cols() == IN);
+
+  // b broadcast
+  Broadcast b(g, z, v);
+  ASSERT(b.forward().rows() == IN);
+  ASSERT(b.forward().cols() == IN);
+
+  Function& vb = v + b;
+
+  // vs_hat
+  Tensor vb_hat(IN, IN);
+  vb_hat << 1+3, 2+3,
+            3+4, 4+4;
+  ASSERT(vb_hat == vb.forward());
+
+  TEST_END()
+}
+
+void test_broadcast_backward()
+{
+  TEST_BEGIN("Broadcast Backward")
+  Graph g;
+
+  // size
+  int ROWS = 2;
+  int COLS = 3;
+
+  // x vector
+  auto& x = *g.new_variable(1, COLS);
+  x.value() << 1, 2, 3;
+  ASSERT(x.forward().rows() == 1);
+  ASSERT(x.forward().cols() == COLS);
+
+  // v matrix
+  auto& v = *g.new_variable(ROWS, COLS);
+  v.value() << 4,5,6,
                7,8,9;
   ASSERT(v.forward().rows() == ROWS);
   ASSERT(v.forward().cols() == COLS);
@@ -1158,6 +2757,78 @@ void test_reshape_backward()
   TEST_END()
 }
 
+void test_shape_views()
+{
+  TEST_BEGIN("Shape Views")
+
+  int ROWS = 4;
+  int HEADS = 3;
+  int HEAD = 2;
+  int COLS = HEADS * HEAD;
+
+  // heads split by column, transposed, flattened and joined back
+  Tensor X = Tensor::Random(ROWS, COLS);
+  Tensor W = Tensor::Random(ROWS, COLS);
+  auto model = [&](Graph& g, Variable& x, bool checkpoint) -> Function&
+  {
+    Function* j = nullptr;
+    for (int h=0; h<HEADS; h++)
+    {
+      auto& head = *g.new_split(x, 0, h * HEAD, ROWS, HEAD);
+      auto& flat = *g.new_reshape(*g.new_transpose(head), 1, ROWS * HEAD);
+      if (j) j = g.new_join(*j, flat, 1, (h + 1) * ROWS * HEAD);
+      else j = &flat;
+    }
+    Function* y = g.new_reshape(*j, ROWS, COLS);
+    if (checkpoint) y = g.new_checkpoint(*y);
+
+    // rows block read again, its gradient adds to the heads
+    auto& w = *g.new_constant(ROWS, COLS);
+    w.value() = W;
+    auto& top = *g.new_split(x, 1, 0, 2, COLS);
+    return *g.new_sum(*g.new_mul(*y, w)) + *g.new_sum(top * top);
+  };
+
+  Graph g1;
+  auto& x1 = *g1.new_variable(ROWS, COLS);
+  x1.value() = X;
+  auto& f1 = model(g1, x1, false);
+  f1.forward();
+  g1.backward(f1, Tensor::Ones(1, 1));
+  Tensor dFdx = x1.gradient();
+
+  // every x element is read by one head transposed back
+  Tensor dFdx_hat = Tensor::Zero(ROWS, COLS);
+  for (int h=0; h<HEADS; h++)
+  {
+    ConstTensorMap Wh(W.data() + h * ROWS * HEAD, HEAD, ROWS);
+    dFdx_hat.middleCols(h * HEAD, HEAD) = Wh.transpose();
+  }
+  dFdx_hat.middleRows(1, 2) += 2 * X.middleRows(1, 2);
+  ASSERT(dFdx.isApprox(dFdx_hat))
+
+  Tensor dFdx_num = g1.dFdX(f1, x1);
+  ASSERT(dFdx.isApprox(dFdx_num, 0.01))
+
+  // compiled passes read view gradients in place
+  auto& plan = *g1.compile(f1);
+  g1.zero_grad();
+  plan.forward();
+  plan.backward(Tensor::Ones(1, 1));
+  ASSERT(x1.gradient().isApprox(dFdx_hat))
+
+  // checkpointed segment keeps view gradients of its input
+  Graph g2;
+  auto& x2 = *g2.new_variable(ROWS, COLS);
+  x2.value() = X;
+  auto& f2 = model(g2, x2, true);
+  f2.forward();
+  g2.backward(f2, Tensor::Ones(1, 1));
+  ASSERT(x2.gradient().isApprox(dFdx_hat))
+
+  TEST_END()
+}
+
 void test_linear_forward()
 {
   TEST_BEGIN("Linear Forward")
@@ -2234,6 +3905,61 @@ void test_softplus_backward()
   TEST_END()
 }
 
+void test_activation_kernels()
+{
+  TEST_BEGIN("Activation Kernels")
+
+  // activations over several kernel blocks
+  int ROWS = 50;
+  int COLS = 60;
+  Graph g;
+
+  Tensor x = 4 * Tensor::Random(ROWS, COLS);
+  Tensor a = x.array() * M_SQRT1_2;
+  auto std_erf = [](DTYPE v) { return (DTYPE)std::erf(v); };
+
+  // expected values and derivatives
+  Tensor erf_hat = x.unaryExpr(std_erf);
+  Tensor derf_hat = M_2_SQRTPI * (-x.array().square()).exp();
+  Tensor gelu_hat = 0.5 * x.array() * (1 + a.unaryExpr(std_erf).array());
+  Tensor dgelu_hat = 0.5 * (1 + a.unaryExpr(std_erf).array()) +
+    x.array() * (-a.array().square()).exp() * M_2_SQRTPI * M_SQRT1_2 / 2;
+  Tensor softplus_hat = (1 + x.array().exp()).log();
+  Tensor dsoftplus_hat = 1 / (1 + (-x).array().exp());
+
+  auto& x_erf = *g.new_variable(ROWS, COLS);
+  auto& x_gelu = *g.new_variable(ROWS, COLS);
+  auto& x_softplus = *g.new_variable(ROWS, COLS);
+  x_erf.value() = x_gelu.value() = x_softplus.value() = x;
+
+  auto& erf = *g.new_erf(x_erf);
+  auto& gelu = *g.new_gelu(x_gelu);
+  auto& softplus = *g.new_softplus(x_softplus);
+
+  // derivatives cached by forward pass
+  ASSERT(erf().isApprox(erf_hat, 1e-5))
+  ASSERT(gelu().isApprox(gelu_hat, 1e-5))
+  ASSERT(softplus().isApprox(softplus_hat, 1e-5))
+
+  erf.gradient() = Tensor::Ones(ROWS, COLS);
+  gelu.gradient() = Tensor::Ones(ROWS, COLS);
+  softplus.gradient() = Tensor::Ones(ROWS, COLS);
+
+  ASSERT(x_erf.backward().isApprox(derf_hat, 1e-5))
+  ASSERT(x_gelu.backward().isApprox(dgelu_hat, 1e-5))
+  ASSERT(x_softplus.backward().isApprox(dsoftplus_hat, 1e-5))
+
+  // derivatives recomputed with new input
+  g.recache();
+  g.zero_grad();
+  x_gelu.value() = Tensor::Constant(ROWS, COLS, 1);
+  g.backward(gelu, Tensor::Ones(ROWS, COLS));
+  ASSERT(x_gelu.gradient().isApprox(
+    Tensor::Constant(ROWS, COLS, 1.0833155), 1e-5))
+
+  TEST_END()
+}
+
 void test_log_softmax_forward()
 {
   TEST_BEGIN("Log Softmax Forward")
@@ -2288,6 +4014,35 @@ void test_log_softmax_backward()
   TEST_END()
 }
 
+void test_softmax_vocabulary_backward()
+{
+  TEST_BEGIN("Softmax Vocabulary Backward")
+
+  // vocabulary size (dense Jacobian would take 4GB)
+  int N = 32000;
+  Graph g;
+
+  auto& z = *g.new_variable(1, N);
+  z.value() = Tensor::Random(1, N);
+
+  auto& y = *g.new_softmax(z);
+  auto& ly = *g.new_log_softmax(z);
+  auto& w = *g.new_constant(1, N);
+  w.value() = Tensor::Random(1, N);
+  auto& F = *g.new_sum(w * y) + *g.new_sum(w * ly);
+
+  g.backward(F, Tensor::Ones(1,1));
+
+  // dFdz_hat = y * (w - dot(w, y)) + w - y * sum(w)
+  auto& Y = y.forward();
+  auto& W = w.value();
+  Tensor dFdz_hat = Y.array() * (W.array() - W.cwiseProduct(Y).sum()) +
+                    W.array() - Y.array() * W.sum();
+  ASSERT(z.gradient().isApprox(dFdz_hat, 0.001))
+
+  TEST_END()
+}
+
 void test_log_forward()
 {
   TEST_BEGIN("Log Forward")
@@ -2848,24 +4603,194 @@ void test_gru_backward()
     -3, 2, -2, -3;
   y.bh().value() << -1,2,-3,-4;
 
-  y.forward();
-  y.gradient() = Tensor::Ones(1, OUT);
-  auto& dydx = x.backward();
-  auto& dydh = h.backward();
+  y.forward();
+  y.gradient() = Tensor::Ones(1, OUT);
+  auto& dydx = x.backward();
+  auto& dydh = h.backward();
+
+  auto dydx_num = g.dFdX(y,x);
+  auto dydh_num = g.dFdX(y,h);
+
+  Tensor dydx_hat(1,IN);
+  Tensor dydh_hat(1,OUT);
+  dydx_hat << 0.2577, 1.6326, 1.7202;
+  dydh_hat << 2.4663,  1.9466,  0.9862, -0.2952;
+
+  ASSERT(dydx.isApprox(dydx_hat, 0.001))
+  ASSERT(dydh.isApprox(dydh_hat, 0.001))
+
+  ASSERT(dydx.isApprox(dydx_num, 0.001))
+  ASSERT(dydh.isApprox(dydh_num, 0.001))
+
+  TEST_END()
+}
+
+void test_gru_sequence()
+{
+  TEST_BEGIN("GRU Sequence")
+
+  // size
+  int IN = 3;
+  int OUT = 4;
+  int T = 3; // steps
+  int B = 1; // batch
+
+  // GRU cells unrolled over steps
+  Graph g;
+  auto& h = *g.new_variable(B, OUT);
+  h.value() = Tensor::Random(B, OUT);
+  Tensor X = Tensor::Random(T * B, IN);
+  Tensor C = Tensor::Random(T * B, OUT);
+
+  std::vector<Variable*> x;
+  GRU* cell = nullptr;
+  Function* y = &h;
+  Function* loss = nullptr;
+  for (int t=0; t<T; t++)
+  {
+    x.push_back(g.new_variable(B, IN));
+    x[t]->value() = X.middleRows(t * B, B);
+    cell = (t == 0) ? g.new_gru(*x[t], *y, IN, OUT) :
+      g.new_gru(*x[t], *y, *cell);
+    y = cell;
+
+    auto& c = *g.new_constant(B, OUT);
+    c.value() = C.middleRows(t * B, B);
+    auto& l = *g.new_sum(*y * c);
+    loss = (loss) ? &(*loss + l) : &l;
+  }
+
+  // fused sequence with variables in the same order
+  Graph s;
+  auto& xs = *s.new_variable(T * B, IN);
+  auto& hs = *s.new_variable(B, OUT);
+  auto& ys = *s.new_gru_sequence(xs, hs, IN, OUT);
+  auto& cs = *s.new_constant(T * B, OUT);
+  auto& ls = *s.new_sum(ys * cs);
+  xs.value() = X;
+  hs.value() = h.value();
+  cs.value() = C;
+
+  auto& vars = g.variables();
+  auto& vars_s = s.variables();
+  for (int i=0; i<9; i++) vars_s[i + 2]->value() = vars[i + 2]->value();
+
+  ASSERT(ys().middleRows((T - 1) * B, B).isApprox((*y)(), 0.0001))
+  ASSERT(ls().isApprox((*loss)(), 0.0001))
+
+  // back-propagation through time matches unrolled cells
+  g.backward(*loss, Tensor::Ones(1, 1));
+  s.backward(ls, Tensor::Ones(1, 1));
+  ASSERT(hs.gradient().isApprox(h.gradient(), 0.001))
+  for (int t=0; t<T; t++)
+  {
+    ASSERT(xs.gradient().middleRows(t * B, B).isApprox(
+      x[t]->gradient(), 0.001))
+  }
+  for (int i=0; i<9; i++)
+  {
+    ASSERT(vars_s[i + 2]->gradient().isApprox(vars[i + 2]->gradient(), 0.001))
+  }
 
-  auto dydx_num = g.dFdX(y,x);
-  auto dydh_num = g.dFdX(y,h);
+  // share variables with GRU cell
+  auto& shared = *g.new_gru_sequence(*x[0], h, *cell);
+  g.recache();
+  ASSERT(shared().isApprox(ys().topRows(B), 0.0001))
+
+  // batch of time-major sequences
+  auto& xb = *s.new_variable(T * 2, IN);
+  auto& hb = *s.new_variable(2, OUT);
+  auto& yb = *s.new_gru_sequence(xb, hb, ys);
+  xb.value() = Tensor::Random(T * 2, IN);
+  hb.value() = Tensor::Random(2, OUT);
+  for (int b=0; b<2; b++)
+  {
+    for (int t=0; t<T; t++) xs.value().row(t) = xb.value().row(t * 2 + b);
+    hs.value() = hb.value().row(b);
+    s.recache();
+    for (int t=0; t<T; t++)
+    {
+      ASSERT(yb().row(t * 2 + b).isApprox(ys().row(t), 0.0001))
+    }
+  }
 
-  Tensor dydx_hat(1,IN);
-  Tensor dydh_hat(1,OUT);
-  dydx_hat << 0.2577, 1.6326, 1.7202;
-  dydh_hat << 2.4663,  1.9466,  0.9862, -0.2952;
+  TEST_END()
+}
 
-  ASSERT(dydx.isApprox(dydx_hat, 0.001))
-  ASSERT(dydh.isApprox(dydh_hat, 0.001))
+void test_lstm_sequence()
+{
+  TEST_BEGIN("LSTM Sequence")
 
-  ASSERT(dydx.isApprox(dydx_num, 0.001))
-  ASSERT(dydh.isApprox(dydh_num, 0.001))
+  // size
+  int IN = 3;
+  int OUT = 4;
+  int T = 3; // steps
+  int B = 1; // batch
+
+  // LSTM cells unrolled over steps
+  Graph g;
+  auto& h = *g.new_variable(B, OUT);
+  auto& c = *g.new_variable(B, OUT);
+  h.value() = Tensor::Random(B, OUT);
+  c.value() = Tensor::Random(B, OUT);
+  Tensor X = Tensor::Random(T * B, IN);
+  Tensor C = Tensor::Random(T * B, OUT);
+
+  std::vector<Variable*> x;
+  LSTM* cell = nullptr;
+  Function* y = &h;
+  Function* state = &c;
+  Function* loss = nullptr;
+  for (int t=0; t<T; t++)
+  {
+    x.push_back(g.new_variable(B, IN));
+    x[t]->value() = X.middleRows(t * B, B);
+    cell = (t == 0) ? g.new_lstm(*x[t], *y, *state, IN, OUT) :
+      g.new_lstm(*x[t], *y, *state, *cell);
+    y = cell;
+    state = &cell->cell();
+
+    auto& k = *g.new_constant(B, OUT);
+    k.value() = C.middleRows(t * B, B);
+    auto& l = *g.new_sum(*y * k);
+    loss = (loss) ? &(*loss + l) : &l;
+  }
+
+  // fused sequence with variables in the same order
+  Graph s;
+  auto& xs = *s.new_variable(T * B, IN);
+  auto& hs = *s.new_variable(B, OUT);
+  auto& cs = *s.new_variable(B, OUT);
+  auto& ys = *s.new_lstm_sequence(xs, hs, cs, IN, OUT);
+  auto& ks = *s.new_constant(T * B, OUT);
+  auto& ls = *s.new_sum(ys * ks);
+  xs.value() = X;
+  hs.value() = h.value();
+  cs.value() = c.value();
+  ks.value() = C;
+
+  auto& vars = g.variables();
+  auto& vars_s = s.variables();
+  for (int i=0; i<12; i++) vars_s[i + 3]->value() = vars[i + 3]->value();
+
+  ASSERT(ys().middleRows((T - 1) * B, B).isApprox((*y)(), 0.0001))
+  ASSERT(ys.cell().middleRows((T - 1) * B, B).isApprox((*state)(), 0.0001))
+  ASSERT(ls().isApprox((*loss)(), 0.0001))
+
+  // back-propagation through time matches unrolled cells
+  g.backward(*loss, Tensor::Ones(1, 1));
+  s.backward(ls, Tensor::Ones(1, 1));
+  ASSERT(hs.gradient().isApprox(h.gradient(), 0.001))
+  ASSERT(cs.gradient().isApprox(c.gradient(), 0.001))
+  for (int t=0; t<T; t++)
+  {
+    ASSERT(xs.gradient().middleRows(t * B, B).isApprox(
+      x[t]->gradient(), 0.001))
+  }
+  for (int i=0; i<12; i++)
+  {
+    ASSERT(vars_s[i + 3]->gradient().isApprox(vars[i + 3]->gradient(), 0.001))
+  }
 
   TEST_END()
 }
@@ -2941,6 +4866,66 @@ void test_norm_backward()
   TEST_END()
 }
 
+void test_norm_fused()
+{
+  TEST_BEGIN("Norm Fused")
+
+  // rows longer than the Welford lanes with a remainder
+  int ROWS = 3;
+  int COLS = 19;
+  DTYPE EPS = 1e-5;
+
+  Graph g;
+
+  // large offset needs the Welford update for accurate variance
+  auto& x = *g.new_variable(ROWS, COLS);
+  x.value() = Tensor::Random(ROWS, COLS) * 10 + Tensor::Constant(ROWS, COLS, 100);
+
+  // row gain normalizes each row
+  auto& R = *g.new_norm(x, 1, COLS, EPS);
+  R.A().value() = Tensor::Random(1, COLS);
+  R.B().value() = Tensor::Random(1, COLS);
+
+  auto& X = x.value();
+  ColVector m = X.rowwise().mean();
+  Tensor D = X.colwise() - m;
+  ColVector s = (D.array().square().rowwise().mean() + EPS).sqrt();
+  Tensor H = D.array().colwise() / s.array();
+  Tensor R_hat = (H.array().rowwise() * R.A().value().row(0).array()).rowwise()
+    + R.B().value().row(0).array();
+  ASSERT(R.forward().isApprox(R_hat, 0.0001))
+
+  // scalar gain normalizes all elements
+  auto& S = *g.new_norm(x, 1, 1, EPS);
+  S.A().value() << 2;
+  S.B().value() << 3;
+
+  DTYPE mean = X.mean();
+  DTYPE var = (X.array() - mean).square().mean();
+  Tensor S_hat = (X.array() - mean) / std::sqrt(var + EPS) * 2 + 3;
+  ASSERT(S.forward().isApprox(S_hat, 0.0001))
+
+  // analytic derivatives of weighted outputs match numerical derivatives,
+  // small offset keeps finite differences of float inputs accurate
+  x.value() = Tensor::Random(ROWS, COLS) * 3 + Tensor::Constant(ROWS, COLS, 5);
+  g.invalidate_from(x);
+
+  auto& w = *g.new_constant(ROWS, COLS);
+  w.value() = Tensor::Random(ROWS, COLS);
+  auto& F = *g.new_sum(*g.new_mul(R + S, w));
+
+  F.forward();
+  F.gradient() = Tensor::Ones(1, 1);
+
+  ASSERT(x.backward().isApprox(g.dFdX(F, x), 0.05))
+  ASSERT(R.A().backward().isApprox(g.dFdX(F, R.A()), 0.05))
+  ASSERT(R.B().backward().isApprox(g.dFdX(F, R.B()), 0.05))
+  ASSERT(S.A().backward().isApprox(g.dFdX(F, S.A()), 0.05))
+  ASSERT(S.B().backward().isApprox(g.dFdX(F, S.B()), 0.05))
+
+  TEST_END()
+}
+
 void test_gaussian_forward()
 {
   TEST_BEGIN("Gaussian Forward")
@@ -3126,6 +5111,133 @@ void test_embedding_backward()
   TEST_END()
 }
 
+void test_sparse_embedding()
+{
+  TEST_BEGIN("Sparse Embedding")
+
+  int IN = 1000; // vocabulary size
+  int OUT = 16; // embedding size
+
+  class Model : public Training
+  {
+  public:
+    Model(bool lazy) : Training(0)
+    {
+      auto& g = graph();
+      _i = g.new_constant(4, 1);
+      _i->value() << 7, 3, 7, 500;
+      _e = g.new_embedding(*_i, 1000, 16);
+      _loss = g.new_sum(*g.new_power(*_e, 2));
+      _opt = new Adam(g.variables(), 0.01);
+      _opt->lazy(lazy);
+    }
+    ~Model() { delete _opt; }
+    void batch_train()
+    {
+      auto& g = graph();
+      g.recache();
+      g.backward(*_loss, Tensor::Ones(1, 1));
+      _opt->update();
+    }
+    Embedding& embedding() { return *_e; }
+    Graph& model() { return graph(); }
+  private:
+    Constant* _i;
+    Embedding* _e;
+    Function* _loss;
+    Optimizer* _opt;
+  };
+
+  Model lazy(true), dense(false);
+  dense.set_weights(lazy.get_weights());
+  lazy.set_weights(lazy.get_weights());
+  auto& E = lazy.embedding().E();
+  Tensor E0 = E.value();
+
+  lazy.batch_train();
+  dense.batch_train();
+
+  // gradient of indexed rows, repeated rows add up
+  ASSERT(E.row_sparse())
+  ASSERT(E.rows() == std::vector<int>({7, 3, 500}))
+  ASSERT(E.gradient().row(7).isApprox(4 * E0.row(7)))
+  ASSERT(E.gradient().row(3).isApprox(2 * E0.row(3)))
+
+  // lazy update touches indexed rows only
+  auto& E_dense = dense.embedding().E().value();
+  for (int r=0; r<IN; r++)
+  {
+    bool indexed = (r == 3 || r == 7 || r == 500);
+    ASSERT(indexed == (E.value().row(r) != E0.row(r)))
+    ASSERT(E.value().row(r).isApprox(E_dense.row(r)))
+  }
+
+  lazy.model().zero_grad();
+  ASSERT(E.rows().empty())
+  ASSERT(E.gradient().isZero())
+
+  // row-sparse increment
+  auto update = lazy.get_update();
+  ASSERT(update.size() < 4 * 8 * OUT + 64)
+
+  Model master(false);
+  master.set_weights(dense.get_weights(FP32));
+  master.embedding().E().value() = E0;
+  master.upd_weights(update);
+  ASSERT(master.embedding().E().value() == E.value())
+
+  TEST_END()
+}
+
+void test_gather_forward()
+{
+  TEST_BEGIN("Gather Forward")
+
+  Graph g;
+
+  auto& x = *g.new_variable(3, 4);
+  auto& i = *g.new_constant(3, 1);
+  x.value() << 1, 2, 3, 4,
+               5, 6, 7, 8,
+               9, 10, 11, 12;
+  i.value() << 2, -1, 0;
+
+  Tensor y_hat(3, 1);
+  y_hat << 3, 0, 9;
+
+  auto& y = *g.new_gather(x, i);
+  ASSERT(y() == y_hat)
+
+  TEST_END()
+}
+
+void test_gather_backward()
+{
+  TEST_BEGIN("Gather Backward")
+
+  Graph g;
+
+  auto& x = *g.new_variable(3, 4);
+  auto& i = *g.new_constant(3, 1);
+  x.value() = Tensor::Random(3, 4);
+  i.value() << 2, -1, 0;
+
+  auto& y = *g.new_gather(x, i);
+  y.forward();
+  y.gradient() = Tensor::Ones(3, 1);
+  y.gradient()(0) = 5;
+
+  Tensor dydx_hat = Tensor::Zero(3, 4);
+  dydx_hat(0, 2) = 5;
+  dydx_hat(2, 0) = 1;
+
+  auto& dydx = x.backward();
+  ASSERT(dydx == dydx_hat)
+  ASSERT(dydx.isApprox(g.dFdX(y, x), 0.01))
+
+  TEST_END()
+}
+
 void test_conv2d_forward()
 {
   TEST_BEGIN("Conv2D Forward Single-Channel")
@@ -3375,76 +5487,455 @@ void test_conv2d_backward()
   int IN = IN_CHANNELS * IN_ROWS * IN_COLS;
   int OUT = OUT_CHANNELS * OUT_ROWS * OUT_COLS;
 
-  // size
-  Graph g;
+  // size
+  Graph g;
+
+  // 2D input, IN_CHANNELS * IN_ROWS, IN_COLS = 4x3;
+  //
+  //  1  2  3 // channel 1
+  //  4  5  6
+  //
+  //  7  8  9 // channel 2
+  // 10 11 12
+
+  // 2D input as vector
+  auto& x = *g.new_variable(1, IN_CHANNELS * IN_ROWS * IN_COLS);
+  // col major
+  //x.value() << 1,4, 2,5, 3,6, 7,10, 8,11, 9,12;
+  // row major
+  x.value() << 1,2,3, 4,5,6, 7,8,9, 10,11,12;
+
+  // 2D conv layer
+  auto& y = *g.new_conv2d(
+    x,
+    IN_ROWS, IN_COLS,
+    IN_CHANNELS, OUT_CHANNELS,
+    K_ROWS, K_COLS,
+    STRIDE, PADDING, DILATION
+  );
+
+  // K, OUT_CHANNELS * K_ROWS, IN_CHANNELS * K_COLS = 6x4
+  //
+  //  1  2    5  6
+  //  3  4    7  8
+  //
+  //  9 10   11 12
+  // 13 14   15 16
+  //
+  // 17 18   19 20
+  // 21 22   23 34
+
+  auto& K = y.K();
+  K.value() << 1, 2,  5, 6,
+               3, 4,  7, 8,
+               9,10, 11,12,
+              13,14, 15,16,
+              17,18, 19,20,
+              21,22, 23,24;
+
+  y.forward();
+  g.backward(y, Tensor::Ones(1, OUT));
+
+  // dFdK
+  Tensor dFdK = K.gradient();
+  ASSERT(dFdK.rows() == OUT_CHANNELS * K_ROWS);
+  ASSERT(dFdK.cols() == IN_CHANNELS * K_COLS);
+
+  // dFdK_hat = x
+  Tensor dFdK_hat = g.dFdX(y, K);
+  ASSERT(dFdK_hat.rows() == OUT_CHANNELS * K_ROWS);
+  ASSERT(dFdK_hat.cols() == IN_CHANNELS * K_COLS);
+  ASSERT(dFdK.isApprox(dFdK_hat, 0.01))
+
+  // dFdx
+  Tensor dFdx = x.gradient();
+  ASSERT(dFdx.rows() == 1);
+  ASSERT(dFdx.cols() == IN);
+
+  // dFdx_hat = K
+  Tensor dFdx_hat = g.dFdX(y, x);
+  ASSERT(dFdx_hat.rows() == 1);
+  ASSERT(dFdx_hat.cols() == IN);
+  ASSERT(dFdx.isApprox(dFdx_hat, 0.01))
+
+  TEST_END()
+}
+
+void test_conv2d_im2col()
+{
+  TEST_BEGIN("Conv2D Im2col")
+
+  // size
+  int BATCH = 2;
+  int IN_ROWS = 5;
+  int IN_COLS = 6;
+  int IN_CHANNELS = 2;
+  int OUT_CHANNELS = 3;
+  int IN = IN_CHANNELS * IN_ROWS * IN_COLS;
+
+  Graph g;
+
+  auto& x = *g.new_variable(BATCH, IN);
+  x.value() = Tensor::Random(BATCH, IN);
+
+  // strides, padding and dilation
+  int options[][3] = {{1,0,1}, {2,1,1}, {1,2,2}, {3,1,2}};
+
+  for (auto& o: options)
+  {
+    auto& y = *g.new_conv2d(x, IN_ROWS, IN_COLS, IN_CHANNELS, OUT_CHANNELS,
+      3, 3, o[0], o[1], o[2]);
+    y.K().value() = Tensor::Random(OUT_CHANNELS * 3, IN_CHANNELS * 3);
+    auto& w = *g.new_constant(BATCH, y().cols());
+    w.value() = Tensor::Random(BATCH, y().cols());
+    auto& f = *g.new_sum(w * y);
+
+    // im2col GEMM
+    g.recache();
+    g.zero_grad();
+    g.backward(f, Tensor::Ones(1,1));
+    Tensor y_gemm = y.forward();
+    Tensor dx_gemm = x.gradient();
+    Tensor dK_gemm = y.K().gradient();
+
+    // sparse kernel matrix
+    y.sparse(true);
+    g.recache();
+    g.zero_grad();
+    g.backward(f, Tensor::Ones(1,1));
+    ASSERT(y.forward().isApprox(y_gemm))
+    ASSERT(x.gradient().isApprox(dx_gemm))
+    ASSERT(y.K().gradient().isApprox(dK_gemm))
+  }
+
+  TEST_END()
+}
+
+void test_attention_forward()
+{
+  TEST_BEGIN("Multi-Head Attention Forward")
+
+  // size
+  int L = 3; // target size
+  int S = 4; // sequence size
+  int E = 6; // embedding size
+  int H = 2; // heads
+  int D = E / H;
+  Graph g;
+
+  auto& q = *g.new_variable(L, E);
+  auto& k = *g.new_variable(S, E);
+  auto& mask = *g.new_constant(L, S);
+  q.value() = Tensor::Random(L, E);
+  k.value() = Tensor::Random(S, E);
+  mask.value() = Tensor::Zero(L, S);
+  mask.value()(0, S-1) = -std::numeric_limits<DTYPE>::infinity();
+
+  auto& self_mask = *g.new_constant(S, S);
+  self_mask.value() = Tensor::Zero(S, S);
+  self_mask.value().triangularView<Eigen::StrictlyUpper>().setConstant(
+    -std::numeric_limits<DTYPE>::infinity());
+
+  auto& self = *g.new_multihead_attention(k, k, k, self_mask, S, S, E, H);
+  auto& cross = *g.new_multihead_attention(q, k, k, mask, L, S, E, H);
+  ASSERT(g.named_variables().count("MHA.Wq.1"))
+
+  // attention of each head computed separately
+  auto attention = [&](MultiHeadAttention& mha, const Tensor& x,
+  const Tensor& y, const Tensor& m)
+  {
+    Tensor Q = x * mha.Wq().value().transpose();
+    Tensor K = y * mha.Wk().value().transpose();
+    Tensor V = y * mha.Wv().value().transpose();
+    Q.rowwise() += mha.bq().value().row(0);
+    K.rowwise() += mha.bk().value().row(0);
+    V.rowwise() += mha.bv().value().row(0);
+
+    Tensor O(x.rows(), E);
+    for (int h=0; h<H; h++)
+    {
+      Tensor P = Q.middleCols(h*D, D) * K.middleCols(h*D, D).transpose();
+      P = (P / std::sqrt(D) + m).array().exp();
+      for (int r=0; r<P.rows(); r++) P.row(r) /= P.row(r).sum();
+      O.middleCols(h*D, D) = P * V.middleCols(h*D, D);
+    }
+
+    Tensor F = O * mha.Wo().value().transpose();
+    F.rowwise() += mha.bo().value().row(0);
+    return F;
+  };
+
+  ASSERT(self().isApprox(
+    attention(self, k.value(), k.value(), self_mask.value()), 0.0001))
+  ASSERT(cross().rows() == L && cross().cols() == E)
+  ASSERT(cross().isApprox(
+    attention(cross, q.value(), k.value(), mask.value()), 0.0001))
+
+  TEST_END()
+}
+
+void test_attention_backward()
+{
+  TEST_BEGIN("Multi-Head Attention Backward")
+
+  // size
+  int L = 2; // target size
+  int S = 3; // sequence size
+  int E = 4; // embedding size
+  int H = 2; // heads
+  Graph g;
+
+  auto& q = *g.new_variable(L, E);
+  auto& k = *g.new_variable(S, E);
+  auto& mask = *g.new_constant(L, S);
+  // scores away from uniform attention for numerical derivatives
+  q.value() = 3 * Tensor::Random(L, E);
+  k.value() = 3 * Tensor::Random(S, E);
+  mask.value() = Tensor::Zero(L, S);
+
+  auto& mha = *g.new_multihead_attention(q, k, k, mask, L, S, E, H);
+
+  mha.forward();
+  mha.gradient() = Tensor::Random(L, E);
+
+  // softmax of scores is invariant to bk
+  Variable* vars[] = { &q, &k, &mha.Wq(), &mha.Wk(), &mha.Wv(), &mha.Wo(),
+    &mha.bq(), &mha.bv(), &mha.bo() };
+  ASSERT(mha.bk().backward().isZero(0.0001))
+
+  std::vector<Tensor> dFdx;
+  for (auto x: vars) dFdx.push_back(x->backward());
+
+  for (int i=0; i<dFdx.size(); i++)
+  {
+    ASSERT(dFdx[i].isApprox(g.dFdX(mha, *vars[i]), 0.01))
+  }
+
+  // self-attention input has one derivative of all projections
+  Graph s;
+  auto& x = *s.new_variable(S, E);
+  auto& m = *s.new_constant(S, S);
+  x.value() = Tensor::Random(S, E);
+  m.value() = Tensor::Zero(S, S);
+
+  auto& self = *s.new_multihead_attention(x, x, x, m, S, S, E, H);
+
+  self.forward();
+  self.gradient() = Tensor::Random(S, E);
+  Tensor dSdx = x.backward();
+  ASSERT(dSdx.isApprox(s.dFdX(self, x), 0.01))
+
+  // inputs must have constructed sizes
+  auto& wrong = *s.new_multihead_attention(x, x, x, m, S + 1, S, E, H);
+  bool error = false;
+  try { wrong.forward(); } catch (std::exception&) { error = true; }
+  ASSERT(error)
+
+  TEST_END()
+}
+
+void test_attention_packed()
+{
+  TEST_BEGIN("Multi-Head Attention Packed")
+
+  // size
+  int E = 4; // embedding size
+  int H = 2; // heads
+  std::vector<int> q_offsets = { 0, 2, 5 };
+  std::vector<int> k_offsets = { 0, 3, 4 };
+  int L = q_offsets.back();
+  int S = k_offsets.back();
+  DTYPE inf = std::numeric_limits<DTYPE>::infinity();
+
+  Graph g;
+
+  auto& q = *g.new_variable(L, E);
+  auto& k = *g.new_variable(S, E);
+  q.value() = Tensor::Random(L, E);
+  k.value() = Tensor::Random(S, E);
+
+  // block-diagonal and causal masks of sequences
+  auto& mask = *g.new_constant(L, S);
+  auto& causal_mask = *g.new_constant(L, L);
+  mask.value() = Tensor::Constant(L, S, -inf);
+  causal_mask.value() = Tensor::Constant(L, L, -inf);
+  for (int i=1; i<q_offsets.size(); i++)
+  {
+    int q0 = q_offsets[i-1], q_rows = q_offsets[i] - q0;
+    int k0 = k_offsets[i-1], k_rows = k_offsets[i] - k0;
+    mask.value().block(q0, k0, q_rows, k_rows).setZero();
+    causal_mask.value().block(q0, q0, q_rows, q_rows)
+      .triangularView<Eigen::Lower>().setZero();
+  }
+
+  auto& dense = *g.new_multihead_attention(q, k, k, mask, L, S, E, H);
+  auto& packed = *g.new_multihead_attention(q, k, k, mask, dense);
+  packed.pack(q_offsets, k_offsets);
+
+  auto& causal = *g.new_multihead_attention(q, q, q, causal_mask, dense);
+  auto& causal_packed = *g.new_multihead_attention(q, q, q, mask, dense);
+  causal_packed.pack(q_offsets, q_offsets, true);
+
+  ASSERT(packed().isApprox(dense(), 0.0001))
+  ASSERT(causal_packed().isApprox(causal(), 0.0001))
+
+  // packed gradients match masked attention
+  Tensor dFdy = Tensor::Random(L, E);
+  Function* outputs[] = { &dense, &packed };
+  Tensor dFdq[2], dFdk[2], dFdWq[2];
+  for (int i=0; i<2; i++)
+  {
+    g.recache();
+    g.zero_grad();
+    g.backward(*outputs[i], dFdy);
+    dFdq[i] = q.gradient();
+    dFdk[i] = k.gradient();
+    dFdWq[i] = dense.Wq().gradient();
+  }
+
+  ASSERT(dFdq[1].isApprox(dFdq[0], 0.001))
+  ASSERT(dFdk[1].isApprox(dFdk[0], 0.001))
+  ASSERT(dFdWq[1].isApprox(dFdWq[0], 0.001))
+
+  packed.unpack();
+  g.recache();
+  ASSERT(packed().isApprox(dense(), 0.0001))
+
+  TEST_END()
+}
+
+void test_attention_tiled()
+{
+  TEST_BEGIN("Multi-Head Attention Tiled")
+
+  // size
+  int L = 5; // target size
+  int S = 7; // sequence size
+  int E = 4; // embedding size
+  int H = 2; // heads
+  DTYPE inf = std::numeric_limits<DTYPE>::infinity();
+
+  Graph g;
+
+  auto& q = *g.new_variable(L, E);
+  auto& k = *g.new_variable(S, E);
+  auto& mask = *g.new_constant(L, S);
+  q.value() = Tensor::Random(L, E);
+  k.value() = Tensor::Random(S, E);
+  mask.value() = Tensor::Zero(L, S);
+  mask.value()(1, 2) = -inf;
+  mask.value()(3, S-1) = -inf;
+
+  auto& dense = *g.new_multihead_attention(q, k, k, mask, L, S, E, H);
+  auto& tiled = *g.new_multihead_attention(q, k, k, mask, dense);
+  tiled.tile(2);
+  ASSERT(tiled().isApprox(dense(), 0.0001))
+
+  // tiles of causal packed sequences
+  std::vector<int> offsets = { 0, 2, 5 };
+  auto& causal = *g.new_multihead_attention(q, q, q, mask, dense);
+  auto& causal_tiled = *g.new_multihead_attention(q, q, q, mask, dense);
+  causal.pack(offsets, offsets, true);
+  causal_tiled.pack(offsets, offsets, true);
+  causal_tiled.tile(2);
+  ASSERT(causal_tiled().isApprox(causal(), 0.0001))
+
+  // gradients recomputed from tiles match full attention
+  Function* outputs[] = { &dense, &tiled, &causal, &causal_tiled };
+  Tensor dFdq[4], dFdk[4], dFdWv[4];
+  for (int i=0; i<4; i++)
+  {
+    Tensor dFdy = Tensor::Ones(L, E);
+    g.recache();
+    g.zero_grad();
+    g.backward(*outputs[i], dFdy);
+    dFdq[i] = q.gradient();
+    dFdk[i] = k.gradient();
+    dFdWv[i] = dense.Wv().gradient();
+  }
+
+  for (int i=0; i<4; i+=2)
+  {
+    ASSERT(dFdq[i+1].isApprox(dFdq[i], 0.001))
+    ASSERT(dFdWv[i+1].isApprox(dFdWv[i], 0.001))
+  }
+  ASSERT(dFdk[1].isApprox(dFdk[0], 0.001))
 
-  // 2D input, IN_CHANNELS * IN_ROWS, IN_COLS = 4x3;
-  //
-  //  1  2  3 // channel 1
-  //  4  5  6
-  //
-  //  7  8  9 // channel 2
-  // 10 11 12
+  // tile larger than sequence
+  tiled.tile(16);
+  g.recache();
+  ASSERT(tiled().isApprox(dense(), 0.0001))
 
-  // 2D input as vector
-  auto& x = *g.new_variable(1, IN_CHANNELS * IN_ROWS * IN_COLS);
-  // col major
-  //x.value() << 1,4, 2,5, 3,6, 7,10, 8,11, 9,12;
-  // row major
-  x.value() << 1,2,3, 4,5,6, 7,8,9, 10,11,12;
+  TEST_END()
+}
 
-  // 2D conv layer
-  auto& y = *g.new_conv2d(
-    x,
-    IN_ROWS, IN_COLS,
-    IN_CHANNELS, OUT_CHANNELS,
-    K_ROWS, K_COLS,
-    STRIDE, PADDING, DILATION
-  );
+void test_int8_quantization()
+{
+  TEST_BEGIN("Int8 Quantization")
 
-  // K, OUT_CHANNELS * K_ROWS, IN_CHANNELS * K_COLS = 6x4
-  //
-  //  1  2    5  6
-  //  3  4    7  8
-  //
-  //  9 10   11 12
-  // 13 14   15 16
-  //
-  // 17 18   19 20
-  // 21 22   23 34
+  auto model = [](Graph& g, Constant& i, Constant& x) -> Function&
+  {
+    auto& e = *g.new_embedding(i, 50, 64);
+    auto& h = *g.new_linear(e, 64, 32);
+    auto& c = *g.new_conv2d(x, 10, 10, 2, 4, 3, 3);
+    auto& p = *g.new_product(*g.new_reshape(c, 16, 16), *g.new_variable(16, 8));
+    return *g.new_join(*g.new_reshape(h, 1, 8 * 32), *g.new_reshape(p, 1, 128),
+      1, 8 * 32 + 128);
+  };
 
-  auto& K = y.K();
-  K.value() << 1, 2,  5, 6,
-               3, 4,  7, 8,
-               9,10, 11,12,
-              13,14, 15,16,
-              17,18, 19,20,
-              21,22, 23,24;
+  Graph g;
+  auto& i = *g.new_constant(8, 1);
+  auto& x = *g.new_constant(1, 2 * 10 * 10);
+  auto& y = model(g, i, x);
 
-  y.forward();
-  g.backward(y, Tensor::Ones(1, OUT));
+  Quantizer q(g);
+  ASSERT(q.nodes().size() == 5) // embedding, linear and its product, conv, product
 
-  // dFdK
-  Tensor dFdK = K.gradient();
-  ASSERT(dFdK.rows() == OUT_CHANNELS * K_ROWS);
-  ASSERT(dFdK.cols() == IN_CHANNELS * K_COLS);
+  // calibrate on sample data
+  for (int n=0; n<3; n++)
+  {
+    g.recache();
+    i.value() = (25 * (Tensor::Random(8, 1).array() + 1)).floor();
+    x.value() = Tensor::Random(1, 2 * 10 * 10);
+    y.forward();
+    q.calibrate();
+  }
 
-  // dFdK_hat = x
-  Tensor dFdK_hat = g.dFdX(y, K);
-  ASSERT(dFdK_hat.rows() == OUT_CHANNELS * K_ROWS);
-  ASSERT(dFdK_hat.cols() == IN_CHANNELS * K_COLS);
-  ASSERT(dFdK.isApprox(dFdK_hat, 0.01))
+  Tensor y_fp32 = y();
+  q.quantize();
+  Tensor y_int8 = y();
+  ASSERT((y_int8 - y_fp32).norm() < 0.02 * y_fp32.norm())
 
-  // dFdx
-  Tensor dFdx = x.gradient();
-  ASSERT(dFdx.rows() == 1);
-  ASSERT(dFdx.cols() == IN);
+  // int8 weights are about 4x smaller than fp32 weights
+  std::stringstream store;
+  q.write(store);
+  size_t fp32_size = 0;
+  for (auto v: g.variables()) fp32_size += v->value().size() * sizeof(DTYPE);
+  ASSERT(store.str().size() < fp32_size / 3)
+
+  // load int8 weights into new graph
+  Graph g2;
+  auto& i2 = *g2.new_constant(8, 1);
+  auto& x2 = *g2.new_constant(1, 2 * 10 * 10);
+  auto& y2 = model(g2, i2, x2);
+  i2.value() = i.value();
+  x2.value() = x.value();
+
+  Quantizer q2(g2);
+  q2.read(store);
+  // product inputs are quantized on each pass
+  auto& vars = g.variables();
+  auto& vars2 = g2.variables();
+  for (int k=0; k<vars.size(); k++)
+  {
+    if (vars[k]->value().rows() == 16) vars2[k]->value() = vars[k]->value();
+  }
+  g2.recache();
+  ASSERT(y2().isApprox(y_int8))
 
-  // dFdx_hat = K
-  Tensor dFdx_hat = g.dFdX(y, x);
-  ASSERT(dFdx_hat.rows() == 1);
-  ASSERT(dFdx_hat.cols() == IN);
-  ASSERT(dFdx.isApprox(dFdx_hat, 0.01))
+  // back to full precision
+  q.dequantize();
+  ASSERT(y() == y_fp32)
 
   TEST_END()
 }
@@ -3753,6 +6244,206 @@ void test_adam_optimizer()
   TEST_END()
 }
 
+void test_fused_adam()
+{
+  TEST_BEGIN("Fused Adam")
+
+  // variables spanning several chunks and a partial chunk
+  Graph g1, g2;
+  std::vector<std::pair<int,int>> sizes = {{3, 5}, {70, 64}, {1, 1}};
+  for (auto& s: sizes)
+  {
+    Tensor w = Tensor::Random(s.first, s.second);
+    g1.new_variable(s.first, s.second)->value() = w;
+    g2.new_variable(s.first, s.second)->value() = w;
+  }
+
+  Adam adam(g1.variables(), 0.01);
+  FusedAdam fused(g2.variables(), 0.01);
+  fused.threads(2);
+
+  for (int step=0; step<5; step++)
+  {
+    for (int i=0; i<sizes.size(); i++)
+    {
+      auto& s = sizes[i];
+      Tensor grad = Tensor::Random(s.first, s.second);
+      g1.variables()[i]->gradient() = grad;
+      g2.variables()[i]->gradient() = grad;
+    }
+
+    adam.update();
+    fused.update();
+  }
+
+  for (int i=0; i<sizes.size(); i++)
+  {
+    auto& w1 = g1.variables()[i]->value();
+    auto& w2 = g2.variables()[i]->value();
+    ASSERT(w1.isApprox(w2, 1e-5))
+  }
+
+  TEST_END()
+}
+
+void test_checkpoint_file()
+{
+  TEST_BEGIN("Checkpoint File")
+
+  class Model : public Training
+  {
+  public:
+    Model(bool named) : Training(0)
+    {
+      if (!named) return;
+      graph().new_variable(2, 3, "W");
+      graph().new_variable(1, 3, "b");
+      graph().new_variable(17, 5, "E");
+    }
+    void batch_train() {}
+    Variable& var(int i) { return *graph().variables()[i]; }
+    int size() { return graph().variables().size(); }
+  };
+
+  std::string path = "/tmp/test.sgck";
+  Model source(true);
+  for (int i=0; i<source.size(); i++) source.var(i).value().setRandom();
+  source.save_checkpoint(path);
+
+  // mapped tensors are aligned views in variable order
+  Checkpoint checkpoint(path, true);
+  ASSERT(Checkpoint::is_checkpoint(path))
+  ASSERT(checkpoint.size() == 3)
+  ASSERT(checkpoint.name(2) == "E")
+  ASSERT(checkpoint.find("b") == 1)
+  ASSERT(checkpoint.find("x") == -1)
+  for (int i=0; i<checkpoint.size(); i++)
+  {
+    ASSERT(((size_t)checkpoint.tensor(i).data() % 64) == 0)
+    ASSERT(checkpoint.tensor(i) == source.var(i).value())
+  }
+
+  // load by name into existing variables and in order into new ones
+  Model named(true), unnamed(false);
+  named.load_checkpoint(path, true);
+  unnamed.load_checkpoint(path);
+  ASSERT(unnamed.size() == 3)
+  for (int i=0; i<source.size(); i++)
+  {
+    ASSERT(named.var(i).value() == source.var(i).value())
+    ASSERT(unnamed.var(i).value() == source.var(i).value())
+  }
+
+  // corrupted payload fails verification
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-1, std::ios::end);
+    file.put(0x7f);
+  }
+  ASSERT(!Checkpoint(path).verify())
+
+  bool error = false;
+  try { Checkpoint(path, true); }
+  catch (std::exception& e) { error = true; }
+  ASSERT(error)
+
+  std::remove(path.c_str());
+
+  TEST_END()
+}
+
+void test_update_compression()
+{
+  TEST_BEGIN("Update Compression")
+
+  class Model : public Training
+  {
+  public:
+    Model() : Training(0) { graph().new_variable(100, 50); }
+    void batch_train() {}
+    Tensor& W() { return graph().variables()[0]->value(); }
+  };
+
+  const int N = 100 * 50;
+  Model worker, master;
+  worker.W().setRandom();
+  master.set_weights(worker.get_weights());
+  worker.set_weights(worker.get_weights());
+  Tensor W0 = worker.W();
+
+  Tensor delta = Tensor::Random(100, 50) * 0.01;
+  worker.W() += delta;
+
+  auto dense = worker.get_update();
+  ASSERT(dense.size() > N * sizeof(DTYPE))
+
+  // payload ratio and decoded accuracy of each compression
+  struct Case { Compression c; DTYPE param; int max_size; DTYPE max_error; };
+  Case cases[] = {
+    { TOP_K,     0.01,  N / 100 * 8 + 64,  0.01 },
+    { THRESHOLD, 0.0095, N / 10 * 8,       0.01 },
+    { QUANT8,    0,     N + 64,            0.01 / 127 },
+    { QUANT4,    0,     N / 2 + 64,        0.01 / 7 },
+  };
+
+  for (auto& t: cases)
+  {
+    worker.compression(t.c, t.param);
+    ASSERT(worker.compression() == t.c)
+
+    auto update = worker.get_update();
+    ASSERT(update.size() < t.max_size)
+
+    master.W() = W0;
+    master.upd_weights(update, t.c);
+    ASSERT((master.W() - worker.W()).cwiseAbs().maxCoeff() <= t.max_error * 1.01)
+  }
+
+  // top-k keeps the largest increments
+  worker.compression(TOP_K, 0.01);
+  master.W() = W0;
+  master.upd_weights(worker.get_update(), TOP_K);
+  Tensor sent = master.W() - W0;
+  int changed = (sent.array() != 0).count();
+  ASSERT(changed == N / 100)
+  DTYPE kept = sent.cwiseAbs().maxCoeff();
+  ASSERT(std::abs(kept - delta.cwiseAbs().maxCoeff()) < 1e-6)
+
+  // error feedback sends the residual with later updates, so repeated
+  // updates of the same increment add up to its multiple
+  for (auto c: { TOP_K, QUANT4 })
+  {
+    worker.compression(c, 0.01);
+    master.W() = W0;
+    const int steps = 1000;
+    for (int i=0; i<steps; i++) master.upd_weights(worker.get_update(), c);
+    Tensor error = (master.W() - W0) - steps * delta;
+    ASSERT(error.norm() < 0.1 * (steps * delta).norm())
+  }
+
+  // stochastic rounding is unbiased without feedback
+  Tensor sum = Tensor::Zero(100, 50);
+  for (int i=0; i<100; i++)
+  {
+    worker.compression(QUANT8);
+    master.W().setZero();
+    master.upd_weights(worker.get_update(), QUANT8);
+    sum += master.W();
+  }
+  ASSERT(std::abs((sum / 100 - delta).mean()) < 1e-5)
+
+  // empty increment keeps none of its elements
+  RNG rng;
+  for (auto c: { TOP_K, THRESHOLD, QUANT8 })
+  {
+    std::ostringstream out;
+    Tensor decoded = write_compressed(Tensor(), c, 0.01, rng, out);
+    ASSERT(decoded.size() == 0 && out.str().size())
+  }
+
+  TEST_END()
+}
+
 void test_ImageFP()
 {
   TEST_BEGIN("ImageFP")
@@ -3799,6 +6490,81 @@ void test_ImageFP()
   ASSERT(fp_scaled.size() == scaled.size());
   ASSERT(fp_scaled.channels() == scaled.channels());
 
+  ImageFP fp_flipped = fpi.flip();
+  ASSERT(fp_flipped.rows() == fpi.rows());
+  ASSERT(fp_flipped.cols() == fpi.cols());
+  ASSERT(fp_flipped.get(3, 0, 1) == fpi.get(3, fpi.cols() - 1, 1));
+
+  ImageFP fp_restored = fp_flipped.flip();
+  ASSERT(std::memcmp(fp_restored.data(), fpi.data(),
+    fpi.size() * sizeof(DTYPE)) == 0);
+
+  TEST_END()
+}
+
+void test_image_kernels()
+{
+  TEST_BEGIN("Image Kernels")
+
+  int rows = 23;
+  int cols = 31;
+
+  Image img(rows, cols, 3);
+  ImageFP fpi(rows, cols, 3);
+  for (int i=0; i<img.size(); i++)
+  {
+    img.data()[i] = (i * 37) % 256;
+    fpi.data()[i] = img.data()[i];
+  }
+
+  // scale of window in place same as scale of cropped copy
+  Image view(16, 16, 3);
+  ImageFP fp_view(16, 16, 3);
+  for (auto interp : {Image::INTERPOLATE_NEAREST, Image::INTERPOLATE_BILINEAR})
+  {
+    img.scale(-3, 20, 12, 14, view, interp);
+    Image copy = img.crop(-3, 20, 12, 14).scale(16, 16, interp);
+    ASSERT(std::memcmp(view.data(), copy.data(), view.size()) == 0)
+
+    auto fp_interp = (ImageFP::Interpolation)interp;
+    fpi.scale(-3, 20, 12, 14, fp_view, fp_interp);
+    ImageFP fp_copy = fpi.crop(-3, 20, 12, 14).scale(16, 16, fp_interp);
+    ASSERT(std::memcmp(fp_view.data(), fp_copy.data(),
+      fp_view.size() * sizeof(DTYPE)) == 0)
+  }
+
+  // crop into buffer, zero outside of the image
+  Image cropped(4, 5, 3);
+  img.crop(rows - 2, -1, cropped);
+  ASSERT(cropped.get(0, 0, 0) == 0)
+  ASSERT(cropped.get(2, 1, 0) == 0)
+  ASSERT(cropped.get(1, 1, 2) == img.get(rows - 1, 0, 2))
+
+  // interleaved to planar
+  Tensor planar(3, rows * cols);
+  img.planar(planar.data(), 0.5);
+  ASSERT(planar(2, cols + 4) == 0.5 * img.get(1, 4, 2))
+  fpi.planar(planar.data());
+  ASSERT(planar(1, 7) == fpi.get(0, 7, 1))
+
+  // per channel standardization
+  DTYPE mean[] = {1, 2, 3};
+  DTYPE stddev[] = {2, 4, 8};
+  DTYPE value = fpi.get(5, 6, 2);
+  fpi.standardize(mean, stddev);
+  ASSERT(std::abs(fpi.get(5, 6, 2) - (value - 3) / 8) < EPSILON)
+
+  // view into caller buffer same as returned view
+  RLEnv env;
+  env.set_full_rgb(img.data(), 1, rows, cols);
+  env.new_episode();
+  env.action_zoom_in();
+  Image env_view;
+  env.get_view_rgb(env_view);
+  Image ret_view = env.get_view_rgb();
+  ASSERT(env_view.size() == ret_view.size())
+  ASSERT(std::memcmp(env_view.data(), ret_view.data(), ret_view.size()) == 0)
+
   TEST_END()
 }
 
@@ -3939,21 +6705,347 @@ void test_rl_env()
   TEST_END()
 }
 
+class TestVecRLEnv : public VecRLEnv
+{
+public:
+  TestVecRLEnv(int size) : VecRLEnv(size, 20, 20) {}
+
+protected:
+  // reward first move, finish on any other action
+  virtual DTYPE reward(int i, int action) { return (action == MOVE_UP); }
+  virtual bool finished(int i, int action) { return action >= NUM_OF_MOVES; }
+};
+
+void test_vec_rl_env()
+{
+  TEST_BEGIN("Vectorized RL Env")
+
+  int size = 3;
+  int rows = 100;
+  int cols = 150;
+
+  Image image(rows, cols, 3); // random image
+  for (int i=0; i<rows*cols*3; i++) image.data()[i] = i % 251;
+
+  TestVecRLEnv vec(size);
+  for (int i=0; i<size; i++) vec.set_full_rgb(i, image.data(), 1, rows, cols);
+
+  RLEnv env;
+  env.set_view_size(20, 20);
+  env.set_full_rgb(image.data(), 1, rows, cols);
+
+  vec.new_episode();
+  env.new_episode();
+
+  // centered views match single environment view
+  Tensor obs;
+  vec.observe(obs);
+  ASSERT(obs.rows() == size)
+  ASSERT(obs.cols() == vec.features())
+  ASSERT(vec.features() == 20 * 20 * 3)
+
+  auto view = env.get_view_rgb();
+  for (int i=0; i<size; i++)
+  for (int k=0; k<vec.features(); k++)
+  {
+    ASSERT(obs(i,k) == view.data()[k] / DTYPE(255))
+  }
+
+  Tensor center = obs.row(0);
+
+  // one action per environment
+  std::vector<int> actions = {
+    VecRLEnv::MOVE_UP, VecRLEnv::MOVE_ZOOM_IN, VecRLEnv::NUM_OF_MOVES
+  };
+  std::vector<DTYPE> rewards;
+  std::vector<bool> done;
+  vec.step(actions, rewards, done);
+
+  ASSERT(rewards[0] == 1 && rewards[1] == 0 && rewards[2] == 0)
+  ASSERT(!done[0] && !done[1] && done[2])
+  ASSERT(vec.steps(0) == 1 && vec.steps(1) == 1)
+
+  // finished episode restarted with centered view
+  ASSERT(vec.steps(2) == 0)
+
+  env.action_zoom_in();
+  view = env.get_view_rgb();
+  vec.observe(obs);
+  for (int k=0; k<vec.features(); k++)
+  {
+    ASSERT(obs(1,k) == view.data()[k] / DTYPE(255))
+  }
+  ASSERT(obs.row(2) == center)
+  ASSERT(obs.row(0) != center)
+
+  // finished episode kept without auto reset
+  vec.enable_auto_reset(false);
+  actions = { VecRLEnv::NUM_OF_MOVES, VecRLEnv::MOVE_UP, VecRLEnv::MOVE_UP };
+  vec.step(actions, rewards, done);
+  ASSERT(done[0] && vec.steps(0) == 2)
+
+  // invalid number of actions
+  actions.resize(size - 1);
+  try
+  {
+    vec.step(actions, rewards, done);
+    ASSERT(false)
+  }
+  catch (std::runtime_error&) {}
+
+  TEST_END()
+}
+
+void test_shared_weights()
+{
+  TEST_BEGIN("Shared Weights")
+
+  class Worker : public Training
+  {
+  public:
+    Worker(int worker) : Training(worker)
+    {
+      graph().new_variable(2, 3);
+      graph().new_variable(1, 3);
+    }
+    void batch_train()
+    {
+      for (auto v: graph().variables()) v->value().array() += worker();
+    }
+    const Tensor& weight(int i) { return graph().variables()[i]->value(); }
+  };
+
+  Worker source(0);
+
+  // one snapshot read by all workers
+  auto weights = read_weights(source.get_weights());
+  Worker worker1(1), worker2(2), master(-1);
+  worker1.set_weights(weights);
+  worker2.set_weights(weights);
+  master.set_weights(weights);
+  ASSERT(weights.use_count() == 4)
+  ASSERT(worker1.get_weights() == source.get_weights())
+
+  // training leaves snapshot unchanged
+  worker1.batch_train();
+  worker2.batch_train();
+  ASSERT(worker1.weight(0) != worker2.weight(0))
+  ASSERT((*weights)[0] == source.weight(0))
+
+  // worker updates relative to snapshot
+  master.upd_weights(worker1.get_update());
+  master.upd_weights(worker2.get_update());
+  for (int i=0; i<2; i++)
+  {
+    Tensor expected = (*weights)[i].array() + 3;
+    ASSERT(master.weight(i).isApprox(expected, 1e-6))
+  }
+
+  // snapshot stored in reduced precision reads back in FP32
+  std::istringstream in(source.get_weights(BF16));
+  Precision precision;
+  auto reduced = read_weights(in, precision, BF16);
+  ASSERT(precision == BF16)
+  ASSERT(reduced->precision() == BF16)
+  ASSERT(reduced->size() == 2)
+  for (auto storage: {FP16, BF16})
+  {
+    Weights stored({source.weight(0), source.weight(1)}, storage);
+    Tensor buffer;
+    ASSERT(&stored.get(0, buffer) == &buffer)
+    ASSERT(buffer.isApprox(source.weight(0), 1e-2))
+  }
+
+  // updates relative to reduced snapshot
+  Worker worker3(3);
+  worker3.set_weights(reduced);
+  Tensor buffer;
+  ASSERT(worker3.weight(1) == reduced->get(1, buffer))
+  worker3.batch_train();
+  master.set_weights(reduced);
+  master.upd_weights(worker3.get_update());
+  for (int i=0; i<2; i++)
+  {
+    Tensor expected = reduced->get(i, buffer).array() + 3;
+    ASSERT(master.weight(i).isApprox(expected, 1e-6))
+  }
+
+  TEST_END()
+}
+
+void test_weights_delta()
+{
+  TEST_BEGIN("Weights Delta")
+
+  Tensor w0 = Tensor::Random(4, 3);
+  Tensor w1 = Tensor::Random(2, 2);
+  SharedWeights base(new Weights({w0, w1}));
+
+  // two increments of first weight, full second weight
+  Tensor a = w0, b = w0;
+  a.row(1).array() += 1;
+  b.array() += 0.5;
+  Tensor full = Tensor::Random(2, 2);
+
+  std::ostringstream out;
+  write_int(2, out);
+  write_int(2, out);
+  write_int(FP32, out);
+  write_int(DENSE, out);
+  write_update(a, w0, FP32, out);
+  write_int(FP32, out);
+  write_int(QUANT8, out);
+  RNG rng;
+  write_compressed(b - w0, QUANT8, 0, rng, out);
+  write_int(-1, out);
+  write_int(FP16, out);
+  write_tensor(full, out, FP16);
+
+  auto weights = read_weights_delta(out.str(), base);
+  Tensor expected = a + (b - w0);
+  ASSERT((*weights)[0].isApprox(expected, 1e-2))
+  ASSERT((*weights)[1].isApprox(full, 1e-2))
+
+  // base snapshot stays intact, empty delta keeps it
+  ASSERT((*base)[0] == w0)
+  ASSERT(read_weights_delta("", base) == base)
+
+  TEST_END()
+}
+
+void test_flat_weights()
+{
+  TEST_BEGIN("Flat Weights")
+
+  class Model : public Training
+  {
+  public:
+    Model() : Training(0)
+    {
+      graph().new_variable(2, 3)->value().setRandom();
+      graph().new_variable(1, 4)->value().setRandom();
+    }
+    void batch_train()
+    {
+      for (auto v: graph().variables()) v->value().array() += 1;
+    }
+    const Tensor& weight(int i) { return graph().variables()[i]->value(); }
+  };
+
+  Model a, b;
+  ASSERT(a.flat_size() == 10)
+
+  // weights in variable order
+  std::vector<DTYPE> flat(a.flat_size());
+  a.get_flat(flat.data());
+  ASSERT(flat[4] == a.weight(0)(1, 1))
+  ASSERT(flat[9] == a.weight(1)(0, 3))
+
+  b.set_flat(flat.data());
+  ASSERT(b.get_weights() == a.get_weights())
+
+  // increments are relative to weights set last
+  b.batch_train();
+  b.get_flat(flat.data(), true);
+  for (auto e: flat) { ASSERT(e == 1) }
+
+  for (auto& e: flat) e = 0.5;
+  b.set_flat(flat.data(), true);
+  Tensor expected = a.weight(0).array() + 0.5;
+  ASSERT(b.weight(0).isApprox(expected))
+
+  b.get_flat(flat.data(), true);
+  for (auto e: flat) { ASSERT(e == 0) }
+
+  TEST_END()
+}
+
+void test_payload_frames()
+{
+  TEST_BEGIN("Payload Frames")
+
+  // weights larger than one frame and small values around them
+  Tensor w0 = Tensor::Random(600, 500);
+  Tensor w1 = Tensor::Random(3, 2);
+
+  for (bool deflate: {false, true})
+  {
+    std::stringstream stream;
+    std::ostringstream plain;
+    FrameOutputBuffer frames(stream, deflate);
+    std::ostream out(&frames);
+    for (auto e: {&out, (std::ostream*)&plain})
+    {
+      write_int(2, *e);
+      write_tensor(w0, *e);
+      write_update(w1, Tensor::Zero(3, 2), BF16, *e);
+    }
+    frames.close();
+    write_int(7, stream);
+
+    ASSERT(frames.bytes() == plain.str().size())
+
+    // payload ends before data following it
+    FrameInputBuffer input(stream, deflate);
+    std::istream in(&input);
+    ASSERT(read_int(in) == 2)
+    ASSERT(read_tensor(in) == w0)
+    Tensor w = Tensor::Zero(3, 2);
+    read_update(w, BF16, in);
+    ASSERT(w.isApprox(w1, 1e-2))
+    ASSERT(in.get() == EOF)
+    ASSERT(input.bytes() == frames.bytes())
+    ASSERT(read_int(stream) == 7)
+  }
+
+  // deflated payload of repeated values is smaller
+  std::stringstream raw, compressed;
+  for (auto e: {&raw, &compressed})
+  {
+    FrameOutputBuffer frames(*e, e == &compressed);
+    std::ostream out(&frames);
+    write_tensor(Tensor::Ones(600, 500), out);
+    frames.close();
+  }
+  ASSERT(compressed.str().size() < raw.str().size() / 10)
+
+  // unread payload is skipped
+  FrameInputBuffer input(compressed, true);
+  std::istream in(&input);
+  ASSERT(read_int(in) == 600)
+  input.drain();
+  ASSERT(compressed.get() == EOF)
+
+  TEST_END()
+}
+
 /**
  * test entry point
  */ 
 int main(int argc, char* argv[]) {
 
   test_ImageFP();
+  test_image_kernels();
   test_painter();
   test_rl_env();
+  test_vec_rl_env();
 
   test_eigen_fft();
   test_audio_file();
+  test_audio_stream();
   test_image_file();
+  test_dataset_file();
+  test_pipeline();
+  test_replay_buffer();
+  test_batcher();
+  test_topology();
+  test_ring_all_reduce();
 
   test_eigen_matrix();
+  test_tensor_precision();
+  test_compute_backend();
   test_random_numbers();
+  test_philox();
   test_discount_reward();
   test_cosine_similarity();
   test_function_negative();
@@ -3964,6 +7056,19 @@ int main(int argc, char* argv[]) {
 
   test_numerical_derivative();
   test_back_propagation();
+  test_compiled_plan();
+  test_plan_memory();
+  test_plan_shapes();
+  test_minibatch();
+  test_axis_reduction();
+  test_invalidate_from();
+  test_plan_fusion();
+  test_plan_threads();
+  test_unroll();
+  test_checkpoint();
+  test_profiler();
+  test_no_grad_graph();
+  test_gradient_aggregation();
 
   test_broadcast_forward();
   test_broadcast_backward();
@@ -3982,6 +7087,7 @@ int main(int argc, char* argv[]) {
 
   test_reshape_forward();
   test_reshape_backward();
+  test_shape_views();
 
   test_linear_forward();
   test_linear_backward();
@@ -4024,9 +7130,11 @@ int main(int argc, char* argv[]) {
 
   test_softplus_forward();
   test_softplus_backward();
+  test_activation_kernels();
 
   test_log_softmax_forward();
   test_log_softmax_backward();
+  test_softmax_vocabulary_backward();
 
   test_log_forward();
   test_log_backward();
@@ -4048,9 +7156,12 @@ int main(int argc, char* argv[]) {
 
   test_gru_forward();
   test_gru_backward();
+  test_gru_sequence();
+  test_lstm_sequence();
 
   test_norm_forward();
   test_norm_backward();
+  test_norm_fused();
 
   test_gaussian_forward();
   test_gaussian_backward();
@@ -4060,9 +7171,20 @@ int main(int argc, char* argv[]) {
 
   test_embedding_forward();
   test_embedding_backward();
+  test_sparse_embedding();
+
+  test_gather_forward();
+  test_gather_backward();
 
   test_conv2d_forward();
   test_conv2d_backward();
+  test_conv2d_im2col();
+
+  test_attention_forward();
+  test_attention_backward();
+  test_attention_packed();
+  test_attention_tiled();
+  test_int8_quantization();
 
   test_gaussian_sampler();
   test_linear_regression();
@@ -4070,6 +7192,13 @@ int main(int argc, char* argv[]) {
 
   test_average_convergence();
   test_adam_optimizer();
+  test_fused_adam();
+  test_shared_weights();
+  test_weights_delta();
+  test_flat_weights();
+  test_checkpoint_file();
+  test_update_compression();
+  test_payload_frames();
 
   return 0;
 }
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "vecrlenv.hh"
+#include "imagekernel.hh"
+
+namespace seegnify {
+
+// default channles - RGB
+#define CHANNELS 3
+
+// scale range
+#define MAX_SCALE 10.0
+#define MIN_SCALE 0.1
+
+// rounding routine
+#define ROUND(a) ((int)round((a)))
+
+VecRLEnv::VecRLEnv(int size, uint16_t view_rows, uint16_t view_cols) :
+_size(size), _view_rows(view_rows), _view_cols(view_cols), _auto_reset(true)
+{
+  if (size <= 0) throw std::runtime_error("Invalid number of environments");
+
+  _data.resize(size);
+  _slices.assign(size, 0);
+  _rows.assign(size, 0);
+  _cols.assign(size, 0);
+
+  _slice.assign(size, 0);
+  _x.assign(size, 0);
+  _y.assign(size, 0);
+  _scale.assign(size, 1);
+  _steps.assign(size, 0);
+}
+
+void VecRLEnv::set_full_rgb(int i,
+const uint8_t* rgb, uint16_t slices, uint16_t rows, uint16_t cols)
+{
+  _data[i].assign(rgb, rgb + (size_t)CHANNELS * slices * rows * cols);
+  _slices[i] = slices;
+  _rows[i] = rows;
+  _cols[i] = cols;
+}
+
+void VecRLEnv::new_episode()
+{
+  for (int i=0; i<_size; i++) new_episode(i);
+}
+
+void VecRLEnv::new_episode(int i)
+{
+  reset(i);
+
+  _steps[i] = 0;
+  _scale[i] = 1.0;
+  _slice[i] = 0;
+  _x[i] = _cols[i] / 2;
+  _y[i] = _rows[i] / 2;
+}
+
+void VecRLEnv::observe(Tensor& obs) const
+{
+  obs.resize(_size, features());
+
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for (int i=0; i<_size; i++)
+  {
+    thread_local std::vector<uint8_t> view;
+    view.resize(features());
+
+    // window of the full data in the agent view
+    auto scale = _scale[i];
+    auto slice = ROUND(_slice[i]);
+    size_t offset = (size_t)CHANNELS * slice * _rows[i] * _cols[i];
+
+    PixelWindow<uint8_t> w = {
+      _data[i].data() + offset, _rows[i], _cols[i], CHANNELS,
+      ROUND(_y[i] - _view_rows / 2.0 / scale),
+      ROUND(_x[i] - _view_cols / 2.0 / scale),
+      ROUND(_view_rows / scale),
+      ROUND(_view_cols / scale)
+    };
+
+    // zoom to fit agent view
+    scale_nearest_kernel(w, view.data(), _view_rows, _view_cols);
+
+    auto row = obs.row(i).data();
+    for (int k=features()-1; k>=0; k--) row[k] = view[k] / DTYPE(255);
+  }
+}
+
+void VecRLEnv::step(const std::vector<int>& actions,
+std::vector<DTYPE>& rewards, std::vector<bool>& done)
+{
+  if ((int)actions.size() != _size)
+    throw std::runtime_error("Invalid number of actions");
+
+  rewards.resize(_size);
+  done.resize(_size);
+
+  for (int i=0; i<_size; i++)
+  {
+    auto action = actions[i];
+
+    if (action < NUM_OF_MOVES) move(i, action);
+    _steps[i] += 1;
+
+    rewards[i] = reward(i, action);
+    done[i] = finished(i, action);
+
+    if (done[i] && _auto_reset) new_episode(i);
+  }
+}
+
+void VecRLEnv::move(int i, int action)
+{
+  auto& scale = _scale[i];
+
+  switch (action)
+  {
+    case MOVE_UP:       _y[i] -= 1.0 / scale; break;
+    case MOVE_DOWN:     _y[i] += 1.0 / scale; break;
+    case MOVE_LEFT:     _x[i] -= 1.0 / scale; break;
+    case MOVE_RIGHT:    _x[i] += 1.0 / scale; break;
+    case MOVE_FORWARD:
+      _slice[i] = std::fmin(_slice[i] + 1.0, _slices[i] - 1);
+      break;
+    case MOVE_BACKWARD:
+      _slice[i] = std::fmax(_slice[i] - 1.0, 0);
+      break;
+    case MOVE_ZOOM_IN:
+      if (scale * 2 <= MAX_SCALE) scale *= 2;
+      break;
+    case MOVE_ZOOM_OUT:
+    {
+      float min_s = MIN_SCALE * std::fmin(
+        float(_view_rows) / _rows[i], float(_view_cols) / _cols[i]);
+      if (scale / 2 >= min_s) scale /= 2;
+      break;
+    }
+  }
+}
+
+} /* namespace */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Greg Padiasek
+ * Distributed under the terms of the MIT License.
+ * See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef _SEEGNIFY_VEC_RL_ENV_H_
+#define _SEEGNIFY_VEC_RL_ENV_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "main/types.hh"
+
+namespace seegnify {
+
+// Batch of RL environments stepped together with one action each. Every
+// environment moves a view over its own image slices like RLEnv. State of
+// the environments is kept in arrays, one element per environment, and the
+// views of all of them are scaled from the image data straight into rows
+// of one observation tensor. Finished episodes restart in the same step.
+class VecRLEnv
+{
+public:
+  // view moves, actions from NUM_OF_MOVES up are handled by subclasses
+  enum Move
+  {
+    MOVE_UP,
+    MOVE_DOWN,
+    MOVE_LEFT,
+    MOVE_RIGHT,
+    MOVE_FORWARD,
+    MOVE_BACKWARD,
+    MOVE_ZOOM_IN,
+    MOVE_ZOOM_OUT,
+    NUM_OF_MOVES
+  };
+
+  VecRLEnv(int size, uint16_t view_rows = 16, uint16_t view_cols = 16);
+
+  virtual ~VecRLEnv() {}
+
+  // number of environments
+  int size() const { return _size; }
+
+  // observation features of one environment
+  int features() const { return 3 * _view_rows * _view_cols; }
+
+  // copy RGB slices [slices x rows x cols x 3] of environment i
+  void set_full_rgb(int i,
+    const uint8_t* rgb, uint16_t slices, uint16_t rows, uint16_t cols);
+
+  // start new episode in all environments
+  void new_episode();
+
+  // start new episode in environment i
+  void new_episode(int i);
+
+  // RGB views in [0,1] of all environments [size x features]
+  void observe(Tensor& obs) const;
+
+  // apply one action per environment, return reward and end of episode
+  // of each, restart finished episodes when auto reset is enabled
+  void step(const std::vector<int>& actions,
+    std::vector<DTYPE>& rewards, std::vector<bool>& done);
+
+  // restart finished episodes in step
+  void enable_auto_reset(bool reset) { _auto_reset = reset; }
+
+  // actions taken in current episode of environment i
+  uint32_t steps(int i) const { return _steps[i]; }
+
+protected:
+  // reward of action taken by environment i
+  virtual DTYPE reward(int i, int action) = 0;
+
+  // episode of environment i finished by action
+  virtual bool finished(int i, int action) = 0;
+
+  // prepare environment i for new episode, before the view is centered
+  virtual void reset(int i) {}
+
+  // move view of environment i
+  void move(int i, int action);
+
+protected:
+  int _size;
+  uint16_t _view_rows;
+  uint16_t _view_cols;
+  bool _auto_reset;
+
+  // image data
+  std::vector<std::vector<uint8_t>> _data;
+  std::vector<uint16_t> _slices;
+  std::vector<uint16_t> _rows;
+  std::vector<uint16_t> _cols;
+
+  // view position
+  std::vector<float> _slice;
+  std::vector<float> _x;
+  std::vector<float> _y;
+  std::vector<float> _scale;
+  std::vector<uint32_t> _steps;
+};
+
+} /* namespace */
+
+#endif /* _SEEGNIFY_VEC_RL_ENV_H_ */
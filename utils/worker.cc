@@ -8,11 +8,18 @@
 #include <sstream>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <random>
 
 #include <dlfcn.h>
 
 #include "transport.hh"
 #include "training.hh"
+#include "topology.hh"
 #include "graph.pb.h"
 
 namespace seegnify {
@@ -22,6 +29,19 @@ namespace seegnify {
 bool done = false;
 std::string host;
 int port = -1;
+uint64_t worker_id = 0;
+
+// time of worker threads spent training and waiting for transfers
+
+std::atomic<uint64_t> compute_time(0);
+std::atomic<uint64_t> comm_time(0);
+
+// microseconds since time point
+inline uint64_t micros_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count();
+}
 
 typedef Training* (*create_callback)(int);
 typedef void (*destroy_callback)(Training*);
@@ -29,88 +49,359 @@ typedef void (*destroy_callback)(Training*);
 create_callback create = nullptr;
 destroy_callback destroy = nullptr;
 
+// connections to master shared by worker threads
+
+typedef ProtobufClientPool<graph::Request, graph::Response> ClientPool;
+std::unique_ptr<ClientPool> clients;
+
+// placement of worker threads on CPUs and NUMA nodes
+
+std::unique_ptr<Topology> topology;
+
+// process-wide weights snapshot shared by worker threads
+
+struct Pulled
+{
+  SharedWeights weights;
+  uint64_t updates; // applied to weights at master
+};
+
+std::mutex weights_lock;
+std::condition_variable weights_ready;
+Pulled weights_snapshot;
+std::vector<uint64_t> weights_versions;
+bool weights_loading = false;
+size_t weights_round = 0;
+std::exception_ptr weights_error; // of last round, null when downloaded
+
+// Increments of worker threads summed in process memory and pushed as one
+// update every given number of thread batches. Each weight has its own lock
+// so that threads add different weights at the same time.
+class Aggregator
+{
+public:
+  Aggregator(int batches) : _batches(batches), _count(0), _clock(0),
+  _updates(UINT64_MAX), _precision(FP32), _compression(DENSE), _param(0) {}
+
+  // add increments of thread computed on weights of given updates,
+  // returns true when combined update is due
+  bool add(Training& impl, uint64_t clock, uint64_t updates)
+  {
+    int size = impl.weights_count();
+    {
+      std::lock_guard<std::mutex> lock(_lock);
+      if (_sums.size() != size)
+      {
+        if (_sums.size()) throw std::runtime_error("Incompatible update");
+        for (int i=0; i<size; i++) _sums.emplace_back(new Sum());
+      }
+    }
+
+    for (int i=0; i<size; i++)
+    {
+      std::lock_guard<std::mutex> lock(_sums[i]->lock);
+      impl.add_increment(i, _sums[i]->value);
+    }
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _clock = std::max(_clock, clock);
+    _updates = std::min(_updates, updates);
+    _precision = impl.precision();
+    _compression = impl.compression();
+    _param = impl.compression_param();
+    if (++_count < _batches) return false;
+    _count = 0;
+    return true;
+  }
+
+  // added increments not taken yet
+  bool pending()
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _count > 0;
+  }
+
+  // take combined update with highest clock and oldest weights of threads
+  std::string take(Compression& compression, uint64_t& clock,
+  uint64_t& updates)
+  {
+    std::lock_guard<std::mutex> take_lock(_take_lock);
+
+    Precision precision;
+    DTYPE param;
+    {
+      std::lock_guard<std::mutex> lock(_lock);
+      _count = 0;
+      clock = _clock;
+      updates = _updates;
+      _updates = UINT64_MAX;
+      precision = _precision;
+      compression = _compression;
+      param = _param;
+    }
+
+    std::ostringstream out;
+    write_weights_header(_sums.size(), precision, out);
+    for (auto& e: _sums)
+    {
+      Tensor sum;
+      {
+        std::lock_guard<std::mutex> lock(e->lock);
+        std::swap(sum, e->value);
+      }
+
+      // keep shape of weights without increments since last take
+      if (sum.size() == 0) sum = Tensor::Zero(e->rows, e->cols);
+      e->rows = sum.rows();
+      e->cols = sum.cols();
+
+      if (compression == DENSE)
+      {
+        write_update(sum, Tensor::Zero(sum.rows(), sum.cols()),
+          precision, out);
+      }
+      else
+      {
+        // residual of compression is added to next update
+        if (e->residual.size() == sum.size()) sum += e->residual;
+        e->residual = sum - write_compressed(sum, compression, param,
+          _rng, out);
+      }
+    }
+
+    return out.str();
+  }
+
+private:
+  struct Sum
+  {
+    std::mutex lock;
+    Tensor value;
+    Tensor residual;
+    int rows = 0;
+    int cols = 0;
+  };
+
+  int _batches;
+  int _count;
+  uint64_t _clock;
+  uint64_t _updates;
+  Precision _precision;
+  Compression _compression;
+  DTYPE _param;
+  std::vector<std::unique_ptr<Sum>> _sums;
+  std::mutex _lock;
+  std::mutex _take_lock;
+  RNG _rng;
+};
+
+std::unique_ptr<Aggregator> aggregator;
+
 // command handlers
 
-// get master graph weights
-std::string get_weights()
+// get master graph weights, only their increments since versions of base,
+// full weights in precision kept in storage precision, master may hold
+// them until clock of slower workers catches up
+Pulled get_weights(const std::vector<uint64_t>& since, uint64_t clock,
+Precision precision, Precision storage, const SharedWeights& base,
+std::vector<uint64_t>& versions)
 {
   graph::Request req;
   graph::Response res;
 
   auto get_weights = req.mutable_get_weights();
-
-  ProtobufClient<graph::Request, graph::Response> client;    
-  client.connect(host, port);    
-  client.send(req);    
-  client.receive(res);
-  client.disconnect();
+  for (auto v: since) get_weights->add_since_version(v);
+  get_weights->set_worker(worker_id);
+  get_weights->set_clock(clock);
+  get_weights->set_precision(precision);
+
+  // read weights from connection, base is current without payload
+  Pulled pulled;
+  pulled.weights = base;
+  clients->call(req, res, nullptr,
+    [&](graph::Response& res, std::istream& in)
+    {
+      Precision served;
+      if (res.get_weights().delta())
+        pulled.weights = read_weights_delta(in, base);
+      else
+        pulled.weights = read_weights(in, served, storage);
+    });
   
   if (res.has_error()) throw std::runtime_error(res.error().message());
-  
-  auto master_weights = res.get_weights().weights();
-  
-  return master_weights;
+  if (pulled.weights == nullptr)
+    throw std::runtime_error("Missing master weights");
+
+  pulled.updates = res.get_weights().updates();
+  versions.assign(res.get_weights().version().begin(),
+    res.get_weights().version().end());
+  return pulled;
 }
 
-// set master graph weights
-void set_weights(const std::string& weights)
+// set master graph weights, written from variables of implementation
+void set_weights(Training& impl)
 {
   graph::Request req;
   graph::Response res;
 
-  auto set_weights = req.mutable_set_weights();
-  set_weights->set_weights(weights);
+  req.mutable_set_weights();
 
-  ProtobufClient<graph::Request, graph::Response> client;    
-  client.connect(host, port);
-  client.send(req);    
-  client.receive(res);
-  client.disconnect();
+  clients->call(req, res, [&](std::ostream& out)
+  {
+    impl.write_weights(out, impl.precision());
+  });
   
   if (res.has_error()) throw std::runtime_error(res.error().message());
 }
 
-// update master graph weights
-void upd_weights(const std::string& update)
+// update master graph weights, computed from weights of given updates
+void upd_weights(const std::string& update, Compression compression,
+uint64_t clock, uint64_t updates)
 {
   graph::Request req;
   graph::Response res;
 
   auto upd_weights = req.mutable_upd_weights();
-  upd_weights->set_update(update);
-
-  ProtobufClient<graph::Request, graph::Response> client;    
-  client.connect(host, port);
-  client.send(req);    
-  client.receive(res);
-  client.disconnect();
+  upd_weights->set_compression(compression);
+  upd_weights->set_worker(worker_id);
+  upd_weights->set_clock(clock);
+  upd_weights->set_updates(updates);
+  upd_weights->set_compute_seconds(compute_time * 1e-6);
+  upd_weights->set_comm_seconds(comm_time * 1e-6);
+
+  clients->call(req, res, [&](std::ostream& out)
+  {
+    out.write(update.data(), update.size());
+  });
   
   if (res.has_error()) throw std::runtime_error(res.error().message());
 }
 
+// get master graph weights once for all threads waiting for them, threads
+// of one process train one model in the same precision
+Pulled get_shared_weights(uint64_t clock, Precision precision,
+Precision storage)
+{
+  std::unique_lock<std::mutex> lock(weights_lock);
+
+  // join download in progress
+  if (weights_loading)
+  {
+    auto round = weights_round;
+    weights_ready.wait(lock, [&]() { return weights_round != round; });
+    if (weights_error) std::rethrow_exception(weights_error);
+    return weights_snapshot;
+  }
+
+  // start new download of changes since last snapshot
+  weights_loading = true;
+  auto base = weights_snapshot.weights;
+  auto since = weights_versions;
+  lock.unlock();
+
+  // increments are not added to reduced precision snapshot, it is replaced
+  // by full weights of its precision
+  if (storage != FP32)
+  {
+    since.clear();
+    precision = storage;
+  }
+
+  Pulled snapshot;
+  std::vector<uint64_t> versions;
+  try
+  {
+    snapshot = get_weights(since, clock, precision, storage, base, versions);
+  }
+  catch (...)
+  {
+    lock.lock();
+    weights_error = std::current_exception();
+    weights_loading = false;
+    weights_round++;
+    weights_ready.notify_all();
+    throw;
+  }
+
+  // publish snapshot, previous one is released by its last reader
+  lock.lock();
+  weights_snapshot = snapshot;
+  weights_versions = versions;
+  weights_error = nullptr;
+  weights_loading = false;
+  weights_round++;
+  weights_ready.notify_all();
+
+  return snapshot;
+}
+
 // worker routines
 
 void thread_run(int worker)
 {
   try
   {
+    // place thread before its graph is allocated
+    topology->bind(worker);
     auto& impl = *create(worker);
 
     // init master graph
-    set_weights(impl.get_weights());
+    set_weights(impl);
+
+    // get master graph
+    uint64_t clock = 0;
+    auto precision = impl.precision();
+    auto storage = impl.storage();
+    auto weights = get_shared_weights(clock, precision, storage);
+    std::future<Pulled> pending;
 
     while (!done)
     {
-      // get master graph
-      impl.set_weights(get_weights());
-
       // train worker graph
+      auto start = std::chrono::steady_clock::now();
+      impl.set_weights(weights.weights);
       impl.batch_train();
-
-      // update master graph
-      upd_weights(impl.get_update());
+      compute_time += micros_since(start);
+      clock++;
+
+      // take own update or combined one when due
+      std::string update;
+      auto compression = impl.compression();
+      auto update_clock = clock;
+      auto updates = weights.updates;
+      if (!aggregator)
+        update = impl.get_update();
+      else
+      if (aggregator->add(impl, clock, weights.updates))
+        update = aggregator->take(compression, update_clock, updates);
+
+      // update master graph and get next one in background
+      auto transfer = std::async(std::launch::async,
+        [clock, precision, storage](const std::string& update,
+        Compression compression, uint64_t update_clock, uint64_t updates)
+        {
+          if (update.size())
+            upd_weights(update, compression, update_clock, updates);
+          return get_shared_weights(clock, precision, storage);
+        }, update, compression, update_clock, updates);
+
+      // train next batch on weights of earlier transfer when stale
+      start = std::chrono::steady_clock::now();
+      if (impl.staleness() == 0)
+      {
+        weights = transfer.get();
+      }
+      else
+      {
+        if (pending.valid()) weights = pending.get();
+        pending = std::move(transfer);
+      }
+      comm_time += micros_since(start);
     }
 
+    // complete last update
+    if (pending.valid()) pending.get();
+
     destroy(&impl);
   }
   catch (std::exception& e)
@@ -120,7 +411,8 @@ void thread_run(int worker)
   }
 }
 
-void worker_run(const std::string& impl, const std::string& host, int port)
+void worker_run(const std::string& impl, const std::string& host, int port,
+int aggregate, bool deflate)
 {  
   void* handle = dlopen(impl.c_str(), RTLD_LAZY);
   if (handle == nullptr)
@@ -139,16 +431,39 @@ void worker_run(const std::string& impl, const std::string& host, int port)
 
   seegnify::host = host;
   seegnify::port = port;
+  std::random_device random;
+  seegnify::worker_id = ((uint64_t)random() << 32) | random();
+  clients.reset(new ClientPool(host, port, deflate));
+  if (aggregate > 1) aggregator.reset(new Aggregator(aggregate));
+
+  topology.reset(new Topology(Topology::environment()));
 
   std::vector<std::thread> pool;
 
-  int threads = std::thread::hardware_concurrency();
-  std::cout << "starting " << threads << " threads..." << std::endl;
+  int threads = topology->replicas();
+  std::cout << "starting " << threads << " threads of "
+            << topology->threads() << " intra-op threads on "
+            << topology->nodes() << " nodes..." << std::endl;
 
   for (int i=0; i<threads; i++) pool.emplace_back(thread_run, i);
 
   for (auto& e: pool) e.join();
-  
+
+  // push increments of last batches
+  if (aggregator && aggregator->pending())
+  {
+    Compression compression;
+    uint64_t clock, updates;
+    auto update = aggregator->take(compression, clock, updates);
+    upd_weights(update, compression, clock, updates);
+  }
+
+  std::cout << "compute " << compute_time * 1e-6 << " s, "
+            << "communication " << comm_time * 1e-6 << " s" << std::endl;
+
+  aggregator.reset();
+  clients.reset();
+  topology.reset();
   dlclose(handle);
 }
 